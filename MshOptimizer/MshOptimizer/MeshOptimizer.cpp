@@ -0,0 +1,456 @@
+/**
+  MshOptimizer for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// MeshOptimizer.cpp : vertex and triangle optimizations for .msh groups.
+//-------------------------------------------------------------------------
+
+#include "MeshOptimizer.h"
+#include <math.h>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+// Round each vertex value to the number of decimal places that will be written, renormalizing
+// normals first.  Doing this before deduplication lets vertices that differ only in digits that
+// are about to be discarded share a single vertex.
+void MeshOptimizer::QuantizeVertices(MshGroup &group, const MshPrecision &precision)
+{
+    const double positionScale = pow(10.0, precision.positionDecimals);
+    const double normalScale = pow(10.0, precision.normalDecimals);
+    const double texCoordScale = pow(10.0, precision.texCoordDecimals);
+    const int texCoordOffset = group.GetTexCoordOffset();
+
+    for (MshVertex &v : group.vertices)
+    {
+        for (int i = 0; i < 3; i++)
+            v[i] = round(v[i] * positionScale) / positionScale;
+
+        if (group.HasNormals())
+        {
+            const double length = sqrt((v[3] * v[3]) + (v[4] * v[4]) + (v[5] * v[5]));
+            for (int i = 3; i < 6; i++)
+            {
+                if (length > 0)
+                    v[i] /= length;
+                v[i] = round(v[i] * normalScale) / normalScale;
+            }
+        }
+
+        if (group.HasTexCoords())
+        {
+            for (int i = texCoordOffset; i < texCoordOffset + 2; i++)
+                v[i] = round(v[i] * texCoordScale) / texCoordScale;
+        }
+    }
+}
+
+// hash for exact vertex matches
+struct VertexHasher
+{
+    size_t operator()(const MshVertex &v) const
+    {
+        size_t hash = 14695981039346656037ULL;
+        for (const double value : v)
+        {
+            const double normalized = ((value == 0) ? 0 : value);   // -0 == 0
+            const unsigned char *pBytes = reinterpret_cast<const unsigned char *>(&normalized);
+            for (size_t i = 0; i < sizeof(double); i++)
+                hash = (hash ^ pBytes[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+
+// Merge identical vertices, then drop degenerate triangles and any vertices no triangle uses.
+// Returns: number of vertices removed
+int MeshOptimizer::DeduplicateVertices(MshGroup &group)
+{
+    const int orgVertexCount = static_cast<int>(group.vertices.size());
+
+    unordered_map<MshVertex, int, VertexHasher> vertexMap;   // key = vertex, value = new index
+    vector<int> remap(orgVertexCount);
+    vector<MshVertex> uniqueVertices;
+    for (int i = 0; i < orgVertexCount; i++)
+    {
+        MshVertex v = group.vertices[i];
+        for (int j = group.componentCount; j < MAX_VERTEX_COMPONENTS; j++)
+            v[j] = 0;   // ignore unused values
+
+        auto result = vertexMap.emplace(v, static_cast<int>(uniqueVertices.size()));
+        if (result.second)
+            uniqueVertices.push_back(v);
+        remap[i] = result.first->second;
+    }
+
+    vector<MshTriangle> triangles;
+    triangles.reserve(group.triangles.size());
+    for (const MshTriangle &t : group.triangles)
+    {
+        const MshTriangle remapped = { remap[t[0]], remap[t[1]], remap[t[2]] };
+        if ((remapped[0] != remapped[1]) && (remapped[1] != remapped[2]) && (remapped[0] != remapped[2]))
+            triangles.push_back(remapped);
+    }
+
+    group.vertices.swap(uniqueVertices);
+    group.triangles.swap(triangles);
+    OptimizeVertexOrder(group);     // drops unused vertices
+    return orgVertexCount - static_cast<int>(group.vertices.size());
+}
+
+//-------------------------------------------------------------------------
+// Triangle reordering for post-transform vertex cache efficiency.
+// This is Tom Forsyth's "Linear-Speed Vertex Cache Optimisation": each vertex is scored by its
+// position in a simulated LRU cache and by how many triangles still use it, and the
+// highest-scoring triangle that touches the cache is emitted next.
+
+static const int FORSYTH_CACHE_SIZE = 32;
+
+static float GetForsythVertexScore(const int cachePosition, const int remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f;   // no triangles need this vertex
+
+    float score = 0;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+            score = 0.75f;  // used by the last triangle: fixed score so it is not favored over its neighbors
+        else
+            score = powf(1.0f - (static_cast<float>(cachePosition - 3) / (FORSYTH_CACHE_SIZE - 3)), 1.5f);
+    }
+
+    // boost vertices with few remaining triangles so that lone triangles are not left behind
+    score += 2.0f * powf(static_cast<float>(remainingTriangles), -0.5f);
+    return score;
+}
+
+void MeshOptimizer::OptimizeTriangleOrder(MshGroup &group)
+{
+    const int vertexCount = static_cast<int>(group.vertices.size());
+    const int triangleCount = static_cast<int>(group.triangles.size());
+    if (triangleCount == 0)
+        return;
+
+    // build vertex -> triangle adjacency
+    vector<int> adjacencyStart(vertexCount + 1, 0);
+    for (const MshTriangle &t : group.triangles)
+    {
+        for (int i = 0; i < 3; i++)
+            adjacencyStart[t[i] + 1]++;
+    }
+    for (int i = 0; i < vertexCount; i++)
+        adjacencyStart[i + 1] += adjacencyStart[i];
+
+    vector<int> adjacency(adjacencyStart[vertexCount]);
+    vector<int> remainingTriangles(vertexCount, 0);   // also the number of valid entries in each vertex's adjacency list
+    for (int t = 0; t < triangleCount; t++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            const int v = group.triangles[t][i];
+            adjacency[adjacencyStart[v] + remainingTriangles[v]++] = t;
+        }
+    }
+
+    vector<int> cachePosition(vertexCount, -1);
+    vector<float> vertexScore(vertexCount);
+    for (int v = 0; v < vertexCount; v++)
+        vertexScore[v] = GetForsythVertexScore(-1, remainingTriangles[v]);
+
+    vector<float> triangleScore(triangleCount);
+    vector<bool> isEmitted(triangleCount, false);
+    for (int t = 0; t < triangleCount; t++)
+    {
+        const MshTriangle &tri = group.triangles[t];
+        triangleScore[t] = vertexScore[tri[0]] + vertexScore[tri[1]] + vertexScore[tri[2]];
+    }
+
+    vector<MshTriangle> orderedTriangles;
+    orderedTriangles.reserve(triangleCount);
+    vector<int> cache;      // vertex indices, most recently used first
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    int bestTriangle = -1;
+    int searchStart = 0;    // all triangles before this index have been emitted
+
+    while (static_cast<int>(orderedTriangles.size()) < triangleCount)
+    {
+        if (bestTriangle < 0)
+        {
+            // Nothing in the cache is connected to a remaining triangle, so scan for the best remaining
+            // triangle.  This only happens when we move to a new disconnected piece of the group.
+            float bestScore = -1e30f;
+            while (isEmitted[searchStart])
+                searchStart++;
+            for (int t = searchStart; t < triangleCount; t++)
+            {
+                if (!isEmitted[t] && (triangleScore[t] > bestScore))
+                {
+                    bestScore = triangleScore[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        // emit the best triangle and move its vertices to the front of the cache
+        const MshTriangle &tri = group.triangles[bestTriangle];
+        orderedTriangles.push_back(tri);
+        isEmitted[bestTriangle] = true;
+
+        for (int i = 0; i < 3; i++)
+        {
+            const int v = tri[i];
+
+            // remove this triangle from the vertex's list of remaining triangles
+            int *pList = &adjacency[adjacencyStart[v]];
+            int *pEnd = pList + remainingTriangles[v];
+            *find(pList, pEnd, bestTriangle) = pEnd[-1];
+            remainingTriangles[v]--;
+
+            auto it = find(cache.begin(), cache.end(), v);
+            if (it != cache.end())
+                cache.erase(it);
+        }
+        for (int i = 2; i >= 0; i--)
+        {
+            if (find(cache.begin(), cache.end(), tri[i]) == cache.end())   // degenerate triangles may repeat a vertex
+                cache.insert(cache.begin(), tri[i]);
+        }
+
+        // drop any vertices that fell out of the cache
+        while (static_cast<int>(cache.size()) > FORSYTH_CACHE_SIZE)
+        {
+            const int v = cache.back();
+            cache.pop_back();
+            cachePosition[v] = -1;
+            vertexScore[v] = GetForsythVertexScore(-1, remainingTriangles[v]);
+            for (int i = 0; i < remainingTriangles[v]; i++)
+            {
+                const int t = adjacency[adjacencyStart[v] + i];
+                const MshTriangle &other = group.triangles[t];
+                triangleScore[t] = vertexScore[other[0]] + vertexScore[other[1]] + vertexScore[other[2]];
+            }
+        }
+
+        // rescore everything in the cache and pick the next triangle from the triangles it touches
+        for (int i = 0; i < static_cast<int>(cache.size()); i++)
+        {
+            const int v = cache[i];
+            cachePosition[v] = i;
+            vertexScore[v] = GetForsythVertexScore(i, remainingTriangles[v]);
+        }
+
+        bestTriangle = -1;
+        float bestScore = -1e30f;
+        for (const int v : cache)
+        {
+            for (int i = 0; i < remainingTriangles[v]; i++)
+            {
+                const int t = adjacency[adjacencyStart[v] + i];
+                const MshTriangle &other = group.triangles[t];
+                triangleScore[t] = vertexScore[other[0]] + vertexScore[other[1]] + vertexScore[other[2]];
+                if (triangleScore[t] > bestScore)
+                {
+                    bestScore = triangleScore[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    group.triangles.swap(orderedTriangles);
+}
+
+// Renumber vertices in the order the triangles first use them so that vertex fetches walk
+// through memory sequentially; vertices no triangle uses are dropped.
+void MeshOptimizer::OptimizeVertexOrder(MshGroup &group)
+{
+    vector<int> remap(group.vertices.size(), -1);
+    vector<MshVertex> orderedVertices;
+    orderedVertices.reserve(group.vertices.size());
+
+    for (MshTriangle &t : group.triangles)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            int &newIndex = remap[t[i]];
+            if (newIndex < 0)
+            {
+                newIndex = static_cast<int>(orderedVertices.size());
+                orderedVertices.push_back(group.vertices[t[i]]);
+            }
+            t[i] = newIndex;
+        }
+    }
+
+    group.vertices.swap(orderedVertices);
+}
+
+//-------------------------------------------------------------------------
+
+// Returns true if the source group's triangles can be drawn as part of the target group.
+bool MeshOptimizer::AreGroupsCompatible(const MshFile &mesh, const MshGroup &target, const MshGroup &source)
+{
+    if ((target.componentCount != source.componentCount) ||
+        (target.vertices.size() + source.vertices.size() > MAX_GROUP_VERTICES))
+        return false;
+
+    // Transparent groups must be drawn in their original order.
+    if (mesh.GetMaterialAlpha(target.materialIndex) < 1.0)
+        return false;
+
+    // every header line except the label must match: MATERIAL, TEXTURE, FLAG, NONORMAL, TEXWRAP, etc.
+    vector<string> targetHeader, sourceHeader;
+    for (const string &line : target.headerLines)
+    {
+        if (GetKeyword(line) != "LABEL")
+            targetHeader.push_back(line);
+    }
+    for (const string &line : source.headerLines)
+    {
+        if (GetKeyword(line) != "LABEL")
+            sourceHeader.push_back(line);
+    }
+    return (targetHeader == sourceHeader);
+}
+
+// Append each unprotected group to the first earlier unprotected group with the same material,
+// texture, and flags.
+// Group indices are referenced by the vessel code (animations, meshres.h), so a group is only merged
+// away if every group after it is also unreferenced: removing it shifts the index of each later group.
+// isProtected = one entry per group; true if the group index is referenced by the vessel code
+// Returns: number of groups removed
+int MeshOptimizer::MergeGroups(MshFile &mesh, const vector<bool> &isProtected, string &warningOut)
+{
+    const int groupCount = static_cast<int>(mesh.m_groups.size());
+
+    // If a group omits MATERIAL or TEXTURE it inherits them from the previous group, so removing
+    // any group could change another group's appearance.
+    for (const MshGroup &group : mesh.m_groups)
+    {
+        if ((group.materialIndex < 0) || (group.textureIndex < 0))
+        {
+            warningOut = "not merging groups: some groups do not specify MATERIAL and TEXTURE";
+            return 0;
+        }
+    }
+
+    int firstMovableGroup = 0;
+    for (int i = 0; i < groupCount; i++)
+    {
+        if (isProtected[i])
+            firstMovableGroup = i + 1;
+    }
+
+    vector<bool> isRemoved(groupCount, false);
+    int removedCount = 0;
+    for (int source = firstMovableGroup; source < groupCount; source++)
+    {
+        MshGroup &sourceGroup = mesh.m_groups[source];
+        for (int target = 0; target < source; target++)
+        {
+            MshGroup &targetGroup = mesh.m_groups[target];
+            if (isProtected[target] || isRemoved[target] || !AreGroupsCompatible(mesh, targetGroup, sourceGroup))
+                continue;
+
+            const int vertexOffset = static_cast<int>(targetGroup.vertices.size());
+            targetGroup.vertices.insert(targetGroup.vertices.end(), sourceGroup.vertices.begin(), sourceGroup.vertices.end());
+            for (const MshTriangle &t : sourceGroup.triangles)
+                targetGroup.triangles.push_back({ t[0] + vertexOffset, t[1] + vertexOffset, t[2] + vertexOffset });
+
+            isRemoved[source] = true;
+            removedCount++;
+            break;
+        }
+    }
+
+    vector<MshGroup> groups;
+    groups.reserve(groupCount - removedCount);
+    for (int i = 0; i < groupCount; i++)
+    {
+        if (!isRemoved[i])
+            groups.push_back(move(mesh.m_groups[i]));
+    }
+    mesh.m_groups.swap(groups);
+    return removedCount;
+}
+
+// Quantize, deduplicate, and reorder the vertices and triangles of each group.  The vessel code edits the vertices
+// of some protected groups by index (e.g., the VC HUD and status indicator groups), so a protected group keeps every
+// vertex unchanged and in its original order; only the order of its triangles may change.
+// Returns: number of vertices removed
+int MeshOptimizer::OptimizeGroups(MshFile &mesh, const MshPrecision &precision, const bool doDedup, const bool doReorder)
+{
+    int removedVertexCount = 0;
+    for (MshGroup &group : mesh.m_groups)
+    {
+        if (group.isProtected)
+        {
+            if (doReorder)
+                OptimizeTriangleOrder(group);   // does not touch the vertices
+            continue;
+        }
+
+        QuantizeVertices(group, precision);
+        if (doDedup)
+            removedVertexCount += DeduplicateVertices(group);
+
+        if (doReorder)
+        {
+            OptimizeTriangleOrder(group);
+            OptimizeVertexOrder(group);
+        }
+    }
+    return removedVertexCount;
+}
+
+//-------------------------------------------------------------------------
+
+// Returns the number of vertex shader invocations needed to draw a group with a FIFO post-transform cache.
+int MeshOptimizer::CountCacheMisses(const MshGroup &group, const int cacheSize)
+{
+    vector<int> cacheTimestamp(group.vertices.size(), -1);   // value of missCount when the vertex entered the cache
+    int missCount = 0;
+    for (const MshTriangle &t : group.triangles)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            int &timestamp = cacheTimestamp[t[i]];
+            if ((timestamp < 0) || (missCount - timestamp >= cacheSize))
+            {
+                timestamp = missCount;
+                missCount++;
+            }
+        }
+    }
+    return missCount;
+}
+
+// Returns the average cache miss ratio for the whole mesh; 3.0 is the worst case and 0.5 is the ideal for a large regular grid.
+double MeshOptimizer::ComputeACMR(const MshFile &mesh)
+{
+    long long missCount = 0;
+    for (const MshGroup &group : mesh.m_groups)
+        missCount += CountCacheMisses(group, ACMR_CACHE_SIZE);
+
+    const int triangleCount = mesh.GetTriangleCount();
+    return ((triangleCount > 0) ? (static_cast<double>(missCount) / triangleCount) : 0);
+}
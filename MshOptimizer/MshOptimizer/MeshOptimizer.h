@@ -0,0 +1,51 @@
+/**
+  MshOptimizer for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// MeshOptimizer.h : vertex and triangle optimizations for .msh groups.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include "MshFile.h"
+
+class MeshOptimizer
+{
+public:
+    // cache size used to compute ACMR (average cache miss ratio: vertex shader invocations per triangle)
+    static const int ACMR_CACHE_SIZE = 16;
+
+    // Orbiter's graphics clients use 16-bit vertex indices
+    static const int MAX_GROUP_VERTICES = 65535;
+
+    static void QuantizeVertices(MshGroup &group, const MshPrecision &precision);
+    static int DeduplicateVertices(MshGroup &group);
+    static void OptimizeTriangleOrder(MshGroup &group);
+    static void OptimizeVertexOrder(MshGroup &group);
+    static int MergeGroups(MshFile &mesh, const vector<bool> &isProtected, string &warningOut);
+    static int OptimizeGroups(MshFile &mesh, const MshPrecision &precision, const bool doDedup, const bool doReorder);
+
+    static int CountCacheMisses(const MshGroup &group, const int cacheSize);
+    static double ComputeACMR(const MshFile &mesh);
+
+protected:
+    static bool AreGroupsCompatible(const MshFile &mesh, const MshGroup &target, const MshGroup &source);
+};
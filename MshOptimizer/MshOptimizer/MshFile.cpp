@@ -0,0 +1,403 @@
+/**
+  MshOptimizer for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// MshFile.cpp : read and write Orbiter text .msh files.
+//-------------------------------------------------------------------------
+
+#include "MshFile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Returns the first whitespace-delimited token of a line
+string GetKeyword(const string &line)
+{
+    const size_t start = line.find_first_not_of(" \t");
+    if (start == string::npos)
+        return string();
+
+    const size_t end = line.find_first_of(" \t", start);
+    return line.substr(start, (end == string::npos) ? string::npos : end - start);
+}
+
+// Parses up to maxValues whitespace-delimited numbers from pStr.
+// Returns: number of values parsed
+static int ParseNumbers(const char *pStr, double *pValuesOut, const int maxValues)
+{
+    int count = 0;
+    while (count < maxValues)
+    {
+        char *pEnd;
+        const double value = strtod(pStr, &pEnd);
+        if (pEnd == pStr)
+            break;      // no more numbers on this line
+
+        pValuesOut[count++] = value;
+        pStr = pEnd;
+    }
+    return count;
+}
+
+// Reads the entire file into memory and splits it into lines with any trailing CR removed.
+static bool ReadLines(const char *pFilespec, vector<string> &linesOut)
+{
+    FILE *pFile = fopen(pFilespec, "rb");
+    if (pFile == nullptr)
+        return false;
+
+    string contents;
+    char buffer[65536];
+    size_t bytesRead;
+    while ((bytesRead = fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+        contents.append(buffer, bytesRead);
+    fclose(pFile);
+
+    size_t lineStart = 0;
+    while (lineStart < contents.size())
+    {
+        size_t lineEnd = contents.find('\n', lineStart);
+        if (lineEnd == string::npos)
+            lineEnd = contents.size();
+
+        size_t length = lineEnd - lineStart;
+        if ((length > 0) && (contents[lineStart + length - 1] == '\r'))
+            length--;
+
+        linesOut.emplace_back(contents, lineStart, length);
+        lineStart = lineEnd + 1;
+    }
+    return true;
+}
+
+// Read a .msh file, replacing any existing contents of this object.
+// Returns: true on success, false on error (errorOut describes the error)
+bool MshFile::Read(const char *pFilespec, string &errorOut)
+{
+    m_formatLine.clear();
+    m_groups.clear();
+    m_trailerLines.clear();
+    m_materialAlphas.clear();
+
+    vector<string> lines;
+    if (!ReadLines(pFilespec, lines))
+    {
+        errorOut = string("cannot open ") + pFilespec;
+        return false;
+    }
+
+    size_t lineIndex = 0;
+    if (lines.empty() || (GetKeyword(lines[0]).compare(0, 3, "MSH") != 0))
+    {
+        errorOut = "missing MSHX1 header";
+        return false;
+    }
+    m_formatLine = lines[lineIndex++];
+
+    // locate the group count
+    int groupCount = -1;
+    for (; lineIndex < lines.size(); lineIndex++)
+    {
+        if (GetKeyword(lines[lineIndex]) == "GROUPS")
+        {
+            groupCount = atoi(lines[lineIndex].c_str() + lines[lineIndex].find("GROUPS") + 6);
+            lineIndex++;
+            break;
+        }
+    }
+    if (groupCount < 0)
+    {
+        errorOut = "missing GROUPS line";
+        return false;
+    }
+
+    m_groups.resize(groupCount);
+    for (int i = 0; i < groupCount; i++)
+    {
+        if (!ParseGroup(lines, lineIndex, m_groups[i], errorOut))
+        {
+            errorOut = "group " + to_string(i) + ": " + errorOut;
+            return false;
+        }
+    }
+
+    // everything after the last group is kept verbatim
+    m_trailerLines.assign(lines.begin() + lineIndex, lines.end());
+    while (!m_trailerLines.empty() && m_trailerLines.back().empty())
+        m_trailerLines.pop_back();
+
+    ParseMaterialAlphas();
+    return true;
+}
+
+// Parse one group starting at lineIndex; on exit lineIndex is the first line after the group.
+bool MshFile::ParseGroup(const vector<string> &lines, size_t &lineIndex, MshGroup &group, string &errorOut)
+{
+    group.materialIndex = -1;
+    group.textureIndex = -1;
+    group.noNormals = false;
+    group.componentCount = 0;
+    group.isProtected = false;
+
+    // header lines
+    for (;; lineIndex++)
+    {
+        if (lineIndex >= lines.size())
+        {
+            errorOut = "unexpected end of file before GEOM";
+            return false;
+        }
+
+        const string &line = lines[lineIndex];
+        const string keyword = GetKeyword(line);
+        if (keyword.empty())
+            continue;   // blank line
+
+        if (keyword == "GEOM")
+            break;
+
+        const char *pArgs = line.c_str() + line.find(keyword) + keyword.size();
+        if (keyword == "LABEL")
+            group.label = GetKeyword(pArgs);
+        else if (keyword == "MATERIAL")
+            group.materialIndex = atoi(pArgs);
+        else if (keyword == "TEXTURE")
+            group.textureIndex = atoi(pArgs);
+        else if (keyword == "NONORMAL")
+            group.noNormals = true;
+
+        group.headerLines.push_back(line);
+    }
+
+    // GEOM <vertex count> <triangle count> [; comment]
+    const string &geomLine = lines[lineIndex++];
+    int vertexCount = 0, triangleCount = 0;
+    if (sscanf(geomLine.c_str(), " GEOM %d %d", &vertexCount, &triangleCount) != 2)
+    {
+        errorOut = "invalid GEOM line: " + geomLine;
+        return false;
+    }
+    const size_t commentStart = geomLine.find(';');
+    if (commentStart != string::npos)
+        group.geomComment = geomLine.substr(commentStart + 1);
+
+    if (lineIndex + vertexCount + triangleCount > lines.size())
+    {
+        errorOut = "unexpected end of file in GEOM block";
+        return false;
+    }
+
+    group.vertices.resize(vertexCount);
+    for (int i = 0; i < vertexCount; i++)
+    {
+        MshVertex &v = group.vertices[i];
+        v.fill(0);
+        const int count = ParseNumbers(lines[lineIndex++].c_str(), v.data(), MAX_VERTEX_COMPONENTS);
+
+        // Every vertex in a group must have the same layout; extra values on a line are ignored.
+        if (i == 0)
+            group.componentCount = (group.noNormals ? ((count >= 5) ? 5 : count) : count);
+
+        if ((count < 3) || (count < group.componentCount))
+        {
+            errorOut = "vertex " + to_string(i) + " has too few values";
+            return false;
+        }
+    }
+    if ((vertexCount > 0) && (group.componentCount != 3) && (group.componentCount != 5) &&
+        (group.componentCount != 6) && (group.componentCount != 8))
+    {
+        errorOut = "unsupported vertex layout with " + to_string(group.componentCount) + " values";
+        return false;
+    }
+
+    group.triangles.resize(triangleCount);
+    for (int i = 0; i < triangleCount; i++)
+    {
+        MshTriangle &t = group.triangles[i];
+        if (sscanf(lines[lineIndex++].c_str(), "%d %d %d", &t[0], &t[1], &t[2]) != 3)
+        {
+            errorOut = "invalid triangle " + to_string(i);
+            return false;
+        }
+        for (int j = 0; j < 3; j++)
+        {
+            if ((t[j] < 0) || (t[j] >= vertexCount))
+            {
+                errorOut = "triangle " + to_string(i) + " references a nonexistent vertex";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Extract the diffuse alpha of each material block in the trailer:
+//     MATERIAL <name>
+//     <diffuse r g b a>
+//     ...
+void MshFile::ParseMaterialAlphas()
+{
+    bool inMaterials = false;
+    for (size_t i = 0; i < m_trailerLines.size(); i++)
+    {
+        const string keyword = GetKeyword(m_trailerLines[i]);
+        if (keyword == "MATERIALS")
+            inMaterials = true;
+        else if (keyword == "TEXTURES")
+            inMaterials = false;
+        else if (inMaterials && (keyword == "MATERIAL") && (i + 1 < m_trailerLines.size()))
+        {
+            double rgba[4] = { 1, 1, 1, 1 };
+            ParseNumbers(m_trailerLines[i + 1].c_str(), rgba, 4);
+            m_materialAlphas.push_back(rgba[3]);
+        }
+    }
+}
+
+// Returns the diffuse alpha of the specified 1-based material index; material 0 is the default material.
+double MshFile::GetMaterialAlpha(const int materialIndex) const
+{
+    if ((materialIndex <= 0) || (materialIndex > static_cast<int>(m_materialAlphas.size())))
+        return 1.0;
+
+    return m_materialAlphas[materialIndex - 1];
+}
+
+int MshFile::GetVertexCount() const
+{
+    int count = 0;
+    for (const MshGroup &group : m_groups)
+        count += static_cast<int>(group.vertices.size());
+    return count;
+}
+
+int MshFile::GetTriangleCount() const
+{
+    int count = 0;
+    for (const MshGroup &group : m_groups)
+        count += static_cast<int>(group.triangles.size());
+    return count;
+}
+
+// Appends a value with the specified number of decimal places and no trailing zeros; e.g., "0.5", "-3", "0".
+static void AppendValue(string &out, const double value, const int decimals)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+
+    char *pEnd = buffer + strlen(buffer);
+    if (strchr(buffer, '.') != nullptr)
+    {
+        while (pEnd[-1] == '0')
+            pEnd--;
+        if (pEnd[-1] == '.')
+            pEnd--;
+        *pEnd = 0;
+    }
+
+    if (strcmp(buffer, "-0") == 0)
+        strcpy(buffer, "0");
+
+    out.append(buffer);
+}
+
+// Appends a value with the fewest decimal places that read back as exactly the same value; e.g., "0.123456789".
+static void AppendExactValue(string &out, const double value)
+{
+    for (int decimals = 0; decimals <= 20; decimals++)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        if (strtod(buffer, nullptr) == value)
+        {
+            AppendValue(out, value, decimals);
+            return;
+        }
+    }
+
+    // tiny values need more digits than this; write every significant digit instead
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out.append(buffer);
+}
+
+// Write this mesh to a .msh file.
+// Returns: true on success, false on error (errorOut describes the error)
+bool MshFile::Write(const char *pFilespec, const MshPrecision &precision, string &errorOut) const
+{
+    string out;
+    out.reserve(1 << 20);
+
+    out += m_formatLine + "\n";
+    out += "GROUPS " + to_string(m_groups.size()) + "\n";
+
+    for (const MshGroup &group : m_groups)
+    {
+        for (const string &line : group.headerLines)
+            out += line + "\n";
+
+        out += "GEOM " + to_string(group.vertices.size()) + " " + to_string(group.triangles.size());
+        if (!group.geomComment.empty())
+            out += " ;" + group.geomComment;
+        out += "\n";
+
+        for (const MshVertex &v : group.vertices)
+        {
+            for (int i = 0; i < group.componentCount; i++)
+            {
+                if (i > 0)
+                    out += ' ';
+
+                if (group.isProtected)
+                {
+                    AppendExactValue(out, v[i]);    // the vessel code may edit these vertices, so do not round them
+                    continue;
+                }
+
+                const int decimals = ((i < 3) ? precision.positionDecimals :
+                    ((group.HasNormals() && (i < 6)) ? precision.normalDecimals : precision.texCoordDecimals));
+                AppendValue(out, v[i], decimals);
+            }
+            out += '\n';
+        }
+
+        for (const MshTriangle &t : group.triangles)
+            out += to_string(t[0]) + " " + to_string(t[1]) + " " + to_string(t[2]) + "\n";
+    }
+
+    for (const string &line : m_trailerLines)
+        out += line + "\n";
+
+    FILE *pFile = fopen(pFilespec, "wb");
+    if (pFile == nullptr)
+    {
+        errorOut = string("cannot create ") + pFilespec;
+        return false;
+    }
+    const bool success = (fwrite(out.data(), 1, out.size(), pFile) == out.size());
+    fclose(pFile);
+
+    if (!success)
+        errorOut = string("error writing ") + pFilespec;
+    return success;
+}
@@ -0,0 +1,88 @@
+/**
+  MshOptimizer for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// MshFile.h : in-memory representation of an Orbiter text .msh file.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+
+using namespace std;
+
+// Maximum number of values in a vertex line: x y z nx ny nz tu tv
+const int MAX_VERTEX_COMPONENTS = 8;
+
+typedef array<double, MAX_VERTEX_COMPONENTS> MshVertex;
+typedef array<int, 3> MshTriangle;
+
+// A single mesh group: its header lines followed by its GEOM block.
+struct MshGroup
+{
+    vector<string> headerLines;  // all lines preceding GEOM, written back verbatim; e.g., "LABEL foo", "MATERIAL 2", "FLAG 3"
+    string label;           // empty if the group has no LABEL line
+    int materialIndex;      // -1 if the group has no MATERIAL line
+    int textureIndex;       // -1 if the group has no TEXTURE line
+    bool noNormals;         // true if the group has a NONORMAL line
+    string geomComment;     // everything after ';' on the GEOM line, if any
+    int componentCount;     // values per vertex line: 3 or 5 without normals, 6 or 8 with normals
+    vector<MshVertex> vertices;
+    vector<MshTriangle> triangles;
+    bool isProtected;       // true if the vessel code references this group; its vertices are written back unchanged
+
+    bool HasNormals() const { return (componentCount >= 6); }
+    bool HasTexCoords() const { return ((componentCount == 5) || (componentCount == 8)); }
+    int GetTexCoordOffset() const { return (HasNormals() ? 6 : 3); }
+};
+
+// Number of decimal places written for each kind of vertex value.
+struct MshPrecision
+{
+    int positionDecimals;
+    int normalDecimals;
+    int texCoordDecimals;
+};
+
+class MshFile
+{
+public:
+    bool Read(const char *pFilespec, string &errorOut);
+    bool Write(const char *pFilespec, const MshPrecision &precision, string &errorOut) const;
+
+    double GetMaterialAlpha(const int materialIndex) const;  // diffuse alpha of a 1-based material index; material 0 is the opaque default
+    int GetVertexCount() const;
+    int GetTriangleCount() const;
+
+    string m_formatLine;            // e.g., "MSHX1"
+    vector<MshGroup> m_groups;
+    vector<string> m_trailerLines;  // MATERIALS and TEXTURES sections, written back verbatim
+    vector<double> m_materialAlphas;  // diffuse alpha of each material in the trailer; element 0 = material 1
+
+protected:
+    bool ParseGroup(const vector<string> &lines, size_t &lineIndex, MshGroup &group, string &errorOut);
+    void ParseMaterialAlphas();
+};
+
+// Returns the first whitespace-delimited token of a line; e.g., "GEOM" for "GEOM 418 248 ; foo"
+string GetKeyword(const string &line);
@@ -0,0 +1,350 @@
+/**
+  MshOptimizer for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// MshOptimizer.cpp : command-line optimizer for Orbiter text .msh files.
+//
+// Deduplicates vertices, reorders triangles for post-transform vertex cache
+// efficiency, merges compatible groups that the vessel code does not
+// reference, and drops precision the renderer cannot use.
+//
+// Builds with Visual Studio (MshOptimizer.sln) or on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "MshFile.h"
+#include "MeshOptimizer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+const char *PROGRAM_NAME   = "MshOptimizer";
+const char *VERSION        = "1.0";
+const char *COPYRIGHT_YEAR = "2006-2021";
+
+struct MeshStats
+{
+    int groupCount;
+    int vertexCount;
+    int triangleCount;
+    double acmr;
+    long fileBytes;
+    double parseMillis;
+};
+
+static void Usage()
+{
+    printf("Usage: %s [options] <input.msh> [output.msh]\n", PROGRAM_NAME);
+    printf("If no output file is specified, only the statistics for the input file are shown.\n\n");
+    printf("Options:\n");
+    printf("  --protect-header <file>   do not move, merge, or change the vertices of any group defined as\n");
+    printf("                            '#define ...GRP_<name> <index>' in <file> (e.g., the vessel's meshres.h);\n");
+    printf("                            may be specified more than once\n");
+    printf("  --protect <list>          do not move, merge, or change the vertices of these group indices; e.g., 0,5,10-20\n");
+    printf("  --no-group-references     the vessel code references no groups by index, so any group may be merged\n");
+    printf("  --no-merge                do not merge groups\n");
+    printf("  --no-dedup                do not merge duplicate vertices\n");
+    printf("  --no-reorder              do not reorder triangles or vertices\n");
+    printf("  --position-decimals <n>   decimal places written for vertex positions (default 5)\n");
+    printf("  --normal-decimals <n>     decimal places written for normals (default 4)\n");
+    printf("  --texcoord-decimals <n>   decimal places written for texture coordinates (default 5)\n");
+    printf("\nGroups are only merged if --protect-header, --protect, or --no-group-references is specified.\n");
+}
+
+static long GetFileBytes(const char *pFilespec)
+{
+    FILE *pFile = fopen(pFilespec, "rb");
+    if (pFile == nullptr)
+        return -1;
+
+    fseek(pFile, 0, SEEK_END);
+    const long bytes = ftell(pFile);
+    fclose(pFile);
+    return bytes;
+}
+
+// Read a mesh and gather its statistics.
+// Returns: true on success, false on error (errorOut describes the error)
+static bool ReadMesh(const char *pFilespec, MshFile &mesh, MeshStats &stats, string &errorOut)
+{
+    const auto startTime = chrono::steady_clock::now();
+    if (!mesh.Read(pFilespec, errorOut))
+        return false;
+    stats.parseMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+
+    stats.groupCount = static_cast<int>(mesh.m_groups.size());
+    stats.vertexCount = mesh.GetVertexCount();
+    stats.triangleCount = mesh.GetTriangleCount();
+    stats.acmr = MeshOptimizer::ComputeACMR(mesh);
+    stats.fileBytes = GetFileBytes(pFilespec);
+    return true;
+}
+
+// Mark every group index defined in a meshres.h-style header as protected.
+// Returns: number of group indices found, or -1 if the file cannot be read
+static int ParseProtectHeader(const char *pFilespec, vector<bool> &isProtected)
+{
+    FILE *pFile = fopen(pFilespec, "r");
+    if (pFile == nullptr)
+        return -1;
+
+    int count = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), pFile) != nullptr)
+    {
+        char name[512];
+        int groupIndex;
+        if ((sscanf(line, " #define %511s %d", name, &groupIndex) == 2) && (strstr(name, "GRP_") != nullptr) && (groupIndex >= 0))
+        {
+            if (groupIndex >= static_cast<int>(isProtected.size()))
+                isProtected.resize(groupIndex + 1, false);
+            isProtected[groupIndex] = true;
+            count++;
+        }
+    }
+    fclose(pFile);
+    return count;
+}
+
+// Parse a list of group indices and ranges; e.g., "0,5,10-20"
+// Returns: true on success, false if the list is invalid
+static bool ParseProtectList(const char *pList, vector<bool> &isProtected)
+{
+    while (*pList != 0)
+    {
+        char *pEnd;
+        const long first = strtol(pList, &pEnd, 10);
+        if ((pEnd == pList) || (first < 0))
+            return false;
+
+        long last = first;
+        pList = pEnd;
+        if (*pList == '-')
+        {
+            last = strtol(pList + 1, &pEnd, 10);
+            if ((pEnd == pList + 1) || (last < first))
+                return false;
+            pList = pEnd;
+        }
+
+        if (last >= static_cast<long>(isProtected.size()))
+            isProtected.resize(last + 1, false);
+        for (long i = first; i <= last; i++)
+            isProtected[i] = true;
+
+        if (*pList == ',')
+            pList++;
+        else if (*pList != 0)
+            return false;
+    }
+    return true;
+}
+
+static void PrintStats(const MeshStats &before, const MeshStats *pAfter)
+{
+    printf("\n%-20s %14s", "", "before");
+    if (pAfter != nullptr)
+        printf(" %14s %9s", "after", "change");
+    printf("\n");
+
+    struct Row
+    {
+        const char *pName;
+        double before;
+        double after;
+        int decimals;
+    };
+    const MeshStats &after = ((pAfter != nullptr) ? *pAfter : before);
+    const Row rows[] =
+    {
+        { "Groups",           static_cast<double>(before.groupCount),    static_cast<double>(after.groupCount),    0 },
+        { "Vertices",         static_cast<double>(before.vertexCount),   static_cast<double>(after.vertexCount),   0 },
+        { "Triangles",        static_cast<double>(before.triangleCount), static_cast<double>(after.triangleCount), 0 },
+        { "ACMR (FIFO 16)",   before.acmr,                               after.acmr,                               3 },
+        { "File size (bytes)", static_cast<double>(before.fileBytes),    static_cast<double>(after.fileBytes),     0 },
+        { "Parse time (ms)",  before.parseMillis,                        after.parseMillis,                        1 },
+    };
+
+    for (const Row &row : rows)
+    {
+        printf("%-20s %14.*f", row.pName, row.decimals, row.before);
+        if (pAfter != nullptr)
+        {
+            if (row.before != 0)
+                printf(" %14.*f %8.1f%%", row.decimals, row.after, ((row.after - row.before) * 100.0) / row.before);
+            else
+                printf(" %14.*f %9s", row.decimals, row.after, "-");
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    printf("\n >>> %s %s <<<\n", PROGRAM_NAME, VERSION);
+    printf("Copyright %s Douglas Beachy\n", COPYRIGHT_YEAR);
+    printf("Licensed under the terms of the GNU General Public License.\n");
+    printf("See https://www.gnu.org/licenses/ for license details.\n");
+    printf("-------------------------------------------------------\n");
+
+    const char *pInputFilespec = nullptr;
+    const char *pOutputFilespec = nullptr;
+    vector<bool> isProtected;
+    bool hasGroupReferenceInfo = false;
+    bool doMerge = true, doDedup = true, doReorder = true;
+    MshPrecision precision = { 5, 4, 5 };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(pArg, "--help") == 0) || (strcmp(pArg, "-h") == 0))
+        {
+            Usage();
+            return 0;
+        }
+        else if ((strcmp(pArg, "--protect-header") == 0) && hasValue)
+        {
+            const char *pHeader = argv[++i];
+            const int count = ParseProtectHeader(pHeader, isProtected);
+            if (count < 0)
+            {
+                fprintf(stderr, "ERROR: cannot read %s\n", pHeader);
+                return 2;
+            }
+            printf("%s: %d group indices protected\n", pHeader, count);
+            hasGroupReferenceInfo = true;
+        }
+        else if ((strcmp(pArg, "--protect") == 0) && hasValue)
+        {
+            if (!ParseProtectList(argv[++i], isProtected))
+            {
+                fprintf(stderr, "ERROR: invalid group list: %s\n", argv[i]);
+                return 1;
+            }
+            hasGroupReferenceInfo = true;
+        }
+        else if (strcmp(pArg, "--no-group-references") == 0)
+            hasGroupReferenceInfo = true;
+        else if (strcmp(pArg, "--no-merge") == 0)
+            doMerge = false;
+        else if (strcmp(pArg, "--no-dedup") == 0)
+            doDedup = false;
+        else if (strcmp(pArg, "--no-reorder") == 0)
+            doReorder = false;
+        else if ((strcmp(pArg, "--position-decimals") == 0) && hasValue)
+            precision.positionDecimals = atoi(argv[++i]);
+        else if ((strcmp(pArg, "--normal-decimals") == 0) && hasValue)
+            precision.normalDecimals = atoi(argv[++i]);
+        else if ((strcmp(pArg, "--texcoord-decimals") == 0) && hasValue)
+            precision.texCoordDecimals = atoi(argv[++i]);
+        else if ((pArg[0] == '-') && (pArg[1] != 0))
+        {
+            fprintf(stderr, "ERROR: unknown option or missing value: %s\n\n", pArg);
+            Usage();
+            return 1;
+        }
+        else if (pInputFilespec == nullptr)
+            pInputFilespec = pArg;
+        else if (pOutputFilespec == nullptr)
+            pOutputFilespec = pArg;
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    if (pInputFilespec == nullptr)
+    {
+        Usage();
+        return 1;
+    }
+
+    if ((precision.positionDecimals < 0) || (precision.normalDecimals < 0) || (precision.texCoordDecimals < 0) ||
+        (precision.positionDecimals > 15) || (precision.normalDecimals > 15) || (precision.texCoordDecimals > 15))
+    {
+        fprintf(stderr, "ERROR: decimal places must be between 0 and 15\n");
+        return 1;
+    }
+
+    MshFile mesh;
+    MeshStats before;
+    string error;
+    if (!ReadMesh(pInputFilespec, mesh, before, error))
+    {
+        fprintf(stderr, "ERROR: %s: %s\n", pInputFilespec, error.c_str());
+        return 2;
+    }
+    printf("Read %s\n", pInputFilespec);
+
+    if (pOutputFilespec == nullptr)
+    {
+        PrintStats(before, nullptr);
+        return 0;
+    }
+
+    // merge first so that the merged groups are deduplicated and reordered as a whole
+    if (doMerge)
+    {
+        if (hasGroupReferenceInfo)
+        {
+            isProtected.resize(mesh.m_groups.size(), false);
+            string warning;
+            const int mergedCount = MeshOptimizer::MergeGroups(mesh, isProtected, warning);
+            if (!warning.empty())
+                printf("WARNING: %s\n", warning.c_str());
+            printf("Merged %d groups\n", mergedCount);
+        }
+        else
+        {
+            printf("Not merging groups: use --protect-header, --protect, or --no-group-references to identify the groups the vessel code uses\n");
+        }
+    }
+
+    // Merging never moves a protected group, so each protected index still refers to the same group here.
+    for (size_t i = 0; (i < isProtected.size()) && (i < mesh.m_groups.size()); i++)
+        mesh.m_groups[i].isProtected = isProtected[i];
+
+    const int removedVertexCount = MeshOptimizer::OptimizeGroups(mesh, precision, doDedup, doReorder);
+    if (doDedup)
+        printf("Removed %d duplicate or unused vertices\n", removedVertexCount);
+
+    if (!mesh.Write(pOutputFilespec, precision, error))
+    {
+        fprintf(stderr, "ERROR: %s\n", error.c_str());
+        return 2;
+    }
+    printf("Wrote %s\n", pOutputFilespec);
+
+    // read the output back both to time the parse and to verify that it is valid
+    MshFile optimizedMesh;
+    MeshStats after;
+    if (!ReadMesh(pOutputFilespec, optimizedMesh, after, error))
+    {
+        fprintf(stderr, "ERROR: cannot read back %s: %s\n", pOutputFilespec, error.c_str());
+        return 2;
+    }
+
+    PrintStats(before, &after);
+    return 0;
+}
@@ -0,0 +1,224 @@
+/**
+  XRFlightDataExport for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRFlightDataExport.cpp : exports XR flight data recorder (.xrfdr) files
+// to CSV.
+//
+// Builds with Visual Studio (XRFlightDataExport.sln) or on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRFlightDataReader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char *PROGRAM_NAME   = "XRFlightDataExport";
+const char *VERSION        = "1.0";
+const char *COPYRIGHT_YEAR = "2006-2021";
+
+static void Usage()
+{
+    printf("Usage: %s [options] <input.xrfdr> [output.csv]\n", PROGRAM_NAME);
+    printf("If no output file is specified, the CSV data is written to stdout.\n\n");
+    printf("Options:\n");
+    printf("  --list                 show the file header and recorded channels instead of exporting\n");
+    printf("  --from <seconds>       export only frames at or after this sim time\n");
+    printf("  --to <seconds>         export only frames at or before this sim time\n");
+    printf("  --channels <list>      export only these channels, in this order; e.g., Altitude,Airspeed,Pitch\n");
+}
+
+static void ListFile(const XRFlightDataReader &reader)
+{
+    const XRFDRFileHeader &header = reader.GetHeader();
+    printf("Vessel:   %s (%s)\n", header.VesselName, header.VesselClass);
+    printf("MJD:      %.6f\n", header.StartMJD);
+    printf("Blocks:   %d (%d frames per block)\n", reader.GetBlockCount(), XRFDR_BLOCK_FRAMES);
+    printf("Channels: %d\n", reader.GetChannelCount());
+    for (int i = 0; i < reader.GetChannelCount(); i++)
+        printf("  %-28s %s\n", reader.GetChannelName(i), reader.GetChannelUnits(i));
+}
+
+// Parse a comma-separated list of channel names into channel indices.
+// Returns: true on success, false if a channel is not in the file
+static bool ParseChannelList(const XRFlightDataReader &reader, const char *pList, vector<int> &channelsOut)
+{
+    string list(pList);
+    size_t start = 0;
+    while (start <= list.size())
+    {
+        size_t end = list.find(',', start);
+        if (end == string::npos)
+            end = list.size();
+
+        const string name = list.substr(start, end - start);
+        if (!name.empty())
+        {
+            const int channelIndex = reader.FindChannel(name.c_str());
+            if (channelIndex < 0)
+            {
+                fprintf(stderr, "Error: channel '%s' was not recorded in this file; use --list to see the recorded channels.\n", name.c_str());
+                return false;
+            }
+            channelsOut.push_back(channelIndex);
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pInputFile = nullptr;
+    const char *pOutputFile = nullptr;
+    const char *pChannelList = nullptr;
+    bool listOnly = false;
+    double fromSimt = -1e300, toSimt = 1e300;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (strcmp(pArg, "--list") == 0)
+            listOnly = true;
+        else if ((strcmp(pArg, "--from") == 0) && hasValue)
+            fromSimt = atof(argv[++i]);
+        else if ((strcmp(pArg, "--to") == 0) && hasValue)
+            toSimt = atof(argv[++i]);
+        else if ((strcmp(pArg, "--channels") == 0) && hasValue)
+            pChannelList = argv[++i];
+        else if ((pArg[0] == '-') && (pArg[1] != 0))
+        {
+            Usage();
+            return 1;
+        }
+        else if (pInputFile == nullptr)
+            pInputFile = pArg;
+        else if (pOutputFile == nullptr)
+            pOutputFile = pArg;
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    if (pInputFile == nullptr)
+    {
+        fprintf(stderr, "%s %s  Copyright (C) %s Douglas Beachy\n\n", PROGRAM_NAME, VERSION, COPYRIGHT_YEAR);
+        Usage();
+        return 1;
+    }
+
+    XRFlightDataReader reader;
+    string errorMsg;
+    if (!reader.Open(pInputFile, errorMsg))
+    {
+        fprintf(stderr, "Error: %s: %s\n", pInputFile, errorMsg.c_str());
+        return 2;
+    }
+
+    if (listOnly)
+    {
+        ListFile(reader);
+        return 0;
+    }
+
+    vector<int> channels;
+    if (pChannelList != nullptr)
+    {
+        if (!ParseChannelList(reader, pChannelList, channels))
+            return 1;
+    }
+    else
+    {
+        for (int i = 0; i < reader.GetChannelCount(); i++)
+            channels.push_back(i);
+    }
+
+    FILE *pOut = stdout;
+    if (pOutputFile != nullptr)
+    {
+        pOut = fopen(pOutputFile, "w");
+        if (pOut == nullptr)
+        {
+            fprintf(stderr, "Error: cannot create %s\n", pOutputFile);
+            return 2;
+        }
+    }
+
+    // header row: "SimTime (s),Altitude (m),..."
+    fprintf(pOut, "SimTime (s)");
+    for (const int channelIndex : channels)
+    {
+        const char *pUnits = reader.GetChannelUnits(channelIndex);
+        if (*pUnits != 0)
+            fprintf(pOut, ",%s (%s)", reader.GetChannelName(channelIndex), pUnits);
+        else
+            fprintf(pOut, ",%s", reader.GetChannelName(channelIndex));
+    }
+    fprintf(pOut, "\n");
+
+    // Gather the column pointers once per block so each row is a straight walk across the selected columns.
+    vector<const float *> columns(channels.size());
+    int exitCode = 0;
+    long long rowsWritten = 0;
+    for (int blockIndex = 0; blockIndex < reader.GetBlockCount(); blockIndex++)
+    {
+        const void *pBlock = reader.ReadBlock(blockIndex);
+        if (pBlock == nullptr)
+        {
+            fprintf(stderr, "Error: cannot read block %d; the file may be truncated.\n", blockIndex);
+            exitCode = 2;
+            break;
+        }
+
+        const int frameCount = XRFlightDataReader::GetFrameCount(pBlock);
+        const double *pSimTimes = XRFDRGetSimTimes(pBlock);
+        if ((frameCount == 0) || (pSimTimes[frameCount - 1] < fromSimt))
+            continue;   // entire block precedes the range
+        if (pSimTimes[0] > toSimt)
+            break;      // sim time only increases, so we're done
+
+        for (size_t i = 0; i < channels.size(); i++)
+            columns[i] = XRFDRGetChannelValues(pBlock, channels[i]);
+
+        for (int frame = 0; frame < frameCount; frame++)
+        {
+            const double simt = pSimTimes[frame];
+            if ((simt < fromSimt) || (simt > toSimt))
+                continue;
+
+            fprintf(pOut, "%.4f", simt);
+            for (const float *pColumn : columns)
+                fprintf(pOut, ",%.7g", pColumn[frame]);
+            fprintf(pOut, "\n");
+            rowsWritten++;
+        }
+    }
+
+    if (pOut != stdout)
+    {
+        fclose(pOut);
+        fprintf(stderr, "Wrote %lld rows x %d channels to %s\n", rowsWritten, static_cast<int>(channels.size()), pOutputFile);
+    }
+    return exitCode;
+}
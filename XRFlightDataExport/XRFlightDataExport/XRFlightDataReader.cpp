@@ -0,0 +1,123 @@
+/**
+  XRFlightDataExport for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRFlightDataReader.cpp : reads XR flight data recorder (.xrfdr) files.
+//-------------------------------------------------------------------------
+
+#include "XRFlightDataReader.h"
+#include <string.h>
+
+#ifdef _WIN32
+#define strcasecmp _stricmp
+#define fseek64 _fseeki64
+#else
+#include <strings.h>
+#define fseek64 fseeko
+#endif
+
+XRFlightDataReader::XRFlightDataReader() :
+    m_pFile(nullptr)
+{
+    memset(&m_header, 0, sizeof(m_header));
+}
+
+XRFlightDataReader::~XRFlightDataReader()
+{
+    Close();
+}
+
+// Open a flight data file and validate its header.
+// Returns: true on success, false on error (errorMsgOut is set)
+bool XRFlightDataReader::Open(const char *pFilespec, string &errorMsgOut)
+{
+    Close();
+
+    m_pFile = fopen(pFilespec, "rb");
+    if (m_pFile == nullptr)
+    {
+        errorMsgOut = string("cannot open ") + pFilespec;
+        return false;
+    }
+
+    bool ok = (fread(&m_header, sizeof(m_header), 1, m_pFile) == 1);
+    if (!ok)
+        errorMsgOut = "file is too short to be a flight data file";
+    else if (m_header.Magic != XRFDR_MAGIC)
+        errorMsgOut = "not a flight data file";
+    else if (m_header.FormatVersion != XRFDR_FORMAT_VERSION)
+        errorMsgOut = "unsupported flight data format version " + to_string(m_header.FormatVersion);
+    else if ((m_header.HeaderSize != sizeof(XRFDRFileHeader)) || (m_header.BlockFrames != XRFDR_BLOCK_FRAMES) ||
+             (m_header.ChannelCount == 0) || (m_header.ChannelCount > XRFDR_MAX_CHANNELS) || 
+             (m_header.BlockSize != XRFDRBlockSize(m_header.ChannelCount)))
+        errorMsgOut = "flight data file header is corrupt";
+    else
+    {
+        // ensure all strings are terminated even if the file is damaged
+        m_header.VesselName[XRFDR_VESSEL_NAME_LEN - 1] = 0;
+        m_header.VesselClass[XRFDR_VESSEL_NAME_LEN - 1] = 0;
+        for (uint32_t i = 0; i < m_header.ChannelCount; i++)
+        {
+            m_header.Channels[i].Name[XRFDR_NAME_LEN - 1] = 0;
+            m_header.Channels[i].Units[XRFDR_UNITS_LEN - 1] = 0;
+        }
+        m_blockBuffer.resize(m_header.BlockSize);
+        return true;
+    }
+
+    Close();
+    return false;
+}
+
+void XRFlightDataReader::Close()
+{
+    if (m_pFile != nullptr)
+    {
+        fclose(m_pFile);
+        m_pFile = nullptr;
+    }
+}
+
+int XRFlightDataReader::FindChannel(const char *pName) const
+{
+    for (int i = 0; i < GetChannelCount(); i++)
+    {
+        if (strcasecmp(m_header.Channels[i].Name, pName) == 0)
+            return i;
+    }
+    return -1;
+}
+
+const void *XRFlightDataReader::ReadBlock(const int blockIndex)
+{
+    if ((m_pFile == nullptr) || (blockIndex < 0) || (blockIndex >= GetBlockCount()))
+        return nullptr;
+
+    const long long offset = static_cast<long long>(m_header.HeaderSize) + (static_cast<long long>(blockIndex) * m_header.BlockSize);
+    if ((fseek64(m_pFile, offset, SEEK_SET) != 0) || (fread(m_blockBuffer.data(), m_header.BlockSize, 1, m_pFile) != 1))
+        return nullptr;
+
+    const void *pBlock = m_blockBuffer.data();
+    if (GetFrameCount(pBlock) > XRFDR_BLOCK_FRAMES)
+        return nullptr;     // corrupt
+
+    return pBlock;
+}
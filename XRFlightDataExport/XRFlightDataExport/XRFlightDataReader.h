@@ -0,0 +1,64 @@
+/**
+  XRFlightDataExport for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRFlightDataReader.h : reads XR flight data recorder (.xrfdr) files.
+//
+// Blocks are read one at a time, so files of any length may be processed
+// with constant memory.  The file layout is defined in XRFlightDataFormat.h
+// in the XR vessel framework.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include "XRFlightDataFormat.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class XRFlightDataReader
+{
+public:
+    XRFlightDataReader();
+    virtual ~XRFlightDataReader();
+
+    bool Open(const char *pFilespec, string &errorMsgOut);
+    void Close();
+
+    const XRFDRFileHeader &GetHeader() const { return m_header; }
+    int GetChannelCount() const { return static_cast<int>(m_header.ChannelCount); }
+    int GetBlockCount() const { return static_cast<int>(m_header.BlockCount); }
+    const char *GetChannelName(const int channelIndex) const { return m_header.Channels[channelIndex].Name; }
+    const char *GetChannelUnits(const int channelIndex) const { return m_header.Channels[channelIndex].Units; }
+    int FindChannel(const char *pName) const;   // case-insensitive; returns -1 if not found
+
+    // Reads the specified block; the returned pointer is valid until the next call to ReadBlock or Close.
+    // Returns nullptr on error.
+    const void *ReadBlock(const int blockIndex);
+    static int GetFrameCount(const void *pBlock) { return static_cast<int>(static_cast<const XRFDRBlockHeader *>(pBlock)->FrameCount); }
+
+protected:
+    FILE *m_pFile;
+    XRFDRFileHeader m_header;
+    vector<unsigned char> m_blockBuffer;
+};
@@ -0,0 +1,141 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// AeroCoeffTableTests.cpp : AeroCoeffTable lookups against the XR1
+// airfoil coefficient functions they replace.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "DeltaGliderXR1.h"
+#include "AeroCoeffTable.h"
+
+using namespace XRTests;
+
+// The only error should come from interpolating across a kink in one of the source function's curves,
+// and that is limited by the 0.1 degree and 0.01 Mach grid spacing.
+static const double COEFF_TOLERANCE = 0.001;
+
+// Returns the largest difference between the table and its source function over the given number of random points
+// from -180 to +180 degrees and Mach 0 to 45, which includes the pass-through range above MAX_TABLE_MACH.
+static double GetMaxTableError(const AeroCoeffTable &table, AirfoilCoeffFuncEx pSourceFunc, const int pointCount)
+{
+    unsigned int seed = 12345;  // repeatable
+    double maxError = 0;
+    for (int i = 0; i < pointCount; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const double alpha = -PI + (2 * PI) * ((seed >> 8) / 16777216.0);
+        seed = seed * 1103515245 + 12345;
+        const double mach = 45.0 * ((seed >> 8) / 16777216.0);
+
+        double cl, cm, cd, liveCL, liveCM, liveCD;
+        table.GetCoeffs(alpha, mach, &cl, &cm, &cd);
+        pSourceFunc(nullptr, alpha, mach, 1e7, nullptr, &liveCL, &liveCM, &liveCD);
+        maxError = max(maxError, max(fabs(cl - liveCL), max(fabs(cm - liveCM), fabs(cd - liveCD))));
+    }
+    return maxError;
+}
+
+// Returns the largest difference between the table and its source function at every grid node below Mach 5.
+static double GetMaxNodeError(const AeroCoeffTable &table, AirfoilCoeffFuncEx pSourceFunc)
+{
+    const double alphaStep = (2 * PI) / AeroCoeffTable::ALPHA_CELL_COUNT;
+    const double machStep = AeroCoeffTable::MAX_TABLE_MACH / AeroCoeffTable::MACH_CELL_COUNT;
+    double maxError = 0;
+    for (int i = 0; i <= AeroCoeffTable::ALPHA_CELL_COUNT; i++)
+    {
+        for (int j = 0; j <= 500; j += 7)
+        {
+            const double alpha = -PI + (i * alphaStep);
+            double cl, cm, cd, liveCL, liveCM, liveCD;
+            table.GetCoeffs(alpha, j * machStep, &cl, &cm, &cd);
+            pSourceFunc(nullptr, alpha, j * machStep, 1e7, nullptr, &liveCL, &liveCM, &liveCD);
+            maxError = max(maxError, max(fabs(cl - liveCL), max(fabs(cm - liveCM), fabs(cd - liveCD))));
+        }
+    }
+    return maxError;
+}
+
+XR_TEST(AeroCoeffTableMatchesXR1Airfoils)
+{
+    const AeroCoeffTable &vTable = *DeltaGliderXR1::GetVLiftCoeffTable();
+    const AeroCoeffTable &hTable = *DeltaGliderXR1::GetHLiftCoeffTable();
+    XR_CHECK(vTable.IsTableValid());
+    XR_CHECK(hTable.IsTableValid());
+
+    XR_CHECK(GetMaxNodeError(vTable, DeltaGliderXR1::VLiftCoeff) <= 1e-9);
+    XR_CHECK(GetMaxNodeError(hTable, DeltaGliderXR1::HLiftCoeff) <= 1e-9);
+    XR_CHECK(GetMaxTableError(vTable, DeltaGliderXR1::VLiftCoeff, 1000000) <= COEFF_TOLERANCE);
+    XR_CHECK(GetMaxTableError(hTable, DeltaGliderXR1::HLiftCoeff, 1000000) <= COEFF_TOLERANCE);
+
+    // out-of-range angles are clamped to the table rather than read past it
+    double cl, cm, cd, liveCL, liveCM, liveCD;
+    vTable.GetCoeffs(PI + 0.01, 1.0, &cl, &cm, &cd);
+    DeltaGliderXR1::VLiftCoeff(nullptr, PI, 1.0, 1e7, nullptr, &liveCL, &liveCM, &liveCD);
+    XR_CHECK_NEAR(liveCL, cl, 1e-9);
+    XR_CHECK_NEAR(liveCD, cd, 1e-9);
+}
+
+// a coefficient function in which Mach changes lift, so it cannot be split into angle and Mach terms
+static void MachDependentLift(VESSEL *v, double aoa, double M, double Re, void *context, double *cl, double *cm, double *cd)
+{
+    *cl = sin(aoa) * (1.0 + 0.1 * M);
+    *cm = 0;
+    *cd = 0.05 + 0.01 * M;
+}
+
+XR_TEST(AeroCoeffTablePassesThroughNonSeparableFunctions)
+{
+    static const AeroCoeffTable s_table(MachDependentLift);   // too large for the stack
+    XR_CHECK(!s_table.IsTableValid());
+    XR_CHECK(GetMaxTableError(s_table, MachDependentLift, 10000) == 0);
+}
+
+//-------------------------------------------------------------------------
+// one table lookup per op, with the same sweep as XR1VLiftCoeff and XR1HLiftCoeff
+
+XR_BENCH(AeroCoeffTableVLift)
+{
+    const AeroCoeffTable *pTable = DeltaGliderXR1::GetVLiftCoeffTable();
+    double cl, cm, cd;
+    for (long i = 0; i < iterations; i++)
+    {
+        const double aoa = ((i % 360) - 180) * RAD;
+        AeroCoeffTable::AirfoilCoeffFunc(nullptr, aoa, (i % 25) * 0.1, 1e7, const_cast<AeroCoeffTable *>(pTable), &cl, &cm, &cd);
+        g_sink = cl + cm + cd;
+    }
+}
+
+XR_BENCH(AeroCoeffTableHLift)
+{
+    const AeroCoeffTable *pTable = DeltaGliderXR1::GetHLiftCoeffTable();
+    double cl, cm, cd;
+    for (long i = 0; i < iterations; i++)
+    {
+        const double beta = ((i % 360) - 180) * RAD;
+        AeroCoeffTable::AirfoilCoeffFunc(nullptr, beta, (i % 25) * 0.1, 1e7, const_cast<AeroCoeffTable *>(pTable), &cl, &cm, &cd);
+        g_sink = cl + cm + cd;
+    }
+}
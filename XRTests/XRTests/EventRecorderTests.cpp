@@ -0,0 +1,295 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// EventRecorderTests.cpp : .xrevt files written by XREventRecorder and read
+// back by XREventPlayer, and the XR1's playback event table.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XREventRecorder.h"
+#include "XR1PlaybackEvents.h"
+#include "DeltaGliderXR1.h"
+#include "XRFlightDataRecorder.h"   // for XRFDR_OUTPUT_FOLDER
+#include <stdio.h>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+static const char *TEST_VESSEL_NAME = "XR1-01";
+static const double START_MJD = 59000.25;
+
+// Returns the MJD the supplied number of seconds after START_MJD
+static double AtSeconds(const double seconds)
+{
+    return START_MJD + (seconds / 86400);
+}
+
+// Records the supplied events for TEST_VESSEL_NAME, starting at the supplied MJD; each event is { seconds, type, value }.
+static void WriteEventFile(const double startMJD, const vector<vector<int>> &events)
+{
+    XREventRecorder recorder;
+    XR_CHECK(recorder.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, "DeltaGliderXR1", startMJD));
+    for (const vector<int> &event : events)
+        recorder.Record(startMJD + (event[0] / 86400.0), event[1], event[2]);
+    recorder.Close();
+}
+
+// Returns the name of the event file that WriteEventFile wrote for the supplied start MJD
+static string GetEventFilename(const double startMJD)
+{
+    char filename[MAX_PATH];
+    sprintf(filename, "%s/%s-%.6lf%s", XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, startMJD, XREVT_FILE_EXTENSION);
+    return filename;
+}
+
+// Keeps track of the door and autopilot actions that the playback events invoke.
+class PlaybackXR1 : public DeltaGliderXR1
+{
+public:
+    PlaybackXR1() : m_autopilotMode(AUTOPILOT::AP_NOTSET)
+    {
+        m_name = TEST_VESSEL_NAME;
+        m_className = "DeltaGliderXR1";
+    }
+
+    virtual void ActivateLandingGear(DoorStatus action) { m_gearActions.push_back(action); }
+    virtual void ActivateRadiator(DoorStatus action) { m_radiatorActions.push_back(action); }
+    virtual void SetCustomAutopilotMode(AUTOPILOT mode, bool, bool) { m_autopilotMode = mode; }
+
+    // Dispatches an Orbiter playback event, as clbkPlaybackEvent does
+    bool PlayOrbiterEvent(const char *pEventType, const char *pEvent)
+    {
+        const XRPlaybackEventTable &table = GetPlaybackEventTable();
+        const XR_EVENT_TYPE type = table.Find(pEventType);
+        XREventRecord record;
+        memset(&record, 0, sizeof(record));
+        record.Type = static_cast<uint16_t>(type);
+        record.Value = static_cast<uint8_t>(XRPlaybackEventTable::ParseValue(pEvent, table.IsValueCaseSensitive(type)));
+        return table.Dispatch(*this, record);
+    }
+
+    vector<DoorStatus> m_gearActions;
+    vector<DoorStatus> m_radiatorActions;
+    AUTOPILOT m_autopilotMode;
+};
+
+XR_TEST(EventRecorderRoundTrip)
+{
+    TempFolder folder("EventRecorderRoundTrip");
+    {
+        XREventRecorder recorder;
+        XR_CHECK(recorder.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, "DeltaGliderXR1", START_MJD));
+        recorder.Record(AtSeconds(10), 1, 3);
+        recorder.Record(AtSeconds(10), 2, 2);
+        recorder.Record(AtSeconds(25.5), 26, 9, 1, 4.5f, -2.0f, 0.25f);
+        recorder.Close();
+    }
+
+    XREventPlayer player;
+    XR_CHECK(player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, START_MJD));
+    XR_CHECK(player.IsOpen());
+    XR_CHECK(player.GetNextDueRecord(AtSeconds(9.9)) == nullptr);
+
+    // both events recorded at the same time are due together, in the order they were recorded
+    const XREventRecord *pRecord = player.GetNextDueRecord(AtSeconds(10));
+    XR_CHECK(pRecord != nullptr);
+    if (pRecord != nullptr)
+    {
+        XR_CHECK_NEAR(10.0, pRecord->EventTime, 1e-3);
+        XR_CHECK_EQUAL(1, static_cast<int>(pRecord->Type));
+        XR_CHECK_EQUAL(3, static_cast<int>(pRecord->Value));
+    }
+    pRecord = player.GetNextDueRecord(AtSeconds(10));
+    XR_CHECK((pRecord != nullptr) && (pRecord->Type == 2) && (pRecord->Value == 2));
+    XR_CHECK(player.GetNextDueRecord(AtSeconds(10)) == nullptr);
+
+    pRecord = player.GetNextDueRecord(AtSeconds(60));
+    XR_CHECK(pRecord != nullptr);
+    if (pRecord != nullptr)
+    {
+        XR_CHECK_NEAR(25.5, pRecord->EventTime, 1e-3);
+        XR_CHECK_EQUAL(26, static_cast<int>(pRecord->Type));
+        XR_CHECK_EQUAL(9, static_cast<int>(pRecord->Value));
+        XR_CHECK_EQUAL(1, static_cast<int>(pRecord->Flags));
+        XR_CHECK_NEAR(4.5, pRecord->Args[0], 0);
+        XR_CHECK_NEAR(-2.0, pRecord->Args[1], 0);
+        XR_CHECK_NEAR(0.25, pRecord->Args[2], 0);
+    }
+    XR_CHECK(player.GetNextDueRecord(AtSeconds(60)) == nullptr);
+}
+
+// A vessel's event files are told apart by the MJD at which each recording started
+XR_TEST(EventRecorderMatchesStartMJD)
+{
+    TempFolder folder("EventRecorderMatchesStartMJD");
+    const double laterMJD = START_MJD + 1.5;
+    WriteEventFile(START_MJD, { { 1, 1, 3 } });
+    WriteEventFile(laterMJD, { { 1, 1, 4 } });
+
+    // playback may start up to a second from the recorded MJD
+    XREventPlayer player;
+    XR_CHECK(player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, AtSeconds(0.5)));
+    const XREventRecord *pRecord = player.GetNextDueRecord(AtSeconds(2));
+    XR_CHECK((pRecord != nullptr) && (pRecord->Value == 3));
+
+    XR_CHECK(player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, laterMJD - (0.5 / 86400)));
+    pRecord = player.GetNextDueRecord(laterMJD + (2.0 / 86400));
+    XR_CHECK((pRecord != nullptr) && (pRecord->Value == 4));
+
+    XR_CHECK(!player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, AtSeconds(2)));
+    XR_CHECK(!player.IsOpen());
+    XR_CHECK(!player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, AtSeconds(-2)));
+    XR_CHECK(!player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, START_MJD + 0.75));
+
+    // "XR1" matches the filename pattern of "XR1-01", but not its header
+    XR_CHECK(!player.Open(XRFDR_OUTPUT_FOLDER, "XR1", START_MJD));
+    XR_CHECK(!player.Open(XRFDR_OUTPUT_FOLDER, "XR1-02", START_MJD));
+    XR_CHECK(!player.Open("NoSuchFolder", TEST_VESSEL_NAME, START_MJD));
+}
+
+// A recording that was cut short keeps its complete records
+XR_TEST(EventRecorderIgnoresTruncatedRecord)
+{
+    TempFolder folder("EventRecorderIgnoresTruncatedRecord");
+    WriteEventFile(START_MJD, { { 1, 1, 3 }, { 2, 1, 4 } });
+
+    FILE *pFile = fopen(GetEventFilename(START_MJD).c_str(), "ab");
+    XR_CHECK(pFile != nullptr);
+    if (pFile == nullptr)
+        return;
+    XREventRecord partialRecord;
+    memset(&partialRecord, 0, sizeof(partialRecord));
+    partialRecord.Type = 1;
+    fwrite(&partialRecord, sizeof(partialRecord) / 2, 1, pFile);
+    fclose(pFile);
+
+    XREventPlayer player;
+    XR_CHECK(player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, START_MJD));
+    int recordCount = 0;
+    while (player.GetNextDueRecord(AtSeconds(3600)) != nullptr)
+        recordCount++;
+    XR_CHECK_EQUAL(2, recordCount);
+
+    // a file cut short inside its header is not an event file at all
+    pFile = fopen(GetEventFilename(START_MJD).c_str(), "r+b");
+    XR_CHECK(pFile != nullptr);
+    if (pFile == nullptr)
+        return;
+    ftruncate(fileno(pFile), sizeof(XREventFileHeader) - 1);
+    fclose(pFile);
+    XR_CHECK(!player.Open(XRFDR_OUTPUT_FOLDER, TEST_VESSEL_NAME, START_MJD));
+}
+
+// The dump events have always required an exact "ON", while all other values match without regard to case
+XR_TEST(PlaybackEventDumpValuesAreCaseSensitive)
+{
+    PlaybackXR1 xr1;
+    const XRPlaybackEventTable &table = xr1.GetPlaybackEventTable();
+
+    const XR_EVENT_TYPE dumpTypes[] = { XR_EVENT_TYPE::MAINDUMP, XR_EVENT_TYPE::RCSDUMP, XR_EVENT_TYPE::SCRAMDUMP, XR_EVENT_TYPE::APUDUMP, XR_EVENT_TYPE::LOXDUMP };
+    for (const XR_EVENT_TYPE type : dumpTypes)
+        XR_CHECK(table.IsValueCaseSensitive(type));
+    XR_CHECK(!table.IsValueCaseSensitive(XR_EVENT_TYPE::GEAR));
+    XR_CHECK(!table.IsValueCaseSensitive(XR_EVENT_TYPE::NAVLIGHT));
+
+    XR_CHECK(XRPlaybackEventTable::ParseValue("ON", true) == XR_EVENT_VALUE::ON);
+    XR_CHECK(XRPlaybackEventTable::ParseValue("on", true) == XR_EVENT_VALUE::NONE);
+    XR_CHECK(XRPlaybackEventTable::ParseValue("On", true) == XR_EVENT_VALUE::NONE);
+    XR_CHECK(XRPlaybackEventTable::ParseValue("on", false) == XR_EVENT_VALUE::ON);
+    XR_CHECK(XRPlaybackEventTable::ParseValue("up", false) == XR_EVENT_VALUE::UP);
+    XR_CHECK(XRPlaybackEventTable::ParseValue("ONN", false) == XR_EVENT_VALUE::NONE);
+
+    // event names still match without regard to case
+    XR_CHECK(xr1.PlayOrbiterEvent("maindump", "ON"));
+    XR_CHECK(xr1.m_mainFuelDumpInProgress);
+    XR_CHECK(xr1.PlayOrbiterEvent("MAINDUMP", "on"));
+    XR_CHECK(!xr1.m_mainFuelDumpInProgress);
+
+    XR_CHECK(xr1.PlayOrbiterEvent("LOXDUMP", "ON"));
+    XR_CHECK(xr1.m_loxDumpInProgress);
+    XR_CHECK(xr1.PlayOrbiterEvent("LOXDUMP", "On"));
+    XR_CHECK(!xr1.m_loxDumpInProgress);
+}
+
+// The landing gear closes only on "UP"; all other doors close on "CLOSE", and anything else opens them
+XR_TEST(PlaybackEventGearClosesOnlyOnUp)
+{
+    PlaybackXR1 xr1;
+    const char *gearValues[] = { "UP", "up", "DOWN", "CLOSE", "OPEN" };
+    for (const char *pValue : gearValues)
+        XR_CHECK(xr1.PlayOrbiterEvent("GEAR", pValue));
+    const vector<DoorStatus> expectedGear = { DoorStatus::DOOR_CLOSING, DoorStatus::DOOR_CLOSING, DoorStatus::DOOR_OPENING, DoorStatus::DOOR_OPENING, DoorStatus::DOOR_OPENING };
+    XR_CHECK(xr1.m_gearActions == expectedGear);
+
+    const char *radiatorValues[] = { "CLOSE", "UP", "OPEN" };
+    for (const char *pValue : radiatorValues)
+        XR_CHECK(xr1.PlayOrbiterEvent("RADIATOR", pValue));
+    const vector<DoorStatus> expectedRadiator = { DoorStatus::DOOR_CLOSING, DoorStatus::DOOR_OPENING, DoorStatus::DOOR_OPENING };
+    XR_CHECK(xr1.m_radiatorActions == expectedRadiator);
+}
+
+// Events recorded by one vessel are played back by another at their recorded times, including the native-only events
+XR_TEST(PlaybackEventsRoundTripThroughVessel)
+{
+    TempFolder folder("PlaybackEventsRoundTripThroughVessel");
+    {
+        PlaybackXR1 recordingXR1;
+        recordingXR1.m_recording = true;
+        recordingXR1.UpdateXREventRecorder(START_MJD);
+
+        oapiSetTestSimMJD(AtSeconds(5));
+        recordingXR1.RecordXREvent(XR_EVENT_TYPE::GEAR, XR_EVENT_VALUE::UP);
+        recordingXR1.RecordXREvent(XR_EVENT_TYPE::AUTOPILOT, XR_EVENT_VALUE::ATTITUDEHOLD, XREVT_FLAG_HOLD_AOA, 7.5f, -15.0f, 0);
+
+        recordingXR1.m_recording = false;
+        recordingXR1.UpdateXREventRecorder(AtSeconds(6));
+        XR_CHECK(!recordingXR1.m_xrEventRecorder.IsOpen());
+
+        // only the events that Orbiter has always recorded go to its flight recorder
+        const vector<string> expectedOrbiterEvents = { "GEAR UP" };
+        XR_CHECK(recordingXR1.m_recordedEvents == expectedOrbiterEvents);
+    }
+
+    PlaybackXR1 xr1;
+    xr1.m_playback = true;
+    xr1.UpdateXREventRecorder(START_MJD);
+    XR_CHECK(xr1.m_xrEventPlayer.IsOpen());
+    xr1.UpdateXREventRecorder(AtSeconds(4));
+    XR_CHECK(xr1.m_gearActions.empty());
+    XR_CHECK(xr1.m_autopilotMode == AUTOPILOT::AP_NOTSET);
+
+    xr1.UpdateXREventRecorder(AtSeconds(5));
+    const vector<DoorStatus> expectedGear = { DoorStatus::DOOR_CLOSING };
+    XR_CHECK(xr1.m_gearActions == expectedGear);
+    XR_CHECK(xr1.m_autopilotMode == AUTOPILOT::AP_ATTITUDEHOLD);
+    XR_CHECK_NEAR(7.5, xr1.m_setPitchOrAOA, 0);
+    XR_CHECK_NEAR(-15.0, xr1.m_setBank, 0);
+    XR_CHECK(xr1.m_holdAOA);
+
+    xr1.m_playback = false;
+    xr1.UpdateXREventRecorder(AtSeconds(7));
+    XR_CHECK(!xr1.m_xrEventPlayer.IsOpen());
+}
@@ -0,0 +1,180 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// FlightDataRecorderTests.cpp : XRFlightDataRecorder files read back with
+// XRFlightDataExport's reader, including when growing the file fails.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRFlightDataRecorder.h"
+#include "XRFlightDataReader.h"
+#include <unistd.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace XRTests;
+
+// Lets a test wait for the writer thread so that no blocks are dropped, and exposes the recorder's sizes.
+class TestRecorder : public XRFlightDataRecorder
+{
+public:
+    void WaitForWriter()
+    {
+        while (m_writtenBlocks.load() < m_producedBlocks.load())
+            this_thread::yield();
+    }
+
+    size_t GetBlockSize() const { return m_blockSize; }
+    static int GetGrowBlocks() { return GROW_BLOCKS; }
+};
+
+static const int TEST_CHANNEL_GROUPS = XRFDR_GROUP_ATTITUDE | XRFDR_GROUP_FLIGHT;
+
+// the values recorded for each frame
+static void FillRecord(XRTelemetryRecord &record, const int frame)
+{
+    memset(&record, 0, sizeof(record));
+    record.SimTime = frame * 0.02;
+    record.Pitch = frame * 0.001;
+    record.Altitude = 1000.0 + frame;
+    record.GroundContact = frame % 2;
+}
+
+// Records frameCount frames, waiting for the writer thread after each block so that none are dropped.
+static void RecordFrames(TestRecorder &recorder, const int frameCount)
+{
+    XRTelemetryRecord record;
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        FillRecord(record, frame);
+        recorder.Record(record);
+        if (((frame + 1) % XRFDR_BLOCK_FRAMES) == 0)
+            recorder.WaitForWriter();
+    }
+}
+
+// Checks that the file holds the first frameCount frames recorded by RecordFrames, and that it was trimmed to its blocks.
+static void CheckFile(const string &filename, const size_t blockSize, const int frameCount)
+{
+    XRFlightDataReader reader;
+    string error;
+    XR_CHECK(reader.Open(filename.c_str(), error));
+    if (!error.empty())
+    {
+        Fail(__FILE__, __LINE__, "%s: %s", filename.c_str(), error.c_str());
+        return;
+    }
+
+    const XRFDRFileHeader &header = reader.GetHeader();
+    XR_CHECK_STR("XR5-01", header.VesselName);
+    XR_CHECK_STR("XR5Vanguard", header.VesselClass);
+    XR_CHECK_EQUAL(59000.5, header.StartMJD);
+    const int expectedBlocks = (frameCount + XRFDR_BLOCK_FRAMES - 1) / XRFDR_BLOCK_FRAMES;
+    XR_CHECK_EQUAL(expectedBlocks, reader.GetBlockCount());
+
+    struct stat st;
+    XR_CHECK(stat(filename.c_str(), &st) == 0);
+    XR_CHECK_EQUAL(static_cast<long long>(sizeof(XRFDRFileHeader) + (expectedBlocks * blockSize)), static_cast<long long>(st.st_size));
+
+    const int pitchChannel = reader.FindChannel("Pitch");
+    const int altitudeChannel = reader.FindChannel("Altitude");
+    const int groundContactChannel = reader.FindChannel("GroundContact");
+    XR_CHECK((pitchChannel >= 0) && (altitudeChannel >= 0) && (groundContactChannel >= 0));
+    XR_CHECK_EQUAL(-1, reader.FindChannel("MainFuelMass"));     // group not recorded
+    if ((pitchChannel < 0) || (altitudeChannel < 0) || (groundContactChannel < 0))
+        return;
+
+    int mismatchCount = 0;
+    XRTelemetryRecord expected;
+    for (int blockIndex = 0; blockIndex < reader.GetBlockCount(); blockIndex++)
+    {
+        const void *pBlock = reader.ReadBlock(blockIndex);
+        XR_CHECK(pBlock != nullptr);
+        if (pBlock == nullptr)
+            return;
+
+        const int firstFrame = blockIndex * XRFDR_BLOCK_FRAMES;
+        const int blockFrames = XRFlightDataReader::GetFrameCount(pBlock);
+        XR_CHECK_EQUAL(min(XRFDR_BLOCK_FRAMES, frameCount - firstFrame), blockFrames);
+        for (int row = 0; row < blockFrames; row++)
+        {
+            FillRecord(expected, firstFrame + row);
+            if ((XRFDRGetSimTimes(pBlock)[row] != expected.SimTime) ||
+                (XRFDRGetChannelValues(pBlock, pitchChannel)[row] != static_cast<float>(expected.Pitch)) ||
+                (XRFDRGetChannelValues(pBlock, altitudeChannel)[row] != static_cast<float>(expected.Altitude)) ||
+                (XRFDRGetChannelValues(pBlock, groundContactChannel)[row] != static_cast<float>(expected.GroundContact)))
+                mismatchCount++;
+        }
+    }
+    XR_CHECK_EQUAL(0, mismatchCount);
+}
+
+// Frames recorded into the ring buffer come back out of the file, across a file growth and a partial last block.
+XR_TEST(FlightDataRecorderRoundTrip)
+{
+    TempFolder folder("FlightDataRecorderRoundTrip");
+    TestRecorder recorder;
+    XR_CHECK(recorder.Open("XR5-01", "XR5Vanguard", TEST_CHANNEL_GROUPS, 59000.5));
+    XR_CHECK(recorder.IsOpen());
+    if (!recorder.IsOpen())
+        return;
+
+    const int frameCount = ((TestRecorder::GetGrowBlocks() + 2) * XRFDR_BLOCK_FRAMES) + 100;
+    RecordFrames(recorder, frameCount);
+    string filename = recorder.GetFilename();
+    replace(filename.begin(), filename.end(), '\\', '/');
+    const size_t blockSize = recorder.GetBlockSize();
+    recorder.Close();
+    XR_CHECK(!recorder.IsOpen());
+    XR_CHECK_EQUAL(0u, recorder.GetDroppedBlocks());
+
+    CheckFile(filename, blockSize, frameCount);
+}
+
+// If the file cannot grow (e.g., the disk is full), the blocks already written are kept and Close still trims the file.
+XR_TEST(FlightDataRecorderGrowthFailure)
+{
+    TempFolder folder("FlightDataRecorderGrowthFailure");
+    TestRecorder recorder;
+    XR_CHECK(recorder.Open("XR5-01", "XR5Vanguard", TEST_CHANNEL_GROUPS, 59000.5));
+    if (!recorder.IsOpen())
+        return;
+
+    // Open mapped room for the first GROW_BLOCKS blocks; the mapping that grows the file past that fails
+    XRTestsMaxMappedFileBytes() = sizeof(XRFDRFileHeader) + (TestRecorder::GetGrowBlocks() * recorder.GetBlockSize());
+
+    const int frameCount = (TestRecorder::GetGrowBlocks() + 3) * XRFDR_BLOCK_FRAMES;
+    RecordFrames(recorder, frameCount + 50);
+    string filename = recorder.GetFilename();
+    replace(filename.begin(), filename.end(), '\\', '/');
+    recorder.Close();   // must not touch the view that the failed growth unmapped
+    XRTestsMaxMappedFileBytes() = -1;
+
+    CheckFile(filename, recorder.GetBlockSize(), TestRecorder::GetGrowBlocks() * XRFDR_BLOCK_FRAMES);
+}
@@ -0,0 +1,354 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// FrameworkBench.cpp : benchmarks for the framework primitives that run
+// every frame or on every command: rolling averages, the string-keyed
+// payload maps, prefs parsing, the XRVesselCtrlDemo command parser, the
+// XR5 payload bay fit checks, the scramjet model, and the XR1 airfoils.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "DeltaGliderXR1.h"
+#include "RollingArray.h"
+#include "XRTemplates.h"
+#include "stringhasher.h"
+#include "ConfigFileParser.h"
+#include "XRPayload.h"
+#include "XRPayloadBaySlot.h"
+#include "XR5PayloadBay.h"
+#include "XRVCClientCommandParser.h"
+#include <vector>
+
+using namespace XRTests;
+
+//-------------------------------------------------------------------------
+// rolling averages: one sample added and averaged per op, as the gauges do each frame
+
+XR_BENCH(RollingArrayAddSampleGetAverage)
+{
+    RollingArray rollingArray(60);
+    for (long i = 0; i < iterations; i++)
+    {
+        rollingArray.AddSample(static_cast<double>(i & 0xFF));
+        g_sink = rollingArray.GetAverage();
+    }
+}
+
+XR_BENCH(AveragerAddSampleGetMean)
+{
+    Averager<double> averager(60);
+    for (long i = 0; i < iterations; i++)
+    {
+        averager.AddSample(static_cast<double>(i & 0xFF));
+        g_sink = averager.GetMean();
+    }
+}
+
+//-------------------------------------------------------------------------
+// stringhasher-keyed maps: one lookup per op in a map keyed like the payload classname map
+
+typedef unordered_map<const string *, int, stringhasher, stringhasher> HASHMAP_STR_INT;
+
+// Returns classnames shaped like the ones in Config\Vessels, plus enough more to fill a large installation.
+static const vector<string> &GetSampleClassnames()
+{
+    static vector<string> s_classnames;
+    if (s_classnames.empty())
+    {
+        const char *pBaseNames[] = { "XR2PayloadCHM", "XR2PayloadLOX", "XR2PayloadMainFuel", "XR2PayloadSCRAMFuel", "XRParts", "CSA_XR5_ER_LOX", "AIA_Logistics" };
+        for (const char *pBaseName : pBaseNames)
+        {
+            for (int i = 0; i < 40; i++)
+                s_classnames.push_back(string(pBaseName) + "_" + to_string(i));
+        }
+    }
+    return s_classnames;
+}
+
+XR_BENCH(StringHasherMapFind)
+{
+    const vector<string> &classnames = GetSampleClassnames();
+    HASHMAP_STR_INT map;
+    for (size_t i = 0; i < classnames.size(); i++)
+        map[&classnames[i]] = static_cast<int>(i);
+
+    for (long i = 0; i < iterations; i++)
+    {
+        const string classname = classnames[i % classnames.size()];   // a copy, as callers look up by a temporary string
+        g_sink = map.find(&classname)->second;
+    }
+
+    // the hash distribution drives the lookup time, so report the worst bucket as well
+    size_t maxBucketSize = 0;
+    for (size_t b = 0; b < map.bucket_count(); b++)
+        maxBucketSize = max(maxBucketSize, map.bucket_size(b));
+    ReportMetric("max_bucket_size", static_cast<double>(maxBucketSize));
+}
+
+//-------------------------------------------------------------------------
+// ConfigFileParser::ParseFile: all four shipped prefs files per op
+
+// Counts the name/value pairs parsed instead of storing them, so only the base class parsing is timed.
+class CountingConfigFileParser : public ConfigFileParser
+{
+public:
+    CountingConfigFileParser(const char *pFilename) : ConfigFileParser(pFilename, nullptr), m_lineCount(0) { }
+    int m_lineCount;
+
+protected:
+    virtual bool ParseLine(const char *pSection, const char *pName, const char *pValue, const bool bParsingOverrideFile)
+    {
+        m_lineCount++;
+        return true;
+    }
+};
+
+XR_BENCH(ConfigFileParserParsePrefs)
+{
+    const char *pPrefsFiles[] =
+    {
+        "DeltaGliderXR1/DeltaGliderXR1Prefs.cfg", "XR2Ravenstar/XR2RavenstarPrefs.cfg",
+        "XR3Phoenix/XR3PhoenixPrefs.cfg", "XR5Vanguard/XR5VanguardPrefs.cfg"
+    };
+
+    vector<string> paths;
+    for (const char *pFile : pPrefsFiles)
+        paths.push_back(GetRepoRoot() + "/XRVessels/" + pFile);
+
+    for (long i = 0; i < iterations; i++)
+    {
+        for (const string &path : paths)
+        {
+            CountingConfigFileParser parser(path.c_str());
+            parser.ParseFile();
+            g_sink = parser.m_lineCount;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+// XRVesselCtrlDemo command grammar: resolve and autocomplete one command per op
+
+// Exposes the parser tree; commands are resolved to their leaf nodes rather than executed since there is no vessel to command.
+class BenchCommandParser : public XRVCClientCommandParser
+{
+public:
+    BenchCommandParser(XRVCClient &client) : XRVCClientCommandParser(client) { }
+    ParserTree &GetTree() { return *m_commandParserTree; }
+};
+
+static const char *s_pSampleCommands[] =
+{
+    "Set Engine MainBoth ThrottleLevel 0.5",
+    "Set Engine ScramLeft GimbalX -0.25",
+    "Set Engine HoverFore AutoMode on",
+    "Set Door PayloadBayDoors Open",
+    "Set Door Gear Close",
+    "Set Light Strobe on",
+    "Set Other SecondaryHUDMode 3",
+    "Reset",
+};
+
+XR_BENCH(ParserTreeResolve)
+{
+    XRVCClient client;
+    BenchCommandParser parser(client);
+    const int commandCount = sizeof(s_pSampleCommands) / sizeof(s_pSampleCommands[0]);
+    vector<CString> leafArgv;
+    CString status;
+    for (long i = 0; i < iterations; i++)
+    {
+        leafArgv.clear();
+        g_sink = (parser.GetTree().Resolve(s_pSampleCommands[i % commandCount], leafArgv, status) != nullptr);
+    }
+}
+
+XR_BENCH(ParserTreeAutoComplete)
+{
+    static const char *pPartialCommands[] = { "s e mainb th", "se do pay", "s l st", "set o sec", "r" };
+    const int commandCount = sizeof(pPartialCommands) / sizeof(pPartialCommands[0]);
+
+    XRVCClient client;
+    BenchCommandParser parser(client);
+    for (long i = 0; i < iterations; i++)
+    {
+        CString csCommand = pPartialCommands[i % commandCount];
+        parser.GetTree().ResetAutocompletionState();
+        g_sink = parser.GetTree().AutoComplete(csCommand, true);
+    }
+}
+
+//-------------------------------------------------------------------------
+// XR5 payload bay: CheckSlotSpace for every XR payload class in every slot per op
+
+// A payload vessel of the given class with its XRCARGO attachment point.
+class BenchPayloadVessel : public VESSEL
+{
+public:
+    BenchPayloadVessel(const char *pClassname)
+    {
+        m_className = pClassname;
+        CreateAttachment(true, _V(0, 0, 0), _V(0, -1, 0), _V(0, 0, 1), "XRCARGO");
+    }
+};
+
+// Builds the XR5 bay and payload vessels for each XR payload class found in the Orbiter folder.
+struct XR5BayFixture
+{
+    XR5BayFixture() : pBay(nullptr)
+    {
+        vessel.m_className = "XR5Vanguard";
+        XRPayloadClassData::InitializeXRPayloadClassData();
+        for (const XRPayloadClassData **pp = XRPayloadClassData::GetAllAvailableXRPayloads(); *pp != nullptr; pp++)
+            payloadVessels.push_back(new BenchPayloadVessel((*pp)->GetClassname()));
+    }
+
+    ~XR5BayFixture()
+    {
+        delete pBay;
+        for (VESSEL *pVessel : payloadVessels)
+            delete pVessel;
+    }
+
+    // creates a new bay and sweeps every class from every slot, as XRPayloadBay::PerformFinalInitialization does
+    void CreateBay()
+    {
+        delete pBay;
+        pBay = new XR5PayloadBay(vessel);
+        const XRPayloadClassData **ppPayloadClasses = XRPayloadClassData::GetAllAvailableXRPayloads();
+        for (int slotNumber = 1; slotNumber <= pBay->GetSlotCount(); slotNumber++)
+            pBay->GetSlot(slotNumber)->PrecomputeSweeps(ppPayloadClasses);
+    }
+
+    XR5Vanguard vessel;
+    XR5PayloadBay *pBay;
+    vector<VESSEL *> payloadVessels;
+};
+
+// verifies that the fixture really resolves commands and fits payloads, so the benchmarks do not time early-outs
+XR_TEST(FrameworkBenchFixtures)
+{
+    XRVCClient client;
+    BenchCommandParser parser(client);
+    for (const char *pCommand : s_pSampleCommands)
+    {
+        vector<CString> leafArgv;
+        CString status;
+        XR_CHECK(parser.GetTree().Resolve(pCommand, leafArgv, status) != nullptr);
+    }
+
+    XR5BayFixture fixture;
+    fixture.CreateBay();
+    XR_CHECK_EQUAL(36, fixture.pBay->GetSlotCount());
+    XR_CHECK(fixture.payloadVessels.size() >= 5);
+    int fitCount = 0;
+    for (const VESSEL *pPayload : fixture.payloadVessels)
+        fitCount += fixture.pBay->GetSlot(1)->CheckSlotSpace(*pPayload);
+    XR_CHECK(fitCount > 0);
+}
+
+XR_BENCH(XR5CheckSlotSpace)
+{
+    static XR5BayFixture s_fixture;
+    if (s_fixture.pBay == nullptr)
+        s_fixture.CreateBay();
+
+    const int slotCount = s_fixture.pBay->GetSlotCount();
+    for (long i = 0; i < iterations; i++)
+    {
+        int fitCount = 0;
+        for (int slotNumber = 1; slotNumber <= slotCount; slotNumber++)
+        {
+            const XRPayloadBaySlot *pSlot = s_fixture.pBay->GetSlot(slotNumber);
+            for (const VESSEL *pPayload : s_fixture.payloadVessels)
+                fitCount += pSlot->CheckSlotSpace(*pPayload);
+        }
+        g_sink = fitCount;
+    }
+}
+
+XR_BENCH(XR5CreateBayAndSweep)
+{
+    static XR5BayFixture s_fixture;
+    for (long i = 0; i < iterations; i++)
+    {
+        s_fixture.CreateBay();
+        g_sink = s_fixture.pBay->GetSlotCount();
+    }
+}
+
+//-------------------------------------------------------------------------
+// XR1Ramjet::Thrust: both scramjets at full throttle across the flight envelope
+
+XR_BENCH(XR1RamjetThrust)
+{
+    DeltaGliderXR1 vessel;
+    vessel.m_hAtmRef = &vessel;     // any non-null reference is Earth
+    XR1Ramjet ramjet(&vessel);
+    for (int i = 0; i < 2; i++)
+    {
+        THRUSTER_HANDLE th = vessel.CreateThruster(_V(0, 0, -5.6), _V(0, 0, 1), 0);
+        vessel.SetThrusterLevel(th, 1.0);
+        ramjet.AddThrusterDefinition(th, SCRAM_FHV[1], SCRAM_INTAKE_AREA, SCRAM_INTERNAL_TEMAX, 2.0);
+    }
+
+    double F[2];
+    for (long i = 0; i < iterations; i++)
+    {
+        // Mach 3 to 17 at altitudes with matching air density and temperature
+        const double frac = (i % 100) / 100.0;
+        vessel.m_mach = 3.0 + (14.0 * frac);
+        vessel.m_atmTemperature = 220.0 + (30.0 * frac);
+        vessel.m_atmDensity = 0.1 * (1.0 - frac) + 1e-4;
+        vessel.m_atmPressure = vessel.m_atmDensity * 286.91 * vessel.m_atmTemperature;
+        ramjet.Thrust(F);
+        g_sink = F[0] + F[1];
+    }
+}
+
+//-------------------------------------------------------------------------
+// XR1 airfoil coefficients: one call per op, sweeping AoA or slip and Mach
+
+XR_BENCH(XR1VLiftCoeff)
+{
+    double cl, cm, cd;
+    for (long i = 0; i < iterations; i++)
+    {
+        const double aoa = ((i % 360) - 180) * RAD;
+        DeltaGliderXR1::VLiftCoeff(nullptr, aoa, (i % 25) * 0.1, 1e7, nullptr, &cl, &cm, &cd);
+        g_sink = cl + cm + cd;
+    }
+}
+
+XR_BENCH(XR1HLiftCoeff)
+{
+    double cl, cm, cd;
+    for (long i = 0; i < iterations; i++)
+    {
+        const double beta = ((i % 360) - 180) * RAD;
+        DeltaGliderXR1::HLiftCoeff(nullptr, beta, (i % 25) * 0.1, 1e7, nullptr, &cl, &cm, &cd);
+        g_sink = cl + cm + cd;
+    }
+}
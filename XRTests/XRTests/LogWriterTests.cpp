@@ -0,0 +1,375 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// LogWriterTests.cpp : XRLogWriter with several vessels logging to one
+// file at once, against the synchronous fprintf/fflush path it replaced,
+// and dropping messages rather than blocking when its queue is full.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRLogWriter.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+typedef chrono::steady_clock Clock;
+
+static const int WRITE_SAMPLE_INTERVAL = 16;    // time every Nth call so that the clock reads do not dominate the benchmark
+static const double MAX_WRITE_NS_P99 = 20000;   // Write never waits for the writer thread, so only a context switch should take this long
+
+// Returns a log file path unique to this process; any previous file is deleted.
+static string GetTempLogPath(const char *pName)
+{
+    char path[256];
+    sprintf(path, "/tmp/XRTests-%s-%d.log", pName, static_cast<int>(getpid()));
+    remove(path);
+    return path;
+}
+
+// Each vessel thread writes messageCount messages tagged "XR-nn", recording the duration of every
+// WRITE_SAMPLE_INTERVAL-th call in pSamples if supplied.
+static void RunVessels(XRLogWriter *pWriter, const int vesselCount, const long messageCount, vector<double> *pSamples)
+{
+    vector<vector<double>> samples(vesselCount);
+    vector<thread> threads;
+    for (int v = 0; v < vesselCount; v++)
+    {
+        threads.emplace_back([=, &samples]
+        {
+            char prefix[16];
+            sprintf(prefix, "XR-%02d", v);
+            char msg[64];
+            for (long i = 0; i < messageCount; i++)
+            {
+                sprintf(msg, "msg %ld", i);
+                if (pSamples && ((i % WRITE_SAMPLE_INTERVAL) == 0))
+                {
+                    const Clock::time_point start = Clock::now();
+                    pWriter->Write(prefix, msg);
+                    samples[v].push_back(chrono::duration<double, nano>(Clock::now() - start).count());
+                }
+                else
+                {
+                    pWriter->Write(prefix, msg);
+                }
+            }
+        });
+    }
+    for (thread &t : threads)
+        t.join();
+
+    if (pSamples)
+    {
+        for (const vector<double> &s : samples)
+            pSamples->insert(pSamples->end(), s.begin(), s.end());
+    }
+}
+
+// Returns: the 99th percentile sample, or 0 if there are no samples
+static double ReportWriteLatency(vector<double> &samples)
+{
+    if (samples.empty())
+        return 0;
+
+    sort(samples.begin(), samples.end());
+    const double p99 = samples[samples.size() * 99 / 100];
+    ReportMetric("write_ns_p50", samples[samples.size() / 2]);
+    ReportMetric("write_ns_p99", p99);
+    return p99;
+}
+
+// Returns true if the line has the "MM.DD.YYYY HH:MM:SS.mmm - " timestamp written by the log writer.
+static bool HasTimestamp(const char *pLine)
+{
+    static const char TEMPLATE[] = "00.00.0000 00:00:00.000 - ";
+    for (int i = 0; TEMPLATE[i] != 0; i++)
+    {
+        if ((TEMPLATE[i] == '0') ? !isdigit(static_cast<unsigned char>(pLine[i])) : (pLine[i] != TEMPLATE[i]))
+            return false;
+    }
+    return true;
+}
+
+XR_TEST(XRLogWriterKeepsEveryMessageInOrder)
+{
+    const int vesselCount = 8;
+    const long messageCount = 60;       // per vessel; all of the messages fit in the queue at once, so none may be dropped
+    const string path = GetTempLogPath("LogWriterOrder");
+
+    XRLogWriter *pWriter = XRLogWriter::Open(path.c_str());
+    XR_CHECK(pWriter != nullptr);
+    if (pWriter == nullptr)
+        return;
+
+    // vessels logging to the same file share one writer, regardless of case
+    string upperPath = path;
+    for (char &c : upperPath)
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    XR_CHECK(XRLogWriter::Open(upperPath.c_str()) == pWriter);
+
+    RunVessels(pWriter, vesselCount, messageCount, nullptr);
+
+    // over-long messages are truncated, and an empty prefix is omitted
+    const string longMsg(XRLOG_MAX_MESSAGE_LENGTH * 2, 'x');
+    pWriter->Write("XR-LONG", longMsg.c_str());
+    pWriter->Write("", "no prefix");
+    XRLogWriter::Terminate();
+
+    FILE *pFile = fopen(path.c_str(), "rt");
+    XR_CHECK(pFile != nullptr);
+    if (pFile == nullptr)
+        return;
+
+    vector<long> nextMsg(vesselCount, 0);
+    int longCount = 0, noPrefixCount = 0, badCount = 0;
+    static char line[XRLOG_MAX_MESSAGE_LENGTH * 4];
+    const int textOffset = static_cast<int>(strlen("00.00.0000 00:00:00.000 - "));
+    while (fgets(line, sizeof(line), pFile))
+    {
+        if (!HasTimestamp(line))
+        {
+            if (++badCount <= 3)
+                XRTests::Fail(__FILE__, __LINE__, "bad timestamp: %.60s", line);
+            continue;
+        }
+
+        const char *pText = line + textOffset;
+        int vessel;
+        long msg;
+        if (sscanf(pText, "[XR-%d] msg %ld\n", &vessel, &msg) == 2)
+        {
+            XR_CHECK((vessel >= 0) && (vessel < vesselCount));
+            if ((vessel < 0) || (vessel >= vesselCount))
+                continue;
+
+            if (msg != nextMsg[vessel])
+            {
+                if (++badCount <= 3)
+                    XRTests::Fail(__FILE__, __LINE__, "vessel %d: expected msg %ld, got %ld", vessel, nextMsg[vessel], msg);
+            }
+            nextMsg[vessel] = msg + 1;
+        }
+        else if (strncmp(pText, "[XR-LONG] ", 10) == 0)
+        {
+            longCount++;
+            XR_CHECK_EQUAL(static_cast<int>(strlen(pText)), XRLOG_MAX_MESSAGE_LENGTH);     // the truncated text plus the newline
+        }
+        else if (strcmp(pText, "no prefix\n") == 0)
+        {
+            noPrefixCount++;
+        }
+        else if (++badCount <= 3)
+        {
+            XRTests::Fail(__FILE__, __LINE__, "unexpected line: %.60s", line);
+        }
+    }
+    fclose(pFile);
+    remove(path.c_str());
+
+    XR_CHECK_EQUAL(badCount, 0);
+    XR_CHECK_EQUAL(longCount, 1);
+    XR_CHECK_EQUAL(noPrefixCount, 1);
+    for (int v = 0; v < vesselCount; v++)
+        XR_CHECK_EQUAL(nextMsg[v], messageCount);
+}
+
+// Lets a test stall the writer thread: it cannot return from its wait while the test holds its mutex.
+class StalledLogWriter : public XRLogWriter
+{
+public:
+    StalledLogWriter(FILE *pFile) : XRLogWriter(pFile) { }
+    virtual ~StalledLogWriter() { }
+
+    mutex &GetWriterMutex() { return m_mutex; }
+    static int GetQueueSlots() { return QUEUE_SLOTS; }
+};
+
+// With the writer stalled, a Write that waited for a free slot would never return.
+XR_TEST(XRLogWriterDropsMessagesWhenQueueIsFull)
+{
+    const string path = GetTempLogPath("LogWriterDrops");
+    FILE *pLogFile = fopen(path.c_str(), "a+t");
+    XR_CHECK(pLogFile != nullptr);
+    if (pLogFile == nullptr)
+        return;
+
+    const int queueSlots = StalledLogWriter::GetQueueSlots();
+    const long messageCount = queueSlots * 4L;
+    StalledLogWriter *pWriter = new StalledLogWriter(pLogFile);
+    {
+        lock_guard<mutex> lock(pWriter->GetWriterMutex());
+        char msg[64];
+        for (long i = 0; i < messageCount; i++)
+        {
+            sprintf(msg, "msg %ld", i);
+            pWriter->Write("XR-00", msg);
+        }
+    }
+    delete pWriter;     // writes the queued messages and the dropped count
+
+    FILE *pFile = fopen(path.c_str(), "rt");
+    XR_CHECK(pFile != nullptr);
+    if (pFile == nullptr)
+        return;
+
+    // the messages that fit in the queue are kept in order, followed by the number of messages dropped
+    long nextMsg = 0;
+    unsigned int droppedCount = 0;
+    int droppedLineCount = 0, badCount = 0;
+    char line[XRLOG_MAX_MESSAGE_LENGTH + 32];
+    const int textOffset = static_cast<int>(strlen("00.00.0000 00:00:00.000 - "));
+    while (fgets(line, sizeof(line), pFile))
+    {
+        long msg;
+        unsigned int dropped;
+        const char *pText = line + textOffset;
+        if (!HasTimestamp(line))
+        {
+            badCount++;
+        }
+        else if (sscanf(pText, "[XR-00] msg %ld\n", &msg) == 1)
+        {
+            if ((msg != nextMsg) || (droppedLineCount > 0))
+                badCount++;
+            nextMsg = msg + 1;
+        }
+        else if (sscanf(pText, "WARNING: %u log messages dropped", &dropped) == 1)
+        {
+            droppedCount += dropped;
+            droppedLineCount++;
+        }
+        else
+        {
+            badCount++;
+        }
+    }
+    fclose(pFile);
+    remove(path.c_str());
+
+    XR_CHECK_EQUAL(badCount, 0);
+    XR_CHECK_EQUAL(nextMsg, static_cast<long>(queueSlots));
+    XR_CHECK_EQUAL(droppedLineCount, 1);
+    XR_CHECK_EQUAL(static_cast<long>(droppedCount), messageCount - queueSlots);
+}
+
+// Splits 'iterations' messages across the vessels; the time includes draining the queue to disk in Terminate.
+static void BenchLogWriter(const int vesselCount, const long iterations)
+{
+    const string path = GetTempLogPath("LogWriterBench");
+    XRLogWriter *pWriter = XRLogWriter::Open(path.c_str());
+    if (pWriter == nullptr)
+    {
+        XRTests::Fail(__FILE__, __LINE__, "could not open %s", path.c_str());
+        return;
+    }
+
+    vector<double> samples;
+    RunVessels(pWriter, vesselCount, (iterations + vesselCount - 1) / vesselCount, &samples);
+    XRLogWriter::Terminate();
+    remove(path.c_str());
+
+    const double p99 = ReportWriteLatency(samples);
+    if (p99 > MAX_WRITE_NS_P99)
+        XRTests::Fail(__FILE__, __LINE__, "write_ns_p99 is %.0f; expected at most %.0f", p99, MAX_WRITE_NS_P99);
+}
+
+XR_BENCH(XRLogWriterWrite1Vessel)
+{
+    BenchLogWriter(1, iterations);
+}
+
+XR_BENCH(XRLogWriterWrite8Vessels)
+{
+    BenchLogWriter(8, iterations);
+}
+
+// The logging path XRLogWriter replaced: each vessel formats the local time and the message on the calling
+// thread, then writes and flushes its own handle to the shared log file.
+static void BenchSynchronousLog(const int vesselCount, const long iterations)
+{
+    const string path = GetTempLogPath("SyncLogBench");
+    const long messageCount = (iterations + vesselCount - 1) / vesselCount;
+    vector<vector<double>> samples(vesselCount);
+    vector<thread> threads;
+    for (int v = 0; v < vesselCount; v++)
+    {
+        threads.emplace_back([=, &path, &samples]
+        {
+            FILE *pFile = fopen(path.c_str(), "a+t");
+            if (pFile == nullptr)
+                return;
+
+            char prefix[16];
+            sprintf(prefix, "XR-%02d", v);
+            char msg[64];
+            for (long i = 0; i < messageCount; i++)
+            {
+                sprintf(msg, "msg %ld", i);
+                const bool bSample = ((i % WRITE_SAMPLE_INTERVAL) == 0);
+                const Clock::time_point start = (bSample ? Clock::now() : Clock::time_point());
+
+                SYSTEMTIME t;
+                GetLocalTime(&t);
+                char line[XRLOG_MAX_MESSAGE_LENGTH + 32];
+                const int length = snprintf(line, sizeof(line), "%02d.%02d.%04d %02d:%02d:%02d.%03d - [%s] %s\n",
+                    t.wMonth, t.wDay, t.wYear, t.wHour, t.wMinute, t.wSecond, t.wMilliseconds, prefix, msg);
+                OutputDebugString(line);
+                fwrite(line, 1, length, pFile);
+                fflush(pFile);
+
+                if (bSample)
+                    samples[v].push_back(chrono::duration<double, nano>(Clock::now() - start).count());
+            }
+            fclose(pFile);
+        });
+    }
+    for (thread &t : threads)
+        t.join();
+    remove(path.c_str());
+
+    vector<double> allSamples;
+    for (const vector<double> &s : samples)
+        allSamples.insert(allSamples.end(), s.begin(), s.end());
+    ReportWriteLatency(allSamples);
+}
+
+XR_BENCH(SynchronousLogWrite1Vessel)
+{
+    BenchSynchronousLog(1, iterations);
+}
+
+XR_BENCH(SynchronousLogWrite8Vessels)
+{
+    BenchSynchronousLog(8, iterations);
+}
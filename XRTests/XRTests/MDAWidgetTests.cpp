@@ -0,0 +1,424 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// MDAWidgetTests.cpp : MDAWidgetLayer partial repaints compared
+// pixel-for-pixel against a full render of the same screen, both for a
+// synthetic screen and for the XR1's hull temperatures mode.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XR1MultiDisplayArea.h"
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// the MDA screen size
+static const int SCREEN_WIDTH = 190;
+static const int SCREEN_HEIGHT = 69;
+
+// A surface for the fake GDI in stubs/windows.h.
+struct TestSurface : public XRTestsSurface
+{
+    TestSurface(const int w, const int h) : pixels(w * h)
+    {
+        width = w;
+        height = h;
+        pPixels = pixels.data();
+    }
+
+    bool operator==(const TestSurface &s) const { return pixels == s.pixels; }
+    vector<uint32_t> pixels;
+};
+
+// A screen laid out like the hull temperatures mode, but with deliberate overlaps: moving indicators pass
+// under text, and text fields with different fonts and alignments grow into one another.
+class TestScreen
+{
+public:
+    static const int INDICATOR_COUNT = 4;
+    static const int INDICATOR_SIZE = 7;
+    static const int FIELD_COUNT = 10;
+
+    TestScreen() :
+        m_mda(SCREEN_WIDTH, SCREEN_HEIGHT), m_pLayer(new MDAWidgetLayer(m_mda)), m_background(SCREEN_WIDTH, SCREEN_HEIGHT), m_indicatorSource(INDICATOR_SIZE * 2, INDICATOR_SIZE),
+        m_seed(1)
+    {
+        m_hSmallFont = CreateFont(-10, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, 0, "Arial");
+        m_hLargeFont = CreateFont(-14, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, 0, "Arial");
+
+        // background and indicator patterns; indicator pixels of 0 are transparent
+        for (size_t i = 0; i < m_background.pixels.size(); i++)
+            m_background.pixels[i] = static_cast<uint32_t>(i * 2654435761u);
+        for (size_t i = 0; i < m_indicatorSource.pixels.size(); i++)
+            m_indicatorSource.pixels[i] = ((i % 3) == 0 ? 0 : static_cast<uint32_t>(0x100 + i));
+
+        // four hull temperature pointers on two rows, sharing the same bitmap
+        for (int i = 0; i < INDICATOR_COUNT; i++)
+        {
+            m_indicators[i] = { _COORD2((i % 2) * INDICATOR_SIZE, 0), _COORD2(0, 8 + (i / 2) * 24) };
+            m_indicators[i].id = m_pLayer->AddIndicator(&m_indicatorSource, m_indicators[i].srcCoord, INDICATOR_SIZE, INDICATOR_SIZE);
+        }
+
+        // value fields on the pointer rows, labels, and a centered title that the values can run into
+        static const struct { bool large; int x, y; UINT align; } s_fields[FIELD_COUNT] =
+        {
+            { false, 4, 4, TA_LEFT }, { false, 186, 4, TA_RIGHT }, { true, 95, 0, TA_CENTER },
+            { false, 4, 28, TA_LEFT }, { false, 186, 28, TA_RIGHT }, { true, 95, 24, TA_CENTER },
+            { false, 40, 10, TA_LEFT }, { false, 150, 34, TA_RIGHT },
+            { true, 95, 50, TA_CENTER }, { false, -3, 60, TA_LEFT },    // the last one is partly off the screen
+        };
+        for (int i = 0; i < FIELD_COUNT; i++)
+        {
+            m_fields[i] = { (s_fields[i].large ? m_hLargeFont : m_hSmallFont), _COORD2(s_fields[i].x, s_fields[i].y), s_fields[i].align };
+            m_fields[i].id = m_pLayer->AddTextField(m_fields[i].font, m_fields[i].coord, m_fields[i].align);
+        }
+    }
+
+    virtual ~TestScreen()
+    {
+        delete m_pLayer;
+        DeleteObject(m_hSmallFont);
+        DeleteObject(m_hLargeFont);
+    }
+
+    // Changes each widget with the given probability, as a mode does when its values change.
+    void ChangeValues(const double changeProbability)
+    {
+        static const char *s_pTexts[] = { "", "1", "-45", "273K", "1450C", "OFFLINE", "WARNING", "Hull Temp", "12345678", "XXXXXXXXXXXXXXXXX" };
+        static const COLORREF s_colors[] = { RGB(0, 255, 0), RGB(255, 255, 0), RGB(255, 0, 0) };
+        for (Indicator &indicator : m_indicators)
+        {
+            if (NextRandom() < changeProbability)
+                indicator.coord.x = static_cast<int>(NextRandom() * (SCREEN_WIDTH + 10)) - 5;
+        }
+        for (Field &field : m_fields)
+        {
+            if (NextRandom() < changeProbability)
+                field.pText = s_pTexts[static_cast<int>(NextRandom() * (sizeof(s_pTexts) / sizeof(s_pTexts[0])))];
+            if (NextRandom() < changeProbability)
+                field.color = s_colors[static_cast<int>(NextRandom() * 3)];
+        }
+    }
+
+    // pushes the current values and renders the screen incrementally; returns the number of GDI calls
+    long RenderIncremental(const int event, TestSurface &screen)
+    {
+        const long startCalls = g_gdiCallCount;
+        for (const Indicator &indicator : m_indicators)
+            m_pLayer->SetIndicatorCoord(indicator.id, indicator.coord.x, indicator.coord.y);
+        for (const Field &field : m_fields)
+            m_pLayer->SetText(field.id, field.pText, field.color);
+        m_pLayer->Render(event, &screen, &m_background);
+        return g_gdiCallCount - startCalls;
+    }
+
+    // renders the whole screen from scratch, as the modes did before the widget layer; returns the number of GDI calls
+    long RenderFull(TestSurface &screen)
+    {
+        const long startCalls = g_gdiCallCount;
+        DeltaGliderXR1::SafeBlt(&screen, &m_background, 0, 0, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        for (const Indicator &indicator : m_indicators)
+            DeltaGliderXR1::SafeBlt(&screen, &m_indicatorSource, indicator.coord.x, indicator.coord.y, indicator.srcCoord.x, indicator.srcCoord.y, INDICATOR_SIZE, INDICATOR_SIZE, SURF_PREDEF_CK);
+
+        HDC hDC = m_mda.GetDC(&screen);
+        const HFONT hPrevFont = SelectObject(hDC, m_hSmallFont);
+        SetBkMode(hDC, TRANSPARENT);
+        for (const Field &field : m_fields)
+        {
+            if (*field.pText == 0)
+                continue;
+            SelectObject(hDC, field.font);
+            SetTextColor(hDC, field.color);
+            SetTextAlign(hDC, field.align);
+            TextOut(hDC, field.coord.x, field.coord.y, field.pText, static_cast<int>(strlen(field.pText)));
+        }
+        SelectObject(hDC, hPrevFont);
+        m_mda.ReleaseDC(&screen, hDC);
+        return g_gdiCallCount - startCalls;
+    }
+
+protected:
+    struct Indicator { COORD2 srcCoord, coord; int id; };
+    struct Field
+    {
+        Field() { }
+        Field(const HFONT f, const COORD2 c, const UINT a) : font(f), coord(c), align(a), pText(""), color(0), id(-1) { }
+        HFONT font;
+        COORD2 coord;
+        UINT align;
+        const char *pText;
+        COLORREF color;
+        int id;
+    };
+
+    double NextRandom()
+    {
+        m_seed = m_seed * 1103515245 + 12345;   // repeatable
+        return (m_seed >> 8) / 16777216.0;
+    }
+
+    MultiDisplayArea m_mda;
+    MDAWidgetLayer *m_pLayer;
+    TestSurface m_background;
+    TestSurface m_indicatorSource;
+    HFONT m_hSmallFont, m_hLargeFont;
+    Indicator m_indicators[INDICATOR_COUNT];
+    Field m_fields[FIELD_COUNT];
+    unsigned int m_seed;
+};
+
+// Returns a description of the first pixel that differs between the two surfaces.
+static string DescribeMismatch(const TestSurface &actual, const TestSurface &expected)
+{
+    for (size_t i = 0; i < actual.pixels.size(); i++)
+    {
+        if (actual.pixels[i] != expected.pixels[i])
+        {
+            char msg[128];
+            sprintf(msg, "pixel (%d, %d) is 0x%08X, expected 0x%08X", static_cast<int>(i % actual.width), static_cast<int>(i / actual.width), actual.pixels[i], expected.pixels[i]);
+            return msg;
+        }
+    }
+    return "";
+}
+
+XR_TEST(MDAWidgetLayerMatchesFullRender)
+{
+    TestScreen screen;
+    TestSurface incremental(SCREEN_WIDTH, SCREEN_HEIGHT), full(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    // the first render after activation paints everything
+    screen.ChangeValues(1.0);
+    screen.RenderIncremental(PANEL_REDRAW_INIT, incremental);
+    screen.RenderFull(full);
+    XR_CHECK(incremental == full);
+
+    // every later frame must leave exactly the image a full render would, whether few or many widgets changed
+    for (int frame = 0; frame < 20000; frame++)
+    {
+        screen.ChangeValues((frame % 10 == 0) ? 0.5 : 0.05);
+        screen.RenderIncremental(PANEL_REDRAW_ALWAYS, incremental);
+        screen.RenderFull(full);
+        if (!(incremental == full))
+        {
+            XRTests::Fail(__FILE__, __LINE__, "frame %d: %s", frame, DescribeMismatch(incremental, full).c_str());
+            break;
+        }
+    }
+
+    // MultiDisplayArea blanks the screen when it switches modes and then asks for a full repaint
+    oapiColourFill(&incremental, 0);
+    screen.RenderIncremental(PANEL_REDRAW_INIT, incremental);
+    XR_CHECK(incremental == full);
+}
+
+XR_TEST(MDAWidgetLayerSkipsUnchangedFrames)
+{
+    TestScreen screen;
+    TestSurface incremental(SCREEN_WIDTH, SCREEN_HEIGHT);
+    screen.ChangeValues(1.0);
+    screen.RenderIncremental(PANEL_REDRAW_INIT, incremental);
+
+    // nothing changed, so nothing is drawn and no device context is acquired
+    const vector<uint32_t> before = incremental.pixels;
+    XR_CHECK_EQUAL(0L, screen.RenderIncremental(PANEL_REDRAW_ALWAYS, incremental));
+    XR_CHECK(before == incremental.pixels);
+}
+
+//-------------------------------------------------------------------------
+// the XR1's hull temperatures mode, drawn by its own Redraw2D
+
+static const int MDA_SCREEN_WIDTH = 179;   // see MultiDisplayArea::MultiDisplayArea
+static const int MDA_SCREEN_HEIGHT = 110;
+
+// An XR1 whose hull temperatures, coolant temperature and doors change at random, as they do during reentry.
+class HullTempsXR1 : public DeltaGliderXR1
+{
+public:
+    HullTempsXR1() : m_seed(7)
+    {
+        // from XR1StartupCallbacks.cpp
+        m_hullTemperatureLimits = { CTOK(2840), CTOK(2380), CTOK(1490), CTOK(1210), 0.80, 0.90, 0.75, CTOK(480) };
+    }
+
+    // Changes each value with the given probability; temperatures range up to just past their limits.
+    void ChangeValues(const double changeProbability)
+    {
+        static const DoorStatus s_doorStates[] = { DoorStatus::DOOR_CLOSED, DoorStatus::DOOR_OPEN, DoorStatus::DOOR_OPENING, DoorStatus::DOOR_FAILED };
+        const HullTemperatureLimits &limits = m_hullTemperatureLimits;
+        ChangeTemp(m_noseconeTemp, limits.noseCone, changeProbability);
+        ChangeTemp(m_leftWingTemp, limits.wings, changeProbability);
+        ChangeTemp(m_rightWingTemp, limits.wings, changeProbability);
+        ChangeTemp(m_cockpitTemp, limits.cockpit, changeProbability);
+        ChangeTemp(m_topHullTemp, limits.topHull, changeProbability);
+        ChangeTemp(m_atmTemperature, 400, changeProbability);
+        ChangeTemp(m_coolantTemp, 120, changeProbability);     // degrees C; the gauge spans 10 to 110
+        for (DoorStatus *pDoorStatus : { &nose_status, &hoverdoor_status, &gear_status, &rcover_status, &hatch_status, &radiator_status })
+        {
+            if (NextRandom() < (changeProbability / 4))
+                *pDoorStatus = s_doorStates[static_cast<int>(NextRandom() * 4)];
+        }
+        if (NextRandom() < (changeProbability / 10))
+            m_activeTempScale = static_cast<TempScale>(static_cast<int>(NextRandom() * 3));
+    }
+
+protected:
+    void ChangeTemp(double &temp, const double limit, const double changeProbability)
+    {
+        if (NextRandom() < changeProbability)
+            temp = NextRandom() * limit * 1.1;
+    }
+
+    double NextRandom()
+    {
+        m_seed = m_seed * 1103515245 + 12345;   // repeatable
+        return (m_seed >> 8) / 16777216.0;
+    }
+
+    unsigned int m_seed;
+};
+
+// An active hull temperatures mode on its own MDA screen.
+class HullTempsScreen
+{
+public:
+    HullTempsScreen(HullTempsXR1 &xr1) : m_mda(MDA_SCREEN_WIDTH, MDA_SCREEN_HEIGHT, &xr1), m_mode(3), m_surface(MDA_SCREEN_WIDTH, MDA_SCREEN_HEIGHT)
+    {
+        m_mode.SetParent(&m_mda);
+        m_mode.Activate();
+    }
+
+    ~HullTempsScreen() { m_mode.Deactivate(); }
+
+    // renders the mode's current values; returns the number of GDI calls
+    long Redraw(const int event)
+    {
+        const long startCalls = g_gdiCallCount;
+        m_mode.Redraw2D(event, &m_surface);
+        return g_gdiCallCount - startCalls;
+    }
+
+    const TestSurface &GetSurface() const { return m_surface; }
+
+protected:
+    MultiDisplayArea m_mda;
+    HullTempsMultiDisplayMode m_mode;
+    TestSurface m_surface;
+};
+
+XR_TEST(MDAHullTempsModeMatchesFullRender)
+{
+    HullTempsXR1 xr1;
+    HullTempsScreen incremental(xr1), full(xr1);
+
+    xr1.ChangeValues(1.0);
+    incremental.Redraw(PANEL_REDRAW_INIT);
+    full.Redraw(PANEL_REDRAW_INIT);
+    XR_CHECK(incremental.GetSurface() == full.GetSurface());
+
+    // the full render repaints the whole screen on every frame, as the mode did before the widget layer
+    for (int frame = 0; frame < 5000; frame++)
+    {
+        xr1.ChangeValues((frame % 10 == 0) ? 0.5 : 0.05);
+        incremental.Redraw(PANEL_REDRAW_ALWAYS);
+        full.Redraw(PANEL_REDRAW_INIT);
+        if (!(incremental.GetSurface() == full.GetSurface()))
+        {
+            XRTests::Fail(__FILE__, __LINE__, "frame %d: %s", frame, DescribeMismatch(incremental.GetSurface(), full.GetSurface()).c_str());
+            break;
+        }
+    }
+
+    // nothing changed, so nothing is drawn
+    XR_CHECK_EQUAL(0L, incremental.Redraw(PANEL_REDRAW_ALWAYS));
+}
+
+//-------------------------------------------------------------------------
+// one MDA frame per op, in which about one widget in twenty changes
+
+XR_BENCH(MDAWidgetLayerRender)
+{
+    TestScreen screen;
+    TestSurface surface(SCREEN_WIDTH, SCREEN_HEIGHT);
+    screen.ChangeValues(1.0);
+    screen.RenderIncremental(PANEL_REDRAW_INIT, surface);
+
+    long gdiCalls = 0;
+    for (long i = 0; i < iterations; i++)
+    {
+        screen.ChangeValues(0.05);
+        gdiCalls += screen.RenderIncremental(PANEL_REDRAW_ALWAYS, surface);
+    }
+    g_sink = surface.pixels[0];
+    ReportMetric("gdi_calls_per_frame", static_cast<double>(gdiCalls) / iterations);
+}
+
+XR_BENCH(MDAFullRender)
+{
+    TestScreen screen;
+    TestSurface surface(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    long gdiCalls = 0;
+    for (long i = 0; i < iterations; i++)
+    {
+        screen.ChangeValues(0.05);
+        gdiCalls += screen.RenderFull(surface);
+    }
+    g_sink = surface.pixels[0];
+    ReportMetric("gdi_calls_per_frame", static_cast<double>(gdiCalls) / iterations);
+}
+
+XR_BENCH(MDAHullTempsModeRender)
+{
+    HullTempsXR1 xr1;
+    HullTempsScreen screen(xr1);
+    xr1.ChangeValues(1.0);
+    screen.Redraw(PANEL_REDRAW_INIT);
+
+    long gdiCalls = 0;
+    for (long i = 0; i < iterations; i++)
+    {
+        xr1.ChangeValues(0.05);
+        gdiCalls += screen.Redraw(PANEL_REDRAW_ALWAYS);
+    }
+    g_sink = screen.GetSurface().pixels[0];
+    ReportMetric("gdi_calls_per_frame", static_cast<double>(gdiCalls) / iterations);
+}
+
+XR_BENCH(MDAHullTempsModeFullRender)
+{
+    HullTempsXR1 xr1;
+    HullTempsScreen screen(xr1);
+
+    long gdiCalls = 0;
+    for (long i = 0; i < iterations; i++)
+    {
+        xr1.ChangeValues(0.05);
+        gdiCalls += screen.Redraw(PANEL_REDRAW_INIT);
+    }
+    g_sink = screen.GetSurface().pixels[0];
+    ReportMetric("gdi_calls_per_frame", static_cast<double>(gdiCalls) / iterations);
+}
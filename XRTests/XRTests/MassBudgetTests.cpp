@@ -0,0 +1,97 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// MassBudgetTests.cpp : XRMassBudget's running total, and when it asks
+// its owner to send the total to Orbiter.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRMassBudget.h"
+
+using namespace std;
+using namespace XRTests;
+
+// A new budget must always be pushed once, and then only after the total moves more than PUSH_THRESHOLD
+XR_TEST(MassBudgetPushesPastThreshold)
+{
+    const double threshold = XRMassBudget::PUSH_THRESHOLD;
+    XRMassBudget budget(3);
+    XR_CHECK(budget.IsPushRequired());
+    XR_CHECK_NEAR(0, budget.Push(), 0);
+    XR_CHECK(!budget.IsPushRequired());
+
+    budget.SetItemMass(0, 10000);
+    budget.SetItemMass(1, 500);
+    XR_CHECK_NEAR(10500, budget.GetTotalMass(), 0);
+    XR_CHECK(budget.IsPushRequired());
+    XR_CHECK_NEAR(10500, budget.Push(), 0);
+    XR_CHECK(!budget.IsPushRequired());
+
+    // small changes add up from the last push rather than from the last change
+    budget.SetItemMass(2, threshold * 0.4);
+    XR_CHECK(!budget.IsPushRequired());
+    budget.SetItemMass(2, threshold * 0.8);
+    XR_CHECK(!budget.IsPushRequired());
+    budget.SetItemMass(2, threshold * 1.2);
+    XR_CHECK(budget.IsPushRequired());
+    XR_CHECK_NEAR(10500 + (threshold * 1.2), budget.Push(), 1e-9);
+
+    // changes in either direction count, and changes that cancel out do not require a push
+    budget.SetItemMass(1, 500 - (threshold * 2));
+    XR_CHECK(budget.IsPushRequired());
+    budget.SetItemMass(1, 500);
+    XR_CHECK(!budget.IsPushRequired());
+    XR_CHECK_NEAR(500, budget.GetItemMass(1), 0);
+}
+
+// Push re-sums the items, so rounding in the running total does not build up
+XR_TEST(MassBudgetPushResumsItems)
+{
+    XRMassBudget budget(2);
+    budget.SetItemMass(0, 0.1);
+    budget.SetItemMass(1, 1e17);    // the running total cannot hold the 0.1 kg next to this...
+    budget.SetItemMass(1, 0);       // ...so it is lost here
+    XR_CHECK_NEAR(0, budget.GetTotalMass(), 0);
+    XR_CHECK_NEAR(0.1, budget.RecomputeTotalMass(), 0);
+
+    XR_CHECK_NEAR(0.1, budget.Push(), 0);
+    XR_CHECK_NEAR(0.1, budget.GetTotalMass(), 0);
+    XR_CHECK(!budget.IsPushRequired());
+}
+
+// Invalidate forces the next push, e.g., after something else set Orbiter's empty mass
+XR_TEST(MassBudgetInvalidateForcesPush)
+{
+    XRMassBudget budget(1);
+    budget.SetItemMass(0, 1234);
+    budget.Push();
+    XR_CHECK(!budget.IsPushRequired());
+
+    budget.Invalidate();
+    XR_CHECK(budget.IsPushRequired());
+    XR_CHECK(budget.IsPushRequired());     // asking does not clear it
+    XR_CHECK_NEAR(1234, budget.Push(), 0);
+    XR_CHECK(!budget.IsPushRequired());
+}
@@ -0,0 +1,106 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// MshOptimizerTests.cpp : MshOptimizer must leave the vertices of
+// protected groups untouched, since the vessel code edits some of them
+// by index.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "MshFile.h"
+#include "MeshOptimizer.h"
+#include <unistd.h>
+#include <string.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// the shipped mesh the tests optimize; it has several groups with shared vertices
+static const char *TEST_MESH = "Meshes/XRPayload/TankD1.msh";
+
+static bool AreVerticesIdentical(const MshGroup &a, const MshGroup &b)
+{
+    return (a.vertices.size() == b.vertices.size()) &&
+        (memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(MshVertex)) == 0);
+}
+
+static vector<MshTriangle> GetSortedTriangles(const MshGroup &group)
+{
+    vector<MshTriangle> triangles = group.triangles;
+    sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// Protected groups keep every vertex byte-for-byte in its original order, and keep the same triangles.
+XR_TEST(MshOptimizerKeepsProtectedGroupVertices)
+{
+    MshFile original;
+    string error;
+    XR_CHECK(original.Read(TEST_MESH, error));
+    const int groupCount = static_cast<int>(original.m_groups.size());
+    XR_CHECK(groupCount >= 4);
+    if (groupCount < 4)
+        return;
+
+    MshFile mesh = original;
+    for (int i = 0; i < groupCount; i += 2)
+        mesh.m_groups[i].isProtected = true;
+
+    const MshPrecision precision = { 3, 2, 3 };     // coarse enough to round every unprotected vertex
+    MeshOptimizer::OptimizeGroups(mesh, precision, true, true);
+    XR_CHECK_EQUAL(groupCount, static_cast<int>(mesh.m_groups.size()));
+
+    int changedGroupCount = 0;
+    for (int i = 0; i < groupCount; i++)
+    {
+        const MshGroup &before = original.m_groups[i];
+        const MshGroup &after = mesh.m_groups[i];
+        if (after.isProtected)
+        {
+            XR_CHECK(AreVerticesIdentical(before, after));
+            XR_CHECK(GetSortedTriangles(before) == GetSortedTriangles(after));
+        }
+        else if (!AreVerticesIdentical(before, after))
+        {
+            changedGroupCount++;
+        }
+    }
+    XR_CHECK(changedGroupCount > 0);    // the unprotected groups were still optimized
+
+    // writing the mesh must not round the protected vertices either
+    char path[256];
+    sprintf(path, "/tmp/XRTests-MshOptimizer-%d.msh", static_cast<int>(getpid()));
+    XR_CHECK(mesh.Write(path, precision, error));
+    MshFile reread;
+    XR_CHECK(reread.Read(path, error));
+    remove(path);
+    XR_CHECK_EQUAL(groupCount, static_cast<int>(reread.m_groups.size()));
+    for (int i = 0; (i < groupCount) && (i < static_cast<int>(reread.m_groups.size())); i += 2)
+        XR_CHECK(AreVerticesIdentical(original.m_groups[i], reread.m_groups[i]));
+}
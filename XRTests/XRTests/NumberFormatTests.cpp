@@ -0,0 +1,203 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// NumberFormatTests.cpp : XRNumberFormat against the sprintf formats it
+// replaces.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRNumberFormat.h"
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+using namespace XRTests;
+
+// repeatable random numbers for the comparisons
+static unsigned long long s_seed = 1;
+static unsigned int NextRandom()
+{
+    s_seed = s_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<unsigned int>(s_seed >> 33);
+}
+
+// Formats the value with both FormatDouble and sprintf, and fails on the first difference.
+// Returns false if the output differed.
+static bool CheckFormatDouble(const double value, const int decimals, const int width, const bool prependPlus, const char *pSuffix)
+{
+    char actual[600], expected[600];
+    const int length = XRNumberFormat::FormatDouble(actual, sizeof(actual), value, decimals, width, prependPlus, pSuffix);
+    sprintf(expected, (prependPlus ? "%+*.*f%s" : "%*.*f%s"), width, decimals, value, (pSuffix ? pSuffix : ""));
+    if ((strcmp(actual, expected) != 0) || (length != static_cast<int>(strlen(expected))))
+    {
+        XRTests::Fail(__FILE__, __LINE__, "value %.17g, decimals %d, width %d, plus %d: got \"%s\" (%d), expected \"%s\"",
+            value, decimals, width, prependPlus, actual, length, expected);
+        return false;
+    }
+    return true;
+}
+
+XR_TEST(NumberFormatDoubleMatchesSprintf)
+{
+    static const char *s_pSuffixes[] = { nullptr, "", " km", " m/s\xB2" };
+    static const double s_scales[] = { 1e-12, 1e-6, 0.01, 1, 100, 1e4, 1e8, 1e12, 1e16, 1e300 };
+
+    for (int i = 0; i < 500000; i++)
+    {
+        const int decimals = NextRandom() % 12;    // 10 and 11 are passed to sprintf
+        const int width = static_cast<int>(NextRandom() % 41) - 20;
+        const bool prependPlus = ((NextRandom() & 1) != 0);
+        const char *pSuffix = s_pSuffixes[NextRandom() % 4];
+        double value;
+        switch (NextRandom() % 4)
+        {
+        case 0:     // any magnitude
+            value = (NextRandom() / 4294967296.0) * s_scales[NextRandom() % 10];
+            break;
+
+        case 1:     // exact binary ties, e.g., 0.125 to two decimals
+            value = static_cast<int>(NextRandom() % 100000) / 8.0;
+            break;
+
+        case 2:     // decimal ties that are not exact in binary, e.g., 2.675 to two decimals, and their neighbors
+            value = (static_cast<int>(NextRandom() % 2000000) + 0.5) / pow(10.0, decimals);
+            value = nextafter(value, ((NextRandom() % 3) == 0 ? 0 : ((NextRandom() & 1) ? DBL_MAX : value)));
+            break;
+
+        default:    // small integers and values that round to zero
+            value = static_cast<int>(NextRandom() % 2000) / 1000.0 - 0.001;
+            break;
+        }
+        if (NextRandom() & 1)
+            value = -value;
+
+        if (!CheckFormatDouble(value, decimals, width, prependPlus, pSuffix))
+            break;
+    }
+
+    // values the fast path hands to sprintf, and signed zeros
+    static const double s_special[] = { 0.0, -0.0, NAN, -NAN, INFINITY, -INFINITY, DBL_MAX, -DBL_MAX, DBL_MIN, 1e15, 999999999999999.5, 0.5, -0.5, 1.5, 2.5 };
+    for (const double value : s_special)
+    {
+        for (int decimals = 0; decimals <= 3; decimals++)
+        {
+            CheckFormatDouble(value, decimals, 12, false, nullptr);
+            CheckFormatDouble(value, decimals, -12, true, " m");
+        }
+    }
+}
+
+XR_TEST(NumberFormatIntMatchesSprintf)
+{
+    static const int s_special[] = { 0, 1, -1, 9, 10, -10, 99999, INT_MAX, INT_MIN, INT_MIN + 1 };
+    for (int i = 0; i < 500000; i++)
+    {
+        const int value = ((i < 10 * 41) ? s_special[i % 10] : static_cast<int>(NextRandom()) >> (NextRandom() % 32));
+        const int width = ((i < 10 * 41) ? (i / 10) : static_cast<int>(NextRandom() % 41)) - 20;
+        for (const bool zeroPad : { false, true })
+        {
+            char actual[64], expected[64];
+            const int length = XRNumberFormat::FormatInt(actual, sizeof(actual), value, width, zeroPad);
+            sprintf(expected, (zeroPad ? "%0*d" : "%*d"), width, value);
+            if ((strcmp(actual, expected) != 0) || (length != static_cast<int>(strlen(expected))))
+            {
+                XRTests::Fail(__FILE__, __LINE__, "value %d, width %d, zeroPad %d: got \"%s\" (%d), expected \"%s\"", value, width, zeroPad, actual, length, expected);
+                return;
+            }
+        }
+    }
+}
+
+XR_TEST(NumberFormatTruncatesAndAppendsUnits)
+{
+    // text that does not fit is cut off like snprintf's, but the return value is what was written
+    char buffer[8];
+    memset(buffer, 'x', sizeof(buffer));
+    XR_CHECK_EQUAL(7, XRNumberFormat::FormatDouble(buffer, sizeof(buffer), -1234.5678, 3, XR_UNIT::KILOMETERS));
+    XR_CHECK_STR("-1234.5", buffer);
+    XR_CHECK_EQUAL(3, XRNumberFormat::FormatInt(buffer, 4, 123456, 10));
+    XR_CHECK_STR("   ", buffer);
+    buffer[0] = 'x';
+    XR_CHECK_EQUAL(0, XRNumberFormat::FormatInt(buffer, 0, 1));
+    XR_CHECK(buffer[0] == 'x');
+
+    char text[32];
+    XRNumberFormat::FormatDouble(text, sizeof(text), 1.5, 2, XR_UNIT::MACH, true);
+    XR_CHECK_STR("+1.50 Mach", text);
+    XRNumberFormat::FormatDouble(text, sizeof(text), 45, 1, XR_UNIT::DEGREES);
+    XR_CHECK_STR("45.0\xB0", text);
+    XRNumberFormat::FormatDouble(text, sizeof(text), 300, 0, XR_UNIT::KELVIN);
+    XR_CHECK_STR("300 \xB0K", text);
+    for (int unit = 0; unit < static_cast<int>(XR_UNIT::COUNT); unit++)
+        XR_CHECK(XRNumberFormat::GetUnitSuffix(static_cast<XR_UNIT>(unit)) != nullptr);
+}
+
+//-------------------------------------------------------------------------
+// one formatted value per op, in the formats the HUDs and panels use most, each against sprintf
+
+static const double s_benchValues[] = { 1234.5678, -0.25, 98765.4321, 3.14159, -271.8, 0.0049, 65432.1, 12.5 };
+
+XR_BENCH(NumberFormatDoubleUnit)
+{
+    char text[32];
+    for (long i = 0; i < iterations; i++)
+        g_sink = XRNumberFormat::FormatDouble(text, sizeof(text), s_benchValues[i & 7], 2, XR_UNIT::KILOMETERS);
+}
+
+XR_BENCH(SprintfDoubleUnit)
+{
+    char text[32];
+    for (long i = 0; i < iterations; i++)
+        g_sink = sprintf(text, "%.2lf km", s_benchValues[i & 7]);
+}
+
+XR_BENCH(NumberFormatDoubleWidth)
+{
+    char text[32];
+    for (long i = 0; i < iterations; i++)
+        g_sink = XRNumberFormat::FormatDouble(text, sizeof(text), s_benchValues[i & 7], 3, 9);
+}
+
+XR_BENCH(SprintfDoubleWidth)
+{
+    char text[32];
+    for (long i = 0; i < iterations; i++)
+        g_sink = sprintf(text, "%9.3lf", s_benchValues[i & 7]);
+}
+
+XR_BENCH(NumberFormatInt)
+{
+    char text[32];
+    for (long i = 0; i < iterations; i++)
+        g_sink = XRNumberFormat::FormatInt(text, sizeof(text), static_cast<int>(i * 7919), 6, true);
+}
+
+XR_BENCH(SprintfInt)
+{
+    char text[32];
+    for (long i = 0; i < iterations; i++)
+        g_sink = sprintf(text, "%06d", static_cast<int>(i * 7919));
+}
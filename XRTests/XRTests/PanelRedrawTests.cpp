@@ -0,0 +1,222 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+
+//-------------------------------------------------------------------------
+// PanelRedrawTests.cpp : InstrumentPanel's scheduling of PANEL_REDRAW_ALWAYS
+// areas by redraw interval, priority, and frame redraw budget.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "InstrumentPanel.h"
+#include "Area.h"
+#include <math.h>
+#include <map>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// Runs oapiGetSysTime and the performance counter from a simulated clock for the life of the object.
+class SimulatedClock
+{
+public:
+    ~SimulatedClock()
+    {
+        XRTestsPerformanceCounter() = -1;
+        oapiSetTestSysTime(0);
+    }
+
+    // Orbiter's system time stays the same for the whole frame; the performance counter keeps running
+    void StartFrame(const double seconds)
+    {
+        oapiSetTestSysTime(seconds);
+        XRTestsPerformanceCounter() = llround(seconds * 1e9);
+    }
+
+    static void Advance(const double seconds) { XRTestsPerformanceCounter() += llround(seconds * 1e9); }
+};
+
+// Declares each area's redraw interval and priority the way a vessel subclass does.
+class TestVessel : public VESSEL3_EXT
+{
+public:
+    TestVessel(const double redrawBudget)
+    {
+        m_config.PanelRedrawBudget = redrawBudget;
+        m_pConfig = &m_config;
+    }
+
+    virtual double GetAreaRedrawInterval(const int areaID) override { return m_intervals[areaID]; }
+    virtual REDRAW_PRIORITY GetAreaRedrawPriority(const int areaID) override
+    {
+        const auto it = m_priorities.find(areaID);
+        return ((it != m_priorities.end()) ? it->second : REDRAW_PRIORITY::NORMAL);
+    }
+
+    map<int, double> m_intervals;       // realtime seconds; default 0 = every frame
+    map<int, REDRAW_PRIORITY> m_priorities;
+
+protected:
+    VesselConfigFileParser m_config;
+};
+
+class TestPanel : public InstrumentPanel
+{
+public:
+    TestPanel(VESSEL3_EXT &vessel) : InstrumentPanel(vessel, 0) { }
+
+    virtual bool Activate() override
+    {
+        ActivateAllAreas();
+        SetActive(true);
+        return true;
+    }
+};
+
+// Counts its redraws, each of which takes redrawCost seconds of simulated realtime.
+class CountingArea : public Area
+{
+public:
+    CountingArea(InstrumentPanel &parentPanel, const int areaID, const double redrawCost) :
+        Area(parentPanel, _COORD2(0, 0), areaID), m_redrawCost(redrawCost), m_redrawCount(0) { }
+
+    int GetRedrawCount() const { return m_redrawCount; }
+
+protected:
+    virtual bool Redraw2D(const int event, const SURFHANDLE surf) override
+    {
+        m_redrawCount++;
+        SimulatedClock::Advance(m_redrawCost);
+        return true;
+    }
+
+    const double m_redrawCost;
+    int m_redrawCount;
+};
+
+// Sends one frame's PANEL_REDRAW_ALWAYS events to the visible areas, as Orbiter does.
+// Returns: number of areas redrawn
+static int RunFrame(TestPanel &panel, SimulatedClock &clock, const double frameTime, const vector<int> &visibleAreaIDs)
+{
+    clock.StartFrame(frameTime);
+    int redrawCount = 0;
+    for (const int areaID : visibleAreaIDs)
+    {
+        if (panel.ProcessRedrawEvent(areaID, PANEL_REDRAW_ALWAYS, nullptr))
+            redrawCount++;
+    }
+    return redrawCount;
+}
+
+XR_TEST(PanelRedrawHonorsAreaInterval)
+{
+    SimulatedClock clock;
+    TestVessel vessel(0);
+    vessel.m_intervals[1] = 0.045;
+    TestPanel panel(vessel);
+    CountingArea *pThrottled = static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, 1, 0.001)));
+    CountingArea *pEveryFrame = static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, 2, 0.001)));
+    panel.Activate();
+
+    // at 100 fps a 45 ms interval falls between frames; staying in phase still averages 45 ms rather than 50 ms
+    for (int frame = 0; frame < 200; frame++)
+        RunFrame(panel, clock, frame * 0.01, { 1, 2 });
+
+    XR_CHECK_EQUAL(200, pEveryFrame->GetRedrawCount());
+    XR_CHECK((pThrottled->GetRedrawCount() >= 44) && (pThrottled->GetRedrawCount() <= 46));
+    XR_CHECK_NEAR(1 / 0.045, panel.GetAchievedRefreshRate(1), 1.0);
+    XR_CHECK_NEAR(100.0, panel.GetAchievedRefreshRate(2), 0.5);
+    XR_CHECK_EQUAL(0.0, panel.GetAchievedRefreshRate(3));   // not on the panel
+}
+
+XR_TEST(PanelRedrawBudgetDefersAreas)
+{
+    SimulatedClock clock;
+    TestVessel vessel(5);       // ms
+    TestPanel panel(vessel);
+    vector<CountingArea *> expensiveAreas;
+    for (int areaID = 1; areaID <= 3; areaID++)
+        expensiveAreas.push_back(static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, areaID, 0.004))));
+    CountingArea *pCheap = static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, 4, 0.0005)));
+    panel.Activate();
+
+    // every area redraws on its first event so that its cost is known
+    XR_CHECK_EQUAL(4, RunFrame(panel, clock, 0, { 1, 2, 3, 4 }));
+
+    // From then on only one expensive area fits in the budget; they take turns, and the cheap area still fits after it.
+    for (int frame = 1; frame <= 30; frame++)
+        XR_CHECK_EQUAL(2, RunFrame(panel, clock, frame * 0.02, { 1, 2, 3, 4 }));
+
+    for (const CountingArea *pArea : expensiveAreas)
+        XR_CHECK_EQUAL(11, pArea->GetRedrawCount());
+    XR_CHECK_EQUAL(31, pCheap->GetRedrawCount());
+}
+
+XR_TEST(PanelRedrawBudgetFavorsHighPriority)
+{
+    SimulatedClock clock;
+    TestVessel vessel(5);
+    vessel.m_priorities[1] = REDRAW_PRIORITY::HIGH;
+    TestPanel panel(vessel);
+    vector<CountingArea *> areas;
+    for (int areaID = 1; areaID <= 3; areaID++)
+        areas.push_back(static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, areaID, 0.004))));
+    panel.Activate();
+
+    for (int frame = 0; frame <= 60; frame++)
+        RunFrame(panel, clock, frame * 0.02, { 1, 2, 3 });
+
+    // the high priority area redraws more often, but the normal priority areas are never starved
+    XR_CHECK(areas[0]->GetRedrawCount() > areas[1]->GetRedrawCount());
+    XR_CHECK(areas[0]->GetRedrawCount() > areas[2]->GetRedrawCount());
+    XR_CHECK(areas[1]->GetRedrawCount() >= 10);
+    XR_CHECK(areas[2]->GetRedrawCount() >= 10);
+    XR_CHECK_EQUAL(61 + 2, areas[0]->GetRedrawCount() + areas[1]->GetRedrawCount() + areas[2]->GetRedrawCount());
+}
+
+XR_TEST(PanelRedrawHiddenAreasUseNoBudget)
+{
+    SimulatedClock clock;
+    TestVessel vessel(5);
+    TestPanel panel(vessel);
+    CountingArea *pShown = static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, 1, 0.004)));
+    CountingArea *pHidden = static_cast<CountingArea *>(panel.AddArea(new CountingArea(panel, 2, 0.004)));
+    panel.Activate();
+
+    RunFrame(panel, clock, 0, { 1, 2 });
+
+    // Orbiter sends no events for an area that is not visible, so the visible area gets the whole budget
+    for (int frame = 1; frame <= 10; frame++)
+        RunFrame(panel, clock, frame * 0.02, { 1 });
+    XR_CHECK_EQUAL(11, pShown->GetRedrawCount());
+    XR_CHECK_EQUAL(1, pHidden->GetRedrawCount());
+
+    // an area that was not visible last frame redraws as soon as it is visible again; then the two take turns
+    XR_CHECK_EQUAL(2, RunFrame(panel, clock, 11 * 0.02, { 1, 2 }));
+    for (int frame = 12; frame <= 21; frame++)
+        XR_CHECK_EQUAL(1, RunFrame(panel, clock, frame * 0.02, { 1, 2 }));
+    XR_CHECK_EQUAL(17, pShown->GetRedrawCount());
+    XR_CHECK_EQUAL(7, pHidden->GetRedrawCount());
+}
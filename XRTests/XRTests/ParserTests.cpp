@@ -0,0 +1,297 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// ParserTests.cpp : XRVesselCtrlDemo command tokenizer and parser tree
+// child lookup, autocompletion and available-arguments help.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "ParserTree.h"
+#include "XRVCClientCommandParser.h"
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// Saves the arguments passed to it; its first parameter autocompletes to "on" or "off".
+class RecordingLeafHandler : public ParserTreeNode::LeafHandler
+{
+public:
+    virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+    {
+        m_lastArgv = remainingArgv;
+        statusOut = "executed";
+        return true;
+    }
+
+    virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const { csOut = "<on/off>"; }
+
+    virtual const char **GetFirstParamAutocompletionTokens(const ParserTreeNode *pTreeNode)
+    {
+        static const char *s_pTokens[] = { "on", "off", nullptr };
+        return s_pTokens;
+    }
+
+    vector<CString> m_lastArgv;
+};
+
+// A small tree whose top-level nodes share the prefix "s":
+//   Set   (group 0) -> MainBoth, MainLeft (group 1), Strobe (group 2)
+//   Shift (group 0) -> Up
+//   Status (group 1) -> <leaf>
+struct TestParserTree : public ParserTree
+{
+    TestParserTree()
+    {
+        ParserTreeNode *pSet = new ParserTreeNode("Set", 0);
+        pSet->AddChild(new ParserTreeNode("MainBoth", 1, nullptr, &leafHandler));
+        pSet->AddChild(new ParserTreeNode("MainLeft", 1, nullptr, &leafHandler));
+        pSet->AddChild(new ParserTreeNode("Strobe", 2, nullptr, &leafHandler));
+        AddTopLevelNode(pSet);
+
+        ParserTreeNode *pShift = new ParserTreeNode("Shift", 0);
+        pShift->AddChild(new ParserTreeNode("Up", 0, nullptr, &leafHandler));
+        AddTopLevelNode(pShift);
+
+        AddTopLevelNode(new ParserTreeNode("Status", 1, nullptr, &leafHandler));
+    }
+
+    const ParserTreeNode *Resolve(const char *pCommand, vector<CString> &leafArgv)
+    {
+        CString status;
+        leafArgv.clear();
+        return ParserTree::Resolve(pCommand, leafArgv, status);
+    }
+
+    // resets the autocompletion state as a keystroke does, then autocompletes once
+    CString AutoCompleteFresh(const char *pCommand, const bool direction = true)
+    {
+        ResetAutocompletionState();
+        CString csCommand = pCommand;
+        AutoComplete(csCommand, direction);
+        return csCommand;
+    }
+
+    RecordingLeafHandler leafHandler;
+};
+
+// returns a command with the given number of tokens
+static CString MakeCommand(const int tokenCount)
+{
+    CString csCommand = "Set MainBoth";
+    for (int i = 2; i < tokenCount; i++)
+        csCommand += " x";
+    return csCommand;
+}
+
+XR_TEST(ParserTokenizerSplitsOnWhitespace)
+{
+    ParserTreeNode::TokenArray argv;
+    const char *pCommand = "  Set\tMainBoth   ThrottleLevel 0.5 \r\n";
+    XR_CHECK(ParserTreeNode::ParseToSpaceDelimitedTokens(pCommand, argv));
+    XR_CHECK_EQUAL(4, argv.size());
+    XR_CHECK_STR("Set", argv[0].ToCString());
+    XR_CHECK_STR("MainBoth", argv[1].ToCString());
+    XR_CHECK_STR("ThrottleLevel", argv[2].ToCString());
+    XR_CHECK_STR("0.5", argv[3].ToCString());
+
+    // tokens point into the command rather than copying it
+    XR_CHECK(argv[0].pText == pCommand + 2);
+    XR_CHECK(argv[3].pText == pCommand + 31);
+    XR_CHECK(argv[2].EqualsNoCase("throttlelevel"));
+    XR_CHECK(!argv[2].EqualsNoCase("throttle"));
+    XR_CHECK(!argv[2].EqualsNoCase("throttlelevels"));
+
+    XR_CHECK(ParserTreeNode::ParseToSpaceDelimitedTokens(" \t ", argv));
+    XR_CHECK_EQUAL(0, argv.size());
+
+    XR_CHECK(ParserTreeNode::ParseToSpaceDelimitedTokens(MakeCommand(ParserTreeNode::TokenArray::MAX_TOKENS), argv));
+    XR_CHECK_EQUAL(ParserTreeNode::TokenArray::MAX_TOKENS, argv.size());
+    XR_CHECK(!ParserTreeNode::ParseToSpaceDelimitedTokens(MakeCommand(ParserTreeNode::TokenArray::MAX_TOKENS + 1), argv));
+
+    TestParserTree tree;
+    CString status;
+    XR_CHECK(tree.Parse(MakeCommand(ParserTreeNode::TokenArray::MAX_TOKENS), status));
+    XR_CHECK_EQUAL(ParserTreeNode::TokenArray::MAX_TOKENS - 2, static_cast<int>(tree.leafHandler.m_lastArgv.size()));
+    XR_CHECK(!tree.Parse(MakeCommand(ParserTreeNode::TokenArray::MAX_TOKENS + 1), status));
+    XR_CHECK(status.Find("Too many parameters.") >= 0);
+}
+
+XR_TEST(ParserPrefixIndexFindsUniqueChildren)
+{
+    TestParserTree tree;
+    vector<CString> leafArgv;
+
+    // full and unique-prefix tokens match in any case; the rest of the command goes to the leaf handler
+    const ParserTreeNode *pNode = tree.Resolve("SET mainboth on 2", leafArgv);
+    XR_CHECK(pNode != nullptr);
+    if (pNode != nullptr)
+        XR_CHECK_STR("MainBoth", *pNode->GetNodeText());
+    XR_CHECK_EQUAL(2, static_cast<int>(leafArgv.size()));
+    if (leafArgv.size() == 2)
+    {
+        XR_CHECK_STR("on", leafArgv[0]);
+        XR_CHECK_STR("2", leafArgv[1]);
+    }
+
+    pNode = tree.Resolve("se mainl", leafArgv);
+    XR_CHECK((pNode != nullptr) && (*pNode->GetNodeText() == "MainLeft"));
+    pNode = tree.Resolve("sh u", leafArgv);
+    XR_CHECK((pNode != nullptr) && (*pNode->GetNodeText() == "Up"));
+    pNode = tree.Resolve("STA", leafArgv);
+    XR_CHECK((pNode != nullptr) && (*pNode->GetNodeText() == "Status"));
+    XR_CHECK(tree.Resolve("set st", leafArgv) != nullptr);
+
+    // ambiguous prefixes and unknown tokens do not match
+    XR_CHECK(tree.Resolve("s mainboth", leafArgv) == nullptr);
+    XR_CHECK(tree.Resolve("set main", leafArgv) == nullptr);
+    XR_CHECK(tree.Resolve("set mainbothx", leafArgv) == nullptr);
+    XR_CHECK(tree.Resolve("sets mainboth", leafArgv) == nullptr);
+    XR_CHECK(tree.Resolve("set", leafArgv) == nullptr);
+}
+
+XR_TEST(ParserAutoCompleteCyclesThroughCandidates)
+{
+    TestParserTree tree;
+
+    XR_CHECK_STR("Set ", tree.AutoCompleteFresh("se"));
+    XR_CHECK_STR("Set MainLeft ", tree.AutoCompleteFresh("set mainl"));
+    XR_CHECK_STR("Shift Up ", tree.AutoCompleteFresh("SH U"));
+    XR_CHECK_STR("Set Strobe off ", tree.AutoCompleteFresh("se str of"));
+    XR_CHECK_STR("Set bogus", tree.AutoCompleteFresh("se bogus"));
+    XR_CHECK_STR("s ma", tree.AutoCompleteFresh("s ma"));   // only the last token may be ambiguous
+
+    // tabbing on an ambiguous last token cycles through the matching children in the order they were added, and wraps
+    static const char *s_pForward[] = { "Set ", "Shift ", "Status ", "Set " };
+    tree.ResetAutocompletionState();
+    for (const char *pExpected : s_pForward)
+    {
+        CString csCommand = "s";
+        tree.AutoComplete(csCommand, true);
+        XR_CHECK_STR(pExpected, csCommand);
+    }
+
+    static const char *s_pBackward[] = { "Set MainBoth ", "Set MainLeft ", "Set MainBoth " };
+    tree.ResetAutocompletionState();
+    for (const char *pExpected : s_pBackward)
+    {
+        CString csCommand = "set ma";
+        tree.AutoComplete(csCommand, false);
+        XR_CHECK_STR(pExpected, csCommand);
+    }
+
+    // the first leaf parameter cycles through the leaf handler's tokens
+    static const char *s_pParam[] = { "Set Strobe on ", "Set Strobe off ", "Set Strobe on " };
+    tree.ResetAutocompletionState();
+    for (const char *pExpected : s_pParam)
+    {
+        CString csCommand = "set strobe o";
+        tree.AutoComplete(csCommand, true);
+        XR_CHECK_STR(pExpected, csCommand);
+    }
+}
+
+XR_TEST(ParserAvailableArgumentsListsChildGroups)
+{
+    TestParserTree tree;
+    vector<CString> args;
+
+    CString csCommand = "";
+    XR_CHECK_EQUAL(0, tree.GetAvailableArgumentsForCommand(csCommand, args));
+    XR_CHECK_EQUAL(3, static_cast<int>(args.size()));
+    if (args.size() == 3)
+    {
+        XR_CHECK_STR(" [Set", args[0]);
+        XR_CHECK_STR("Shift]", args[1]);
+        XR_CHECK_STR(" [Status]", args[2]);
+    }
+
+    csCommand = "se bogus";
+    XR_CHECK_EQUAL(1, tree.GetAvailableArgumentsForCommand(csCommand, args));
+    XR_CHECK_EQUAL(3, static_cast<int>(args.size()));
+
+    csCommand = "set strobe";
+    XR_CHECK_EQUAL(2, tree.GetAvailableArgumentsForCommand(csCommand, args));
+    XR_CHECK_EQUAL(1, static_cast<int>(args.size()));
+    if (args.size() == 1)
+        XR_CHECK_STR("[<on/off>]", args[0]);
+}
+
+//-------------------------------------------------------------------------
+// full XRVesselCtrlDemo command tree
+
+// Exposes the full command tree that the XRVesselCtrlDemo dialog uses.
+class TestCommandParser : public XRVCClientCommandParser
+{
+public:
+    TestCommandParser(XRVCClient &client) : XRVCClientCommandParser(client) { }
+    ParserTree &GetTree() { return *m_commandParserTree; }
+};
+
+// partial commands as typed in the command box, each a step longer than the last
+static const char *s_pTypedCommands[] =
+{
+    "", "s", "set", "set e", "set engine", "set engine mainb", "set engine mainboth t", "set engine mainboth throttlelevel",
+    "set engine mainboth throttlelevel 0.5", "set do", "set door gear", "set l st", "set other sec", "Shift", "bogus x",
+};
+
+XR_BENCH(ParserTokenize)
+{
+    const int commandCount = sizeof(s_pTypedCommands) / sizeof(s_pTypedCommands[0]);
+    ParserTreeNode::TokenArray argv;
+    for (long i = 0; i < iterations; i++)
+    {
+        ParserTreeNode::ParseToSpaceDelimitedTokens(s_pTypedCommands[i % commandCount], argv);
+        g_sink = argv.size();
+    }
+}
+
+// One op refreshes the available-arguments help for one typed command, as the dialog's 100 ms timer does.
+XR_BENCH(ParserTreeAvailableArguments)
+{
+    const int commandCount = sizeof(s_pTypedCommands) / sizeof(s_pTypedCommands[0]);
+    XRVCClient client;
+    TestCommandParser parser(client);
+    vector<CString> args;
+    for (long i = 0; i < iterations; i++)
+    {
+        CString csCommand = s_pTypedCommands[i % commandCount];
+        g_sink = parser.GetTree().GetAvailableArgumentsForCommand(csCommand, args);
+    }
+}
+
+// One op is a keystroke: the autocompletion state is reset and the typed command is autocompleted.
+XR_BENCH(ParserTreeAutoCompleteTyped)
+{
+    const int commandCount = sizeof(s_pTypedCommands) / sizeof(s_pTypedCommands[0]);
+    XRVCClient client;
+    TestCommandParser parser(client);
+    for (long i = 0; i < iterations; i++)
+    {
+        CString csCommand = s_pTypedCommands[i % commandCount];
+        parser.GetTree().ResetAutocompletionState();
+        g_sink = parser.GetTree().AutoComplete(csCommand, true);
+    }
+}
@@ -0,0 +1,268 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// PayloadBayTests.cpp : the XR2, XR3, and XR5 payload bays' cached slot
+// sweeps against a fresh sweep of the bay.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "DeltaGliderXR1.h"
+#include "XRPayload.h"
+#include "XRPayloadBaySlot.h"
+#include "XR2PayloadBay.h"
+#include "XR3PayloadBay.h"
+#include "XR5PayloadBay.h"
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// Reaches the protected sweep methods of a slot; never instantiated.
+class SlotSweeper : public XRPayloadBaySlot
+{
+public:
+    typedef XRPayloadBaySlot::SweepResult SweepResult;
+
+    // returns the result cached by PrecomputeSweeps, sweeping the bay only if this class was not precomputed
+    static const SweepResult &GetCachedSweep(const XRPayloadBaySlot &slot, const XRPayloadClassData &pcd)
+    {
+        return (slot.*(&SlotSweeper::GetSweepResult))(pcd);
+    }
+
+    // sweeps the bay now, bypassing the cache
+    static bool SweepNow(const XRPayloadBaySlot &slot, const XRPayloadClassData &pcd, vector<const XRPayloadBaySlot *> &vOut)
+    {
+        return (slot.*(&SlotSweeper::SweepSlots))(pcd.GetPrimarySlotCenterOfMassOffset(), pcd.GetDimensions(), vOut);
+    }
+};
+
+// A payload vessel of the given class with its XRCARGO attachment point.
+class TestPayloadVessel : public VESSEL
+{
+public:
+    TestPayloadVessel(const char *pClassname)
+    {
+        m_className = pClassname;
+        CreateAttachment(true, _V(0, 0, 0), _V(0, -1, 0), _V(0, 0, 1), "XRCARGO");
+    }
+};
+
+// Builds one vessel's bay and sweeps every XR payload class found in the Orbiter folder from every slot,
+// as XRPayloadBay::PerformFinalInitialization does.
+template <class VesselType, class BayType>
+struct BayFixture
+{
+    BayFixture(const char *pClassname)
+    {
+        vessel.m_className = pClassname;
+        XRPayloadClassData::InitializeXRPayloadClassData();
+        ppPayloadClasses = XRPayloadClassData::GetAllAvailableXRPayloads();
+        for (const XRPayloadClassData **pp = ppPayloadClasses; *pp != nullptr; pp++)
+            payloadVessels.push_back(new TestPayloadVessel((*pp)->GetClassname()));
+
+        pBay = new BayType(vessel);
+        for (int slotNumber = 1; slotNumber <= pBay->GetSlotCount(); slotNumber++)
+            pBay->GetSlot(slotNumber)->PrecomputeSweeps(ppPayloadClasses);
+    }
+
+    ~BayFixture()
+    {
+        delete pBay;
+        for (VESSEL *pVessel : payloadVessels)
+            delete pVessel;
+    }
+
+    VesselType vessel;
+    BayType *pBay;
+    const XRPayloadClassData **ppPayloadClasses;
+    vector<VESSEL *> payloadVessels;
+};
+
+typedef BayFixture<XR2Ravenstar, XR2PayloadBay> XR2BayFixture;
+typedef BayFixture<XR3Phoenix, XR3PayloadBay> XR3BayFixture;
+typedef BayFixture<XR5Vanguard, XR5PayloadBay> XR5BayFixture;
+
+// Compares every cached sweep against a fresh one, slot for slot and in sweep order, and verifies that the
+// fit checks built on them let some payloads in and keep others out.
+template <class Fixture>
+static void CheckCachedSweeps(const char *pClassname, const int expectedSlotCount)
+{
+    Fixture fixture(pClassname);
+    XR_CHECK_EQUAL(expectedSlotCount, fixture.pBay->GetSlotCount());
+    XR_CHECK(fixture.payloadVessels.size() >= 5);
+
+    int mismatchCount = 0;
+    int clearsHullCount = 0, hitsHullCount = 0, fitCount = 0, noFitCount = 0;
+    for (int slotNumber = 1; slotNumber <= fixture.pBay->GetSlotCount(); slotNumber++)
+    {
+        const XRPayloadBaySlot &slot = *fixture.pBay->GetSlot(slotNumber);
+        for (const XRPayloadClassData **pp = fixture.ppPayloadClasses; *pp != nullptr; pp++)
+        {
+            const SlotSweeper::SweepResult &cached = SlotSweeper::GetCachedSweep(slot, **pp);
+            vector<const XRPayloadBaySlot *> freshSlots;
+            const bool freshClearsHull = SlotSweeper::SweepNow(slot, **pp, freshSlots);
+            if ((cached.clearsHull != freshClearsHull) || (cached.slots != freshSlots))
+            {
+                if (++mismatchCount <= 3)
+                {
+                    XRTests::Fail(__FILE__, __LINE__, "%s slot %d, %s: cached sweep (clears hull %d, %d slots) != fresh sweep (clears hull %d, %d slots)",
+                        pClassname, slotNumber, (*pp)->GetClassname(), cached.clearsHull, static_cast<int>(cached.slots.size()),
+                        freshClearsHull, static_cast<int>(freshSlots.size()));
+                }
+            }
+            (freshClearsHull ? clearsHullCount : hitsHullCount)++;
+        }
+
+        for (const VESSEL *pPayload : fixture.payloadVessels)
+            (slot.CheckSlotSpace(*pPayload) ? fitCount : noFitCount)++;
+    }
+
+    XR_CHECK_EQUAL(0, mismatchCount);
+    XR_CHECK(clearsHullCount > 0);
+    XR_CHECK(hitsHullCount > 0);
+    XR_CHECK(fitCount > 0);
+    XR_CHECK(noFitCount > 0);
+}
+
+XR_TEST(XR2CachedSweepsMatchFreshSweeps)
+{
+    CheckCachedSweeps<XR2BayFixture>("XR2Ravenstar", 3);
+}
+
+XR_TEST(XR3CachedSweepsMatchFreshSweeps)
+{
+    CheckCachedSweeps<XR3BayFixture>("XR3Phoenix", 36);
+}
+
+XR_TEST(XR5CachedSweepsMatchFreshSweeps)
+{
+    CheckCachedSweeps<XR5BayFixture>("XR5Vanguard", 36);
+}
+
+// The bay's payload mass is cached as payload is attached and detached; ComputePayloadMass reads each attached
+// vessel without changing the cache, and PollPayloadMass picks up a vessel that changed its own mass.
+XR_TEST(XR5PayloadMassReadsAttachedVessels)
+{
+    XR5BayFixture fixture("XR5Vanguard");
+    XRPayloadBaySlot *pSlot = nullptr;
+    VESSEL *pPayload = nullptr;
+    for (int slotNumber = 1; (slotNumber <= fixture.pBay->GetSlotCount()) && (pPayload == nullptr); slotNumber++)
+    {
+        for (VESSEL *pCandidate : fixture.payloadVessels)
+        {
+            if (fixture.pBay->GetSlot(slotNumber)->CheckSlotSpace(*pCandidate))
+            {
+                pSlot = fixture.pBay->GetSlot(slotNumber);
+                pPayload = pCandidate;
+                break;
+            }
+        }
+    }
+    XR_CHECK(pPayload != nullptr);
+    if (pPayload == nullptr)
+        return;
+
+    oapiRegisterTestVessel(pPayload);
+    pPayload->m_mass = 1500;
+    XR_CHECK(pSlot->AttachChild(*pPayload));
+    XR_CHECK_NEAR(1500, fixture.pBay->GetPayloadMass(), 0);
+
+    pPayload->m_mass = 1200;     // e.g., the payload burned some of its own fuel
+    XR_CHECK_NEAR(1200, fixture.pBay->ComputePayloadMass(), 0);
+    XR_CHECK_NEAR(1500, fixture.pBay->GetPayloadMass(), 0);
+    XR_CHECK_NEAR(1200, fixture.pBay->PollPayloadMass(), 0);
+    XR_CHECK_NEAR(1200, fixture.pBay->GetPayloadMass(), 0);
+
+    XR_CHECK(pSlot->DetachChild(0));
+    XR_CHECK_NEAR(0, fixture.pBay->GetPayloadMass(), 0);
+    XR_CHECK_NEAR(0, fixture.pBay->ComputePayloadMass(), 0);
+    oapiUnregisterTestVessel(pPayload);
+}
+
+// One op is a sweep of every payload class from every slot of the bay, either from the cache or afresh.
+template <class Fixture>
+static void BenchSweeps(Fixture &fixture, const bool bCached, const long iterations)
+{
+    const int slotCount = fixture.pBay->GetSlotCount();
+    vector<const XRPayloadBaySlot *> slots;
+    for (long i = 0; i < iterations; i++)
+    {
+        size_t slotTotal = 0;
+        for (int slotNumber = 1; slotNumber <= slotCount; slotNumber++)
+        {
+            const XRPayloadBaySlot &slot = *fixture.pBay->GetSlot(slotNumber);
+            for (const XRPayloadClassData **pp = fixture.ppPayloadClasses; *pp != nullptr; pp++)
+            {
+                if (bCached)
+                {
+                    slotTotal += SlotSweeper::GetCachedSweep(slot, **pp).slots.size();
+                }
+                else
+                {
+                    slots.clear();
+                    SlotSweeper::SweepNow(slot, **pp, slots);
+                    slotTotal += slots.size();
+                }
+            }
+        }
+        g_sink = static_cast<double>(slotTotal);
+    }
+}
+
+XR_BENCH(XR2BaySweepCached)
+{
+    static XR2BayFixture s_fixture("XR2Ravenstar");
+    BenchSweeps(s_fixture, true, iterations);
+}
+
+XR_BENCH(XR2BaySweepFresh)
+{
+    static XR2BayFixture s_fixture("XR2Ravenstar");
+    BenchSweeps(s_fixture, false, iterations);
+}
+
+XR_BENCH(XR3BaySweepCached)
+{
+    static XR3BayFixture s_fixture("XR3Phoenix");
+    BenchSweeps(s_fixture, true, iterations);
+}
+
+XR_BENCH(XR3BaySweepFresh)
+{
+    static XR3BayFixture s_fixture("XR3Phoenix");
+    BenchSweeps(s_fixture, false, iterations);
+}
+
+XR_BENCH(XR5BaySweepCached)
+{
+    static XR5BayFixture s_fixture("XR5Vanguard");
+    BenchSweeps(s_fixture, true, iterations);
+}
+
+XR_BENCH(XR5BaySweepFresh)
+{
+    static XR5BayFixture s_fixture("XR5Vanguard");
+    BenchSweeps(s_fixture, false, iterations);
+}
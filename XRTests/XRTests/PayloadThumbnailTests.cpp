@@ -0,0 +1,168 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// PayloadThumbnailTests.cpp : payload class data initialization time and
+// thumbnail memory, and the on-demand XRPayloadThumbnailCache.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRPayload.h"
+#include "XRPayloadThumbnailCache.h"
+#include <chrono>
+#include <set>
+#include <thread>
+
+using namespace XRTests;
+
+static const long THUMBNAIL_BYTES = PAYLOAD_THUMBNAIL_DIMX * PAYLOAD_THUMBNAIL_DIMY * 3;   // see LoadImage in stubs/windows.h
+
+// Frees all payload class data and thumbnails and rescans Config\Vessels, as a fresh simulation session does.
+static const XRPayloadClassData **ReinitializePayloadClassData()
+{
+    XRPayloadClassData::Terminate();
+    XRPayloadClassData::InitializeXRPayloadClassData();
+    return XRPayloadClassData::GetAllAvailableXRPayloads();
+}
+
+// Requests a thumbnail until the worker thread has decoded it, as a dialog does on each redraw.
+// Returns the decoded bitmap, or the placeholder if it did not load within a few seconds.
+static HBITMAP WaitForThumbnail(const char *pThumbnailPath, const HBITMAP hPlaceholder)
+{
+    XRPayloadThumbnailCache &cache = XRPayloadThumbnailCache::GetInstance();
+    HBITMAP hBitmap = cache.GetThumbnail(pThumbnailPath);
+    for (int i = 0; (i < 5000) && (hBitmap == hPlaceholder); i++)
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+        hBitmap = cache.GetThumbnail(pThumbnailPath);
+    }
+    return hBitmap;
+}
+
+// Returns a path that names the same file as pThumbnailPath but is a different cache key each time 'variant' changes.
+static string MakeAliasPath(const char *pThumbnailPath, const int variant)
+{
+    string path;
+    for (int i = 0; i < variant; i++)
+        path += "Vessels\\..\\";
+    return path + pThumbnailPath;
+}
+
+XR_TEST(PayloadClassDataInitLoadsNoThumbnails)
+{
+    const XRPayloadClassData **ppPayloadClasses = ReinitializePayloadClassData();
+    XR_CHECK(ppPayloadClasses[0] != nullptr);
+    XR_CHECK_EQUAL(0L, g_liveBitmapBytes.load());
+}
+
+XR_TEST(PayloadThumbnailCacheLoadsOnDemandAndKeepsPinned)
+{
+    const XRPayloadClassData **ppPayloadClasses = ReinitializePayloadClassData();
+    XRPayloadThumbnailCache &cache = XRPayloadThumbnailCache::GetInstance();
+
+    // the placeholder is null only until the worker thread has decoded it
+    const HBITMAP hPlaceholder = WaitForThumbnail(DEFAULT_PAYLOAD_THUMBNAIL_PATH, nullptr);
+    XR_CHECK(hPlaceholder != nullptr);
+    XR_CHECK_EQUAL(THUMBNAIL_BYTES, g_liveBitmapBytes.load());
+
+    const char *pThumbnailPath = nullptr;
+    for (const XRPayloadClassData **pp = ppPayloadClasses; *pp != nullptr; pp++)
+    {
+        if (strcasecmp((*pp)->GetThumbnailPath(), DEFAULT_PAYLOAD_THUMBNAIL_PATH) != 0)
+        {
+            pThumbnailPath = (*pp)->GetThumbnailPath();
+            break;
+        }
+    }
+    XR_CHECK(pThumbnailPath != nullptr);
+    if (pThumbnailPath == nullptr)
+        return;
+
+    const HBITMAP hPinned = WaitForThumbnail(pThumbnailPath, hPlaceholder);
+    XR_CHECK(hPinned != hPlaceholder);
+    cache.Pin(hPinned);
+
+    // request more thumbnails than the cache holds; the pinned one is now the least recently used
+    for (int i = 1; i <= XRPayloadThumbnailCache::CAPACITY + 4; i++)
+        XR_CHECK(WaitForThumbnail(MakeAliasPath(pThumbnailPath, i).c_str(), hPlaceholder) != hPlaceholder);
+    XR_CHECK(g_liveBitmapBytes.load() <= (XRPayloadThumbnailCache::CAPACITY + 1) * THUMBNAIL_BYTES);
+    XR_CHECK(cache.GetThumbnail(pThumbnailPath) == hPinned);
+
+    // once unpinned it is evicted like any other thumbnail
+    cache.Unpin(hPinned);
+    for (int i = 1; i <= XRPayloadThumbnailCache::CAPACITY + 1; i++)
+        WaitForThumbnail(MakeAliasPath(pThumbnailPath, XRPayloadThumbnailCache::CAPACITY + 4 + i).c_str(), hPlaceholder);
+    XR_CHECK(cache.GetThumbnail(pThumbnailPath) == hPlaceholder);
+
+    XRPayloadClassData::Terminate();
+    XR_CHECK_EQUAL(0L, g_liveBitmapBytes.load());
+    XRPayloadClassData::InitializeXRPayloadClassData();
+}
+
+// Returns the distinct installed thumbnails of the supplied payload classes, lowercased as the cache keys them, not counting
+// the placeholder; some payloads name a thumbnail that is not installed.
+static set<string> GetInstalledThumbnailPaths(const XRPayloadClassData **ppPayloadClasses)
+{
+    set<string> paths;
+    for (const XRPayloadClassData **pp = ppPayloadClasses; *pp != nullptr; pp++)
+    {
+        string path((*pp)->GetThumbnailPath());
+        transform(path.begin(), path.end(), path.begin(), [](const char c) { return static_cast<char>(tolower(static_cast<unsigned char>(c))); });
+        struct stat st;
+        if ((strcasecmp(path.c_str(), DEFAULT_PAYLOAD_THUMBNAIL_PATH) != 0) && (stat(XRTestsNativePath(("Config\\" + path).c_str()).c_str(), &st) == 0))
+            paths.insert(path);
+    }
+    return paths;
+}
+
+// One op scans Config\Vessels and builds the payload class data, as the first PostStep of each session does
+// (the previous session's data is freed first).  No thumbnail may be held afterwards.
+XR_BENCH(PayloadClassDataInit)
+{
+    for (long i = 0; i < iterations; i++)
+        ReinitializePayloadClassData();
+    ReportMetric("init_bitmap_bytes", static_cast<double>(g_liveBitmapBytes.load()));
+}
+
+// One op initializes the payload class data and then shows every installed thumbnail, as scrolling through
+// the whole payload list does.  Reports the thumbnail memory held afterwards, which the cache bounds, and the
+// memory that loading every thumbnail up front would take, as initialization did before the cache was added.
+XR_BENCH(PayloadThumbnailShowAll)
+{
+    size_t thumbnailCount = 0;
+    for (long i = 0; i < iterations; i++)
+    {
+        const set<string> thumbnailPaths = GetInstalledThumbnailPaths(ReinitializePayloadClassData());
+        const HBITMAP hPlaceholder = WaitForThumbnail(DEFAULT_PAYLOAD_THUMBNAIL_PATH, nullptr);
+        for (const string &path : thumbnailPaths)
+            WaitForThumbnail(path.c_str(), hPlaceholder);
+        thumbnailCount = thumbnailPaths.size();
+    }
+    ReportMetric("shown_bitmap_bytes", static_cast<double>(g_liveBitmapBytes.load()));
+    ReportMetric("eager_bitmap_bytes", static_cast<double>((thumbnailCount + 1) * THUMBNAIL_BYTES));   // + 1 for the placeholder
+
+    // stop the worker thread, but leave the class data initialized for any benchmarks that follow
+    XRPayloadClassData::Terminate();
+    XRPayloadClassData::InitializeXRPayloadClassData();
+}
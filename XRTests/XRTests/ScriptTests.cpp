@@ -0,0 +1,188 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// ScriptTests.cpp : XRVesselCtrlDemo scripts, compiled by XRVCScript
+// versus running each line as an interactive command.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRTestsVessel.h"
+#include "XRVCScript.h"
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// script lines in mixed case, plus the timing instructions only compiled scripts support
+static const char *s_pScriptLines[] =
+{
+    "Set Engine MainBoth ThrottleLevel 0.5",
+    "Set Engine ScramLeft GimbalX -0.25",
+    "Set Engine HoverFore AutoMode on",
+    "set door payloadbaydoors open",
+    "Set Door Gear Close",
+    "set light strobe on",
+    "Set Other SecondaryHUDMode 3",
+    "set other rcsdockingmode off",
+    "wait 0",
+    "wait-until SimTime >= 0",
+};
+static const int TIMING_LINE_COUNT = 2;   // at the end of s_pScriptLines
+static const int SCRIPT_LINE_COUNT = 100000;
+
+// Returns a script of SCRIPT_LINE_COUNT lines, cycling through s_pScriptLines
+static vector<CString> MakeScript(const bool includeTimingLines)
+{
+    const int sampleCount = static_cast<int>(sizeof(s_pScriptLines) / sizeof(s_pScriptLines[0])) - (includeTimingLines ? 0 : TIMING_LINE_COUNT);
+    vector<CString> lines;
+    lines.reserve(SCRIPT_LINE_COUNT);
+    for (int i = 0; i < SCRIPT_LINE_COUNT; i++)
+        lines.push_back(s_pScriptLines[i % sampleCount]);
+    return lines;
+}
+
+// counts the commands echoed to the user, as XRVCMainDialog shows them
+class CountingScriptListener : public XRVCScript::Listener
+{
+public:
+    CountingScriptListener() : m_commandCount(0) { }
+    virtual void ScriptCommandExecuting(const CString &csCommand) { m_commandCount++; }
+    long m_commandCount;
+};
+
+// Runs each script line the way scripts ran before XRVCScript: autocompleted as the command box does, then executed.
+// Returns the number of lines that failed.
+static int InterpretScript(const vector<CString> &lines, XRVCClientCommandParser &parser)
+{
+    int failedCount = 0;
+    CString status;
+    for (const CString &line : lines)
+    {
+        CString command = line;
+        parser.ResetAutocompletionState();
+        parser.AutoCompleteCommand(command, true);
+        if (!parser.ExecuteCommand(command, status))
+            failedCount++;
+    }
+    return failedCount;
+}
+
+// A compiled script must make exactly the vessel calls that running the same lines one at a time makes.
+XR_TEST(XRVCScriptMatchesInteractiveCommands)
+{
+    const vector<CString> lines = MakeScript(false);
+
+    XRTestsVessel interpretedVessel;
+    XRVCClient interpretedClient;
+    interpretedClient.SetXRVessel(&interpretedVessel);
+    XRVCClientCommandParser interpretedParser(interpretedClient);
+    XR_CHECK_EQUAL(0, InterpretScript(lines, interpretedParser));
+
+    XRTestsVessel compiledVessel;
+    XRVCClient compiledClient;
+    compiledClient.SetXRVessel(&compiledVessel);
+    XRVCClientCommandParser compiledParser(compiledClient);
+    XRVCScript script;
+    CString status;
+    XR_CHECK(script.Compile(lines, compiledParser, &compiledVessel, status));
+    XR_CHECK_EQUAL(SCRIPT_LINE_COUNT, script.GetInstructionCount());
+
+    CountingScriptListener listener;
+    XR_CHECK(script.Step(&compiledVessel, 0, listener, status) == XRVCScript::StepResult::Completed);
+    XR_CHECK_EQUAL(static_cast<long>(SCRIPT_LINE_COUNT), listener.m_commandCount);
+    XR_CHECK(compiledVessel.m_setCount > 0);
+    XR_CHECK_EQUAL(interpretedVessel.m_setCount, compiledVessel.m_setCount);
+}
+
+XR_TEST(XRVCScriptWaitsAndAborts)
+{
+    XRTestsVessel vessel, otherVessel;
+    XRVCClient client;
+    client.SetXRVessel(&vessel);
+    XRVCClientCommandParser parser(client);
+    XRVCScript script;
+    CString status;
+    CountingScriptListener listener;
+
+    const vector<CString> waitLines = { "set light strobe on", "wait 10", "set light strobe off" };
+    XR_CHECK(script.Compile(waitLines, parser, &vessel, status));
+    XR_CHECK(script.Step(&vessel, 100, listener, status) == XRVCScript::StepResult::Waiting);
+    XR_CHECK_EQUAL(1L, listener.m_commandCount);
+    XR_CHECK(script.Step(&vessel, 109.9, listener, status) == XRVCScript::StepResult::Waiting);
+    XR_CHECK(script.Step(&vessel, 110, listener, status) == XRVCScript::StepResult::Completed);
+    XR_CHECK_EQUAL(2L, listener.m_commandCount);
+
+    // the script stops if the user selects another vessel while it waits
+    XR_CHECK(script.Compile(waitLines, parser, &vessel, status));
+    XR_CHECK(script.Step(&vessel, 0, listener, status) == XRVCScript::StepResult::Waiting);
+    XR_CHECK(script.Step(&otherVessel, 20, listener, status) == XRVCScript::StepResult::Failed);
+    XR_CHECK(!script.IsRunning());
+
+    // bad lines are reported before anything runs
+    const vector<CString> badLines = { "set light strobe on", "wait -1" };
+    const long setCount = vessel.m_setCount;
+    XR_CHECK(!script.Compile(badLines, parser, &vessel, status));
+    XR_CHECK_EQUAL(setCount, vessel.m_setCount);
+}
+
+// One op compiles and runs a 100,000-line script in a single frame.  Also reports the compile and run time per line.
+XR_BENCH(XRVCScriptCompileAndRun100kLines)
+{
+    typedef chrono::steady_clock Clock;
+    const vector<CString> lines = MakeScript(true);
+    XRTestsVessel vessel;
+    XRVCClient client;
+    client.SetXRVessel(&vessel);
+    XRVCClientCommandParser parser(client);
+    XRVCScript script;
+    CountingScriptListener listener;
+    CString status;
+
+    double compileSeconds = 0, runSeconds = 0;
+    for (long i = 0; i < iterations; i++)
+    {
+        const Clock::time_point start = Clock::now();
+        script.Compile(lines, parser, &vessel, status);
+        const Clock::time_point compiled = Clock::now();
+        g_sink = static_cast<double>(script.Step(&vessel, 0, listener, status));
+        compileSeconds += chrono::duration<double>(compiled - start).count();
+        runSeconds += chrono::duration<double>(Clock::now() - compiled).count();
+    }
+    ReportMetric("compile_ns_per_line", compileSeconds * 1e9 / (static_cast<double>(iterations) * SCRIPT_LINE_COUNT));
+    ReportMetric("run_ns_per_line", runSeconds * 1e9 / (static_cast<double>(iterations) * SCRIPT_LINE_COUNT));
+}
+
+// One op runs the same 100,000 lines (less the timing instructions) one command at a time, as scripts ran before XRVCScript.
+XR_BENCH(XRVCScriptInterpret100kLines)
+{
+    const vector<CString> lines = MakeScript(false);
+    XRTestsVessel vessel;
+    XRVCClient client;
+    client.SetXRVessel(&vessel);
+    XRVCClientCommandParser parser(client);
+    for (long i = 0; i < iterations; i++)
+        g_sink = InterpretScript(lines, parser);
+}
@@ -0,0 +1,230 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// SoundVoiceCacheTests.cpp : XRSoundVoiceCache's lazy loading, memory
+// budget, and least-recently-used eviction of voices that are not playing.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRSoundVoiceCache.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <string>
+#include <map>
+#include <deque>
+
+using namespace std;
+using namespace XRTests;
+
+// Records the file loaded into each voice and which voices are playing.
+class FakeXRSound : public XRSound
+{
+public:
+    virtual bool LoadWav(const int soundID, const char *pSoundFilename, const PlaybackType playbackType) override
+    {
+        m_voiceFiles[soundID] = pSoundFilename;
+        m_playing[soundID] = false;     // loading a new file into a voice stops its old sample
+        return true;
+    }
+    virtual bool PlayWav(const int soundID, const bool bLoop, const float volume) override
+    {
+        if (m_voiceFiles.find(soundID) == m_voiceFiles.end())
+            return false;
+        m_playing[soundID] = true;
+        return true;
+    }
+    virtual bool StopWav(const int soundID) override { m_playing[soundID] = false; return true; }
+    virtual bool IsWavPlaying(const int soundID) override { return m_playing[soundID]; }
+
+    int GetLoadedVoiceCount() const { return static_cast<int>(m_voiceFiles.size()); }
+    const string &GetVoiceFile(const int voiceID) { return m_voiceFiles[voiceID]; }
+
+protected:
+    map<int, string> m_voiceFiles;
+    map<int, bool> m_playing;
+};
+
+// Exposes the cache's sound entries so the tests can check the budget and each sound's voice.
+class TestVoiceCache : public XRSoundVoiceCache
+{
+public:
+    int GetVoiceCount() const { return static_cast<int>(m_voices.size()); }
+    int SumVoiceBytes() const
+    {
+        int bytes = 0;
+        for (const Voice &voice : m_voices)
+        {
+            if (voice.soundID != 0)
+                bytes += voice.bytes;
+        }
+        return bytes;
+    }
+};
+
+// Creates sound files of the requested sizes in /tmp and removes them when the test ends.
+class SoundFiles
+{
+public:
+    SoundFiles(const char *pTestName) : m_testName(pTestName) { }
+    ~SoundFiles()
+    {
+        for (const string &path : m_paths)
+            remove(path.c_str());
+    }
+
+    // Returns the path of a new file of fileBytes bytes
+    const char *Create(const int fileBytes)
+    {
+        char path[256];
+        sprintf(path, "/tmp/XRTests-%s-%d-%d.wav", m_testName, static_cast<int>(getpid()), static_cast<int>(m_paths.size()));
+        FILE *pFile = fopen(path, "wb");
+        const string data(fileBytes, 'x');
+        fwrite(data.data(), 1, data.size(), pFile);
+        fclose(pFile);
+        m_paths.push_back(path);
+        return m_paths.back().c_str();
+    }
+
+protected:
+    const char *m_testName;
+    deque<string> m_paths;      // deque so that returned pointers stay valid
+};
+
+XR_TEST(SoundVoiceCacheLoadsOnFirstPlay)
+{
+    SoundFiles files("SoundVoiceCacheLoadsOnFirstPlay");
+    FakeXRSound xrSound;
+    TestVoiceCache cache;
+    cache.Initialize(&xrSound, 0);
+
+    cache.Register(1, files.Create(1000), XRSound::PlaybackType::InternalOnly);
+    cache.Register(2, files.Create(2000), XRSound::PlaybackType::Radio);
+    XR_CHECK_EQUAL(0, xrSound.GetLoadedVoiceCount());
+    XR_CHECK_EQUAL(0, cache.GetVoice(1));
+
+    const int voiceID = cache.AcquireVoice(1);
+    XR_CHECK(voiceID > 0);
+    XR_CHECK_EQUAL(voiceID, cache.GetVoice(1));
+    XR_CHECK_EQUAL(voiceID, cache.AcquireVoice(1));
+    XR_CHECK_EQUAL(0, cache.GetVoice(2));
+    XR_CHECK_EQUAL(0, cache.AcquireVoice(3));    // never registered
+
+    const XRSoundVoiceCache::Stats &stats = cache.GetStats();
+    XR_CHECK_EQUAL(2u, stats.requests);
+    XR_CHECK_EQUAL(1u, stats.hits);
+    XR_CHECK_EQUAL(1u, stats.loads);
+    XR_CHECK_EQUAL(1000, stats.residentBytes);
+}
+
+// A large sound must evict as many cold sounds as it takes to fit, oldest first, and reuse a freed voice.
+XR_TEST(SoundVoiceCacheEvictsUntilSoundFits)
+{
+    SoundFiles files("SoundVoiceCacheEvictsUntilSoundFits");
+    FakeXRSound xrSound;
+    TestVoiceCache cache;
+    cache.Initialize(&xrSound, 4000);
+
+    for (int soundID = 1; soundID <= 4; soundID++)
+    {
+        cache.Register(soundID, files.Create(1000), XRSound::PlaybackType::InternalOnly);
+        cache.AcquireVoice(soundID);
+    }
+    XR_CHECK_EQUAL(4000, cache.GetStats().residentBytes);
+    XR_CHECK_EQUAL(4, cache.GetVoiceCount());
+
+    cache.AcquireVoice(3);      // sounds 1 and 2 are now the least recently used
+    cache.AcquireVoice(4);
+
+    cache.Register(5, files.Create(2500), XRSound::PlaybackType::InternalOnly);
+    const int voiceID = cache.AcquireVoice(5);
+    XR_CHECK(voiceID > 0);
+    XR_CHECK_EQUAL(0, cache.GetVoice(1));
+    XR_CHECK_EQUAL(0, cache.GetVoice(2));
+    XR_CHECK_EQUAL(0, cache.GetVoice(3));
+    XR_CHECK(cache.GetVoice(4) > 0);
+    XR_CHECK_EQUAL(3500, cache.GetStats().residentBytes);
+    XR_CHECK_EQUAL(cache.SumVoiceBytes(), cache.GetStats().residentBytes);
+    XR_CHECK_EQUAL(4, cache.GetVoiceCount());       // reused an evicted voice rather than adding one
+
+    // the other evicted voices are reused before any new voice is added
+    cache.AcquireVoice(1);
+    XR_CHECK_EQUAL(4, cache.GetVoiceCount());
+    XR_CHECK(cache.GetStats().residentBytes <= 4000);
+    XR_CHECK_EQUAL(cache.SumVoiceBytes(), cache.GetStats().residentBytes);
+}
+
+// Sounds that are playing are never evicted, even if that means exceeding the budget.
+XR_TEST(SoundVoiceCacheNeverEvictsPlayingSounds)
+{
+    SoundFiles files("SoundVoiceCacheNeverEvictsPlayingSounds");
+    FakeXRSound xrSound;
+    TestVoiceCache cache;
+    cache.Initialize(&xrSound, 3000);
+
+    for (int soundID = 1; soundID <= 3; soundID++)
+    {
+        cache.Register(soundID, files.Create(1000), XRSound::PlaybackType::InternalOnly);
+        xrSound.PlayWav(cache.AcquireVoice(soundID), false, 1.0f);
+    }
+    xrSound.StopWav(cache.GetVoice(2));
+
+    cache.Register(4, files.Create(2000), XRSound::PlaybackType::InternalOnly);
+    XR_CHECK(cache.AcquireVoice(4) > 0);
+    XR_CHECK(cache.GetVoice(1) > 0);
+    XR_CHECK_EQUAL(0, cache.GetVoice(2));
+    XR_CHECK(cache.GetVoice(3) > 0);
+    XR_CHECK(xrSound.IsWavPlaying(cache.GetVoice(1)));
+    XR_CHECK(xrSound.IsWavPlaying(cache.GetVoice(3)));
+    XR_CHECK_EQUAL(4000, cache.GetStats().residentBytes);
+    XR_CHECK_EQUAL(cache.SumVoiceBytes(), cache.GetStats().residentBytes);
+}
+
+// Registering a new file for a sound that is playing must leave the old sample reachable so it can be stopped.
+XR_TEST(SoundVoiceCacheReRegisterKeepsPlayingVoice)
+{
+    SoundFiles files("SoundVoiceCacheReRegisterKeepsPlayingVoice");
+    FakeXRSound xrSound;
+    TestVoiceCache cache;
+    cache.Initialize(&xrSound, 0);
+
+    const string oldFile = files.Create(1000);
+    cache.Register(1, oldFile.c_str(), XRSound::PlaybackType::Radio);
+    const int voiceID = cache.AcquireVoice(1);
+    xrSound.PlayWav(voiceID, true, 1.0f);
+
+    const string newFile = files.Create(1500);
+    cache.Register(1, newFile.c_str(), XRSound::PlaybackType::Radio);
+    XR_CHECK_EQUAL(voiceID, cache.GetVoice(1));
+    XR_CHECK(xrSound.IsWavPlaying(cache.GetVoice(1)));
+    XR_CHECK_STR(oldFile.c_str(), xrSound.GetVoiceFile(voiceID).c_str());
+    xrSound.StopWav(cache.GetVoice(1));
+    XR_CHECK(!xrSound.IsWavPlaying(voiceID));
+
+    // the next play loads the new file into the same voice
+    XR_CHECK_EQUAL(voiceID, cache.AcquireVoice(1));
+    XR_CHECK_STR(newFile.c_str(), xrSound.GetVoiceFile(voiceID).c_str());
+    XR_CHECK_EQUAL(1500, cache.GetStats().residentBytes);
+    XR_CHECK_EQUAL(2u, cache.GetStats().loads);
+}
@@ -0,0 +1,221 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// TelemetryTests.cpp : XRTelemetryChannel publish and read, torn-read
+// checks with concurrent readers, and publisher throughput.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "XRTelemetry.h"
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// Fills every field of the record from 'value' so that a reader can tell whether it got a record from a single Publish.
+static void FillRecord(XRTelemetryRecord &record, const unsigned long long value)
+{
+    double *pDoubles = reinterpret_cast<double *>(&record);
+    for (size_t i = 0; i < sizeof(record) / sizeof(double); i++)
+        pDoubles[i] = static_cast<double>(value) + i;
+}
+
+// Returns true if every field of the record came from the same FillRecord call
+static bool IsRecordConsistent(const XRTelemetryRecord &record)
+{
+    const double *pDoubles = reinterpret_cast<const double *>(&record);
+    for (size_t i = 1; i < sizeof(record) / sizeof(double); i++)
+    {
+        if (pDoubles[i] != pDoubles[0] + i)
+            return false;
+    }
+    return true;
+}
+
+XR_TEST(TelemetryChannelPublishAndRead)
+{
+    XRTelemetryChannel channel;
+    XR_CHECK(channel.Open("XRTests-01", false));
+    XR_CHECK(!channel.IsSharedMemory());
+
+    XRTelemetryRecord record;
+    XR_CHECK(!channel.Read(record));    // nothing published yet
+
+    for (unsigned long long i = 1; i <= 3; i++)
+    {
+        FillRecord(record, i);
+        channel.Publish(record);
+    }
+
+    XRTelemetryRecord readRecord;
+    unsigned long long sequence = 0;
+    XR_CHECK(channel.Read(readRecord, &sequence));
+    XR_CHECK(IsRecordConsistent(readRecord));
+    XR_CHECK_EQUAL(3.0, readRecord.SimTime);
+    XR_CHECK_EQUAL(6ULL, sequence);     // two per Publish
+}
+
+XR_TEST(TelemetryReaderAttachesByVesselName)
+{
+    XRTelemetryReader reader;
+    XR_CHECK(!reader.Open("XRTests-02"));   // not publishing yet
+
+    XRTelemetryChannel channel;
+    XR_CHECK(channel.Open("XRTests-02", true));
+    XR_CHECK(channel.IsSharedMemory());
+    XR_CHECK(reader.Open("XRTests-02"));
+
+    XRTelemetryRecord record, readRecord;
+    XR_CHECK(!reader.ReadIfNew(readRecord));
+    FillRecord(record, 42);
+    channel.Publish(record);
+    XR_CHECK(reader.ReadIfNew(readRecord));
+    XR_CHECK_EQUAL(42.0, readRecord.SimTime);
+    XR_CHECK(!reader.ReadIfNew(readRecord));    // nothing new since the last call
+    XR_CHECK_EQUAL(1ULL, reader.GetPublishedCount());
+}
+
+// Readers running flat out against a writer that never waits must never see a record mixed from two Publish calls,
+// and must never see the sequence go backwards.
+XR_TEST(TelemetryReadersNeverSeeTornRecords)
+{
+    XRTelemetryChannel channel;
+    channel.Open("XRTests-03", false);
+
+    const unsigned long long publishCount = 200000;
+    atomic<bool> bStop(false);
+    atomic<long> tornCount(0), backwardsCount(0), readCount(0);
+    vector<thread> readers;
+    for (int r = 0; r < 3; r++)
+    {
+        readers.emplace_back([&]()
+        {
+            unsigned long long lastSequence = 0;
+            XRTelemetryRecord record;
+            while (!bStop.load())
+            {
+                unsigned long long sequence;
+                if (!channel.Read(record, &sequence))
+                    continue;
+                readCount++;
+                if (!IsRecordConsistent(record))
+                    tornCount++;
+                if (sequence < lastSequence)
+                    backwardsCount++;
+                lastSequence = sequence;
+            }
+        });
+    }
+
+    XRTelemetryRecord record;
+    for (unsigned long long i = 1; i <= publishCount; i++)
+    {
+        FillRecord(record, i);
+        channel.Publish(record);
+    }
+    bStop = true;
+    for (thread &reader : readers)
+        reader.join();
+
+    XR_CHECK_EQUAL(0L, tornCount.load());
+    XR_CHECK_EQUAL(0L, backwardsCount.load());
+    XR_CHECK(readCount.load() > 0);
+
+    XRTelemetryRecord last;
+    XR_CHECK(channel.Read(last));
+    XR_CHECK_EQUAL(static_cast<double>(publishCount), last.SimTime);
+}
+
+// one Publish per op with no readers, as a vessel does at the end of each clbkPostStep
+XR_BENCH(TelemetryPublish)
+{
+    XRTelemetryChannel channel;
+    channel.Open("XRTests-04", false);
+    XRTelemetryRecord record;
+    FillRecord(record, 0);
+    for (long i = 0; i < iterations; i++)
+    {
+        record.SimTime = static_cast<double>(i);
+        channel.Publish(record);
+    }
+}
+
+// One Publish per op while two readers poll the channel continuously.  Also reports the fraction of read calls
+// that gave up because the writer kept tearing them.
+XR_BENCH(TelemetryPublishWithReaders)
+{
+    XRTelemetryChannel channel;
+    channel.Open("XRTests-05", false);
+    XRTelemetryRecord record;
+    FillRecord(record, 0);
+    channel.Publish(record);
+
+    atomic<bool> bStop(false);
+    atomic<long> readCount(0), failedCount(0);
+    vector<thread> readers;
+    for (int r = 0; r < 2; r++)
+    {
+        readers.emplace_back([&]()
+        {
+            XRTelemetryRecord readRecord;
+            long reads = 0, failures = 0;
+            while (!bStop.load(memory_order_relaxed))
+            {
+                reads++;
+                if (!channel.Read(readRecord))
+                    failures++;
+            }
+            readCount += reads;
+            failedCount += failures;
+        });
+    }
+
+    for (long i = 0; i < iterations; i++)
+    {
+        record.SimTime = static_cast<double>(i);
+        channel.Publish(record);
+    }
+    bStop = true;
+    for (thread &reader : readers)
+        reader.join();
+
+    ReportMetric("failed_read_fraction", (readCount > 0) ? (static_cast<double>(failedCount) / readCount) : 0);
+}
+
+// one uncontended Read per op
+XR_BENCH(TelemetryRead)
+{
+    XRTelemetryChannel channel;
+    channel.Open("XRTests-06", false);
+    XRTelemetryRecord record;
+    FillRecord(record, 1);
+    channel.Publish(record);
+    for (long i = 0; i < iterations; i++)
+    {
+        channel.Read(record);
+        g_sink = record.SimTime;
+    }
+}
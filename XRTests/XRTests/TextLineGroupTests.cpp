@@ -0,0 +1,223 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// TextLineGroupTests.cpp : TextLineGroup's circular line buffer against
+// the vector of heap-allocated lines it replaced.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include "DeltaGliderXR1.h"
+#include "TextBox.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace XRTests;
+
+// TextLineGroup as it was before it used a circular buffer: each line is a heap-allocated string, and the
+// oldest line is erased from the front of the vector.  The old version copied each message into a
+// MAX_MESSAGE_LENGTH buffer first, which overflowed on longer messages; this copy skips that.
+class OldTextLineGroup
+{
+public:
+    struct Line
+    {
+        string text;
+        TEXTCOLOR color;
+    };
+
+    OldTextLineGroup(const int maxLines) : m_maxLines(maxLines), m_addLinesCount(0) { }
+    ~OldTextLineGroup() { Clear(); }
+
+    int GetLineCount() const { return static_cast<int>(m_lines.size()); }
+    const Line &GetLine(const int index) const { return *m_lines[index]; }
+    int GetAddLinesCount() const { return m_addLinesCount; }
+
+    void Clear()
+    {
+        for (const Line *pLine : m_lines)
+            delete pLine;
+        m_lines.clear();
+    }
+
+    void AddLines(const char *pStr, bool highlighted)
+    {
+        m_addLinesCount++;
+        string temp = pStr;
+        size_t start = 0;
+        for (;;)
+        {
+            const size_t end = temp.find('&', start);
+            m_lines.push_back(new Line{ temp.substr(start, (end == string::npos ? string::npos : end - start)), (highlighted ? TEXTCOLOR::Highlighted : TEXTCOLOR::Normal) });
+            if (GetLineCount() > m_maxLines)
+            {
+                delete m_lines[0];
+                m_lines.erase(m_lines.begin());
+            }
+
+            if (end == string::npos)
+                break;
+            start = end + 1;
+        }
+    }
+
+protected:
+    const int m_maxLines;
+    int m_addLinesCount;
+    vector<const Line *> m_lines;
+};
+
+// Returns a message of one to four '&'-separated lines, including empty lines and lines longer than TextLineGroup keeps.
+static string MakeMessage(unsigned int &seed)
+{
+    seed = seed * 1103515245 + 12345;
+    const int lineCount = 1 + (seed >> 16) % 4;
+    string message;
+    for (int i = 0; i < lineCount; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const int r = (seed >> 16) % 100;
+        const int length = (r < 5 ? 0 : (r < 8 ? MAX_MESSAGE_LENGTH + r : r));
+        if (i > 0)
+            message += '&';
+        for (int j = 0; j < length; j++)
+            message += static_cast<char>('A' + (i + j) % 26);
+    }
+    return message;
+}
+
+// Checks that the new line group holds the same lines as the old one, with lines truncated to MAX_MESSAGE_LENGTH - 1 characters.
+static void CheckSameLines(const TextLineGroup &group, const OldTextLineGroup &oldGroup, const int message)
+{
+    XR_CHECK_EQUAL(oldGroup.GetLineCount(), group.GetLineCount());
+    XR_CHECK_EQUAL(oldGroup.GetAddLinesCount(), group.GetAddLinesCount());
+    for (int i = 0; i < min(group.GetLineCount(), oldGroup.GetLineCount()); i++)
+    {
+        const TextLine line = group.GetLine(i);
+        const string expected = oldGroup.GetLine(i).text.substr(0, MAX_MESSAGE_LENGTH - 1);
+        if ((string(line.text) != expected) || (line.length != static_cast<int>(expected.size())) || (line.color != oldGroup.GetLine(i).color))
+        {
+            XRTests::Fail(__FILE__, __LINE__, "message %d, line %d: got \"%.40s\" (%d characters), expected \"%.40s\" (%d characters)",
+                message, i, line.text, line.length, expected.c_str(), static_cast<int>(expected.size()));
+            return;
+        }
+    }
+}
+
+XR_TEST(TextLineGroupMatchesOldLineVector)
+{
+    for (const int maxLines : { 1, 7, 64 })
+    {
+        TextLineGroup group(maxLines);
+        OldTextLineGroup oldGroup(maxLines);
+        unsigned int seed = maxLines;
+        for (int message = 0; message < 5000; message++)
+        {
+            const string text = MakeMessage(seed);
+            group.AddLines(text.c_str(), (message % 3) == 0);
+            oldGroup.AddLines(text.c_str(), (message % 3) == 0);
+            CheckSameLines(group, oldGroup, message);
+
+            if (message == 2500)
+            {
+                group.Clear();
+                oldGroup.Clear();
+                CheckSameLines(group, oldGroup, message);
+            }
+        }
+    }
+
+    // '&' alone is two empty lines, and a trailing '&' adds an empty line
+    TextLineGroup group(4);
+    group.AddLines("&", false);
+    group.AddLines("Gear up&", true);
+    XR_CHECK_EQUAL(4, group.GetLineCount());
+    XR_CHECK_STR("", group.GetLine(0).text);
+    XR_CHECK_STR("", group.GetLine(1).text);
+    XR_CHECK_STR("Gear up", group.GetLine(2).text);
+    XR_CHECK(group.GetLine(2).color == TEXTCOLOR::Highlighted);
+    XR_CHECK_EQUAL(0, group.GetLine(3).length);
+}
+
+XR_TEST(TextBoxRendersNewestLines)
+{
+    XRTestsSurface surface = { 200, 60, nullptr };
+    vector<uint32_t> pixels(surface.width * surface.height), expectedPixels(pixels.size());
+    const HFONT hFont = CreateFont(-8, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, 0, "Arial");
+    XRTestsDC dc = { &surface, nullptr, 0, TA_LEFT };
+
+    TextLineGroup group(10);
+    TextBox textBox(surface.width, surface.height, RGB(0, 255, 0), RGB(255, 0, 0), CWHITE, 3, group);
+    group.AddLines("one&two", false);
+    group.AddLines("three&four", true);
+
+    // the box shows the newest three lines
+    surface.pPixels = pixels.data();
+    XR_CHECK(textBox.Render(&dc, 10, hFont, 12, false));
+    surface.pPixels = expectedPixels.data();
+    static const struct { const char *pText; COLORREF color; } s_expected[] = { { "two", RGB(0, 255, 0) }, { "three", RGB(255, 0, 0) }, { "four", RGB(255, 0, 0) } };
+    SelectObject(&dc, hFont);
+    for (int i = 0; i < 3; i++)
+    {
+        SetTextColor(&dc, s_expected[i].color);
+        TextOut(&dc, 3, 11 + (i * 12), s_expected[i].pText, static_cast<int>(strlen(s_expected[i].pText)));
+    }
+    XR_CHECK(pixels == expectedPixels);
+
+    // nothing is drawn until more lines are added
+    XR_CHECK(!textBox.Render(&dc, 10, hFont, 12, false));
+    group.AddLines("five", false);
+    XR_CHECK(textBox.Render(&dc, 10, hFont, 12, false));
+    XR_CHECK(!textBox.Render(&dc, 10, hFont, 12, false, 9));     // past the end of the buffer
+    DeleteObject(hFont);
+}
+
+//-------------------------------------------------------------------------
+// one AddLines per op: a burst of mixed one- and three-line messages into a 64-line group
+
+static const char *s_pMessages[] =
+{
+    "Gear up and locked.",
+    "WARNING: Hull temperature&is approaching its limit;&reduce airspeed.",
+    "Main engines online.",
+    "Retro doors open.",
+    "Autopilot OFF.&Attitude hold disengaged.&Pitch and bank hold released.",
+};
+
+XR_BENCH(TextLineGroupAddLines)
+{
+    TextLineGroup group(64);
+    for (long i = 0; i < iterations; i++)
+        group.AddLines(s_pMessages[i % 5], (i & 1) != 0);
+    g_sink = group.GetLine(0).length;
+}
+
+XR_BENCH(OldTextLineGroupAddLines)
+{
+    OldTextLineGroup group(64);
+    for (long i = 0; i < iterations; i++)
+        group.AddLines(s_pMessages[i % 5], (i & 1) != 0);
+    g_sink = static_cast<double>(group.GetLine(0).text.size());
+}
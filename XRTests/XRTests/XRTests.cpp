@@ -0,0 +1,333 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRTests.cpp : runs the registered tests, or the registered benchmarks
+// with --bench.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "XRTests.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+const char *PROGRAM_NAME = "XRTests";
+
+namespace XRTests
+{
+    volatile double g_sink;
+
+    struct Entry
+    {
+        const char *pName;
+        TestFunc pTest;
+        BenchFunc pBench;
+    };
+
+    // function-local so that registrars in other translation units may run first
+    static vector<Entry> &GetEntries()
+    {
+        static vector<Entry> s_entries;
+        return s_entries;
+    }
+
+    Registrar::Registrar(const char *pName, TestFunc pTest)
+    {
+        GetEntries().push_back({ pName, pTest, nullptr });
+    }
+
+    Registrar::Registrar(const char *pName, BenchFunc pBench)
+    {
+        GetEntries().push_back({ pName, nullptr, pBench });
+    }
+
+    static int s_failureCount;
+    static const char *s_pCurrentName;
+
+    void Fail(const char *pFile, const int line, const char *pFormat, ...)
+    {
+        // only show the first few failures of a test; a broken loop could otherwise print thousands of lines
+        if (++s_failureCount > 20)
+            return;
+
+        // show only the filename, not the path
+        const char *pSlash = strrchr(pFile, '/');
+        printf("  FAILED %s (%s:%d): ", s_pCurrentName, (pSlash ? pSlash + 1 : pFile), line);
+        va_list args;
+        va_start(args, pFormat);
+        vprintf(pFormat, args);
+        va_end(args);
+        printf("\n");
+    }
+
+    struct Result
+    {
+        string name;
+        string metric;
+        double value;
+        long iterations;
+    };
+
+    static vector<Result> s_results;
+    static long s_currentIterations;
+
+    void ReportMetric(const char *pMetric, const double value)
+    {
+        s_results.push_back({ s_pCurrentName, pMetric, value, s_currentIterations });
+    }
+
+    const string &GetRepoRoot()
+    {
+        // the Makefile passes the repository root; allow an override for out-of-tree runs
+        static string s_root = (getenv("XR_REPO_ROOT") ? getenv("XR_REPO_ROOT") : XR_REPO_ROOT);
+        return s_root;
+    }
+
+    TempFolder::TempFolder(const char *pTestName)
+    {
+        char folder[PATH_MAX];
+        m_orgFolder = getcwd(folder, sizeof(folder));
+        snprintf(folder, sizeof(folder), "/tmp/XRTests-%s-%d", pTestName, static_cast<int>(getpid()));
+        m_folder = folder;
+        mkdir(folder, 0755);
+        chdir(folder);
+    }
+
+    TempFolder::~TempFolder()
+    {
+        chdir(m_orgFolder.c_str());
+        system(("rm -rf '" + m_folder + "'").c_str());
+    }
+}
+
+using namespace XRTests;
+
+static void Usage()
+{
+    printf("Usage: %s [options]\n", PROGRAM_NAME);
+    printf("Runs the tests, or the benchmarks if --bench is specified.\n\n");
+    printf("Options:\n");
+    printf("  --bench                run the benchmarks instead of the tests\n");
+    printf("  --filter <text>        run only tests or benchmarks whose name contains this text\n");
+    printf("  --list                 list the registered tests and benchmarks\n");
+    printf("  --min-time <seconds>   minimum time to run each benchmark (default: 0.2)\n");
+    printf("  --out <file>           also write benchmark results to this file\n");
+    printf("  --baseline <file>      compare benchmark results against a file written by --out\n");
+    printf("  --tolerance <percent>  allowed slowdown against the baseline (default: 10)\n");
+}
+
+// Runs a benchmark with increasing iteration counts until it takes at least minTime seconds.
+static void RunBench(const Entry &entry, const double minTime)
+{
+    typedef chrono::steady_clock Clock;
+
+    // warm up caches and lazy initialization
+    s_currentIterations = 1;
+    const size_t warmupResult = s_results.size();
+    entry.pBench(1);
+    s_results.resize(warmupResult);
+
+    long iterations = 1;
+    for (;;)
+    {
+        const size_t firstResult = s_results.size();
+        s_currentIterations = iterations;
+        const Clock::time_point start = Clock::now();
+        entry.pBench(iterations);
+        const double elapsed = chrono::duration<double>(Clock::now() - start).count();
+        if ((elapsed >= minTime) || (iterations >= (1L << 40)))
+        {
+            s_results.insert(s_results.begin() + firstResult, { entry.pName, "ns_per_op", elapsed * 1e9 / iterations, iterations });
+            break;
+        }
+
+        // discard any metrics from this run; they are reported again by the final run
+        s_results.resize(firstResult);
+
+        // aim for 1.5x the minimum time, but never grow by more than 100x at once
+        const double scale = (elapsed > 0 ? (minTime * 1.5 / elapsed) : 100.0);
+        iterations = static_cast<long>(iterations * (scale > 100.0 ? 100.0 : (scale < 2.0 ? 2.0 : scale)));
+    }
+}
+
+static bool ReadBaseline(const char *pFilename, map<string, double> &baseline)
+{
+    FILE *pFile = fopen(pFilename, "r");
+    if (pFile == nullptr)
+        return false;
+
+    char line[512];
+    while (fgets(line, sizeof(line), pFile))
+    {
+        if (line[0] == '#')
+            continue;
+
+        char name[256], metric[64];
+        double value;
+        if (sscanf(line, "%255s %63s %lf", name, metric, &value) == 3)
+            baseline[string(name) + "\t" + metric] = value;
+    }
+    fclose(pFile);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    bool bBench = false;
+    bool bList = false;
+    const char *pFilter = nullptr;
+    const char *pOutFile = nullptr;
+    const char *pBaselineFile = nullptr;
+    double minTime = 0.2;
+    double tolerancePct = 10.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *pArg = argv[i];
+        const bool bHasValue = (i + 1 < argc);
+        if (strcmp(pArg, "--bench") == 0)
+            bBench = true;
+        else if (strcmp(pArg, "--list") == 0)
+            bList = true;
+        else if ((strcmp(pArg, "--filter") == 0) && bHasValue)
+            pFilter = argv[++i];
+        else if ((strcmp(pArg, "--min-time") == 0) && bHasValue)
+            minTime = atof(argv[++i]);
+        else if ((strcmp(pArg, "--out") == 0) && bHasValue)
+            pOutFile = argv[++i];
+        else if ((strcmp(pArg, "--baseline") == 0) && bHasValue)
+            pBaselineFile = argv[++i];
+        else if ((strcmp(pArg, "--tolerance") == 0) && bHasValue)
+            tolerancePct = atof(argv[++i]);
+        else
+        {
+            Usage();
+            return 2;
+        }
+    }
+
+    // Orbiter runs with its own folder as the working directory and the XR code opens files relative to it
+    const string orbiterFolder = GetRepoRoot() + "/Orbiter";
+    if (chdir(orbiterFolder.c_str()) != 0)
+    {
+        printf("Error: could not change to the Orbiter folder '%s'\n", orbiterFolder.c_str());
+        return 2;
+    }
+
+    int ranCount = 0;
+    int failedCount = 0;
+    for (const Entry &entry : GetEntries())
+    {
+        const bool bIsBench = (entry.pBench != nullptr);
+        if (pFilter && (strstr(entry.pName, pFilter) == nullptr))
+            continue;
+
+        if (bList)
+        {
+            printf("%s\t%s\n", (bIsBench ? "bench" : "test"), entry.pName);
+            continue;
+        }
+
+        if (bIsBench != bBench)
+            continue;
+
+        s_pCurrentName = entry.pName;
+        s_failureCount = 0;
+        ranCount++;
+        if (bBench)
+        {
+            const size_t firstResult = s_results.size();
+            RunBench(entry, minTime);
+            for (size_t r = firstResult; r < s_results.size(); r++)
+                printf("%s\t%s\t%.6g\t%ld\n", s_results[r].name.c_str(), s_results[r].metric.c_str(), s_results[r].value, s_results[r].iterations);
+        }
+        else
+        {
+            entry.pTest();
+            printf("%s %s\n", (s_failureCount ? "FAIL" : "ok  "), entry.pName);
+        }
+        fflush(stdout);
+
+        if (s_failureCount)
+            failedCount++;
+    }
+
+    if (bList)
+        return 0;
+
+    if (pOutFile)
+    {
+        FILE *pFile = fopen(pOutFile, "w");
+        if (pFile == nullptr)
+        {
+            printf("Error: could not create '%s'\n", pOutFile);
+            return 2;
+        }
+        fprintf(pFile, "# name\tmetric\tvalue\titerations\n");
+        for (const Result &result : s_results)
+            fprintf(pFile, "%s\t%s\t%.6g\t%ld\n", result.name.c_str(), result.metric.c_str(), result.value, result.iterations);
+        fclose(pFile);
+    }
+
+    // a result that got worse by more than the tolerance counts as a failure, so that 'make bench' can gate a change
+    if (pBaselineFile)
+    {
+        map<string, double> baseline;
+        if (!ReadBaseline(pBaselineFile, baseline))
+        {
+            printf("Error: could not read baseline '%s'\n", pBaselineFile);
+            return 2;
+        }
+
+        printf("\nComparison against %s (tolerance %g%%):\n", pBaselineFile, tolerancePct);
+        for (const Result &result : s_results)
+        {
+            const auto it = baseline.find(result.name + "\t" + result.metric);
+            if (it == baseline.end())
+            {
+                printf("  %-44s %-20s %12.6g  (new)\n", result.name.c_str(), result.metric.c_str(), result.value);
+                continue;
+            }
+
+            const double oldValue = it->second;
+            const double changePct = (oldValue != 0 ? ((result.value - oldValue) * 100.0 / oldValue) : 0);
+            const bool bRegressed = (result.value > oldValue * (1.0 + tolerancePct / 100.0));
+            printf("  %-44s %-20s %12.6g  %+7.1f%%%s\n", result.name.c_str(), result.metric.c_str(), result.value, changePct, (bRegressed ? "  REGRESSION" : ""));
+            if (bRegressed)
+                failedCount++;
+        }
+    }
+
+    if (!bBench)
+        printf("\n%d of %d tests passed\n", ranCount - failedCount, ranCount);
+
+    return (failedCount ? 1 : 0);
+}
@@ -0,0 +1,107 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRTests.h : minimal test and benchmark framework for the XR vessel
+// code that does not depend on a running Orbiter instance.
+//
+// Tests are registered with XR_TEST and run by default; benchmarks are
+// registered with XR_BENCH and run with --bench.  Benchmark results are
+// written as tab-separated "name metric value iterations" lines so they
+// may be saved as a baseline and compared on a later run.
+//
+// Builds on Linux with 'make'; the stubs folder stands in for the Win32
+// and Orbiter headers.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdio.h>
+#include <math.h>
+#include <string>
+
+namespace XRTests
+{
+    typedef void (*TestFunc)();
+    typedef void (*BenchFunc)(const long iterations);
+
+    // registers a test or benchmark at static-initialization time
+    struct Registrar
+    {
+        Registrar(const char *pName, TestFunc pTest);
+        Registrar(const char *pName, BenchFunc pBench);
+    };
+
+    // records a test failure; the current test keeps running so that all of its failures are reported
+    void Fail(const char *pFile, const int line, const char *pFormat, ...);
+
+    // Reports an additional metric for the benchmark currently running, such as bytes allocated or GDI calls per frame.
+    // As with ns_per_op, lower values are better when comparing against a baseline.
+    void ReportMetric(const char *pMetric, const double value);
+
+    // Returns the root folder of the repository, for tests that read shipped data files.
+    const std::string &GetRepoRoot();
+
+    // Runs a test in a new folder under /tmp, for code that writes to folders relative to the current one;
+    // the previous folder is restored and the new one removed when this goes out of scope.
+    class TempFolder
+    {
+    public:
+        TempFolder(const char *pTestName);
+        ~TempFolder();
+
+        const std::string &GetPath() const { return m_folder; }
+
+    protected:
+        std::string m_orgFolder;
+        std::string m_folder;
+    };
+
+    // benchmarks store results here so the compiler cannot discard the work being timed
+    extern volatile double g_sink;
+}
+
+#define XR_TEST(name) \
+    static void name(); \
+    static XRTests::Registrar name##_registrar(#name, static_cast<XRTests::TestFunc>(name)); \
+    static void name()
+
+// The benchmark body runs 'iterations' operations; the framework picks the count and divides the time by it.
+#define XR_BENCH(name) \
+    static void name(const long iterations); \
+    static XRTests::Registrar name##_registrar(#name, static_cast<XRTests::BenchFunc>(name)); \
+    static void name(const long iterations)
+
+#define XR_CHECK(cond) \
+    do { if (!(cond)) XRTests::Fail(__FILE__, __LINE__, "%s", #cond); } while (0)
+
+#define XR_CHECK_EQUAL(expected, actual) \
+    do { const auto xrExpected = (expected); const auto xrActual = (actual); \
+         if (!(xrExpected == xrActual)) XRTests::Fail(__FILE__, __LINE__, "%s == %s: expected %.17g, got %.17g", #expected, #actual, static_cast<double>(xrExpected), static_cast<double>(xrActual)); } while (0)
+
+#define XR_CHECK_NEAR(expected, actual, tolerance) \
+    do { const double xrExpected = (expected); const double xrActual = (actual); \
+         if (!(fabs(xrExpected - xrActual) <= (tolerance))) XRTests::Fail(__FILE__, __LINE__, "%s ~= %s: expected %.17g, got %.17g (tolerance %g)", #expected, #actual, xrExpected, xrActual, static_cast<double>(tolerance)); } while (0)
+
+// compares C strings; CString arguments convert to const char * as in the XR code
+#define XR_CHECK_STR(expected, actual) \
+    do { const std::string xrExpected = static_cast<const char *>(expected); const std::string xrActual = static_cast<const char *>(actual); \
+         if (xrExpected != xrActual) XRTests::Fail(__FILE__, __LINE__, "%s == %s: expected \"%s\", got \"%s\"", #expected, #actual, xrExpected.c_str(), xrActual.c_str()); } while (0)
@@ -0,0 +1,88 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// XRTestsGlobals.cpp : the vessel globals used by the code under test.
+//
+// Each vessel's XR*Globals.cpp defines every constant for that vessel and
+// pulls in its config file parser and payload dialog, so the values the
+// tests need are copied here instead; keep them in sync with those files.
+// The payload bay constants are renamed per vessel by the Makefile so that
+// each vessel's bay may be linked into the same binary.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "OrbiterAPI.h"
+#include "XR1Globals.h"     // verify that types agree
+#include "XRVCMainDialog.h"
+
+extern const VECTOR3 &XR5_PAYLOAD_SLOT_DIMENSIONS;
+extern const double XR5_PAYLOAD_BAY_DELTAY_TO_GROUND;
+extern const double XR5_PAYLOAD_BAY_DELTAX_TO_GROUND;
+extern const VECTOR3 &XR2_PAYLOAD_SLOT1_DIMENSIONS;
+extern const VECTOR3 &XR2_PAYLOAD_SLOT_DIMENSIONS;
+extern const double XR2_PAYLOAD_BAY_DELTAY_TO_GROUND;
+extern const double XR2_PAYLOAD_BAY_DELTAX_TO_GROUND;
+extern const VECTOR3 &XR3_PAYLOAD_SLOT_DIMENSIONS;
+extern const double XR3_PAYLOAD_BAY_DELTAY_TO_GROUND;
+extern const double XR3_PAYLOAD_BAY_DELTAX_TO_GROUND;
+
+// XR1: DeltaGliderXR1/XR1Globals.cpp
+const double WING_ASPECT_RATIO = 1.5;
+const double WING_EFFICIENCY_FACTOR = 0.70;
+double SCRAM_FHV[2] = { 3.5e8, 2.0e8 };
+const double SCRAM_INTERNAL_TEMAX = 16000;
+const double SCRAM_COOLING = 2.0;
+const double MAX_SCRAM_TEMPERATURE = (SCRAM_INTERNAL_TEMAX / SCRAM_COOLING);
+const double SCRAM_PRESSURE_RECOVERY_MULT = 0.9;
+const double SCRAM_DMA_SCALE = 1.35e-4;
+const double SCRAM_INTAKE_AREA = 1.0;
+const double SCRAM_DEFAULT_DIR = (0.0 * RAD);
+const double WARN_COOLANT_TEMP     = 80.0;
+const double CRITICAL_COOLANT_TEMP = 90.0;
+const double MAX_COOLANT_TEMP = 108 + oapiRand();
+const double MAX_COOLANT_GAUGE_TEMP = 110.0;
+const double MIN_COOLANT_GAUGE_TEMP = 10.0;
+
+// XR5: XR5Vanguard/XR5Globals.cpp
+const VECTOR3 &XR5_PAYLOAD_SLOT_DIMENSIONS = _V(2.4384, 2.5908, 6.096);
+const double XR5_PAYLOAD_BAY_DELTAY_TO_GROUND = (-10.838 + 2.67) + (XR5_PAYLOAD_SLOT_DIMENSIONS.y / 2) + 0.20;
+const double XR5_PAYLOAD_BAY_DELTAX_TO_GROUND = (13.4 / 2) + (76.67 / 2) + 5.0;
+
+// XR2: XR2Ravenstar/XR2Globals.cpp, where GEAR_UNCOMPRESSED_YCOORD is -2.60 and GEAR_COMPRESSION_DISTANCE is 0
+const VECTOR3 &XR2_PAYLOAD_SLOT1_DIMENSIONS = _V(3.452, 2.418, 2.060);
+const VECTOR3 &XR2_PAYLOAD_SLOT_DIMENSIONS = _V(3.452, 2.128, 1.454);
+const double XR2_PAYLOAD_BAY_DELTAY_TO_GROUND = (-2.60 + 0) + (XR2_PAYLOAD_SLOT_DIMENSIONS.y / 2) + 0.40;
+const double XR2_PAYLOAD_BAY_DELTAX_TO_GROUND = (3.452 / 2) + (18.95 / 2) + 3.0;
+
+// XR3: XR3Phoenix/XR3Globals.cpp, where GEAR_UNCOMPRESSED_YCOORD is -3.8 and GEAR_COMPRESSION_DISTANCE is 0
+const VECTOR3 &XR3_PAYLOAD_SLOT_DIMENSIONS = _V(3.452, 2.128, 1.454);
+const double XR3_PAYLOAD_BAY_DELTAY_TO_GROUND = (-3.8 + 0) + (XR3_PAYLOAD_SLOT_DIMENSIONS.y / 2) + 0.20;
+const double XR3_PAYLOAD_BAY_DELTAX_TO_GROUND = (7.0 / 2) + (29.49 / 2) + 5.0;
+
+// the framework objects are built once, so they see the XR5's payload globals
+const VECTOR3 &PAYLOAD_SLOT_DIMENSIONS = XR5_PAYLOAD_SLOT_DIMENSIONS;
+const char *DEFAULT_PAYLOAD_THUMBNAIL_PATH = "Vessels\\Altea_Default_Payload_Thumbnail.bmp";
+
+// XRVesselCtrlDemo: XRVCMainDialog.cpp
+XRVCMainDialog *XRVCMainDialog::s_pSingleton = nullptr;
@@ -0,0 +1,92 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRTestsVessel.h : an XRVesselCtrl vessel for the XRVesselCtrlDemo tests.
+// Every Set call succeeds and is counted; Get calls return zeroed state.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include "XRVesselCtrl.h"
+#include <string.h>
+
+class XRTestsVessel : public XRVesselCtrl
+{
+public:
+    XRTestsVessel() : XRVesselCtrl(nullptr, 0), m_setCount(0) { }
+
+    long m_setCount;    // number of Set calls made
+
+    virtual bool SetEngineState(XREngineID id, const XREngineStateWrite &state) { return Set(); }
+    virtual bool GetEngineState(XREngineID id, XREngineStateRead &state) const { memset(&state, 0, sizeof(state)); return true; }
+    virtual bool SetDoorState(XRDoorID id, XRDoorState state) { return Set(); }
+    virtual XRDoorState GetDoorState(XRDoorID id, double *pProc = nullptr) const { if (pProc) *pProc = 0; return XRDoorState::XRDS_Closed; }
+    virtual bool SetXRSystemStatus(const XRSystemStatusWrite &status) { return Set(); }
+    virtual void GetXRSystemStatus(XRSystemStatusRead &status) const { memset(&status, 0, sizeof(status)); }
+    virtual bool ClearAllXRDamage() { return Set(); }
+    virtual void KillAutopilots() { Set(); }
+    virtual XRAutopilotState SetStandardAP(XRStdAutopilot id, bool on) { Set(); return (on ? XRAutopilotState::XRAPSTATE_Engaged : XRAutopilotState::XRAPSTATE_Disengaged); }
+    virtual XRAutopilotState GetStandardAP(XRStdAutopilot id) { return XRAutopilotState::XRAPSTATE_Disengaged; }
+    virtual XRAutopilotState SetAttitudeHoldAP(const XRAttitudeHoldState &state) { Set(); return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState GetAttitudeHoldAP(XRAttitudeHoldState &state) const { memset(&state, 0, sizeof(state)); return XRAutopilotState::XRAPSTATE_Disengaged; }
+    virtual XRAutopilotState SetDescentHoldAP(const XRDescentHoldState &state) { Set(); return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState GetDescentHoldAP(XRDescentHoldState &state) const { memset(&state, 0, sizeof(state)); return XRAutopilotState::XRAPSTATE_Disengaged; }
+    virtual XRAutopilotState SetAirspeedHoldAP(const XRAirspeedHoldState &state) { Set(); return XRAutopilotState::XRAPSTATE_Engaged; }
+    virtual XRAutopilotState GetAirspeedHoldAP(XRAirspeedHoldState &state) const { memset(&state, 0, sizeof(state)); return XRAutopilotState::XRAPSTATE_Disengaged; }
+    virtual bool SetExteriorLight(XRLight light, bool state) { return Set(); }
+    virtual bool GetExteriorLight(XRLight light) const { return false; }
+    virtual bool SetSecondaryHUDMode(int modeNumber) { return Set(); }
+    virtual int GetSecondaryHUDMode() const { return 0; }
+    virtual bool SetTertiaryHUDState(bool on) { return Set(); }
+    virtual bool GetTertiaryHUDState() const { return false; }
+    virtual bool ResetMasterWarningAlarm() { return Set(); }
+    virtual bool ShiftCenterOfGravity(double requestedShift) { return Set(); }
+    virtual double GetCenterOfGravity() const { return 0; }
+    virtual bool SetRCSDockingMode(bool on) { return Set(); }
+    virtual bool IsRCSDockingMode() const { return false; }
+    virtual bool SetElevatorEVAPortActive(bool on) { return Set(); }
+    virtual bool IsElevatorEVAPortActive() const { return false; }
+    virtual int GetStatusScreenText(char *pLinesOut, const int maxLinesToRetrieve) const { return 0; }
+    virtual OMMUManagement *GetMMuObject() { return nullptr; }
+    virtual void WriteTertiaryHudMessage(const char *pMessage, const bool isWarning) { }
+    virtual const char *GetCustomSkinName() const { return nullptr; }
+    virtual int GetPayloadBaySlotCount() const { return 0; }
+    virtual bool IsPayloadBaySlotFree(const int slotNumber) const { return false; }
+    virtual bool GetPayloadSlotData(const int slotNumber, XRPayloadSlotData &slotDataOut) { return false; }
+    virtual bool CanAttachPayload(const OBJHANDLE hPayloadVessel, const int slotNumber) const { return false; }
+    virtual bool GrapplePayloadModuleIntoSlot(const OBJHANDLE hPayloadVessel, const int slotNumber) { return false; }
+    virtual bool DeployPayloadInFlight(const int slotNumber, const double deltaV) { return false; }
+    virtual bool DeployPayloadWhileLanded(const int slotNumber) { return false; }
+    virtual int DeployAllPayloadInFlight(const double deltaV) { return 0; }
+    virtual int DeployAllPayloadWhileLanded() { return 0; }
+    virtual bool SetMWSTest(bool bTestMode) { return Set(); }
+    virtual bool GetRecenterCOGMode() const { return false; }
+    virtual bool SetRecenterCOGMode(const bool bEnableRecenterMode) { return Set(); }
+    virtual XRDoorState GetExternalCoolingState() const { return XRDoorState::XRDS_Closed; }
+    virtual bool SetExternalCoolingState(const bool bEnabled) { return Set(); }
+    virtual bool SetCrossFeedMode(XRXFEED_STATE state) { return Set(); }
+
+protected:
+    bool Set() { m_setCount++; return true; }
+};
@@ -0,0 +1,51 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+//-------------------------------------------------------------------------
+// AreaStubs.cpp : the Area members that InstrumentPanel needs.  Area.cpp
+// pulls in the surface cache, the blink clock and the VC mesh textures,
+// none of which the code under test uses.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "Area.h"
+
+Area::Area(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID, const int meshTextureID) :
+    m_mainSurface(nullptr), m_parentPanel(parentPanel), m_pParentComponent(nullptr), m_panelCoordinates(panelCoordinates),
+    m_areaID(areaID), m_meshTextureID(meshTextureID), m_sizeX(-1), m_sizeY(-1), m_isActive(false)
+{
+}
+
+Area::~Area()
+{
+}
+
+void Area::Activate()
+{
+    m_isActive = true;
+}
+
+void Area::Deactivate()
+{
+    m_isActive = false;
+}
@@ -0,0 +1,138 @@
+// Stand-in for the XR1's deltagliderxr1.h, which pulls in nearly all of XR1Lib.
+// It declares only the DeltaGliderXR1 members that the code under test uses; the
+// door, light, autopilot and sound methods are no-ops for XR1Ctrl_DlgProc in
+// XRVesselStatic.cpp, the hull temperatures MDA mode, and the playback events in
+// XR1PlaybackEvents.cpp.  Tests override the virtual ones to see what was invoked.
+#pragma once
+
+#include "OrbiterAPI.h"
+#include "vessel3ext.h"
+#include "XR1Globals.h"
+#include "XR1Ramjet.h"
+#include "AeroCoeffTable.h"
+#include "XR1PlaybackEvents.h"
+#include "resource.h"
+#include <atlstr.h>
+
+class XRPayloadBay;
+
+// the only part of the XR1's settings that the code under test uses
+class XR1ConfigFileParser
+{
+public:
+    void WriteLog(const char *pMsg) const { oapiWriteLog(pMsg); }
+};
+
+class DeltaGliderXR1 : public VESSEL3_EXT
+{
+public:
+    DeltaGliderXR1() :
+        scramdoor_status(DoorStatus::DOOR_OPEN), scramdoor_proc(1.0),
+        nose_status(DoorStatus::DOOR_CLOSED), hoverdoor_status(DoorStatus::DOOR_CLOSED), gear_status(DoorStatus::DOOR_CLOSED), rcover_status(DoorStatus::DOOR_CLOSED),
+        hatch_status(DoorStatus::DOOR_CLOSED), radiator_status(DoorStatus::DOOR_CLOSED),
+        m_noseconeTemp(0), m_leftWingTemp(0), m_rightWingTemp(0), m_cockpitTemp(0), m_topHullTemp(0), m_coolantTemp(0), m_activeTempScale(TempScale::Celsius),
+        m_mainFuelDumpInProgress(false), m_rcsFuelDumpInProgress(false), m_scramFuelDumpInProgress(false), m_apuFuelDumpInProgress(false), m_loxDumpInProgress(false),
+        m_holdAOA(false), m_setPitchOrAOA(0), m_setBank(0), m_setDescentRate(0), m_setAirspeed(0),
+        m_xrEventRecordingStarted(false), m_xrEventPlaybackStarted(false),
+        m_pPayloadBay(nullptr), m_deployDeltaV(0), m_selectedSlot(0)
+    {
+        m_hullTemperatureLimits = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    }
+
+    static void VLiftCoeff(VESSEL* v, double aoa, double M, double Re, void* context, double* cl, double* cm, double* cd);
+    static void HLiftCoeff(VESSEL* v, double beta, double M, double Re, void* context, double* cl, double* cm, double* cd);
+    static AeroCoeffTable *GetVLiftCoeffTable();
+    static AeroCoeffTable *GetHLiftCoeffTable();
+
+    static void SafeColorFill(SURFHANDLE tgt, DWORD fillcolor, int tgtx = 0, int tgty = 0, int width = 0, int height = 0);
+    static void SafeBlt(SURFHANDLE tgt, SURFHANDLE src, int tgtx, int tgty, int srcx, int srcy, int width, int height, DWORD ck = SURF_NO_CK);
+    static void FormatDouble(const double val, CString &out, const int decimalPlaces);
+    static void EncodeSpaces(char *pStr);
+    static void DecodeSpaces(char *pStr);
+    static EXHAUSTSPEC *GetExhaustSpec(const THRUSTER_HANDLE th, const double lscale, const double wscale, const VECTOR3 *pos, const VECTOR3 *dir, const SURFHANDLE tex = 0);
+    unsigned int AddXRExhaust(const THRUSTER_HANDLE th, const double lscale, const double wscale, const SURFHANDLE tex = 0);
+    unsigned int AddXRExhaust(const THRUSTER_HANDLE th, const double lscale, const double wscale, const VECTOR3 &pos, const VECTOR3 &dir, const SURFHANDLE tex = 0);
+    static HWND s_hPayloadEditorDialog;
+
+    // the real method tapers the OAT at very low static pressure; that does not matter to the tests
+    virtual double GetExternalTemperature() const { return GetAtmTemperature(); }
+
+    virtual void UpdateCtrlDialog(DeltaGliderXR1 *, HWND = nullptr) { }
+    virtual void ActivateLandingGear(DoorStatus) { }
+    void ActivateRCover(DoorStatus) { }
+    void ActivateNoseCone(DoorStatus) { }
+    virtual void ActivateLadder(DoorStatus) { }
+    virtual void ActivateRadiator(DoorStatus) { }
+    void ActivateOuterAirlock(DoorStatus) { }
+    void ActivateInnerAirlock(DoorStatus) { }
+    void ActivateHatch(DoorStatus) { }
+    virtual void ActivateAirbrake(DoorStatus) { }
+    virtual void ActivateAPU(DoorStatus) { }
+    virtual void ActivateHoverDoors(DoorStatus) { }
+    virtual void ActivateScramDoors(DoorStatus) { }
+    virtual void ActivateBayDoors(DoorStatus) { }
+    virtual void ActivateChamber(DoorStatus, bool) { }
+    void SetNavlight(bool) { }
+    void SetBeacon(bool) { }
+    void SetStrobe(bool) { }
+    void ResetMET() { }
+    virtual void SetCrossfeedMode(const XFEED_MODE, const char *) { }
+    virtual void SetCustomAutopilotMode(AUTOPILOT, bool, bool = false) { }
+    virtual void SetAirspeedHoldMode(bool, bool) { }
+    virtual bool DeployPayload(const int, const bool) { return false; }
+    virtual int DeployAllPayload() { return 0; }
+
+    const XR1ConfigFileParser *GetXR1Config() const { return &m_xr1Config; }
+
+    // defined in XR1PlaybackEvents.cpp
+    virtual void RegisterPlaybackEvents(XRPlaybackEventTable &table);
+    const XRPlaybackEventTable &GetPlaybackEventTable();
+    void RecordXREvent(const XR_EVENT_TYPE type, const XR_EVENT_VALUE value, const int flags = 0, const float arg0 = 0, const float arg1 = 0, const float arg2 = 0);
+    void StartXREventPlayback(const double mjd);
+    void UpdateXREventRecorder(const double mjd);
+
+    bool IsCrewIncapacitatedOrNoPilotOnBoard() const { return false; }
+
+    enum Sound { _MDMButtonUp };
+    enum SoundType { ST_Other };
+    void PlaySound(Sound sound, const SoundType soundType, int volume = 255, bool bLoop = false) { }
+
+    DoorStatus scramdoor_status;
+    double scramdoor_proc;
+
+    // read by the hull temperatures MDA mode
+    DoorStatus nose_status, hoverdoor_status, gear_status, rcover_status, hatch_status, radiator_status;
+    HullTemperatureLimits m_hullTemperatureLimits;
+    double m_noseconeTemp;
+    double m_leftWingTemp;
+    double m_rightWingTemp;
+    double m_cockpitTemp;
+    double m_topHullTemp;
+    double m_coolantTemp;   // in degrees C
+    TempScale m_activeTempScale;
+
+    // set by the playback events
+    bool m_mainFuelDumpInProgress;
+    bool m_rcsFuelDumpInProgress;
+    bool m_scramFuelDumpInProgress;
+    bool m_apuFuelDumpInProgress;
+    bool m_loxDumpInProgress;
+    bool m_holdAOA;
+    double m_setPitchOrAOA;
+    double m_setBank;
+    double m_setDescentRate;
+    double m_setAirspeed;
+
+    XRPlaybackEventTable m_playbackEventTable;
+    XREventRecorder m_xrEventRecorder;
+    XREventPlayer m_xrEventPlayer;
+    bool m_xrEventRecordingStarted;
+    bool m_xrEventPlaybackStarted;
+
+    XRPayloadBay *m_pPayloadBay;
+    double m_deployDeltaV;
+    int m_selectedSlot;
+
+protected:
+    XR1ConfigFileParser m_xr1Config;
+};
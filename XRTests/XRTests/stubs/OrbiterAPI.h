@@ -0,0 +1,281 @@
+// Linux stand-in for the parts of the Orbiter SDK used by the XR code under test.
+// VESSEL keeps its state in public members so that a test can set up a flight
+// condition directly; the oapi functions are defined in OrbiterStubs.cpp.
+#pragma once
+
+#include "windows.h"
+#include <math.h>
+#include <string>
+#include <vector>
+
+#define DLLCLBK extern "C"
+#define OAPIFUNC
+
+const double PI = 3.14159265358979323846;
+const double PI05 = PI * 0.5;
+const double PI2 = PI * 2.0;
+const double RAD = PI / 180.0;
+const double DEG = 180.0 / PI;
+const double G = 6.67259e-11;
+
+typedef union
+{
+    double data[3];
+    struct { double x, y, z; };
+} VECTOR3;
+
+inline VECTOR3 _V(const double x, const double y, const double z) { VECTOR3 v = { { x, y, z } }; return v; }
+inline VECTOR3 operator+(const VECTOR3 &a, const VECTOR3 &b) { return _V(a.x + b.x, a.y + b.y, a.z + b.z); }
+inline VECTOR3 operator-(const VECTOR3 &a, const VECTOR3 &b) { return _V(a.x - b.x, a.y - b.y, a.z - b.z); }
+inline VECTOR3 operator-(const VECTOR3 &a) { return _V(-a.x, -a.y, -a.z); }
+inline VECTOR3 operator*(const VECTOR3 &a, const double f) { return _V(a.x * f, a.y * f, a.z * f); }
+inline VECTOR3 operator/(const VECTOR3 &a, const double f) { return _V(a.x / f, a.y / f, a.z / f); }
+inline VECTOR3 &operator+=(VECTOR3 &a, const VECTOR3 &b) { a.x += b.x; a.y += b.y; a.z += b.z; return a; }
+inline VECTOR3 &operator-=(VECTOR3 &a, const VECTOR3 &b) { a.x -= b.x; a.y -= b.y; a.z -= b.z; return a; }
+inline VECTOR3 &operator*=(VECTOR3 &a, const double f) { a.x *= f; a.y *= f; a.z *= f; return a; }
+inline double dotp(const VECTOR3 &a, const VECTOR3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline double length(const VECTOR3 &a) { return sqrt(dotp(a, a)); }
+
+typedef void *OBJHANDLE;
+typedef void *THRUSTER_HANDLE;
+typedef void *PROPELLANT_HANDLE;
+typedef void *ATTACHMENTHANDLE;
+typedef void *THGROUP_HANDLE;
+typedef void *FILEHANDLE;
+typedef void *SURFHANDLE;
+typedef void *MESHHANDLE;
+typedef void *DOCKHANDLE;
+
+typedef struct
+{
+    double p0;       // pressure at mean radius ('sea level') [Pa]
+    double rho0;     // density at mean radius
+    double R;        // specific gas constant [J/(K kg)]
+    double gamma;    // ratio of specific heats, c_p/c_v
+    double C;        // exponent for pressure equation (temporary)
+    double O2pp;     // partial pressure of oxygen
+    double altlimit; // atmosphere altitude limit [m]
+    double radlimit; // radius limit (altlimit + mean radius)
+    double horizonalt;
+    VECTOR3 color0;
+} ATMCONST;
+
+enum PathRoot { ROOT, CONFIG, SCENARIOS, TEXTURES, TEXTURES2, MESHES, MODULES };
+enum FileAccessMode { FILE_IN, FILE_OUT, FILE_APP, FILE_IN_ZEROONFAIL };
+
+#define FRAME_HORIZON 3
+#define ALTMODE_MEANRAD 0
+#define ALTMODE_GROUND 1
+
+#define SURF_NO_CK 0xFFFFFFFF
+#define SURF_PREDEF_CK 0xFFFFFFFE
+#define PANEL_REDRAW_NEVER 0x00
+#define PANEL_REDRAW_ALWAYS 0x04
+#define PANEL_REDRAW_INIT 0x08
+#define PANEL_MOUSE_LBDOWN 0x01
+
+#define EXHAUST_CONSTANTLEVEL 0x0001
+#define EXHAUST_CONSTANTPOS 0x0002
+#define EXHAUST_CONSTANTDIR 0x0004
+
+typedef struct
+{
+    THRUSTER_HANDLE th;
+    double *level;
+    VECTOR3 *lpos, *ldir;
+    double lsize, wsize, lofs;
+    double modulate;
+    SURFHANDLE tex;
+    DWORD flags;
+    UINT id;
+} EXHAUSTSPEC;
+
+typedef struct
+{
+    DWORD version;
+    DWORD flag;
+    OBJHANDLE rbody;
+    OBJHANDLE base;
+    int port;
+    int status;
+    VECTOR3 rpos, rvel, vrot, arot;
+    double surf_lng, surf_lat, surf_hdg;
+    DWORD nfuel;
+    struct FUELSPEC { DWORD idx; double level; } *fuel;
+    DWORD nthruster;
+    struct THRUSTSPEC { DWORD idx; double level; } *thruster;
+    DWORD ndockinfo;
+    struct DOCKINFOSPEC { DWORD idx; DWORD ridx; OBJHANDLE rvessel; } *dockinfo;
+    DWORD xpdr;
+} VESSELSTATUS2;
+
+class VESSEL;
+
+typedef void (*AirfoilCoeffFunc)(double aoa, double M, double Re, double *cl, double *cm, double *cd);
+typedef void (*AirfoilCoeffFuncEx)(VESSEL *v, double aoa, double M, double Re, void *context, double *cl, double *cm, double *cd);
+
+class VESSEL
+{
+public:
+    // one attachment point created by CreateAttachment
+    struct Attachment
+    {
+        bool toParent;
+        VECTOR3 pos, dir, rot;
+        std::string id;
+        OBJHANDLE hChild;
+    };
+
+    // one propellant resource
+    struct Propellant
+    {
+        double maxMass;
+        double mass;
+        double efficiency;
+    };
+
+    VESSEL(OBJHANDLE hVessel = nullptr, int fmodel = 1);
+    virtual ~VESSEL();
+
+    OBJHANDLE GetHandle() const { return m_hVessel; }
+    const char *GetName() const { return m_name.c_str(); }
+    const char *GetClassName() const { return m_className.c_str(); }
+    char *GetClassNameA() const { return const_cast<char *>(m_className.c_str()); }
+
+    // flight state
+    OBJHANDLE GetAtmRef() const { return m_hAtmRef; }
+    double GetMachNumber() const { return m_mach; }
+    double GetAtmTemperature() const { return m_atmTemperature; }
+    double GetAtmPressure() const { return m_atmPressure; }
+    double GetAtmDensity() const { return m_atmDensity; }
+    double GetDynPressure() const { return m_dynPressure; }
+    double GetAltitude(int = ALTMODE_MEANRAD) const { return m_altitude; }
+    double GetAirspeed() const { return m_airspeed; }
+    double GetGroundspeed() const { return m_airspeed; }
+    double GetAOA() const { return m_aoa; }
+    double GetSlipAngle() const { return 0; }
+    double GetPitch() const { return m_pitch; }
+    double GetBank() const { return m_bank; }
+    double GetMass() const { return m_mass; }
+    double GetEmptyMass() const { return m_emptyMass; }
+    void SetEmptyMass(const double mass) { m_emptyMass = mass; }
+    bool GetAirspeedVector(int, VECTOR3 &v) const { v = _V(0, 0, m_airspeed); return true; }
+    bool GroundContact() const { return m_groundContact; }
+    void GetStatusEx(void *pStatus) const { static_cast<VESSELSTATUS2 *>(pStatus)->status = (m_groundContact ? 1 : 0); }
+    void DefSetStateEx(const void *) const { }
+    unsigned int AddExhaust(EXHAUSTSPEC *) { return 0; }
+    void GetTouchdownPoints(VECTOR3 &pt1, VECTOR3 &pt2, VECTOR3 &pt3) const { pt1 = pt2 = pt3 = _V(0, -1, 0); }
+    void GlobalRot(const VECTOR3 &local, VECTOR3 &global) const { global = local; }     // the vessel is never rotated
+
+    // flight recorder: tests set the recorder state, and recorded events are kept as "type value" strings
+    bool Recording() const { return m_recording; }
+    bool Playback() const { return m_playback; }
+    void RecordEvent(const char *pEventType, const char *pEvent) const { m_recordedEvents.push_back(std::string(pEventType) + " " + pEvent); }
+
+    // thrusters: a THRUSTER_HANDLE is a pointer to the thruster's level
+    THRUSTER_HANDLE CreateThruster(const VECTOR3 &, const VECTOR3 &, double, PROPELLANT_HANDLE = nullptr, double = 1.0, double = 0.0, double = 1e5);
+    double GetThrusterLevel(THRUSTER_HANDLE th) const { return *static_cast<const double *>(th); }
+    void SetThrusterLevel(THRUSTER_HANDLE th, double level) { *static_cast<double *>(th) = level; }
+
+    // propellant resources: a PROPELLANT_HANDLE is a pointer to its Propellant
+    PROPELLANT_HANDLE CreatePropellantResource(double maxMass, double mass = -1.0, double efficiency = 1.0);
+    DWORD GetPropellantCount() const { return static_cast<DWORD>(m_propellants.size()); }
+    PROPELLANT_HANDLE GetPropellantHandleByIndex(DWORD index) const { return (index < m_propellants.size() ? m_propellants[index] : nullptr); }
+    double GetPropellantMaxMass(PROPELLANT_HANDLE ph) const { return (ph ? static_cast<Propellant *>(ph)->maxMass : 0); }
+    double GetPropellantMass(PROPELLANT_HANDLE ph) const { return (ph ? static_cast<Propellant *>(ph)->mass : 0); }
+    void SetPropellantMass(PROPELLANT_HANDLE ph, double mass) { static_cast<Propellant *>(ph)->mass = mass; }
+    void SetPropellantMaxMass(PROPELLANT_HANDLE ph, double maxMass) { static_cast<Propellant *>(ph)->maxMass = maxMass; }
+    double GetPropellantEfficiency(PROPELLANT_HANDLE ph) const { return static_cast<Propellant *>(ph)->efficiency; }
+    double GetPropellantFlowrate(PROPELLANT_HANDLE) const { return 0; }
+
+    // attachments: an ATTACHMENTHANDLE is a pointer to its Attachment
+    ATTACHMENTHANDLE CreateAttachment(bool toParent, const VECTOR3 &pos, const VECTOR3 &dir, const VECTOR3 &rot, const char *pID, bool loose = false) const;
+    DWORD AttachmentCount(bool toParent) const;
+    ATTACHMENTHANDLE GetAttachmentHandle(bool toParent, DWORD index) const;
+    OBJHANDLE GetAttachmentStatus(ATTACHMENTHANDLE attachment) const { return static_cast<Attachment *>(attachment)->hChild; }
+    void GetAttachmentParams(ATTACHMENTHANDLE attachment, VECTOR3 &pos, VECTOR3 &dir, VECTOR3 &rot) const;
+    const char *GetAttachmentId(ATTACHMENTHANDLE attachment) const { return static_cast<Attachment *>(attachment)->id.c_str(); }
+    bool AttachChild(OBJHANDLE hChild, ATTACHMENTHANDLE attachment, ATTACHMENTHANDLE) const { static_cast<Attachment *>(attachment)->hChild = hChild; return true; }
+    bool DetachChild(ATTACHMENTHANDLE attachment, double = 0.0) const { static_cast<Attachment *>(attachment)->hChild = nullptr; return true; }
+
+    // public so that tests can set up the vessel state directly
+    OBJHANDLE m_hVessel;
+    std::string m_name;
+    std::string m_className;
+    OBJHANDLE m_hAtmRef;
+    double m_mach, m_atmTemperature, m_atmPressure, m_atmDensity, m_dynPressure;
+    double m_altitude, m_airspeed, m_aoa, m_pitch, m_bank;
+    double m_mass, m_emptyMass;
+    bool m_groundContact;
+    bool m_recording, m_playback;
+    mutable std::vector<std::string> m_recordedEvents;
+
+protected:
+    std::vector<double *> m_thrusters;
+    std::vector<Propellant *> m_propellants;
+    mutable std::vector<Attachment *> m_attachments;
+};
+
+class VESSEL2 : public VESSEL
+{
+public:
+    VESSEL2(OBJHANDLE hVessel = nullptr, int fmodel = 1) : VESSEL(hVessel, fmodel) { }
+};
+
+class VESSEL3 : public VESSEL2
+{
+public:
+    VESSEL3(OBJHANDLE hVessel = nullptr, int fmodel = 1) : VESSEL2(hVessel, fmodel) { }
+};
+
+class VESSEL4 : public VESSEL3
+{
+public:
+    VESSEL4(OBJHANDLE hVessel = nullptr, int fmodel = 1) : VESSEL3(hVessel, fmodel) { }
+};
+
+// general
+void oapiWriteLog(const char *pLine);
+char *oapiDebugString();
+double oapiRand();
+double oapiGetSimTime();
+double oapiGetSimStep();
+double oapiGetTimeAcceleration();
+double oapiGetSimMJD();
+void oapiSetTestSimMJD(const double mjd);         // tests drive the simulation date that oapiGetSimMJD returns
+double oapiGetSysTime();
+void oapiSetTestSysTime(const double sysTime);    // tests drive the realtime clock that oapiGetSysTime returns
+const ATMCONST *oapiGetPlanetAtmConstants(OBJHANDLE hPlanet);
+double oapiGetInducedDrag(double cl, double A, double e);
+double oapiGetWaveDrag(double M, double M1, double M2, double M3, double cmax);
+
+// drawing and dialogs; nothing is drawn outside of Orbiter except GDI text (see windows.h)
+inline DWORD oapiGetColour(DWORD red, DWORD green, DWORD blue) { return ((red & 0xFF) << 16) | ((green & 0xFF) << 8) | (blue & 0xFF); }
+void oapiColourFill(SURFHANDLE tgt, DWORD col, int tgtx = 0, int tgty = 0, int w = 0, int h = 0);
+void oapiBlt(SURFHANDLE tgt, SURFHANDLE src, int tgtx, int tgty, int srcx, int srcy, int w, int h, DWORD ck = SURF_NO_CK);
+void *oapiGetDialogContext(HWND hDlg);
+HWND oapiOpenDialog(HINSTANCE hDLLInst, int resourceId, INT_PTR (*msgProc)(HWND, UINT, WPARAM, LPARAM), void *context = nullptr);
+void oapiCloseDialog(HWND hDlg);
+void oapiVCTriggerRedrawArea(int vcPanelID, int areaID);
+INT_PTR oapiDefDialogProc(HWND hDlg, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+// vessels: tests register the VESSEL objects that the code under test may look up
+void oapiRegisterTestVessel(VESSEL *pVessel);
+void oapiUnregisterTestVessel(VESSEL *pVessel);
+DWORD oapiGetVesselCount();
+OBJHANDLE oapiGetVesselByIndex(int index);
+OBJHANDLE oapiGetVesselByName(const char *pName);
+VESSEL *oapiGetVesselInterface(OBJHANDLE hVessel);
+bool oapiIsVessel(OBJHANDLE hVessel);
+OBJHANDLE oapiGetFocusObject();
+OBJHANDLE oapiCreateVesselEx(const char *pName, const char *pClassname, const VESSELSTATUS2 *pStatus);
+bool oapiDeleteVessel(OBJHANDLE hVessel, OBJHANDLE hAlternativeCameraTarget = nullptr);
+
+// configuration files, read from the Orbiter folder of the repository
+FILEHANDLE oapiOpenFile(const char *pFilename, FileAccessMode mode, PathRoot root = ROOT);
+void oapiCloseFile(FILEHANDLE hFile, FileAccessMode mode);
+bool oapiReadItem_string(FILEHANDLE hFile, const char *pItem, char *pValue);
+bool oapiReadItem_float(FILEHANDLE hFile, const char *pItem, double &value);
+bool oapiReadItem_int(FILEHANDLE hFile, const char *pItem, int &value);
+bool oapiReadItem_bool(FILEHANDLE hFile, const char *pItem, bool &value);
+bool oapiReadItem_vec(FILEHANDLE hFile, const char *pItem, VECTOR3 &value);
@@ -0,0 +1,4 @@
+// Linux builds are case-sensitive, and the XR code includes the Orbiter SDK under several names.
+#pragma once
+
+#include "OrbiterAPI.h"
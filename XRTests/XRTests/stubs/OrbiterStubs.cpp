@@ -0,0 +1,386 @@
+/**
+  XRTests for Orbiter
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// OrbiterStubs.cpp : definitions for the Orbiter and Win32 stand-ins in
+// the stubs folder.
+//
+// Builds on Linux with 'make'.
+//-------------------------------------------------------------------------
+
+#include "OrbiterAPI.h"
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+long g_gdiCallCount;
+std::atomic<long> g_liveBitmapBytes;
+
+//=========================================================================
+// VESSEL
+
+VESSEL::VESSEL(OBJHANDLE hVessel, int) :
+    m_hVessel(hVessel ? hVessel : this), m_hAtmRef(nullptr),
+    m_mach(0), m_atmTemperature(0), m_atmPressure(0), m_atmDensity(0), m_dynPressure(0),
+    m_altitude(0), m_airspeed(0), m_aoa(0), m_pitch(0), m_bank(0),
+    m_mass(0), m_emptyMass(0), m_groundContact(false), m_recording(false), m_playback(false)
+{
+}
+
+VESSEL::~VESSEL()
+{
+    for (double *pLevel : m_thrusters)
+        delete pLevel;
+    for (Propellant *pPropellant : m_propellants)
+        delete pPropellant;
+    for (Attachment *pAttachment : m_attachments)
+        delete pAttachment;
+}
+
+THRUSTER_HANDLE VESSEL::CreateThruster(const VECTOR3 &, const VECTOR3 &, double, PROPELLANT_HANDLE, double, double, double)
+{
+    m_thrusters.push_back(new double(0));
+    return m_thrusters.back();
+}
+
+PROPELLANT_HANDLE VESSEL::CreatePropellantResource(double maxMass, double mass, double efficiency)
+{
+    m_propellants.push_back(new Propellant{ maxMass, (mass < 0 ? maxMass : mass), efficiency });
+    return m_propellants.back();
+}
+
+ATTACHMENTHANDLE VESSEL::CreateAttachment(bool toParent, const VECTOR3 &pos, const VECTOR3 &dir, const VECTOR3 &rot, const char *pID, bool) const
+{
+    m_attachments.push_back(new Attachment{ toParent, pos, dir, rot, pID, nullptr });
+    return m_attachments.back();
+}
+
+DWORD VESSEL::AttachmentCount(bool toParent) const
+{
+    return static_cast<DWORD>(count_if(m_attachments.begin(), m_attachments.end(), [toParent](const Attachment *pAttachment) { return pAttachment->toParent == toParent; }));
+}
+
+ATTACHMENTHANDLE VESSEL::GetAttachmentHandle(bool toParent, DWORD index) const
+{
+    for (Attachment *pAttachment : m_attachments)
+    {
+        if ((pAttachment->toParent == toParent) && (index-- == 0))
+            return pAttachment;
+    }
+    return nullptr;
+}
+
+void VESSEL::GetAttachmentParams(ATTACHMENTHANDLE attachment, VECTOR3 &pos, VECTOR3 &dir, VECTOR3 &rot) const
+{
+    const Attachment *pAttachment = static_cast<const Attachment *>(attachment);
+    pos = pAttachment->pos;
+    dir = pAttachment->dir;
+    rot = pAttachment->rot;
+}
+
+//=========================================================================
+// general
+
+void oapiWriteLog(const char *)
+{
+    // tests check behavior rather than log output
+}
+
+char *oapiDebugString()
+{
+    static char s_debugString[256];
+    return s_debugString;
+}
+
+double oapiRand()
+{
+    // deterministic so that test runs are repeatable
+    static unsigned int s_seed = 1;
+    s_seed = s_seed * 1103515245 + 12345;
+    return ((s_seed >> 16) & 0x7FFF) / 32768.0;
+}
+
+double oapiGetSimTime() { return 0; }
+double oapiGetSimStep() { return 0; }
+double oapiGetTimeAcceleration() { return 1.0; }
+
+static double s_simMJD = 51544.5;   // 2000-01-01 12:00 UT; any date will do
+double oapiGetSimMJD() { return s_simMJD; }
+void oapiSetTestSimMJD(const double mjd) { s_simMJD = mjd; }
+
+static double s_sysTime;
+double oapiGetSysTime() { return s_sysTime; }
+void oapiSetTestSysTime(const double sysTime) { s_sysTime = sysTime; }
+
+const ATMCONST *oapiGetPlanetAtmConstants(OBJHANDLE hPlanet)
+{
+    // Earth's values from Orbiter's Earth.cfg; any non-null atmosphere reference is treated as Earth
+    static const ATMCONST s_earth = { 101.4e3, 1.293, 286.91, 1.4, 0, 0.20946, 2e5, 6.571e6, 0, { { 0.29, 0.45, 0.9 } } };
+    return (hPlanet ? &s_earth : nullptr);
+}
+
+// These match the formulas documented for the Orbiter API.
+double oapiGetInducedDrag(double cl, double A, double e)
+{
+    return cl * cl / (PI * A * e);
+}
+
+double oapiGetWaveDrag(double M, double M1, double M2, double M3, double cmax)
+{
+    if (M < M1)
+        return 0.0;
+    else if (M < M2)
+        return cmax * (M - M1) / (M2 - M1);
+    else if (M < M3)
+        return cmax;
+    else
+        return cmax * sqrt(M3 * M3 - 1.0) / sqrt(M * M - 1.0);
+}
+
+//=========================================================================
+// drawing and dialogs
+
+// Surfaces are XRTestsSurface objects when a test draws on them, and null otherwise.
+// Both calls count as GDI calls, and the predefined color key is black.
+void oapiColourFill(SURFHANDLE tgt, DWORD col, int tgtx, int tgty, int w, int h)
+{
+    g_gdiCallCount++;
+    XRTestsSurface *pTarget = static_cast<XRTestsSurface *>(tgt);
+    if (pTarget == nullptr)
+        return;
+
+    if ((w == 0) || (h == 0))
+    {
+        // as in Orbiter, a zero size fills the entire surface
+        tgtx = tgty = 0;
+        w = pTarget->width;
+        h = pTarget->height;
+    }
+    for (int y = max(tgty, 0); y < min(tgty + h, pTarget->height); y++)
+    {
+        for (int x = max(tgtx, 0); x < min(tgtx + w, pTarget->width); x++)
+            pTarget->pPixels[y * pTarget->width + x] = col;
+    }
+}
+
+void oapiBlt(SURFHANDLE tgt, SURFHANDLE src, int tgtx, int tgty, int srcx, int srcy, int w, int h, DWORD ck)
+{
+    g_gdiCallCount++;
+    XRTestsSurface *pTarget = static_cast<XRTestsSurface *>(tgt);
+    const XRTestsSurface *pSource = static_cast<const XRTestsSurface *>(src);
+    if ((pTarget == nullptr) || (pSource == nullptr))
+        return;
+
+    for (int j = 0; j < h; j++)
+    {
+        for (int i = 0; i < w; i++)
+        {
+            const int tx = tgtx + i, ty = tgty + j, sx = srcx + i, sy = srcy + j;
+            if ((tx < 0) || (ty < 0) || (tx >= pTarget->width) || (ty >= pTarget->height) ||
+                (sx < 0) || (sy < 0) || (sx >= pSource->width) || (sy >= pSource->height))
+                continue;
+
+            const uint32_t pixel = pSource->pPixels[sy * pSource->width + sx];
+            if ((ck == SURF_PREDEF_CK) && (pixel == 0))
+                continue;   // transparent
+            pTarget->pPixels[ty * pTarget->width + tx] = pixel;
+        }
+    }
+}
+void *oapiGetDialogContext(HWND) { return nullptr; }
+HWND oapiOpenDialog(HINSTANCE, int, INT_PTR (*)(HWND, UINT, WPARAM, LPARAM), void *) { return nullptr; }
+void oapiCloseDialog(HWND) { }
+void oapiVCTriggerRedrawArea(int, int) { }
+INT_PTR oapiDefDialogProc(HWND, UINT, WPARAM, LPARAM) { return 0; }
+
+//=========================================================================
+// vessels
+
+static vector<VESSEL *> s_vessels;
+
+void oapiRegisterTestVessel(VESSEL *pVessel)
+{
+    s_vessels.push_back(pVessel);
+}
+
+void oapiUnregisterTestVessel(VESSEL *pVessel)
+{
+    s_vessels.erase(remove(s_vessels.begin(), s_vessels.end(), pVessel), s_vessels.end());
+}
+
+DWORD oapiGetVesselCount()
+{
+    return static_cast<DWORD>(s_vessels.size());
+}
+
+OBJHANDLE oapiGetVesselByIndex(int index)
+{
+    return s_vessels[index]->GetHandle();
+}
+
+OBJHANDLE oapiGetVesselByName(const char *pName)
+{
+    for (VESSEL *pVessel : s_vessels)
+    {
+        if (strcmp(pVessel->GetName(), pName) == 0)
+            return pVessel->GetHandle();
+    }
+    return nullptr;
+}
+
+VESSEL *oapiGetVesselInterface(OBJHANDLE hVessel)
+{
+    for (VESSEL *pVessel : s_vessels)
+    {
+        if (pVessel->GetHandle() == hVessel)
+            return pVessel;
+    }
+    return nullptr;
+}
+
+bool oapiIsVessel(OBJHANDLE hVessel)
+{
+    return (oapiGetVesselInterface(hVessel) != nullptr);
+}
+
+OBJHANDLE oapiGetFocusObject()
+{
+    return (s_vessels.empty() ? nullptr : s_vessels.front()->GetHandle());
+}
+
+OBJHANDLE oapiCreateVesselEx(const char *, const char *, const VESSELSTATUS2 *)
+{
+    return nullptr;     // no vessel creation outside of Orbiter
+}
+
+bool oapiDeleteVessel(OBJHANDLE hVessel, OBJHANDLE)
+{
+    VESSEL *pVessel = oapiGetVesselInterface(hVessel);
+    if (pVessel == nullptr)
+        return false;
+
+    oapiUnregisterTestVessel(pVessel);
+    return true;
+}
+
+//=========================================================================
+// configuration files
+
+// An open configuration file: "Name = value" pairs, with case-insensitive names as in Orbiter.
+struct ConfigFile
+{
+    struct NoCaseLess
+    {
+        bool operator()(const string &a, const string &b) const { return strcasecmp(a.c_str(), b.c_str()) < 0; }
+    };
+    map<string, string, NoCaseLess> items;
+};
+
+// The working directory is the repository's Orbiter folder (see XRTests.cpp), so paths are relative to that as in Orbiter.
+FILEHANDLE oapiOpenFile(const char *pFilename, FileAccessMode mode, PathRoot root)
+{
+    if ((mode != FILE_IN) && (mode != FILE_IN_ZEROONFAIL))
+        return nullptr;     // tests never write configuration files
+
+    string path = XRTestsNativePath(pFilename);
+    if (root == CONFIG)
+        path = "Config/" + path;
+    else if (root == SCENARIOS)
+        path = "Scenarios/" + path;
+
+    FILE *pFile = fopen(path.c_str(), "r");
+    if (pFile == nullptr)
+        return nullptr;
+
+    ConfigFile *pConfig = new ConfigFile;
+    char line[1024];
+    while (fgets(line, sizeof(line), pFile))
+    {
+        char *pComment = strchr(line, ';');
+        if (pComment)
+            *pComment = 0;
+        char *pEquals = strchr(line, '=');
+        if (pEquals == nullptr)
+            continue;
+
+        *pEquals = 0;
+        string name(line), value(pEquals + 1);
+        const char *pWhitespace = " \t\r\n";
+        name.erase(name.find_last_not_of(pWhitespace) + 1);
+        name.erase(0, name.find_first_not_of(pWhitespace));
+        value.erase(value.find_last_not_of(pWhitespace) + 1);
+        value.erase(0, value.find_first_not_of(pWhitespace));
+        pConfig->items[name] = value;
+    }
+    fclose(pFile);
+    return pConfig;
+}
+
+void oapiCloseFile(FILEHANDLE hFile, FileAccessMode)
+{
+    delete static_cast<ConfigFile *>(hFile);
+}
+
+static const string *FindItem(FILEHANDLE hFile, const char *pItem)
+{
+    const ConfigFile *pConfig = static_cast<const ConfigFile *>(hFile);
+    const auto it = pConfig->items.find(pItem);
+    return (it == pConfig->items.end() ? nullptr : &it->second);
+}
+
+bool oapiReadItem_string(FILEHANDLE hFile, const char *pItem, char *pValue)
+{
+    const string *pStr = FindItem(hFile, pItem);
+    if (pStr == nullptr)
+        return false;
+
+    strcpy(pValue, pStr->c_str());
+    return true;
+}
+
+bool oapiReadItem_float(FILEHANDLE hFile, const char *pItem, double &value)
+{
+    const string *pStr = FindItem(hFile, pItem);
+    return (pStr && (sscanf(pStr->c_str(), "%lf", &value) == 1));
+}
+
+bool oapiReadItem_int(FILEHANDLE hFile, const char *pItem, int &value)
+{
+    const string *pStr = FindItem(hFile, pItem);
+    return (pStr && (sscanf(pStr->c_str(), "%d", &value) == 1));
+}
+
+bool oapiReadItem_bool(FILEHANDLE hFile, const char *pItem, bool &value)
+{
+    const string *pStr = FindItem(hFile, pItem);
+    if (pStr == nullptr)
+        return false;
+
+    value = (strcasecmp(pStr->c_str(), "TRUE") == 0);
+    return true;
+}
+
+bool oapiReadItem_vec(FILEHANDLE hFile, const char *pItem, VECTOR3 &value)
+{
+    const string *pStr = FindItem(hFile, pItem);
+    return (pStr && (sscanf(pStr->c_str(), "%lf %lf %lf", &value.x, &value.y, &value.z) == 3));
+}
@@ -0,0 +1,7 @@
+// Linux stand-in for the Shell path API.
+#pragma once
+
+#include "windows.h"
+#include <unistd.h>
+
+inline BOOL PathFileExists(const char *pPath) { return (access(pPath, F_OK) == 0); }
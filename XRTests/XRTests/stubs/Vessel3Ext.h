@@ -0,0 +1,4 @@
+// Linux builds are case-sensitive; some sources include "Vessel3Ext.h" and others "vessel3ext.h".
+#pragma once
+
+#include "vessel3ext.h"
@@ -0,0 +1,4 @@
+// Linux builds are case-sensitive; some sources include <Windows.h> and others <windows.h>.
+#pragma once
+
+#include "windows.h"
@@ -0,0 +1,4 @@
+// The XR1 sources include "XR1Colors.h" but the file is named xr1colors.h; Linux builds are case-sensitive.
+#pragma once
+
+#include "xr1colors.h"
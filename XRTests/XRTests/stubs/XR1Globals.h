@@ -0,0 +1,4 @@
+// The XR1 sources include "XR1Globals.h" but the file is named xr1globals.h; Linux builds are case-sensitive.
+#pragma once
+
+#include "xr1globals.h"
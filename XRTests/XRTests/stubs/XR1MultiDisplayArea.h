@@ -0,0 +1,150 @@
+// Stand-in for the XR1's XR1MultiDisplayArea.h, which pulls in the panel and area classes.
+// MultiDisplayArea provides only what MDAWidgetLayer and the modes use; MultiDisplayMode and
+// HullTempsMultiDisplayMode are declared as in the real header so that XR1MDAHullTempsMode.cpp
+// builds unchanged; keep them in sync with it.
+#pragma once
+
+#include "DeltaGliderXR1.h"
+#include "XR1Colors.h"
+#include "XR1MDAWidgetLayer.h"
+#include <vector>
+
+class MultiDisplayArea
+{
+public:
+    MultiDisplayArea(const int width, const int height, DeltaGliderXR1 *pXR1 = nullptr) : m_screenSize(_COORD2(width, height)), m_pXR1(pXR1) { }
+
+    const COORD2 &GetScreenSize() { return m_screenSize; }
+    HDC GetDC(const SURFHANDLE surf) { g_gdiCallCount++; return new XRTestsDC{ static_cast<XRTestsSurface *>(surf), nullptr, 0, TA_LEFT }; }
+    void ReleaseDC(const SURFHANDLE, const HDC hDC) { g_gdiCallCount++; delete hDC; }
+    void SetSurfaceColorKey(const SURFHANDLE, const DWORD) { }   // the stubs' predefined color key is always black
+
+    DeltaGliderXR1 &GetXR1() const { return *m_pXR1; }
+    VESSEL2 &GetVessel() const { return *m_pXR1; }
+
+    // Each resource bitmap is a screen-sized pattern unique to its resource ID; a pixel of 0 is transparent.
+    SURFHANDLE CreateSurface(const int resourceID) const
+    {
+        XRTestsSurface *pSurface = new XRTestsSurface{ m_screenSize.x, m_screenSize.y, new uint32_t[m_screenSize.x * m_screenSize.y] };
+        for (int i = 0; i < (m_screenSize.x * m_screenSize.y); i++)
+            pSurface->pPixels[i] = (((i % 5) == 0) ? 0 : static_cast<uint32_t>((i + resourceID) * 2654435761u) | 1);
+        return pSurface;
+    }
+
+    void DestroySurface(SURFHANDLE *pSurfHandle)
+    {
+        XRTestsSurface *pSurface = static_cast<XRTestsSurface *>(*pSurfHandle);
+        if (pSurface != nullptr)
+        {
+            delete[] pSurface->pPixels;
+            delete pSurface;
+            *pSurfHandle = nullptr;
+        }
+    }
+
+    // same as XR1Area in XR1Areas.cpp
+    COLORREF GetTempCREF(const double tempK, double limitK, const DoorStatus doorStatus) const
+    {
+        if (doorStatus != DoorStatus::DOOR_CLOSED)
+            limitK = GetXR1().m_hullTemperatureLimits.doorOpen;
+
+        const double warningTemp = limitK * GetXR1().m_hullTemperatureLimits.warningFrac;
+        const double criticalTemp = limitK * GetXR1().m_hullTemperatureLimits.criticalFrac;
+        if (tempK >= limitK)
+            return CREF(BRIGHT_WHITE);
+        if (tempK >= criticalTemp)
+            return CREF(BRIGHT_RED);
+        if (tempK >= warningTemp)
+            return CREF(BRIGHT_YELLOW);
+        return CREF(BRIGHT_GREEN);
+    }
+
+    COLORREF GetValueCREF(double value, double warningLimit, double criticalLimit) const
+    {
+        if (value >= criticalLimit)
+            return CREF(BRIGHT_RED);
+        if (value >= warningLimit)
+            return CREF(BRIGHT_YELLOW);
+        return CREF(BRIGHT_GREEN);
+    }
+
+    static double KelvinToFahrenheit(const double k) { return (((k - 273.15) * (9.0/5.0)) + 32); }
+    static double KelvinToCelsius(const double k) { return (k - 273.15); }
+    static double CelsiusToKelvin(const double c) { return (c + 273.15); }
+    static double CelsiusToFahrenheit(const double c) { return ((c * (9.0/5.0)) + 32); }
+
+protected:
+    COORD2 m_screenSize;
+    DeltaGliderXR1 *m_pXR1;
+};
+
+//----------------------------------------------------------------------------------
+
+// base class for all multi-display mode objects
+class MultiDisplayMode
+{
+public:
+    MultiDisplayMode(int modeNumber) :
+        m_modeNumber(modeNumber), m_pParentMDA(nullptr)  { }
+
+    // gateway methods to parent XR1Area methods that the MDM objects need
+    VESSEL2 &GetVessel() const { return m_pParentMDA->GetVessel(); }
+    DeltaGliderXR1 &GetXR1() const { return m_pParentMDA->GetXR1(); }
+    SURFHANDLE CreateSurface(const int resourceID) const { return m_pParentMDA->CreateSurface(resourceID); }
+    void DestroySurface(SURFHANDLE *pSurfHandle) { m_pParentMDA->DestroySurface(pSurfHandle); }
+    const COORD2 &GetScreenSize() const { return m_pParentMDA->GetScreenSize(); }
+    COLORREF GetTempCREF(double tempK, double limitK, DoorStatus doorStatus) const { return m_pParentMDA->GetTempCREF(tempK, limitK, doorStatus); }
+    COLORREF GetValueCREF(double value, double warningLimit, double criticalLimit) const { return m_pParentMDA->GetValueCREF(value, warningLimit, criticalLimit); }
+
+    void SetParent(MultiDisplayArea *pParentMDA) { m_pParentMDA = pParentMDA; }
+    int GetModeNumber() const { return m_modeNumber; }
+
+    virtual void OnParentAttach() { }
+    virtual void Activate() { }
+    virtual void Deactivate() { }
+    virtual bool Redraw2D(const int event, const SURFHANDLE surf) { return false;  }
+    virtual bool ProcessMouseEvent(const int event, const int mx, const int my) { return false; }
+    virtual bool ProcessVCMouseEvent(const int event, const VECTOR3 &coords) { return false; }
+
+protected:
+    int m_modeNumber;           // 0-n; this is the absolute mode number
+    MultiDisplayArea *m_pParentMDA;
+};
+
+//----------------------------------------------------------------------------------
+
+class HullTempsMultiDisplayMode : public MultiDisplayMode
+{
+public:
+    HullTempsMultiDisplayMode(int modeNumber);
+
+    // These methods are invoked by our parent MultiDisplayArea object.
+    virtual void Activate();
+    virtual void Deactivate();
+    virtual bool Redraw2D(const int event, const SURFHANDLE surf);
+    virtual bool ProcessMouseEvent(const int event, const int mx, const int my);
+
+protected:
+    virtual double GetHighestTempFrac();
+
+    // if DoorStatus::DOOR_OPEN, temperature values will be displayed in yellow or red correctly since that door is open
+    virtual DoorStatus GetNoseDoorStatus();
+    virtual DoorStatus GetLeftWingDoorStatus();
+    virtual DoorStatus GetRightWingDoorStatus();
+    virtual DoorStatus GetCockpitDoorStatus();
+    virtual DoorStatus GetTopHullDoorStatus();
+
+    void GetTemperatureStr(double tempK, char *pStrOut);
+    void GetCoolantTemperatureStr(double tempC, char *pStrOut);
+    SURFHANDLE m_backgroundSurface;   // main screen background
+    SURFHANDLE m_indicatorSurface;
+    COORD2 m_kfcButtonCoord;
+
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    int m_hullTempIndicatorID, m_coolantTempIndicatorID;
+    int m_kfcFieldID, m_extFieldID, m_noseconeFieldID, m_leftWingFieldID, m_rightWingFieldID, m_cockpitFieldID, m_topHullFieldID, m_coolantFieldID;
+
+    HFONT m_pKfcFont;
+    HFONT m_pCoolantFont;   // coolant temps only
+};
@@ -0,0 +1,17 @@
+// Stand-in for the XR1's XR1PayloadBay.h; the real xr1payloadbay.cpp also defines the
+// DeltaGliderXR1 payload methods, which pull in the rest of XR1Lib.
+#pragma once
+
+#include "DeltaGliderXR1.h"
+#include "XRPayloadBay.h"
+
+class XR1PayloadBay : public XRPayloadBay
+{
+public:
+    XR1PayloadBay(VESSEL &parentVessel) : XRPayloadBay(parentVessel) { }
+
+    DeltaGliderXR1 &GetXR1() const { return static_cast<DeltaGliderXR1 &>(GetParentVessel()); }
+
+    // the real callback unselects a slot that is now disabled; the tests do not select slots
+    virtual void clbkChildCreatedInBay(XRPayloadBaySlot &) { }
+};
@@ -0,0 +1,20 @@
+// Stand-in for the XR2's XR2Ravenstar.h, which pulls in nearly all of XR1Lib; it declares
+// only what xr2payloadbay.cpp uses.
+#pragma once
+
+#include "DeltaGliderXR1.h"
+
+extern const VECTOR3 &PAYLOAD_SLOT1_DIMENSIONS;   // from XR2Globals.h
+
+class XRPayloadBay;
+
+class XR2Ravenstar : public DeltaGliderXR1
+{
+public:
+    XR2Ravenstar() : m_pPayloadBay(nullptr), m_dummyAttachmentPoint(nullptr) { }
+
+    void CreatePayloadBay();
+
+    XRPayloadBay *m_pPayloadBay;
+    ATTACHMENTHANDLE m_dummyAttachmentPoint;
+};
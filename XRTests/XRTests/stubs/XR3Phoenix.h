@@ -0,0 +1,18 @@
+// Stand-in for the XR3's XR3Phoenix.h, which pulls in nearly all of XR1Lib; it declares
+// only what XR3PayloadBay.cpp uses.
+#pragma once
+
+#include "DeltaGliderXR1.h"
+
+class XRPayloadBay;
+
+class XR3Phoenix : public DeltaGliderXR1
+{
+public:
+    XR3Phoenix() : m_pPayloadBay(nullptr), m_dummyAttachmentPoint(nullptr) { }
+
+    void CreatePayloadBay();
+
+    XRPayloadBay *m_pPayloadBay;
+    ATTACHMENTHANDLE m_dummyAttachmentPoint;
+};
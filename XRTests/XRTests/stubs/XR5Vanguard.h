@@ -0,0 +1,18 @@
+// Stand-in for the XR5's XR5Vanguard.h, which pulls in nearly all of XR1Lib; it declares
+// only what xr5payloadbay.cpp uses.
+#pragma once
+
+#include "DeltaGliderXR1.h"
+
+class XRPayloadBay;
+
+class XR5Vanguard : public DeltaGliderXR1
+{
+public:
+    XR5Vanguard() : m_pPayloadBay(nullptr), m_dummyAttachmentPoint(nullptr) { }
+
+    void CreatePayloadBay();
+
+    XRPayloadBay *m_pPayloadBay;
+    ATTACHMENTHANDLE m_dummyAttachmentPoint;
+};
@@ -0,0 +1,15 @@
+// Stand-in for the XRSound SDK header; it declares only what XRSoundVoiceCache.cpp uses.  The methods are
+// virtual so that tests can record which files are loaded into which voices.
+#pragma once
+
+class XRSound
+{
+public:
+    enum PlaybackType { InternalOnly, BothViewFar, BothViewMedium, BothViewClose, Radio, Wind, Global };
+
+    virtual ~XRSound() { }
+    virtual bool LoadWav(const int soundID, const char *pSoundFilename, const PlaybackType playbackType) = 0;
+    virtual bool PlayWav(const int soundID, const bool bLoop = false, const float volume = 1.0f) = 0;
+    virtual bool StopWav(const int soundID) = 0;
+    virtual bool IsWavPlaying(const int soundID) = 0;
+};
@@ -0,0 +1,42 @@
+// Force-included ahead of every source file (see the Makefile): the MSVC C runtime
+// extensions and namespaces that the XR code uses without including windows.h.
+#pragma once
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+
+namespace stdext { }
+
+#define _stricmp strcasecmp
+#define _strnicmp strncasecmp
+#define _snprintf snprintf
+#define sscanf_s sscanf
+#define _strdup strdup
+
+// the "secure" CRT functions, in both their explicit-size and array-template forms
+inline int sprintf_s(char *pBuffer, const size_t size, const char *pFormat, ...) __attribute__((format(printf, 3, 4)));
+inline int sprintf_s(char *pBuffer, const size_t size, const char *pFormat, ...)
+{
+    va_list args;
+    va_start(args, pFormat);
+    const int length = vsnprintf(pBuffer, size, pFormat, args);
+    va_end(args);
+    return length;
+}
+
+template <size_t SIZE> int sprintf_s(char (&buffer)[SIZE], const char *pFormat, ...) __attribute__((format(printf, 2, 3)));
+template <size_t SIZE> int sprintf_s(char (&buffer)[SIZE], const char *pFormat, ...)
+{
+    va_list args;
+    va_start(args, pFormat);
+    const int length = vsnprintf(buffer, SIZE, pFormat, args);
+    va_end(args);
+    return length;
+}
+
+inline int strcpy_s(char *pDest, const size_t size, const char *pSrc) { snprintf(pDest, size, "%s", pSrc); return 0; }
+template <size_t SIZE> int strcpy_s(char (&dest)[SIZE], const char *pSrc) { return strcpy_s(dest, SIZE, pSrc); }
+inline int strcat_s(char *pDest, const size_t size, const char *pSrc) { const size_t length = strlen(pDest); return strcpy_s(pDest + length, size - length, pSrc); }
+template <size_t SIZE> int strcat_s(char (&dest)[SIZE], const char *pSrc) { return strcat_s(dest, SIZE, pSrc); }
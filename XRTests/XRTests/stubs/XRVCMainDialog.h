@@ -0,0 +1,10 @@
+// Stand-in for the XRVesselCtrlDemo's XRVCMainDialog.h, which pulls in the Win32 dialog;
+// the command parser only calls back into it to run script files.
+#pragma once
+
+class XRVCMainDialog
+{
+public:
+    static XRVCMainDialog *s_pSingleton;
+    bool ExecuteScriptFile(const char *pFilename) { return false; }
+};
@@ -0,0 +1,156 @@
+// Linux stand-in for the ATL CString class, covering the members the XR code uses.
+#pragma once
+
+#include "windows.h"
+#include <stdarg.h>
+#include <string>
+
+class CString
+{
+public:
+    CString() { }
+    CString(const char *pStr) : m_str(pStr ? pStr : "") { }
+    CString(const char *pStr, const int length) : m_str(pStr, length) { }
+    CString(const char ch, const int count = 1) : m_str(count, ch) { }
+    CString(const std::string &str) : m_str(str) { }
+
+    operator const char *() const { return m_str.c_str(); }
+    const char *GetString() const { return m_str.c_str(); }
+    int GetLength() const { return static_cast<int>(m_str.size()); }
+    bool IsEmpty() const { return m_str.empty(); }
+    void Empty() { m_str.clear(); }
+    char GetAt(const int index) const { return m_str[index]; }
+    char operator[](const int index) const { return m_str[index]; }
+    void SetAt(const int index, const char ch) { m_str[index] = ch; }
+
+    CString &operator=(const char *pStr) { m_str = (pStr ? pStr : ""); return *this; }
+    CString &operator=(const char ch) { m_str.assign(1, ch); return *this; }
+    CString &operator+=(const char *pStr) { m_str += pStr; return *this; }
+    CString &operator+=(const CString &str) { m_str += str.m_str; return *this; }
+    CString &operator+=(const char ch) { m_str += ch; return *this; }
+    void Append(const char *pStr) { m_str += pStr; }
+    void Append(const char *pStr, const int length) { m_str.append(pStr, length); }
+    void AppendChar(const char ch) { m_str += ch; }
+
+    void __attribute__((format(printf, 2, 3))) Format(const char *pFormat, ...)
+    {
+        va_list args;
+        va_start(args, pFormat);
+        m_str.clear();
+        AppendFormatV(pFormat, args);
+        va_end(args);
+    }
+
+    void __attribute__((format(printf, 2, 3))) AppendFormat(const char *pFormat, ...)
+    {
+        va_list args;
+        va_start(args, pFormat);
+        AppendFormatV(pFormat, args);
+        va_end(args);
+    }
+
+    int Compare(const char *pStr) const { return strcmp(m_str.c_str(), pStr); }
+    int CompareNoCase(const char *pStr) const { return strcasecmp(m_str.c_str(), pStr); }
+
+    int Find(const char ch, const int start = 0) const { return ToIndex(m_str.find(ch, start)); }
+    int Find(const char *pStr, const int start = 0) const { return ToIndex(m_str.find(pStr, start)); }
+    int FindOneOf(const char *pChars) const { return ToIndex(m_str.find_first_of(pChars)); }
+    int ReverseFind(const char ch) const { return ToIndex(m_str.rfind(ch)); }
+
+    CString Left(const int count) const { return CString(m_str.substr(0, Clamp(count))); }
+    CString Right(const int count) const { const int n = Clamp(count); return CString(m_str.substr(m_str.size() - n)); }
+    CString Mid(const int first) const { return CString(m_str.substr(Clamp(first))); }
+    CString Mid(const int first, const int count) const { return CString(m_str.substr(Clamp(first), (count < 0 ? 0 : count))); }
+
+    CString &MakeUpper() { for (char &ch : m_str) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch))); return *this; }
+    CString &MakeLower() { for (char &ch : m_str) ch = static_cast<char>(tolower(static_cast<unsigned char>(ch))); return *this; }
+    CString &TrimLeft() { m_str.erase(0, m_str.find_first_not_of(" \t\r\n")); return *this; }
+    CString &TrimRight() { m_str.erase(m_str.find_last_not_of(" \t\r\n") + 1); return *this; }
+    CString &Trim() { TrimRight(); return TrimLeft(); }
+
+    int Replace(const char oldCh, const char newCh)
+    {
+        int count = 0;
+        for (char &ch : m_str)
+        {
+            if (ch == oldCh)
+            {
+                ch = newCh;
+                count++;
+            }
+        }
+        return count;
+    }
+
+    int Remove(const char ch)
+    {
+        const size_t oldLength = m_str.size();
+        std::string out;
+        for (char c : m_str)
+        {
+            if (c != ch)
+                out += c;
+        }
+        m_str = out;
+        return static_cast<int>(oldLength - m_str.size());
+    }
+
+    int Delete(const int index, const int count = 1) { m_str.erase(Clamp(index), count); return GetLength(); }
+    int Insert(const int index, const char *pStr) { m_str.insert(Clamp(index), pStr); return GetLength(); }
+    int Insert(const int index, const char ch) { m_str.insert(Clamp(index), 1, ch); return GetLength(); }
+
+    // Returns the next token delimited by any of pDelimiters starting at 'start', which is advanced past it; start is -1 when no tokens remain.
+    CString Tokenize(const char *pDelimiters, int &start) const
+    {
+        if (start >= 0)
+        {
+            const size_t first = m_str.find_first_not_of(pDelimiters, start);
+            if (first != std::string::npos)
+            {
+                size_t end = m_str.find_first_of(pDelimiters, first);
+                if (end == std::string::npos)
+                    end = m_str.size();
+                start = static_cast<int>(end + 1);
+                return CString(m_str.substr(first, end - first));
+            }
+        }
+        start = -1;
+        return CString();
+    }
+
+    char *GetBuffer(const int minLength = 0) { if (static_cast<int>(m_str.size()) < minLength) m_str.resize(minLength); return &m_str[0]; }
+    char *GetBufferSetLength(const int length) { m_str.resize(length); return &m_str[0]; }
+    void ReleaseBuffer(const int newLength = -1) { m_str.resize(newLength < 0 ? strlen(m_str.c_str()) : newLength); }
+
+    bool operator==(const char *pStr) const { return m_str == pStr; }
+    bool operator!=(const char *pStr) const { return m_str != pStr; }
+    bool operator==(const CString &str) const { return m_str == str.m_str; }
+    bool operator!=(const CString &str) const { return m_str != str.m_str; }
+    bool operator<(const CString &str) const { return m_str < str.m_str; }
+
+protected:
+    std::string m_str;
+
+    static int ToIndex(const size_t pos) { return (pos == std::string::npos ? -1 : static_cast<int>(pos)); }
+    int Clamp(const int index) const { return (index < 0 ? 0 : (index > GetLength() ? GetLength() : index)); }
+
+    void AppendFormatV(const char *pFormat, va_list args)
+    {
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        const int length = vsnprintf(nullptr, 0, pFormat, argsCopy);
+        va_end(argsCopy);
+        if (length > 0)
+        {
+            const size_t oldLength = m_str.size();
+            m_str.resize(oldLength + length + 1);
+            vsnprintf(&m_str[oldLength], length + 1, pFormat, args);
+            m_str.resize(oldLength + length);
+        }
+    }
+};
+
+inline CString operator+(const CString &a, const CString &b) { CString out(a); out += b; return out; }
+inline CString operator+(const CString &a, const char *pB) { CString out(a); out += pB; return out; }
+inline CString operator+(const char *pA, const CString &b) { CString out(pA); out += b; return out; }
+inline CString operator+(const CString &a, const char ch) { CString out(a); out += ch; return out; }
@@ -0,0 +1,6 @@
+// Linux stand-in for the MSVC debug CRT header: only _ASSERTE is used.
+#pragma once
+
+#include <assert.h>
+
+#define _ASSERTE(expr) assert(expr)
@@ -0,0 +1,8 @@
+// Linux stand-in for the MSVC low-level I/O header.
+#pragma once
+
+#include <unistd.h>
+#include <errno.h>
+
+// MSVC uses 0x2 for write and 0x4 for read; R_OK and W_OK happen to match those values.
+inline int _access_s(const char *pPath, const int mode) { return (access(pPath, mode) == 0 ? 0 : errno); }
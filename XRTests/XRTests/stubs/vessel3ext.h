@@ -0,0 +1,69 @@
+// Stand-in for the XR framework's Vessel3Ext.h, which pulls in most of the framework;
+// the code under test only needs COORD2, two static helpers, and the panel redraw settings from it.
+#pragma once
+
+#include "OrbiterAPI.h"
+#include <vector>
+
+using namespace std;    // the real header brings this in through the framework headers it includes
+
+const int VCPANEL_TEXTURE_NONE = -1;
+enum class BLINK_RATE;
+enum class REDRAW_PRIORITY { LOW = 1, NORMAL = 2, HIGH = 4 };
+
+// the only framework setting that InstrumentPanel reads; tests set it directly
+class VesselConfigFileParser
+{
+public:
+    VesselConfigFileParser() : PanelRedrawBudget(0) { }
+    double GetPanelRedrawBudget() const { return PanelRedrawBudget; }
+
+    double PanelRedrawBudget;       // in milliseconds per frame for all PANEL_REDRAW_ALWAYS areas; 0 = unlimited
+};
+
+class VESSEL3_EXT : public VESSEL3
+{
+public:
+    VESSEL3_EXT() : m_pConfig(nullptr) { }
+
+    bool HasFocus() const { return true; }
+    double GetAbsoluteSimTime() const { return oapiGetSimTime(); }
+    void TriggerPanelRedrawArea(const int panelID, const int areaID) { }
+    virtual double GetAreaRedrawInterval(const int areaID) { return 0; }
+    virtual REDRAW_PRIORITY GetAreaRedrawPriority(const int areaID) { return REDRAW_PRIORITY::NORMAL; }
+
+    static void GetStatusSafe(const VESSEL &vessel, VESSELSTATUS2 &status, const bool resetToDefault)
+    {
+        memset(&status, 0, sizeof(status));
+        status.version = 2;
+        vessel.GetStatusEx(&status);
+    }
+
+    static int ResetAllFuelLevels(VESSEL *pVessel, const double levelFrac)
+    {
+        const DWORD dwPropCount = pVessel->GetPropellantCount();
+        for (DWORD i = 0; i < dwPropCount; i++)
+        {
+            PROPELLANT_HANDLE ph = pVessel->GetPropellantHandleByIndex(i);
+            pVessel->SetPropellantMass(ph, pVessel->GetPropellantMaxMass(ph) * levelFrac);
+        }
+        return static_cast<int>(dwPropCount);
+    }
+
+    VesselConfigFileParser *m_pConfig;
+};
+
+// 2D coordinates on an instrument panel (2D or 3D)
+struct COORD2
+{
+    int x, y;
+
+    bool InBounds(const COORD2 &topLeft, const int width, const int height) const
+    {
+        return ((x >= topLeft.x) && (x <= (topLeft.x + width)) && (y >= topLeft.y) && (y <= topLeft.y + height));
+    }
+};
+
+inline COORD2 _COORD2(int x, int y) { COORD2 c = { x, y }; return c; }
+inline COORD2 operator+(const COORD2 &a, const COORD2 &b) { return _COORD2(a.x + b.x, a.y + b.y); }
+inline COORD2 operator-(const COORD2 &a, const COORD2 &b) { return _COORD2(a.x - b.x, a.y - b.y); }
@@ -0,0 +1,543 @@
+// Linux stand-in for the parts of the Win32 API used by the XR code under test.
+// Only the declarations that code needs are here; GDI calls are counted so that
+// benchmarks can report how many each frame makes.
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <string>
+#include <atomic>
+#include <map>
+#include <algorithm>
+#include <crtdbg.h>
+
+typedef uint32_t DWORD;
+typedef uint16_t WORD;
+typedef uint8_t BYTE;
+typedef int BOOL;
+typedef long LONG;
+typedef unsigned int UINT;
+typedef intptr_t INT_PTR;
+typedef intptr_t LRESULT;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+typedef uint32_t COLORREF;
+typedef void *HANDLE;
+typedef void *HWND;
+typedef void *HINSTANCE;
+typedef void *HMODULE;
+typedef void *HBRUSH;
+typedef void *HPEN;
+typedef void *HGDIOBJ;
+typedef void *HBITMAP;
+typedef struct XRTestsFont *HFONT;    // see CreateFont below
+typedef struct XRTestsDC *HDC;
+
+#define FALSE 0
+#define TRUE 1
+#define MAX_PATH 260
+#define CALLBACK
+#define WINAPI
+
+#define RGB(r, g, b) static_cast<COLORREF>(((r) & 0xFF) | (((g) & 0xFF) << 8) | (((b) & 0xFF) << 16))
+
+// The XR code relies on windows.h for min and max; std's versions work for it as long as both arguments have the same type.
+using std::min;
+using std::max;
+
+// time
+
+typedef struct { DWORD dwLowDateTime, dwHighDateTime; } FILETIME;
+typedef struct { WORD wYear, wMonth, wDayOfWeek, wDay, wHour, wMinute, wSecond, wMilliseconds; } SYSTEMTIME;
+typedef union { struct { DWORD LowPart; LONG HighPart; }; long long QuadPart; } LARGE_INTEGER;
+
+inline void GetSystemTimeAsFileTime(FILETIME *pFileTime)
+{
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    const uint64_t t = static_cast<uint64_t>(ts.tv_sec) * 10000000ULL + ts.tv_nsec / 100;
+    pFileTime->dwLowDateTime = static_cast<DWORD>(t);
+    pFileTime->dwHighDateTime = static_cast<DWORD>(t >> 32);
+}
+
+inline BOOL FileTimeToLocalFileTime(const FILETIME *pFileTime, FILETIME *pLocalFileTime) { *pLocalFileTime = *pFileTime; return TRUE; }
+
+inline BOOL FileTimeToSystemTime(const FILETIME *pFileTime, SYSTEMTIME *pSystemTime)
+{
+    const uint64_t t = (static_cast<uint64_t>(pFileTime->dwHighDateTime) << 32) | pFileTime->dwLowDateTime;
+    const time_t seconds = static_cast<time_t>(t / 10000000ULL);
+    tm parts;
+    gmtime_r(&seconds, &parts);
+    pSystemTime->wYear = static_cast<WORD>(parts.tm_year + 1900);
+    pSystemTime->wMonth = static_cast<WORD>(parts.tm_mon + 1);
+    pSystemTime->wDayOfWeek = static_cast<WORD>(parts.tm_wday);
+    pSystemTime->wDay = static_cast<WORD>(parts.tm_mday);
+    pSystemTime->wHour = static_cast<WORD>(parts.tm_hour);
+    pSystemTime->wMinute = static_cast<WORD>(parts.tm_min);
+    pSystemTime->wSecond = static_cast<WORD>(parts.tm_sec);
+    pSystemTime->wMilliseconds = static_cast<WORD>((t / 10000) % 1000);
+    return TRUE;
+}
+
+inline void GetLocalTime(SYSTEMTIME *pSystemTime)
+{
+    FILETIME fileTime;
+    GetSystemTimeAsFileTime(&fileTime);
+    FileTimeToSystemTime(&fileTime, pSystemTime);
+}
+
+inline BOOL QueryPerformanceFrequency(LARGE_INTEGER *pFrequency) { pFrequency->QuadPart = 1000000000LL; return TRUE; }
+
+// Tests set this to run the performance counter from a simulated clock, in nanoseconds; -1 = the real clock
+inline long long &XRTestsPerformanceCounter()
+{
+    static long long s_counter = -1;
+    return s_counter;
+}
+
+inline BOOL QueryPerformanceCounter(LARGE_INTEGER *pCount)
+{
+    if (XRTestsPerformanceCounter() >= 0)
+    {
+        pCount->QuadPart = XRTestsPerformanceCounter();
+        return TRUE;
+    }
+
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    pCount->QuadPart = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    return TRUE;
+}
+
+inline DWORD GetTickCount() { LARGE_INTEGER count; QueryPerformanceCounter(&count); return static_cast<DWORD>(count.QuadPart / 1000000); }
+
+// files
+
+typedef struct { DWORD dwFileAttributes; FILETIME ftCreationTime, ftLastAccessTime, ftLastWriteTime; DWORD nFileSizeHigh, nFileSizeLow; } WIN32_FILE_ATTRIBUTE_DATA;
+enum GET_FILEEX_INFO_LEVELS { GetFileExInfoStandard };
+
+inline BOOL GetFileAttributesEx(const char *pFilename, GET_FILEEX_INFO_LEVELS, WIN32_FILE_ATTRIBUTE_DATA *pData)
+{
+    struct stat st;
+    if (stat(pFilename, &st) != 0)
+        return FALSE;
+
+    memset(pData, 0, sizeof(*pData));
+    const uint64_t t = static_cast<uint64_t>(st.st_mtim.tv_sec) * 10000000ULL + st.st_mtim.tv_nsec / 100;
+    pData->ftLastWriteTime.dwLowDateTime = static_cast<DWORD>(t);
+    pData->ftLastWriteTime.dwHighDateTime = static_cast<DWORD>(t >> 32);
+    pData->nFileSizeLow = static_cast<DWORD>(st.st_size);
+    pData->nFileSizeHigh = static_cast<DWORD>(static_cast<uint64_t>(st.st_size) >> 32);
+    return TRUE;
+}
+
+inline LONG CompareFileTime(const FILETIME *pA, const FILETIME *pB)
+{
+    const uint64_t a = (static_cast<uint64_t>(pA->dwHighDateTime) << 32) | pA->dwLowDateTime;
+    const uint64_t b = (static_cast<uint64_t>(pB->dwHighDateTime) << 32) | pB->dwLowDateTime;
+    return (a < b ? -1 : (a > b ? 1 : 0));
+}
+
+// FindFirstFile supports wildcards in the last path component only; as on Windows, they match without regard to case.
+#define FILE_ATTRIBUTE_DIRECTORY 0x10
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(-1))
+#define ERROR_NO_MORE_FILES 18
+typedef struct { DWORD dwFileAttributes; FILETIME ftCreationTime, ftLastAccessTime, ftLastWriteTime; DWORD nFileSizeHigh, nFileSizeLow; char cFileName[MAX_PATH]; } WIN32_FIND_DATA;
+struct XRTestsFind { DIR *pDir; std::string path; std::string pattern; };
+
+// Converts a Windows path to a Linux one: backslashes become slashes, and since Windows paths are
+// case-insensitive, any component that does not exist as spelled is matched case-insensitively.
+inline std::string XRTestsNativePath(const char *pPath)
+{
+    std::string path(pPath);
+    for (char &ch : path)
+    {
+        if (ch == '\\')
+            ch = '/';
+    }
+
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0)
+        return path;
+
+    std::string resolved = ((path[0] == '/') ? "/" : "");
+    size_t start = ((path[0] == '/') ? 1 : 0);
+    while (start <= path.size())
+    {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos)
+            end = path.size();
+        std::string component = path.substr(start, end - start);
+        const std::string candidate = resolved + component;
+        if (!component.empty() && (component != ".") && (component != "..") && (stat(candidate.c_str(), &st) != 0))
+        {
+            DIR *pDir = opendir(resolved.empty() ? "." : resolved.c_str());
+            if (pDir != nullptr)
+            {
+                for (const dirent *pEntry = readdir(pDir); pEntry != nullptr; pEntry = readdir(pDir))
+                {
+                    if (strcasecmp(pEntry->d_name, component.c_str()) == 0)
+                    {
+                        component = pEntry->d_name;
+                        break;
+                    }
+                }
+                closedir(pDir);
+            }
+        }
+        resolved += component;
+        if (end < path.size())
+            resolved += '/';
+        start = end + 1;
+    }
+    return resolved;
+}
+
+inline BOOL FindNextFile(HANDLE hFind, WIN32_FIND_DATA *pData)
+{
+    XRTestsFind *pFind = static_cast<XRTestsFind *>(hFind);
+    const dirent *pEntry;
+    do
+    {
+        pEntry = readdir(pFind->pDir);
+        if (pEntry == nullptr)
+            return FALSE;
+    } while (fnmatch(pFind->pattern.c_str(), pEntry->d_name, FNM_CASEFOLD) != 0);
+
+    memset(pData, 0, sizeof(*pData));
+    snprintf(pData->cFileName, sizeof(pData->cFileName), "%s", pEntry->d_name);
+    struct stat st;
+    if (stat((pFind->path + "/" + pEntry->d_name).c_str(), &st) == 0)
+    {
+        pData->dwFileAttributes = (S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : 0);
+        pData->nFileSizeLow = static_cast<DWORD>(st.st_size);
+    }
+    return TRUE;
+}
+
+inline HANDLE FindFirstFile(const char *pWildcard, WIN32_FIND_DATA *pData)
+{
+    std::string path = XRTestsNativePath(pWildcard);
+    const size_t lastSlash = path.rfind('/');
+    const std::string pattern = path.substr(lastSlash + 1);
+    path.erase(lastSlash);
+    DIR *pDir = opendir(path.c_str());
+    if (pDir == nullptr)
+        return INVALID_HANDLE_VALUE;
+
+    XRTestsFind *pFind = new XRTestsFind{ pDir, path, pattern };
+    if (!FindNextFile(pFind, pData))
+    {
+        closedir(pDir);
+        delete pFind;
+        return INVALID_HANDLE_VALUE;
+    }
+    return pFind;
+}
+
+inline BOOL FindClose(HANDLE hFind)
+{
+    XRTestsFind *pFind = static_cast<XRTestsFind *>(hFind);
+    closedir(pFind->pDir);
+    delete pFind;
+    return TRUE;
+}
+
+#define INVALID_FILE_ATTRIBUTES (static_cast<DWORD>(-1))
+
+inline DWORD GetFileAttributes(const char *pFilename)
+{
+    struct stat st;
+    if (stat(XRTestsNativePath(pFilename).c_str(), &st) != 0)
+        return INVALID_FILE_ATTRIBUTES;
+    return (S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : 0);
+}
+
+inline DWORD GetLastError() { return ERROR_NO_MORE_FILES; }
+inline void OutputDebugString(const char *) { }
+inline void Sleep(const DWORD milliseconds) { timespec ts = { static_cast<time_t>(milliseconds / 1000), static_cast<long>(milliseconds % 1000) * 1000000L }; nanosleep(&ts, nullptr); }
+
+// files: each handle is a file descriptor plus the file pointer that SetEndOfFile uses
+
+typedef size_t SIZE_T;
+typedef long long LONGLONG;
+#define GENERIC_READ 0x80000000
+#define GENERIC_WRITE 0x40000000
+#define FILE_SHARE_READ 0x00000001
+#define CREATE_ALWAYS 2
+#define FILE_ATTRIBUTE_NORMAL 0x80
+#define FILE_BEGIN 0
+struct XRTestsMapping { int fd; std::string name; bool isOwner; long long filePointer; };   // a file or a file mapping
+
+inline HANDLE CreateFile(const char *pFilename, DWORD, DWORD, void *, DWORD, DWORD, HANDLE)
+{
+    const int fd = open(XRTestsNativePath(pFilename).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);   // always CREATE_ALWAYS
+    return ((fd < 0) ? INVALID_HANDLE_VALUE : new XRTestsMapping{ fd, std::string(), false, 0 });
+}
+
+inline BOOL CreateDirectory(const char *pPath, void *) { return (mkdir(XRTestsNativePath(pPath).c_str(), 0755) == 0); }
+inline BOOL DeleteFile(const char *pFilename) { return (unlink(XRTestsNativePath(pFilename).c_str()) == 0); }
+
+// fopen accepts Windows paths, as it does on Windows
+inline FILE *XRTestsFOpen(const char *pFilename, const char *pMode) { return fopen(XRTestsNativePath(pFilename).c_str(), pMode); }
+#define fopen XRTestsFOpen
+
+inline BOOL SetFilePointerEx(HANDLE hFile, LARGE_INTEGER distance, LARGE_INTEGER *, DWORD)
+{
+    static_cast<XRTestsMapping *>(hFile)->filePointer = distance.QuadPart;  // always FILE_BEGIN
+    return TRUE;
+}
+
+inline BOOL SetEndOfFile(HANDLE hFile)
+{
+    XRTestsMapping *pFile = static_cast<XRTestsMapping *>(hFile);
+    return (ftruncate(pFile->fd, pFile->filePointer) == 0);
+}
+
+// Tests set this to make mapping a file larger than this many bytes fail, as it would if the disk were full; -1 = no limit
+inline long long &XRTestsMaxMappedFileBytes()
+{
+    static long long s_maxBytes = -1;
+    return s_maxBytes;
+}
+
+// File mappings: a mapping of a file extends the file to the mapping size, as on Windows.  Named mappings of no
+// file are backed by POSIX shared memory objects, which the creating handle removes when it is closed.
+
+#define PAGE_READWRITE 0x04
+#define FILE_MAP_WRITE 0x0002
+#define FILE_MAP_READ 0x0004
+
+inline std::string XRTestsMappingName(const char *pName)
+{
+    std::string name = std::string("/") + pName;
+    std::replace(name.begin() + 1, name.end(), '\\', '_');
+    return name;
+}
+
+inline HANDLE CreateFileMapping(HANDLE hFile, void *, DWORD, DWORD sizeHigh, DWORD sizeLow, const char *pName)
+{
+    if (hFile != INVALID_HANDLE_VALUE)
+    {
+        const long long size = (static_cast<long long>(sizeHigh) << 32) | sizeLow;
+        const int fileFD = static_cast<XRTestsMapping *>(hFile)->fd;
+        struct stat st;
+        if (((XRTestsMaxMappedFileBytes() >= 0) && (size > XRTestsMaxMappedFileBytes())) || (fstat(fileFD, &st) != 0))
+            return nullptr;
+        if ((st.st_size < size) && (ftruncate(fileFD, size) != 0))
+            return nullptr;
+        return new XRTestsMapping{ dup(fileFD), std::string(), false, 0 };
+    }
+
+    const DWORD size = sizeLow;
+    const std::string name = XRTestsMappingName(pName);
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0)
+        return nullptr;
+    if (ftruncate(fd, size) != 0)
+    {
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+    return new XRTestsMapping{ fd, name, true, 0 };
+}
+
+inline HANDLE OpenFileMapping(DWORD, BOOL, const char *pName)
+{
+    const std::string name = XRTestsMappingName(pName);
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    return ((fd < 0) ? nullptr : new XRTestsMapping{ fd, name, false, 0 });
+}
+
+// munmap needs the length of each view, so remember it
+inline std::map<const void *, size_t> &XRTestsMappedViews()
+{
+    static std::map<const void *, size_t> s_views;
+    return s_views;
+}
+
+inline void *MapViewOfFile(HANDLE hMapping, DWORD access, DWORD, DWORD, size_t size)
+{
+    const int protection = ((access & FILE_MAP_WRITE) ? (PROT_READ | PROT_WRITE) : PROT_READ);
+    void *pView = mmap(nullptr, size, protection, MAP_SHARED, static_cast<XRTestsMapping *>(hMapping)->fd, 0);
+    if (pView == MAP_FAILED)
+        return nullptr;
+    XRTestsMappedViews()[pView] = size;
+    return pView;
+}
+
+inline BOOL FlushViewOfFile(const void *pView, SIZE_T)
+{
+    auto it = XRTestsMappedViews().find(pView);
+    return ((it != XRTestsMappedViews().end()) && (msync(const_cast<void *>(pView), it->second, MS_SYNC) == 0));
+}
+
+inline BOOL UnmapViewOfFile(const void *pView)
+{
+    auto it = XRTestsMappedViews().find(pView);
+    if (it == XRTestsMappedViews().end())
+        return FALSE;
+    munmap(const_cast<void *>(pView), it->second);
+    XRTestsMappedViews().erase(it);
+    return TRUE;
+}
+
+// only files and file mappings are closed with CloseHandle by the code under test
+inline BOOL CloseHandle(HANDLE hObject)
+{
+    XRTestsMapping *pMapping = static_cast<XRTestsMapping *>(hObject);
+    close(pMapping->fd);
+    if (pMapping->isOwner)
+        shm_unlink(pMapping->name.c_str());
+    delete pMapping;
+    return TRUE;
+}
+
+inline void YieldProcessor()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+inline HMODULE GetModuleHandle(const char *) { return nullptr; }
+inline void *GetProcAddress(HMODULE, const char *) { return nullptr; }
+
+// dialogs
+#define WM_INITDIALOG 0x0110
+#define WM_COMMAND 0x0111
+#define IDOK 1
+#define IDCANCEL 2
+#define BM_GETCHECK 0x00F0
+#define BM_SETCHECK 0x00F1
+#define BST_UNCHECKED 0
+#define BST_CHECKED 1
+#define LOWORD(l) (static_cast<WORD>(static_cast<uintptr_t>(l) & 0xFFFF))
+#define HIWORD(l) (static_cast<WORD>((static_cast<uintptr_t>(l) >> 16) & 0xFFFF))
+inline LRESULT SendDlgItemMessage(HWND, int, UINT, WPARAM, LPARAM) { return 0; }
+
+#define MB_OK 0
+#define MB_SETFOREGROUND 0
+#define MB_ICONWARNING 0
+inline int MessageBox(HWND, const char *, const char *, UINT) { return 0; }
+
+// GDI: text is drawn as 6-pixel-wide glyphs that are blended into a 32-bit surface,
+// so that a test can detect both missing and redundant redraws pixel-for-pixel.
+
+struct XRTestsFont { int height; };
+struct XRTestsSurface { int width, height; uint32_t *pPixels; };
+struct XRTestsDC { XRTestsSurface *pSurface; HFONT hFont; COLORREF textColor; UINT textAlign; };
+
+extern long g_gdiCallCount;   // defined by the test framework
+
+#define TA_LEFT 0
+#define TA_RIGHT 2
+#define TA_CENTER 6
+#define FF_MODERN 0x30
+#define TA_TOP 0
+#define TRANSPARENT 1
+#define OPAQUE 2
+#define XRTESTS_GLYPH_WIDTH 6
+
+typedef struct { LONG cx, cy; } SIZE;
+typedef struct { LONG left, top, right, bottom; } RECT;
+typedef struct { LONG tmHeight, tmAscent, tmDescent, tmOverhang; } TEXTMETRIC;
+
+inline HFONT CreateFont(int height, int, int, int, int, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, const char *) { return new XRTestsFont{ (height < 0 ? -height : height) }; }
+inline HDC CreateCompatibleDC(HDC) { return new XRTestsDC{ nullptr, nullptr, 0, TA_LEFT }; }
+inline BOOL DeleteDC(HDC hDC) { delete hDC; return TRUE; }
+inline HFONT SelectObject(HDC hDC, HFONT hFont) { g_gdiCallCount++; HFONT hOld = hDC->hFont; hDC->hFont = hFont; return hOld; }
+inline int SetBkMode(HDC, int) { g_gdiCallCount++; return OPAQUE; }
+inline COLORREF SetBkColor(HDC, COLORREF) { g_gdiCallCount++; return 0; }   // text is always blended; see TextOut
+inline COLORREF SetTextColor(HDC hDC, COLORREF color) { g_gdiCallCount++; COLORREF old = hDC->textColor; hDC->textColor = color; return old; }
+inline UINT SetTextAlign(HDC hDC, UINT align) { g_gdiCallCount++; UINT old = hDC->textAlign; hDC->textAlign = align; return old; }
+
+inline BOOL GetTextExtentPoint32(HDC hDC, const char *, int length, SIZE *pSize)
+{
+    pSize->cx = XRTESTS_GLYPH_WIDTH * length;
+    pSize->cy = (hDC->hFont ? hDC->hFont->height : 0);
+    return TRUE;
+}
+
+inline BOOL GetTextMetrics(HDC hDC, TEXTMETRIC *pMetrics)
+{
+    pMetrics->tmHeight = (hDC->hFont ? hDC->hFont->height : 0);
+    pMetrics->tmAscent = pMetrics->tmHeight;
+    pMetrics->tmDescent = 0;
+    pMetrics->tmOverhang = 0;
+    return TRUE;
+}
+
+inline BOOL TextOut(HDC hDC, int x, int y, const char *pText, int length)
+{
+    g_gdiCallCount++;
+    const int width = XRTESTS_GLYPH_WIDTH * length;
+    const int height = (hDC->hFont ? hDC->hFont->height : 0);
+    const UINT align = (hDC->textAlign & TA_CENTER);
+    const int left = (align == TA_CENTER ? x - width / 2 : (align == TA_RIGHT ? x - width : x));
+    XRTestsSurface *pSurface = hDC->pSurface;
+    for (int i = 0; i < width; i++)
+    {
+        for (int j = 0; j < height; j++)
+        {
+            const int px = left + i, py = y + j;
+            if ((px < 0) || (py < 0) || (px >= pSurface->width) || (py >= pSurface->height))
+                continue;
+
+            // blend rather than overwrite: drawing the same text twice without erasing it first changes the result
+            const char c = pText[i / XRTESTS_GLYPH_WIDTH];
+            uint32_t &pixel = pSurface->pPixels[py * pSurface->width + px];
+            if (((i + j + c) % 3) == 0)
+                pixel = pixel * 3 + hDC->textColor + c;
+        }
+    }
+    return TRUE;
+}
+
+// bitmaps: LoadImage reads the file so that load time is realistic, and allocates a 24-bit DIB of the requested size
+
+#define IMAGE_BITMAP 0
+#define LR_LOADFROMFILE 0x10
+struct XRTestsBitmap { int width, height; unsigned char *pBits; };
+extern std::atomic<long> g_liveBitmapBytes;   // defined by the test framework; the thumbnail cache loads bitmaps on its own thread
+
+inline HANDLE LoadImage(HINSTANCE, const char *pFilename, UINT, int width, int height, UINT)
+{
+    FILE *pFile = fopen(pFilename, "rb");
+    if (pFile == nullptr)
+        return nullptr;
+
+    XRTestsBitmap *pBitmap = new XRTestsBitmap{ width, height, new unsigned char[width * height * 3] };
+    memset(pBitmap->pBits, 0, width * height * 3);
+    fread(pBitmap->pBits, 1, width * height * 3, pFile);
+    fclose(pFile);
+    g_liveBitmapBytes += width * height * 3;
+    return pBitmap;
+}
+
+inline BOOL DeleteObject(HFONT hFont)
+{
+    delete hFont;
+    return TRUE;
+}
+
+inline BOOL DeleteObject(HGDIOBJ hObject)
+{
+    XRTestsBitmap *pBitmap = static_cast<XRTestsBitmap *>(hObject);
+    g_liveBitmapBytes -= pBitmap->width * pBitmap->height * 3;
+    delete[] pBitmap->pBits;
+    delete pBitmap;
+    return TRUE;
+}
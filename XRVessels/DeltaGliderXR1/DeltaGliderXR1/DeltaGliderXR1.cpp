@@ -45,6 +45,7 @@ DLLCLBK void InitModule (HINSTANCE hModule)
 DLLCLBK void ExitModule (HINSTANCE hModule)
 {
     oapiUnregisterCustomControls(hModule);
+    XRLogWriter::Terminate();    // flush and close the log file
 }
 
 // --------------------------------------------------------------
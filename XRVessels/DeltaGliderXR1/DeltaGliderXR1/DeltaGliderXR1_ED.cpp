@@ -182,6 +182,7 @@ INT_PTR CALLBACK EdPg2Proc (HWND hTab, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     }
                 }
 
+                dg->RefreshCrewMass();
                 dg->SetPassengerVisuals();
                 dg->SetEmptyMass();
                 sprintf (cbuf, "%0.2f kg", dg->GetMass());
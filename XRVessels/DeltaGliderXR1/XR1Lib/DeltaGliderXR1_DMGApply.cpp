@@ -109,7 +109,7 @@ void DeltaGliderXR1::PerformCrashDamage()
     // kill the APU
     apu_status = DoorStatus::DOOR_FAILED;   // this will deactivate all doors as well
     m_apuWarning = true;
-    m_apuFuelQty = 0;
+    SetAPUFuelQty(0);
     StopSound(APU);
 }
 
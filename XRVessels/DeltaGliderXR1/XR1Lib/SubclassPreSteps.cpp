@@ -85,7 +85,7 @@ void RotateWheelsPreStep::clbkPrePostStep(const double simt, const double simdt,
         return;  
 
     VECTOR3 gsVector;
-	GetXR1().GetGroundspeedVector(FRAME_LOCAL, gsVector);
+	GetXR1().GetFlightState().GetGroundspeedVector(FRAME_LOCAL, gsVector);
 	const double groundSpeed = gsVector.z;  // in m/s; may be negative!
 
 #if 0   // set to 1 for constant spin for testing
@@ -210,14 +210,14 @@ void AnimateGearCompressionPreStep::clbkPrePostStep(const double simt, const dou
         return;
     }
 
-    const double altitude = GetVessel().GetAltitude(ALTMODE_GROUND);  // altitude at the ship's centerpoint in meters
+    const double altitude = GetVessel().GetFlightState().GetAltitude(ALTMODE_GROUND);  // altitude at the ship's centerpoint in meters
 
     // for efficiency, only recompute translation if the altitude has changed since the previous timestep
     if (altitude == m_previousAltitude)
         return;
 
     m_previousAltitude = altitude;
-    const double pitch = GetVessel().GetPitch();  // in radians
+    const double pitch = GetVessel().GetFlightState().GetPitch();  // in radians
 
     // Compute the length of the a and b legs of the front or rear strut triangle using a line parallel to the ground through the ship's centerpoint along the b leg
     // and the ship's centerline as the c leg (hypotenuse).  This will give us the all the data for the right triangle for these three lines:
@@ -94,11 +94,10 @@ bool TextBox::Render(HDC hDC, int topY, HFONT font, int lineSpacing, bool forceR
         const int endingLineIndex = min(startingLineIndex + m_screenLineCount, bufferLineCount);   // EXCLUSIVE
         for (int i = startingLineIndex; i < endingLineIndex; i++)
         {
-            const TextLine &line = m_textLineGroup.GetLine(i);
-            const char *pText = line.text.c_str();
+            const TextLine line = m_textLineGroup.GetLine(i);
 
             SetTextColor(hDC, (line.color == TEXTCOLOR::Normal ? m_normalTextColor : m_highlightTextColor));
-            TextOut(hDC, cx, cy, pText, static_cast<int>(line.text.length()));
+            TextOut(hDC, cx, cy, line.text, line.length);
 
             // drop to next line
             cy += lineSpacing;
@@ -117,63 +116,68 @@ bool TextBox::Render(HDC hDC, int topY, HFONT font, int lineSpacing, bool forceR
 // Constructor
 // maxLines = maximum # of lines to preserve in this line group; after full, the oldest line will be discarded
 TextLineGroup::TextLineGroup(const int maxLines) :
-    m_maxLines(maxLines), m_addLinesCount(0)
+    m_maxLines(maxLines), m_maxLineLength(MAX_MESSAGE_LENGTH - 1), m_addLinesCount(0),
+    m_chars(maxLines * MAX_MESSAGE_LENGTH), m_slots(maxLines), m_oldestSlot(0), m_lineCount(0)
 {
+    // each slot has a fixed region of the character buffer
+    for (int i = 0; i < m_maxLines; i++)
+    {
+        m_slots[i].offset = i * (m_maxLineLength + 1);
+        m_slots[i].length = 0;
+        m_slots[i].color = TEXTCOLOR::Normal;
+        m_chars[m_slots[i].offset] = 0;
+    }
 }
 
 TextLineGroup::~TextLineGroup()
 {
-    // free all TextLine objects in the buffer
-    for (unsigned int i=0; i < m_lines.size(); i++)
-        delete m_lines[i];
 }
 
-
 // Add lines of text to the HUD; newlines are denoted by the "&" character
 // highlighted = to render in highlighted color or normal color
 void TextLineGroup::AddLines(const char *pStr, bool highlighted)
 {
     m_addLinesCount++;      // text has changed now
 
-    // mark a working copy and parse it into separate lines
-    char temp[MAX_MESSAGE_LENGTH];
-    strcpy(temp, pStr);
-
-    char *pStart = temp;
-    bool cont = true;
-    while (cont)
+    // copy each line straight from the caller's string into the buffer
+    const TEXTCOLOR color = (highlighted ? TEXTCOLOR::Highlighted : TEXTCOLOR::Normal);
+    const char *pStart = pStr;
+    for (;;)
     {
-        char *pEnd = strchr(pStart, '&');
-        if (pEnd)   // found a newline?
+        const char *pEnd = strchr(pStart, '&');
+        if (pEnd == nullptr)   // this is the last line
         {
-            *pEnd = 0;     // terminate line
+            AddLine(pStart, static_cast<int>(strlen(pStart)), color);
+            break;
         }
-        else
-            cont = false;   // this is the last line
-
-        TextLine textLine(pStart, (highlighted ? TEXTCOLOR::Highlighted : TEXTCOLOR::Normal));
-        AddLine(textLine);
 
-        if (pEnd)
-            pStart = pEnd + 1;  // set to start of next line
+        AddLine(pStart, static_cast<int>(pEnd - pStart), color);
+        pStart = pEnd + 1;  // set to start of next line
     }
 }
 
-// Add a line to the buffer, removing the oldest line in the buffer if necessary
-// textLine will be cloned internally by the vector's push_back method
-void TextLineGroup::AddLine(const TextLine &textLine)
+// Add a line to the buffer, overwriting the oldest line in the buffer if necessary
+// pText = line text; it does not need to be null-terminated
+void TextLineGroup::AddLine(const char *pText, const int length, const TEXTCOLOR color)
 {
-    // lines are stored oldest -> newest; i.e., index #0 has oldest line
-    m_lines.push_back(new TextLine(textLine));  // clone incoming line object
-
-    int lineCount = GetLineCount();
-    if (lineCount > m_maxLines)
+    // lines are stored oldest -> newest starting at m_oldestSlot
+    int slotIndex;
+    if (m_lineCount < m_maxLines)
     {
-        lineCount = m_maxLines;  // keep in range
-        // New code
-        // Delete the oldest item in the list (at the front)
-        delete m_lines[0];               // free TextLine object
-        m_lines.erase(m_lines.begin());  // ...and remove the line ptr from the vector
+        slotIndex = (m_oldestSlot + m_lineCount) % m_maxLines;
+        m_lineCount++;
+    }
+    else
+    {
+        // buffer is full, so reuse the oldest line's slot
+        slotIndex = m_oldestSlot;
+        m_oldestSlot = (m_oldestSlot + 1) % m_maxLines;
     }
-}
 
+    LineSlot &slot = m_slots[slotIndex];
+    slot.length = min(length, m_maxLineLength);
+    slot.color = color;
+    char *pDest = &m_chars[slot.offset];
+    memcpy(pDest, pText, slot.length);
+    pDest[slot.length] = 0;
+}
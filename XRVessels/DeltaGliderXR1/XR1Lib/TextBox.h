@@ -41,47 +41,34 @@ using namespace std;
 
 enum class TEXTCOLOR { Normal, Highlighted };
 
-// line of text to be added to buffer
+// line of text in a TextLineGroup
+// NOTE: text points into the owning TextLineGroup's buffer, so it is only valid until the next AddLines or Clear call.
 struct TextLine
 {
-    // Normal constructor
-    TextLine(const char *pText, TEXTCOLOR color) 
-    {
-        this->text = pText;
-        this->color = color;
-    }
-
-    // NOTE: A copy constructor is required by the 'vector' class.
-    TextLine(const TextLine &that) 
-    {
-        text = that.text;
-        color = that.color;
-    }
-
-    string text;                // text itself
+    const char *text;     // text itself; null-terminated
+    int length;           // # of characters in text, excluding the terminator
     TEXTCOLOR color;      // color of line to be rendered
-
-    bool operator=(const TextLine &that) 
-    { 
-        return ((text == that.text) && (color == that.color));
-    }
 };
 
-// Manages a group of TextLine objects; this is the primary public object for populating a TextBox
+// Manages a group of text lines; this is the primary public object for populating a TextBox.
+// Lines are stored in a fixed-size circular buffer backed by a single character array allocated once 
+// by the constructor, so adding lines never allocates memory, and discarding the oldest line is free.
 class TextLineGroup
 {
 public:
     TextLineGroup(const int maxLines);
     virtual ~TextLineGroup();
 
-    int GetLineCount() const { return static_cast<int>(m_lines.size()); }
-    void Clear() { m_lines.clear(); }
-
-    // retrives lines in buffer
-    const vector<const TextLine *> &GetLines() const { return m_lines; } 
+    int GetLineCount() const { return m_lineCount; }
+    void Clear() { m_lineCount = 0; m_oldestSlot = 0; }
 
-    // retrieves a single line from the buffer
-    const TextLine &GetLine(const int index) const { return *m_lines[index]; }
+    // retrieves a single line from the buffer; index 0 is the oldest line
+    TextLine GetLine(const int index) const
+    {
+        const LineSlot &slot = m_slots[(m_oldestSlot + index) % m_maxLines];
+        TextLine line = { &m_chars[slot.offset], slot.length, slot.color };
+        return line;
+    }
 
     // Returns how many times AddLines has been invoked; useful to determine whether
     // text has changed since the last check.
@@ -91,10 +78,22 @@ public:
     virtual void AddLines(const char *pStr, bool highlighted);
 
 protected:
-    void AddLine(const TextLine &textLine);
+    void AddLine(const char *pText, const int length, const TEXTCOLOR color);
+
+    struct LineSlot
+    {
+        int offset;         // index of the first character of this line in m_chars
+        int length;
+        TEXTCOLOR color;
+    };
+
     const int m_maxLines;
+    const int m_maxLineLength;   // longer lines are truncated; excludes the terminator
     int m_addLinesCount;   // total # of times AddLines invoked
-    vector<const TextLine *> m_lines;  // uses TextLine ptrs for 1) efficiency, and 2) so that vector.erase works
+    vector<char> m_chars;        // text for all slots; slot n begins at n * (m_maxLineLength + 1)
+    vector<LineSlot> m_slots;    // one per line in the buffer
+    int m_oldestSlot;            // index in m_slots of the oldest line
+    int m_lineCount;             // # of lines currently in the buffer
 };
 
 //-------------------------------------------------------------------------
@@ -142,27 +142,13 @@ void DoorIndicatorArea::clbkPrePostStep(const double simt, const double simdt, c
     if (*m_pDoorStatus >= DoorStatus::DOOR_CLOSING) // in transit?
     {
         m_transitColor = BRIGHT_YELLOW; 
-        const double blinkDelay = 0.75;   // blink once every 3/4-second
-        double modTime = fmod(simt, blinkDelay);
-        if (m_isTransitVisible) // "Transit" currently visible?
+        // blink once every 3/4-second; "Transit" is shown during the off half of the shared phase
+        const bool isTransitVisible = !GetVessel().GetBlinkClock().IsOn(BLINK_RATE::HZ_1_33);
+        if (isTransitVisible != m_isTransitVisible)
         {
-            // see if it's time to blank it
-            if (modTime < (blinkDelay/2))
-            {
-                // signal redraw method to leave area blank
-                m_isTransitVisible = false;   
-                TriggerRedraw();
-            }
-        }
-        else   // "Transit" currently invisible
-        {
-            // see if it's time to show it
-            if (modTime >= (blinkDelay/2))
-            {
-                // signal redraw method to repaint "Transit"
-                m_isTransitVisible = true;
-                TriggerRedraw();
-            }
+            // signal redraw method to show or blank "Transit"
+            m_isTransitVisible = isTransitVisible;
+            TriggerRedraw();
         }
     }
     else    // door not in transit
@@ -393,7 +393,7 @@ void FuelDumpButtonArea::clbkPrePostStep(const double simt, const double simdt,
     if (m_fuelDumpInProgress)
     {
         // blink the light twice a second
-        bool isLit = (fmod(simt, 0.5) < 0.25);
+        bool isLit = GetXR1().GetBlinkClock().IsOn(BLINK_RATE::HZ_2);
 
         if (isLit != m_isLit)
         {
@@ -22,6 +22,7 @@
 // must be included BEFORE XR1Areas.h
 #include "DeltaGliderXR1.h"
 #include "XR1Areas.h"
+#include "XRNumberFormat.h"
 
 //-------------------------------------------------------------------------
 
@@ -154,7 +155,7 @@ bool ThrustNumberArea::UpdateRenderData(RENDERDATA& renderData)
 
     double thrust = GetThrust();  // retrieve from subclass (in kN)
 
-    // no need to round here; sprintf will do it for us
+    // no need to round here; FormatDouble will do it for us
 
     // check whether the value has changed since the last render
     if (forceRedraw || (thrust != renderData.value))
@@ -168,22 +169,22 @@ bool ThrustNumberArea::UpdateRenderData(RENDERDATA& renderData)
         else if (thrust < 0)
             thrust = 0;       // thrust cannot be negative!
 
-        // note: pFormatStr must evaluate to exactly 7 characters for each case
-        const char* pFormatStr;
+        // note: the formatted value must be exactly 7 characters for each case
+        int decimals;
         if (thrust > 99999.9)
-            pFormatStr = "%6.0f.";
+            decimals = 0;   // "." appended below
         else if (thrust > 9999.99)
-            pFormatStr = "%5.1f";
+            decimals = 1;
         else if (thrust > 999.999)
-            pFormatStr = "%4.2f";
+            decimals = 2;
         else if (thrust > 99.9999)
-            pFormatStr = "%3.3f";
+            decimals = 3;
         else if (thrust > 9.99999)
-            pFormatStr = "%2.4f";
+            decimals = 4;
         else  // <= 9.99999
-            pFormatStr = "%1.5f";
+            decimals = 5;
 
-        sprintf(pTemp, pFormatStr, thrust);
+        XRNumberFormat::FormatDouble(pTemp, sizeof(pTemp), thrust, decimals, 6 - decimals, false, ((decimals == 0) ? "." : nullptr));
         if (forceRedraw || (strcmp(pTemp, renderData.pStrToRender) != 0))
         {
             // text has changed; signal the base class to render it
@@ -241,7 +242,7 @@ bool AccNumberArea::UpdateRenderData(RENDERDATA& renderData)
             acc = 99.999;   // trim to 2 leading digits + possible minus sign
         else if (acc < -99.999)
             acc = -99.999;
-        sprintf(pTemp, "%7.3f", acc);
+        XRNumberFormat::FormatDouble(pTemp, sizeof(pTemp), acc, 3, 7);
         if (forceRedraw || (strcmp(pTemp, renderData.pStrToRender) != 0))
         {
             // text has changed; signal the base class to render it
@@ -340,9 +341,9 @@ bool TimerNumberArea::RenderTimeValue(RENDERDATA& renderData, double time)
             value = 0;
 
         if (m_sizeInChars == 4)     // days?
-            sprintf(temp, "%4d", value);
+            XRNumberFormat::FormatInt(temp, sizeof(temp), value, 4);
         else        // hours, minutes, or seconds
-            sprintf(temp, "%02d", value);
+            XRNumberFormat::FormatInt(temp, sizeof(temp), value, 2, true);
 
         // signal the base class to render the text
         renderData.value = value;   // remember for next time
@@ -445,18 +446,21 @@ bool MassNumberArea::UpdateRenderData(RENDERDATA& renderData)
         else if (mass < 0)      // sanity-check
             mass = 0;
 
-        // Note: pFormatString must be exactly nine characters in length, with exactly one decimal.
-        char* pFormatString;
+        // Note: the formatted value must be exactly nine characters in length, with exactly one decimal.
+        int decimals;
         if (mass > 9999999.9)
-            pFormatString = "%8.0lf.";  // eight because of "." appended = nine total
+            decimals = 0;   // width is eight because of "." appended = nine total
         else if (mass > 999999.9)
-            pFormatString = "%9.1lf";   // includes the "."
+            decimals = 1;   // width includes the "."
         else if (mass > 99999.99)
-            pFormatString = "%9.2lf";
+            decimals = 2;
         else
-            pFormatString = "%9.3lf";
+            decimals = 3;
 
-        sprintf(pTemp, pFormatString, mass);
+        if (decimals == 0)
+            XRNumberFormat::FormatDouble(pTemp, sizeof(pTemp), mass, 0, 8, false, ".");
+        else
+            XRNumberFormat::FormatDouble(pTemp, sizeof(pTemp), mass, decimals, 9);
         if (forceRedraw || (strcmp(pTemp, renderData.pStrToRender) != 0))
         {
             // text has changed; signal the base class to render it
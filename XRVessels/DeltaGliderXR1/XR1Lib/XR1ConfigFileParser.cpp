@@ -63,7 +63,7 @@ XR1ConfigFileParser::XR1ConfigFileParser() :
 	CheatcodesEnabled(true), EnableParkingBrakes(true),
     // Values below here are NOT used by the XR1; there are here for subclasses
     EnableResupplyHatchAnimationsWhileDocked(true),
-    AudioCalloutVolume(255), PayloadScreensUpdateInterval(0.05),  // 20 times/second
+    AudioCalloutVolume(255), SoundCacheBudgetKB(0), PayloadScreensUpdateInterval(0.05),  // 20 times/second
     LOXConsumptionMultiplier(1.0), EnableBoilOffExhaustEffect(true)
 {
     // set callout defaults
@@ -204,6 +204,21 @@ bool XR1ConfigFileParser::ParseLine(const char *pSection, const char *pPropertyN
         else if (PNAME_MATCHES("EnableParkingBrakes"))
         {
 			SSCANF_BOOL("%c", &EnableParkingBrakes);
+        }
+        else if (PNAME_MATCHES("TelemetryMode"))
+        {
+            SSCANF1("%d", &TelemetryMode);
+            VALIDATE_INT(reinterpret_cast<int *>(&TelemetryMode), 0, 2, 0);  // OK to cast enum * to int * here
+        }
+        else if (PNAME_MATCHES("FlightDataRecorderChannels"))
+        {
+            SSCANF1("%d", &FlightDataRecorderChannels);
+            VALIDATE_INT(&FlightDataRecorderChannels, 0, 511, 0);
+        }
+        else if (PNAME_MATCHES("InactivePanelTimeout"))
+        {
+            SSCANF1("%lf", &InactivePanelTimeout);
+            VALIDATE_DOUBLE(&InactivePanelTimeout, 0, 86400, 0);
         }
 		else if (PNAME_MATCHES("CheatcodesEnabled"))
 		{
@@ -394,6 +409,11 @@ bool XR1ConfigFileParser::ParseLine(const char *pSection, const char *pPropertyN
             SSCANF1("%lf", &PanelUpdateInterval);
             VALIDATE_DOUBLE(&PanelUpdateInterval, 0, 2.0, 0.0167);
         }
+        else if (PNAME_MATCHES("PanelRedrawBudget"))
+        {
+            SSCANF1("%lf", &PanelRedrawBudget);
+            VALIDATE_DOUBLE(&PanelRedrawBudget, 0, 100.0, 0);
+        }
         else if (PNAME_MATCHES("APUFuelBurnRate"))
         {
             SSCANF1("%d", &APUFuelBurnRate);
@@ -476,6 +496,11 @@ bool XR1ConfigFileParser::ParseLine(const char *pSection, const char *pPropertyN
             SSCANF1("%d", &AudioCalloutVolume);
             VALIDATE_INT(&AudioCalloutVolume, 0, 255, 255);
         }
+        else if (PNAME_MATCHES("SoundCacheBudgetKB"))
+        {
+            SSCANF1("%d", &SoundCacheBudgetKB);
+            VALIDATE_INT(&SoundCacheBudgetKB, 0, 1048576, 0);   // max 1 GB
+        }
         else if (PNAME_MATCHES("CustomMainEngineSoundVolume"))
         {
             SSCANF1("%d", &CustomMainEngineSoundVolume);
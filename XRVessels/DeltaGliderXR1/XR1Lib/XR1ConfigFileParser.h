@@ -192,6 +192,7 @@ public:
     bool EnableCustomHoverEngineSound;
     bool EnableCustomRCSSound;
     int AudioCalloutVolume;
+    int SoundCacheBudgetKB;     // 0 = unlimited
     int CustomMainEngineSoundVolume;
     bool Lower2DPanelVerticalScrollingEnabled;
     // payload items; not used by the XR1
@@ -38,6 +38,7 @@ class FuelCalloutsPostStep : public XR1PrePostStep
 public:
     FuelCalloutsPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::DISTANT; }  // our previous fractions catch any level crossed while we were skipped
 
 protected:
     void CheckFuelLevel(const char *pLabel, PROPELLANT_HANDLE ph, double &prevQty, WarningLight warningLight);
@@ -96,17 +97,19 @@ protected:
 
 //---------------------------------------------------------------------------
 
-class FuelDumpPostStep : public XR1PrePostStep
+class FuelDumpPostStep : public XR1PrePostStep, public XRConsumables::Listener
 {
 public:
     FuelDumpPostStep(DeltaGliderXR1 &vessel);
     virtual ~FuelDumpPostStep();
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt);
 
 protected:
-    bool DumpFuel(const PROPELLANT_HANDLE ph, const double simdt, bool &dumpInProgress, const double rateFraction);
+    void AddDumpFlow(const ConsumableTank tank, const bool dumpInProgress, const double rate);
 
     double m_nextWarningSimt;   // send next warning message
+    int m_dumpFlowIDs[static_cast<int>(ConsumableTank::External)];  // indexed by tank; -1 = tank not dumping this frame
 
     PSTREAM_HANDLE m_fuelDumpStream1;
     PSTREAM_HANDLE m_fuelDumpStream2;
@@ -115,11 +118,15 @@ protected:
 
 //---------------------------------------------------------------------------
 
-class XFeedPostStep : public XR1PrePostStep
+class XFeedPostStep : public XR1PrePostStep, public XRConsumables::Listener
 {
 public:
     XFeedPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt);
+
+protected:
+    int m_flowID;   // -1 = cross-feed not flowing this frame
 };
 
 //---------------------------------------------------------------------------
@@ -148,12 +155,13 @@ protected:
 //---------------------------------------------------------------------------
 
 // NOTE: this class handles external cooling logic as well
-class ResupplyPostStep : public XR1PrePostStep
+class ResupplyPostStep : public XR1PrePostStep, public XRConsumables::Listener
 {
 public:
     ResupplyPostStep(DeltaGliderXR1 &vessel);
     virtual ~ResupplyPostStep();
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt);
 
 protected:
     void PerformRefueling(const double simt, const double simdt, const double mjd);
@@ -165,6 +173,13 @@ protected:
     void FlowScramFuel(const double simt, const double simdt, const double mjd);  // invoked only when refueling scram tanks
     void FlowApuFuel(const double simt, const double simdt, const double mjd);    // invoked only when refueling apu tanks
     void FlowLox(const double simt, const double simdt, const double mjd);        // invoked only when refueling lox tanks
+    void HaltFlow(bool &flowSwitch, const int switchAreaID, const int ledAreaID);
+
+    // consumables flow IDs for this frame; -1 = not flowing
+    int m_mainFlowID;
+    int m_scramFlowID;
+    int m_apuFlowID;
+    int m_loxFlowID;
 
     // line pressure objects
     LinePressure *m_pMainLinePressure;
@@ -192,15 +207,34 @@ protected:
 //---------------------------------------------------------------------------
 
 // Handles LOX consumption
-class LOXConsumptionPostStep : public XR1PrePostStep
+class LOXConsumptionPostStep : public XR1PrePostStep, public XRConsumables::Listener
 {
 public:
     LOXConsumptionPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt);
 
 protected:
     bool m_previousAmbientO2Available;  // from previous timestep
     double m_previousO2Level;           // cabin level
+
+    // state saved for ConsumablesIntegrated this frame
+    bool m_cabinUpdatePending;          // false = crew is dead or cabin decompressed this frame, so there is nothing to update
+    bool m_ambientO2Available;
+    bool m_loxAvailable;                // at the start of the frame
+    double m_loxConsumptionPerSecond;   // in kg; may be zero
+    int m_loxFlowID;                    // -1 = no LOX consumed this frame
+};
+
+//---------------------------------------------------------------------------
+
+// Integrates all the fuel and LOX flows registered by the preceding PostSteps and writes the tank levels back to the core once.
+// This must be added immediately after the last PostStep that registers a flow.
+class IntegrateConsumablesPostStep : public XR1PrePostStep
+{
+public:
+    IntegrateConsumablesPostStep(DeltaGliderXR1 &vessel);
+    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
 };
 
 //---------------------------------------------------------------------------
@@ -85,7 +85,7 @@ bool DeltaGliderXR1::clbkDrawHUD (int mode, const HUDPAINTSPEC *hps, oapi::Sketc
         const int markerSize = hps->Markersize;
 
         int d = markerSize/2;
-        const bool blinkOn = (fmod(GetAbsoluteSimTime(), 1.0) < 0.5);
+        const bool blinkOn = GetBlinkClock().IsOn(BLINK_RATE::HZ_1);
 
         // default to LEFT alignment
         skp->SetTextAlign(oapi::Sketchpad::LEFT);
@@ -445,7 +445,7 @@ void LoxDumpButtonArea::clbkPrePostStep(const double simt, const double simdt, c
     if (GetXR1().m_loxDumpInProgress)
     {
         // blink the light twice a second
-        bool isLit = (fmod(simt, 0.5) < 0.25);
+        bool isLit = GetXR1().GetBlinkClock().IsOn(BLINK_RATE::HZ_2);
 
         if (isLit != m_isLit)
         {
@@ -25,6 +25,7 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1MultiDisplayArea.h"
+#include "XRNumberFormat.h"
 
 //-------------------------------------------------------------------------
 
@@ -33,7 +34,7 @@
 // Constructor
 AirspeedHoldMultiDisplayMode::AirspeedHoldMultiDisplayMode(int modeNumber) :
     MultiDisplayMode(modeNumber), m_statusFont(0), m_numberFont(0), m_buttonFont(0),
-    m_backgroundSurface(0), m_mouseHoldTargetSimt(-1), m_lastAction(RATE_ACTION::ACT_NONE), m_repeatCount(0)
+    m_backgroundSurface(0), m_mouseHoldTargetSimt(-1), m_lastAction(RATE_ACTION::ACT_NONE), m_repeatCount(0), m_pWidgetLayer(nullptr)
 {
     m_engageButtonCoord.x = 6;
     m_engageButtonCoord.y = 42;
@@ -87,10 +88,22 @@ void AirspeedHoldMultiDisplayMode::Activate()
     m_statusFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // ENGAGED or DISENGAGED
     m_numberFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // set airspeed number text
     m_buttonFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // engage/disengage button text
+
+    // declare our widgets in the order in which they are painted
+    m_pWidgetLayer = new MDAWidgetLayer(*m_pParentMDA);
+    m_statusFieldID       = m_pWidgetLayer->AddTextField(m_statusFont, _COORD2(46, 24), TA_LEFT);
+    m_engageFieldID       = m_pWidgetLayer->AddTextField(m_buttonFont, _COORD2(27, 43), TA_LEFT);
+    m_airspeedFieldID     = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(48, 62), TA_LEFT);
+    m_airspeedImpFieldID  = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(48, 73), TA_LEFT);
+    m_maxAccFieldID       = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(62, 95), TA_LEFT);
+    m_thrustPctFieldID    = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(62, 84), TA_LEFT);
+    m_setAirspeedFieldID  = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(121, 48), TA_RIGHT);
 }
 
 void AirspeedHoldMultiDisplayMode::Deactivate()
 {
+    delete m_pWidgetLayer;
+    m_pWidgetLayer = nullptr;
     DestroySurface(&m_backgroundSurface);
     DeleteObject(m_statusFont);
     DeleteObject(m_numberFont);
@@ -99,18 +112,7 @@ void AirspeedHoldMultiDisplayMode::Deactivate()
 
 bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
 {
-    // Always re-render everything; it is too error-prone to try to track all values and clear any 
-    // old data underneath from the previous render.
-
-    // render the background
-    const COORD2& screenSize = GetScreenSize();
-    DeltaGliderXR1::SafeBlt(surf, m_backgroundSurface, 0, 0, 0, 0, screenSize.x, screenSize.y);
-
-    // obtain device context and save existing font
-    HDC hDC = m_pParentMDA->GetDC(surf);
-    HFONT hPrevObject = (HFONT)SelectObject(hDC, m_statusFont); // will render status text first
-    SetBkMode(hDC, TRANSPARENT);
-    SetTextAlign(hDC, TA_LEFT);     // default to LEFT alignment
+    // Push the current state of every widget to our widget layer, which repaints only the ones that changed.
 
     // render autopilot status
     const char* pStatus;        // set below
@@ -126,17 +128,12 @@ bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         pStatus = (engaged ? "ENGAGED" : "DISENGAGED");
         statusColor = (engaged ? CREF(BRIGHT_GREEN) : CREF(BRIGHT_RED));  // use CREF macro to convert to Windows' Blue, Green, Red COLORREF
     }
-    SetTextColor(hDC, statusColor);
-    TextOut(hDC, 46, 24, pStatus, static_cast<int>(strlen(pStatus)));
+    m_pWidgetLayer->SetText(m_statusFieldID, pStatus, statusColor);
 
     // render button text
-    SelectObject(hDC, m_buttonFont);
     const char* pEngageDisengage = (engaged ? "Disengage" : "Engage");
-    SetTextColor(hDC, CREF(LIGHT_BLUE));
-    TextOut(hDC, 27, 43, pEngageDisengage, static_cast<int>(strlen(pEngageDisengage)));
+    m_pWidgetLayer->SetText(m_engageFieldID, pEngageDisengage, CREF(LIGHT_BLUE));
 
-    SelectObject(hDC, m_numberFont);
-    SetTextColor(hDC, CREF(OFF_WHITE217));
     char temp[15];
 
     // airspeed 
@@ -147,8 +144,8 @@ bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         airspeed = 99999.9;
     else if (airspeed < 0)
         airspeed = 0;     // sanity-check
-    sprintf(temp, "%-.1f m/s", airspeed);
-    TextOut(hDC, 48, 62, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), airspeed, 1, XR_UNIT::METERS_PER_SEC);
+    m_pWidgetLayer->SetText(m_airspeedFieldID, temp, CREF(OFF_WHITE217));
 
     // imperial airspeed 
     double airspeedImp = XR1Area::MpsToMph(airspeed);
@@ -156,8 +153,8 @@ bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         airspeedImp = 99999.9;
     else if (airspeedImp < 0)
         airspeedImp = 0;     // sanity-check
-    sprintf(temp, "%-.1f mph", airspeedImp);
-    TextOut(hDC, 48, 73, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), airspeedImp, 1, XR_UNIT::MPH);
+    m_pWidgetLayer->SetText(m_airspeedImpFieldID, temp, CREF(OFF_WHITE217));
 
     // max main engine acc based on ship mass + atm drag
     // NOTE: this is a ROLLING AVERAGE over the last n frames to help the jumping around the Orbiter does with the acc values
@@ -167,7 +164,7 @@ bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
     if (fabs(maxMainAcc) > 99.999)        // keep in range
         sprintf(temp, "------ m/s");
     else
-        sprintf(temp, "%.3f m/s", maxMainAcc);
+        XRNumberFormat::FormatDouble(temp, sizeof(temp), maxMainAcc, 3, XR_UNIT::METERS_PER_SEC2);
     COLORREF cref;  // reused below as well
     if (maxMainAcc <= 0)
         cref = CREF(MEDB_RED);
@@ -175,13 +172,12 @@ bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         cref = CREF(BRIGHT_YELLOW);
     else
         cref = CREF(BRIGHT_GREEN);
-    SetTextColor(hDC, cref);
-    TextOut(hDC, 62, 95, temp, static_cast<int>(strlen(temp)));
+    m_pWidgetLayer->SetText(m_maxAccFieldID, temp, cref);
 
     // main thrust pct 
-    double mainThrustFrac = GetVessel().GetThrusterGroupLevel(THGROUP_MAIN);  // do not round this; sprintf will do it
+    double mainThrustFrac = GetVessel().GetThrusterGroupLevel(THGROUP_MAIN);  // do not round this; FormatDouble will do it
     double mainThrustPct = (mainThrustFrac * 100.0);
-    sprintf(temp, "%.3f%%", mainThrustPct);
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), mainThrustPct, 3, 0, false, "%");
     if (mainThrustPct >= 100)
         cref = CREF(MEDB_RED);
     else if (mainThrustPct >= 90)
@@ -189,20 +185,13 @@ bool AirspeedHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
     else
         cref = CREF(BRIGHT_GREEN);
 
-    SetTextColor(hDC, cref);
-    TextOut(hDC, 62, 84, temp, static_cast<int>(strlen(temp)));
+    m_pWidgetLayer->SetText(m_thrustPctFieldID, temp, cref);
 
     // render the set airspeed
-    sprintf(temp, "%.1lf", GetXR1().m_setAirspeed);
-    SetTextAlign(hDC, TA_RIGHT);
-    SetTextColor(hDC, CREF(LIGHT_BLUE));
-    TextOut(hDC, 121, 48, temp, static_cast<int>(strlen(temp)));
-
-    // restore previous font and release device context
-    SelectObject(hDC, hPrevObject);
-    m_pParentMDA->ReleaseDC(surf, hDC);
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetXR1().m_setAirspeed, 1);
+    m_pWidgetLayer->SetText(m_setAirspeedFieldID, temp, CREF(LIGHT_BLUE));
 
-    return true;
+    return m_pWidgetLayer->Render(event, surf, m_backgroundSurface);
 }
 
 bool AirspeedHoldMultiDisplayMode::ProcessMouseEvent(const int event, const int mx, const int my)
@@ -25,12 +25,13 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1MultiDisplayArea.h"
+#include "XRNumberFormat.h"
 
 //-------------------------------------------------------------------------
 
 AttitudeHoldMultiDisplayMode::AttitudeHoldMultiDisplayMode(int modeNumber) :
     MultiDisplayMode(modeNumber),
-    m_backgroundSurface(0), m_mouseHoldTargetSimt(-1), m_lastAction(AXIS_ACTION::ACT_NONE), m_repeatCount(0)
+    m_backgroundSurface(0), m_mouseHoldTargetSimt(-1), m_lastAction(AXIS_ACTION::ACT_NONE), m_repeatCount(0), m_pWidgetLayer(nullptr)
 {
     m_engageButtonCoord.x = 6;
     m_engageButtonCoord.y = 42;
@@ -79,10 +80,24 @@ void AttitudeHoldMultiDisplayMode::Activate()
     m_numberFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // bank/pitch number text
     m_buttonFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // engage/disengage button text
     m_aoaPitchFont = CreateFont(10, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Arial");  // "Hold Pitch", "Hold AOA" text
+
+    // declare our widgets in the order in which they are painted
+    m_pWidgetLayer = new MDAWidgetLayer(*m_pParentMDA);
+    m_statusFieldID        = m_pWidgetLayer->AddTextField(m_statusFont, _COORD2(46, 24), TA_LEFT);
+    m_setPitchLabelFieldID = m_pWidgetLayer->AddTextField(m_aoaPitchFont, _COORD2(165, 26), TA_RIGHT);
+    m_engageFieldID        = m_pWidgetLayer->AddTextField(m_buttonFont, _COORD2(27, 43), TA_LEFT);
+    m_pitchFieldID         = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(31, 61), TA_LEFT);
+    m_bankFieldID          = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(31, 72), TA_LEFT);
+    m_aoaFieldID           = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(98, 61), TA_LEFT);
+    m_zeroLabelFieldID     = m_pWidgetLayer->AddTextField(m_aoaPitchFont, _COORD2(18, 86), TA_LEFT);
+    m_setPitchFieldID      = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(143, 41), TA_RIGHT);
+    m_setBankFieldID       = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(151, 83), TA_CENTER);
 }
 
 void AttitudeHoldMultiDisplayMode::Deactivate()
 {
+    delete m_pWidgetLayer;
+    m_pWidgetLayer = nullptr;
     DestroySurface(&m_backgroundSurface);
     DeleteObject(m_statusFont);
     DeleteObject(m_numberFont);
@@ -92,21 +107,10 @@ void AttitudeHoldMultiDisplayMode::Deactivate()
 
 bool AttitudeHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
 {
-    // Always re-render everything; it is too error-prone to try to track all values and clear any 
-    // old data underneath from the previous render.
+    // Push the current state of every widget to our widget layer, which repaints only the ones that changed.
 
     const bool holdAOA = GetXR1().m_holdAOA;        // for convenience
 
-    // render the background
-    const COORD2& screenSize = GetScreenSize();
-    DeltaGliderXR1::SafeBlt(surf, m_backgroundSurface, 0, 0, 0, 0, screenSize.x, screenSize.y);
-
-    // obtain device context and save existing font
-    HDC hDC = m_pParentMDA->GetDC(surf);
-    HFONT hPrevObject = (HFONT)SelectObject(hDC, m_statusFont); // will render status text first
-    SetBkMode(hDC, TRANSPARENT);
-    SetTextAlign(hDC, TA_LEFT);     // default to LEFT alignment
-
     // render autopilot status
     const char* pStatus;        // set below
     COLORREF statusColor;
@@ -121,60 +125,39 @@ bool AttitudeHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         pStatus = (engaged ? "ENGAGED" : "DISENGAGED");
         statusColor = (engaged ? CREF(BRIGHT_GREEN) : CREF(BRIGHT_RED));  // use CREF macro to convert to Windows' Blue, Green, Red COLORREF
     }
-    SetTextColor(hDC, statusColor);
-    TextOut(hDC, 46, 24, pStatus, static_cast<int>(strlen(pStatus)));
+    m_pWidgetLayer->SetText(m_statusFieldID, pStatus, statusColor);
 
     // render "Set Pitch" or "Set AOA" text
-    SelectObject(hDC, m_aoaPitchFont);
-    SetTextAlign(hDC, TA_RIGHT);     // RIGHT alignment
     const char* pSetText = (holdAOA ? "SET AOA" : "SET PITCH");
-    SetTextColor(hDC, CREF((holdAOA ? BRIGHT_YELLOW : BRIGHT_GREEN)));
-    TextOut(hDC, 165, 26, pSetText, static_cast<int>(strlen(pSetText)));
-    SetTextAlign(hDC, TA_LEFT);     // restore to default to LEFT alignment
+    m_pWidgetLayer->SetText(m_setPitchLabelFieldID, pSetText, CREF((holdAOA ? BRIGHT_YELLOW : BRIGHT_GREEN)));
 
     // render button text
-    SelectObject(hDC, m_buttonFont);
     const char* pEngageDisengage = (engaged ? "Disengage" : "Engage");
-    SetTextColor(hDC, CREF(LIGHT_BLUE));
-    TextOut(hDC, 27, 43, pEngageDisengage, static_cast<int>(strlen(pEngageDisengage)));
+    m_pWidgetLayer->SetText(m_engageFieldID, pEngageDisengage, CREF(LIGHT_BLUE));
 
     // render ship's current pitch, bank, and AOA
-    SelectObject(hDC, m_numberFont);
-    SetTextColor(hDC, CREF(OFF_WHITE217));
     char temp[15];
-    sprintf(temp, "%+7.2f", GetVessel().GetPitch() * DEG);
-    TextOut(hDC, 31, 61, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetVessel().GetPitch() * DEG, 2, 7, true, XRNumberFormat::GetUnitSuffix(XR_UNIT::DEGREES));
+    m_pWidgetLayer->SetText(m_pitchFieldID, temp, CREF(OFF_WHITE217));
 
-    sprintf(temp, "%+7.2f", GetVessel().GetBank() * DEG);
-    TextOut(hDC, 31, 72, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetVessel().GetBank() * DEG, 2, 7, true, XRNumberFormat::GetUnitSuffix(XR_UNIT::DEGREES));
+    m_pWidgetLayer->SetText(m_bankFieldID, temp, CREF(OFF_WHITE217));
 
-    sprintf(temp, "%+7.2f", GetVessel().GetAOA() * DEG);
-    TextOut(hDC, 98, 61, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetVessel().GetAOA() * DEG, 2, 7, true, XRNumberFormat::GetUnitSuffix(XR_UNIT::DEGREES));
+    m_pWidgetLayer->SetText(m_aoaFieldID, temp, CREF(OFF_WHITE217));
 
     // render "ZERO PITCH" or "ZERO AOA"
-    SelectObject(hDC, m_aoaPitchFont);
     const char* pZeroText = (holdAOA ? "ZERO AOA" : "ZERO PITCH");
-    SetTextColor(hDC, CREF((holdAOA ? BRIGHT_YELLOW : BRIGHT_GREEN)));
-    TextOut(hDC, 18, 86, pZeroText, static_cast<int>(strlen(pZeroText)));
+    m_pWidgetLayer->SetText(m_zeroLabelFieldID, pZeroText, CREF((holdAOA ? BRIGHT_YELLOW : BRIGHT_GREEN)));
 
     // render SET pitch/aoa and bank values; these values will be limited to +-90 degrees at the most
-    SelectObject(hDC, m_numberFont);
-
-    SetTextAlign(hDC, TA_RIGHT);
-    SetTextColor(hDC, engaged ? CREF((holdAOA ? BRIGHT_YELLOW : BRIGHT_GREEN)) : CREF(LIGHT_BLUE));
-    sprintf(temp, "%+5.1f", GetXR1().m_setPitchOrAOA);  // already in degrees
-    TextOut(hDC, 143, 41, temp, static_cast<int>(strlen(temp)));
-
-    SetTextAlign(hDC, TA_CENTER);
-    SetTextColor(hDC, engaged ? CREF(BRIGHT_GREEN) : CREF(LIGHT_BLUE));
-    sprintf(temp, "%+5.1f", GetXR1().m_setBank);  // already in degrees
-    TextOut(hDC, 151, 83, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetXR1().m_setPitchOrAOA, 1, 5, true, XRNumberFormat::GetUnitSuffix(XR_UNIT::DEGREES));  // already in degrees
+    m_pWidgetLayer->SetText(m_setPitchFieldID, temp, engaged ? CREF((holdAOA ? BRIGHT_YELLOW : BRIGHT_GREEN)) : CREF(LIGHT_BLUE));
 
-    // restore previous font and release device context
-    SelectObject(hDC, hPrevObject);
-    m_pParentMDA->ReleaseDC(surf, hDC);
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetXR1().m_setBank, 1, 5, true, XRNumberFormat::GetUnitSuffix(XR_UNIT::DEGREES));  // already in degrees
+    m_pWidgetLayer->SetText(m_setBankFieldID, temp, engaged ? CREF(BRIGHT_GREEN) : CREF(LIGHT_BLUE));
 
-    return true;
+    return m_pWidgetLayer->Render(event, surf, m_backgroundSurface);
 }
 
 bool AttitudeHoldMultiDisplayMode::ProcessMouseEvent(const int event, const int mx, const int my)
@@ -25,13 +25,14 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1MultiDisplayArea.h"
+#include "XRNumberFormat.h"
 
 //-------------------------------------------------------------------------
 
 // Constructor
 DescentHoldMultiDisplayMode::DescentHoldMultiDisplayMode(int modeNumber) :
     MultiDisplayMode(modeNumber),
-    m_backgroundSurface(0), m_mouseHoldTargetSimt(-1), m_lastAction(RATE_ACTION::ACT_NONE), m_repeatCount(0)
+    m_backgroundSurface(0), m_mouseHoldTargetSimt(-1), m_lastAction(RATE_ACTION::ACT_NONE), m_repeatCount(0), m_pWidgetLayer(nullptr)
 {
     m_engageButtonCoord.x = 6;
     m_engageButtonCoord.y = 42;
@@ -71,10 +72,22 @@ void DescentHoldMultiDisplayMode::Activate()
     m_statusFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // ENGAGED or DISENGAGED
     m_numberFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // bank/pitch number text
     m_buttonFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");  // engage/disengage button text
+
+    // declare our widgets in the order in which they are painted
+    m_pWidgetLayer = new MDAWidgetLayer(*m_pParentMDA);
+    m_statusFieldID      = m_pWidgetLayer->AddTextField(m_statusFont, _COORD2(46, 24), TA_LEFT);
+    m_engageFieldID      = m_pWidgetLayer->AddTextField(m_buttonFont, _COORD2(27, 43), TA_LEFT);
+    m_vertSpeedFieldID   = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(49, 62), TA_LEFT);
+    m_altitudeFieldID    = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(49, 73), TA_LEFT);
+    m_maxAccFieldID      = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(61, 95), TA_LEFT);
+    m_thrustPctFieldID   = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(61, 84), TA_LEFT);
+    m_setRateFieldID     = m_pWidgetLayer->AddTextField(m_numberFont, _COORD2(121, 48), TA_RIGHT);
 }
 
 void DescentHoldMultiDisplayMode::Deactivate()
 {
+    delete m_pWidgetLayer;
+    m_pWidgetLayer = nullptr;
     DestroySurface(&m_backgroundSurface);
     DeleteObject(m_statusFont);
     DeleteObject(m_numberFont);
@@ -83,18 +96,7 @@ void DescentHoldMultiDisplayMode::Deactivate()
 
 bool DescentHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
 {
-    // Always re-render everything; it is too error-prone to try to track all values and clear any 
-    // old data underneath from the previous render.
-
-    // render the background
-    const COORD2& screenSize = GetScreenSize();
-    DeltaGliderXR1::SafeBlt(surf, m_backgroundSurface, 0, 0, 0, 0, screenSize.x, screenSize.y);
-
-    // obtain device context and save existing font
-    HDC hDC = m_pParentMDA->GetDC(surf);
-    HFONT hPrevObject = (HFONT)SelectObject(hDC, m_statusFont); // will render status text first
-    SetBkMode(hDC, TRANSPARENT);
-    SetTextAlign(hDC, TA_LEFT);     // default to LEFT alignment
+    // Push the current state of every widget to our widget layer, which repaints only the ones that changed.
 
     // render autopilot status
     const char* pStatus;        // set below
@@ -117,17 +119,12 @@ bool DescentHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE sur
             statusColor = CREF(BRIGHT_YELLOW);
         }
     }
-    SetTextColor(hDC, statusColor);
-    TextOut(hDC, 46, 24, pStatus, static_cast<int>(strlen(pStatus)));
+    m_pWidgetLayer->SetText(m_statusFieldID, pStatus, statusColor);
 
     // render button text
-    SelectObject(hDC, m_buttonFont);
     const char* pEngageDisengage = (engaged ? "Disengage" : "Engage");
-    SetTextColor(hDC, CREF(LIGHT_BLUE));
-    TextOut(hDC, 27, 43, pEngageDisengage, static_cast<int>(strlen(pEngageDisengage)));
+    m_pWidgetLayer->SetText(m_engageFieldID, pEngageDisengage, CREF(LIGHT_BLUE));
 
-    SelectObject(hDC, m_numberFont);
-    SetTextColor(hDC, CREF(OFF_WHITE217));
     char temp[15];
 
     // vertical speed
@@ -140,8 +137,8 @@ bool DescentHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE sur
         vs = 999.99;
     else if (vs < -999.99)
         vs = -999.99;
-    sprintf(temp, "%-+7.2f", vs);
-    TextOut(hDC, 49, 62, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), vs, 2, -7, true);   // left-justified
+    m_pWidgetLayer->SetText(m_vertSpeedFieldID, temp, CREF(OFF_WHITE217));
 
     // altitude
     double alt = GetXR1().GetGearFullyUncompressedAltitude();   // adjust for gear down and/or GroundContact
@@ -150,15 +147,15 @@ bool DescentHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE sur
         alt = 999999.9;
     else if (alt < -999999.9)
         alt = -999999.9;
-    sprintf(temp, "%-8.1f", alt);
-    TextOut(hDC, 49, 73, temp, static_cast<int>(strlen(temp)));
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), alt, 1, -8);   // left-justified
+    m_pWidgetLayer->SetText(m_altitudeFieldID, temp, CREF(OFF_WHITE217));
 
     // max hover engine acc based on ship mass
     const double maxHoverAcc = GetXR1().m_maxShipHoverAcc;
     if (fabs(maxHoverAcc) > 99.999)        // keep in range
         sprintf(temp, "------ m/s");
     else
-        sprintf(temp, "%.3f m/s", maxHoverAcc);
+        XRNumberFormat::FormatDouble(temp, sizeof(temp), maxHoverAcc, 3, XR_UNIT::METERS_PER_SEC2);
 
     COLORREF cref;  // reused later as well
     if (maxHoverAcc <= 0)
@@ -167,13 +164,12 @@ bool DescentHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE sur
         cref = CREF(BRIGHT_YELLOW);
     else
         cref = CREF(BRIGHT_GREEN);
-    SetTextColor(hDC, cref);
-    TextOut(hDC, 61, 95, temp, static_cast<int>(strlen(temp)));
+    m_pWidgetLayer->SetText(m_maxAccFieldID, temp, cref);
 
     // hover thrurst pct 
-    double hoverThrustFrac = GetVessel().GetThrusterGroupLevel(THGROUP_HOVER);  // do not round this; sprintf will do it
+    double hoverThrustFrac = GetVessel().GetThrusterGroupLevel(THGROUP_HOVER);  // do not round this; FormatDouble will do it
     double hoverThrustPct = (hoverThrustFrac * 100.0);
-    sprintf(temp, "%.3f%%", hoverThrustPct);
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), hoverThrustPct, 3, 0, false, "%");
     if (hoverThrustPct >= 100)
         cref = CREF(MEDB_RED);
     else if (hoverThrustPct >= 90)
@@ -181,20 +177,13 @@ bool DescentHoldMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE sur
     else
         cref = CREF(BRIGHT_GREEN);
 
-    SetTextColor(hDC, cref);
-    TextOut(hDC, 61, 84, temp, static_cast<int>(strlen(temp)));
+    m_pWidgetLayer->SetText(m_thrustPctFieldID, temp, cref);
 
     // render the set ascent or descent rate
-    sprintf(temp, "%+.1f", GetXR1().m_setDescentRate);
-    SetTextAlign(hDC, TA_RIGHT);
-    SetTextColor(hDC, CREF(LIGHT_BLUE));
-    TextOut(hDC, 121, 48, temp, static_cast<int>(strlen(temp)));
-
-    // restore previous font and release device context
-    SelectObject(hDC, hPrevObject);
-    m_pParentMDA->ReleaseDC(surf, hDC);
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), GetXR1().m_setDescentRate, 1, 0, true);
+    m_pWidgetLayer->SetText(m_setRateFieldID, temp, CREF(LIGHT_BLUE));
 
-    return true;
+    return m_pWidgetLayer->Render(event, surf, m_backgroundSurface);
 }
 
 bool DescentHoldMultiDisplayMode::ProcessMouseEvent(const int event, const int mx, const int my)
@@ -25,6 +25,7 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1MultiDisplayArea.h"
+#include "XRNumberFormat.h"
 
 // Note: as of D3D9 RC23 there is no difference in framerate between sketchpad and GetDC on this 
 // MDA area. In addition, the font control isn't quite as precise under sketchpad (FF_MODERN fonts looks a lot
@@ -33,7 +34,7 @@
 // Constructor
 HullTempsMultiDisplayMode::HullTempsMultiDisplayMode(int modeNumber) :
     MultiDisplayMode(modeNumber),
-    m_backgroundSurface(0), m_indicatorSurface(0)
+    m_backgroundSurface(0), m_indicatorSurface(0), m_pWidgetLayer(nullptr)
 {
     m_kfcButtonCoord.x = 24;
     m_kfcButtonCoord.y = 25;
@@ -47,10 +48,26 @@ void HullTempsMultiDisplayMode::Activate()
 
     m_pKfcFont = CreateFont(14, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");
     m_pCoolantFont = CreateFont(12, 0, 0, 0, 600, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");
+
+    // declare our widgets; the gauge indicators only ever move vertically
+    m_pWidgetLayer = new MDAWidgetLayer(*m_pParentMDA);
+    m_hullTempIndicatorID    = m_pWidgetLayer->AddIndicator(m_indicatorSurface, _COORD2(0, 0), 6, 7);
+    m_coolantTempIndicatorID = m_pWidgetLayer->AddIndicator(m_indicatorSurface, _COORD2(6, 0), 6, 7);
+
+    m_kfcFieldID       = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(35, 22), TA_LEFT);
+    m_extFieldID       = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(142, 36), TA_CENTER);
+    m_noseconeFieldID  = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(91, 22), TA_CENTER);
+    m_leftWingFieldID  = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(65, 57), TA_RIGHT);
+    m_rightWingFieldID = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(119, 57), TA_LEFT);
+    m_cockpitFieldID   = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(78, 38), TA_RIGHT);
+    m_topHullFieldID   = m_pWidgetLayer->AddTextField(m_pKfcFont, _COORD2(91, 75), TA_CENTER);
+    m_coolantFieldID   = m_pWidgetLayer->AddTextField(m_pCoolantFont, _COORD2(134, 82), TA_LEFT);
 }
 
 void HullTempsMultiDisplayMode::Deactivate()
 {
+    delete m_pWidgetLayer;
+    m_pWidgetLayer = nullptr;
     DestroySurface(&m_backgroundSurface);
     DestroySurface(&m_indicatorSurface);
     DeleteObject(m_pKfcFont);
@@ -59,17 +76,7 @@ void HullTempsMultiDisplayMode::Deactivate()
 
 bool HullTempsMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
 {
-    // Always re-render everything; it is too error-prone to try to track all values and clear any 
-    // old data underneath from the previous render.
-
-    // 
-    // Render the graphics
-    // NOTE: must render these BEFORE any text, or the graphics will not paint because of the SelectObject call.
-    //
-
-    // render the background
-    const COORD2& screenSize = GetScreenSize();
-    DeltaGliderXR1::SafeBlt(surf, m_backgroundSurface, 0, 0, 0, 0, screenSize.x, screenSize.y);
+    // Push the current state of every widget to our widget layer, which repaints only the ones that changed.
 
     // detect the highest temperature percentage of all surfaces
     double highestTempFrac = GetHighestTempFrac();  // max percentage of any hull temperature to its limit
@@ -81,8 +88,7 @@ bool HullTempsMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
     int maxIndex = 83;   // total height = 84 pixels (index 0-83, inclusive)
     int index = static_cast<int>((maxIndex * highestTempFrac) + 0.5);  // round to nearest pixel
     int tgtY = 102 - index;   // center-3 pixels
-    //      tgt,  src,                tgtx,tgty,srcx,srcy,w,h, <use predefined color key>
-    DeltaGliderXR1::SafeBlt(surf, m_indicatorSurface, 8, tgtY, 0, 0, 6, 7, SURF_PREDEF_CK);
+    m_pWidgetLayer->SetIndicatorCoord(m_hullTempIndicatorID, 8, tgtY);
 
     // Render the coolant temperature gauge
     // round to nearest pixel
@@ -98,24 +104,13 @@ bool HullTempsMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
     maxIndex = 72;      // 0-72 inclusive
     index = static_cast<int>((maxIndex * frac) + 0.5);
     tgtY = 91 - index;   // center-3 pixels
-    //      tgt,  src,                tgtx,tgty,srcx,srcy,w,h, <use predefined color key>
-    DeltaGliderXR1::SafeBlt(surf, m_indicatorSurface, 165, tgtY, 6, 0, 6, 7, SURF_PREDEF_CK);
+    m_pWidgetLayer->SetIndicatorCoord(m_coolantTempIndicatorID, 165, tgtY);
 
     // 
-    // Now draw the text
+    // Now the text fields
     //
 
-    // NOTE: according to jarmonik invoking oapiClearSurface before a GetDC improves performance on the D3D9 client,
-    // but unfortunately we can't do that here since we are rendering on top of a background that we blitted.
-
-    // obtain device context and save existing font
-    HDC hDC = m_pParentMDA->GetDC(surf);
-    HFONT hPrevObject = (HFONT)SelectObject(hDC, m_pKfcFont);
-
-    // render our K/F/C button temp label if necessary
-    SetBkMode(hDC, TRANSPARENT);
-    SetTextColor(hDC, CREF(LIGHT_BLUE));  // use CREF macro to convert to Windows' Blue, Green, Red COLORREF
-    SetTextAlign(hDC, TA_LEFT);
+    // K/F/C button temp label
     char* pScale;
     if (GetXR1().m_activeTempScale == TempScale::Kelvin)
         pScale = "K";
@@ -124,61 +119,41 @@ bool HullTempsMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
     else
         pScale = "F";
 
-    TextOut(hDC, 35, 22, pScale, static_cast<int>(strlen(pScale)));
+    m_pWidgetLayer->SetText(m_kfcFieldID, pScale, CREF(LIGHT_BLUE));  // use CREF macro to convert to Windows' Blue, Green, Red COLORREF
 
     char tempStr[12];   // temperature string; reused for each temperature; includes 1 extra char
 
     // EXT 
-    SetTextColor(hDC, CREF(OFF_WHITE192));
-    SetTextAlign(hDC, TA_CENTER);
     GetTemperatureStr(GetXR1().GetExternalTemperature(), tempStr);
-    TextOut(hDC, 142, 36, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_extFieldID, tempStr, CREF(OFF_WHITE192));
 
     const HullTemperatureLimits& limits = GetXR1().m_hullTemperatureLimits;
 
     // NOSECONE 
-    SetTextColor(hDC, GetTempCREF(GetXR1().m_noseconeTemp, limits.noseCone, GetNoseDoorStatus()));
-    SetTextAlign(hDC, TA_CENTER);
     GetTemperatureStr(GetXR1().m_noseconeTemp, tempStr);
-    TextOut(hDC, 91, 22, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_noseconeFieldID, tempStr, GetTempCREF(GetXR1().m_noseconeTemp, limits.noseCone, GetNoseDoorStatus()));
 
     // LEFT WING
-    const int wingY = 57;
-    SetTextColor(hDC, GetTempCREF(GetXR1().m_leftWingTemp, limits.wings, GetLeftWingDoorStatus()));
-    SetTextAlign(hDC, TA_RIGHT);
     GetTemperatureStr(GetXR1().m_leftWingTemp, tempStr);
-    TextOut(hDC, 65, wingY, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_leftWingFieldID, tempStr, GetTempCREF(GetXR1().m_leftWingTemp, limits.wings, GetLeftWingDoorStatus()));
 
     // RIGHT WING
-    SetTextColor(hDC, GetTempCREF(GetXR1().m_rightWingTemp, limits.wings, GetRightWingDoorStatus()));
-    SetTextAlign(hDC, TA_LEFT);
     GetTemperatureStr(GetXR1().m_rightWingTemp, tempStr);
-    TextOut(hDC, 119, wingY, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_rightWingFieldID, tempStr, GetTempCREF(GetXR1().m_rightWingTemp, limits.wings, GetRightWingDoorStatus()));
 
     // COCKPIT
-    SetTextColor(hDC, GetTempCREF(GetXR1().m_cockpitTemp, limits.cockpit, GetCockpitDoorStatus()));
-    SetTextAlign(hDC, TA_RIGHT);
     GetTemperatureStr(GetXR1().m_cockpitTemp, tempStr);
-    TextOut(hDC, 78, 38, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_cockpitFieldID, tempStr, GetTempCREF(GetXR1().m_cockpitTemp, limits.cockpit, GetCockpitDoorStatus()));
 
     // TOP HULL
-    SetTextColor(hDC, GetTempCREF(GetXR1().m_topHullTemp, limits.topHull, GetTopHullDoorStatus()));
-    SetTextAlign(hDC, TA_CENTER);
     GetTemperatureStr(GetXR1().m_topHullTemp, tempStr);
-    TextOut(hDC, 91, 75, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_topHullFieldID, tempStr, GetTempCREF(GetXR1().m_topHullTemp, limits.topHull, GetTopHullDoorStatus()));
 
     // COOL (coolant temperature)
-    SelectObject(hDC, m_pCoolantFont);       // use smaller font
-    SetTextColor(hDC, GetValueCREF(coolantTemp, WARN_COOLANT_TEMP, CRITICAL_COOLANT_TEMP));  // do not round value
-    SetTextAlign(hDC, TA_LEFT);
     GetCoolantTemperatureStr(coolantTemp, tempStr);
-    TextOut(hDC, 134, 82, tempStr, static_cast<int>(strlen(tempStr)));
+    m_pWidgetLayer->SetText(m_coolantFieldID, tempStr, GetValueCREF(coolantTemp, WARN_COOLANT_TEMP, CRITICAL_COOLANT_TEMP));  // do not round value
 
-    // restore previous font and release device context
-    SelectObject(hDC, hPrevObject);
-    m_pParentMDA->ReleaseDC(surf, hDC);
-
-    return true;
+    return m_pWidgetLayer->Render(event, surf, m_backgroundSurface);
 }
 #else // SKETCHPAD INTERFACE
 
@@ -392,8 +367,8 @@ void HullTempsMultiDisplayMode::GetCoolantTemperatureStr(double tempC, char* pSt
         tempConverted = -99.9;
 
     // Do not round the value!  We need to match the warning PostStep exactly, and rounding up makes us arrive early.
-    // HOWEVER: NOTE THAT sprintf will round the value!
-    sprintf(pStrOut, "%.1lf", tempConverted);
+    // HOWEVER: NOTE THAT FormatDouble will round the value!
+    XRNumberFormat::FormatDouble(pStrOut, 7, tempConverted, 1, XR_UNIT::DEGREES);
 }
 
 // convert temperature in K to a displayable string 
@@ -428,7 +403,7 @@ void HullTempsMultiDisplayMode::GetTemperatureStr(double tempK, char* pStrOut)
 
     // Do not round the value!  We want to match the damage code exactly (although it is technically not critical), and rounding up makes us arrive early.
 
-    sprintf(pStrOut, "%.1lf", tempConverted);
+    XRNumberFormat::FormatDouble(pStrOut, 11, tempConverted, 1, XR_UNIT::DEGREES);
 }
 
 bool HullTempsMultiDisplayMode::ProcessMouseEvent(const int event, const int mx, const int my)
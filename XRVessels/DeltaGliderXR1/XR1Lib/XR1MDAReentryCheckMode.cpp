@@ -31,7 +31,7 @@
 // Constructor
 ReentryCheckMultiDisplayMode::ReentryCheckMultiDisplayMode(int modeNumber) :
     MultiDisplayMode(modeNumber),
-    m_backgroundSurface(0), m_prevReentryCheckStatus(true)
+    m_backgroundSurface(0), m_prevReentryCheckStatus(true), m_pWidgetLayer(nullptr)
 {
     // NOTE: cannot accesss parent XR1 object yet because we have not yet been attached to a parent MDA object.
     // Therefore, one-time initialization that requires the our XR1 object will be done in OnParentAttach() below.
@@ -68,6 +68,18 @@ void ReentryCheckMultiDisplayMode::Activate()
     m_backgroundSurface = CreateSurface(IDB_REENTRY_CHECK_MULTI_DISPLAY);
     m_mainFont = CreateFont(12, 0, 0, 0, 700, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");
 
+    // declare our widgets: one line per door plus the overall status line
+    m_pWidgetLayer = new MDAWidgetLayer(*m_pParentMDA);
+    m_doorFieldIDs.clear();
+    const COORD2 startingCoords = GetStartingCoords();
+    int y = startingCoords.y;
+    for (int i = 0; i < GetDoorCount(); i++)
+    {
+        m_doorFieldIDs.push_back(m_pWidgetLayer->AddTextField(m_mainFont, _COORD2(startingCoords.x, y), TA_LEFT));
+        y += GetLinePitch();
+    }
+    m_statusLineFieldID = m_pWidgetLayer->AddTextField(m_mainFont, GetStatusLineCoords(), TA_CENTER);
+
     // check doors and issue correct callout here
     int openDoorCount = 0;
     for (int i = 0; i < GetDoorCount(); i++)
@@ -81,6 +93,8 @@ void ReentryCheckMultiDisplayMode::Activate()
 
 void ReentryCheckMultiDisplayMode::Deactivate()
 {
+    delete m_pWidgetLayer;
+    m_pWidgetLayer = nullptr;
     DestroySurface(&m_backgroundSurface);
     DeleteObject(m_mainFont);
 }
@@ -112,21 +126,7 @@ void ReentryCheckMultiDisplayMode::PlayStatusCallout(const int openDoorCount)
 
 bool ReentryCheckMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
 {
-    // render the background
-    const COORD2& screenSize = GetScreenSize();
-    DeltaGliderXR1::SafeBlt(surf, m_backgroundSurface, 0, 0, 0, 0, screenSize.x, screenSize.y);
-
-    // obtain device context and save existing font
-    HDC hDC = m_pParentMDA->GetDC(surf);
-    HFONT hPrevObject = (HFONT)SelectObject(hDC, m_mainFont);
-
-    SetBkMode(hDC, TRANSPARENT);
-    SetTextAlign(hDC, TA_LEFT);
-
-    // set starting coordinates 
-    COORD2 startingCoords = GetStartingCoords();
-    int x = startingCoords.x;
-    int y = startingCoords.y;
+    // Push the current state of every widget to our widget layer, which repaints only the ones that changed.
 
     // loop through and render each door's status
     int openDoorCount = 0;
@@ -160,21 +160,13 @@ bool ReentryCheckMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         case DoorStatus::DOOR_CLOSING:
             textColor = CREF(BRIGHT_YELLOW);
             pStatus = "In Transit";
-            const double simt = GetAbsoluteSimTime();
-            renderStatus = (fmod(simt, 0.75) < 0.375);  // blink once every 3/4-second
+            renderStatus = GetXR1().GetBlinkClock().IsOn(BLINK_RATE::HZ_1_33);  // blink once every 3/4-second
             openDoorCount++;
             break;
         }
 
         // render the door status if requested
-        if (renderStatus)
-        {
-            SetTextColor(hDC, textColor);
-            TextOut(hDC, x, y, pStatus, static_cast<int>(strlen(pStatus))); // "Left Wing", etc.
-        }
-
-        // drop to next line
-        y += GetLinePitch();
+        m_pWidgetLayer->SetText(m_doorFieldIDs[i], (renderStatus ? pStatus : ""), textColor);
     }
 
     // now render overall status on the bottom line
@@ -194,17 +186,8 @@ bool ReentryCheckMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
         textColor = CREF(BRIGHT_GREEN);
     }
 
-    if (renderStatus)
-    {
-        SetTextAlign(hDC, TA_CENTER);
-        SetTextColor(hDC, textColor);
-        COORD2 c = GetStatusLineCoords();
-        TextOut(hDC, c.x, c.y, pStatus, static_cast<int>(strlen(pStatus)));
-    }
-
-    // restore previous font and release device context
-    SelectObject(hDC, hPrevObject);
-    m_pParentMDA->ReleaseDC(surf, hDC);
+    m_pWidgetLayer->SetText(m_statusLineFieldID, (renderStatus ? pStatus : ""), textColor);
+    const bool redraw = m_pWidgetLayer->Render(event, surf, m_backgroundSurface);
 
     // play sound if our status changed from previous loop
     bool status = (openDoorCount == 0);     // true = OK
@@ -214,7 +197,7 @@ bool ReentryCheckMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE su
     // save status for next frame
     m_prevReentryCheckStatus = status;
 
-    return true;
+    return redraw;
 }
 
 bool ReentryCheckMultiDisplayMode::ProcessMouseEvent(const int event, const int mx, const int my)
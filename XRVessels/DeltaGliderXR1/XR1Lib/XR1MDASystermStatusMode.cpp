@@ -30,7 +30,7 @@
 // Constructor
 SystemsStatusMultiDisplayMode::SystemsStatusMultiDisplayMode(int modeNumber) :
     MultiDisplayMode(modeNumber),
-    m_backgroundSurface(0)
+    m_backgroundSurface(0), m_pWidgetLayer(nullptr)
 {
     m_screenIndex = modeNumber - MDMID_SYSTEMS_STATUS1;   // index 0...n
 }
@@ -44,52 +44,53 @@ void SystemsStatusMultiDisplayMode::Activate()
     m_backgroundSurface = CreateSurface(resourceIDs[m_screenIndex]);
     m_mainFont = CreateFont(14, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, FF_MODERN, "Microsoft Sans Serif");
     m_fontPitch = 11;
+
+    // set starting coordinates 
+    int x = 5;
+    int y = 20;
+    int statusX = 136;  // "OK", "OFFLINE", "32%", etc.
+
+    m_pWidgetLayer = new MDAWidgetLayer(*m_pParentMDA);
+    for (int i = 0; i < LINES_PER_SCREEN; i++)
+    {
+        m_labelFieldIDs[i] = m_pWidgetLayer->AddTextField(m_mainFont, _COORD2(x, y), TA_LEFT);   // "Left Wing:", etc.
+        m_statusFieldIDs[i] = m_pWidgetLayer->AddTextField(m_mainFont, _COORD2(statusX, y), TA_LEFT);
+
+        // drop to next line
+        y += m_fontPitch;
+    }
 }
 
 void SystemsStatusMultiDisplayMode::Deactivate()
 {
+    delete m_pWidgetLayer;
+    m_pWidgetLayer = nullptr;
     DestroySurface(&m_backgroundSurface);
     DeleteObject(m_mainFont);
 }
 
 bool SystemsStatusMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE surf)
 {
-    // render the background
-    const COORD2& screenSize = GetScreenSize();
-    DeltaGliderXR1::SafeBlt(surf, m_backgroundSurface, 0, 0, 0, 0, screenSize.x, screenSize.y);
-
-    // obtain device context and save existing font
-    HDC hDC = m_pParentMDA->GetDC(surf);
-    HFONT hPrevObject = (HFONT)SelectObject(hDC, m_mainFont);
-
-    SetBkMode(hDC, TRANSPARENT);
-    SetTextAlign(hDC, TA_LEFT);
-
-    // set starting coordinates 
-    int x = 5;
-    int y = 20;
-    int statusX = 136;  // "OK", "OFFLINE", "32%", etc.
-
-    static const int linesPerScreen = 7;
-    DamageItem start = static_cast<DamageItem>(static_cast<int>(DamageItem::LeftWing) + (m_screenIndex * linesPerScreen));
+    DamageItem start = static_cast<DamageItem>(static_cast<int>(DamageItem::LeftWing) + (m_screenIndex * LINES_PER_SCREEN));
     char temp[64];
-    for (int i = 0; i < linesPerScreen; i++)
+    for (int i = 0; i < LINES_PER_SCREEN; i++)
     {
         DamageItem damageItem = static_cast<DamageItem>(static_cast<int>(start) + i);
         if (damageItem > D_END)
-            break;  // no more items
+            break;  // no more items; these fields remain empty
 
         DamageStatus damageStatus = GetXR1().GetDamageStatus(damageItem);
 
         double integrity = damageStatus.fracIntegrity;
 
+        COLORREF color;
         if (integrity == 1.0)
-            SetTextColor(hDC, CREF(MEDIUM_GREEN));
+            color = CREF(MEDIUM_GREEN);
         else
-            SetTextColor(hDC, CREF(BRIGHT_RED));
+            color = CREF(BRIGHT_RED);
 
         sprintf(temp, "%s:", damageStatus.label);
-        TextOut(hDC, x, y, temp, static_cast<int>(strlen(temp))); // "Left Wing", etc.
+        m_pWidgetLayer->SetText(m_labelFieldIDs[i], temp, color); // "Left Wing", etc.
 
         if (damageStatus.onlineOffline)
         {
@@ -103,15 +104,9 @@ bool SystemsStatusMultiDisplayMode::Redraw2D(const int event, const SURFHANDLE s
             sprintf(temp, "%d%%", static_cast<int>(integrity * 100));
         }
 
-        TextOut(hDC, statusX, y, temp, static_cast<int>(strlen(temp)));
-
-        // drop to next line
-        y += m_fontPitch;
+        m_pWidgetLayer->SetText(m_statusFieldIDs[i], temp, color);
     }
 
-    // restore previous font and release device context
-    SelectObject(hDC, hPrevObject);
-    m_pParentMDA->ReleaseDC(surf, hDC);
-
-    return true;
+    // repaint only the lines that changed
+    return m_pWidgetLayer->Render(event, surf, m_backgroundSurface);
 }
@@ -0,0 +1,326 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1MDAWidgetLayer.cpp
+// Retained-mode rendering for MultiDisplayMode screens
+// ==============================================================
+
+#include "DeltaGliderXR1.h"
+#include "XR1MultiDisplayArea.h"
+#include "XR1MDAWidgetLayer.h"
+
+// Constructor
+// parentMDA = MDA whose screen we render
+MDAWidgetLayer::MDAWidgetLayer(MultiDisplayArea &parentMDA) :
+    m_parentMDA(parentMDA), m_fullRepaintRequired(true)
+{
+    m_hMeasureDC = CreateCompatibleDC(0);
+}
+
+// Destructor
+MDAWidgetLayer::~MDAWidgetLayer()
+{
+    DeleteDC(m_hMeasureDC);
+}
+
+// Declare a color-keyed indicator blitted from srcSurface; its target coordinates are set via SetIndicatorCoord.
+// Returns: indicator ID
+int MDAWidgetLayer::AddIndicator(const SURFHANDLE srcSurface, const COORD2 srcCoord, const int width, const int height)
+{
+    Indicator indicator;
+    indicator.srcSurface = srcSurface;
+    indicator.srcCoord = srcCoord;
+    indicator.width = width;
+    indicator.height = height;
+    indicator.coord = indicator.drawnCoord = _COORD2(0, 0);
+    indicator.isDirty = true;
+    m_indicators.push_back(indicator);
+
+    m_fullRepaintRequired = true;
+    return static_cast<int>(m_indicators.size()) - 1;
+}
+
+// Declare a text field; its extent on the screen is measured from the font each time its text changes.
+// coord, textAlign = passed to TextOut and SetTextAlign as-is; only top alignment is supported
+// Returns: field ID
+int MDAWidgetLayer::AddTextField(const HFONT font, const COORD2 coord, const UINT textAlign)
+{
+    TextField field;
+    field.font = font;
+    field.coord = coord;
+    field.textAlign = textAlign;
+
+    *field.text = *field.drawnText = 0;
+    field.color = field.drawnColor = 0;
+    field.box = field.drawnBox = MeasureText(field, field.text);
+    field.isDirty = true;
+    m_textFields.push_back(field);
+
+    m_fullRepaintRequired = true;
+    return static_cast<int>(m_textFields.size()) - 1;
+}
+
+void MDAWidgetLayer::SetIndicatorCoord(const int indicatorID, const int x, const int y)
+{
+    Indicator &indicator = m_indicators[indicatorID];
+    indicator.coord.x = x;
+    indicator.coord.y = y;
+}
+
+void MDAWidgetLayer::SetText(const int fieldID, const char *pText, const COLORREF color)
+{
+    TextField &field = m_textFields[fieldID];
+    strncpy(field.text, pText, MAX_TEXT_LENGTH);
+    field.text[MAX_TEXT_LENGTH] = 0;
+    field.color = color;
+}
+
+// Repaint any widgets whose values changed since the last render.
+// event = Orbiter event flags; PANEL_REDRAW_INIT repaints the entire screen
+// surf = MDA screen surface
+// backgroundSurface = the mode's screen background
+// Returns: true if anything was repainted, false if the screen is unchanged
+bool MDAWidgetLayer::Render(const int event, const SURFHANDLE surf, const SURFHANDLE backgroundSurface)
+{
+    if (event == PANEL_REDRAW_INIT)
+        m_fullRepaintRequired = true;   // our previous render is gone
+
+    m_dirtyRegion.clear();
+    if (m_fullRepaintRequired)
+    {
+        const COORD2 &screenSize = m_parentMDA.GetScreenSize();
+        const Box screenBox = { 0, 0, screenSize.x, screenSize.y };
+        AddDirtyBox(screenBox);
+
+        for (auto it = m_indicators.begin(); it != m_indicators.end(); it++)
+            it->isDirty = true;
+        for (auto it = m_textFields.begin(); it != m_textFields.end(); it++)
+        {
+            it->box = MeasureText(*it, it->text);
+            it->isDirty = true;
+        }
+
+        m_fullRepaintRequired = false;
+    }
+    else
+    {
+        // clear the old image of each changed widget and repaint it at its new state
+        for (auto it = m_indicators.begin(); it != m_indicators.end(); it++)
+        {
+            it->isDirty = ((it->coord.x != it->drawnCoord.x) || (it->coord.y != it->drawnCoord.y));
+            if (it->isDirty)
+            {
+                AddDirtyBox(GetIndicatorBox(it->drawnCoord, *it));
+                AddDirtyBox(GetIndicatorBox(it->coord, *it));
+            }
+        }
+
+        for (auto it = m_textFields.begin(); it != m_textFields.end(); it++)
+        {
+            it->isDirty = (it->color != it->drawnColor);
+            if (strcmp(it->text, it->drawnText) != 0)
+            {
+                it->box = MeasureText(*it, it->text);
+                it->isDirty = true;
+            }
+
+            if (it->isDirty)
+            {
+                AddDirtyBox(it->drawnBox);
+                AddDirtyBox(it->box);
+            }
+        }
+
+        if (m_dirtyRegion.empty())
+            return false;   // nothing changed
+
+        // Any unchanged widget that overlaps the restored region must be repainted in full; otherwise part
+        // of it would be erased, and we cannot simply redraw it on top of itself because anti-aliased text
+        // blends with the pixels underneath it.  Since that extends the region, repeat until no more widgets join.
+        bool regionGrew;
+        do
+        {
+            regionGrew = false;
+            for (auto it = m_indicators.begin(); it != m_indicators.end(); it++)
+            {
+                const Box box = GetIndicatorBox(it->coord, *it);
+                if (!it->isDirty && IntersectsDirtyRegion(box))
+                {
+                    it->isDirty = true;
+                    AddDirtyBox(box);
+                    regionGrew = true;
+                }
+            }
+
+            for (auto it = m_textFields.begin(); it != m_textFields.end(); it++)
+            {
+                if (!it->isDirty && IntersectsDirtyRegion(it->box))
+                {
+                    it->isDirty = true;
+                    AddDirtyBox(it->box);
+                    regionGrew = true;
+                }
+            }
+        } while (regionGrew);
+    }
+
+    // restore the background under the dirty region
+    for (auto it = m_dirtyRegion.begin(); it != m_dirtyRegion.end(); it++)
+        DeltaGliderXR1::SafeBlt(surf, backgroundSurface, it->left, it->top, it->left, it->top, it->right - it->left, it->bottom - it->top);
+
+    RepaintDirtyWidgets(surf);
+    return true;
+}
+
+// Paint all dirty widgets in declaration order, indicators first.
+void MDAWidgetLayer::RepaintDirtyWidgets(const SURFHANDLE surf)
+{
+    // NOTE: must render these BEFORE any text, or the graphics will not paint because of the SelectObject call.
+    for (auto it = m_indicators.begin(); it != m_indicators.end(); it++)
+    {
+        if (it->isDirty)
+        {
+            //      tgt,  src,          tgtx,        tgty,        srcx,           srcy,           w,         h,          <use predefined color key>
+            DeltaGliderXR1::SafeBlt(surf, it->srcSurface, it->coord.x, it->coord.y, it->srcCoord.x, it->srcCoord.y, it->width, it->height, SURF_PREDEF_CK);
+            it->drawnCoord = it->coord;
+            it->isDirty = false;
+        }
+    }
+
+    // only obtain a device context if we have text to draw; that is the most expensive part of an MDA render
+    HDC hDC = 0;
+    HFONT hPrevObject = 0;
+    HFONT hCurrentFont = 0;
+    for (auto it = m_textFields.begin(); it != m_textFields.end(); it++)
+    {
+        if (!it->isDirty)
+            continue;
+
+        it->drawnBox = it->box;     // also covers fields that are now empty
+        if (*it->text == 0)
+        {
+            *it->drawnText = 0;
+            it->drawnColor = it->color;
+            it->isDirty = false;
+            continue;   // nothing to draw
+        }
+
+        if (hDC == 0)
+        {
+            hDC = m_parentMDA.GetDC(surf);
+            hPrevObject = (HFONT)SelectObject(hDC, it->font);
+            hCurrentFont = it->font;
+            SetBkMode(hDC, TRANSPARENT);
+        }
+        else if (it->font != hCurrentFont)
+        {
+            SelectObject(hDC, it->font);
+            hCurrentFont = it->font;
+        }
+
+        SetTextColor(hDC, it->color);
+        SetTextAlign(hDC, it->textAlign);
+        TextOut(hDC, it->coord.x, it->coord.y, it->text, static_cast<int>(strlen(it->text)));
+
+        strcpy(it->drawnText, it->text);
+        it->drawnColor = it->color;
+        it->isDirty = false;
+    }
+
+    // restore previous font and release device context
+    if (hDC != 0)
+    {
+        SelectObject(hDC, hPrevObject);
+        m_parentMDA.ReleaseDC(surf, hDC);
+    }
+}
+
+MDAWidgetLayer::Box MDAWidgetLayer::GetIndicatorBox(const COORD2 &coord, const Indicator &indicator) const
+{
+    const Box box = { coord.x, coord.y, coord.x + indicator.width, coord.y + indicator.height };
+    return ClipToScreen(box);
+}
+
+// Compute the screen extent of the specified text as TextOut would render it for this field.
+// The box is widened by the font's overhang plus one pixel on each side for anti-aliased edges.
+MDAWidgetLayer::Box MDAWidgetLayer::MeasureText(const TextField &field, const char *pText) const
+{
+    const int len = static_cast<int>(strlen(pText));
+    if (len == 0)
+    {
+        const Box emptyBox = { field.coord.x, field.coord.y, field.coord.x, field.coord.y };
+        return emptyBox;
+    }
+
+    const HFONT hPrevFont = (HFONT)SelectObject(m_hMeasureDC, field.font);
+    SIZE size;
+    GetTextExtentPoint32(m_hMeasureDC, pText, len, &size);
+    TEXTMETRIC tm;
+    GetTextMetrics(m_hMeasureDC, &tm);
+    SelectObject(m_hMeasureDC, hPrevFont);
+
+    const int width = static_cast<int>(size.cx + tm.tmOverhang);
+    const int height = static_cast<int>(max(size.cy, tm.tmHeight));
+
+    // Note: TA_CENTER includes the TA_RIGHT bit, so we must compare the whole horizontal alignment value.
+    const UINT horizontalAlign = (field.textAlign & TA_CENTER);
+    int left;
+    if (horizontalAlign == TA_CENTER)
+        left = field.coord.x - static_cast<int>(size.cx / 2);
+    else if (horizontalAlign == TA_RIGHT)
+        left = field.coord.x - static_cast<int>(size.cx);
+    else    // TA_LEFT
+        left = field.coord.x;
+
+    const Box box = { left - 1, field.coord.y, left + width + 1, field.coord.y + height };
+    return ClipToScreen(box);
+}
+
+MDAWidgetLayer::Box MDAWidgetLayer::ClipToScreen(const Box &box) const
+{
+    const COORD2 &screenSize = m_parentMDA.GetScreenSize();
+    Box clipped = box;
+    clipped.left = max(clipped.left, 0);
+    clipped.top = max(clipped.top, 0);
+    clipped.right = min(clipped.right, screenSize.x);
+    clipped.bottom = min(clipped.bottom, screenSize.y);
+    return clipped;
+}
+
+bool MDAWidgetLayer::IntersectsDirtyRegion(const Box &box) const
+{
+    for (auto it = m_dirtyRegion.begin(); it != m_dirtyRegion.end(); it++)
+    {
+        if (it->Intersects(box))
+            return true;
+    }
+    return false;
+}
+
+void MDAWidgetLayer::AddDirtyBox(const Box &box)
+{
+    if (!box.IsEmpty())
+        m_dirtyRegion.push_back(box);
+}
@@ -0,0 +1,111 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1MDAWidgetLayer.h
+// Retained-mode rendering for MultiDisplayMode screens: a mode declares its
+// indicators and text fields once when it is activated, pushes their current
+// values on each redraw, and the layer repaints only the regions whose
+// contents actually changed.
+//
+// Indicators are bounded by their bitmap size, and text fields by the extent of
+// their current string as measured from the field's font metrics.
+// When a widget changes, its old and new boxes are restored from the background
+// surface, and any other widget whose box touches a restored region is
+// repainted as well (and its own box is restored first), so the final image is
+// identical to what a full background + all-widgets render would produce.
+// As with the existing modes, all indicators are drawn before any text.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include "vessel3ext.h"
+
+class MultiDisplayArea;
+
+class MDAWidgetLayer
+{
+public:
+    MDAWidgetLayer(MultiDisplayArea &parentMDA);
+    virtual ~MDAWidgetLayer();
+
+    // Widget declaration; construct the layer in your mode's Activate method and declare its widgets once
+    // the fonts and surfaces they use are created.  Each returns the ID of the new widget.
+    int AddIndicator(const SURFHANDLE srcSurface, const COORD2 srcCoord, const int width, const int height);
+    int AddTextField(const HFONT font, const COORD2 coord, const UINT textAlign);
+
+    // Value updates; these are cheap and only record the new state
+    void SetIndicatorCoord(const int indicatorID, const int x, const int y);
+    void SetText(const int fieldID, const char *pText, const COLORREF color);
+
+    bool Render(const int event, const SURFHANDLE surf, const SURFHANDLE backgroundSurface);
+
+protected:
+    struct Box
+    {
+        int left, top, right, bottom;   // right and bottom are exclusive
+        bool Intersects(const Box &b) const { return ((left < b.right) && (b.left < right) && (top < b.bottom) && (b.top < bottom)); }
+        bool IsEmpty() const { return ((right <= left) || (bottom <= top)); }
+    };
+
+    struct Indicator
+    {
+        SURFHANDLE srcSurface;
+        COORD2 srcCoord;
+        int width, height;
+        COORD2 coord;           // desired target coordinates
+        COORD2 drawnCoord;      // target coordinates at the last render
+        bool isDirty;
+    };
+
+    static const int MAX_TEXT_LENGTH = 63;  // excluding the terminator
+    struct TextField
+    {
+        HFONT font;
+        COORD2 coord;
+        UINT textAlign;
+        char text[MAX_TEXT_LENGTH + 1];
+        COLORREF color;
+        char drawnText[MAX_TEXT_LENGTH + 1];
+        COLORREF drawnColor;
+        Box box;                // extent of text on the screen; measured when the text changes
+        Box drawnBox;           // extent of drawnText on the screen
+        bool isDirty;
+    };
+
+    Box GetIndicatorBox(const COORD2 &coord, const Indicator &indicator) const;
+    Box MeasureText(const TextField &field, const char *pText) const;
+    Box ClipToScreen(const Box &box) const;
+    bool IntersectsDirtyRegion(const Box &box) const;
+    void AddDirtyBox(const Box &box);
+    void RepaintDirtyWidgets(const SURFHANDLE surf);
+
+    MultiDisplayArea &m_parentMDA;
+    vector<Indicator> m_indicators;
+    vector<TextField> m_textFields;
+    vector<Box> m_dirtyRegion;          // reused on each render
+    HDC m_hMeasureDC;                   // memory DC used to measure text without touching the screen surface
+    bool m_fullRepaintRequired;
+};
@@ -757,8 +757,7 @@ void MWSTestButtonArea::ProcessButtonAction(int event, double buttonDownSimt)
 //----------------------------------------------------------------------------------
 
 WarningLightsArea::WarningLightsArea(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID) :
-    XR1Area(parentPanel, panelCoordinates, areaID),
-    m_lightStateOn(false)
+    XR1Area(parentPanel, panelCoordinates, areaID)
 {
 }
 
@@ -767,10 +766,13 @@ void WarningLightsArea::Activate()
     Area::Activate();  // invoke superclass method
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(78, 77), PANEL_REDRAW_USER, PANEL_MOUSE_IGNORE, PANEL_MAP_BACKGROUND);
     m_mainSurface = CreateSurface(IDB_WARNING_LIGHTS);
+    SubscribeToBlinkClock(BLINK_RATE::HZ_1);   // we repaint only when the blink state changes
 }
 
 bool WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
 {
+    const bool lightStateOn = GetVessel().GetBlinkClock().IsOn(BLINK_RATE::HZ_1);
+
     // if TEST button pressed, all lights stay on regardless
     bool testModeActive = GetXR1().m_mwsTestActive;
 
@@ -780,9 +782,9 @@ bool WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
         bool warningActive = GetXR1().m_warningLights[i];
 
         // light is ON if 1) test mode, or 2) warning is active and blink state is ON
-        if (testModeActive || (warningActive && m_lightStateOn))
+        if (testModeActive || (warningActive && lightStateOn))
         {
-            if (m_lightStateOn || testModeActive)
+            if (lightStateOn || testModeActive)
             {
                 // render the "lit up" texture
                 int x = (i % 3) * 26;    // column
@@ -797,21 +799,6 @@ bool WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
     return true;
 }
 
-void WarningLightsArea::clbkPrePostStep(const double simt, const double simdt, const double mjd) 
-{
-    double di;
-    // NOTE: must use fabs simt here since simt may be negative!
-    bool lightStateOn = (modf(simt, &di) < 0.5);   // blink twice a second
-    if (lightStateOn != m_lightStateOn)  // has state switched?
-    {
-        // toggle the state and request a repaint
-        m_lightStateOn = lightStateOn;
-        TriggerRedraw();
-
-        // no sound with these lights
-    }
-}
-
 //----------------------------------------------------------------------------------
 
 DeployRadiatorButtonArea::DeployRadiatorButtonArea(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID) :
@@ -862,7 +849,7 @@ void DeployRadiatorButtonArea::clbkPrePostStep(const double simt, const double s
     if (ds == DoorStatus::DOOR_OPEN)
         m_lightState = true;
     else if ((ds == DoorStatus::DOOR_OPENING) || (ds == DoorStatus::DOOR_CLOSING))
-        m_lightState = (fmod(simt, 0.75) < 0.375);  // blink once every 3/4-second
+        m_lightState = GetVessel().GetBlinkClock().IsOn(BLINK_RATE::HZ_1_33);  // blink once every 3/4-second
     else  // door closed or FAILED
         m_lightState = false;
 }
@@ -921,12 +921,11 @@ void APUButton::clbkPrePostStep(const double simt, const double simdt, const dou
     // if startup or shutdown in progress, blink light rapidly
     if ((doorStatus == DoorStatus::DOOR_OPENING) || (doorStatus == DoorStatus::DOOR_CLOSING))
     {
-        isLit = (fmod(simt, 0.5) < 0.25);  // blink twice a second to show startup/shutdown mode
+        isLit = GetXR1().GetBlinkClock().IsOn(BLINK_RATE::HZ_2);  // blink twice a second to show startup/shutdown mode
     }
     else if (GetXR1().m_apuWarning)  // if warning active, set the blink state
     {
-        double di;
-        isLit = (modf(simt, &di) < 0.5);   // blink in sync w/MWS light in case MWS is flashing
+        isLit = GetXR1().GetBlinkClock().IsOn(BLINK_RATE::HZ_1);   // blink in sync w/MWS light in case MWS is flashing
     }
     else    // normal operation
     {
@@ -244,8 +244,13 @@ bool MultiDisplayArea::Redraw2D(const int event, const SURFHANDLE surf)
         return false;   // screen is currently off and was already blanked
     }
 
+    // If we blanked the screen underneath the active mode (e.g., systems failure), the mode must repaint everything
+    // instead of just what changed since its last render.
+    const int modeEvent = (m_screenBlanked ? PANEL_REDRAW_INIT : event);
+    m_screenBlanked = false;
+
     // screen is active; pass the redraw command down the the active mode handler
-    bool redraw = m_pActiveDisplayMode->Redraw2D(event, surf);
+    bool redraw = m_pActiveDisplayMode->Redraw2D(modeEvent, surf);
 
     return redraw;
 }
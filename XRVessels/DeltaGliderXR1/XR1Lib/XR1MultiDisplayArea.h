@@ -34,6 +34,7 @@
 #include "Area.h"
 #include "XR1Areas.h"
 #include "RollingArray.h"
+#include "XR1MDAWidgetLayer.h"
 
 class MultiDisplayMode;
 class DeltaGliderXR1;
@@ -160,6 +161,11 @@ protected:
     SURFHANDLE m_indicatorSurface;
     COORD2 m_kfcButtonCoord;
 
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    int m_hullTempIndicatorID, m_coolantTempIndicatorID;
+    int m_kfcFieldID, m_extFieldID, m_noseconeFieldID, m_leftWingFieldID, m_rightWingFieldID, m_cockpitFieldID, m_topHullFieldID, m_coolantFieldID;
+
     // fonts
     // Note: as of D3D9 RC23 there is no difference in framerate between sketchpad and GetDC on this 
     // MDA area. In addition, the font control isn't quite as precise under sketchpad (FF_MODERN fonts looks a lot
@@ -186,10 +192,17 @@ public:
     virtual bool Redraw2D(const int event, const SURFHANDLE surf);
 
 protected:
+    static const int LINES_PER_SCREEN = 7;
+
     SURFHANDLE m_backgroundSurface;   // main screen background
     int m_fontPitch;
     int m_screenIndex;    // 0-n; this is the status screen index
 
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    int m_labelFieldIDs[LINES_PER_SCREEN];
+    int m_statusFieldIDs[LINES_PER_SCREEN];
+
     // fonts
     HFONT m_mainFont;
 };
@@ -232,6 +245,11 @@ protected:
     double m_mouseHoldTargetSimt;  // simt at which next mouse click occurs
     AXIS_ACTION m_lastAction; // last axis change made
     int m_repeatCount;        // # of repeats this press (hold)
+
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    int m_statusFieldID, m_setPitchLabelFieldID, m_engageFieldID, m_pitchFieldID, m_bankFieldID, m_aoaFieldID;
+    int m_zeroLabelFieldID, m_setPitchFieldID, m_setBankFieldID;
     
     // fonts
     HFONT m_statusFont;
@@ -270,6 +288,10 @@ protected:
     double m_mouseHoldTargetSimt;  // simt at which next mouse click occurs
     RATE_ACTION m_lastAction;      // last rate change made
     int m_repeatCount;             // # of repeats this press (hold)
+
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    int m_statusFieldID, m_engageFieldID, m_vertSpeedFieldID, m_altitudeFieldID, m_maxAccFieldID, m_thrustPctFieldID, m_setRateFieldID;
     
     // fonts
     HFONT m_statusFont;
@@ -312,6 +334,10 @@ protected:
     int m_repeatCount;             // # of repeats this press (hold)
 
     RollingArray *m_pMaxMainAccRollingArray;  // smooths out the jumpy ACC values computed from the Orbiter core's force vectors
+
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    int m_statusFieldID, m_engageFieldID, m_airspeedFieldID, m_airspeedImpFieldID, m_maxAccFieldID, m_thrustPctFieldID, m_setAirspeedFieldID;
     
     // fonts
     HFONT m_statusFont;
@@ -367,6 +393,11 @@ protected:
     DoorInfo **m_pDoorInfo;             // one per door on screen
     bool m_prevReentryCheckStatus;      // check from previous render; true = OK
 
+    // widgets on our screen; these are only valid while we are active
+    MDAWidgetLayer *m_pWidgetLayer;
+    vector<int> m_doorFieldIDs;         // one per door, in display order
+    int m_statusLineFieldID;
+
     // subclass hooks
     virtual COORD2 GetStartingCoords()   { return _COORD2(85, 23); }  // text lines rendered here
     virtual COORD2 GetStatusLineCoords() { return _COORD2(80, 95); }  // "Reentry Check: ..."
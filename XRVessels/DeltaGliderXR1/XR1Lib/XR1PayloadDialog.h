@@ -49,6 +49,8 @@ protected:
     static INT_PTR CALLBACK Proc(HWND hDlg, UINT uMsg, WPARAM wParam, LPARAM lParam);  // message handler
     static void UpdateMassValues(HWND hDlg, const DeltaGliderXR1 &xr1);
     static void UpdatePayloadFields(HWND hDlg, const char *pClassname);
+    static void UpdateThumbnail(HWND hDlg, const XRPayloadClassData &pd);
+    static void ReleaseThumbnail(HWND hDlg);
     static bool ProcessSlotButtonMsg(HWND hDlg, const int slotNumber, const HWND hButton, const WORD notificationMsg);
 
     static bool AddPayloadToSlot(const int slotNumber, HWND hDlg, HWND hButton);
@@ -33,6 +33,7 @@
 #include "DeltaGliderXR1.h"
 #include "XR1PayloadScreenAreas.h"
 #include "XRPayloadBaySlot.h"
+#include "XRNumberFormat.h"
 
 //----------------------------------------------------------------------------------
 
@@ -73,7 +74,7 @@ void DeployPayloadArea::Activate()
     Area::Activate();  // invoke superclass method
     // register area
     // specify both PANEL_REDRAW_ALWAYS and PANEL_REDRAW_MOUSE because we need explicit mouse events
-    // Note that refresh rates are managed above us by clbkPanelRedrawEvent.
+    // Note that refresh rates are managed above us by GetAreaRedrawInterval.
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(s_screenSize.x, s_screenSize.y), 
         PANEL_REDRAW_ALWAYS | PANEL_REDRAW_MOUSE, 
         PANEL_MOUSE_LBDOWN | PANEL_MOUSE_LBPRESSED | PANEL_MOUSE_LBUP, 
@@ -137,7 +138,7 @@ bool DeployPayloadArea::Redraw2D(const int event, const SURFHANDLE surf)
 
         // MASS
         textY += pitch;
-        sprintf(msg, "%.2f kg", pChildVessel->GetMass());
+        XRNumberFormat::FormatDouble(msg, sizeof(msg), pChildVessel->GetMass(), 2, XR_UNIT::KG);
         TextOut(hDC, 39, textY, msg, static_cast<int>(strlen(msg)));
 
         // DIMENSIONS
@@ -201,7 +202,7 @@ bool DeployPayloadArea::Redraw2D(const int event, const SURFHANDLE surf)
     }
     else    // in orbit; always allow Delta-V to be set regardless of whether cargo is selected.
     {
-        sprintf(msg, "%+.1f", GetXR1().m_deployDeltaV);
+        XRNumberFormat::FormatDouble(msg, sizeof(msg), GetXR1().m_deployDeltaV, 1, 0, true);
         SetTextColor(hDC, CREF(LIGHT_BLUE));  // use CREF macro to convert to Windows' Blue, Green, Red COLORREF
         SetTextAlign(hDC, TA_RIGHT);
         TextOut(hDC, 87, 96, msg, static_cast<int>(strlen(msg)));
@@ -398,7 +399,8 @@ bool DeployPayloadArea::ProcessMouseEvent(const int event, const int mx, const i
 // idbPayloadThumbnailNone = resource ID
 PayloadThumbnailArea::PayloadThumbnailArea(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID, const int idbPayloadThumbnailNone) :
     XR1Area(parentPanel, panelCoordinates, areaID),
-    m_hNoneSurface(nullptr), m_idbPayloadThumbnailNone(idbPayloadThumbnailNone)
+    m_hNoneSurface(nullptr), m_idbPayloadThumbnailNone(idbPayloadThumbnailNone),
+    m_pLastRenderedPayloadThumbnailPCD(nullptr), m_hLastRenderedThumbnail(nullptr)
 {
 }
 
@@ -406,7 +408,7 @@ void PayloadThumbnailArea::Activate()
 {
     Area::Activate();  // invoke superclass method
     // register area
-    // Note that refresh rates are managed above us by clbkPanelRedrawEvent.
+    // Note that refresh rates are managed above us by GetAreaRedrawInterval.
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(s_screenSize.x, s_screenSize.y), PANEL_REDRAW_ALWAYS, PANEL_MAP_BGONREQUEST);
 
     m_hNoneSurface = CreateSurface(m_idbPayloadThumbnailNone);  // "none" screen
@@ -456,12 +458,14 @@ bool PayloadThumbnailArea::Redraw2D(const int event, const SURFHANDLE surf)
 
     const XRPayloadClassData *pChildVesselPCD = ((pVesselForThumbnail != nullptr) ? &XRPayloadClassData::GetXRPayloadClassDataForClassname(pVesselForThumbnail->GetClassName()) : nullptr);
 
+    // The thumbnail is loaded in the background on first access, so the default thumbnail is returned until it is ready.
+    const HBITMAP hThumb = ((pChildVesselPCD != nullptr) ? pChildVesselPCD->GetThumbnailBitmapHandle() : nullptr);  // may be null
+
     // render the screen if it has changed since the last render OR if this is the inital render
-    if ((pChildVesselPCD != m_pLastRenderedPayloadThumbnailPCD) || (event == PANEL_REDRAW_INIT))
+    if ((pChildVesselPCD != m_pLastRenderedPayloadThumbnailPCD) || (hThumb != m_hLastRenderedThumbnail) || (event == PANEL_REDRAW_INIT))
     {
         if (pChildVesselPCD != nullptr)
         {
-            const HBITMAP hThumb = pChildVesselPCD->GetThumbnailBitmapHandle();  // may be null, but normally should not be
             if (hThumb == nullptr)
             {
                 // render a black screen so the user knows his thumbnail path is invalid
@@ -490,6 +494,7 @@ bool PayloadThumbnailArea::Redraw2D(const int event, const SURFHANDLE surf)
 
         // save the PCD of the last rendered bitmap image; may be null
         m_pLastRenderedPayloadThumbnailPCD = pChildVesselPCD;
+        m_hLastRenderedThumbnail = hThumb;
         
         retVal = true;
     }
@@ -519,7 +524,7 @@ void GrapplePayloadArea::Activate()
     Area::Activate();  // invoke superclass method
     // register areaD
     // specify both PANEL_REDRAW_ALWAYS and PANEL_REDRAW_MOUSE because we need explicit mouse events
-    // Note that refresh rates are managed above us by clbkPanelRedrawEvent.
+    // Note that refresh rates are managed above us by GetAreaRedrawInterval.
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(s_screenSize.x, s_screenSize.y), PANEL_REDRAW_ALWAYS | PANEL_REDRAW_MOUSE, PANEL_MOUSE_LBDOWN, PANEL_MAP_BGONREQUEST);
 
     m_hSurface = CreateSurface(m_idbGrapplePayload);
@@ -581,14 +586,14 @@ bool GrapplePayloadArea::Redraw2D(const int event, const SURFHANDLE surf)
 
         // MASS
         textY += pitch;
-        sprintf(msg, "%.2f kg", pTargetVessel->GetMass());
+        XRNumberFormat::FormatDouble(msg, sizeof(msg), pTargetVessel->GetMass(), 2, XR_UNIT::KG);
         TextOut(hDC, 39, textY, msg, static_cast<int>(strlen(msg)));
 
         // DISTANCE
         textY += pitch;
         const double distance = pGrappleTargetVessel->GetDistance(); 
         const double grappleRangeLimit = GetXR1().GetPayloadGrappleRangeLimit();
-        sprintf(msg, "%.1f m", distance);
+        XRNumberFormat::FormatDouble(msg, sizeof(msg), distance, 1, XR_UNIT::METERS);
         // render color depending on whether the target is in grapple range 
         DWORD dwColor;
         if (distance > grappleRangeLimit)
@@ -605,7 +610,7 @@ bool GrapplePayloadArea::Redraw2D(const int event, const SURFHANDLE surf)
         // DELTA-V
         textY += pitch;
         const double deltaV = pGrappleTargetVessel->GetDeltaV();
-        sprintf(msg, "%.2f m/s", deltaV);
+        XRNumberFormat::FormatDouble(msg, sizeof(msg), deltaV, 2, XR_UNIT::METERS_PER_SEC);
         // render color depending on whether the target is in delta-V range
         if (fabs(deltaV) > PAYLOAD_GRAPPLE_MAX_DELTAV)
             dwColor = LIGHT_RED;     // out-of-range
@@ -704,7 +709,7 @@ bool GrapplePayloadArea::Redraw2D(const int event, const SURFHANDLE surf)
     SetTextColor(hDC, CREF(LIGHT_YELLOW));  // revert to default color
 
     // RANGE
-    sprintf(msg, "%.0f m", range);    // e.g., "500 m"
+    XRNumberFormat::FormatDouble(msg, sizeof(msg), range, 0, XR_UNIT::METERS);    // e.g., "500 m"
     TextOut(hDC, 84, 98, msg, static_cast<int>(strlen(msg)));
 
     // target X of Y
@@ -812,7 +817,7 @@ PayloadMassNumberArea::PayloadMassNumberArea(InstrumentPanel &parentPanel, const
 
 double PayloadMassNumberArea::GetMassInKG() 
 { 
-    return GetXR1().GetPayloadMass();
+    return GetXR1().GetCachedPayloadMass();    // updated each frame by UpdateMassPostStep
 }
 
 //----------------------------------------------------------------------------------
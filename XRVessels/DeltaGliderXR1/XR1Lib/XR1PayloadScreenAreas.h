@@ -92,6 +92,7 @@ protected:
 
     SURFHANDLE m_hNoneSurface;
     const XRPayloadClassData *m_pLastRenderedPayloadThumbnailPCD;  // indicates which payload icon rendered on the screen
+    HBITMAP m_hLastRenderedThumbnail;   // thumbnails are decoded in the background, so the bitmap for a given PCD may change
 };
 
 //----------------------------------------------------------------------------------
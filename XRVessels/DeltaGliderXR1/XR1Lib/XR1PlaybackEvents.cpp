@@ -0,0 +1,330 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1PlaybackEvents.cpp
+// Playback event table, plus the DeltaGliderXR1 methods that register,
+// record, and replay XR events.
+// ==============================================================
+
+#include "DeltaGliderXR1.h"
+#include "XR1PlaybackEvents.h"
+#include "XRFlightDataRecorder.h"   // for XRFDR_OUTPUT_FOLDER
+#include <ctype.h>
+
+// Orbiter event value strings, indexed by XR_EVENT_VALUE; NONE is written as "." since Orbiter event values may not be empty
+static const char *s_valueNames[] = { ".", "OPEN", "CLOSE", "UP", "DOWN", "ON", "OFF", "MAIN", "RCS", "ATTITUDEHOLD", "DESCENTHOLD" };
+static_assert((sizeof(s_valueNames) / sizeof(const char *)) == static_cast<int>(XR_EVENT_VALUE::COUNT), "s_valueNames does not match XR_EVENT_VALUE");
+
+// Constructor
+XRPlaybackEventTable::XRPlaybackEventTable()
+{
+    for (int i = 0; i < static_cast<int>(XR_EVENT_TYPE::COUNT); i++)
+    {
+        m_entries[i].pName = nullptr;
+        m_entries[i].handler = nullptr;
+        m_entries[i].isNativeOnly = false;
+        m_entries[i].isValueCaseSensitive = false;
+    }
+}
+
+// Case-insensitive FNV-1a hash; Orbiter event names are matched without regard to case.
+unsigned int XRPlaybackEventTable::HashName(const char *pName)
+{
+    unsigned int hash = 2166136261U;
+    for (const char *p = pName; *p; p++)
+    {
+        hash ^= static_cast<unsigned int>(toupper(static_cast<unsigned char>(*p)));
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+// Register an event type; a subclass may replace the handler of a type registered by its superclass.
+//   type = event type; also stored in .xrevt records
+//   pName = Orbiter event name; must be a string literal and must not contain any spaces
+//   handler = invoked to play back the event
+//   isNativeOnly = true if this event is recorded only in our .xrevt file; use this for events that carry arguments
+//   isValueCaseSensitive = true if Orbiter event values for this type have always been matched case-sensitively
+void XRPlaybackEventTable::Register(const XR_EVENT_TYPE type, const char *pName, const Handler handler, const bool isNativeOnly, const bool isValueCaseSensitive)
+{
+    _ASSERTE((type > XR_EVENT_TYPE::NONE) && (type < XR_EVENT_TYPE::COUNT));
+    Entry &entry = m_entries[static_cast<int>(type)];
+    entry.pName = pName;
+    entry.handler = handler;
+    entry.isNativeOnly = isNativeOnly;
+    entry.isValueCaseSensitive = isValueCaseSensitive;
+
+    // two different names must never hash to the same value
+    const unsigned int hash = HashName(pName);
+    _ASSERTE((m_typesByNameHash.find(hash) == m_typesByNameHash.end()) || (m_typesByNameHash[hash] == type));
+    m_typesByNameHash[hash] = type;
+}
+
+// Returns the event type registered with the supplied Orbiter event name, or XR_EVENT_TYPE::NONE if none
+XR_EVENT_TYPE XRPlaybackEventTable::Find(const char *pName) const
+{
+    const auto it = m_typesByNameHash.find(HashName(pName));
+    if (it == m_typesByNameHash.end())
+        return XR_EVENT_TYPE::NONE;
+
+    // guard against unregistered names that happen to hash to a registered one
+    return ((_stricmp(GetName(it->second), pName) == 0) ? it->second : XR_EVENT_TYPE::NONE);
+}
+
+// Play back the supplied event.
+// Returns: true if the event was handled, false if its type is not registered or its handler rejected it
+bool XRPlaybackEventTable::Dispatch(DeltaGliderXR1 &vessel, const XREventRecord &record) const
+{
+    if ((record.Type <= static_cast<int>(XR_EVENT_TYPE::NONE)) || (record.Type >= static_cast<int>(XR_EVENT_TYPE::COUNT)))
+        return false;   // from a newer version, perhaps
+
+    const Entry &entry = m_entries[record.Type];
+    return ((entry.handler != nullptr) ? entry.handler(vessel, record) : false);
+}
+
+// Convert an Orbiter event value string to an XR_EVENT_VALUE; unknown strings are XR_EVENT_VALUE::NONE
+//   isCaseSensitive = true to require an exact match; e.g., "on" is not ON
+XR_EVENT_VALUE XRPlaybackEventTable::ParseValue(const char *pValue, const bool isCaseSensitive)
+{
+    static unsigned int s_valueHashes[static_cast<int>(XR_EVENT_VALUE::COUNT)];
+    static bool s_valueHashesInitialized = false;   // OK because Orbiter is single-threaded
+    if (!s_valueHashesInitialized)
+    {
+        for (int i = 0; i < static_cast<int>(XR_EVENT_VALUE::COUNT); i++)
+            s_valueHashes[i] = HashName(s_valueNames[i]);
+        s_valueHashesInitialized = true;
+    }
+
+    const unsigned int hash = HashName(pValue);
+    for (int i = 1; i < static_cast<int>(XR_EVENT_VALUE::COUNT); i++)
+    {
+        if ((s_valueHashes[i] == hash) && ((isCaseSensitive ? strcmp(s_valueNames[i], pValue) : _stricmp(s_valueNames[i], pValue)) == 0))
+            return static_cast<XR_EVENT_VALUE>(i);
+    }
+    return XR_EVENT_VALUE::NONE;
+}
+
+const char *XRPlaybackEventTable::GetValueName(const XR_EVENT_VALUE value)
+{
+    _ASSERTE((value >= XR_EVENT_VALUE::NONE) && (value < XR_EVENT_VALUE::COUNT));
+    return s_valueNames[static_cast<int>(value)];
+}
+
+//-------------------------------------------------------------------------
+// DeltaGliderXR1 methods
+//-------------------------------------------------------------------------
+
+// Register the playback events supported by all XR vessels; subclasses should invoke this
+// superclass method first and then register their own events.
+// NOTE: do not use spaces in any of these event names.
+void DeltaGliderXR1::RegisterPlaybackEvents(XRPlaybackEventTable &table)
+{
+    typedef XRPlaybackEventTable T;
+
+    // doors
+    table.Register(XR_EVENT_TYPE::GEAR, "GEAR", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateLandingGear(T::GetDoorAction(r, XR_EVENT_VALUE::UP)); return true; });
+    table.Register(XR_EVENT_TYPE::NOSECONE, "NOSECONE", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateNoseCone(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::RCOVER, "RCOVER", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateRCover(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::RADIATOR, "RADIATOR", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateRadiator(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::AIRBRAKE, "AIRBRAKE", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateAirbrake(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::HATCH, "HATCH", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateHatch(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::OLOCK, "OLOCK", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateOuterAirlock(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::ILOCK, "ILOCK", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateInnerAirlock(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::LADDER, "LADDER", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateLadder(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::APU, "APU", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateAPU(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::HOVERDOORS, "HOVERDOORS", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateHoverDoors(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::SCRAMDOORS, "SCRAMDOORS", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateScramDoors(T::GetDoorAction(r)); return true; });
+    table.Register(XR_EVENT_TYPE::BAYDOORS, "BAYDOORS", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateBayDoors(T::GetDoorAction(r)); return true; });
+    // OK to force the chamber here, although it shouldn't be necessary
+    table.Register(XR_EVENT_TYPE::CHAMBER, "CHAMBER", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ActivateChamber(T::GetDoorAction(r), true); return true; });
+
+    // new for the XR1-1.9 release group
+    table.Register(XR_EVENT_TYPE::NAVLIGHT, "NAVLIGHT", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.SetNavlight(T::IsOn(r)); return true; });
+    table.Register(XR_EVENT_TYPE::BEACONLIGHT, "BEACONLIGHT", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.SetBeacon(T::IsOn(r)); return true; });
+    table.Register(XR_EVENT_TYPE::STROBELIGHT, "STROBELIGHT", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.SetStrobe(T::IsOn(r)); return true; });
+    table.Register(XR_EVENT_TYPE::RESETMET, "RESETMET", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.ResetMET(); return true; });  // value not used for this
+
+    // engine and fuel systems
+    table.Register(XR_EVENT_TYPE::XFEED, "XFEED", [](DeltaGliderXR1 &xr1, const XREventRecord &r)
+    {
+        XFEED_MODE mode;
+        switch (static_cast<XR_EVENT_VALUE>(r.Value))
+        {
+        case XR_EVENT_VALUE::MAIN:
+            mode = XFEED_MODE::XF_MAIN;
+            break;
+        case XR_EVENT_VALUE::RCS:
+            mode = XFEED_MODE::XF_RCS;
+            break;
+        case XR_EVENT_VALUE::OFF:
+            mode = XFEED_MODE::XF_OFF;
+            break;
+        default:    // invalid mode, so ignore it
+            _ASSERTE(false);
+            return false;
+        }
+        xr1.SetCrossfeedMode(mode, nullptr);   // no optional message for this
+        return true;
+    });
+    // the dump events have always required an exact "ON" value
+    table.Register(XR_EVENT_TYPE::MAINDUMP, "MAINDUMP", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.m_mainFuelDumpInProgress = T::IsOn(r); return true; }, false, true);
+    table.Register(XR_EVENT_TYPE::RCSDUMP, "RCSDUMP", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.m_rcsFuelDumpInProgress = T::IsOn(r); return true; }, false, true);
+    table.Register(XR_EVENT_TYPE::SCRAMDUMP, "SCRAMDUMP", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.m_scramFuelDumpInProgress = T::IsOn(r); return true; }, false, true);
+    table.Register(XR_EVENT_TYPE::APUDUMP, "APUDUMP", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.m_apuFuelDumpInProgress = T::IsOn(r); return true; }, false, true);
+    table.Register(XR_EVENT_TYPE::LOXDUMP, "LOXDUMP", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { xr1.m_loxDumpInProgress = T::IsOn(r); return true; }, false, true);
+
+    // Autopilots; these carry their targets, so they are recorded only in our own event file.
+    table.Register(XR_EVENT_TYPE::AUTOPILOT, "AUTOPILOT", [](DeltaGliderXR1 &xr1, const XREventRecord &r)
+    {
+        AUTOPILOT mode;
+        switch (static_cast<XR_EVENT_VALUE>(r.Value))
+        {
+        case XR_EVENT_VALUE::ATTITUDEHOLD:
+            mode = AUTOPILOT::AP_ATTITUDEHOLD;
+            xr1.m_setPitchOrAOA = r.Args[0];
+            xr1.m_setBank = r.Args[1];
+            xr1.m_holdAOA = ((r.Flags & XREVT_FLAG_HOLD_AOA) != 0);
+            break;
+        case XR_EVENT_VALUE::DESCENTHOLD:
+            mode = AUTOPILOT::AP_DESCENTHOLD;
+            xr1.m_setDescentRate = r.Args[2];
+            break;
+        case XR_EVENT_VALUE::OFF:
+            mode = AUTOPILOT::AP_OFF;
+            break;
+        default:    // invalid mode, so ignore it
+            _ASSERTE(false);
+            return false;
+        }
+        xr1.SetCustomAutopilotMode(mode, true);
+        return true;
+    }, true);
+    table.Register(XR_EVENT_TYPE::AIRSPEEDHOLD, "AIRSPEEDHOLD", [](DeltaGliderXR1 &xr1, const XREventRecord &r)
+    {
+        const bool on = T::IsOn(r);
+        if (on)
+            xr1.m_setAirspeed = r.Args[0];
+        xr1.SetAirspeedHoldMode(on, true);
+        return true;
+    }, true);
+
+    // Payload deployment; the XR1 has no payload bay, so it never records these.
+    table.Register(XR_EVENT_TYPE::PAYLOADDEPLOY, "PAYLOADDEPLOY", [](DeltaGliderXR1 &xr1, const XREventRecord &r)
+    {
+        if (xr1.m_pPayloadBay == nullptr)
+            return false;
+
+        xr1.m_deployDeltaV = r.Args[1];
+        xr1.m_selectedSlot = static_cast<int>(r.Args[0]);
+        return xr1.DeployPayload(xr1.m_selectedSlot, true);
+    }, true);
+    table.Register(XR_EVENT_TYPE::PAYLOADDEPLOYALL, "PAYLOADDEPLOYALL", [](DeltaGliderXR1 &xr1, const XREventRecord &r)
+    {
+        if (xr1.m_pPayloadBay == nullptr)
+            return false;
+
+        xr1.m_deployDeltaV = r.Args[0];
+        return (xr1.DeployAllPayload() > 0);
+    }, true);
+}
+
+// Returns our playback event table, registering our events on first use
+const XRPlaybackEventTable &DeltaGliderXR1::GetPlaybackEventTable()
+{
+    if (m_playbackEventTable.IsEmpty())
+        RegisterPlaybackEvents(m_playbackEventTable);
+
+    return m_playbackEventTable;
+}
+
+// Record an XR event for playback.  Events that Orbiter has always recorded are still sent to Orbiter's flight
+// recorder as well so that recordings remain playable without their .xrevt file.
+//   type, value = event to record
+//   flags, arg0-arg2 = event-specific data; see XR_EVENT_TYPE
+void DeltaGliderXR1::RecordXREvent(const XR_EVENT_TYPE type, const XR_EVENT_VALUE value, const int flags, const float arg0, const float arg1, const float arg2)
+{
+    const XRPlaybackEventTable &table = GetPlaybackEventTable();
+    _ASSERTE(table.GetName(type) != nullptr);   // all recorded types must be registered
+
+    if (!table.IsNativeOnly(type))
+        RecordEvent(table.GetName(type), XRPlaybackEventTable::GetValueName(value));
+
+    if (m_xrEventRecorder.IsOpen())
+        m_xrEventRecorder.Record(oapiGetSimMJD(), static_cast<int>(type), static_cast<int>(value), flags, arg0, arg1, arg2);
+}
+
+// Open our event file if a playback session just started; this is invoked from both clbkPreStep and
+// clbkPlaybackEvent since Orbiter may deliver an event before our first PreStep.
+void DeltaGliderXR1::StartXREventPlayback(const double mjd)
+{
+    if (m_xrEventPlaybackStarted)
+        return;     // already tried
+
+    m_xrEventPlaybackStarted = true;   // only try once per playback session
+    if (m_xrEventPlayer.Open(XRFDR_OUTPUT_FOLDER, GetName(), mjd))
+        GetXR1Config()->WriteLog("XR event file found: XR events will be played back from it.");
+}
+
+// Start and stop our event file along with Orbiter's flight recorder, and replay any recorded events that are due.
+// This is invoked at the beginning of each PreStep.
+void DeltaGliderXR1::UpdateXREventRecorder(const double mjd)
+{
+    // recording
+    if (Recording())
+    {
+        if (!m_xrEventRecordingStarted)
+        {
+            m_xrEventRecordingStarted = true;  // only try once per recording session
+            if (!m_xrEventRecorder.Open(XRFDR_OUTPUT_FOLDER, GetName(), GetClassName(), mjd))
+            {
+                char msg[128];
+                sprintf(msg, "WARNING: unable to create XR event file; GetLastError=0x%X.  XR events will not be recorded.", GetLastError());
+                GetXR1Config()->WriteLog(msg);
+            }
+        }
+    }
+    else if (m_xrEventRecordingStarted)
+    {
+        m_xrEventRecorder.Close();
+        m_xrEventRecordingStarted = false;
+    }
+
+    // playback
+    if (Playback())
+    {
+        StartXREventPlayback(mjd);
+
+        const XRPlaybackEventTable &table = GetPlaybackEventTable();
+        const XREventRecord *pRecord;
+        while ((pRecord = m_xrEventPlayer.GetNextDueRecord(mjd)) != nullptr)
+            table.Dispatch(*this, *pRecord);
+    }
+    else if (m_xrEventPlaybackStarted)
+    {
+        // playback ended or the pilot took over
+        m_xrEventPlayer.Close();
+        m_xrEventPlaybackStarted = false;
+    }
+}
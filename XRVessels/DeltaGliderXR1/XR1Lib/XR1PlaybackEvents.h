@@ -0,0 +1,112 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XR1PlaybackEvents.h
+// Table of the playback events supported by an XR vessel.  Each event type
+// is registered once with its Orbiter event name and a handler; Orbiter
+// playback events are dispatched by a hash of their name, and native
+// .xrevt records (see XREventRecorder.h) are dispatched by their type.
+// ==============================================================
+
+#pragma once
+
+#include "XREventRecorder.h"
+#include "XR1Globals.h"
+#include <unordered_map>
+
+class DeltaGliderXR1;
+
+// These values are stored in .xrevt files: never renumber them, and only add new types at the end.
+enum class XR_EVENT_TYPE
+{
+    NONE = 0,
+    GEAR = 1, NOSECONE = 2, RCOVER = 3, RADIATOR = 4, AIRBRAKE = 5, HATCH = 6, OLOCK = 7, ILOCK = 8, LADDER = 9,
+    APU = 10, HOVERDOORS = 11, SCRAMDOORS = 12, BAYDOORS = 13, CHAMBER = 14,
+    NAVLIGHT = 15, BEACONLIGHT = 16, STROBELIGHT = 17, RESETMET = 18,
+    XFEED = 19, MAINDUMP = 20, RCSDUMP = 21, SCRAMDUMP = 22, APUDUMP = 23, LOXDUMP = 24,
+    ELEVATOR = 25,          // XR3 and XR5 only
+    AUTOPILOT = 26,         // Args: pitch or AOA, bank, descent rate; Flags: 1 = hold AOA
+    AIRSPEEDHOLD = 27,      // Args: target airspeed
+    PAYLOADDEPLOY = 28,     // Args: slot number, deploy delta-V
+    PAYLOADDEPLOYALL = 29,  // Args: deploy delta-V
+    COUNT                   // not a type: number of types
+};
+
+// These values are stored in .xrevt files: never renumber them, and only add new values at the end.
+enum class XR_EVENT_VALUE
+{
+    NONE = 0, OPEN = 1, CLOSE = 2, UP = 3, DOWN = 4, ON = 5, OFF = 6, MAIN = 7, RCS = 8, ATTITUDEHOLD = 9, DESCENTHOLD = 10,
+    COUNT                   // not a value: number of values
+};
+
+#define XREVT_FLAG_HOLD_AOA 0x01    // AUTOPILOT: m_setPitchOrAOA is an AOA
+
+class XRPlaybackEventTable
+{
+public:
+    // Returns: true if the event was handled, false if it was invalid
+    typedef bool (*Handler)(DeltaGliderXR1 &vessel, const XREventRecord &record);
+
+    XRPlaybackEventTable();
+
+    void Register(const XR_EVENT_TYPE type, const char *pName, const Handler handler, const bool isNativeOnly = false, const bool isValueCaseSensitive = false);
+    bool IsEmpty() const { return m_typesByNameHash.empty(); }
+    XR_EVENT_TYPE Find(const char *pName) const;
+    bool Dispatch(DeltaGliderXR1 &vessel, const XREventRecord &record) const;
+
+    // Returns the Orbiter event name for the supplied type
+    const char *GetName(const XR_EVENT_TYPE type) const { return m_entries[static_cast<int>(type)].pName; }
+
+    // Returns true if the supplied type is recorded only in our .xrevt files and never as an Orbiter event; these events carry arguments
+    bool IsNativeOnly(const XR_EVENT_TYPE type) const { return m_entries[static_cast<int>(type)].isNativeOnly; }
+
+    // Returns true if the Orbiter event value for the supplied type must match its value name exactly
+    bool IsValueCaseSensitive(const XR_EVENT_TYPE type) const { return m_entries[static_cast<int>(type)].isValueCaseSensitive; }
+
+    static XR_EVENT_VALUE ParseValue(const char *pValue, const bool isCaseSensitive);
+    static const char *GetValueName(const XR_EVENT_VALUE value);
+
+    // Returns the door action for an event; closeValue closes the door and anything else opens it, as it always has
+    static DoorStatus GetDoorAction(const XREventRecord &record, const XR_EVENT_VALUE closeValue = XR_EVENT_VALUE::CLOSE)
+    {
+        return ((static_cast<XR_EVENT_VALUE>(record.Value) == closeValue) ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
+    }
+
+    static bool IsOn(const XREventRecord &record) { return (static_cast<XR_EVENT_VALUE>(record.Value) == XR_EVENT_VALUE::ON); }
+
+protected:
+    static unsigned int HashName(const char *pName);
+
+    struct Entry
+    {
+        const char *pName;      // nullptr = type not registered
+        Handler handler;
+        bool isNativeOnly;
+        bool isValueCaseSensitive;
+    };
+
+    Entry m_entries[static_cast<int>(XR_EVENT_TYPE::COUNT)];   // indexed by type
+    unordered_map<unsigned int, XR_EVENT_TYPE> m_typesByNameHash;
+};
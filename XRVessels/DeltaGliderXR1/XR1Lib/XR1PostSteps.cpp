@@ -72,7 +72,7 @@ void ComputeAccPostStep::clbkPrePostStep(const double simt, const double simdt,
     // We allow a 5% cushion.  
     // NOTE: if the vessel is still in contact with the ground, lock the scale to TwoG since sometimes 
     // the G "bouncing" during roll can jump it to 4G, which is pointless.
-    if (GetVessel().GroundContact() ||
+    if (GetVessel().GetFlightState().GroundContact() ||
         (maxAcc > (GetXR1().m_maxGaugeAcc * 1.05)) ||   // has maxAcc exceeded current gauge by 5%?
         (simt >= m_gaugeScaleExpiration))   // OK to lower gauge scale if necessary?
     {
@@ -256,9 +256,9 @@ SetSlopePostStep::~SetSlopePostStep()
 
 void SetSlopePostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
-    const double altitude = GetVessel().GetAltitude(ALTMODE_GROUND);
+    const double altitude = GetVessel().GetFlightState().GetAltitude(ALTMODE_GROUND);
 
-    if (GetXR1().GroundContact())
+    if (GetXR1().GetFlightState().GroundContact())
     {
         m_isNextUpdateTimeValid = false;      // reset
         GetXR1().m_slope = 0;       // no slope when on ground
@@ -277,7 +277,7 @@ void SetSlopePostStep::clbkPrePostStep(const double simt, const double simdt, co
     // over time vary, which would make accuracy (and lag) dependent on the framerate.  So we sync at 60 fps instead (see m_refreshRate value).
     if (m_isNextUpdateTimeValid && (simt >= m_nextUpdateTime))
     {
-		const double groundspeed = GetVessel().GetGroundspeed();
+		const double groundspeed = GetVessel().GetFlightState().GetGroundspeed();
 
         const double timeDeltaSinceLastUpdate = simt - m_lastUpdateTime;
         m_pAltitudeDeltaRollingArray->AddSample(altitude - m_lastUpdateAltitude);       // altitude delta for this timestep
@@ -338,6 +338,40 @@ DoorSoundsPostStep::DoorSoundsPostStep(DeltaGliderXR1 &vessel) :
     INIT_DOORSOUND(9,  scramdoor_status, dScramDoors,    "SCRAM Doors");
 }
 
+// Invoked when the vessel regains the focus: reinitialize the previous status of each door on the next frame, 
+// just like when the scenario loads, so we do not play sounds for doors that moved while we were skipped.
+void DoorSoundsPostStep::clbkResync(const double simt)
+{
+    const int doorCount = (sizeof(m_doorSounds) / sizeof(DoorSound));
+    for (int i=0; i < doorCount; i++)
+        ResyncDoorSound(m_doorSounds[i]);
+
+    m_prevChamberStatus = DoorStatus::NOT_SET;
+}
+
+void DoorSoundsPostStep::ResyncDoorSound(DoorSound &doorSound)
+{
+    doorSound.prevDoorStatus = DoorStatus::NOT_SET;
+    doorSound.processAPUTransitionState = false;
+}
+
+// Invoked each frame that the door sounds are skipped because we do not have the focus: the door sounds are 
+// what marks the APU active while a hydraulic door moves, so keep doing that or the APU idle warning timer 
+// would expire while a door is still moving.
+void DoorSoundsPostStep::clbkSkipped(const double simt, const double simdt, const double mjd)
+{
+    const int doorCount = (sizeof(m_doorSounds) / sizeof(DoorSound));
+    for (int i=0; i < doorCount; i++)
+        MarkAPUActiveIfDoorMoving(m_doorSounds[i]);
+}
+
+void DoorSoundsPostStep::MarkAPUActiveIfDoorMoving(const DoorSound &doorSound)
+{
+    const DoorStatus ds = *doorSound.pDoorStatus;
+    if (((ds == DoorStatus::DOOR_OPENING) || (ds == DoorStatus::DOOR_CLOSING)) && GetXR1().CheckHydraulicPressure(false, false))
+        GetXR1().MarkAPUActive();  // reset the APU idle warning callout time
+}
+
 void DoorSoundsPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
     // walk through all doors
@@ -528,31 +562,23 @@ void UpdateCoolantTempPostStep::clbkPrePostStep(const double simt, const double
     if ((GetXR1().apu_status == DoorStatus::DOOR_OPEN) || (GetXR1().apu_status == DoorStatus::DOOR_OPENING))
         heatingModifier += 0.05;
 
-    // add heat
-    coolantTemp += (COOLANT_HEATING_RATE[heatingRateSetting] * simdt * heatingModifier);
-
-    // heat is capped at max temp
-    if (coolantTemp > MAX_COOLANT_TEMP)
-        coolantTemp = MAX_COOLANT_TEMP;
+    // Each active cooler removes heat at a percentage OR at a minimum rate, whichever is higher.
+    double coolingFracs[2];
+    int coolerCount = 0;
 
     // remove heat if radiator open
     if (GetXR1().radiator_status == DoorStatus::DOOR_OPEN)
-    {
-        // cool at a percentage OR at a minimum rate, whichever is higher
-        coolantTemp -= max(COOLANT_COOLING_RATE_FRAC * coolantTemp, COOLANT_COOLING_RATE_MIN) * simdt;
-    }
+        coolingFracs[coolerCount++] = COOLANT_COOLING_RATE_FRAC;
 
     // remove heat if external cooling is flowing; this "stacks" with the radiator as well
+    // NOTE: ground cooling is 27% more efficient than radiators, so effective total cooling with both active is 127% of normal.
     if (GetXR1().m_isExternalCoolantFlowing)
-    {
-        // cool at a percentage OR at a minimum rate, whichever is higher
-        // NOTE: ground cooling is 27% more efficient than radiators, so effective total cooling with both active is 127% of normal.
-        coolantTemp -= max((COOLANT_COOLING_RATE_FRAC * 1.27) * coolantTemp, COOLANT_COOLING_RATE_MIN) * simdt;
-    }
+        coolingFracs[coolerCount++] = COOLANT_COOLING_RATE_FRAC * 1.27;
 
-    // do not drop below nominal
-    if (coolantTemp < NOMINAL_COOLANT_TEMP)
-        coolantTemp = NOMINAL_COOLANT_TEMP;
+    // Add and remove heat over this timestep; this is solved exactly, so the temperature does not depend on the time acceleration.
+    // Heat is capped at max temp, and we do not drop below nominal.
+    coolantTemp = XRConsumables::IntegrateTemperature(coolantTemp, COOLANT_HEATING_RATE[heatingRateSetting] * heatingModifier, 
+        coolingFracs, coolerCount, COOLANT_COOLING_RATE_MIN, NOMINAL_COOLANT_TEMP, MAX_COOLANT_TEMP, simdt);
 
     // check for warnings or failure
     if (coolantTemp >= CRITICAL_COOLANT_TEMP)
@@ -569,9 +595,10 @@ void UpdateCoolantTempPostStep::clbkPrePostStep(const double simt, const double
             const double dt = oapiGetSimStep();     // # of seconds since last timestep
             double exceededLimitMult = pow((coolantTemp / CRITICAL_COOLANT_TEMP), 2);  // e.g. 1.21 = 10% over limit
 
-            // # of seconds at this temp / average terminal failure interval (20 secs)
+            // # of seconds at this temp / average terminal failure interval (20 secs); use the exponential form so that
+            // the chance of failure over a given span of sim time is the same at any time acceleration.
             double failureTimeFrac = dt / 20.0;
-            double failureProbability = failureTimeFrac * exceededLimitMult;
+            double failureProbability = 1.0 - exp(-failureTimeFrac * exceededLimitMult);
 
             if (oapiRand() <= failureProbability)
             {
@@ -652,7 +679,7 @@ void AirlockDecompressionPostStep::clbkPrePostStep(const double simt, const doub
     // check for both airlock doors open and low atmospheric pressure AND we are not docked
     // doors are open if >= 10% ajar
     const bool doorsOpen = ((GetXR1().olock_proc > 0.20) && (GetXR1().olock_proc > 0.20));
-    if (doorsOpen && (GetXR1().m_cabinO2Level > 0) && (GetXR1().GetAtmPressure() < 50e3) && (GetXR1().IsDocked() == false))
+    if (doorsOpen && (GetXR1().m_cabinO2Level > 0) && (GetXR1().GetFlightState().GetAtmPressure() < 50e3) && (GetXR1().IsDocked() == false))
     {
         // decompression!
         // obtain our docking port params
@@ -1003,8 +1030,7 @@ void ManageMWSPostStep::clbkPrePostStep(const double simt, const double simdt, c
 {
     if (GetXR1().m_MWSActive)    // is light enabled?
     {
-        double di;
-        bool mwson = (modf(simt, &di) < 0.5);   // toggle twice a second
+        const bool mwson = GetXR1().GetBlinkClock().IsOn(BLINK_RATE::HZ_1);   // toggle twice a second
         if (mwson != GetXR1().m_MWSLit)  // not updated the light yet?
         {
             // toggle the state and request a repaint
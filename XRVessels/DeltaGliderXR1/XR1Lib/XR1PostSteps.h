@@ -55,6 +55,7 @@ class ComputeAccPostStep : public XR1PrePostStep
 public:
     ComputeAccPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // acceleration is only displayed on the panels and HUD
 
 protected:
     AccScale m_activeGaugeScale;
@@ -108,9 +109,14 @@ class DoorSoundsPostStep : public XR1PrePostStep
 public:
     DoorSoundsPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // sound only
+    virtual void clbkResync(const double simt);  // do not play sounds for doors that moved while we were skipped
+    virtual void clbkSkipped(const double simt, const double simdt, const double mjd);  // keeps the APU idle timer current
 
 protected:
     void PlayDoorSound(DoorSound &doorSound, const double simt);
+    void ResyncDoorSound(DoorSound &doorSound);
+    void MarkAPUActiveIfDoorMoving(const DoorSound &doorSound);
     void ShowDoorInfoMsg(DoorSound doorSound);
     DoorSound m_doorSounds[10];
 
@@ -190,6 +196,7 @@ class ManageMWSPostStep : public XR1PrePostStep
 public:
     ManageMWSPostStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // blinks the MWS light only
 };
 
 //---------------------------------------------------------------------------
@@ -88,9 +88,11 @@ void APUPostStep::BurnAPUFuel(const double simt, const double simdt, const doubl
 
         if (GetXR1().m_apuFuelQty > 0.0)
         {
-            GetXR1().m_apuFuelQty -= (kgPerSec * simdt);     // amount of fuel burned in this timestep
-            if (GetXR1().m_apuFuelQty < 0.0)
-                GetXR1().m_apuFuelQty = 0.0;
+            double apuFuelQty = GetXR1().m_apuFuelQty - (kgPerSec * simdt);     // amount of fuel burned in this timestep
+            if (apuFuelQty < 0.0)
+                apuFuelQty = 0.0;
+
+            GetXR1().SetAPUFuelQty(apuFuelQty);
         }
     }
 
@@ -202,7 +204,7 @@ void APUPostStep::UpdateAPUDoorState(const double simt, const double simdt, cons
         m_poweringUpOrDown = false;  // reset for next time
 
         // if APU just reached full ON state, turn AF CTRL ON as well *if* inside any atmosphere
-        if ((doorStatus == DoorStatus::DOOR_OPEN) && (GetVessel().GetDynPressure() >= 5.0e3))   // 5 kPa dynamic pressure
+        if ((doorStatus == DoorStatus::DOOR_OPEN) && (GetVessel().GetFlightState().GetDynPressure() >= 5.0e3))   // 5 kPa dynamic pressure
             GetVessel().SetADCtrlMode(7);
     }
 
@@ -268,7 +270,7 @@ void DisableControlSurfForAPUPostStep::clbkPrePostStep(const double simt, const
             if (m_initialStartupComplete)
             {
                 // only warn the user if 1) we are moving in a noticable atmosphere, and 2) the ship is airborne
-                bool warnUser = (GetVessel().GetDynPressure() > 5) && (GetVessel().GroundContact() == false);
+                bool warnUser = (GetVessel().GetFlightState().GetDynPressure() > 5) && (GetVessel().GetFlightState().GroundContact() == false);
                 GetXR1().CheckHydraulicPressure(warnUser, warnUser);
             }
 
@@ -177,6 +177,11 @@ FuelDumpPostStep::FuelDumpPostStep(DeltaGliderXR1 &vessel) :
 
     if (GetXR1().m_pFuelDumpParticleStreamSpec != nullptr)
         m_fuelDumpStream2 = GetVessel().AddParticleStream(GetXR1().m_pFuelDumpParticleStreamSpec, FUEL_DUMP_PARTICLE_STREAM_POS2, FUEL_DUMP_PARTICLE_STREAM_DIR2, &m_fuelDumpLevel);
+
+    for (int i = 0; i < static_cast<int>(ConsumableTank::External); i++)
+        m_dumpFlowIDs[i] = -1;
+
+    GetXR1().m_consumables.AddListener(this);
 }
 
 // destructor
@@ -190,75 +195,68 @@ FuelDumpPostStep::~FuelDumpPostStep()
 }
 
 void FuelDumpPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    // The fuel is dumped by IntegrateConsumablesPostStep, which invokes ConsumablesIntegrated below when it is done.
+    // Add oapiRand to the fuel dump rate so that kg mass goes down by a random fraction (looks better on the lower panel's mass display).
+    AddDumpFlow(ConsumableTank::Main, GetXR1().m_mainFuelDumpInProgress, (FUEL_DUMP_RATE + oapiRand()));
+    AddDumpFlow(ConsumableTank::RCS, GetXR1().m_rcsFuelDumpInProgress, (FUEL_DUMP_RATE + oapiRand()) * RCS_FLOW_FRACTION);
+    AddDumpFlow(ConsumableTank::SCRAM, GetXR1().m_scramFuelDumpInProgress, (FUEL_DUMP_RATE + oapiRand()) * SCRAM_FLOW_FRACTION);
+    AddDumpFlow(ConsumableTank::APU, GetXR1().m_apuFuelDumpInProgress, FUEL_DUMP_RATE * APU_FLOW_FRACTION);
+
+    // LOX flow fraction is based on tank capacity AND a minimum flow rate per second
+    // This take payload LOX into account as well
+    AddDumpFlow(ConsumableTank::LOX, GetXR1().m_loxDumpInProgress, max(GetXR1().GetXRLOXMaxMass() * LOX_DUMP_FRAC, LOX_MIN_DUMP_RATE));
+}
+
+// Register a dump flow for this frame if a dump is in progress for the specified tank
+//  rate = dump rate in kg/second
+void FuelDumpPostStep::AddDumpFlow(const ConsumableTank tank, const bool dumpInProgress, const double rate)
+{
+    m_dumpFlowIDs[static_cast<int>(tank)] = (dumpInProgress ? GetXR1().m_consumables.AddFlow(tank, ConsumableTank::External, rate, true) : -1);
+}
+
+// Invoked each frame after all fuel flows were integrated
+void FuelDumpPostStep::ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt)
 {
     m_fuelDumpLevel = 0.0;      // 0 -> 1.0; used for dump particle level
-    // flow weights:
+    // flow weights, indexed by tank:
     //   Main:  50%
-    //   SCRAM: 25%
-    //   LOX: 15%
     //   RCS: 5%
+    //   SCRAM: 25%
     //   APU: 5%
-    if (GetXR1().m_mainFuelDumpInProgress)
-    {
-        if (DumpFuel(GetXR1().ph_main, simdt, GetXR1().m_mainFuelDumpInProgress, 1.0))
-            m_fuelDumpLevel += 0.50;
-    }
-
-    if (GetXR1().m_rcsFuelDumpInProgress)
+    //   LOX: 15%
+    static const double s_flowWeights[] = { 0.50, 0.05, 0.25, 0.05, 0.15 };
+    bool *pDumpInProgress[] = 
     {
-        if (DumpFuel(GetXR1().ph_rcs, simdt, GetXR1().m_rcsFuelDumpInProgress, RCS_FLOW_FRACTION))
-            m_fuelDumpLevel += 0.05;
-    }
+        &GetXR1().m_mainFuelDumpInProgress, &GetXR1().m_rcsFuelDumpInProgress, &GetXR1().m_scramFuelDumpInProgress, 
+        &GetXR1().m_apuFuelDumpInProgress, nullptr   // LOX dump state must be set via SetLOXDumpState
+    };
 
-    if (GetXR1().m_scramFuelDumpInProgress)
+    for (int i = 0; i < static_cast<int>(ConsumableTank::External); i++)
     {
-        if (DumpFuel(GetXR1().ph_scram, simdt, GetXR1().m_scramFuelDumpInProgress, SCRAM_FLOW_FRACTION))
-            m_fuelDumpLevel += 0.25;
-    }
-
-    if (GetXR1().m_apuFuelDumpInProgress)
-    {
-        // must dump APU fuel manually here
-        if (GetXR1().m_apuFuelQty > 0)
-        {
-            GetXR1().m_apuFuelQty -= (FUEL_DUMP_RATE * simdt * APU_FLOW_FRACTION);
-            if (GetXR1().m_apuFuelQty <= 0)    // underflow?
-                GetXR1().m_apuFuelQty = 0;     
-            else
-                m_fuelDumpLevel += 0.05;
-        }
+        const int flowID = m_dumpFlowIDs[i];
+        if (flowID < 0)
+            continue;   // not dumping this tank
 
-        if (GetXR1().m_apuFuelQty <= 0)    // did tank reach empty?
+        // NOTE: it is possible for the tank to have been empty already at the start of the frame, in which case it halted immediately
+        if (consumables.GetFlow(flowID).haltReason != XRConsumables::HaltReason::None)
         {
+            // tank either just reached empty or was empty on entry
             GetXR1().PlayErrorBeep();   // alert the pilot
-            GetXR1().m_apuFuelDumpInProgress = false;   // halt the dump
-        }
-    }
 
-    if (GetXR1().m_loxDumpInProgress)
-    {
-        // must dump LOX manually here
-        // This take payload LOX into account as well
-        if (GetXR1().GetXRLOXMass() > 0)
-        {
-            // LOX flow fraction is based on tank capacity AND a minimum flow rate per second
-            const double flowRate = max(GetXR1().GetXRLOXMaxMass() * LOX_DUMP_FRAC, LOX_MIN_DUMP_RATE);
-
-            double qty = GetXR1().GetXRLOXMass();
-            qty -= (flowRate * simdt);  // mass * dump rate in TANK FRACTION/SECOND
-            if (qty <= 0)     // underflow?
-                qty = 0;      // prevent underflow
+            // halt the dump
+            if (pDumpInProgress[i] != nullptr)
+                *pDumpInProgress[i] = false;
             else
-                m_fuelDumpLevel += 0.15; 
-            GetXR1().SetXRLOXMass(qty);  // updates payload LOX as well
+                GetXR1().SetLOXDumpState(false);
         }
-
-        if (GetXR1().GetXRLOXMass() <= 0)  // did tank reach empty?
+        else
         {
-            GetXR1().PlayErrorBeep();   // alert the pilot
-            GetXR1().SetLOXDumpState(false);  // halt the dump
+            m_fuelDumpLevel += s_flowWeights[i];
         }
-    } 
+
+        m_dumpFlowIDs[i] = -1;  // flow IDs are only valid for one frame
+    }
 
     // update the dump particle stream rate
     // TESTING ONLY: m_fuelDumpLevel = 1.0;
@@ -319,149 +317,88 @@ void FuelDumpPostStep::clbkPrePostStep(const double simt, const double simdt, co
     }
 }
 
-// rateFraction = fraction of speed to dump this tank
-// Returns: true if dump continuing, false if dump was halted
-bool FuelDumpPostStep::DumpFuel(const PROPELLANT_HANDLE ph, const double simdt, bool &dumpInProgress, const double rateFraction)
-{
-    // NOTE: it is possible for remaining to be zero here already, so we have to check to end the dump *outside* the "remaining > 0" if block below
-    double remaining = GetXR1().GetXRPropellantMass(ph);
-    if (remaining > 0)
-    {
-        // add oapiRand to fuel dump rate so that kg mass goes down by a random fraction
-        // (looks better on the lower panel's mass display)
-        remaining -= ((FUEL_DUMP_RATE + oapiRand()) * simdt * rateFraction);
-        if (remaining < 0)    // underflow?
-            remaining = 0;
-
-        // update fuel remaning in tank
-        GetXR1().SetXRPropellantMass(ph, remaining);
-    }
-    
-    if (remaining <= 0)    // is tank empty?
-    {
-        // tank either just reached empty or was empty on entry
-        GetXR1().PlayErrorBeep();   // alert the pilot
-        dumpInProgress = false;     // halt the dump
-    }
-
-    return dumpInProgress;
-}
-
 //---------------------------------------------------------------------------
 
 XFeedPostStep::XFeedPostStep(DeltaGliderXR1 &vessel) : 
-    XR1PrePostStep(vessel)
+    XR1PrePostStep(vessel),
+    m_flowID(-1)
 {
+    GetXR1().m_consumables.AddListener(this);
 }
 
 void XFeedPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
-    double mainToRCSFlow = 0.0;
-
     // NOTE: flow is to or from RCS tank here, so use RCS_FLOW_FRACTION
+    const double flowRate = FUEL_DUMP_RATE * RCS_FLOW_FRACTION;  // kg/second
+
+    // the fuel is flowed by IntegrateConsumablesPostStep, which invokes ConsumablesIntegrated below when it is done
     switch (GetXR1().m_xfeedMode)
     {
     case XFEED_MODE::XF_MAIN:
         // RCS -> MAIN
-        mainToRCSFlow = -(FUEL_DUMP_RATE * simdt * RCS_FLOW_FRACTION); 
+        m_flowID = GetXR1().m_consumables.AddFlow(ConsumableTank::RCS, ConsumableTank::Main, flowRate, true);
         break;
 
     case XFEED_MODE::XF_RCS:
         // MAIN -> RCS
-        mainToRCSFlow = (FUEL_DUMP_RATE * simdt * RCS_FLOW_FRACTION); 
+        m_flowID = GetXR1().m_consumables.AddFlow(ConsumableTank::Main, ConsumableTank::RCS, flowRate, true);
         break;
 
     default:
         // no default handler for this; fall through and do nothing
+        m_flowID = -1;
         break;
     }
+}
 
-    // flow the fuel
-    if (mainToRCSFlow != 0)
+// Invoked each frame after all fuel flows were integrated
+void XFeedPostStep::ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt)
+{
+    if (m_flowID < 0)   // fuel not flowing
     {
-        double mainTankQty = GetXR1().GetXRPropellantMass(GetXR1().ph_main);
-        double rcsTankQty = GetXR1().GetXRPropellantMass(GetXR1().ph_rcs);
-        const double mainTankMaxQty = GetXR1().GetXRPropellantMaxMass(GetXR1().ph_main);
-        const double rcsTankMaxQty = GetXR1().GetXRPropellantMaxMass(GetXR1().ph_rcs);
-
-        mainTankQty -= mainToRCSFlow;
-        rcsTankQty += mainToRCSFlow;
-
-        // check limits
-        bool haltFlow = false;
-        const char *pMsg = nullptr;
-        if (mainTankQty < 0)  // main tank underflow
-        {
-            // fuel flowing to RCS; remove excess fuel added
-            rcsTankQty += mainTankQty;  // mainTankQty is negative
-
-            mainTankQty = 0;
-            haltFlow = true;
-            pMsg = "MAIN fuel tanks empty";
-        }
-        else if (mainTankQty > mainTankMaxQty)  // main tank overflow
-        {
-            // fuel flowing from RCS; replace excess fuel removed
-            rcsTankQty += (mainTankQty - mainTankMaxQty);
-
-            mainTankQty = mainTankMaxQty;
-            haltFlow = true;
-            pMsg = "MAIN fuel tanks full";
-        }
-
-        if (rcsTankQty < 0)   // RCS tank underflow
-        {
-            // fuel flowing to main; remove excess fuel added
-            mainTankQty += rcsTankQty;  // rcsTankQty is negative
-
-            rcsTankQty = 0;
-            haltFlow = true;
-            pMsg = "RCS fuel tanks empty";
-        }
-        else if (rcsTankQty > rcsTankMaxQty)  // RCS tank overflow
-        {
-            // fuel flowing from main; replace excess fuel removed
-            mainTankQty += (rcsTankQty - rcsTankMaxQty);
+        GetXR1().StopSound(GetXR1().FuelCrossFeed);
+        return;
+    }
 
-            rcsTankQty = rcsTankMaxQty;
-            haltFlow = true;
-            pMsg = "RCS fuel tanks full";
-        }
+    const XRConsumables::Flow &flow = consumables.GetFlow(m_flowID);
+    m_flowID = -1;      // flow IDs are only valid for one frame
 
-        GetXR1().SetXRPropellantMass(GetXR1().ph_main, mainTankQty);
-        GetXR1().SetXRPropellantMass(GetXR1().ph_rcs, rcsTankQty);
+    if (flow.haltReason != XRConsumables::HaltReason::None)
+    {
+        const bool isMain = (flow.haltTank == ConsumableTank::Main);
+        const char *pMsg;
+        if (flow.haltReason == XRConsumables::HaltReason::SourceEmpty)
+            pMsg = (isMain ? "MAIN fuel tanks empty" : "RCS fuel tanks empty");
+        else
+            pMsg = (isMain ? "MAIN fuel tanks full" : "RCS fuel tanks full");
 
-        if (haltFlow)
-        {
-            GetXR1().SetCrossfeedMode(XFEED_MODE::XF_OFF, pMsg);  // also triggers the knob to redraw
-            // flow sound will stop next timestep 
-        }
-        else    // flow still in progress
-        {
-            // play sound if not already playing
-            if (GetXR1().IsPlaying(GetXR1().FuelCrossFeed) == false)
-                GetXR1().PlaySound(GetXR1().FuelCrossFeed, DeltaGliderXR1::ST_Other, FUEL_XFEED_VOL, true);   // loop this sound
-        }
+        GetXR1().SetCrossfeedMode(XFEED_MODE::XF_OFF, pMsg);  // also triggers the knob to redraw
+        // flow sound will stop next timestep 
     }
-    else    // fuel not flowing
+    else    // flow still in progress
     {
-        GetXR1().StopSound(GetXR1().FuelCrossFeed);
+        // play sound if not already playing
+        if (GetXR1().IsPlaying(GetXR1().FuelCrossFeed) == false)
+            GetXR1().PlaySound(GetXR1().FuelCrossFeed, DeltaGliderXR1::ST_Other, FUEL_XFEED_VOL, true);   // loop this sound
     }
 }
 
-
-
 //---------------------------------------------------------------------------
 
 // Handles LOX consumption
 LOXConsumptionPostStep::LOXConsumptionPostStep(DeltaGliderXR1 &vessel) : 
     XR1PrePostStep(vessel),
-    m_previousAmbientO2Available(false), m_previousO2Level(-1)
+    m_previousAmbientO2Available(false), m_previousO2Level(-1),
+    m_cabinUpdatePending(false), m_ambientO2Available(false), m_loxAvailable(false), m_loxConsumptionPerSecond(0), m_loxFlowID(-1)
 {
+    GetXR1().m_consumables.AddListener(this);
 }
 
 void LOXConsumptionPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
+    m_cabinUpdatePending = false;   // assume nothing to do this frame
+    m_loxFlowID = -1;
+
     // if crew is DEAD, nothing to do here
     if (GetXR1().m_crewState == CrewState::DEAD)
         return;
@@ -471,18 +408,17 @@ void LOXConsumptionPostStep::clbkPrePostStep(const double simt, const double sim
     // compensate for reduced oxygen consumption if configured as such
     const double consumptionFraction = GetXR1().GetXR1Config()->GetLOXConsumptionFraction();   // 0 < n <= 1.0
     const double loxConsumptionPerSecond = crewMembers * LOX_CONSUMPTION_RATE * consumptionFraction * GetXR1().GetXR1Config()->LOXConsumptionMultiplier;  // WARNING: MAY BE ZERO!
-    const double loxConsumptionThisTimestep = loxConsumptionPerSecond * simdt;  // WARNING: MAY BE ZERO!
 
     // no LOX consumption if landed in earth ATM or docked and both airlocks and noscone open, OR if in earth ATM and hatch open, OR if external cooling active
     bool ambientO2Available = false;
     const bool bothAirlocksOpen = ((GetXR1().ilock_proc >= 0.25) && (GetXR1().olock_proc >= 0.25) && (GetXR1().nose_proc >= 0.25));
     const bool externalCoolingActive = (GetXR1().externalcooling_status == DoorStatus::DOOR_OPEN);
     const bool isHatchOpen = (GetXR1().hatch_proc > 0.25);  
-    double loxQty = GetXR1().GetXRLOXMass();  // includes payload LOX as well
-    double o2Level = GetXR1().m_cabinO2Level;   // fraction of O2 in cabin atm
+    const double loxQty = GetXR1().GetXRLOXMass();  // includes payload LOX as well
+    const double o2Level = GetXR1().m_cabinO2Level;   // fraction of O2 in cabin atm
 
     // check for cabin decompression due to open hatch
-    if ((GetXR1().hatch_proc > 0.10) && (GetVessel().GetAtmPressure() < 50e3))
+    if ((GetXR1().hatch_proc > 0.10) && (GetVessel().GetFlightState().GetAtmPressure() < 50e3))
     {
         // decompression!
         GetXR1().ShowHatchDecompression();
@@ -525,47 +461,69 @@ void LOXConsumptionPostStep::clbkPrePostStep(const double simt, const double sim
             if (m_previousAmbientO2Available)
                 GetXR1().ShowInfo("Using Onboard O2.wav", DeltaGliderXR1::ST_InformationCallout, "Using onboard oxygen;&internal O2 flow resumed.");
 
-            // consume oxygen if LOX available (delta will be 0.0 if LOX consumption disabled)
-            if (loxAvailable)
-            {
-                loxQty -= loxConsumptionThisTimestep;
-                if (loxQty < 0)
-                    loxQty = 0;     // prevent underflow
-            }
+            // consume oxygen if LOX available (no flow if LOX consumption disabled); the LOX is consumed by IntegrateConsumablesPostStep.
+            // If the tanks run dry during this frame while being resupplied, consumption is limited to the resupply rate.
+            if (loxAvailable && (loxConsumptionPerSecond > 0))
+                m_loxFlowID = GetXR1().m_consumables.AddFlow(ConsumableTank::LOX, ConsumableTank::External, loxConsumptionPerSecond, false);
 
             // disable A/C sound if LOX exhausted or enable it if LOX available
             GetXR1().XRSoundOnOff(XRSound::AirConditioning, loxAvailable);  // no internal airflow if lox not available
         }
+    }
+
+    // the cabin O2 level is updated by ConsumablesIntegrated below once we know for how long LOX was available this frame
+    m_cabinUpdatePending = true;
+    m_ambientO2Available = ambientO2Available;
+    m_loxAvailable = loxAvailable;
+    m_loxConsumptionPerSecond = loxConsumptionPerSecond;
+}
+
+// Invoked each frame after all LOX flows were integrated
+void LOXConsumptionPostStep::ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt)
+{
+    if (m_cabinUpdatePending == false)
+        return;     // crew is dead or cabin decompressed
+
+    m_cabinUpdatePending = false;
+    double o2Level = GetXR1().m_cabinO2Level;   // fraction of O2 in cabin atm
 
+    // skip these checks the first time through here so that m_previousAmbientO2Available and m_previousO2Level have a chance to initialize
+    if (m_previousO2Level > 0)
+    {
         //
         // Adjust ambient O2 level
         //
-        if (ambientO2Available || loxAvailable)
-        {
-            // increment level if too low
-            if (o2Level < NORMAL_O2_LEVEL)
-            {
-                o2Level += (AMBIENT_O2_REPLENTISHMENT_RATE * simdt);
 
-                // NOTE: do not play callout here; callout already occurred when we crossed the LOC threshold
-                if (o2Level > NORMAL_O2_LEVEL)     
-                    o2Level = NORMAL_O2_LEVEL;  // avoid overrun
-            }
+        // Determine for how many seconds of this frame O2 was flowing; if the LOX tanks ran dry part way through the frame, 
+        // the cabin O2 level rises until then and falls for the rest of the frame.
+        double o2AvailableTime = 0;
+        if (m_ambientO2Available)
+            o2AvailableTime = simdt;
+        else if (m_loxAvailable)
+            o2AvailableTime = ((m_loxFlowID >= 0) ? (consumables.GetFlow(m_loxFlowID).mass / m_loxConsumptionPerSecond) : simdt);  // no flow = LOX consumption disabled
+        o2AvailableTime = min(o2AvailableTime, simdt);  // sanity-check
+
+        // increment level if too low
+        if (o2Level < NORMAL_O2_LEVEL)
+        {
+            o2Level += (AMBIENT_O2_REPLENTISHMENT_RATE * o2AvailableTime);
 
-            // level can never rise above normal, so no need to check it
+            // NOTE: do not play callout here; callout already occurred when we crossed the LOC threshold
+            if (o2Level > NORMAL_O2_LEVEL)     
+                o2Level = NORMAL_O2_LEVEL;  // avoid overrun
         }
-        else    // No O2 replentishment available; using existing cabin air only!
+        // level can never rise above normal, so no need to check it
+
+        // No O2 replentishment available for the rest of the frame; using existing cabin air only!
+        // Only consume cabin air here if LOX consumption enabled 
+        if ((o2AvailableTime < simdt) && (GetXR1().GetXR1Config()->GetLOXConsumptionFraction() > 0.0))
         {
-            // only consume cabin air here if LOX consumption enabled 
-            if (GetXR1().GetXR1Config()->GetLOXConsumptionFraction() > 0.0)
-            {
-                // level falls based on # of crew members AND whether crew is still alive
-                const int crewMembers = GetXR1().GetCrewMembersCount();
+            // level falls based on # of crew members AND whether crew is still alive
+            const int crewMembers = GetXR1().GetCrewMembersCount();
 
-                if (crewMembers > 0)
-                {
-                    o2Level -= (AMBIENT_O2_CONSUMPTION_RATE * crewMembers * simdt);
-                }
+            if (crewMembers > 0)
+            {
+                o2Level -= (AMBIENT_O2_CONSUMPTION_RATE * crewMembers * (simdt - o2AvailableTime));
             }
         }
         
@@ -636,18 +594,62 @@ void LOXConsumptionPostStep::clbkPrePostStep(const double simt, const double sim
     // set new O2 level
     GetXR1().m_cabinO2Level = o2Level;
 
-    // DEBUG: sprintf(oapiDebugString(), "consumptionFraction=%lf, loxConsumptionPerSecond=%lf, loxQty=%lf, m_oxygenRemainingTime=%lf", consumptionFraction, loxConsumptionPerSecond, loxQty, GetXR1().m_oxygenRemainingTime);
-
-    // update LOX remaining time in seconds and quantity
-    // WARNING: must handle loxConsumptionPerSecond = 0 here!
-    GetXR1().m_oxygenRemainingTime = ((loxConsumptionPerSecond <= 0) ? 0 : (loxQty / loxConsumptionPerSecond));
-    GetXR1().SetXRLOXMass(loxQty);
+    // update LOX remaining time in seconds; the LOX quantity itself was already written by IntegrateConsumablesPostStep
+    // WARNING: must handle m_loxConsumptionPerSecond = 0 here!
+    const double loxQty = GetXR1().GetXRLOXMass();
+    GetXR1().m_oxygenRemainingTime = ((m_loxConsumptionPerSecond <= 0) ? 0 : (loxQty / m_loxConsumptionPerSecond));
+    m_loxFlowID = -1;   // flow IDs are only valid for one frame
 
     // save for next timestep
-    m_previousAmbientO2Available = ambientO2Available;
+    m_previousAmbientO2Available = m_ambientO2Available;
     m_previousO2Level = o2Level;
 }
 
+//---------------------------------------------------------------------------
+
+IntegrateConsumablesPostStep::IntegrateConsumablesPostStep(DeltaGliderXR1 &vessel) : 
+    XR1PrePostStep(vessel)
+{
+}
+
+void IntegrateConsumablesPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
+{
+    XRConsumables &consumables = GetXR1().m_consumables;
+
+    // only touch the tanks if something is flowing this frame
+    if (consumables.GetFlowCount() > 0)
+    {
+        // NOTE: these all include the payload bay tanks as well
+        consumables.SetTank(ConsumableTank::Main, GetXR1().GetXRPropellantMass(GetXR1().ph_main), GetXR1().GetXRPropellantMaxMass(GetXR1().ph_main));
+        consumables.SetTank(ConsumableTank::RCS, GetXR1().GetXRPropellantMass(GetXR1().ph_rcs), GetXR1().GetXRPropellantMaxMass(GetXR1().ph_rcs));
+        consumables.SetTank(ConsumableTank::SCRAM, GetXR1().GetXRPropellantMass(GetXR1().ph_scram), GetXR1().GetXRPropellantMaxMass(GetXR1().ph_scram));
+        consumables.SetTank(ConsumableTank::APU, GetXR1().m_apuFuelQty, APU_FUEL_CAPACITY);
+        consumables.SetTank(ConsumableTank::LOX, GetXR1().GetXRLOXMass(), GetXR1().GetXRLOXMaxMass());
+
+        consumables.Integrate(simdt);
+
+        // write each tank that changed back once
+        if (consumables.IsTankChanged(ConsumableTank::Main))
+            GetXR1().SetXRPropellantMass(GetXR1().ph_main, consumables.GetTankMass(ConsumableTank::Main));
+
+        if (consumables.IsTankChanged(ConsumableTank::RCS))
+            GetXR1().SetXRPropellantMass(GetXR1().ph_rcs, consumables.GetTankMass(ConsumableTank::RCS));
+
+        if (consumables.IsTankChanged(ConsumableTank::SCRAM))
+            GetXR1().SetXRPropellantMass(GetXR1().ph_scram, consumables.GetTankMass(ConsumableTank::SCRAM));
+
+        if (consumables.IsTankChanged(ConsumableTank::APU))
+            GetXR1().SetAPUFuelQty(consumables.GetTankMass(ConsumableTank::APU));
+
+        if (consumables.IsTankChanged(ConsumableTank::LOX))
+            GetXR1().SetXRLOXMass(consumables.GetTankMass(ConsumableTank::LOX));  // updates payload LOX as well
+    }
+
+    // listeners are notified every frame so they can stop their sounds, etc. when nothing is flowing
+    consumables.NotifyListeners(simt, simdt);
+    consumables.ClearFlows();
+}
+
 //---------------------------------------------------------------------------
 // NOTE: this must be a PostStep, instead of a PreStep as you might expect, because the Orbiter core seems to refuel the ship AFTER the PreSteps are fired.
 // NOTE: take care to only check the ship's *internal* main fuel tank here, *not* the bay tanks (if any).
@@ -680,7 +682,7 @@ void PreventAutoRefuelPostStep::clbkPrePostStep(const double simt, const double
     }
 
     // allow auto-refueling if the user configured it in the prefs file OR if the ship is NOT landed (i.e., allow fuel MFD refueling in space)
-    if (GetXR1().GetXR1Config()->OrbiterAutoRefuelingEnabled || (!GetXR1().GroundContact()))
+    if (GetXR1().GetXR1Config()->OrbiterAutoRefuelingEnabled || (!GetXR1().GetFlightState().GroundContact()))
         return;     // allow external refueling
     
     // Only disable refueling if:
@@ -766,7 +768,7 @@ void BoilOffPostStep::clbkPrePostStep(const double simt, const double simdt, con
     // 2) there is any MAIN FUEL remaining on board
     double newLevel = 0;  // assume disabled
 
-    if (GetVessel().GroundContact() && (GetVessel().GetPropellantMass(GetXR1().ph_main) > 0))
+    if (GetVessel().GetFlightState().GroundContact() && (GetVessel().GetPropellantMass(GetXR1().ph_main) > 0))
     {
         // Note: if you don't want the exhaust to be visible outside of an atmosphere,
         // define the PARTICLESTREAMSPEC with PARTICLESTREAMSPEC::ATM_PLOG
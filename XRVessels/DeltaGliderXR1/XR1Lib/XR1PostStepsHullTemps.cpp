@@ -47,8 +47,8 @@ void SetHullTempsPostStep::AddHeat(const double simdt)
     //
     if (m_forceTempUpdate || GetXR1().IsOATValid())
     {
-        const double atmPressure = GetVessel().GetAtmPressure();
-        const double airspeed = GetVessel().GetAirspeed();   // check *airspeed* here, not ground speed
+        const double atmPressure = GetVessel().GetFlightState().GetAtmPressure();
+        const double airspeed = GetVessel().GetFlightState().GetAirspeed();   // check *airspeed* here, not ground speed
 
         // compute total heat to be added to the ship
 
@@ -142,9 +142,9 @@ void SetHullTempsPostStep::AddHeat(const double simdt)
         if (m_forceTempUpdate || (degreesK > 0.0))
         {
             const double extTemp = GetXR1().GetExternalTemperature();
-            const double slipAngle = GetVessel().GetSlipAngle();
-            const double altitude = GetVessel().GetAltitude(ALTMODE_GROUND);
-            const double aoa = GetVessel().GetAOA();
+            const double slipAngle = GetVessel().GetFlightState().GetSlipAngle();
+            const double altitude = GetVessel().GetFlightState().GetAltitude(ALTMODE_GROUND);
+            const double aoa = GetVessel().GetFlightState().GetAOA();
 
             // NOSECONE
             // since we have TWO factors affecting the nosecone, cut each effect into pieces
@@ -32,13 +32,16 @@ ResupplyPostStep::ResupplyPostStep(DeltaGliderXR1& vessel) :
     m_prevResupplyEnabledStatus(false), m_prevFuelHatchStatus(DoorStatus::DOOR_CLOSED), m_prevLoxHatchStatus(DoorStatus::DOOR_CLOSED), m_prevExternalCoolingStatus(DoorStatus::DOOR_CLOSED),
     m_refuelingSequenceStartSimt(-1), m_loxSequenceStartSimt(-1), m_externalCoolingSequenceStartSimt(-1),
     m_resupplyStartupTime(5.0), // time in seconds
-    m_prevSimt(-1), m_resupplyMovementFirstDetectedSimt(-1)
+    m_prevSimt(-1), m_resupplyMovementFirstDetectedSimt(-1),
+    m_mainFlowID(-1), m_scramFlowID(-1), m_apuFlowID(-1), m_loxFlowID(-1)
 {
     // create our pressure objects; each line has a slightly different pressure rate
     m_pMainLinePressure = new LinePressure(GetXR1().m_mainExtLinePressure, GetXR1().m_nominalMainExtLinePressure, GetXR1().m_mainSupplyLineStatus, GetXR1().m_mainFuelFlowSwitch, MAIN_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 1.14, GetXR1());
     m_pScramLinePressure = new LinePressure(GetXR1().m_scramExtLinePressure, GetXR1().m_nominalScramExtLinePressure, GetXR1().m_scramSupplyLineStatus, GetXR1().m_scramFuelFlowSwitch, SCRAM_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 1.0, GetXR1());
     m_pApuLinePressure = new LinePressure(GetXR1().m_apuExtLinePressure, GetXR1().m_nominalApuExtLinePressure, GetXR1().m_apuSupplyLineStatus, GetXR1().m_apuFuelFlowSwitch, APU_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 0.92, GetXR1());
     m_pLoxLinePressure = new LinePressure(GetXR1().m_loxExtLinePressure, GetXR1().m_nominalLoxExtLinePressure, GetXR1().m_loxSupplyLineStatus, GetXR1().m_loxFlowSwitch, LOX_SUPPLY_PSI_LIMIT, PRESSURE_MOVEMENT_RATE * 0.86, GetXR1());
+
+    GetXR1().m_consumables.AddListener(this);
 }
 
 ResupplyPostStep::~ResupplyPostStep()
@@ -52,6 +55,9 @@ ResupplyPostStep::~ResupplyPostStep()
 
 void ResupplyPostStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
+    // assume nothing flowing this frame; the Flow* methods below register any flows
+    m_mainFlowID = m_scramFlowID = m_apuFlowID = m_loxFlowID = -1;
+
     // assume coolant NOT flowing; this is reset for each poststep below
     GetXR1().m_isExternalCoolantFlowing = false;
 
@@ -409,160 +415,70 @@ void ResupplyPostStep::PerformRefueling(const double simt, const double simdt, c
 // Invoked at each timestep when fuel flowing into main tank
 void ResupplyPostStep::FlowMainFuel(const double simt, const double simdt, const double mjd)
 {
-    double mainTankQty = GetXR1().GetXRPropellantMass(GetXR1().ph_main);
-    const double mainTankMaxQty = GetXR1().GetXRPropellantMaxMass(GetXR1().ph_main);
-
-    bool haltFlow = false;
-
     // if main tank already full, we cannot refuel a full tank
-    if (mainTankQty >= mainTankMaxQty)
+    if (GetXR1().GetXRPropellantMass(GetXR1().ph_main) >= GetXR1().GetXRPropellantMaxMass(GetXR1().ph_main))
     {
         GetXR1().ShowInfo("Main Fuel Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "Main fuel tanks already full.");
-        haltFlow = true;
+        HaltFlow(GetXR1().m_mainFuelFlowSwitch, AID_MAINSUPPLYLINE_SWITCH, AID_MAINSUPPLYLINE_SWITCH_LED);
+        return;
     }
-    else   // tanks not full yet
-    {
-        // adjust by pressure
-        const double pressureFrac = GetXR1().m_mainExtLinePressure / GetXR1().m_nominalMainExtLinePressure;  // 0...1
-        const double fuelFlowForThisStep = (FUEL_LOAD_RATE * simdt * pressureFrac); // main tank loads with no load fraction (i.e., effectively 1.0)
-
-        mainTankQty += fuelFlowForThisStep;
-
-        // check limits
-        const char* pMsg = nullptr;
-        if (mainTankQty > mainTankMaxQty)  // main tank overflow
-        {
-            mainTankQty = mainTankMaxQty;
-
-            // halt fuel flow ONLY if cross-feed is not set to RCS; i.e., fuel is not draining into the RCS tank
-            if (GetXR1().m_xfeedMode != XFEED_MODE::XF_RCS)
-                haltFlow = true;
 
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
-        }
+    // adjust by pressure
+    const double pressureFrac = GetXR1().m_mainExtLinePressure / GetXR1().m_nominalMainExtLinePressure;  // 0...1
+    const double flowRate = (FUEL_LOAD_RATE * pressureFrac); // main tank loads with no load fraction (i.e., effectively 1.0)
 
-        GetXR1().SetXRPropellantMass(GetXR1().ph_main, mainTankQty);
-    }
-
-    // flow sounds are handled by our caller
+    // Halt fuel flow when the tank fills ONLY if cross-feed is not set to RCS; i.e., fuel is not draining into the RCS tank.
+    // Otherwise the flow keeps the main tank topped off as the cross-feed drains it.
     // NOTE: "main fuel tank full" is handled by our FuelCalloutsPostStep
-    if (haltFlow)
-    {
-        GetXR1().m_mainFuelFlowSwitch = false;
-
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_MAINSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_MAINSUPPLYLINE_SWITCH_LED);
-
-        // flow sound will stop next timestep 
-    }
+    m_mainFlowID = GetXR1().m_consumables.AddFlow(ConsumableTank::External, ConsumableTank::Main, flowRate, (GetXR1().m_xfeedMode != XFEED_MODE::XF_RCS));
 }
 
 // Invoked at each timestep when fuel flowing into scram tank
 void ResupplyPostStep::FlowScramFuel(const double simt, const double simdt, const double mjd)
 {
-    double scramTankQty = GetXR1().GetXRPropellantMass(GetXR1().ph_scram);
-    const double scramTankMaxQty = GetXR1().GetXRPropellantMaxMass(GetXR1().ph_scram);
-
-    bool haltFlow = false;
-
     // if SCRAM tank is hidden and no SCRAM tank present in bay, we cannot flow any fuel to resupply anything
     // Note: if the SCRAM tank is hidden, then by definition we have a payload bay, so no need to check if m_pPayloadBay is null here
     if (GetXR1().m_SCRAMTankHidden && (GetXR1().m_pPayloadBay->GetPropellantMaxMass(PROP_TYPE::PT_SCRAM) <= 0))  // < 0 for sanity check
     {
         GetXR1().ShowWarning(nullptr, DeltaGliderXR1::ST_None, "No SCRAM fuel tank in bay.");
         GetXR1().PlayErrorBeep();
-        haltFlow = true;
-        goto FlowScramFuelExit;
+        HaltFlow(GetXR1().m_scramFuelFlowSwitch, AID_SCRAMSUPPLYLINE_SWITCH, AID_SCRAMSUPPLYLINE_SWITCH_LED);
+        return;
     }
 
     // if scram tank already full, we cannot refuel a full tank
-    if (scramTankQty >= scramTankMaxQty)
+    if (GetXR1().GetXRPropellantMass(GetXR1().ph_scram) >= GetXR1().GetXRPropellantMaxMass(GetXR1().ph_scram))
     {
         GetXR1().ShowInfo("Scram Fuel Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "SCRAM fuel tanks already full.");
-        haltFlow = true;
+        HaltFlow(GetXR1().m_scramFuelFlowSwitch, AID_SCRAMSUPPLYLINE_SWITCH, AID_SCRAMSUPPLYLINE_SWITCH_LED);
+        return;
     }
-    else   // tanks not full yet
-    {
-        // adjust by pressure
-        const double pressureFrac = GetXR1().m_scramExtLinePressure / GetXR1().m_nominalScramExtLinePressure;  // 0...1
-        const double fuelFlowForThisStep = (FUEL_LOAD_RATE * simdt * SCRAM_FLOW_FRACTION * pressureFrac);
-
-        scramTankQty += fuelFlowForThisStep;
 
-        // check limits
-        const char* pMsg = nullptr;
-        if (scramTankQty > scramTankMaxQty)  // scram tank overflow
-        {
-            scramTankQty = scramTankMaxQty;
-            haltFlow = true;
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
-        }
-        GetXR1().SetXRPropellantMass(GetXR1().ph_scram, scramTankQty);
-    }
+    // adjust by pressure
+    const double pressureFrac = GetXR1().m_scramExtLinePressure / GetXR1().m_nominalScramExtLinePressure;  // 0...1
+    const double flowRate = (FUEL_LOAD_RATE * SCRAM_FLOW_FRACTION * pressureFrac);
 
-    // flow sounds are handled by our caller
     // NOTE: "scram fuel tank full" is handled by our FuelCalloutsPostStep
-FlowScramFuelExit:
-    if (haltFlow)
-    {
-        GetXR1().m_scramFuelFlowSwitch = false;
-
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_SCRAMSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_SCRAMSUPPLYLINE_SWITCH_LED);
-
-        // flow sound will stop next timestep 
-    }
+    m_scramFlowID = GetXR1().m_consumables.AddFlow(ConsumableTank::External, ConsumableTank::SCRAM, flowRate, true);
 }
 
 // Invoked at each timestep when fuel flowing into apu tank
 void ResupplyPostStep::FlowApuFuel(const double simt, const double simdt, const double mjd)
 {
-    double apuTankQty = GetXR1().m_apuFuelQty;
-    const double apuTankMaxQty = APU_FUEL_CAPACITY;
-
-    bool haltFlow = false;
-
     // if apu tank already full, we cannot refuel a full tank
-    if (apuTankQty >= apuTankMaxQty)
+    if (GetXR1().m_apuFuelQty >= APU_FUEL_CAPACITY)
     {
         GetXR1().ShowInfo("APU Fuel Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "APU fuel tanks already full.");
-        haltFlow = true;
+        HaltFlow(GetXR1().m_apuFuelFlowSwitch, AID_APUSUPPLYLINE_SWITCH, AID_APUSUPPLYLINE_SWITCH_LED);
+        return;
     }
-    else   // tanks not full yet
-    {
-        // adjust by pressure
-        const double pressureFrac = GetXR1().m_apuExtLinePressure / GetXR1().m_nominalApuExtLinePressure;  // 0...1
-        const double fuelFlowForThisStep = (FUEL_LOAD_RATE * simdt * APU_FLOW_FRACTION * pressureFrac);
-
-        apuTankQty += fuelFlowForThisStep;
-
-        // check limits
-
-        const char* pMsg = nullptr;
-        if (apuTankQty > apuTankMaxQty)  // apu tank overflow
-        {
-            apuTankQty = apuTankMaxQty;
-            haltFlow = true;
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
-        }
 
-        GetXR1().m_apuFuelQty = apuTankQty;
-    }
+    // adjust by pressure
+    const double pressureFrac = GetXR1().m_apuExtLinePressure / GetXR1().m_nominalApuExtLinePressure;  // 0...1
+    const double flowRate = (FUEL_LOAD_RATE * APU_FLOW_FRACTION * pressureFrac);
 
-    // flow sounds are handled by our caller
     // NOTE: "apu fuel tank full" is handled by our FuelCalloutsPostStep
-    if (haltFlow)
-    {
-        GetXR1().m_apuFuelFlowSwitch = false;
-
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_APUSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_APUSUPPLYLINE_SWITCH_LED);
-
-        // flow sound will stop next timestep 
-    }
+    m_apuFlowID = GetXR1().m_consumables.AddFlow(ConsumableTank::External, ConsumableTank::APU, flowRate, true);
 }
 
 // **** LOX Resupply 
@@ -594,52 +510,51 @@ void ResupplyPostStep::PerformLoxResupply(const double simt, const double simdt,
 // Invoked at each timestep when LOX flowing into main tank
 void ResupplyPostStep::FlowLox(const double simt, const double simdt, const double mjd)
 {
-    double loxTankQty = GetXR1().GetXRLOXMass();
-    const double loxTankMaxQty = GetXR1().GetXRLOXMaxMass();
-
-    bool haltFlow = false;
-
     // if main tank already full, we cannot refuel a full tank
-    if (loxTankQty >= loxTankMaxQty)
+    if (GetXR1().GetXRLOXMass() >= GetXR1().GetXRLOXMaxMass())
     {
         GetXR1().ShowInfo("LOX Tanks Full.wav", DeltaGliderXR1::ST_InformationCallout, "LOX fuel tanks already full.");
-        haltFlow = true;
+        HaltFlow(GetXR1().m_loxFlowSwitch, AID_LOXSUPPLYLINE_SWITCH, AID_LOXSUPPLYLINE_SWITCH_LED);
+        return;
     }
-    else   // tanks not full yet
-    {
-        // LOX flow fraction is based on tank capacity AND a minimum flow rate per second * pressureFraction
-        const double pressureFrac = GetXR1().m_loxExtLinePressure / GetXR1().m_nominalLoxExtLinePressure;  // 0...1
-        const double flowRate = max(GetXR1().GetXRLOXMaxMass() * LOX_LOAD_FRAC * pressureFrac, LOX_MIN_FLOW_RATE * pressureFrac);
-        const double loxFlowForThisStep = (flowRate * simdt);  // mass * load rate in TANK FRACTION/SECOND
 
-        loxTankQty += loxFlowForThisStep;
+    // LOX flow fraction is based on tank capacity AND a minimum flow rate per second * pressureFraction
+    const double pressureFrac = GetXR1().m_loxExtLinePressure / GetXR1().m_nominalLoxExtLinePressure;  // 0...1
+    const double flowRate = max(GetXR1().GetXRLOXMaxMass() * LOX_LOAD_FRAC * pressureFrac, LOX_MIN_FLOW_RATE * pressureFrac);
 
-        // check limits
+    // NOTE: "lox fuel tank full" is handled by our FuelCalloutsPostStep
+    m_loxFlowID = GetXR1().m_consumables.AddFlow(ConsumableTank::External, ConsumableTank::LOX, flowRate, true);
+}
 
-        const char* pMsg = nullptr;
-        if (loxTankQty > loxTankMaxQty)  // tank overflow?
-        {
-            loxTankQty = loxTankMaxQty;
-            haltFlow = true;
+// Invoked each frame after all fuel and LOX flows were integrated; turns off the flow switch for any tank that filled this frame.
+void ResupplyPostStep::ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt)
+{
+    if ((m_mainFlowID >= 0) && (consumables.GetFlow(m_mainFlowID).haltReason != XRConsumables::HaltReason::None))
+        HaltFlow(GetXR1().m_mainFuelFlowSwitch, AID_MAINSUPPLYLINE_SWITCH, AID_MAINSUPPLYLINE_SWITCH_LED);
 
-            // no need for a msg here; the FuelCalloutsPostStep will handle it
-        }
+    if ((m_scramFlowID >= 0) && (consumables.GetFlow(m_scramFlowID).haltReason != XRConsumables::HaltReason::None))
+        HaltFlow(GetXR1().m_scramFuelFlowSwitch, AID_SCRAMSUPPLYLINE_SWITCH, AID_SCRAMSUPPLYLINE_SWITCH_LED);
 
-        GetXR1().SetXRLOXMass(loxTankQty);  // updates payload LOX mass as well
-    }
+    if ((m_apuFlowID >= 0) && (consumables.GetFlow(m_apuFlowID).haltReason != XRConsumables::HaltReason::None))
+        HaltFlow(GetXR1().m_apuFuelFlowSwitch, AID_APUSUPPLYLINE_SWITCH, AID_APUSUPPLYLINE_SWITCH_LED);
 
-    // flow sounds are handled by our caller
-    // NOTE: "lox fuel tank full" is handled by our FuelCalloutsPostStep
-    if (haltFlow)
-    {
-        GetXR1().m_loxFlowSwitch = false;
+    if ((m_loxFlowID >= 0) && (consumables.GetFlow(m_loxFlowID).haltReason != XRConsumables::HaltReason::None))
+        HaltFlow(GetXR1().m_loxFlowSwitch, AID_LOXSUPPLYLINE_SWITCH, AID_LOXSUPPLYLINE_SWITCH_LED);
 
-        // refresh the switch and its LED
-        GetXR1().TriggerRedrawArea(AID_LOXSUPPLYLINE_SWITCH);
-        GetXR1().TriggerRedrawArea(AID_LOXSUPPLYLINE_SWITCH_LED);
+    // flow IDs are only valid for one frame
+    m_mainFlowID = m_scramFlowID = m_apuFlowID = m_loxFlowID = -1;
+}
 
-        // flow sound will stop next timestep 
-    }
+// Turn off a resupply flow switch and refresh the switch and its LED
+void ResupplyPostStep::HaltFlow(bool &flowSwitch, const int switchAreaID, const int ledAreaID)
+{
+    flowSwitch = false;
+
+    // refresh the switch and its LED
+    GetXR1().TriggerRedrawArea(switchAreaID);
+    GetXR1().TriggerRedrawArea(ledAreaID);
+
+    // flow sounds are handled by clbkPrePostStep; the flow sound will stop next timestep 
 }
 
 //---------------------------------------------------------------------------
@@ -92,7 +92,7 @@ void NosewheelSteeringPreStep::clbkPrePostStep(const double simt, const double s
     if (GetXR1().gear_status == DoorStatus::DOOR_OPEN)
     {
         // check for ground contact and APU power
-        if (GetVessel().GroundContact() && GetXR1().CheckHydraulicPressure(false, false))   // do not play a message or beep here: this is invoked each timestep
+        if (GetVessel().GetFlightState().GroundContact() && GetXR1().CheckHydraulicPressure(false, false))   // do not play a message or beep here: this is invoked each timestep
         {
             bSteeringEnabled = true;  // steering OK
         }
@@ -140,6 +140,8 @@ class MachCalloutsPreStep : public XR1PrePostStep
 public:
     MachCalloutsPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // callouts only
+    virtual void clbkResync(const double simt) { m_previousMach = -1; }
     
 protected:
     void PlayMach(const double simt, const char *pFilename);
@@ -155,6 +157,7 @@ class AltitudeCalloutsPreStep : public XR1PrePostStep
 public:
     AltitudeCalloutsPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // callouts only
     
 protected:
     void PlayAltitude(const double simt, const char *pFilename);
@@ -199,6 +202,7 @@ class UpdateVesselLightsPreStep : public XR1PrePostStep
 public:
     UpdateVesselLightsPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::NEARBY; }  // cosmetic only
 };
 
 //---------------------------------------------------------------------------
@@ -229,6 +233,7 @@ class RefreshGrappleTargetsInDisplayRangePreStep : public XR1PrePostStep
 public:
     RefreshGrappleTargetsInDisplayRangePreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // updates the payload screen only
 
 protected:
     double m_lastUpdateSystemUptime;  // used to manage refresh intervals
@@ -243,6 +248,7 @@ class RotateWheelsPreStep : public XR1PrePostStep
 public:
     RotateWheelsPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::NEARBY; }  // cosmetic only
 
 protected:
     void SetWheelRotVel(const double simdt, const double groundSpeed, const bool isWheelOnGround, double &wheelRotationVelocity);
@@ -276,6 +282,7 @@ class ScramjetSoundPreStep : public XR1PrePostStep
 public:
     ScramjetSoundPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // sound only
 };
 
 //---------------------------------------------------------------------------
@@ -291,6 +298,7 @@ public:
         const bool playRCS);
 
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::FOCUS; }  // sound only
 
 protected:
     const bool m_playMain;
@@ -319,6 +327,7 @@ class RefreshSlotStatesPreStep : public XR1PrePostStep
 public:
     RefreshSlotStatesPreStep(DeltaGliderXR1 &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::DISTANT; }  // needed before the pilot switches to us
 
 private:
     double m_nextRefreshSimt;   // simt when we should perform the next rescan 
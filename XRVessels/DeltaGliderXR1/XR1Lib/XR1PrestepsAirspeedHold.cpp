@@ -109,7 +109,7 @@ void AirspeedHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
 
         // get our airspeed in meters per second
         // NOTE: this autopilot really only works in an atmosphere
-        const double currentAirspeed = GetVessel().GetAirspeed();  // in m/s
+        const double currentAirspeed = GetVessel().GetFlightState().GetAirspeed();  // in m/s
 
         // DEBUG: sprintf(oapiDebugString(), "maxMainThrust=%lf, zWeight=%lf, diff=%lf", maxMainThrust, zWeight, (maxMainThrust - zWeight));
 
@@ -139,7 +139,7 @@ void AirspeedHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         double targetAcc = (velDelta * velDeltaMultiplier); // target acc range is [velDelta * (n >= 0.5)] m/s/s
 
         // WORKAROUND: If grounded and the SET rate == 0, prevent planetAcc from being NEGATIVE here, since it induces thruster oscillations on the ground
-        if (GetVessel().GroundContact() && (GetXR1().m_setAirspeed == 0) && (planetAcc < 0))
+        if (GetVessel().GetFlightState().GroundContact() && (GetXR1().m_setAirspeed == 0) && (planetAcc < 0))
             planetAcc = 0;
 
         // Determine effective acc required to maintain the requested acc (m/s/s); this takes gravity, drag, and our mass into account
@@ -172,7 +172,7 @@ void AirspeedHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
             retroThLevel = 1;
 
         // NOTE: retros only fire if dynamic pressre < 5 kPa
-        const double dynamicPressure = GetVessel().GetDynPressure() / 1000;  // convert to kPa
+        const double dynamicPressure = GetVessel().GetFlightState().GetDynPressure() / 1000;  // convert to kPa
         if (dynamicPressure > 5.0)
             retroThLevel = 0;       // do not fire the retros
 
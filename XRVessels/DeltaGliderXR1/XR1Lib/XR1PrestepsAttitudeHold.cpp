@@ -98,12 +98,12 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         //  y = yaw (slip angle)
         //  z = roll
         VECTOR3 angularVelocity;
-        GetVessel().GetAngularVel(angularVelocity);
+        GetVessel().GetFlightState().GetAngularVel(angularVelocity);
         angularVelocity *= DEG; // convert to degrees
 
         // handle BANK
         double targetBank = (descentHoldActive ? 0 : GetXR1().m_setBank);             // in degrees; -180 to +180
-        const double currentBank = GetVessel().GetBank() * DEG;   // in degrees
+        const double currentBank = GetVessel().GetFlightState().GetBank() * DEG;   // in degrees
 
         //
         // handle *inverted* attitude hold
@@ -178,8 +178,8 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
             if ((descentHoldActive == false) && GetXR1().m_holdAOA)
             {
                 // trying to hold AOA
-                const double currentPitch = GetVessel().GetPitch() * DEG;   // in degrees
-                const double currentAOA = GetVessel().GetAOA() * DEG;       // in degrees
+                const double currentPitch = GetVessel().GetFlightState().GetPitch() * DEG;   // in degrees
+                const double currentAOA = GetVessel().GetFlightState().GetAOA() * DEG;       // in degrees
                 const double targetAOA = GetXR1().m_setPitchOrAOA;          // in degrees
 
                 // SPECIAL CHECK: if current PITCH is outside the MAX_ATTITUDE_HOLD_NORMAL range, hold on the pitch boundary and do not try to continue pitching the ship!
@@ -209,7 +209,7 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
             else  // holding PITCH
             {
                 const double targetPitch = (descentHoldActive ? 0 : GetXR1().m_setPitchOrAOA);  // in degrees
-                const double currentPitch = GetVessel().GetPitch() * DEG;   // in degrees
+                const double currentPitch = GetVessel().GetFlightState().GetPitch() * DEG;   // in degrees
                 // Note: always invert thruster rotation vs. angular velocity since we're holding since we're holding PITCH here
                 requestedColShift = FireThrusterGroups(targetPitch, currentPitch, angularVelocity.x, ttPitchUp, ttPitchDown, simdt, 20.0, true, isInverted, AXIS::PITCH);
             }
@@ -278,7 +278,7 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
                     }
 
                     // do not perform COL if we are on the ground
-                    if (GetVessel().GroundContact() == false)
+                    if (GetVessel().GetFlightState().GroundContact() == false)
                     {
                         // perform the COL shift, keeping it in range
                         GetXR1().ShiftCenterOfLift(requestedColShift);
@@ -331,7 +331,7 @@ void AttitudeHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
 
         // treat rudder as active only if dynamic pressure >= 5.0 kPa
         const bool rudderActive = ((GetVessel().GetControlSurfaceLevel(AIRCTRL_RUDDER) != 0) &&
-            (GetVessel().GetDynPressure() >= 5.0e3));
+            (GetVessel().GetFlightState().GetDynPressure() >= 5.0e3));
         /* DEBUG
         if (rudderActive)
             sprintf(oapiDebugString(), "RUDDER ACTIVE: %lf", GetVessel().GetControlSurfaceLevel(AIRCTRL_RUDDER));
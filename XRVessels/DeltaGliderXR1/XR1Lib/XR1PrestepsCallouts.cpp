@@ -33,8 +33,8 @@ TakeoffAndLandingCalloutsAndCrashPreStep::TakeoffAndLandingCalloutsAndCrashPreSt
 void TakeoffAndLandingCalloutsAndCrashPreStep::clbkPrePostStep(const double simt, const double simdt, const double mjd)
 {
     static const double airborneTriggerTime = 0.5;				// assume airborne 1/2-second after wheels-up
-    const double airspeed = GetVessel().GetAirspeed();
-    const double groundspeed = GetVessel().GetGroundspeed();
+    const double airspeed = GetVessel().GetFlightState().GetAirspeed();
+    const double groundspeed = GetVessel().GetFlightState().GetGroundspeed();
 
     // SPECIAL CASE: if config file could not be parsed, blink the warning message continuously
     if (GetXR1().GetXR1Config()->ParseFailed())
@@ -68,9 +68,9 @@ void TakeoffAndLandingCalloutsAndCrashPreStep::clbkPrePostStep(const double simt
     // if gear compression in a subclass vessel is present) is that the pilot can cut his engines once his wheels touch and he is guaranteed 
     // that he will not collapse his gear *if* the gear doesn't collapse when it first touches down.  In other words, the gear can "absorb" a certain amount of 
     // touchdown rate, which is exactly what we want to model.
-    if ((GetVessel().GroundContact() || GetXR1().GetGearFullyUncompressedAltitude() <= 0.0))
+    if ((GetVessel().GetFlightState().GroundContact() || GetXR1().GetGearFullyUncompressedAltitude() <= 0.0))
     {
-        const double atmPressure = GetVessel().GetAtmPressure();
+        const double atmPressure = GetVessel().GetFlightState().GetAtmPressure();
         // If there is an atmosphere AND APU offline AND groundspeed > 5 m/s, show a warning!
         // However, don't check within the first one second of sim time because Orbiter seems to move the vessel slightly on startup.
         if ((groundspeed > 5) && (atmPressure > 0) && (simt > 1.0))
@@ -89,7 +89,7 @@ void TakeoffAndLandingCalloutsAndCrashPreStep::clbkPrePostStep(const double simt
         if (GetXR1().m_takeoffTime > 0)
         {
             VECTOR3 asVector;
-            GetXR1().GetAirspeedVector(FRAME_HORIZON, asVector);
+            GetXR1().GetFlightState().GetAirspeedVector(FRAME_HORIZON, asVector);
 
             double touchdownVerticalSpeed = -(asVector.y);  // in m/s
             double previousFrameVerticalSpeed = -GetXR1().m_preStepPreviousVerticalSpeed;    // in m/s
@@ -137,26 +137,26 @@ void TakeoffAndLandingCalloutsAndCrashPreStep::clbkPrePostStep(const double simt
 
             // check bank and pitch (meaning, wheels did not touch down cleanly)
             // NOTE: for now, treat positive and negative pitch the same
-            if (fabs(GetVessel().GetPitch()) > TOUCHDOWN_MAX_PITCH)
+            if (fabs(GetVessel().GetFlightState().GetPitch()) > TOUCHDOWN_MAX_PITCH)
             {
                 char temp[128];
-                sprintf(temp, "Excessive pitch!&Touchdown Pitch=%.3f degrees", GetVessel().GetPitch() * DEG);
+                sprintf(temp, "Excessive pitch!&Touchdown Pitch=%.3f degrees", GetVessel().GetFlightState().GetPitch() * DEG);
                 GetXR1().DoGearCollapse(temp, touchdownVerticalSpeed, true);  // move landing gear animation
                 goto resetForGroundMode;
             }
 
-            if (GetVessel().GetPitch() < TOUCHDOWN_MIN_PITCH)
+            if (GetVessel().GetFlightState().GetPitch() < TOUCHDOWN_MIN_PITCH)
             {
                 char temp[128];
-                sprintf(temp, "Insufficient pitch!&Touchdown Pitch=%.3f degrees&Minimum pitch=%.3f degrees", (GetVessel().GetPitch() * DEG), TOUCHDOWN_MIN_PITCH);
+                sprintf(temp, "Insufficient pitch!&Touchdown Pitch=%.3f degrees&Minimum pitch=%.3f degrees", (GetVessel().GetFlightState().GetPitch() * DEG), TOUCHDOWN_MIN_PITCH);
                 GetXR1().DoGearCollapse(temp, touchdownVerticalSpeed, true);  // move landing gear animation
                 goto resetForGroundMode;
             }
 
-            if (fabs(GetVessel().GetBank()) > TOUCHDOWN_BANK_LIMIT)
+            if (fabs(GetVessel().GetFlightState().GetBank()) > TOUCHDOWN_BANK_LIMIT)
             {
                 char temp[128];
-                sprintf(temp, "Excessive bank!&Touchdown Bank=%.3f degrees", GetVessel().GetBank() * DEG);
+                sprintf(temp, "Excessive bank!&Touchdown Bank=%.3f degrees", GetVessel().GetFlightState().GetBank() * DEG);
                 GetXR1().DoGearCollapse(temp, touchdownVerticalSpeed, true);    // move landing gear animation
                 goto resetForGroundMode;
             }
@@ -369,8 +369,8 @@ void MachCalloutsPreStep::clbkPrePostStep(const double simt, const double simdt,
     if (GetXR1().IsCrewIncapacitatedOrNoPilotOnBoard())  // covers IsCrashed() as well
         return;     // no callouts if crashed
 
-    const double mach = GetVessel().GetMachNumber();
-    const bool groundContact = GetVessel().GroundContact();
+    const double mach = GetVessel().GetFlightState().GetMachNumber();
+    const bool groundContact = GetVessel().GetFlightState().GroundContact();
 
     if (!groundContact && (mach <= 0))  // prevent resets when on ground
     {
@@ -463,8 +463,8 @@ void AltitudeCalloutsPreStep::clbkPrePostStep(const double simt, const double si
 
      // get our vertical speed in meters per second
     VECTOR3 v;
-    GetXR1().GetAirspeedVector(FRAME_HORIZON, v);
-    const double currentDescentRate = (GetVessel().GroundContact() ? 0 : v.y);      // in m/s
+    GetXR1().GetFlightState().GetAirspeedVector(FRAME_HORIZON, v);
+    const double currentDescentRate = (GetVessel().GetFlightState().GroundContact() ? 0 : v.y);      // in m/s
 
    // if descending at > 0.25 m/s/s below 275 meters, warn pilot if gear is fully up; do NOT warn him if gear is in motion OR if the ship 
    // is below standard "wheels-down" altitude.
@@ -129,8 +129,8 @@ void DescentHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
         const double timeAcc = oapiGetTimeAcceleration();
 
         // wait until the ship is level: handled by the AttitudeHold autpilot
-        const double currentBank = GetVessel().GetBank() * DEG;     // in degrees
-        const double currentPitch = GetVessel().GetPitch() * DEG;   // in degrees
+        const double currentBank = GetVessel().GetFlightState().GetBank() * DEG;     // in degrees
+        const double currentPitch = GetVessel().GetFlightState().GetPitch() * DEG;   // in degrees
 
         if ((fabs(currentBank) > 5) || (fabs(currentPitch) > 5))
             return;     // ship not level yet
@@ -244,8 +244,8 @@ void DescentHoldPreStep::clbkPrePostStep(const double simt, const double simdt,
 
         // get our vertical speed in meters per second
         VECTOR3 v;
-        GetXR1().GetAirspeedVector(FRAME_HORIZON, v);
-        const double currentDescentRate = (GetVessel().GroundContact() ? 0 : v.y);      // in m/s
+        GetXR1().GetFlightState().GetAirspeedVector(FRAME_HORIZON, v);
+        const double currentDescentRate = (GetVessel().GetFlightState().GroundContact() ? 0 : v.y);      // in m/s
 
         // determine what rate of change (acc) we need in order to hit our target rate in a reasonable timeframe
         // A targetAcc of zero will hold the current descent rate; i.e., the ship will not be accelerated vertically
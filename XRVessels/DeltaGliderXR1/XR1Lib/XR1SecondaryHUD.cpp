@@ -21,6 +21,7 @@
 
 #include "DeltaGliderXR1.h"
 #include "XR1HUD.h"
+#include "XRNumberFormat.h"
 
 // ==============================================================
 
@@ -228,11 +229,11 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         {
             // altitude will never be negative here
             if (value >= 1e7)   // >= 10 million meters (10,000 km)?
-                sprintf(valueStr, "%.2lf mm", (value / 1e6));
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e6, 2, XR_UNIT::MEGAMETERS);
             else if (value >= 3e4)   // >= 30 km?
-                sprintf(valueStr, "%.3lf km", (value / 1e3));
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e3, 3, XR_UNIT::KILOMETERS);
             else
-                sprintf(valueStr, "%.2lf m", value);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2, XR_UNIT::METERS);
         }
         else    // imperial
         {
@@ -240,11 +241,11 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
             // handle large mile distances here
             const double distInMiles = (value / 5280);
             if (fabs(distInMiles) >= 1e6)   // >= 1 million miles?
-                sprintf(valueStr, "%.3lf mmi", (distInMiles / 1e6));  // do not clip
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), distInMiles / 1e6, 3, XR_UNIT::MEGAMILES);  // do not clip
             else if (value > 407e3)  // > 407000 ft?
-                sprintf(valueStr, "%.2lf mi", distInMiles);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), distInMiles, 2, XR_UNIT::MILES);
             else
-                sprintf(valueStr, "%.2lf ft", value);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2, XR_UNIT::FEET);
         }
         break;
 
@@ -253,17 +254,17 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         // velocity will never be negative 
         if (units == Units::u_met) // metric
         {
-            sprintf(valueStr, "%.1lf m/s", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 1, XR_UNIT::METERS_PER_SEC);
         }
         else if (units == Units::u_imp)   // imperial
         {
             value = MpsToMph(value);
-            sprintf(valueStr, "%.1lf mph", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 1, XR_UNIT::MPH);
         }
         else if (units == Units::u_M)
         {
             value = GetXR1().GetMachNumber();
-            sprintf(valueStr, "%.3lf Mach", value);  // cap @ 11 characters here b/c of clipping issue with "mach"
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::MACH);  // cap @ 11 characters here b/c of clipping issue with "mach"
         }
         break;
 
@@ -273,12 +274,12 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         value = ((fieldID == FieldID::StatP) ? GetXR1().GetAtmPressure() : GetXR1().GetDynPressure());
         if (units == Units::u_met) // metric
         {
-            sprintf(valueStr, "%.4lf kPa", (value / 1000));
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1000, 4, XR_UNIT::KPA);
         }
         else // imperial
         {
             value = PaToPsi(value);
-            sprintf(valueStr, "%.4lf psi", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::PSI);
         }
         break;
 
@@ -286,17 +287,17 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         value = GetXR1().GetExternalTemperature();   // Kelvin
         if (units == Units::u_K)
         {
-            sprintf(valueStr, "%.4lf K", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::KELVIN);
         }
         else if (units == Units::u_C)
         {
             value = KelvinToCelsius(value);
-            sprintf(valueStr, "%.4lf C", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::CELSIUS);
         }
         else    // Fahrenheit
         {
             value = KelvinToFahrenheit(value);
-            sprintf(valueStr, "%.4lf F", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::FAHRENHEIT);
         }
         break;
 
@@ -307,7 +308,7 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
             sprintf(valueStr, "---");
         else
         {
-            sprintf(valueStr, "%.3lf", (value * DEG));
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value * DEG, 3, XR_UNIT::DEGREES);
         }
     }
     break;
@@ -319,12 +320,12 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         value = (GetXR1().GroundContact() ? 0 : v.y);      // in m/s
         if (units == Units::u_met) // metric
         {
-            sprintf(valueStr, "%+.2lf m/s", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2, XR_UNIT::METERS_PER_SEC, true);
         }
         else // imperial
         {
             value = MetersToFeet(value);    // feet per second
-            sprintf(valueStr, "%+.2lf fps", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2, XR_UNIT::FEET_PER_SEC, true);
         }
     }
     break;
@@ -343,47 +344,47 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
 
         if (units == Units::u_met)  // metric
         {
-            sprintf(valueStr, "%.4lf m/s", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::METERS_PER_SEC2);
         }
         else if (units == Units::u_imp)    // imperial
         {
             value = MetersToFeet(value);
-            sprintf(valueStr, "%.4lf fps", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::FEET_PER_SEC2);
         }
         else  // G
         {
             value = Mps2ToG(value);
-            sprintf(valueStr, "%.6lf G", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 6, XR_UNIT::G);
         }
     }
     break;
 
     case FieldID::Mass:
         value = GetXR1().GetMass(); // in kg
-        const char* pFormatStr;
+        int decimals;
         if (units == Units::u_met) // metric
         {
             if (value > 999999.9)
-                pFormatStr = "%.1lf kg";
+                decimals = 1;
             else if (value > 99999.9)
-                pFormatStr = "%.2lf kg";
+                decimals = 2;
             else
-                pFormatStr = "%.3lf kg";
+                decimals = 3;
 
-            sprintf(valueStr, "%.3lf kg", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::KG);
         }
         else    // imperial
         {
             value = KgToPounds(value);
 
             if (value > 999999.9)
-                pFormatStr = "%.1lf lb";
+                decimals = 1;
             else if (value > 99999.9)
-                pFormatStr = "%.2lf lb";
+                decimals = 2;
             else
-                pFormatStr = "%.3lf lb";
+                decimals = 3;
 
-            sprintf(valueStr, pFormatStr, value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, decimals, XR_UNIT::POUNDS);
         }
         break;
 
@@ -392,7 +393,7 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         ELEMENTS e;
         GetVessel().GetElements(nullptr, e, nullptr, 0, FRAME_EQU);  // this is only expensive on the first call to it in this frame
         value = e.e;
-        sprintf(valueStr, "%.5lf", value);
+        XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 5);
     }
     break;
 
@@ -401,7 +402,7 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         ELEMENTS e;
         GetVessel().GetElements(nullptr, e, nullptr, 0, FRAME_EQU);
         value = e.i * DEG;  // in degrees
-        sprintf(valueStr, "%.4lf", value);  // reduce to 11 chars for slight clipping issue
+        XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 4, XR_UNIT::DEGREES);  // reduce to 11 chars for slight clipping issue
     }
     break;
 
@@ -421,11 +422,11 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         }
 
         if (fabs(value) >= 1e7)  // >= 10,000,000 seconds?
-            sprintf(valueStr, "%.4lf M", (value / 1e6));
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e6, 4, 0, false, " M");
         else if (fabs(value) >= 1e4)  // >= 10,000 seconds?
-            sprintf(valueStr, "%.4lf K", (value / 1e3));
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e3, 4, 0, false, " K");
         else
-            sprintf(valueStr, "%.2lf", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2);
     }
     break;
 
@@ -459,13 +460,13 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         if (units == Units::u_met)     // metric
         {
             if (fabs(value) >= 1e9)
-                sprintf(valueStr, "%.2lf gm", (value / 1e9));
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e9, 2, XR_UNIT::GIGAMETERS);
             else if (fabs(value) >= 1e7)   // >= 10,000 km?
-                sprintf(valueStr, "%.2lf mm", (value / 1e6));
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e6, 2, XR_UNIT::MEGAMETERS);
             else if (fabs(value) >= 1e3)
-                sprintf(valueStr, "%.2lf km", (value / 1e3));
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1e3, 2, XR_UNIT::KILOMETERS);
             else
-                sprintf(valueStr, "%.2lf m", value);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2, XR_UNIT::METERS);
         }
         else   // imperial
         {
@@ -475,13 +476,13 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
             // handle large mile distances here
             const double distInMiles = (value / 5280);
             if (fabs(distInMiles) >= 1e9)   // >= 1 billion miles?
-                sprintf(valueStr, "%.3lf gmi", (distInMiles / 1e9));  // do not clip
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), distInMiles / 1e9, 3, XR_UNIT::GIGAMILES);  // do not clip
             else if (fabs(distInMiles) >= 1e6)   // >= 1 million miles?
-                sprintf(valueStr, "%.3lf mmi", (distInMiles / 1e6));  // do not clip
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), distInMiles / 1e6, 3, XR_UNIT::MEGAMILES);  // do not clip
             else if (fabs(value) >= 1e5)  // >= 100,000 feet?
-                sprintf(valueStr, "%.2lf mi", distInMiles);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), distInMiles, 2, XR_UNIT::MILES);
             else
-                sprintf(valueStr, "%.2lf ft", value);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 2, XR_UNIT::FEET);
         }
     }
     break;
@@ -503,7 +504,7 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
             value = GetVessel().GetAOA();
 
         value *= DEG;   // convert to degrees
-        sprintf(valueStr, "%+.3lf", value);
+        XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::DEGREES, true);
         break;
 
     case FieldID::Long:
@@ -598,16 +599,16 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
         if (value >= 1000)
         {
             if (units == Units::u_met)
-                sprintf(valueStr, "%.3lf kN", value / 1000);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1000, 3, XR_UNIT::KILONEWTONS);
             else  // imperial
-                sprintf(valueStr, "%.3lf kLb", value / 1000);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value / 1000, 3, XR_UNIT::KILOPOUNDS);
         }
         else    // RCS thrust is very small
         {
             if (units == Units::u_met)
-                sprintf(valueStr, "%.3lf N", value);
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::NEWTONS);
             else  // imperial
-                sprintf(valueStr, "%.3lf lb", NewtonsToPounds(value));
+                XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), NewtonsToPounds(value), 3, XR_UNIT::POUNDS);
         }
     }
     break;
@@ -634,17 +635,17 @@ void SecondaryHUDArea::PopulateCell(SecondaryHUDMode::Cell& cell)
 
         if (units == Units::u_K)
         {
-            sprintf(valueStr, "%.3lf K", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::KELVIN);
         }
         else if (units == Units::u_C)
         {
             value = KelvinToCelsius(value);
-            sprintf(valueStr, "%.3lf C", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::CELSIUS);
         }
         else    // Fahrenheit
         {
             value = KelvinToFahrenheit(value);
-            sprintf(valueStr, "%.3lf F", value);
+            XRNumberFormat::FormatDouble(valueStr, sizeof(valueStr), value, 3, XR_UNIT::FAHRENHEIT);
         }
     }
     break;
@@ -257,12 +257,12 @@ void DeltaGliderXR1::clbkSetClassCaps(FILEHANDLE cfg)
     // ********************* aerodynamics ***********************
 
     // NOTE: org values were causing nasty downward pitch in the atmospehere: 
-    hwing = CreateAirfoil3(LIFT_VERTICAL, _V(m_wingBalance, 0, m_centerOfLift), DeltaGliderXR1::VLiftCoeff, nullptr, 5, WING_AREA, WING_ASPECT_RATIO);
+    hwing = CreateAirfoil3(LIFT_VERTICAL, _V(m_wingBalance, 0, m_centerOfLift), AeroCoeffTable::AirfoilCoeffFunc, GetVLiftCoeffTable(), 5, WING_AREA, WING_ASPECT_RATIO);
 
     ReinitializeDamageableControlSurfaces();  // create ailerons, elevators, and elevator trim
 
     // vertical stabiliser and body lift and drag components
-    CreateAirfoil3(LIFT_HORIZONTAL, _V(0, 0, -4), DeltaGliderXR1::HLiftCoeff, nullptr, 5, 15, 1.5);
+    CreateAirfoil3(LIFT_HORIZONTAL, _V(0, 0, -4), AeroCoeffTable::AirfoilCoeffFunc, GetHLiftCoeffTable(), 5, 15, 1.5);
     CreateControlSurface(AIRCTRL_RUDDER, 0.8, 1.5, _V(0, 0, -7.2), AIRCTRL_AXIS_YPOS, anim_rudder);
 
     // Create a hidden elevator trim to fix the nose-up tendency on liftoff and allow the elevator trim to be truly neutral.
@@ -293,7 +293,7 @@ void DeltaGliderXR1::clbkSetClassCaps(FILEHANDLE cfg)
 
     // default to full LOX INTERNAL tank if not loaded from save file 
     if (m_loxQty < 0)
-        m_loxQty = GetXR1Config()->GetMaxLoxMass();
+        SetInternalLOXQty(GetXR1Config()->GetMaxLoxMass());
 
     // angular damping
 
@@ -405,30 +405,30 @@ void DeltaGliderXR1::clbkSetClassCaps(FILEHANDLE cfg)
     m_pActiveAirlockDoorStatus = &olock_status;
 
     //
-    // Initialize and cache all instrument panels
+    // Register all instrument panels; each panel is constructed the first time it is loaded
     //
 
     // 1920-pixel-wide panels
-    AddInstrumentPanel(new XR1MainInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR1UpperInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR1LowerInstrumentPanel1920(*this), 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR1MainInstrumentPanel1920, DeltaGliderXR1>(*this), PANEL_MAIN, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR1UpperInstrumentPanel1920, DeltaGliderXR1>(*this), PANEL_UPPER, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR1LowerInstrumentPanel1920, DeltaGliderXR1>(*this), PANEL_LOWER, 1920);
 
     // 1600-pixel-wide panels
-    AddInstrumentPanel(new XR1MainInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR1UpperInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR1LowerInstrumentPanel1600(*this), 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR1MainInstrumentPanel1600, DeltaGliderXR1>(*this), PANEL_MAIN, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR1UpperInstrumentPanel1600, DeltaGliderXR1>(*this), PANEL_UPPER, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR1LowerInstrumentPanel1600, DeltaGliderXR1>(*this), PANEL_LOWER, 1600);
 
     // 1280-pixel-wide panels
-    AddInstrumentPanel(new XR1MainInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR1UpperInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR1LowerInstrumentPanel1280(*this), 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR1MainInstrumentPanel1280, DeltaGliderXR1>(*this), PANEL_MAIN, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR1UpperInstrumentPanel1280, DeltaGliderXR1>(*this), PANEL_UPPER, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR1LowerInstrumentPanel1280, DeltaGliderXR1>(*this), PANEL_LOWER, 1280);
 
     // add our VC panels (panel width MUST be zero for these!)
-    AddInstrumentPanel(new XR1VCPilotInstrumentPanel(*this, PANELVC_PILOT), 0);
-    AddInstrumentPanel(new XR1VCPassenger1InstrumentPanel(*this, PANELVC_PSNGR1), 0);
-    AddInstrumentPanel(new XR1VCPassenger2InstrumentPanel(*this, PANELVC_PSNGR2), 0);
-    AddInstrumentPanel(new XR1VCPassenger3InstrumentPanel(*this, PANELVC_PSNGR3), 0);
-    AddInstrumentPanel(new XR1VCPassenger4InstrumentPanel(*this, PANELVC_PSNGR4), 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR1VCPilotInstrumentPanel, DeltaGliderXR1>(*this, PANELVC_PILOT), PANELVC_PILOT, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR1VCPassenger1InstrumentPanel, DeltaGliderXR1>(*this, PANELVC_PSNGR1), PANELVC_PSNGR1, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR1VCPassenger2InstrumentPanel, DeltaGliderXR1>(*this, PANELVC_PSNGR2), PANELVC_PSNGR2, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR1VCPassenger3InstrumentPanel, DeltaGliderXR1>(*this, PANELVC_PSNGR3), PANELVC_PSNGR3, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR1VCPassenger4InstrumentPanel, DeltaGliderXR1>(*this, PANELVC_PSNGR4), PANELVC_PSNGR4, 0);
 
     // NOTE: default crew data is set AFTER the scenario file is parsed
 }
@@ -505,6 +505,7 @@ void DeltaGliderXR1::clbkPostCreation()
     AddPostStep(new XFeedPostStep(*this));
     AddPostStep(new ResupplyPostStep(*this));
     AddPostStep(new LOXConsumptionPostStep(*this));
+    AddPostStep(new IntegrateConsumablesPostStep(*this));   // must follow all PostSteps that register fuel or LOX flows
     AddPostStep(new UpdateCoolantTempPostStep(*this));
     AddPostStep(new AirlockDecompressionPostStep(*this));
     AddPostStep(new AutoCenteringSimpleButtonAreasPostStep(*this));  // logic for all auto-centering button areas
@@ -529,6 +530,11 @@ void DeltaGliderXR1::clbkPostCreationCommonXRCode()
 
     SetGearParameters(gear_proc);
 
+    // Load each mass budget item; from here on, the code that changes an item updates it.
+    SetMassBudgetItem(MASS_ITEM::STRUCTURE, EMPTY_MASS);   // a cheatcode may have changed this
+    RefreshCrewMass();
+    SetMassBudgetItem(MASS_ITEM::APU_FUEL, m_apuFuelQty);
+    SetMassBudgetItem(MASS_ITEM::LOX, m_loxQty);
     SetEmptyMass();     // update mass for passengers, APU fuel, O2, etc.
 
     // set default crew members if no UMmu crew data loaded from scenario file
@@ -549,6 +555,7 @@ void DeltaGliderXR1::clbkPostCreationCommonXRCode()
             UMmu.AddCrewMember(pCM->name, pCM->age, pCM->pulse, pCM->mass, misc);
 #endif
         }
+        RefreshCrewMass();
     }
 
     // ENHANCEMENT: init correct defaults if no scenario file loaded
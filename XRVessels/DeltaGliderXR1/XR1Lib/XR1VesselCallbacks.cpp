@@ -176,259 +176,72 @@ void DeltaGliderXR1::clbkFocusChanged(bool getfocus, OBJHANDLE hNewVessel, OBJHA
     VESSEL3_EXT::clbkFocusChanged(getfocus, hNewVessel, hOldVessel);
 }
 
-// override clbkPanelRedrawEvent so we can limit our refresh rates
-bool DeltaGliderXR1::clbkPanelRedrawEvent(const int areaID, const int event, SURFHANDLE surf)
+// Returns the minimum realtime interval between PANEL_REDRAW_ALWAYS redraws of an area; the active InstrumentPanel
+// schedules the redraws.  Repaint frequency is based on realtime so that it does not vary with time acceleration.
+double DeltaGliderXR1::GetAreaRedrawInterval(const int areaID)
 {
-    // Only filter PANEL_REDRAW_ALWAYS events for timing!
-    if (event == PANEL_REDRAW_ALWAYS)
+    switch (areaID)
     {
-        // NOTE: we want to check *realtime* deltas, not *simulation time* here: repaint frequency should not
-        // vary based on time acceleration.
-        const double uptime = GetSystemUptime();  // will always count up
+    case AID_MULTI_DISPLAY:
+        return GetXR1Config()->MDAUpdateInterval;
 
-        // check for area IDs that have custom refresh rates
-        switch (areaID)
-        {
-        case AID_MULTI_DISPLAY:
-            if (uptime < m_nextMDARefresh)
-                return false;
-
-            // update for next interval
-            m_nextMDARefresh = uptime + GetXR1Config()->MDAUpdateInterval;
-            break;
-
-        case AID_SECONDARY_HUD:
-        {
-            // only delay rendering if the HUD is fully deployed!
-            PopupHUDArea* pHud = static_cast<PopupHUDArea*>(GetArea(PANEL_MAIN, AID_SECONDARY_HUD));  // will never be null
-            if (pHud->GetState() == PopupHUDArea::OnOffState::On)
-            {
-                if (uptime < m_nextSecondaryHUDRefresh)
-                    return false;
-            }
-            else
-            {
-                // else HUD is not fully deployed, so let's refresh it according to the default panel refresh rate rather than each frame so we don't cause a framerate stutter while the HUD is deploying
-                goto panel_default_refresh;
-            }
-
-            // update for next interval
-            m_nextSecondaryHUDRefresh = uptime + GetXR1Config()->SecondaryHUDUpdateInterval;
-            break;
-        }
-
-        case AID_TERTIARY_HUD:
-        {
-            // only delay rendering if the HUD is fully deployed!
-            PopupHUDArea* pHud = static_cast<PopupHUDArea*>(GetArea(PANEL_MAIN, AID_TERTIARY_HUD));  // will never be null
-            if (pHud->GetState() == PopupHUDArea::OnOffState::On)
-            {
-                if (uptime < m_nextTertiaryHUDRefresh)
-                    return false;
-            }
-            else
-            {
-                // else HUD is not fully deployed, so let's refresh it according to the default panel refresh rate rather than each frame so we don't cause a framerate stutter while the HUD is deploying
-                goto panel_default_refresh;
-            }
-
-            // update for next interval
-            m_nextTertiaryHUDRefresh = uptime + GetXR1Config()->TertiaryHUDUpdateInterval;
-            break;
-        }
-
-        case AID_HORIZON:
-        {
-            if (uptime < m_nextArtificialHorizonRefresh)
-                return false;
+    // Only throttle the popup HUDs when fully deployed; while a HUD is deploying, refresh it according to the default 
+    // panel refresh rate rather than its own so we don't cause a framerate stutter.
+    // NOTE: the main panel is only null here if it has not been displayed yet.  FindArea does not pin the main panel,
+    // since this is invoked on every frame by whichever panel is active.
+    case AID_SECONDARY_HUD:
+    {
+        const PopupHUDArea *pHUD = static_cast<PopupHUDArea*>(FindArea(PANEL_MAIN, AID_SECONDARY_HUD));
+        if ((pHUD != nullptr) && (pHUD->GetState() == PopupHUDArea::OnOffState::On))
+            return GetXR1Config()->SecondaryHUDUpdateInterval;
+        break;
+    }
 
-            // update for next interval
-            m_nextArtificialHorizonRefresh = uptime + GetXR1Config()->ArtificialHorizonUpdateInterval;
-            break;
-        }
+    case AID_TERTIARY_HUD:
+    {
+        const PopupHUDArea *pHUD = static_cast<PopupHUDArea*>(FindArea(PANEL_MAIN, AID_TERTIARY_HUD));
+        if ((pHUD != nullptr) && (pHUD->GetState() == PopupHUDArea::OnOffState::On))
+            return GetXR1Config()->TertiaryHUDUpdateInterval;
+        break;
+    }
 
-        default:
-        panel_default_refresh:
-            // defensive code: if GetXR1Config()->PanelUpdateInterval == 0, skip all these checks and just update each frame
-            if (GetXR1Config()->PanelUpdateInterval > 0)
-            {
-                // for all other PANEL_REDRAW_ALWAYS components, limit them to a master framerate for the sake of performance (e.g., 60 fps)
-                // retrieve the next uptime for this particular component
-                auto it = m_nextRedrawAlwaysRefreshMap.find(areaID);
-                double* pNextAreaRefresh = nullptr;  // points to it->second in m_nextRedrawAlwaysRefreshMap 
-                if (it != m_nextRedrawAlwaysRefreshMap.end())
-                {
-                    // area has a uptime in the map, so let's test against that
-                    pNextAreaRefresh = &(it->second);
-                }
-                else
-                {
-                    // no refresh uptime in the map yet for this area, so let's add one with a refresh uptime of now (for immediate update)
-                    // Note: pr.first = new map entry, pr.second = insertion status: true if inserted successfully, false if already in map (should never happen here!)
-                    pair<HASHMAP_UINT_DOUBLE::iterator, bool> pr = m_nextRedrawAlwaysRefreshMap.insert(uint_double_Pair(areaID, uptime));
-                    _ASSERTE(pr.second);  // the above insert should always succeed
-                    pNextAreaRefresh = &((pr.first)->second);  // points into uptime of map entry
-                }
-
-                if (uptime < *pNextAreaRefresh)
-                    return false;   // not time to update this area yet
-#if 0 // debug
-                if (areaID == AID_ACC_SCALE)  // arbitrary
-                    sprintf(oapiDebugString(), "uptime=%lf, next AID_ACC_SCALE refresh=%lf", uptime, *pNextAreaRefresh);
-#endif
-                // update this area's nextUpdateSimt for next interval
-                * pNextAreaRefresh = uptime + GetXR1Config()->PanelUpdateInterval;
-                break;
-            }
-        }
-        // DEBUG: sprintf(oapiDebugString(), "uptime=%lf, m_nextTertiaryHUDRefresh=%lf", uptime, m_nextTertiaryHUDRefresh);
+    case AID_HORIZON:
+        return GetXR1Config()->ArtificialHorizonUpdateInterval;
     }
 
-    // let the superclass dispatch the redraw event
-    return VESSEL3_EXT::clbkPanelRedrawEvent(areaID, event, surf);
+    // for all other PANEL_REDRAW_ALWAYS areas, limit them to a master framerate for the sake of performance (e.g., 60 fps)
+    return GetXR1Config()->PanelUpdateInterval;
+}
+
+// The artificial horizon is the pilot's primary attitude reference, so it is the last area deferred by the panel redraw budget.
+REDRAW_PRIORITY DeltaGliderXR1::GetAreaRedrawPriority(const int areaID)
+{
+    return ((areaID == AID_HORIZON) ? REDRAW_PRIORITY::HIGH : REDRAW_PRIORITY::NORMAL);
 }
 
 // --------------------------------------------------------------
 // Respond to playback event
-// NOTE: do not use spaces in any of these event ID strings.
+// Events are dispatched through our playback event table; see RegisterPlaybackEvents.
+// Returns: true if handled, false if not
 // --------------------------------------------------------------
 bool DeltaGliderXR1::clbkPlaybackEvent(double simt, double event_t, const char* event_type, const char* event)
 {
-    if (!_stricmp(event_type, "GEAR"))
-    {
-        ActivateLandingGear(!_stricmp(event, "UP") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "NOSECONE"))
-    {
-        ActivateNoseCone(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "RCOVER"))
-    {
-        ActivateRCover(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "RADIATOR"))
-    {
-        ActivateRadiator(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "AIRBRAKE"))
-    {
-        ActivateAirbrake(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "HATCH"))
-    {
-        ActivateHatch(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "OLOCK"))
-    {
-        ActivateOuterAirlock(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "ILOCK"))
-    {
-        ActivateInnerAirlock(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "LADDER"))
-    {
-        ActivateLadder(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "APU"))
-    {
-        ActivateAPU(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
+    const XRPlaybackEventTable &table = GetPlaybackEventTable();
+    const XR_EVENT_TYPE type = table.Find(event_type);
+    if (type == XR_EVENT_TYPE::NONE)
+        return false;   // not one of ours
+
+    // If this recording has an XR event file, it contains this event as well: it is played back from there.
+    StartXREventPlayback(oapiGetSimMJD());
+    if (m_xrEventPlayer.IsOpen())
         return true;
-    }
-    else if (!_stricmp(event_type, "HOVERDOORS"))
-    {
-        ActivateHoverDoors(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "SCRAMDOORS"))
-    {
-        ActivateScramDoors(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "BAYDOORS"))
-    {
-        ActivateBayDoors(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
-    else if (!_stricmp(event_type, "CHAMBER"))
-    {
-        ActivateChamber((!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING), true);  // OK to force here, although it shouldn't be necessary
-        return true;
-    }
-    // new for the XR1-1.9 release group
-    else if (!_stricmp(event_type, "NAVLIGHT"))
-    {
-        SetNavlight(!_stricmp(event, "ON"));  // true = light on
-        return true;
-    }
-    else if (!_stricmp(event_type, "BEACONLIGHT"))
-    {
-        SetBeacon(!_stricmp(event, "ON"));  // true = light on
-        return true;
-    }
-    else if (!_stricmp(event_type, "STROBELIGHT"))
-    {
-        SetStrobe(!_stricmp(event, "ON"));  // true = light on
-        return true;
-    }
-    else if (!_stricmp(event_type, "RESETMET"))
-    {
-        ResetMET();   // event not used for this
-        return true;
-    }
-    else if (!_stricmp(event_type, "XFEED"))
-    {
-        XFEED_MODE mode;
-        if (!_stricmp(event, "MAIN"))
-            mode = XFEED_MODE::XF_MAIN;
-        else if (!_stricmp(event, "RCS"))
-            mode = XFEED_MODE::XF_RCS;
-        else if (!_stricmp(event, "OFF"))
-            mode = XFEED_MODE::XF_OFF;
-        else  // invalid mode, so ignore it
-        {
-            _ASSERTE(false);
-            return false;
-        }
-        SetCrossfeedMode(mode, nullptr);   // no optional message for this
-        return true;
-    }
-    else if (!_stricmp(event_type, "MAINDUMP"))
-    {
-        m_mainFuelDumpInProgress = (!strcmp(event, "ON"));
-        return true;
-    }
-    else if (!_stricmp(event_type, "RCSDUMP"))
-    {
-        m_rcsFuelDumpInProgress = (!strcmp(event, "ON"));
-        return true;
-    }
-    else if (!_stricmp(event_type, "SCRAMDUMP"))
-    {
-        m_scramFuelDumpInProgress = (!strcmp(event, "ON"));
-        return true;
-    }
-    else if (!_stricmp(event_type, "APUDUMP"))
-    {
-        m_apuFuelDumpInProgress = (!strcmp(event, "ON"));
-        return true;
-    }
-    else if (!_stricmp(event_type, "LOXDUMP"))
-    {
-        m_loxDumpInProgress = (!strcmp(event, "ON"));
-        return true;
-    }
 
-    return false;
+    XREventRecord record;
+    memset(&record, 0, sizeof(record));
+    record.EventTime = event_t;
+    record.Type = static_cast<uint16_t>(type);
+    record.Value = static_cast<uint8_t>(XRPlaybackEventTable::ParseValue(event, table.IsValueCaseSensitive(type)));
+    return table.Dispatch(*this, record);
 }
 
 // --------------------------------------------------------------
@@ -473,6 +286,9 @@ void DeltaGliderXR1::clbkVisualDestroyed(VISHANDLE vis, int refcount)
 // --------------------------------------------------------------
 void DeltaGliderXR1::clbkPreStep(double simt, double simdt, double mjd)
 {
+    // record our XR events, or play back any that are due, before anything else sees this frame
+    UpdateXREventRecorder(mjd);
+
     // calculate max scramjet thrust
     ScramjetThrust();
 
@@ -73,7 +73,7 @@ bool DeltaGliderXR1::ParseXRCommonScenarioLine(char *line)
         double frac = 1.0;  // default to full if invalid value found
         SSCANF1("%lf", &frac);
         ValidateFraction(frac);     // make sure it's in range
-        m_apuFuelQty = frac * APU_FUEL_CAPACITY;
+        SetAPUFuelQty(frac * APU_FUEL_CAPACITY);
     } 
     else IF_FOUND("LOX_QTY") 
     {
@@ -81,7 +81,7 @@ bool DeltaGliderXR1::ParseXRCommonScenarioLine(char *line)
         double frac = 1.0;  // default to full if invalid value found
         SSCANF1("%lf", &frac);
         ValidateFraction(frac);     // make sure it's in range
-        m_loxQty = frac * GetXR1Config()->GetMaxLoxMass();  // set main tank qty ONLY
+        SetInternalLOXQty(frac * GetXR1Config()->GetMaxLoxMass());  // set main tank qty ONLY
     } 
     else IF_FOUND("CABIN_O2_LEVEL") 
     {
@@ -0,0 +1,368 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XRConsumables.cpp
+// Exact per-frame integration of the vessel's tanks and the flows between them.
+// ==============================================================
+
+#include "XRConsumables.h"
+#include <crtdbg.h>
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+
+// A tank within this many kg of a bound is considered to be at that bound; this absorbs rounding in the segment math.
+static const double MASS_EPSILON = 1e-9;
+
+// Net rates smaller than this (in kg/second) are considered to be zero.
+static const double RATE_EPSILON = 1e-12;
+
+// Upper bound on the number of segments a single frame is split into; each segment ends when a tank empties or fills, 
+// so even with every tank and flow active we never come close to this.
+static const int MAX_SEGMENTS = 32;
+
+XRConsumables::XRConsumables()
+{
+    for (int i = 0; i < static_cast<int>(ConsumableTank::Count); i++)
+    {
+        Tank &tank = m_tanks[i];
+        tank.mass = 0;
+        tank.maxMass = ((i == static_cast<int>(ConsumableTank::External)) ? -1 : 0);
+        tank.emptyTime = -1;
+        tank.changed = false;
+    }
+}
+
+// Set the level of a tank at the start of the frame; invoked before each Integrate call.
+// The External tank is always unbounded and is never set.
+void XRConsumables::SetTank(const ConsumableTank tank, const double mass, const double maxMass)
+{
+    _ASSERTE(tank != ConsumableTank::External);
+    _ASSERTE(tank != ConsumableTank::Count);
+
+    Tank &t = m_tanks[static_cast<int>(tank)];
+    t.maxMass = max(maxMass, 0.0);
+    t.mass = min(max(mass, 0.0), t.maxMass);   // sanity-check
+    t.emptyTime = -1;
+    t.changed = false;
+}
+
+// Register a constant-rate flow for this frame.
+//   rate = requested flow rate in kg/second
+//   haltWhenBlocked = true to stop the flow for the rest of the frame as soon as its source empties or its destination fills;
+//                     false to throttle it to whatever the blocked tank can accept (e.g., crew LOX consumption while the tanks are being resupplied)
+// Returns: flow ID, which is valid until the next Integrate call completes
+int XRConsumables::AddFlow(const ConsumableTank source, const ConsumableTank dest, const double rate, const bool haltWhenBlocked)
+{
+    _ASSERTE(source != dest);
+    _ASSERTE(rate >= 0);
+
+    Flow flow;
+    flow.source = source;
+    flow.dest = dest;
+    flow.rate = max(rate, 0.0);
+    flow.haltWhenBlocked = haltWhenBlocked;
+    flow.throttle = 1.0;
+    flow.mass = 0;
+    flow.haltReason = HaltReason::None;
+    flow.haltTank = ConsumableTank::External;
+    flow.haltTime = -1;
+
+    m_flows.push_back(flow);
+    return static_cast<int>(m_flows.size()) - 1;
+}
+
+// Compute the net rate of change of each tank in kg/second for the current flow throttles
+void XRConsumables::ComputeNetRates(double *pNetRatesOut) const
+{
+    for (int i = 0; i < static_cast<int>(ConsumableTank::Count); i++)
+        pNetRatesOut[i] = 0;
+
+    for (const Flow &flow : m_flows)
+    {
+        const double rate = flow.rate * flow.throttle;
+        pNetRatesOut[static_cast<int>(flow.source)] -= rate;
+        pNetRatesOut[static_cast<int>(flow.dest)] += rate;
+    }
+}
+
+// Returns true if the supplied flow is pushing the supplied tank past one of its bounds
+bool XRConsumables::IsPushingPastBound(const Flow &flow, const ConsumableTank tank, const double *pNetRates) const
+{
+    if ((flow.throttle <= 0) || (tank == ConsumableTank::External))
+        return false;
+
+    const Tank &t = m_tanks[static_cast<int>(tank)];
+    const double netRate = pNetRates[static_cast<int>(tank)];
+
+    if ((flow.source == tank) && (netRate < -RATE_EPSILON) && (t.mass <= MASS_EPSILON))
+        return true;    // draining an empty tank
+
+    if ((flow.dest == tank) && (netRate > RATE_EPSILON) && (t.mass >= t.maxMass - MASS_EPSILON))
+        return true;    // filling a full tank
+
+    return false;
+}
+
+void XRConsumables::HaltFlow(Flow &flow, const HaltReason reason, const ConsumableTank tank, const double t)
+{
+    flow.throttle = 0;
+    flow.haltReason = reason;
+    flow.haltTank = tank;
+    flow.haltTime = t;
+}
+
+// Halt or throttle any flows that are pushing a tank past one of its bounds at time t.  
+// Halting or throttling one flow changes the net rates of other tanks, so repeat until nothing is blocked.
+void XRConsumables::ResolveBlockedFlows(const double t)
+{
+    double netRates[static_cast<int>(ConsumableTank::Count)];
+
+    for (int pass = 0; pass < MAX_SEGMENTS; pass++)
+    {
+        ComputeNetRates(netRates);
+
+        // find the first blocked tank, if any
+        int blockedTankIndex = -1;
+        for (int i = 0; i < static_cast<int>(ConsumableTank::External); i++)
+        {
+            const Tank &tank = m_tanks[i];
+            if (((netRates[i] < -RATE_EPSILON) && (tank.mass <= MASS_EPSILON)) ||
+                ((netRates[i] > RATE_EPSILON) && (tank.mass >= tank.maxMass - MASS_EPSILON)))
+            {
+                blockedTankIndex = i;
+                break;
+            }
+        }
+
+        if (blockedTankIndex < 0)
+            return;     // nothing is blocked
+
+        const ConsumableTank blockedTank = static_cast<ConsumableTank>(blockedTankIndex);
+        const bool isEmpty = (netRates[blockedTankIndex] < 0);
+        if (isEmpty && (m_tanks[blockedTankIndex].emptyTime < 0))
+            m_tanks[blockedTankIndex].emptyTime = t;
+
+        // halt every flow that stops when blocked first; that may be enough to unblock the tank
+        bool haltedAnyFlow = false;
+        for (Flow &flow : m_flows)
+        {
+            if (flow.haltWhenBlocked && IsPushingPastBound(flow, blockedTank, netRates))
+            {
+                HaltFlow(flow, (isEmpty ? HaltReason::SourceEmpty : HaltReason::DestFull), blockedTank, t);
+                haltedAnyFlow = true;
+            }
+        }
+
+        if (haltedAnyFlow)
+            continue;   // recompute the net rates
+
+        // Only throttleable flows are left pushing this tank, so scale them back until the tank's net rate is zero; 
+        // e.g., an empty tank can only pass on what is flowing into it.
+        double pushingRate = 0;
+        for (const Flow &flow : m_flows)
+        {
+            if (IsPushingPastBound(flow, blockedTank, netRates))
+                pushingRate += flow.rate * flow.throttle;
+        }
+        _ASSERTE(pushingRate > 0);
+
+        const double otherRate = fabs(netRates[blockedTankIndex] + (isEmpty ? pushingRate : -pushingRate));  // rate of all the *other* flows in the opposite direction
+        const double scale = ((pushingRate > 0) ? min(otherRate / pushingRate, 1.0) : 0);
+
+        for (Flow &flow : m_flows)
+        {
+            if (IsPushingPastBound(flow, blockedTank, netRates))
+                flow.throttle *= scale;
+        }
+    }
+
+    _ASSERTE(false);    // should never happen
+}
+
+// Integrate all registered flows over this frame.  The frame is split into segments at each instant a tank reaches a bound;
+// within each segment every flow is constant, so the tank levels are exact regardless of how large simdt is.
+void XRConsumables::Integrate(const double simdt)
+{
+    double t = 0;
+    for (int segment = 0; (segment < MAX_SEGMENTS) && (t < simdt); segment++)
+    {
+        // throttling is only valid for the segment in which it was computed, since the flows that limited it may have halted since then
+        for (Flow &flow : m_flows)
+        {
+            if (flow.haltReason == HaltReason::None)
+                flow.throttle = 1.0;
+        }
+        ResolveBlockedFlows(t);
+
+        double netRates[static_cast<int>(ConsumableTank::Count)];
+        ComputeNetRates(netRates);
+
+        // find the next tank to empty or fill
+        double segmentTime = simdt - t;
+        int boundTankIndex = -1;
+        for (int i = 0; i < static_cast<int>(ConsumableTank::External); i++)
+        {
+            const Tank &tank = m_tanks[i];
+            double timeToBound = DBL_MAX;
+            if (netRates[i] < -RATE_EPSILON)
+                timeToBound = tank.mass / -netRates[i];
+            else if (netRates[i] > RATE_EPSILON)
+                timeToBound = (tank.maxMass - tank.mass) / netRates[i];
+
+            if (timeToBound < segmentTime)
+            {
+                segmentTime = timeToBound;
+                boundTankIndex = i;
+            }
+        }
+
+        // move the mass for this segment
+        for (Flow &flow : m_flows)
+        {
+            const double mass = flow.rate * flow.throttle * segmentTime;
+            if (mass > 0)
+            {
+                flow.mass += mass;
+                m_tanks[static_cast<int>(flow.source)].changed = true;
+                m_tanks[static_cast<int>(flow.dest)].changed = true;
+            }
+        }
+
+        for (int i = 0; i < static_cast<int>(ConsumableTank::External); i++)
+        {
+            Tank &tank = m_tanks[i];
+            tank.mass = min(max(tank.mass + (netRates[i] * segmentTime), 0.0), tank.maxMass);
+        }
+
+        t += segmentTime;
+
+        if (boundTankIndex < 0)
+            break;  // reached the end of the frame
+
+        // snap the tank to its bound so rounding cannot leave it a hair short
+        Tank &boundTank = m_tanks[boundTankIndex];
+        if (netRates[boundTankIndex] < 0)
+        {
+            boundTank.mass = 0;
+            if (boundTank.emptyTime < 0)
+                boundTank.emptyTime = t;
+        }
+        else
+        {
+            boundTank.mass = boundTank.maxMass;
+        }
+    }
+
+    // resolve any blocked flows at the end of the frame as well so that flows that just emptied or filled a tank are reported as halted
+    ResolveBlockedFlows(simdt);
+}
+
+// Invoke each listener with the results of this frame; the flows are cleared by our caller afterwards.
+void XRConsumables::NotifyListeners(const double simt, const double simdt) const
+{
+    for (Listener *pListener : m_listeners)
+        pListener->ConsumablesIntegrated(*this, simt, simdt);
+}
+
+// Closed-form solution of dT/dt = heatRate - sum(max(coolerFrac[i] * T, coolerMinRate)), bounded to [minTemp, maxTemp].
+// Each cooler removes a fraction of the current temperature per second or its minimum rate, whichever is higher, so the
+// equation is linear between the temperatures at which a cooler switches between the two; we solve each of those 
+// regions exactly in turn.
+//   pCoolerFracs = cooling fraction of each active cooler; may be null if coolerCount == 0
+// Returns: temperature at the end of the timestep
+double XRConsumables::IntegrateTemperature(const double temp, const double heatRate, const double *pCoolerFracs, const int coolerCount, const double coolerMinRate, const double minTemp, const double maxTemp, const double simdt)
+{
+    double T = min(max(temp, minTemp), maxTemp);
+    double t = 0;
+
+    for (int region = 0; (region < (2 * coolerCount) + 4) && (t < simdt); region++)
+    {
+        // Determine the linear equation dT/dt = A - K*T for this region.  Right at a cooler's switchover temperature
+        // both forms give the same rate, so pick the form that applies on the side of it we are moving toward.
+        double A = 0, K = 0;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            const bool fallingTemp = ((pass == 1) && ((A - (K * T)) < 0));
+            A = heatRate;
+            K = 0;
+            for (int i = 0; i < coolerCount; i++)
+            {
+                const double proportionalRate = pCoolerFracs[i] * T;
+                if (fallingTemp ? (proportionalRate > coolerMinRate) : (proportionalRate >= coolerMinRate))
+                    K += pCoolerFracs[i];
+                else
+                    A -= coolerMinRate;
+            }
+        }
+
+        const double rate = A - (K * T);
+        if ((rate == 0) || ((rate > 0) && (T >= maxTemp)) || ((rate < 0) && (T <= minTemp)))
+            break;  // holding steady for the rest of the timestep
+
+        // find the next temperature at which the equation changes: a cooler switchover or one of the bounds
+        double target = ((rate > 0) ? maxTemp : minTemp);
+        for (int i = 0; i < coolerCount; i++)
+        {
+            if (pCoolerFracs[i] <= 0)
+                continue;
+            const double switchTemp = coolerMinRate / pCoolerFracs[i];
+            if ((rate > 0) && (switchTemp > T) && (switchTemp < target))
+                target = switchTemp;
+            else if ((rate < 0) && (switchTemp < T) && (switchTemp > target))
+                target = switchTemp;
+        }
+
+        // time to reach that temperature
+        double timeToTarget = DBL_MAX;
+        double equilibrium = 0;
+        if (K <= 0)
+        {
+            timeToTarget = (target - T) / rate;
+        }
+        else
+        {
+            // T(t) = equilibrium + (T0 - equilibrium) * e^(-K*t); the target is only reached if it lies between T0 and the equilibrium
+            equilibrium = A / K;
+            const double ratio = (target - equilibrium) / (T - equilibrium);
+            if ((ratio > 0) && (ratio < 1))
+                timeToTarget = -log(ratio) / K;
+        }
+
+        const double remaining = simdt - t;
+        if (timeToTarget >= remaining)
+        {
+            T = ((K <= 0) ? (T + (rate * remaining)) : (equilibrium + ((T - equilibrium) * exp(-K * remaining))));
+            t = simdt;
+        }
+        else
+        {
+            T = target;
+            t += timeToTarget;
+        }
+    }
+
+    return min(max(T, minTemp), maxTemp);
+}
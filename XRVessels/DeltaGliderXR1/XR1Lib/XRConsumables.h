@@ -0,0 +1,118 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XRConsumables.h
+// Exact per-frame integration of the vessel's tanks and the flows between them.
+//
+// Each PostStep that moves fuel or LOX registers a constant-rate flow for the
+// frame instead of adjusting the tanks itself.  Once all flows are registered,
+// the tanks and flows are solved together as a piecewise-linear system over
+// the whole timestep: the frame is split only at the instants a tank empties or
+// fills, so the result does not depend on how large simdt is.  The tanks are
+// then written back to the core once and each listener is notified so it can
+// react to flows that were halted.
+// ==============================================================
+
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+// tanks that can be the source or destination of a flow
+enum class ConsumableTank
+{
+    Main, RCS, SCRAM, APU, LOX, 
+    External,   // unbounded reservoir: resupply lines, dump nozzles, crew O2 consumption, etc.
+    Count       // number of tanks; not a valid tank
+};
+
+class XRConsumables
+{
+public:
+    enum class HaltReason { None, SourceEmpty, DestFull };
+
+    // result of a single flow after the frame is integrated
+    struct Flow
+    {
+        ConsumableTank source;
+        ConsumableTank dest;
+        double rate;            // requested rate in kg/second
+        bool haltWhenBlocked;   // true = flow stops for good when it empties its source or fills its dest; false = flow is throttled to what the tanks can accept
+        double throttle;        // 0...1; working value while integrating
+
+        double mass;            // kg actually moved this frame
+        HaltReason haltReason;  // HaltReason::None if flow ran for the entire frame (possibly throttled)
+        ConsumableTank haltTank;  // tank that stopped the flow; only valid if haltReason != None
+        double haltTime;        // seconds into the frame at which the flow halted; -1 = not halted
+    };
+
+    // implemented by PostSteps that need to see the results of their flows each frame
+    class Listener
+    {
+    public:
+        virtual void ConsumablesIntegrated(const XRConsumables &consumables, const double simt, const double simdt) = 0;
+    };
+
+    XRConsumables();
+
+    // tank levels must be set before each Integrate call
+    void SetTank(const ConsumableTank tank, const double mass, const double maxMass);
+    double GetTankMass(const ConsumableTank tank) const { return m_tanks[static_cast<int>(tank)].mass; }
+    bool IsTankChanged(const ConsumableTank tank) const { return m_tanks[static_cast<int>(tank)].changed; }
+    double GetTankEmptyTime(const ConsumableTank tank) const { return m_tanks[static_cast<int>(tank)].emptyTime; }  // -1 = did not empty this frame
+
+    // Returns the flow ID, which is valid until the next Integrate call completes
+    int AddFlow(const ConsumableTank source, const ConsumableTank dest, const double rate, const bool haltWhenBlocked);
+    const Flow &GetFlow(const int flowID) const { return m_flows[flowID]; }
+    int GetFlowCount() const { return static_cast<int>(m_flows.size()); }
+
+    void Integrate(const double simdt);
+    void ClearFlows() { m_flows.clear(); }
+
+    void AddListener(Listener *pListener) { m_listeners.push_back(pListener); }
+    void NotifyListeners(const double simt, const double simdt) const;
+
+    // Closed-form solution of dT/dt = heatRate - sum(max(coolerFrac[i] * T, coolerMinRate)), bounded to [minTemp, maxTemp]
+    static double IntegrateTemperature(const double temp, const double heatRate, const double *pCoolerFracs, const int coolerCount, const double coolerMinRate, const double minTemp, const double maxTemp, const double simdt);
+
+protected:
+    struct Tank
+    {
+        double mass;
+        double maxMass;     // < 0 = unbounded
+        double emptyTime;   // seconds into the frame at which the tank reached empty; -1 = did not empty
+        bool changed;       // true if any mass was moved in or out of this tank this frame
+    };
+
+    bool IsPushingPastBound(const Flow &flow, const ConsumableTank tank, const double *pNetRates) const;
+    void ComputeNetRates(double *pNetRatesOut) const;
+    void ResolveBlockedFlows(const double t);
+    void HaltFlow(Flow &flow, const HaltReason reason, const ConsumableTank tank, const double t);
+
+    Tank m_tanks[static_cast<int>(ConsumableTank::Count)];
+    vector<Flow> m_flows;
+    vector<Listener *> m_listeners;   // not owned by us
+};
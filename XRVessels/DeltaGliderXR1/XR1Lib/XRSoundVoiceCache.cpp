@@ -0,0 +1,239 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XRSoundVoiceCache.cpp
+// Lazy, pooled loading of XR vessel sound files.
+// ==============================================================
+
+#include "XRSoundVoiceCache.h"
+#include <ctype.h>
+#include <string.h>
+
+// Returns the singleton asset table for this vessel DLL
+XRSoundAssetTable &XRSoundAssetTable::GetInstance()
+{
+    static XRSoundAssetTable s_instance;
+    return s_instance;
+}
+
+// Register a sound file, reusing the existing entry if it was already registered by this or any other vessel.
+// Returns the asset index for the file.
+int XRSoundAssetTable::RegisterAsset(const char *pFilename)
+{
+    string key(pFilename);
+    for (string::iterator it = key.begin(); it != key.end(); it++)
+        *it = static_cast<char>(tolower(static_cast<unsigned char>(*it)));
+
+    unordered_map<string, int>::const_iterator it = m_indexMap.find(key);
+    if (it != m_indexMap.end())
+        return it->second;
+
+    Asset asset;
+    asset.filename = pFilename;
+    asset.fileBytes = -1;
+    m_assets.push_back(asset);
+
+    const int assetIndex = static_cast<int>(m_assets.size() - 1);
+    m_indexMap[key] = assetIndex;
+    return assetIndex;
+}
+
+// Returns the size of the specified sound file in bytes, or 0 if it does not exist.  A WAV file holds 
+// uncompressed PCM data, so this is a close estimate of how much memory XRSound needs for the sound.
+int XRSoundAssetTable::GetFileBytes(const int assetIndex)
+{
+    Asset &asset = m_assets[assetIndex];
+    if (asset.fileBytes < 0)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA fileData;
+        if (GetFileAttributesEx(asset.filename.c_str(), GetFileExInfoStandard, &fileData))
+            asset.fileBytes = static_cast<int>(fileData.nFileSizeLow);  // sound files are never > 2 GB
+        else
+            asset.fileBytes = 0;    // file is missing; the user may have deleted sounds he does not like
+    }
+    return asset.fileBytes;
+}
+
+//-------------------------------------------------------------------------
+
+// Constructor
+XRSoundVoiceCache::XRSoundVoiceCache() :
+    m_pXRSound(nullptr), m_budgetBytes(0), m_useCounter(0)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+// Invoked once XRSound has been initialized for our vessel
+// budgetBytes: 0 = unlimited
+void XRSoundVoiceCache::Initialize(XRSound *pXRSound, const int budgetBytes)
+{
+    m_pXRSound = pXRSound;
+    m_budgetBytes = budgetBytes;
+}
+
+// Assign a sound file to a sound ID; the file is not loaded until the sound is first played.
+// This may be invoked again at any time to change the sound ID's file (e.g., for callouts).
+void XRSoundVoiceCache::Register(const int soundID, const char *pFilename, const XRSound::PlaybackType playbackType)
+{
+    _ASSERTE(soundID > 0);
+    if (soundID >= static_cast<int>(m_sounds.size()))
+    {
+        SoundEntry emptyEntry = { NO_ASSET, XRSound::PlaybackType::InternalOnly, NO_VOICE };
+        m_sounds.resize(soundID + 1, emptyEntry);
+    }
+
+    SoundEntry &entry = m_sounds[soundID];
+    entry.assetIndex = XRSoundAssetTable::GetInstance().RegisterAsset(pFilename);
+    entry.playbackType = playbackType;
+    // If this sound is already loaded in a voice, the sound keeps that voice so that StopSound and IsPlaying still reach
+    // the old file while it plays; AcquireVoice loads the new file into the same voice the next time the sound is played.
+}
+
+// Returns the XRSound voice ID for the specified sound, loading the sound file now if necessary.
+// Returns NO_VOICE if the sound is not registered or XRSound could not load it.
+int XRSoundVoiceCache::AcquireVoice(const int soundID)
+{
+    if ((soundID <= 0) || (soundID >= static_cast<int>(m_sounds.size())))
+        return NO_VOICE;
+
+    SoundEntry &entry = m_sounds[soundID];
+    if (entry.assetIndex == NO_ASSET)
+        return NO_VOICE;
+
+    m_stats.requests++;
+    m_useCounter++;
+
+    const int bytes = XRSoundAssetTable::GetInstance().GetFileBytes(entry.assetIndex);
+    int voiceID = entry.voiceID;
+    if (voiceID != NO_VOICE)
+    {
+        Voice &voice = GetVoiceData(voiceID);
+        if (voice.assetIndex == entry.assetIndex)
+        {
+            // cache hit
+            m_stats.hits++;
+            voice.lastUsed = m_useCounter;
+            return voiceID;
+        }
+
+        // The sound ID was reassigned to a different file, so load the new file into the same voice; 
+        // this is what the on-demand callout sounds do every time.
+        m_stats.residentBytes -= voice.bytes;
+        entry.voiceID = NO_VOICE;
+    }
+    else
+    {
+        voiceID = AllocateVoice(bytes);
+    }
+
+    LARGE_INTEGER freq, startTime, endTime;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&startTime);
+    const bool bLoaded = m_pXRSound->LoadWav(voiceID, XRSoundAssetTable::GetInstance().GetFilename(entry.assetIndex), entry.playbackType);
+    QueryPerformanceCounter(&endTime);
+
+    m_stats.loads++;
+    m_stats.totalLoadMillis += static_cast<double>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+
+    Voice &voice = GetVoiceData(voiceID);
+    if (!bLoaded)
+    {
+        // leave the voice free; we will retry the next time this sound is played
+        voice.soundID = 0;
+        voice.assetIndex = NO_ASSET;
+        voice.bytes = 0;
+        return NO_VOICE;
+    }
+
+    voice.soundID = soundID;
+    voice.assetIndex = entry.assetIndex;
+    voice.bytes = bytes;
+    voice.lastUsed = m_useCounter;
+    m_stats.residentBytes += bytes;
+    entry.voiceID = voiceID;
+    return voiceID;
+}
+
+// Returns the voice ID for the specified sound if it is loaded, or NO_VOICE if it is not loaded.
+// If the sound was registered with a different file since it was loaded, this is the voice still holding the old file.
+int XRSoundVoiceCache::GetVoice(const int soundID) const
+{
+    if ((soundID <= 0) || (soundID >= static_cast<int>(m_sounds.size())))
+        return NO_VOICE;
+
+    return m_sounds[soundID].voiceID;
+}
+
+// Returns a free voice to load a sound into.  If loading bytesNeeded would exceed our memory budget, cold voices
+// (loaded but not playing) are evicted, least-recently-used first, until the new sound fits or no cold voices remain,
+// and the first voice evicted is reused.  XRSound releases a voice's old sample when a new file is loaded into it, so
+// the other evicted voices are kept as free voices and reused before any new voice is added.
+int XRSoundVoiceCache::AllocateVoice(const int bytesNeeded)
+{
+    int reuseVoiceID = NO_VOICE;
+    while ((m_budgetBytes > 0) && (m_stats.residentBytes + bytesNeeded > m_budgetBytes))
+    {
+        int lruVoiceID = NO_VOICE;
+        unsigned int oldestUse = 0;
+        for (int voiceID = 1; voiceID <= static_cast<int>(m_voices.size()); voiceID++)
+        {
+            const Voice &voice = GetVoiceData(voiceID);
+            if ((voice.soundID == 0) || m_pXRSound->IsWavPlaying(voiceID))
+                continue;   // free voices are handled below, and we never interrupt a sound that is playing
+
+            if ((lruVoiceID == NO_VOICE) || (voice.lastUsed < oldestUse))
+            {
+                lruVoiceID = voiceID;
+                oldestUse = voice.lastUsed;
+            }
+        }
+
+        if (lruVoiceID == NO_VOICE)
+            break;  // every loaded sound is playing right now, so we must exceed the budget
+
+        // evict the cold sound
+        Voice &voice = GetVoiceData(lruVoiceID);
+        m_sounds[voice.soundID].voiceID = NO_VOICE;
+        m_stats.residentBytes -= voice.bytes;
+        voice.soundID = 0;
+        voice.bytes = 0;
+        if (reuseVoiceID == NO_VOICE)
+            reuseVoiceID = lruVoiceID;
+    }
+
+    if (reuseVoiceID != NO_VOICE)
+        return reuseVoiceID;
+
+    // reuse a free voice if we have one
+    for (int voiceID = 1; voiceID <= static_cast<int>(m_voices.size()); voiceID++)
+    {
+        if (GetVoiceData(voiceID).soundID == 0)
+            return voiceID;
+    }
+
+    Voice newVoice = { 0, NO_ASSET, 0, 0 };
+    m_voices.push_back(newVoice);
+    return static_cast<int>(m_voices.size());
+}
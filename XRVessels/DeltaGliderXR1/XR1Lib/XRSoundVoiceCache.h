@@ -0,0 +1,124 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR1 Base Class Library
+// These classes extend and use the XR Framework classes
+//
+// XRSoundVoiceCache.h
+// Lazy, pooled loading of XR vessel sound files.
+//
+// Sound IDs are only registered with a filename when the vessel is created;
+// the WAV file is not loaded into XRSound until the sound is first played.
+// Each loaded file occupies one XRSound "voice" slot, and when the configured
+// memory budget would be exceeded the least-recently-used voices that are not
+// playing are evicted until the next sound fits, and one of them is reused for
+// that sound, which makes XRSound release its old sample.
+// ==============================================================
+
+#pragma once
+
+#include <windows.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "XRSound.h"
+
+using namespace std;
+
+// DLL-wide table of sound files shared by all XR vessel instances in this module; each unique
+// filename is stored once and its size is read from disk at most once.
+class XRSoundAssetTable
+{
+public:
+    static XRSoundAssetTable &GetInstance();
+
+    int RegisterAsset(const char *pFilename);   // returns asset index; does not access the disk
+    const char *GetFilename(const int assetIndex) const { return m_assets[assetIndex].filename.c_str(); }
+    int GetFileBytes(const int assetIndex);     // returns file size in bytes, or 0 if the file does not exist
+    int GetAssetCount() const { return static_cast<int>(m_assets.size()); }
+
+protected:
+    XRSoundAssetTable() { }
+
+    struct Asset
+    {
+        string filename;    // path relative to the Orbiter root folder
+        int fileBytes;      // -1 = not read from disk yet
+    };
+    vector<Asset> m_assets;
+    unordered_map<string, int> m_indexMap;   // key = lowercase filename, value = index into m_assets
+};
+
+//-------------------------------------------------------------------------
+
+// Per-vessel mapping of XR sound IDs to XRSound voices.
+class XRSoundVoiceCache
+{
+public:
+    // cumulative cache statistics for this vessel
+    struct Stats
+    {
+        unsigned int requests;      // number of sounds played
+        unsigned int hits;          // number of plays that did not need to load a file
+        unsigned int loads;         // number of files loaded into XRSound
+        double totalLoadMillis;     // total time spent in XRSound::LoadWav
+        int residentBytes;          // total file size of all sounds currently loaded
+    };
+
+    XRSoundVoiceCache();
+
+    void Initialize(XRSound *pXRSound, const int budgetBytes);
+    void Register(const int soundID, const char *pFilename, const XRSound::PlaybackType playbackType);
+    int AcquireVoice(const int soundID);        // loads the sound if necessary; returns 0 if the sound cannot be loaded
+    int GetVoice(const int soundID) const;      // returns 0 if the sound is not loaded
+    const Stats &GetStats() const { return m_stats; }
+
+protected:
+    static const int NO_VOICE = 0;      // XRSound IDs must start at 1
+    static const int NO_ASSET = -1;
+
+    struct SoundEntry
+    {
+        int assetIndex;                 // NO_ASSET = not registered
+        XRSound::PlaybackType playbackType;
+        int voiceID;                    // NO_VOICE = not loaded
+    };
+
+    struct Voice
+    {
+        int soundID;        // 0 = free
+        int assetIndex;     // file currently loaded into this voice
+        int bytes;
+        unsigned int lastUsed;   // value of m_useCounter when this voice was last played
+    };
+
+    int AllocateVoice(const int bytesNeeded);
+    Voice &GetVoiceData(const int voiceID) { return m_voices[voiceID - 1]; }
+    const Voice &GetVoiceData(const int voiceID) const { return m_voices[voiceID - 1]; }
+
+    XRSound *m_pXRSound;
+    int m_budgetBytes;              // 0 = unlimited
+    vector<SoundEntry> m_sounds;    // indexed by sound ID
+    vector<Voice> m_voices;         // element 0 = voice ID 1
+    unsigned int m_useCounter;
+    Stats m_stats;
+};
@@ -46,7 +46,7 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
     m_activeMultiDisplayMode(DEFAULT_MMID), m_activeTempScale(TempScale::Celsius), m_pMDA(nullptr),
     m_tertiaryHUDOn(true), m_damagedWingBalance(0), m_crashProcessed(false),
     m_infoWarningTextLineGroup(INFO_WARNING_BUFFER_LINES), m_mwsTestActive(false),
-    m_nextMDARefresh(0), m_nextSecondaryHUDRefresh(0), m_lastSecondaryHUDMode(0),
+    m_lastSecondaryHUDMode(0),
     m_metMJDStartingTime(-1), m_interval1ElapsedTime(-1), m_interval2ElapsedTime(-1),
     m_metTimerRunning(false), m_interval1TimerRunning(false), m_interval2TimerRunning(false),
     m_apuFuelQty(APU_FUEL_CAPACITY), m_mainFuelDumpInProgress(false), m_rcsFuelDumpInProgress(false),
@@ -56,11 +56,12 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
     m_mainSupplyLineStatus(false), m_scramSupplyLineStatus(false), m_apuSupplyLineStatus(false), m_loxSupplyLineStatus(false),
     m_mainFuelFlowSwitch(false), m_scramFuelFlowSwitch(false), m_apuFuelFlowSwitch(false), m_loxFlowSwitch(false),
     m_loxQty(-1), // set for real in clbkSetClassCaps
+    m_massBudget(static_cast<int>(MASS_ITEM::COUNT)),   // loaded by clbkPostCreationCommonXRCode
     m_loxDumpInProgress(false), m_oxygenRemainingTime(0), m_cabinO2Level(NORMAL_O2_LEVEL),
     m_crewState(CrewState::OK), m_coolantTemp(NOMINAL_COOLANT_TEMP), m_internalSystemsFailure(false),
     m_customAutopilotMode(AUTOPILOT::AP_OFF), m_airspeedHoldEngaged(false), m_setPitchOrAOA(0), m_setBank(0), m_initialAHBankCompleted(false), m_holdAOA(false),
     m_customAutopilotSuspended(false), m_airspeedHoldSuspended(false), m_setDescentRate(0), m_latchedAutoTouchdownMinDescentRate(-3), m_autoLand(false), m_maxShipHoverAcc(0),
-    m_dataHUDActive(false), m_setAirspeed(0), m_maxMainAcc(0), m_nextTertiaryHUDRefresh(0), m_nextArtificialHorizonRefresh(0),
+    m_dataHUDActive(false), m_setAirspeed(0), m_maxMainAcc(0),
     m_crewHatchInterlocksDisabled(false), m_airlockInterlocksDisabled(false), m_isRetroEnabled(false), m_isHoverEnabled(false), m_isScramEnabled(false),
     m_startupMainFuelFrac(0), m_startupRCSFuelFrac(0), m_startupSCRAMFuelFrac(0),  // NOTE: these values must be 0 and not -1!
     m_crewDisplayIndex(0), m_parsedScenarioFile(false), m_mmuCrewDataValid(false), 
@@ -83,7 +84,7 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
     m_pHudNormalFont(nullptr), m_pHudNormalFontSize(0),
     hLeftAileron(0), hRightAileron(0), hElevator(0), hElevatorTrim(0),    // damageable control surfaces
     m_MainFuelFlowedFromBayToMainThisTimestep(0), m_SCRAMFuelFlowedFromBayToMainThisTimestep(0),
-    m_mainThrusterLightLevel(0), m_hoverThrusterLightLevel(0), m_pXRSound(nullptr),
+    m_mainThrusterLightLevel(0), m_hoverThrusterLightLevel(0), m_pXRSound(nullptr), m_xrEventRecordingStarted(false), m_xrEventPlaybackStarted(false),
     // the fields below here are initialized properlyi before being used, but we initialize them here just in case we miss some later
     anim_afdial(0), anim_brake(0), anim_elevator(0), anim_elevatortrim(0), anim_gear(0), anim_gearlever(0), anim_hatch(0),
     anim_hatchswitch(0), anim_hbalance(0), anim_hoverdoor(0), anim_hoverthrottle(0), anim_hudintens(0), anim_ilock(0),
@@ -104,8 +105,6 @@ DeltaGliderXR1::DeltaGliderXR1 (OBJHANDLE hObj, int fmodel, XR1ConfigFileParser
         m_pSpotlights[i] = nullptr;
 
     // zero payload bay variables (unused by us)
-    for (int i=0; i < 3; i++)
-        m_nextPayloadScreensRefresh[i] = 0;
     *m_grappleTargetVesselName = 0;
 
     // normal initialization begins here
@@ -81,6 +81,9 @@ void DeltaGliderXR1::SetAirspeedHoldMode(bool on, bool playSound)
             PlaySound(AutopilotOff, ST_Other, AUTOPILOT_VOL);
     }
 
+    // save a replay event, including the airspeed being held
+    RecordXREvent(XR_EVENT_TYPE::AIRSPEEDHOLD, (on ? XR_EVENT_VALUE::ON : XR_EVENT_VALUE::OFF), 0, static_cast<float>(m_setAirspeed));
+
     // repaint the autopilot buttons
     TriggerNavButtonRedraw();
 }
@@ -220,6 +223,12 @@ void DeltaGliderXR1::SetCustomAutopilotMode(AUTOPILOT mode, bool playSound, bool
     // reset all thruster levels; levels may vary by autopilot mode.  This takes damage into account.
     ResetAllRCSThrustMaxLevels();
 
+    // save a replay event, including the targets in effect for the new mode
+    const XR_EVENT_VALUE eventValue = ((mode == AUTOPILOT::AP_ATTITUDEHOLD) ? XR_EVENT_VALUE::ATTITUDEHOLD : 
+                                       ((mode == AUTOPILOT::AP_DESCENTHOLD) ? XR_EVENT_VALUE::DESCENTHOLD : XR_EVENT_VALUE::OFF));
+    RecordXREvent(XR_EVENT_TYPE::AUTOPILOT, eventValue, (m_holdAOA ? XREVT_FLAG_HOLD_AOA : 0), 
+                  static_cast<float>(m_setPitchOrAOA), static_cast<float>(m_setBank), static_cast<float>(m_setDescentRate));
+
     // repaint the autopilot buttons
     TriggerNavButtonRedraw();
 }
@@ -306,6 +315,10 @@ void DeltaGliderXR1::SetAirspeedHold(bool playSound, const AIRSPEEDHOLD_ADJUST m
         PlaySound(sound, ST_Other);
 
     ShowInfo(nullptr, DeltaGliderXR1::ST_None, msg);
+
+    // if the autopilot is engaged, save a replay event with its new target
+    if (m_airspeedHoldEngaged)
+        RecordXREvent(XR_EVENT_TYPE::AIRSPEEDHOLD, XR_EVENT_VALUE::ON, 0, static_cast<float>(m_setAirspeed));
 }
 
 //
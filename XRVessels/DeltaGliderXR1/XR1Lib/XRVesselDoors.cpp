@@ -83,7 +83,7 @@ void DeltaGliderXR1::ActivateLandingGear(DoorStatus action)
     TriggerRedrawArea(AID_GEARSWITCH);
     TriggerRedrawArea(AID_GEARINDICATOR);
     SetXRAnimation(anim_gearlever, close ? 0 : 1);
-    RecordEvent("GEAR", close ? "UP" : "DOWN");
+    RecordXREvent(XR_EVENT_TYPE::GEAR, close ? XR_EVENT_VALUE::UP : XR_EVENT_VALUE::DOWN);
 
     // NOTE: sound is handled by GearCalloutsPostStep 
 }
@@ -127,7 +127,7 @@ void DeltaGliderXR1::ActivateBayDoors(DoorStatus action)
     TriggerRedrawArea(AID_BAYDOORSSWITCH);
     TriggerRedrawArea(AID_BAYDOORSINDICATOR);
     UpdateCtrlDialog(this);  // Note: CTRL dialog not used for the XR2
-    RecordEvent("BAYDOORS", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::BAYDOORS, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 // invoked from key handler
@@ -157,7 +157,7 @@ void DeltaGliderXR1::ActivateHoverDoors(DoorStatus action)
     TriggerRedrawArea(AID_HOVERDOORINDICATOR);
     // no VC switch for this
     UpdateCtrlDialog(this);
-    RecordEvent("HOVERDOORS", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::HOVERDOORS, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ActivateScramDoors(DoorStatus action)
@@ -179,7 +179,7 @@ void DeltaGliderXR1::ActivateScramDoors(DoorStatus action)
     TriggerRedrawArea(AID_SCRAMDOORINDICATOR);
     // no VC switch for this
     UpdateCtrlDialog(this);
-    RecordEvent("SCRAMDOORS", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::SCRAMDOORS, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ActivateRCover(DoorStatus action)
@@ -211,7 +211,7 @@ void DeltaGliderXR1::ActivateRCover(DoorStatus action)
     TriggerRedrawArea(AID_RETRODOORINDICATOR);
     SetXRAnimation(anim_retroswitch, close ? 0 : 1);
     UpdateCtrlDialog(this);
-    RecordEvent("RCOVER", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::RCOVER, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ActivateNoseCone(DoorStatus action)
@@ -267,7 +267,7 @@ void DeltaGliderXR1::ActivateNoseCone(DoorStatus action)
         ActivateLadder(action); // retract ladder before closing the nose cone
 
     UpdateCtrlDialog(this);
-    RecordEvent("NOSECONE", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::NOSECONE, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 // invoked from key handler
@@ -349,7 +349,7 @@ void DeltaGliderXR1::ForceActivateCabinHatch(DoorStatus action)
     const bool close = (action == DoorStatus::DOOR_CLOSED || action == DoorStatus::DOOR_CLOSING);
     SetXRAnimation(anim_hatchswitch, close ? 0 : 1);
     UpdateCtrlDialog(this);
-    RecordEvent("HATCH", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::HATCH, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 // decompress the cabin and kill the crew if necessary
@@ -420,7 +420,7 @@ void DeltaGliderXR1::ActivateLadder(DoorStatus action)
 
     SetXRAnimation(anim_ladderswitch, close ? 0 : 1);
     UpdateCtrlDialog(this);
-    RecordEvent("LADDER", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::LADDER, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 // Not currently used, but keep it anyway
@@ -515,7 +515,7 @@ void DeltaGliderXR1::ActivateOuterAirlock(DoorStatus action)
     TriggerRedrawArea(AID_OUTERDOORINDICATOR);
     SetXRAnimation(anim_olockswitch, close ? 0 : 1);
     UpdateCtrlDialog(this);
-    RecordEvent("OLOCK", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::OLOCK, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ToggleOuterAirlock()
@@ -573,7 +573,7 @@ void DeltaGliderXR1::ForceActivateInnerAirlock(DoorStatus action)
     TriggerRedrawArea(AID_INNERDOORINDICATOR);
     SetXRAnimation(anim_ilockswitch, close ? 0 : 1);
     UpdateCtrlDialog(this);
-    RecordEvent("ILOCK", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::ILOCK, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ToggleInnerAirlock()
@@ -618,7 +618,7 @@ void DeltaGliderXR1::ActivateChamber(DoorStatus action, bool force)
     TriggerRedrawArea(AID_CHAMBERINDICATOR);
     // TODO: ANIMATE VC SWITCH (need mesh change from Donamy): SetXRAnimation(anim_chamberswitch, close ? 0:1);
     UpdateCtrlDialog(this);
-    RecordEvent("CHAMBER", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::CHAMBER, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ActivateAirbrake(DoorStatus action)
@@ -636,7 +636,7 @@ void DeltaGliderXR1::ActivateAirbrake(DoorStatus action)
         return;     // no hydraulic pressure
 
     brake_status = action;
-    RecordEvent("AIRBRAKE", action == DoorStatus::DOOR_CLOSING ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::AIRBRAKE, action == DoorStatus::DOOR_CLOSING ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 
     CHECK_DOOR_JUMP(brake_proc, anim_brake);
     TriggerRedrawArea(AID_AIRBRAKESWITCH);
@@ -679,7 +679,7 @@ void DeltaGliderXR1::ActivateRadiator(DoorStatus action)
     TriggerRedrawArea(AID_RADIATORINDICATOR);
     SetXRAnimation(anim_radiatorswitch, close ? 0 : 1);
     UpdateCtrlDialog(this);
-    RecordEvent("RADIATOR", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::RADIATOR, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 void DeltaGliderXR1::ToggleRadiator(void)
@@ -715,7 +715,7 @@ void DeltaGliderXR1::ActivateAPU(DoorStatus action)
     MarkAPUActive();  // reset the APU idle warning callout time
 
     apu_status = action;
-    RecordEvent("APU", ((action == DoorStatus::DOOR_CLOSING) || (action == DoorStatus::DOOR_CLOSED)) ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::APU, ((action == DoorStatus::DOOR_CLOSING) || (action == DoorStatus::DOOR_CLOSED)) ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 
     TriggerRedrawArea(AID_APU_BUTTON);
 }
@@ -85,6 +85,7 @@ bool DeltaGliderXR1::PerformEVA(const int ummuCrewMemberIndex)
     {
         // EVA successful!  No need to remove the crew member manually since UMmu will do it for us.
 
+        RefreshCrewMass();
         SetPassengerVisuals();     // update the VC mesh
 
         if (IsDocked() && (m_pActiveAirlockDoorStatus == &olock_status))
@@ -430,6 +431,7 @@ void DeltaGliderXR1::RemoveAllMmuCrewMembers()
         char* pName = CONST_UMMU(this).GetCrewNameBySlotNumber(i);
         UMmu.RemoveCrewMember(pName);  // UMMU BUG: METHOD DOESN'T WORK!  
     }
+    RefreshCrewMass();
 #endif
 }
 
@@ -515,6 +517,7 @@ int DeltaGliderXR1::KillCrew()
             crewMembersKilled++;
         }
     }
+    RefreshCrewMass();
 
     TriggerRedrawArea(AID_CREW_DISPLAY);   // update the crew display since they're all dead now...
     SetPassengerVisuals();     // update the VC mesh
@@ -571,7 +574,8 @@ void MmuPreStep::clbkPrePostStep(const double simt, const double simdt, const do
         GetXR1().m_crewDisplayIndex = GetXR1().GetUMmuSlotNumberForName(pName);
         GetXR1().TriggerRedrawArea(AID_CREW_DISPLAY);
 
-        // update passenger visuals since we just gained a new crew member
+        // update passenger visuals and mass since we just gained a new crew member
+        GetXR1().RefreshCrewMass();
         GetXR1().SetPassengerVisuals();
     }
 #endif
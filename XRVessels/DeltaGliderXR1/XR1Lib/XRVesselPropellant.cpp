@@ -219,7 +219,7 @@ void DeltaGliderXR1::SetXRLOXMass(const double mass)
 
     // fill the internal tank first
     const double internalTankQty = min(mass, GetXR1Config()->GetMaxLoxMass());
-    m_loxQty = internalTankQty;
+    SetInternalLOXQty(internalTankQty);
     deltaRemaining -= internalTankQty;
 
     // now store any remainder in the payload bay, if any bay exists
@@ -30,7 +30,7 @@
 // pMsg = mode-specific infomation message; may be null
 void DeltaGliderXR1::SetCrossfeedMode(const XFEED_MODE mode, const char* pMsg)
 {
-    char modeString[16];
+    XR_EVENT_VALUE eventValue;
     m_xfeedMode = mode;
 
     if (mode == XFEED_MODE::XF_OFF)
@@ -41,17 +41,17 @@ void DeltaGliderXR1::SetCrossfeedMode(const XFEED_MODE mode, const char* pMsg)
         else
             strcpy(temp, "Fuel cross-feed OFF.");  // no optional reason
         ShowInfo("Cross-Feed Off.wav", DeltaGliderXR1::ST_InformationCallout, temp);
-        strcpy(modeString, "OFF");
+        eventValue = XR_EVENT_VALUE::OFF;
     }
     else if (mode == XFEED_MODE::XF_MAIN)
     {
         ShowInfo("Cross-Feed Main.wav", DeltaGliderXR1::ST_InformationCallout, "Fuel cross-feed to MAIN.");
-        strcpy(modeString, "MAIN");
+        eventValue = XR_EVENT_VALUE::MAIN;
     }
     else if (mode == XFEED_MODE::XF_RCS)
     {
         ShowInfo("Cross-Feed RCS.wav", DeltaGliderXR1::ST_InformationCallout, "Fuel cross-feed to RCS.");
-        strcpy(modeString, "RCS");
+        eventValue = XR_EVENT_VALUE::RCS;
     }
     else  // invalid mode!  (should never happen)
     {
@@ -63,7 +63,7 @@ void DeltaGliderXR1::SetCrossfeedMode(const XFEED_MODE mode, const char* pMsg)
     TriggerRedrawArea(AID_XFEED_KNOB);
 
     // save a replay event
-    RecordEvent("XFEED", modeString);
+    RecordXREvent(XR_EVENT_TYPE::XFEED, eventValue);
 }
 
 void DeltaGliderXR1::SetFuelDumpState(bool& fuelDumpInProgress, const bool isDumping, const char* pFuelLabel)
@@ -84,21 +84,21 @@ void DeltaGliderXR1::SetFuelDumpState(bool& fuelDumpInProgress, const bool isDum
         ShowInfo(nullptr, DeltaGliderXR1::ST_None, temp);
     }
 
-    // Convert the fueldump reference to a string; this is a bit of a hack since it checks pointer addresses instead
+    // Convert the fueldump reference to an event type; this is a bit of a hack since it checks pointer addresses instead
     // of a proper flag, but it should be fine since these will never change.
-    const char* pEventName;
+    XR_EVENT_TYPE eventType = XR_EVENT_TYPE::NONE;
     const bool* pIsInProgress = &fuelDumpInProgress;
     if (pIsInProgress == &m_mainFuelDumpInProgress)
-        pEventName = "MAINDUMP";
+        eventType = XR_EVENT_TYPE::MAINDUMP;
     else if (pIsInProgress == &m_rcsFuelDumpInProgress)
-        pEventName = "RCSDUMP";
+        eventType = XR_EVENT_TYPE::RCSDUMP;
     else if (pIsInProgress == &m_scramFuelDumpInProgress)
-        pEventName = "SCRAMDUMP";
+        eventType = XR_EVENT_TYPE::SCRAMDUMP;
     else if (pIsInProgress == &m_apuFuelDumpInProgress)
-        pEventName = "APUDUMP";
+        eventType = XR_EVENT_TYPE::APUDUMP;
 
     // save a replay event
-    RecordEvent(pEventName, (isDumping ? "ON" : "OFF"));
+    RecordXREvent(eventType, (isDumping ? XR_EVENT_VALUE::ON : XR_EVENT_VALUE::OFF));
 }
 
 void DeltaGliderXR1::SetLOXDumpState(const bool isDumping)
@@ -118,7 +118,7 @@ void DeltaGliderXR1::SetLOXDumpState(const bool isDumping)
     }
 
     // save a replay event
-    RecordEvent("LOXDUMP", (isDumping ? "ON" : "OFF"));
+    RecordXREvent(XR_EVENT_TYPE::LOXDUMP, (isDumping ? XR_EVENT_VALUE::ON : XR_EVENT_VALUE::OFF));
 }
 
 // Request that external cooling be enabled or disabled.
@@ -54,6 +54,8 @@ bool DeltaGliderXR1::InitSound()
     sprintf(msg, "Using XRSound version: %.2f", xrSoundVersion);
     GetXR1Config()->WriteLog(msg);
 
+    m_soundVoiceCache.Initialize(m_pXRSound, GetXR1Config()->SoundCacheBudgetKB * 1024);
+
     // disable any default XRSounds that we implement ourselves here via code
     XRSoundOnOff(XRSound::AudioGreeting, false);
     XRSoundOnOff(XRSound::SwitchOn, false);
@@ -91,7 +93,7 @@ bool DeltaGliderXR1::InitSound()
     XRSoundOnOff(XRSound::SubsonicCallout, false);
     XRSoundOnOff(XRSound::SonicBoom, false);
 
-    // load sounds
+    // register sounds: each file is loaded on demand the first time it is played
     LoadXR1Sound(SwitchOn, "SwitchOn1.wav", XRSound::PlaybackType::InternalOnly);
     LoadXR1Sound(SwitchOff, "SwitchOff1.wav", XRSound::PlaybackType::InternalOnly);
     LoadXR1Sound(Off, "Off.wav", XRSound::PlaybackType::Radio);
@@ -136,7 +138,7 @@ bool DeltaGliderXR1::InitSound()
     return true;
 }
 
-// load a WAV file for XRSound to use
+// Assign a WAV file to a sound ID; the file is not loaded into XRSound until the sound is played.
 void DeltaGliderXR1::LoadXR1Sound(const Sound sound, const char* pFilename, XRSound::PlaybackType playbackType)
 {
     if (!m_pXRSound->IsPresent())
@@ -144,11 +146,7 @@ void DeltaGliderXR1::LoadXR1Sound(const Sound sound, const char* pFilename, XRSo
 
     // use member variable here so we can preserve the last file loaded for debugging purposes
     sprintf(m_lastWavLoaded, "%s\\%s", m_pXRSoundPath, pFilename);
-    BOOL stat = m_pXRSound->LoadWav(sound, m_lastWavLoaded, playbackType);
-#ifdef _DEBUG
-    if (!stat)
-        sprintf(oapiDebugString(), "ERROR: LoadXR1Sound: LoadWav failed, filename='%s'", pFilename);
-#endif
+    m_soundVoiceCache.Register(sound, m_lastWavLoaded, playbackType);
 }
 
 // play a sound via the XRSound SDK
@@ -235,7 +233,8 @@ void DeltaGliderXR1::PlaySound(Sound sound, const SoundType soundType, int volum
 
     // play the sound!
     const float volFrac = min(static_cast<float>(volume) / 255.0f, 1.0f);  // convert legacy volume 0-255 to 0-1.0.
-    BOOL stat = m_pXRSound->PlayWav(sound, bLoop, volFrac);
+    const int voiceID = m_soundVoiceCache.AcquireVoice(sound);   // loads the WAV file if this is the first time it is played
+    BOOL stat = ((voiceID > 0) && m_pXRSound->PlayWav(voiceID, bLoop, volFrac));
 
     // We don't want "missing wave file" errors showing up for users; they may want to delete
     // some sound files because they don't like them, so we don't want to clutter the log with
@@ -251,7 +250,9 @@ void DeltaGliderXR1::PlaySound(Sound sound, const SoundType soundType, int volum
         GetXR1Config()->WriteLog(temp);
 
         // now let's play an audible alert, too
-        m_pXRSound->PlayWav(ErrorSoundFileMissing);
+        const int errorVoiceID = m_soundVoiceCache.AcquireVoice(ErrorSoundFileMissing);
+        if (errorVoiceID > 0)
+            m_pXRSound->PlayWav(errorVoiceID);
     }
 #endif
 }
@@ -267,7 +268,9 @@ void DeltaGliderXR1::StopSound(Sound sound)
         return;
 
     // OK if sound is already stopped here
-    m_pXRSound->StopWav(sound);
+    const int voiceID = m_soundVoiceCache.GetVoice(sound);
+    if (voiceID > 0)   // else the sound was never loaded, so it cannot be playing
+        m_pXRSound->StopWav(voiceID);
 }
 
 // check whether the specified sound is playing
@@ -276,7 +279,8 @@ bool DeltaGliderXR1::IsPlaying(Sound sound) const
     if (!m_pXRSound->IsPresent())
         return false;
 
-    return m_pXRSound->IsWavPlaying(sound);
+    const int voiceID = m_soundVoiceCache.GetVoice(sound);
+    return ((voiceID > 0) && m_pXRSound->IsWavPlaying(voiceID));
 }
 
 // play a warning sound and display a warning message via the DisplayWarningPoststep
@@ -345,10 +349,10 @@ void DeltaGliderXR1::ShowInfo(const char* pSoundFilename, const SoundType soundT
 void DeltaGliderXR1::PlayErrorBeep()
 {
     // stop any switch or key sounds that may have been started
-    m_pXRSound->StopWav(SwitchOn);
-    m_pXRSound->StopWav(SwitchOff);
-    m_pXRSound->StopWav(BeepHigh);
-    m_pXRSound->StopWav(BeepLow);
+    StopSound(SwitchOn);
+    StopSound(SwitchOff);
+    StopSound(BeepHigh);
+    StopSound(BeepLow);
 
     PlaySound(Error1, ST_Other, ERROR1_VOL);      // error beep
 }
@@ -176,6 +176,19 @@ void DeltaGliderXR1::HLiftCoeff(VESSEL* v, double beta, double M, double Re, voi
     *cd = PROFILE_DRAG + oapiGetInducedDrag(*cl, 1.5, 0.6) + oapiGetWaveDrag(M, 0.75, 1.0, 1.1, 0.04);
 }
 
+// Orbiter invokes our airfoil functions for every airfoil on every vessel each frame, so our airfoils use these tables instead
+AeroCoeffTable *DeltaGliderXR1::GetVLiftCoeffTable()
+{
+    static AeroCoeffTable s_table(VLiftCoeff);
+    return &s_table;
+}
+
+AeroCoeffTable *DeltaGliderXR1::GetHLiftCoeffTable()
+{
+    static AeroCoeffTable s_table(HLiftCoeff);
+    return &s_table;
+}
+
 // static data
 HWND DeltaGliderXR1::s_hPayloadEditorDialog = 0;
 
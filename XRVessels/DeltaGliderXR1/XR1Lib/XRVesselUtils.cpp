@@ -364,10 +364,10 @@ void DeltaGliderXR1::TweakInternalValue(bool direction)
 	const int stepSize = static_cast<int>(oapiGetSimStep() * 200);
 	const int step = stepSize * (direction ? 1 : -1);
 
-	const int position = m_pXRSound->GetPlayPosition(Sound::RetroDoorsAreClosed) + step;
+	const int position = m_pXRSound->GetPlayPosition(m_soundVoiceCache.GetVoice(Sound::RetroDoorsAreClosed)) + step;
 	sprintf(oapiDebugString(), "PlayPosition=%d", position);
 
-	m_pXRSound->SetPlayPosition(Sound::RetroDoorsAreClosed, position);
+	m_pXRSound->SetPlayPosition(m_soundVoiceCache.GetVoice(Sound::RetroDoorsAreClosed), position);
 #endif
 #endif  // ifdef DEBUG
 }
@@ -396,7 +396,7 @@ void DeltaGliderXR1::TogglePayloadEditor()
 	}
 }
 
-// returns the total payload mass in KG
+// returns the total payload mass in KG; this is the payload bay's running total, so it does not walk the bay
 double DeltaGliderXR1::GetPayloadMass() const
 {
 	if (m_pPayloadBay == nullptr)
@@ -489,12 +489,56 @@ void DeltaGliderXR1::AlteaLogoClicked()
 
 // --------------------------------------------------------------
 // Set vessel mass excluding propellants
-// NOTE: this is invoked automatically each frame by UpdateMassPostStep
+// NOTE: this is invoked automatically each frame by UpdateMassPostStep.
+// The mass budget is kept current by the code that changes each item: crew
+// members are counted when they board or leave, and the payload bay keeps
+// its payload mass current as payload is attached, detached, or refueled.
+// Orbiter is updated only if the total changed.
 // --------------------------------------------------------------
 void DeltaGliderXR1::SetEmptyMass()
+{
+	SetMassBudgetItem(MASS_ITEM::PAYLOAD, GetPayloadMass());   // does not walk the bay
+
+	if (m_massBudget.IsPushRequired())
+		VESSEL2::SetEmptyMass(m_massBudget.Push());
+
+#ifdef _DEBUG
+	// Cross-check the budget against a full recomputation, which reads each payload vessel's mass.  Note that a payload
+	// vessel that changes its own mass is only picked up by the bay's next slot refresh, so it can trip this as well.
+	const double emass = ComputeEmptyMass();
+	_ASSERTE(fabs(m_massBudget.GetTotalMass() - emass) <= (emass * 1e-9) + 1e-6);
+#endif
+}
+
+// --------------------------------------------------------------
+// Returns the vessel's empty mass recomputed from scratch, walking
+// each crew member and each payload vessel in the bay; this is what
+// m_massBudget tracks.
+// --------------------------------------------------------------
+double DeltaGliderXR1::ComputeEmptyMass() const
 {
 	double emass = EMPTY_MASS;
 
+	emass += ComputeCrewMass();
+
+	// add APU fuel
+	emass += m_apuFuelQty;
+
+	// add LOX from the INTERNAL TANK ONLY
+	emass += m_loxQty;
+
+	// add payload; the cheatcode overrides the payload vessels, as in GetPayloadMass
+	if (m_pPayloadBay != nullptr)
+		emass += ((CARGO_MASS != -1.0) ? CARGO_MASS : m_pPayloadBay->ComputePayloadMass());
+
+	return emass;
+}
+
+// Returns the total mass of the crew members on board
+double DeltaGliderXR1::ComputeCrewMass() const
+{
+	double crewMass = 0;
+
 	// Retrieve passenger mass from MMU; we have to manage this ourselves since we have other things
 	// that affect ship mass.
 	for (int i = 0; i < MAX_PASSENGERS; i++)
@@ -505,19 +549,10 @@ void DeltaGliderXR1::SetEmptyMass()
 		const int crewMemberMass = 68;      // 150 lb average
 #endif
 		if (crewMemberMass >= 0)
-			emass += crewMemberMass;
+			crewMass += crewMemberMass;
 	}
 
-	// add APU fuel
-	emass += m_apuFuelQty;
-
-	// add LOX from the INTERNAL TANK ONLY
-	emass += m_loxQty;
-
-	// add payload
-	emass += GetPayloadMass();
-
-	VESSEL2::SetEmptyMass(emass);
+	return crewMass;
 }
 
 void DeltaGliderXR1::ScramjetThrust()
@@ -600,7 +635,7 @@ void DeltaGliderXR1::SetNavlight(bool on)
 	TriggerRedrawArea(AID_NAVLIGHTSWITCH);
 	TriggerRedrawArea(AID_SWITCHLED_NAV);
 	UpdateCtrlDialog(this);
-	RecordEvent("NAVLIGHT", on ? "ON" : "OFF");
+	RecordXREvent(XR_EVENT_TYPE::NAVLIGHT, on ? XR_EVENT_VALUE::ON : XR_EVENT_VALUE::OFF);
 }
 
 void DeltaGliderXR1::SetBeacon(bool on)
@@ -609,7 +644,7 @@ void DeltaGliderXR1::SetBeacon(bool on)
 	TriggerRedrawArea(AID_BEACONSWITCH);
 	TriggerRedrawArea(AID_SWITCHLED_BEACON);  // repaint the new indicator as well
 	UpdateCtrlDialog(this);
-	RecordEvent("BEACONLIGHT", on ? "ON" : "OFF");
+	RecordXREvent(XR_EVENT_TYPE::BEACONLIGHT, on ? XR_EVENT_VALUE::ON : XR_EVENT_VALUE::OFF);
 }
 
 void DeltaGliderXR1::SetStrobe(bool on)
@@ -618,7 +653,7 @@ void DeltaGliderXR1::SetStrobe(bool on)
 	TriggerRedrawArea(AID_STROBESWITCH);
 	TriggerRedrawArea(AID_SWITCHLED_STROBE);  // repaint the new indicator as well
 	UpdateCtrlDialog(this);
-	RecordEvent("STROBELIGHT", on ? "ON" : "OFF");
+	RecordXREvent(XR_EVENT_TYPE::STROBELIGHT, on ? XR_EVENT_VALUE::ON : XR_EVENT_VALUE::OFF);
 }
 
 void DeltaGliderXR1::EnableRetroThrusters(bool state)
@@ -747,7 +782,7 @@ void DeltaGliderXR1::ResetMET()
 	ShowInfo("Mission Elapsed Time Reset.wav", DeltaGliderXR1::ST_InformationCallout, "Mission Elapsed Time reset; timer&will start at liftoff.");
 	m_metMJDStartingTime = -1;     // reset timer
 	m_metTimerRunning = false;     // not running now
-	RecordEvent("RESETMET", ".");
+	RecordXREvent(XR_EVENT_TYPE::RESETMET, XR_EVENT_VALUE::NONE);
 }
 
 void DeltaGliderXR1::UpdateCtrlDialog(DeltaGliderXR1 *dg, HWND hWnd)
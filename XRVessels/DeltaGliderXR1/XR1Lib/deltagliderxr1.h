@@ -34,9 +34,14 @@
 #include "resource.h"
 #include "InstrumentPanel.h"
 #include "XRSound.h"
+#include "XRSoundVoiceCache.h"
+#include "XRConsumables.h"
 #include "XR1ConfigFileParser.h"
 #include "TextBox.h"
 #include "XR1Globals.h"
+#include "AeroCoeffTable.h"
+#include "XR1PlaybackEvents.h"
+#include "XRMassBudget.h"
 
 #ifdef MMU
 #include "UMmuSDK.h"
@@ -66,6 +71,11 @@ public:
     static void VLiftCoeff(VESSEL* v, double aoa, double M, double Re, void* context, double* cl, double* cm, double* cd);
     static void HLiftCoeff(VESSEL* v, double beta, double M, double Re, void* context, double* cl, double* cm, double* cd);
 
+    // Precomputed tables for VLiftCoeff and HLiftCoeff shared by all vessels in this DLL; pass these as the 
+    // context for AeroCoeffTable::AirfoilCoeffFunc.  Each table is built the first time it is requested.
+    static AeroCoeffTable *GetVLiftCoeffTable();
+    static AeroCoeffTable *GetHLiftCoeffTable();
+
     //
     // Global Orbiter API wrapper functions
     //
@@ -82,6 +92,9 @@ public:
     enum class GIMBAL_SWITCH { LEFT, RIGHT, BOTH };
     enum class DIRECTION { UP_OR_LEFT, DOWN_OR_RIGHT, DIR_NONE };
 
+    // items tracked by m_massBudget; together they make up the vessel's empty mass (i.e., everything except Orbiter propellant)
+    enum class MASS_ITEM { STRUCTURE, CREW, APU_FUEL, LOX, PAYLOAD, COUNT };
+
 #ifdef MMU
     UMMUCREWMANAGMENT UMmu;  // Universal MMU
 #endif
@@ -97,6 +110,13 @@ public:
     virtual void DefineAnimations();
     virtual void CleanUpAnimations();
     virtual void SetEmptyMass();
+    double ComputeEmptyMass() const;
+    double ComputeCrewMass() const;
+    void RefreshCrewMass() { SetMassBudgetItem(MASS_ITEM::CREW, ComputeCrewMass()); }
+    void SetAPUFuelQty(const double qty)   { m_apuFuelQty = qty; SetMassBudgetItem(MASS_ITEM::APU_FUEL, qty); }
+    void SetInternalLOXQty(const double qty) { m_loxQty = qty; SetMassBudgetItem(MASS_ITEM::LOX, qty); }   // internal tank only; see SetXRLOXMass
+    void SetMassBudgetItem(const MASS_ITEM item, const double mass) { m_massBudget.SetItemMass(static_cast<int>(item), mass); }
+    double GetMassBudgetItem(const MASS_ITEM item) const { return m_massBudget.GetItemMass(static_cast<int>(item)); }
     virtual void PerformCrashDamage();
     virtual bool CheckAllDoorDamage();
     virtual bool CheckHullHeatingDamage();
@@ -543,13 +563,15 @@ public:
     int     m_activeMultiDisplayMode;  // 0...n, or -1 if no mode set
     double  m_slope;            // ascent/descent slope in radians
     TempScale m_activeTempScale;  // 0=K, 1=F, 2=C
-    double  m_apuFuelQty;   // in kg
-    double  m_loxQty;       // in kg  (INTERNAL TANKS ONLY!)
+    double  m_apuFuelQty;   // in kg; set via SetAPUFuelQty
+    double  m_loxQty;       // in kg  (INTERNAL TANKS ONLY!); set via SetInternalLOXQty
+    XRMassBudget m_massBudget;  // items indexed by MASS_ITEM; sent to Orbiter by SetEmptyMass
     double  m_cabinO2Level; // cabin level of O2
     double  m_coolantTemp;  // in degrees C
     bool    m_internalSystemsFailure;  // if true, internal systems failed due to overheating
     bool    m_crewHatchInterlocksDisabled;       // cabin hatch switch armed
     bool    m_airlockInterlocksDisabled;           // outer airlock switch armed
+    XRConsumables m_consumables;   // fuel and LOX flows registered by the PostSteps each frame; integrated by IntegrateConsumablesPostStep
 
     // custom autopilot data
     AUTOPILOT  m_customAutopilotMode;
@@ -702,11 +724,27 @@ public:
 
     //=====================================================================
 
+    //
+    // Playback events; see XR1PlaybackEvents.cpp
+    //
+    virtual void RegisterPlaybackEvents(XRPlaybackEventTable &table);
+    const XRPlaybackEventTable &GetPlaybackEventTable();
+    void RecordXREvent(const XR_EVENT_TYPE type, const XR_EVENT_VALUE value, const int flags = 0, const float arg0 = 0, const float arg1 = 0, const float arg2 = 0);
+    void StartXREventPlayback(const double mjd);
+    void UpdateXREventRecorder(const double mjd);
+
+    XRPlaybackEventTable m_playbackEventTable;  // populated on first use; see GetPlaybackEventTable
+    XREventRecorder m_xrEventRecorder;          // open while Orbiter's flight recorder is running
+    XREventPlayer m_xrEventPlayer;              // open while playing back a recording that has a matching .xrevt file
+    bool m_xrEventRecordingStarted;             // true = we already tried to open m_xrEventRecorder for this recording session
+    bool m_xrEventPlaybackStarted;              // true = we already tried to open m_xrEventPlayer for this playback session
+
     //
     // XRSound
     //
     const char *m_pXRSoundPath;
     XRSound *m_pXRSound;
+    XRSoundVoiceCache m_soundVoiceCache;    // maps our Sound IDs to XRSound voices, loading each WAV file on first play
 
     // NOTE: sound IDs must start at 1, not 0!
     enum Sound
@@ -1011,7 +1049,8 @@ public:
     }
 
     // overridden base class methods
-    virtual bool clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf);
+    virtual double GetAreaRedrawInterval(const int areaID);
+    virtual REDRAW_PRIORITY GetAreaRedrawPriority(const int areaID);
 
     // payload bay methods for subclasses to use; these are not linked into the XR1
     virtual bool DeployPayload(const int slotNumber, const bool showMessage);
@@ -1030,13 +1069,13 @@ public:
     virtual double GetPayloadGrappleRangeLimit() const { return (IsLanded() ? PAYLOAD_GRAPPLE_RANGE_LANDED : PAYLOAD_GRAPPLE_RANGE_ORBIT); }
     virtual void ClearGrappleTarget(bool playBeep);
     virtual double GetPayloadMass() const;
+    double GetCachedPayloadMass() const { return GetMassBudgetItem(MASS_ITEM::PAYLOAD); }  // as of the last UpdateMassPostStep; does not walk the bay
     void TogglePayloadEditor();
     // No way to do this: bool TrackGrappleTarget(bool showMessage);
     
     // TRANSIENT payload data; used only by subclasses!
     ATTACHMENTHANDLE m_dummyAttachmentPoint; 
     XRPayloadBay *m_pPayloadBay;
-    double m_nextPayloadScreensRefresh[3];  // simt of next refresh for our three screens
     vector<const XRGrappleTargetVessel *> m_xrGrappleTargetVesselsInDisplayRange;   // list of XRGrappleTargetVessel objects; may be empty
     static HWND s_hPayloadEditorDialog;     // if non-zero, contains the window handle of the payload editor dialog; this is GLOBAL across all Ravenstar vessels since the dialog is a singleton
     // subclass bay doors, if any; these are not referenced by our class here
@@ -1067,6 +1106,7 @@ public:
 
 protected:
     virtual bool InitSound(); 
+    virtual void PopulateTelemetryRecord(XRTelemetryRecord &record) const;
     virtual void UpdateVCStatusIndicators();  // moved here
     virtual void FailAileronsIfDamaged();
     void ParseXRConfigFile();  // all XR vessels should invoke this from the beginning of clbkSetClassCaps
@@ -1099,17 +1139,6 @@ protected:
     virtual void ReinitializeDamageableControlSurfaces();  // creates control surfaces for any handles below that are zero
 	CTRLSURFHANDLE hLeftAileron, hRightAileron, hElevator, hElevatorTrim;         // control surface handles
 
-    // custom refresh data
-    double m_nextMDARefresh;            // simt for next PANEL_REDRAW_ALWAYS event
-    double m_nextSecondaryHUDRefresh;   // simt for next PANEL_REDRAW_ALWAYS event
-    double m_nextTertiaryHUDRefresh;    // simt for next PANEL_REDRAW_ALWAYS event
-    double m_nextArtificialHorizonRefresh;  // simt for next PANEL_REDRAW_ALWAYS event
-
-    // map of areaID -> simt of next update (only contains PANEL_REDRAW_ALWAYS areas)
-    typedef unordered_map<unsigned int, double> HASHMAP_UINT_DOUBLE;
-    typedef pair<unsigned int, double> uint_double_Pair;
-    HASHMAP_UINT_DOUBLE m_nextRedrawAlwaysRefreshMap;  // key=area ID, value = simt of next update for this component
-
     // bitmask that tracks all fuel-related config file overrides that were loaded with this scenario
 #define CONFIG_OVERRIDE_MainFuelISP               0x00000001
 #define CONFIG_OVERRIDE_SCRAMFuelISP              0x00000002
@@ -140,6 +140,9 @@ bool DeltaGliderXR1::DeployPayload(const int slotNumber, const bool showMessage)
     // Also set the grapple target to the newly-deployed vessel.
     if (retVal)
     {
+        // save a replay event
+        RecordXREvent(XR_EVENT_TYPE::PAYLOADDEPLOY, XR_EVENT_VALUE::NONE, 0, static_cast<float>(slotNumber), static_cast<float>(m_deployDeltaV));
+
         // must refresh cargo in range since we just "added" another vessel by detaching one from the bay
         RefreshGrappleTargetsInDisplayRange(); 
 
@@ -215,9 +218,12 @@ int DeltaGliderXR1::DeployAllPayload()
 
     // do not change the grapple target
 
-    // on success, refresh cargo in range
+    // on success, save a replay event and refresh cargo in range
     if (retVal)
+    {
+        RecordXREvent(XR_EVENT_TYPE::PAYLOADDEPLOYALL, XR_EVENT_VALUE::NONE, 0, static_cast<float>(m_deployDeltaV));
         RefreshGrappleTargetsInDisplayRange(); 
+    }
 
     return retVal;
 }
@@ -37,6 +37,7 @@
 #include "DlgCtrl.h"
 #include "XRPayload.h"
 #include "XRPayloadBaySlot.h"
+#include "XRPayloadThumbnailCache.h"
 
 // static font handles
 HFONT XR1PayloadDialog::s_hOrgFont;      // normal button font handle
@@ -135,6 +136,12 @@ INT_PTR CALLBACK XR1PayloadDialog::Proc(HWND hDlg, UINT uMsg, WPARAM wParam, LPA
         {
         case TIMERID_REFRESH_MASS:     // refresh the mass readout values
             UpdateMassValues(hDlg, GetXR1(hDlg));
+            {
+                // pick up the selected payload's thumbnail once the background loader has decoded it
+                char pSelectedClassname[256];
+                if (GetSelectedPayloadClassname(hDlg, pSelectedClassname, sizeof(pSelectedClassname)) > 0)
+                    UpdateThumbnail(hDlg, XRPayloadClassData::GetXRPayloadClassDataForClassname(pSelectedClassname));
+            }
             return 0;
 
         case TIMERID_REFRESH_BAY:     // refresh the bay contents
@@ -225,6 +232,7 @@ INT_PTR CALLBACK XR1PayloadDialog::Proc(HWND hDlg, UINT uMsg, WPARAM wParam, LPA
         return TRUE;
 
     case WM_CLOSE:
+         ReleaseThumbnail(hDlg);
          DeltaGliderXR1::s_hPayloadEditorDialog = 0;   // in case the sim is closing
          break;  // fall through to oapiDefDialogProc
 	}
@@ -239,6 +247,7 @@ void XR1PayloadDialog::CloseDialog(HWND hDlg)
     // clean up dialog-specific resources
     KillTimer(hDlg, TIMERID_REFRESH_MASS);
     KillTimer(hDlg, TIMERID_REFRESH_BAY);
+    ReleaseThumbnail(hDlg);
 
     if (s_hOrgFont != nullptr)
     {
@@ -277,10 +286,35 @@ void XR1PayloadDialog::UpdatePayloadFields(HWND hDlg, const char *pClassname)
     sprintf(msg, "%.1f L x %.1f W x %.1f H", slots.z, slots.x, slots.y); 
     SetDlgItemText(hDlg, IDC_STATIC_SLOTS_OCCUPIED, msg);
 
-    // show the bitmap preview, if any (may be null)
-    const HBITMAP hBmp = pd.GetThumbnailBitmapHandle();
+    // show the bitmap preview, if any
+    UpdateThumbnail(hDlg, pd);
+}
+
+// Show the thumbnail for the supplied payload if it is not already shown.
+// Thumbnails are decoded in the background, so this is also invoked from our refresh timer: until the
+// payload's own thumbnail is ready the default thumbnail is shown.
+// The picture control keeps using the bitmap after STM_SETIMAGE, so the displayed thumbnail stays pinned 
+// in the thumbnail cache until it is replaced or the dialog closes.
+void XR1PayloadDialog::UpdateThumbnail(HWND hDlg, const XRPayloadClassData &pd)
+{
+    const HBITMAP hBmp = pd.GetThumbnailBitmapHandle();  // may be null
+    HWND hPictureCtrl = ::GetDlgItem(hDlg, IDC_STATIC_THUMBNAIL_BMP);
+    const HBITMAP hOldBmp = reinterpret_cast<HBITMAP>(::SendMessage(hPictureCtrl, STM_GETIMAGE, IMAGE_BITMAP, 0));
+    if (hOldBmp != hBmp)
+    {
+        XRPayloadThumbnailCache &thumbnailCache = XRPayloadThumbnailCache::GetInstance();
+        thumbnailCache.Pin(hBmp);
+        ::SendMessage(hPictureCtrl, STM_SETIMAGE, IMAGE_BITMAP, reinterpret_cast<LPARAM>(hBmp));   // TODO: figure out what a nullptr hBmp here does to the image; is it blank?
+        thumbnailCache.Unpin(hOldBmp);
+    }
+}
+
+// Remove the displayed thumbnail from our picture control and unpin it so the thumbnail cache may free it
+void XR1PayloadDialog::ReleaseThumbnail(HWND hDlg)
+{
     HWND hPictureCtrl = ::GetDlgItem(hDlg, IDC_STATIC_THUMBNAIL_BMP);
-    ::SendMessage(hPictureCtrl, STM_SETIMAGE, IMAGE_BITMAP, reinterpret_cast<LPARAM>(hBmp));   // TODO: figure out what a nullptr hBmp here does to the image; is it blank?
+    const HBITMAP hOldBmp = reinterpret_cast<HBITMAP>(::SendMessage(hPictureCtrl, STM_SETIMAGE, IMAGE_BITMAP, 0));
+    XRPayloadThumbnailCache::GetInstance().Unpin(hOldBmp);
 }
 
 // Refresh vessel and payload mass readouts
@@ -1022,10 +1022,10 @@ int DeltaGliderXR1::GetStatusScreenText(char *pLinesOut, const int maxLinesToRet
     {
         _ASSERTE(i >= 0);
         _ASSERTE(i < INFO_WARNING_BUFFER_LINES);
-        TextLine textLine = m_infoWarningTextLineGroup.GetLine(i);
+        const TextLine textLine = m_infoWarningTextLineGroup.GetLine(i);
         
-        // retrieve each line's string object and copy it to pLinesOut by value and terminating each with \r\n
-        strcat(pLinesOut, textLine.text.c_str());
+        // retrieve each line's text and copy it to pLinesOut by value and terminating each with \r\n
+        strcat(pLinesOut, textLine.text);
         strcat(pLinesOut, "\r\n");
     }
         
@@ -1278,4 +1278,50 @@ bool DeltaGliderXR1::SetCrossFeedMode(XRXFEED_STATE state)
     return true;
 }
 
-//=========================================================================
\ No newline at end of file
+//=========================================================================
+
+// Populate the XR system fields of our telemetry record; invoked once per frame from VESSEL3_EXT::PublishTelemetry only if telemetry or the flight data recorder is enabled.
+void DeltaGliderXR1::PopulateTelemetryRecord(XRTelemetryRecord &record) const
+{
+    VESSEL3_EXT::PopulateTelemetryRecord(record);   // core flight data
+
+    record.MainFuelMass = GetXRPropellantMass(ph_main);
+    record.RCSFuelMass = GetXRPropellantMass(ph_rcs);
+    record.ScramFuelMass = GetXRPropellantMass(ph_scram);
+    record.APUFuelMass = m_apuFuelQty;
+    record.LOXMass = GetXRLOXMass();
+
+    record.CoolantTemp = m_coolantTemp;
+    record.NoseconeTemp = m_noseconeTemp;
+    record.LeftWingTemp = m_leftWingTemp;
+    record.RightWingTemp = m_rightWingTemp;
+    record.CockpitTemp = m_cockpitTemp;
+    record.TopHullTemp = m_topHullTemp;
+    record.CenterOfGravity = GetCenterOfGravity();
+
+    record.GearProc = gear_proc;
+    record.NoseconeProc = nose_proc;
+    record.AirbrakeProc = brake_proc;
+    record.RadiatorProc = radiator_proc;
+    record.BayDoorsProc = ((m_pPayloadBay != nullptr) ? bay_proc : -1);   // the XR1 has no payload bay
+
+    record.AutopilotTargetPitch = m_setPitchOrAOA;
+    record.AutopilotTargetBank = m_setBank;
+    record.AutopilotTargetDescentRate = m_setDescentRate;
+    record.AutopilotTargetAirspeed = m_setAirspeed;
+    record.CustomAutopilotMode = static_cast<int>(m_customAutopilotMode);
+    record.AirspeedHoldEngaged = (m_airspeedHoldEngaged ? 1 : 0);
+    record.MWSActive = (m_MWSActive ? 1 : 0);
+    record.IsCrashed = (IsCrashed() ? 1 : 0);
+    record.LeftWingIntegrity = lwingstatus;
+    record.RightWingIntegrity = rwingstatus;
+
+    const XRSoundVoiceCache::Stats &soundStats = m_soundVoiceCache.GetStats();
+    record.SoundLoadMillis = ((soundStats.loads > 0) ? (soundStats.totalLoadMillis / soundStats.loads) : 0);
+    record.SoundCacheHitRate = ((soundStats.requests > 0) ? (static_cast<double>(soundStats.hits) / soundStats.requests) : 0);
+    record.SoundResidentBytes = soundStats.residentBytes;
+    record.SoundLoads = static_cast<int>(soundStats.loads);
+    record.SoundRequests = static_cast<int>(soundStats.requests);
+}
+
+//=========================================================================
@@ -79,8 +79,7 @@ void XR2MWSTestButtonArea::ProcessButtonAction(int event, double buttonDownSimt)
 //----------------------------------------------------------------------------------
 
 XR2WarningLightsArea::XR2WarningLightsArea(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID) :
-    XR1Area(parentPanel, panelCoordinates, areaID),
-    m_lightStateOn(false)
+    XR1Area(parentPanel, panelCoordinates, areaID)
 {
 }
 
@@ -89,10 +88,13 @@ void XR2WarningLightsArea::Activate()
     Area::Activate();  // invoke superclass method
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(26, 11), PANEL_REDRAW_USER, PANEL_MOUSE_IGNORE, PANEL_MAP_BACKGROUND);
     m_mainSurface = CreateSurface(IDB_XR2_WARNING_LIGHTS);
+    SubscribeToBlinkClock(BLINK_RATE::HZ_1);   // we repaint only when the blink state changes
 }
 
 bool XR2WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
 {
+    const bool lightStateOn = GetVessel().GetBlinkClock().IsOn(BLINK_RATE::HZ_1);
+
     // if TEST button pressed, all lights stay on regardless
     bool testModeActive = GetXR2().m_mwsTestActive;
 
@@ -102,9 +104,9 @@ bool XR2WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
         bool warningActive = GetXR2().m_xr2WarningLights[i];
 
         // light is ON if 1) test mode, or 2) warning is active and blink state is ON
-        if (testModeActive || (warningActive && m_lightStateOn))
+        if (testModeActive || (warningActive && lightStateOn))
         {
-            if (m_lightStateOn || testModeActive)
+            if (lightStateOn || testModeActive)
             {
                 // render the "lit up" texture
                 int x = 0;          // column
@@ -119,20 +121,6 @@ bool XR2WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
     return true;
 }
 
-void XR2WarningLightsArea::clbkPrePostStep(const double simt, const double simdt, const double mjd) 
-{
-    double di;
-    bool lightStateOn = (modf(simt, &di) < 0.5);   // blink twice a second; NOTE: this must match the XR1's WarningLightsArea time
-    if (lightStateOn != m_lightStateOn)  // has state switched?
-    {
-        // toggle the state and request a repaint
-        m_lightStateOn = lightStateOn;
-        TriggerRedraw();
-
-        // no sound with these lights
-    }
-}
-
 
 //----------------------------------------------------------------------------------
 // our custom hull temps multi-display mode
@@ -56,7 +56,7 @@ void SelectPayloadSlotArea::Activate()
     Area::Activate();  // invoke superclass method
     // register area
     // specify both PANEL_REDRAW_ALWAYS and PANEL_REDRAW_MOUSE because we need explicit mouse events
-    // Note that refresh rates are managed above us by clbkPanelRedrawEvent.
+    // Note that refresh rates are managed above us by GetAreaRedrawInterval.
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(s_screenSize.x, s_screenSize.y), PANEL_REDRAW_ALWAYS | PANEL_REDRAW_MOUSE, PANEL_MOUSE_LBDOWN, PANEL_MAP_BGONREQUEST);
 
     m_hSurface = CreateSurface(IDB_SELECT_BAY_SLOT);
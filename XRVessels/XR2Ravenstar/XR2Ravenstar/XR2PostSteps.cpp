@@ -103,3 +103,25 @@ void XR2DoorSoundsPostStep::clbkPrePostStep(const double simt, const double simd
     for (int i=0; i < doorCount; i++)
         PlayDoorSound(m_doorSounds[i], simt);
 }
+
+void XR2DoorSoundsPostStep::clbkResync(const double simt)
+{
+    // call the superclass to handle all the normal doors
+    DoorSoundsPostStep::clbkResync(simt);
+
+    // handle all our custom doors
+    const int doorCount = (sizeof(m_doorSounds) / sizeof(DoorSound));
+    for (int i=0; i < doorCount; i++)
+        ResyncDoorSound(m_doorSounds[i]);
+}
+
+void XR2DoorSoundsPostStep::clbkSkipped(const double simt, const double simdt, const double mjd)
+{
+    // call the superclass to handle all the normal doors
+    DoorSoundsPostStep::clbkSkipped(simt, simdt, mjd);
+
+    // handle all our custom doors
+    const int doorCount = (sizeof(m_doorSounds) / sizeof(DoorSound));
+    for (int i=0; i < doorCount; i++)
+        MarkAPUActiveIfDoorMoving(m_doorSounds[i]);
+}
@@ -52,6 +52,8 @@ class XR2DoorSoundsPostStep : public DoorSoundsPostStep
 public:
     XR2DoorSoundsPostStep(XR2Ravenstar &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void clbkResync(const double simt);
+    virtual void clbkSkipped(const double simt, const double simdt, const double mjd);
 
 protected:
     DoorSound m_doorSounds[1];   // custom doors
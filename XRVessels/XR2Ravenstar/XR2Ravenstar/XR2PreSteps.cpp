@@ -68,7 +68,7 @@ void XR2NosewheelSteeringPreStep::clbkPrePostStep(const double simt, const doubl
         GetXR2().SetXRAnimation(GetXR2().m_animNosewheelSteering, 0.5);    // recenter since steering is inactive
         return;
     }
-    else if (GetVessel().GroundContact() && (GetVessel().GetADCtrlMode() & 0x02))   // do a sanity check for ground contact and only enable nosewheel steering if rudder AF Ctrl surface is enabled (since anim tied to rudder)
+    else if (GetVessel().GetFlightState().GroundContact() && (GetVessel().GetADCtrlMode() & 0x02))   // do a sanity check for ground contact and only enable nosewheel steering if rudder AF Ctrl surface is enabled (since anim tied to rudder)
     {
         GetVessel().SetNosewheelSteering(true);
     }
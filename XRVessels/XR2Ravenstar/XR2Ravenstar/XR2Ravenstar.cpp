@@ -59,6 +59,7 @@ DLLCLBK void ExitModule (HINSTANCE hModule)
 {
     oapiUnregisterCustomControls(hModule);
     XRPayloadClassData::Terminate();     // clean up global cache
+    XRLogWriter::Terminate();            // flush and close the log file
 }
 
 // --------------------------------------------------------------
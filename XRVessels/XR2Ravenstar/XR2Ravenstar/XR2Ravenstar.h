@@ -57,7 +57,6 @@ public:
     // overridden callback functions
     virtual void clbkSetClassCaps (FILEHANDLE cfg);
     virtual void clbkPostCreation ();
-    virtual bool clbkPlaybackEvent (double simt, double event_t, const char *event_type, const char *event);
     virtual void clbkVisualCreated (VISHANDLE vis, int refcount);
     virtual void clbkVisualDestroyed (VISHANDLE vis, int refcount);
     virtual bool clbkLoadVC(int id);  // NOTE: OVERRIDING THIS IS MANDATORY!
@@ -66,7 +65,8 @@ public:
     virtual int  clbkConsumeBufferedKey(DWORD key, bool down, char *kstate);
     virtual bool clbkLoadGenericCockpit();
     virtual void clbkADCtrlMode(DWORD mode);
-    virtual bool clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf);
+    virtual double GetAreaRedrawInterval(const int areaID);
+    virtual REDRAW_PRIORITY GetAreaRedrawPriority(const int areaID);
 
     // overridden superclass methods
     virtual void SetXRAnimation(const UINT &anim, const double state) const;
@@ -565,12 +565,12 @@ void XR2Ravenstar::clbkSetClassCaps(FILEHANDLE cfg)
 
     // center of lift matches center of mass
     // NOTE: this airfoil's force attack point will be modified by the SetCenterOfLift PreStep 
-    hwing = CreateAirfoil3(LIFT_VERTICAL, _V(m_wingBalance, 0, m_centerOfLift), VLiftCoeff, nullptr, 5 * XR1Multiplier, WING_AREA, WING_ASPECT_RATIO);
+    hwing = CreateAirfoil3(LIFT_VERTICAL, _V(m_wingBalance, 0, m_centerOfLift), AeroCoeffTable::AirfoilCoeffFunc, GetVLiftCoeffTable(), 5 * XR1Multiplier, WING_AREA, WING_ASPECT_RATIO);
 
     ReinitializeDamageableControlSurfaces();  // create ailerons, elevators, and elevator trim
 
     // vertical stabiliser and body lift and drag components
-    CreateAirfoil3(LIFT_HORIZONTAL, _V(0, 0, m_ctrlSurfacesDeltaZ), HLiftCoeff, nullptr, 5 * XR1Multiplier, 15 * XR1Multiplier, 1.5);
+    CreateAirfoil3(LIFT_HORIZONTAL, _V(0, 0, m_ctrlSurfacesDeltaZ), AeroCoeffTable::AirfoilCoeffFunc, GetHLiftCoeffTable(), 5 * XR1Multiplier, 15 * XR1Multiplier, 1.5);
     CreateControlSurface(AIRCTRL_RUDDER, 0.8 * XR1Multiplier, 1.5, _V(0, 0, m_ctrlSurfacesDeltaZ), AIRCTRL_AXIS_YPOS, anim_rudder);
 
     // Create a hidden elevator trim to fix the nose-up tendency on liftoff and allow the elevator trim to be truly neutral.
@@ -607,7 +607,7 @@ void XR2Ravenstar::clbkSetClassCaps(FILEHANDLE cfg)
 
     // default to full LOX tank if not loaded from save file 
     if (m_loxQty < 0)
-        m_loxQty = GetXR1Config()->GetMaxLoxMass();
+        SetInternalLOXQty(GetXR1Config()->GetMaxLoxMass());
 
     // ********************* beacon lights **********************
     const double bd = 0.15;  // beacon delta from the mesh edge
@@ -745,44 +745,44 @@ void XR2Ravenstar::clbkSetClassCaps(FILEHANDLE cfg)
     m_pActiveAirlockDoorStatus = &olock_status;
 
     //
-    // Initialize and cache all instrument panels
+    // Register all instrument panels; each panel is constructed the first time it is loaded
     //
 
     // 1920-pixel-wide panels
-    AddInstrumentPanel(new XR2MainInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR2UpperInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR2LowerInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR2PayloadInstrumentPanel1920(*this), 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR2MainInstrumentPanel1920, XR2Ravenstar>(*this), PANEL_MAIN, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR2UpperInstrumentPanel1920, XR2Ravenstar>(*this), PANEL_UPPER, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR2LowerInstrumentPanel1920, XR2Ravenstar>(*this), PANEL_LOWER, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR2PayloadInstrumentPanel1920, XR2Ravenstar>(*this), PANEL_PAYLOAD, 1920);
 
     // 1600-pixel-wide panels
-    AddInstrumentPanel(new XR2MainInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR2UpperInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR2LowerInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR2PayloadInstrumentPanel1600(*this), 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR2MainInstrumentPanel1600, XR2Ravenstar>(*this), PANEL_MAIN, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR2UpperInstrumentPanel1600, XR2Ravenstar>(*this), PANEL_UPPER, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR2LowerInstrumentPanel1600, XR2Ravenstar>(*this), PANEL_LOWER, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR2PayloadInstrumentPanel1600, XR2Ravenstar>(*this), PANEL_PAYLOAD, 1600);
 
     // 1280-pixel-wide panels
-    AddInstrumentPanel(new XR2MainInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR2UpperInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR2LowerInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR2PayloadInstrumentPanel1280(*this), 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR2MainInstrumentPanel1280, XR2Ravenstar>(*this), PANEL_MAIN, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR2UpperInstrumentPanel1280, XR2Ravenstar>(*this), PANEL_UPPER, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR2LowerInstrumentPanel1280, XR2Ravenstar>(*this), PANEL_LOWER, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR2PayloadInstrumentPanel1280, XR2Ravenstar>(*this), PANEL_PAYLOAD, 1280);
 
     // add our VC panels (panel width MUST be zero for these!)
     // TODO: after overhauling the XR1 base class for isVC handling, add a VC panel ID (3rd argument) to each VC panel here
-    AddInstrumentPanel(new XR2VCPilotInstrumentPanel(*this, PANELVC_PILOT), 0);
-    AddInstrumentPanel(new XR2VCCopilotInstrumentPanel(*this, PANELVC_COPILOT), 0);
-    AddInstrumentPanel(new XR2VCPassenger1InstrumentPanel(*this, PANELVC_PSNGR1), 0);
-    AddInstrumentPanel(new XR2VCPassenger2InstrumentPanel(*this, PANELVC_PSNGR2), 0);
-    AddInstrumentPanel(new XR2VCAirlockInstrumentPanel(*this, PANELVC_AIRLOCK), 0);
-    AddInstrumentPanel(new XR2VCPassenger3InstrumentPanel(*this, PANELVC_PSNGR3), 0);
-    AddInstrumentPanel(new XR2VCPassenger4InstrumentPanel(*this, PANELVC_PSNGR4), 0);
-    AddInstrumentPanel(new XR2VCPassenger5InstrumentPanel(*this, PANELVC_PSNGR5), 0);
-    AddInstrumentPanel(new XR2VCPassenger6InstrumentPanel(*this, PANELVC_PSNGR6), 0);
-    AddInstrumentPanel(new XR2VCPassenger7InstrumentPanel(*this, PANELVC_PSNGR7), 0);
-    AddInstrumentPanel(new XR2VCPassenger8InstrumentPanel(*this, PANELVC_PSNGR8), 0);
-    AddInstrumentPanel(new XR2VCPassenger9InstrumentPanel(*this, PANELVC_PSNGR9), 0);
-    AddInstrumentPanel(new XR2VCPassenger10InstrumentPanel(*this, PANELVC_PSNGR10), 0);
-    AddInstrumentPanel(new XR2VCPassenger11InstrumentPanel(*this, PANELVC_PSNGR11), 0);
-    AddInstrumentPanel(new XR2VCPassenger12InstrumentPanel(*this, PANELVC_PSNGR12), 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPilotInstrumentPanel, XR2Ravenstar>(*this, PANELVC_PILOT), PANELVC_PILOT, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCCopilotInstrumentPanel, XR2Ravenstar>(*this, PANELVC_COPILOT), PANELVC_COPILOT, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger1InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR1), PANELVC_PSNGR1, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger2InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR2), PANELVC_PSNGR2, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCAirlockInstrumentPanel, XR2Ravenstar>(*this, PANELVC_AIRLOCK), PANELVC_AIRLOCK, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger3InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR3), PANELVC_PSNGR3, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger4InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR4), PANELVC_PSNGR4, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger5InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR5), PANELVC_PSNGR5, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger6InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR6), PANELVC_PSNGR6, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger7InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR7), PANELVC_PSNGR7, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger8InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR8), PANELVC_PSNGR8, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger9InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR9), PANELVC_PSNGR9, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger10InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR10), PANELVC_PSNGR10, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger11InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR11), PANELVC_PSNGR11, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<XR2VCPassenger12InstrumentPanel, XR2Ravenstar>(*this, PANELVC_PSNGR12), PANELVC_PSNGR12, 0);
 
     // NOTE: default crew data is set AFTER the scenario file is parsed
 }
@@ -869,6 +869,7 @@ void XR2Ravenstar::clbkPostCreation()
     AddPostStep(new XFeedPostStep(*this));
     AddPostStep(new ResupplyPostStep(*this));
     AddPostStep(new LOXConsumptionPostStep(*this));
+    AddPostStep(new IntegrateConsumablesPostStep(*this));   // must follow all PostSteps that register fuel or LOX flows
     AddPostStep(new UpdateCoolantTempPostStep(*this));
     AddPostStep(new AirlockDecompressionPostStep(*this));
     AddPostStep(new AutoCenteringSimpleButtonAreasPostStep(*this));  // logic for all auto-centering button areas
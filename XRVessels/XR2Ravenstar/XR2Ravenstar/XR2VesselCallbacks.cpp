@@ -52,20 +52,6 @@ bool XR2Ravenstar::InitSound()
     return initSuccessful;
 }
 
-// --------------------------------------------------------------
-// Respond to playback event
-// NOTE: do not use spaces in any of these event ID strings.
-// Returns: true if handled, false if not
-// --------------------------------------------------------------
-bool XR2Ravenstar::clbkPlaybackEvent(double simt, double event_t, const char* event_type, const char* event)
-{
-    // handle our custom events first
-    // TODO: write me if necessary
-
-    // let our superclass have it
-    return DeltaGliderXR1::clbkPlaybackEvent(simt, event_t, event_type, event);
-}
-
 // --------------------------------------------------------------
 // Create visual
 // --------------------------------------------------------------
@@ -140,48 +126,32 @@ void XR2Ravenstar::clbkVisualDestroyed(VISHANDLE vis, int refcount)
     // Note: vcmesh remains nullptr at all times with the XR2
 }
 
-// override clbkPanelRedrawEvent so we can limit our refresh rates for our custom screens
-bool XR2Ravenstar::clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf)
+// override GetAreaRedrawInterval so we can limit our refresh rates for our custom screens
+double XR2Ravenstar::GetAreaRedrawInterval(const int areaID)
 {
-    const XR2ConfigFileParser* pConfig = GetXR2Config();
-
-    // Only filter PANEL_REDRAW_ALWAYS events for timing!
-    if (event == PANEL_REDRAW_ALWAYS)
+    switch (areaID)
     {
-        // NOTE: we want to check *realtime* deltas, not *simulation time* here: repaint frequency should not
-        // vary based on time acceleration.
-        const double uptime = GetSystemUptime();  // will always count up
-
-        // check for area IDs that have custom refresh rates
-        int screenIndex = 0;  // for payload screens
-        switch (areaID)
-        {
-        case AID_SELECT_PAYLOAD_BAY_SLOT_SCREEN:
-            goto check;     // 0
-
-        case AID_GRAPPLE_PAYLOAD_SCREEN:
-            screenIndex = 1;
-            goto check;
-
-        case AID_DEPLOY_PAYLOAD_SCREEN:
-            screenIndex = 2;
-        check:
-            if (uptime < m_nextPayloadScreensRefresh[screenIndex])
-                return false;
-
-            // update for next interval
-            m_nextPayloadScreensRefresh[screenIndex] = uptime + pConfig->PayloadScreensUpdateInterval;
+    case AID_SELECT_PAYLOAD_BAY_SLOT_SCREEN:
+    case AID_GRAPPLE_PAYLOAD_SCREEN:
+    case AID_DEPLOY_PAYLOAD_SCREEN:
+        return GetXR2Config()->PayloadScreensUpdateInterval;
+    }
 
-            // force the repaint to occur by invoking the VESSEL3 superclass directly; otherwise the XR1 impl would 
-            // see each of these areas as just another area and limit it by PanelUpdateInterval yet, which we want to bypass.
-            return VESSEL3_EXT::clbkPanelRedrawEvent(areaID, event, surf);
+    return DeltaGliderXR1::GetAreaRedrawInterval(areaID);
+}
 
-            // no default case here; fall through
-        }
+// the payload screens are the first areas deferred by the panel redraw budget
+REDRAW_PRIORITY XR2Ravenstar::GetAreaRedrawPriority(const int areaID)
+{
+    switch (areaID)
+    {
+    case AID_SELECT_PAYLOAD_BAY_SLOT_SCREEN:
+    case AID_GRAPPLE_PAYLOAD_SCREEN:
+    case AID_DEPLOY_PAYLOAD_SCREEN:
+        return REDRAW_PRIORITY::LOW;
     }
 
-    // redraw is OK: invoke the superclass to dispatch the redraw event
-    return DeltaGliderXR1::clbkPanelRedrawEvent(areaID, event, surf);
+    return DeltaGliderXR1::GetAreaRedrawPriority(areaID);
 }
 
 // --------------------------------------------------------------
@@ -143,6 +143,6 @@ void XR2Ravenstar::CreatePayloadBay()
     //
     // Create our dummy bay vessel attachment point; we want this to be FIRST so that the payload bay slot
     // indices begin at 1 in the scenario file; i.e., the numbers will match the slots.
-    VECTOR3 &attachVector = _V(0.0, 1.079, -2.977);
+    const VECTOR3 &attachVector = _V(0.0, 1.079, -2.977);
     m_dummyAttachmentPoint = CreateAttachment(false, attachVector, _V(0, -1.0, 0), _V(0, 0, 1.0), "XRDUMMY");
 }
@@ -89,8 +89,7 @@ void XR3MWSTestButtonArea::ProcessButtonAction(int event, double buttonDownSimt)
 //----------------------------------------------------------------------------------
 
 XR3WarningLightsArea::XR3WarningLightsArea(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID) :
-    XR1Area(parentPanel, panelCoordinates, areaID),
-    m_lightStateOn(false)
+    XR1Area(parentPanel, panelCoordinates, areaID)
 {
 }
 
@@ -99,10 +98,13 @@ void XR3WarningLightsArea::Activate()
     Area::Activate();  // invoke superclass method
     oapiRegisterPanelArea(GetAreaID(), GetRectForSize(26, 22), PANEL_REDRAW_USER, PANEL_MOUSE_IGNORE, PANEL_MAP_BACKGROUND);
     m_mainSurface = CreateSurface(IDB_XR3_WARNING_LIGHTS);
+    SubscribeToBlinkClock(BLINK_RATE::HZ_1);   // we repaint only when the blink state changes
 }
 
 bool XR3WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
 {
+    const bool lightStateOn = GetVessel().GetBlinkClock().IsOn(BLINK_RATE::HZ_1);
+
     // if TEST button pressed, all lights stay on regardless
     bool testModeActive = GetXR3().m_mwsTestActive;
 
@@ -112,9 +114,9 @@ bool XR3WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
         bool warningActive = GetXR3().m_XR3WarningLights[i];
 
         // light is ON if 1) test mode, or 2) warning is active and blink state is ON
-        if (testModeActive || (warningActive && m_lightStateOn))
+        if (testModeActive || (warningActive && lightStateOn))
         {
-            if (m_lightStateOn || testModeActive)
+            if (lightStateOn || testModeActive)
             {
                 // render the "lit up" texture
                 int x = 0;          // column
@@ -129,21 +131,6 @@ bool XR3WarningLightsArea::Redraw2D(const int event, const SURFHANDLE surf)
     return true;
 }
 
-void XR3WarningLightsArea::clbkPrePostStep(const double simt, const double simdt, const double mjd) 
-{
-    double di;
-    // NOTE: must use fabs simt here since simt may be negative!
-    bool lightStateOn = (modf(simt, &di) < 0.5);   // blink twice a second; NOTE: this must match the XR1's WarningLightsArea time
-    if (lightStateOn != m_lightStateOn)  // has state switched?
-    {
-        // toggle the state and request a repaint
-        m_lightStateOn = lightStateOn;
-        TriggerRedraw();
-
-        // no sound with these lights
-    }
-}
-
 
 //----------------------------------------------------------------------------------
 // our custom hull temps multi-display mode
@@ -53,6 +53,8 @@ class XR3DoorSoundsPostStep : public DoorSoundsPostStep
 public:
     XR3DoorSoundsPostStep(XR3Phoenix &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void clbkResync(const double simt);
+    virtual void clbkSkipped(const double simt, const double simdt, const double mjd);
 
 protected:
     DoorSound m_XR3doorSounds[2];   // custom doors
@@ -73,12 +73,6 @@ public:
     XR5WarningLightsArea(InstrumentPanel &parentPanel, const COORD2 panelCoordinates, const int areaID);
     virtual void Activate();
     virtual bool Redraw2D(const int event, const SURFHANDLE surf);
-
-protected:
-    virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
-
-    // state data
-    bool m_lightStateOn;  // true if light state (during blink) is ON
 };
 
 
@@ -138,6 +138,28 @@ void XR5DoorSoundsPostStep::clbkPrePostStep(const double simt, const double simd
         PlayDoorSound(m_xr5doorSounds[i], simt);
 }
 
+void XR5DoorSoundsPostStep::clbkResync(const double simt)
+{
+    // call the superclass to handle all the normal doors
+    DoorSoundsPostStep::clbkResync(simt);
+
+    // handle all our custom doors
+    const int doorCount = (sizeof(m_xr5doorSounds) / sizeof(DoorSound));
+    for (int i=0; i < doorCount; i++)
+        ResyncDoorSound(m_xr5doorSounds[i]);
+}
+
+void XR5DoorSoundsPostStep::clbkSkipped(const double simt, const double simdt, const double mjd)
+{
+    // call the superclass to handle all the normal doors
+    DoorSoundsPostStep::clbkSkipped(simt, simdt, mjd);
+
+    // handle all our custom doors
+    const int doorCount = (sizeof(m_xr5doorSounds) / sizeof(DoorSound));
+    for (int i=0; i < doorCount; i++)
+        MarkAPUActiveIfDoorMoving(m_xr5doorSounds[i]);
+}
+
 //---------------------------------------------------------------------------
 
 // Detect docking status changes and force active airlock as necessary; this is required
@@ -53,6 +53,8 @@ class XR5DoorSoundsPostStep : public DoorSoundsPostStep
 public:
     XR5DoorSoundsPostStep(XR5Vanguard &vessel);
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd);
+    virtual void clbkResync(const double simt);
+    virtual void clbkSkipped(const double simt, const double simdt, const double mjd);
 
 protected:
     DoorSound m_xr5doorSounds[2];   // custom doors
@@ -42,7 +42,7 @@ void SetCenterOfLiftPreStep::clbkPrePostStep(const double simt, const double sim
     // don't check for isCrashed here.
 
     // only function if in an atmosphere
-    const double pressure = GetVessel().GetAtmPressure() / 1000; // in kPa
+    const double pressure = GetVessel().GetFlightState().GetAtmPressure() / 1000; // in kPa
     if (pressure < 1.0e-6)
         return;     // no atm to speak of
 
@@ -66,7 +66,7 @@ void SetCenterOfLiftPreStep::clbkPrePostStep(const double simt, const double sim
     const double deploymentSpeedRange = FLAPS_FULLY_RETRACTED_SPEED - FLAPS_FULLY_DEPLOYED_SPEED;
 
     // get our velocity
-    const double airspeed = GetXR5().GetAirspeed();     // in meters-per-second
+    const double airspeed = GetXR5().GetFlightState().GetAirspeed();     // in meters-per-second
 
     // center of lift will vary between LOWSPEED_CENTER_OF_LIFT at fullyDeployedSpeed and HIGHSPEED_CENTER_OF_LIFT at fullyRetractedSpeed
     double movementRange = fabs(HIGHSPEED_CENTER_OF_LIFT - NEUTRAL_CENTER_OF_LIFT);    // in meters
@@ -129,7 +129,7 @@ void XR5NosewheelSteeringPreStep::clbkPrePostStep(const double simt, const doubl
         GetXR5().SetXRAnimation(GetXR5().m_animNosewheelSteering, 0.5);    // recenter since steering is inactive
         return;
     }
-    else if (GetVessel().GroundContact())   // do a sanity check for ground contact
+    else if (GetVessel().GetFlightState().GroundContact())   // do a sanity check for ground contact
     {
         GetVessel().SetNosewheelSteering(true);
     }
@@ -431,9 +431,9 @@ void XR5Vanguard::clbkSetClassCaps(FILEHANDLE cfg)
 
     // center of lift matches center of mass
     // NOTE: this airfoil's force attack point will be modified by the SetCenterOfLift PreStep 
-    hwing = CreateAirfoil3(LIFT_VERTICAL, _V(m_wingBalance, 0, m_centerOfLift), VLiftCoeff, nullptr, 5 * XR1Multiplier, WING_AREA, WING_ASPECT_RATIO);
+    hwing = CreateAirfoil3(LIFT_VERTICAL, _V(m_wingBalance, 0, m_centerOfLift), AeroCoeffTable::AirfoilCoeffFunc, GetVLiftCoeffTable(), 5 * XR1Multiplier, WING_AREA, WING_ASPECT_RATIO);
 
-    CreateAirfoil3(LIFT_HORIZONTAL, _V(0, 0, m_ctrlSurfacesDeltaZ + 3.0), HLiftCoeff, nullptr, 16.79, 15 * XR1Multiplier, 1.5);
+    CreateAirfoil3(LIFT_HORIZONTAL, _V(0, 0, m_ctrlSurfacesDeltaZ + 3.0), AeroCoeffTable::AirfoilCoeffFunc, GetHLiftCoeffTable(), 16.79, 15 * XR1Multiplier, 1.5);
 
     ReinitializeDamageableControlSurfaces();  // create ailerons, elevators, and elevator trim
 
@@ -475,7 +475,7 @@ void XR5Vanguard::clbkSetClassCaps(FILEHANDLE cfg)
 
     // default to full LOX tank if not loaded from save file 
     if (m_loxQty < 0)
-        m_loxQty = GetXR1Config()->GetMaxLoxMass();
+        SetInternalLOXQty(GetXR1Config()->GetMaxLoxMass());
 
     // ************************* mesh ***************************
 
@@ -590,38 +590,38 @@ void XR5Vanguard::clbkSetClassCaps(FILEHANDLE cfg)
     DefineMmuAirlock();  // required here so that UMMu loads the crew from the scenario file!
 
     //
-    // Initialize and cache all instrument panels
+    // Register all instrument panels; each panel is constructed the first time it is loaded
     //
 
     // 1920-pixel-wide panels
-    AddInstrumentPanel(new XR5MainInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR5UpperInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR5LowerInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR5OverheadInstrumentPanel1920(*this), 1920);
-    AddInstrumentPanel(new XR5PayloadInstrumentPanel1920(*this), 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR5MainInstrumentPanel1920, XR5Vanguard>(*this), PANEL_MAIN, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR5UpperInstrumentPanel1920, XR5Vanguard>(*this), PANEL_UPPER, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR5LowerInstrumentPanel1920, XR5Vanguard>(*this), PANEL_LOWER, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR5OverheadInstrumentPanel1920, XR5Vanguard>(*this), PANEL_OVERHEAD, 1920);
+    AddInstrumentPanel(new VesselPanelFactory<XR5PayloadInstrumentPanel1920, XR5Vanguard>(*this), PANEL_PAYLOAD, 1920);
 
     // 1600-pixel-wide panels
-    AddInstrumentPanel(new XR5MainInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR5UpperInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR5LowerInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR5OverheadInstrumentPanel1600(*this), 1600);
-    AddInstrumentPanel(new XR5PayloadInstrumentPanel1600(*this), 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR5MainInstrumentPanel1600, XR5Vanguard>(*this), PANEL_MAIN, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR5UpperInstrumentPanel1600, XR5Vanguard>(*this), PANEL_UPPER, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR5LowerInstrumentPanel1600, XR5Vanguard>(*this), PANEL_LOWER, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR5OverheadInstrumentPanel1600, XR5Vanguard>(*this), PANEL_OVERHEAD, 1600);
+    AddInstrumentPanel(new VesselPanelFactory<XR5PayloadInstrumentPanel1600, XR5Vanguard>(*this), PANEL_PAYLOAD, 1600);
 
     // 1280-pixel-wide panels
-    AddInstrumentPanel(new XR5MainInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR5UpperInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR5LowerInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR5OverheadInstrumentPanel1280(*this), 1280);
-    AddInstrumentPanel(new XR5PayloadInstrumentPanel1280(*this), 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR5MainInstrumentPanel1280, XR5Vanguard>(*this), PANEL_MAIN, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR5UpperInstrumentPanel1280, XR5Vanguard>(*this), PANEL_UPPER, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR5LowerInstrumentPanel1280, XR5Vanguard>(*this), PANEL_LOWER, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR5OverheadInstrumentPanel1280, XR5Vanguard>(*this), PANEL_OVERHEAD, 1280);
+    AddInstrumentPanel(new VesselPanelFactory<XR5PayloadInstrumentPanel1280, XR5Vanguard>(*this), PANEL_PAYLOAD, 1280);
 
     // no VC (yet!) for the XR5
 #ifdef UNDEF
     // add our VC panels
-    AddInstrumentPanel(new VCPilotInstrumentPanel(*this, PANELVC_PILOT), 0);
-    AddInstrumentPanel(new VCPassenger1InstrumentPanel(*this, PANELVC_PSNGR1), 0);
-    AddInstrumentPanel(new VCPassenger2InstrumentPanel(*this, PANELVC_PSNGR2), 0);
-    AddInstrumentPanel(new VCPassenger3InstrumentPanel(*this, PANELVC_PSNGR3), 0);
-    AddInstrumentPanel(new VCPassenger4InstrumentPanel(*this, PANELVC_PSNGR4), 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<VCPilotInstrumentPanel, XR5Vanguard>(*this, PANELVC_PILOT), PANELVC_PILOT, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<VCPassenger1InstrumentPanel, XR5Vanguard>(*this, PANELVC_PSNGR1), PANELVC_PSNGR1, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<VCPassenger2InstrumentPanel, XR5Vanguard>(*this, PANELVC_PSNGR2), PANELVC_PSNGR2, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<VCPassenger3InstrumentPanel, XR5Vanguard>(*this, PANELVC_PSNGR3), PANELVC_PSNGR3, 0);
+    AddInstrumentPanel(new VesselPanelIDFactory<VCPassenger4InstrumentPanel, XR5Vanguard>(*this, PANELVC_PSNGR4), PANELVC_PSNGR4, 0);
 #endif
 
 }
@@ -705,6 +705,7 @@ void XR5Vanguard::clbkPostCreation()
     AddPostStep(new XFeedPostStep(*this));
     AddPostStep(new ResupplyPostStep(*this));
     AddPostStep(new LOXConsumptionPostStep(*this));
+    AddPostStep(new IntegrateConsumablesPostStep(*this));   // must follow all PostSteps that register fuel or LOX flows
     AddPostStep(new UpdateCoolantTempPostStep(*this));
     AddPostStep(new AirlockDecompressionPostStep(*this));
     AddPostStep(new AutoCenteringSimpleButtonAreasPostStep(*this));  // logic for all auto-centering button areas
@@ -56,6 +56,7 @@ DLLCLBK void ExitModule (HINSTANCE hModule)
 {
     oapiUnregisterCustomControls(hModule);
     XRPayloadClassData::Terminate();     // clean up global cache
+    XRLogWriter::Terminate();            // flush and close the log file
 }
 
 // --------------------------------------------------------------
@@ -653,7 +654,7 @@ void XR5Vanguard::ActivateElevator(DoorStatus action)
     TriggerRedrawArea(AID_ELEVATORSWITCH);
     TriggerRedrawArea(AID_ELEVATORINDICATOR);
     UpdateCtrlDialog(this);
-    RecordEvent("ELEVATOR", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::ELEVATOR, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 // invoked from key handler
@@ -703,7 +704,7 @@ void XR5Vanguard::ActivateRadiator(DoorStatus action)
     TriggerRedrawArea(AID_RADIATORINDICATOR);
 
     UpdateCtrlDialog(this);
-    RecordEvent ("RADIATOR", close ? "CLOSE" : "OPEN");
+    RecordXREvent(XR_EVENT_TYPE::RADIATOR, close ? XR_EVENT_VALUE::CLOSE : XR_EVENT_VALUE::OPEN);
 }
 
 // prevent landing gear from being raised if the gear is not yet fully uncompressed
@@ -920,8 +921,9 @@ double XR5Vanguard::GetRCSThrustMax(const int index) const
     {
         if ((m_customAutopilotMode == AUTOPILOT::AP_ATTITUDEHOLD) || (m_customAutopilotMode == AUTOPILOT::AP_DESCENTHOLD))
         {
-            const double withPayloadMass = GetEmptyMass();        // includes payload
-            const double payloadMass = GetPayloadMass();
+            // this is invoked for each RCS thruster every frame, so use the cached mass budget instead of walking the payload bay
+            const double withPayloadMass = m_massBudget.GetTotalMass();     // includes payload
+            const double payloadMass = GetCachedPayloadMass();
             const double noPayloadMass = withPayloadMass - payloadMass;  // total mass without any payload
             const double multiplier = withPayloadMass / noPayloadMass;   // 1.0 = no payload, etc.
             rcsThrustMax *= multiplier;
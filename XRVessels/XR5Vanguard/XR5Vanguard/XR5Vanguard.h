@@ -49,14 +49,15 @@ public:
     // overloaded callback functions
     virtual void clbkSetClassCaps(FILEHANDLE cfg);
     virtual void clbkPostCreation();
-    virtual bool clbkPlaybackEvent(double simt, double event_t, const char *event_type, const char *event);
 	virtual void clbkVisualCreated(VISHANDLE vis, int refcount);
 	virtual void clbkVisualDestroyed(VISHANDLE vis, int refcount);
     virtual void clbkLoadStateEx(FILEHANDLE scn, void *vs);
     virtual void clbkSaveState (FILEHANDLE scn);
     virtual int clbkConsumeDirectKey (char *kstate);
     virtual int clbkConsumeBufferedKey(DWORD key, bool down, char *kstate);
-    virtual bool clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf);
+    virtual double GetAreaRedrawInterval(const int areaID);
+    virtual REDRAW_PRIORITY GetAreaRedrawPriority(const int areaID);
+    virtual void RegisterPlaybackEvents(XRPlaybackEventTable &table);
     virtual bool clbkLoadGenericCockpit();
 
     virtual void UpdateCtrlDialog(XR5Vanguard *dg, HWND hWnd = nullptr);
@@ -27,20 +27,16 @@
 #include "XR5AreaIDs.h"  
 
 // --------------------------------------------------------------
-// Respond to playback event
-// NOTE: do not use spaces in any of these event ID strings.
+// Register our playback events
+// NOTE: do not use spaces in any of these event names.
 // --------------------------------------------------------------
-bool XR5Vanguard::clbkPlaybackEvent(double simt, double event_t, const char* event_type, const char* event)
+void XR5Vanguard::RegisterPlaybackEvents(XRPlaybackEventTable &table)
 {
-    // check for XR5-specific events
-    if (!_stricmp(event_type, "ELEVATOR"))
-    {
-        ActivateElevator(!_stricmp(event, "CLOSE") ? DoorStatus::DOOR_CLOSING : DoorStatus::DOOR_OPENING);
-        return true;
-    }
+    // register the events common to all XR vessels
+    DeltaGliderXR1::RegisterPlaybackEvents(table);
 
-    // else let our superclass have it
-    return DeltaGliderXR1::clbkPlaybackEvent(simt, event_t, event_type, event);
+    // XR5-specific events
+    table.Register(XR_EVENT_TYPE::ELEVATOR, "ELEVATOR", [](DeltaGliderXR1 &xr1, const XREventRecord &r) { static_cast<XR5Vanguard &>(xr1).ActivateElevator(XRPlaybackEventTable::GetDoorAction(r)); return true; });
 }
 
 // --------------------------------------------------------------
@@ -111,46 +107,32 @@ void XR5Vanguard::clbkNavMode(int mode, bool active)
     DeltaGliderXR1::clbkNavMode(mode, active);
 }
 
-// override clbkPanelRedrawEvent so we can limit our refresh rates for our custom screens
-bool XR5Vanguard::clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf)
+// override GetAreaRedrawInterval so we can limit our refresh rates for our custom screens
+double XR5Vanguard::GetAreaRedrawInterval(const int areaID)
 {
-    const XR5ConfigFileParser* pConfig = GetXR5Config();
-
-    // Only filter PANEL_REDRAW_ALWAYS events for timing!
-    if (event == PANEL_REDRAW_ALWAYS)
+    switch (areaID)
     {
-        // NOTE: we want to check *realtime* deltas, not *simulation time* here: repaint frequency should not
-        // vary based on time acceleration.
-        const double uptime = GetSystemUptime();  // will always count up
-
-        // check for area IDs that have custom refresh rates
-        int screenIndex = 0;  // for payload screens
-        switch (areaID)
-        {
-        case AID_SELECT_PAYLOAD_BAY_SLOT_SCREEN:
-            goto check;     // 0
-
-        case AID_GRAPPLE_PAYLOAD_SCREEN:
-            screenIndex = 1;
-            goto check;
-
-        case AID_DEPLOY_PAYLOAD_SCREEN:
-            screenIndex = 2;
-        check:
-            if (uptime < m_nextPayloadScreensRefresh[screenIndex])
-                return false;
+    case AID_SELECT_PAYLOAD_BAY_SLOT_SCREEN:
+    case AID_GRAPPLE_PAYLOAD_SCREEN:
+    case AID_DEPLOY_PAYLOAD_SCREEN:
+        return GetXR5Config()->PayloadScreensUpdateInterval;
+    }
 
-            // update for next interval
-            m_nextPayloadScreensRefresh[screenIndex] = uptime + pConfig->PayloadScreensUpdateInterval;
+    return DeltaGliderXR1::GetAreaRedrawInterval(areaID);
+}
 
-            // force the repaint to occur by invoking the VESSEL3 superclass directly; otherwise the XR1 impl would 
-            // see each of these areas as just another area and limit it by PanelUpdateInterval yet, which we want to bypass.
-            return VESSEL3_EXT::clbkPanelRedrawEvent(areaID, event, surf);
-        }
+// the payload screens are the first areas deferred by the panel redraw budget
+REDRAW_PRIORITY XR5Vanguard::GetAreaRedrawPriority(const int areaID)
+{
+    switch (areaID)
+    {
+    case AID_SELECT_PAYLOAD_BAY_SLOT_SCREEN:
+    case AID_GRAPPLE_PAYLOAD_SCREEN:
+    case AID_DEPLOY_PAYLOAD_SCREEN:
+        return REDRAW_PRIORITY::LOW;
     }
 
-    // redraw is OK: invoke the superclass to dispatch the redraw event
-    return DeltaGliderXR1::clbkPanelRedrawEvent(areaID, event, surf);
+    return DeltaGliderXR1::GetAreaRedrawPriority(areaID);
 }
 
 
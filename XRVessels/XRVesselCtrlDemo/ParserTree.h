@@ -66,6 +66,11 @@ public:
         return m_rootParserTreeNode->Parse(pCommand, statusOut);
     }
 
+    const ParserTreeNode *Resolve(const char *pCommand, vector<CString> &leafArgvOut, CString &statusOut) const
+    {
+        return m_rootParserTreeNode->Resolve(pCommand, leafArgvOut, statusOut);
+    }
+
     void ResetAutocompletionState()
     {
         ParserTreeNode::ResetAutocompletionState(m_pAutocompletionState);
@@ -26,6 +26,7 @@
 
 #include <windows.h>
 #include <limits>
+#include <ctype.h>
 #include "ParserTreeNode.h"
 
 // so numeric_limits<T> min, max will compile
@@ -64,7 +65,7 @@
 //            Typically, however, this will be data that will be used later by the LeafHandler of this node or one of its children.  This is clone internally.
 // pCallback = handler that executes for leaf nodes; should be null for non-leaf nodes.  This is not cloned internally.
 ParserTreeNode::ParserTreeNode(const char *pNodeText, const int nodeGroup, const NodeData *pNodeData, LeafHandler *pCallback) :
-    m_nodeGroup(nodeGroup), m_pLeafHandler(pCallback), m_pParentNode(nullptr)
+    m_nodeGroup(nodeGroup), m_pLeafHandler(pCallback), m_pParentNode(nullptr), m_childTrie(1)
 {
     m_pCSNodeText = ((pNodeText != nullptr) ? new CString(pNodeText) : nullptr);   // clone it
     m_pNodeData = ((pNodeData != nullptr) ? pNodeData->Clone() : nullptr);         // deep-clone it
@@ -89,6 +90,62 @@ void ParserTreeNode::AddChild(ParserTreeNode *pChildNode)
     
     pChildNode->SetParentNode(this);   // we are the parent
     m_children.push_back(pChildNode);
+
+    // index the new child by each prefix of its node text; e.g., "s", "se", "set"
+    const CString &csNodeText = *pChildNode->GetNodeText();
+    int trieIndex = 0;   // start at the root
+    for (int i=0; i < csNodeText.GetLength(); i++)
+    {
+        const char c = static_cast<char>(tolower(static_cast<unsigned char>(csNodeText[i])));
+        int nextTrieIndex = -1;
+        for (unsigned int j=0; j < m_childTrie[trieIndex].next.size(); j++)
+        {
+            if (m_childTrie[trieIndex].next[j].first == c)
+            {
+                nextTrieIndex = m_childTrie[trieIndex].next[j].second;
+                break;
+            }
+        }
+
+        if (nextTrieIndex < 0)   // new prefix?
+        {
+            nextTrieIndex = static_cast<int>(m_childTrie.size());
+            m_childTrie.push_back(ChildTrieNode());   // NOTE: invalidates any references into m_childTrie
+            m_childTrie[trieIndex].next.push_back(make_pair(c, nextTrieIndex));
+        }
+        trieIndex = nextTrieIndex;
+        m_childTrie[trieIndex].matchingChildren.push_back(pChildNode);
+    }
+}
+
+// Returns all child nodes whose text begins with the supplied prefix (case-insensitive), or nullptr if no child matches.
+// pPrefix = prefix to search for; NOTE: does not need to be null-terminated
+// prefixLength = number of characters in pPrefix; must be > 0
+const vector<ParserTreeNode *> *ParserTreeNode::FindChildrenWithPrefix(const char *pPrefix, const int prefixLength) const
+{
+    _ASSERTE(prefixLength > 0);
+
+    int trieIndex = 0;   // start at the root
+    for (int i=0; i < prefixLength; i++)
+    {
+        const char c = static_cast<char>(tolower(static_cast<unsigned char>(pPrefix[i])));
+        const vector<pair<char, int>> &next = m_childTrie[trieIndex].next;
+        int nextTrieIndex = -1;
+        for (unsigned int j=0; j < next.size(); j++)
+        {
+            if (next[j].first == c)
+            {
+                nextTrieIndex = next[j].second;
+                break;
+            }
+        }
+
+        if (nextTrieIndex < 0)
+            return nullptr;    // no child has this prefix
+
+        trieIndex = nextTrieIndex;
+    }
+    return &m_childTrie[trieIndex].matchingChildren;
 }
 
  
@@ -110,27 +167,29 @@ bool ParserTreeNode::AutoComplete(CString &csCommand, AUTOCOMPLETION_STATE *pACS
         return false;   // nothing to complete
     
     // parse the command into space-separated pieces
-    vector<CString> argv;
-    ParseToSpaceDelimitedTokens(csCommand, argv);
+    TokenArray argv;
+    if (!ParseToSpaceDelimitedTokens(csCommand, argv))
+        return false;   // too many tokens
 
     // recursively parse all arguments
     const int autocompletedTokenCount = AutoComplete(argv, 0, pACState, direction);
 
-    // now reconstruct the full string from the auto-completed pieces
-    csCommand.Empty();
-    for (unsigned int i=0; i < argv.size(); i++)
+    // now reconstruct the full string from the auto-completed pieces; NOTE: tokens may point into csCommand, so we cannot write to it directly
+    CString csCompleted;
+    for (int i=0; i < argv.size(); i++)
     {
         if (i > 0)
-            csCommand += " ";
-        csCommand += argv[i];
+            csCompleted += " ";
+        csCompleted.Append(argv[i].pText, argv[i].length);
     }
 
     const bool autoCompletedAll = (autocompletedTokenCount == argv.size());
 
     // if we autocompleted all tokens successfully, append a trailing space
     if (autoCompletedAll)
-        csCommand += " ";
+        csCompleted += " ";
 
+    csCommand = csCompleted;
     return autoCompletedAll;
 }
 
@@ -140,29 +199,31 @@ bool ParserTreeNode::AutoComplete(CString &csCommand, AUTOCOMPLETION_STATE *pACS
 // autocompletionTokenIndex = maintains state as we scroll through possible autocompletion choices
 // direction: true = tab direction forward, false = tab direction backward
 // Returns # of nodes auto-completed (may be zero)
-int ParserTreeNode::AutoComplete(vector<CString> &argv, const int startingIndex, AUTOCOMPLETION_STATE *pACState, const bool direction) const
+int ParserTreeNode::AutoComplete(TokenArray &argv, const int startingIndex, AUTOCOMPLETION_STATE *pACState, const bool direction) const
 {
     _ASSERTE(startingIndex >= 0);
-    _ASSERTE(startingIndex < static_cast<int>(argv.size()));
+    _ASSERTE(startingIndex < argv.size());
     _ASSERTE(pACState != nullptr);
 
     int autocompletedTokens = 0;
 
     // try to parse the requested token by finding a match with one of our child nodes
-    CString &csToken = argv[startingIndex];
+    Token &token = argv[startingIndex];
     
     // By design, only track autocompletion state for the *last* token on the line; otherwise we would 
     // overwrite the command following the one we would autocomplete.
     AUTOCOMPLETION_STATE *pActiveACState = ((startingIndex == (argv.size()-1)) ? pACState : nullptr); 
     const int nextArgIndex = startingIndex + 1;
-    ParserTreeNode *pMatchingChild = FindChildForToken(csToken, pActiveACState, direction);
+    ParserTreeNode *pMatchingChild = FindChildForToken(token, pActiveACState, direction);
     if (pMatchingChild != nullptr)
     {
         // Note: by design, we count a token as autocompleted if even if was already complete 
         autocompletedTokens++;
-        argv[startingIndex] = *pMatchingChild->GetNodeText();  // change argv entry to completed token; e.g., "Set", "Main", etc.
+        const CString &csNodeText = *pMatchingChild->GetNodeText();
+        token.pText = csNodeText;   // change argv entry to completed token; e.g., "Set", "Main", etc.
+        token.length = csNodeText.GetLength();
 
-        if (nextArgIndex < static_cast<int>(argv.size()))  // any more arguments to parse?
+        if (nextArgIndex < argv.size())  // any more arguments to parse?
         {
             // now let's recurse down to the next level and try to autocomplete the next level down
             autocompletedTokens += pMatchingChild->AutoComplete(argv, nextArgIndex, pACState, direction);  // propagate the ACState that was passed in
@@ -171,17 +232,18 @@ int ParserTreeNode::AutoComplete(vector<CString> &argv, const int startingIndex,
     else  // no matching child
     {
         // let's see if we're a leaf node AND this is the last token on the line (i.e., the first leaf node parameter)
-        if ((m_pLeafHandler != nullptr) && (nextArgIndex == static_cast<int>(argv.size())))
+        if ((m_pLeafHandler != nullptr) && (nextArgIndex == argv.size()))
         {
             // this is leaf node parameter #1, so let's see if there are any autocompletion tokens available for it
             const char **pFirstParamTokens = m_pLeafHandler->GetFirstParamAutocompletionTokens(this);  // may be nullptr
             
             // let's try to find a unique match
-            const char *pAutocompletedToken = AutocompleteToken(argv[startingIndex], pACState, direction, pFirstParamTokens);
+            const char *pAutocompletedToken = AutocompleteToken(token, pACState, direction, pFirstParamTokens);
             if (pAutocompletedToken != nullptr)
             {
                 autocompletedTokens++;
-                argv[startingIndex] = pAutocompletedToken;  // change argv entry to completed token
+                token.pText = pAutocompletedToken;  // change argv entry to completed token
+                token.length = static_cast<int>(strlen(pAutocompletedToken));
                 // since this is the last token on the line, there is nothing else to parse: fall through and return
             }
         }
@@ -206,76 +268,123 @@ bool ParserTreeNode::Parse(const char *pCommand, CString &statusOut) const
     }
     
     // parse the command into space-separated pieces
-    vector<CString> argv;
-    ParseToSpaceDelimitedTokens(csCommand, argv);
-
-    // recursively parse all arguments and execute the command
+    TokenArray argv;
     CString commandStatus;
-    bool success = Parse(argv, 0, commandStatus);
+    bool success = false;
+    if (!ParseToSpaceDelimitedTokens(csCommand, argv))
+    {
+        commandStatus = "Too many parameters.";
+    }
+    else
+    {
+        // recursively parse all arguments down to the leaf node and execute the command
+        int leafArgIndex = 0;
+        const ParserTreeNode *pLeafNode = Resolve(argv, 0, leafArgIndex, commandStatus);
+        if (pLeafNode != nullptr)
+        {
+            // build vector of remaining arguments for the leaf handler
+            vector<CString> remainingArgv;
+            for (int i=leafArgIndex; i < argv.size(); i++)
+                remainingArgv.push_back(argv[i].ToCString());
 
-    statusOut.Format("Command: [%s]\r\n", csCommand);
+            success = pLeafNode->ExecuteLeaf(remainingArgv, commandStatus);
+        }
+    }
+
+    statusOut.Format("Command: [%s]\r\n", static_cast<const char *>(csCommand));
     statusOut += (success ? "" : "Error: ") + commandStatus;
 
     return success;
 }
 
-// Recursive method that will parse the command and recurse down to our child nodes until we execute the
-// command or locate a syntax error.
+// Parse the command down to its leaf node without executing it.  This allows callers such as XRVCScript to 
+// parse a command only once and then execute it later via ExecuteLeaf.
+//
+// Returns the leaf node on success, or nullptr on error
+// pCommand = command to be parsed
+// leafArgvOut = will be set to the remaining arguments for the leaf handler (typically number values)
+// statusOut = output buffer for error text
+const ParserTreeNode *ParserTreeNode::Resolve(const char *pCommand, vector<CString> &leafArgvOut, CString &statusOut) const
+{
+    CString csCommand = CString(pCommand).Trim();
+    if (csCommand.IsEmpty())
+    {
+        statusOut = "command is empty.";
+        return nullptr;
+    }
+
+    // parse the command into space-separated pieces
+    TokenArray argv;
+    if (!ParseToSpaceDelimitedTokens(csCommand, argv))
+    {
+        statusOut = "Too many parameters.";
+        return nullptr;
+    }
+
+    // recursively parse all arguments down to the leaf node
+    int leafArgIndex = 0;
+    const ParserTreeNode *pLeafNode = Resolve(argv, 0, leafArgIndex, statusOut);
+    if (pLeafNode != nullptr)
+    {
+        leafArgvOut.clear();
+        for (int i=leafArgIndex; i < argv.size(); i++)
+            leafArgvOut.push_back(argv[i].ToCString());
+    }
+
+    return pLeafNode;
+}
+
+// Recursive method that will parse the command and recurse down to our child nodes until we reach 
+// the leaf node for the command or locate a syntax error.
 //
 // argv = arguments to be parsed
 // startingIndex = 0-based index at which to start parsing; NOTE: may be beyond end of argv if this is a leaf node that takes no arguments
-// autocompletionTokenIndex = maintains state as we scroll through possible autocompletion choices
-// Returns true on success, false on error
-bool ParserTreeNode::Parse(vector<CString> &argv, const int startingIndex, CString &statusOut) const
+// leafArgIndexOut = on success, set to the index in argv of the first leaf handler argument
+// Returns leaf node on success, nullptr on error
+const ParserTreeNode *ParserTreeNode::Resolve(const TokenArray &argv, const int startingIndex, int &leafArgIndexOut, CString &statusOut) const
 {
     _ASSERTE(startingIndex >= 0);
     // do not validate argv against startingIndex here: may be beyond end of argv if this is a leaf node that takes no arguments
 
     statusOut.Empty();
-    bool retVal = false;   // assume failure
+    const ParserTreeNode *pRetVal = nullptr;   // assume failure
 
-    // if this is a leaf node, invoke the leafHandler execute the action for this node
+    // if this is a leaf node, we have reached the end of the chain
     if (m_pLeafHandler != nullptr)
     {
         _ASSERTE(m_children.size() == 0);  // leaf nodes must not have any children
-        // build vector of remaining arguments
-        vector<CString> remainingArgv;
-        for (int i=startingIndex; i < static_cast<int>(argv.size()); i++)
-            remainingArgv.push_back(argv[i]);
-        
-        // invoke the leaf handler to execute this command
-        retVal = m_pLeafHandler->Execute(this, remainingArgv, statusOut);
+        leafArgIndexOut = startingIndex;
+        pRetVal = this;
     }
     else  // not a leaf node, so let's keep recursing down...
     {
-        const int nextArgIndex = startingIndex + 1;
-        if (startingIndex < static_cast<int>(argv.size()))  // more arguments to parse?
+        if (startingIndex < argv.size())  // more arguments to parse?
         {
             // try to parse the requested token by finding a match with one of our child nodes
-            CString &csToken = argv[startingIndex];
-            ParserTreeNode *pMatchingChild = FindChildForToken(csToken, nullptr, true);  // must have exact match here (direction is moot)
+            const Token &token = argv[startingIndex];
+            ParserTreeNode *pMatchingChild = FindChildForToken(token, nullptr, true);  // must have exact match here (direction is moot)
             if (pMatchingChild != nullptr)
             {
                 // command token is valid
                 const int nextArgIndex = startingIndex + 1;
                 // Note: there may not be any more arguments to parse here; e.g., for leaf nodes that take no arguments.
-                // Therefore, we always recurse down to the next level and attempt to parse/execute it.
-                retVal = pMatchingChild->Parse(argv, nextArgIndex, statusOut);
+                // Therefore, we always recurse down to the next level and attempt to parse it.
+                pRetVal = pMatchingChild->Resolve(argv, nextArgIndex, leafArgIndexOut, statusOut);
             }
             else   // unknown command
             {
-                statusOut.Format("Invalid command token: [%s]", csToken);
-                // fall through and return false
+                statusOut.Format("Invalid command token: [%s]", static_cast<const char *>(token.ToCString()));
+                // fall through and return nullptr
             }
         }
         else  // no more arguments, but this is not a leaf node
         {
             statusOut = "Required token missing; options are: ";
             AppendChildNodeNames(statusOut);
-            // fall through and return false
+            // fall through and return nullptr
         }
     }
-    return retVal;
+    return pRetVal;
 }
 
 // Sets argsOut to a list of bracket-grouped available arguments for the supplied command.
@@ -290,8 +399,8 @@ int ParserTreeNode::GetAvailableArgumentsForCommand(const char *pCommand, vector
 {
     CString csCommand = CString(pCommand).Trim();
 
-    // parse the command into space-separated pieces
-    vector<CString> argv;
+    // parse the command into space-separated pieces; if there are too many tokens, we just show help for the ones we parsed
+    TokenArray argv;
     ParseToSpaceDelimitedTokens(csCommand, argv);
 
     // recursively parse all arguments
@@ -306,7 +415,7 @@ int ParserTreeNode::GetAvailableArgumentsForCommand(const char *pCommand, vector
 // startingIndex = index into argv to parse; also denotes our recursion level (0...n)
 // argsOut = will be populated with valid arguments for this command
 // Returns the level for which the arguments in argsOut pertain.
-int ParserTreeNode::GetAvailableArgumentsForCommand(vector<CString> &argv, const int startingIndex, vector<CString> &argsOut) const
+int ParserTreeNode::GetAvailableArgumentsForCommand(const TokenArray &argv, const int startingIndex, vector<CString> &argsOut) const
 {
     _ASSERTE(startingIndex >= 0);
     int retVal;
@@ -323,11 +432,10 @@ int ParserTreeNode::GetAvailableArgumentsForCommand(vector<CString> &argv, const
     else  // not a leaf node, so let's keep recursing down...
     {
         ParserTreeNode *pMatchingChild = nullptr;
-        if (startingIndex < static_cast<int>(argv.size()))  // more arguments to parse?
+        if (startingIndex < argv.size())  // more arguments to parse?
         {
             // try to parse the requested token by finding a match with one of our child nodes
-            CString &csToken = argv[startingIndex];
-            pMatchingChild = FindChildForToken(csToken, nullptr, true);  // must have exact match here (direction is moot)
+            pMatchingChild = FindChildForToken(argv[startingIndex], nullptr, true);  // must have exact match here (direction is moot)
         }
 
         const int nextArgIndex = startingIndex + 1;
@@ -402,16 +510,16 @@ void ParserTreeNode::ResetAutocompletionState(AUTOCOMPLETION_STATE *pACState)
 // acState : tracks autocompletion state between successive autocompletion calls; if null, do not track autocompletion for this token (i.e., this is not the final token on the command line)
 // direction: true = tab direction forward, false = tab direction backward
 // Returns node on a match or nullptr if no match found OR if more than one match found.
-ParserTreeNode *ParserTreeNode::FindChildForToken(const CString &csToken, AUTOCOMPLETION_STATE *pACState, const bool direction) const
+ParserTreeNode *ParserTreeNode::FindChildForToken(const Token &token, AUTOCOMPLETION_STATE *pACState, const bool direction) const
 {
-    if (csToken.IsEmpty())
+    if (token.length == 0)
         return nullptr;    // sanity check
 
     // NOTE: do not modify this object's state *except* for the last token on the command line
     AutocompletionState *pActiveACState = reinterpret_cast<AutocompletionState *>(pACState);  // cast back to actual type
 
     // assume no autocompletionstate
-    int significantCharacters = csToken.GetLength();     
+    int significantCharacters = token.length;     
     int tokenCandidateIndex = 0;
 
     if (pActiveACState != nullptr)
@@ -421,27 +529,19 @@ ParserTreeNode *ParserTreeNode::FindChildForToken(const CString &csToken, AUTOCO
         if (significantCharacters <= 0) 
         {
             // we were reset, so test all characters in the token
-            significantCharacters = csToken.GetLength();
+            significantCharacters = token.length;
         }
         tokenCandidateIndex = pActiveACState->tokenCandidateIndex; 
     }
     
-    _ASSERTE(significantCharacters <= csToken.GetLength());
+    _ASSERTE(significantCharacters <= token.length);
 
-    // step through each of our child nodes and build a list of all case-insensitive matches
-    vector<ParserTreeNode *> matchingNodes;
-    for (unsigned int i=0; i < m_children.size(); i++)  
-    {
-        ParserTreeNode *pCandidate = m_children[i];
-        const CString csNodeTextPrefix = pCandidate->GetNodeText()->Left(significantCharacters);
-        const CString csTokenPrefix = csToken.Left(significantCharacters);
-        if (csTokenPrefix.CompareNoCase(csNodeTextPrefix) == 0)
-            matchingNodes.push_back(pCandidate);   // we have a match
-    }
+    // look up all case-insensitive matches in our child index
+    const vector<ParserTreeNode *> *pMatchingNodes = FindChildrenWithPrefix(token.pText, significantCharacters);
 
     // decide which matching node to use
     ParserTreeNode *pRetVal = nullptr;
-    const int matchingNodeCount = static_cast<int>(matchingNodes.size());
+    const int matchingNodeCount = ((pMatchingNodes != nullptr) ? static_cast<int>(pMatchingNodes->size()) : 0);
     
     if (matchingNodeCount > 0)
     {
@@ -451,11 +551,11 @@ ParserTreeNode *ParserTreeNode::FindChildForToken(const CString &csToken, AUTOCO
         if (pActiveACState == nullptr)   // not stepping through multiple tokens?
         {
             // must have exactly *one* match or we cannot autocomplete this token
-            pRetVal = ((matchingNodeCount == 1) ? matchingNodes.front() : nullptr);  
+            pRetVal = ((matchingNodeCount == 1) ? pMatchingNodes->front() : nullptr);  
         }
         else   // we're stepping through multiple tokens (always on the last token on the line)
         {
-            pRetVal = matchingNodes[tokenCandidateIndex];
+            pRetVal = (*pMatchingNodes)[tokenCandidateIndex];
             
             // update our AutocompletionState for next time
             pActiveACState->significantCharacters = significantCharacters;
@@ -481,19 +581,19 @@ ParserTreeNode *ParserTreeNode::FindChildForToken(const CString &csToken, AUTOCO
 // direction: true = tab direction forward, false = tab direction backward
 // pValidTokenValues: may be nullptr.  Otherwise, points to a nullptr-terminated array of valid token values.
 // Returns autocompleted token on a match or nullptr if pValidTokenValues is nullptr OR no match found OR if more than one match found.
-const char *ParserTreeNode::AutocompleteToken(const CString &csToken, AUTOCOMPLETION_STATE *pACState, const bool direction, const char **pValidTokenValues) const
+const char *ParserTreeNode::AutocompleteToken(const Token &token, AUTOCOMPLETION_STATE *pACState, const bool direction, const char **pValidTokenValues) const
 {
     if (pValidTokenValues == nullptr)
         return nullptr;        // no autocompletion possible
 
-    if (csToken.IsEmpty())
+    if (token.length == 0)
         return nullptr;    // sanity check
 
     // NOTE: do not modify this object's state *except* for the last token on the command line
     AutocompletionState *pActiveACState = reinterpret_cast<AutocompletionState *>(pACState);  // cast back to actual type
 
     // assume no autocompletionstate
-    int significantCharacters = csToken.GetLength();     
+    int significantCharacters = token.length;     
     int tokenCandidateIndex = 0;
 
     if (pActiveACState != nullptr)
@@ -503,27 +603,34 @@ const char *ParserTreeNode::AutocompleteToken(const CString &csToken, AUTOCOMPLE
         if (significantCharacters <= 0) 
         {
             // we were reset, so test all characters in the token
-            significantCharacters = csToken.GetLength();
+            significantCharacters = token.length;
         }
         tokenCandidateIndex = pActiveACState->tokenCandidateIndex; 
     }
     
-    _ASSERTE(significantCharacters <= csToken.GetLength());
+    _ASSERTE(significantCharacters <= token.length);
 
-    // step through each of our valid tokens and build a list of all case-insensitive matches
-    vector<const char *> matchingTokens;   
+    // Step through each of our valid tokens and count all case-insensitive matches, remembering the first match and the
+    // requested candidate.  These lists are short (e.g., door states), so a linear scan is fine here.
+    const char *pFirstMatch = nullptr;
+    const char *pCandidateMatch = nullptr;
+    int matchingTokenCount = 0;
     for (const char **ppValidToken = pValidTokenValues; *ppValidToken != nullptr; ppValidToken++)
     {
-        CString candidate = *ppValidToken;    // valid token (a possible match)
-        const CString csNodeTextPrefix = candidate.Left(significantCharacters);
-        const CString csTokenPrefix = csToken.Left(significantCharacters);
-        if (csTokenPrefix.CompareNoCase(csNodeTextPrefix) == 0)
-            matchingTokens.push_back(*ppValidToken);   // we have a match
+        // NOTE: _strnicmp stops at the end of the valid token, so shorter valid tokens never match
+        if (_strnicmp(*ppValidToken, token.pText, significantCharacters) == 0)
+        {
+            // we have a match
+            if (matchingTokenCount == 0)
+                pFirstMatch = *ppValidToken;
+            if (matchingTokenCount == tokenCandidateIndex)
+                pCandidateMatch = *ppValidToken;
+            matchingTokenCount++;
+        }
     }
 
     // decide which matching node to use
     const char *pRetVal = nullptr;
-    const int matchingTokenCount = static_cast<int>(matchingTokens.size());
 
     if (matchingTokenCount > 0)
     {
@@ -533,11 +640,11 @@ const char *ParserTreeNode::AutocompleteToken(const CString &csToken, AUTOCOMPLE
         if (pActiveACState == nullptr)   // not stepping through multiple tokens?
         {
             // must have exactly *one* match or we cannot autocomplete this token
-            pRetVal = ((matchingTokenCount == 1) ? matchingTokens.front() : nullptr);  
+            pRetVal = ((matchingTokenCount == 1) ? pFirstMatch : nullptr);  
         }
         else   // we're stepping through multiple tokens (always on the last token on the line)
         {
-            pRetVal = matchingTokens[tokenCandidateIndex];
+            pRetVal = pCandidateMatch;
             
             // update our AutocompletionState for next time
             pActiveACState->significantCharacters = significantCharacters;
@@ -556,24 +663,35 @@ const char *ParserTreeNode::AutocompleteToken(const CString &csToken, AUTOCOMPLE
     return pRetVal;
 }
 
-// static utility method that will parse a given command string into space-delimited tokens
-// argv = contains parse-delmited tokens; NOTE: it is the caller's responsibility to free the CString objects
-//        added to the vector.
-// Returns: # of valid (i.e., non-empty) tokens parsed; i.e., argv.size()
-int ParserTreeNode::ParseToSpaceDelimitedTokens(const char *pCommand, vector<CString> &argv)
+// static utility method that will parse a given command string into whitespace-delimited tokens
+// argv = will contain the parsed tokens; NOTE: these point into pCommand, so pCommand must remain 
+//        valid and unchanged while argv is in use.
+// Returns: true on success, or false if pCommand has more than TokenArray::MAX_TOKENS tokens (argv will contain the first MAX_TOKENS tokens)
+bool ParserTreeNode::ParseToSpaceDelimitedTokens(const char *pCommand, TokenArray &argv)
 {
-    CString csCommand(pCommand);
-    int tokenIndex = 0;
-    while (tokenIndex >= 0)
+    argv.count = 0;
+    const char *p = pCommand;
+    for (;;)
     {
-        CString token = csCommand.Tokenize(" ", tokenIndex);
-        if (!token.IsEmpty())
-        {
-            argv.push_back(token.Trim());  // whack any other non-printables
-        }
+        // skip leading whitespace
+        while ((*p != 0) && isspace(static_cast<unsigned char>(*p)))
+            p++;
+
+        if (*p == 0)
+            break;      // end of command
+
+        if (argv.count == TokenArray::MAX_TOKENS)
+            return false;   // too many tokens
+
+        // we have a token
+        Token &token = argv.tokens[argv.count++];
+        token.pText = p;
+        while ((*p != 0) && !isspace(static_cast<unsigned char>(*p)))
+            p++;
+        token.length = static_cast<int>(p - token.pText);
     }
 
-    return static_cast<int>(argv.size());
+    return true;
 }
 
 //
@@ -27,6 +27,7 @@
 
 #include <windows.h>
 #include <vector>
+#include <utility>
 #include <atlstr.h>
 
 using namespace std;
@@ -36,6 +37,30 @@ class ParserTreeNode
 public:
     typedef void * AUTOCOMPLETION_STATE;   // client-visible autocomopletion data type
 
+    // A single space-delimited token in a command.  This points into the command string being parsed (or to 
+    // the autocompleted node text), so tokenizing a command never allocates any memory.
+    struct Token
+    {
+        const char *pText;  // NOTE: not null-terminated
+        int length;
+
+        CString ToCString() const { return CString(pText, length); }
+        bool EqualsNoCase(const char *pStr) const { return ((_strnicmp(pText, pStr, length) == 0) && (pStr[length] == 0)); }
+    };
+
+    // Fixed-size list of tokens parsed from a single command; commands are always short, so this never needs to grow.
+    struct TokenArray
+    {
+        static const int MAX_TOKENS = 64;
+        Token tokens[MAX_TOKENS];
+        int count;
+
+        TokenArray() : count(0) { }
+        int size() const { return count; }
+        Token &operator[](const int index) { _ASSERTE(index < count); return tokens[index]; }
+        const Token &operator[](const int index) const { _ASSERTE(index < count); return tokens[index]; }
+    };
+
     // interface that must be implemented by each NodeData subclass
     struct NodeData
     {
@@ -48,11 +73,20 @@ public:
     class LeafHandler
     {
     public:
+        // A single argument already parsed and validated by ParseArgument; which field is valid depends on the leaf handler.
+        union TypedArgument { double Double; bool Bool; int Int; };
+
         // pTreeNode = ParserTreeNode that called this leaf handler; e.g., "ThrottleLevel" in chain Set->LeftMain->ThrottleLevel #0.56
         // remainingArgv = remaining text arguments (typically number values)
         // statusOut = CString to which status message will be written
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut) = 0;
 
+        // Leaf handlers that take exactly one argument of a fixed type should also implement these three methods, so that 
+        // scripts can parse and validate the argument once when they are compiled.  Execute is then just ParseArgument + ExecuteTyped.
+        virtual bool HasTypedArgument() const { return false; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const { _ASSERTE(false); return false; }
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut) { _ASSERTE(false); return false; }
+
         // Returns a help string describing available valid arguments for this leaf node; e.g., "<double>"
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const = 0;
 
@@ -85,9 +119,17 @@ public:
 
     int GetAvailableArgumentsForCommand(const char *pCommand, vector<CString> &argsOut) const;
     bool Parse(const char *pCommand, CString &statusOut) const;
+    const ParserTreeNode *Resolve(const char *pCommand, vector<CString> &leafArgvOut, CString &statusOut) const;  // parse without executing
+    bool ExecuteLeaf(vector<CString> &leafArgv, CString &statusOut) const { _ASSERTE(m_pLeafHandler != nullptr); return m_pLeafHandler->Execute(this, leafArgv, statusOut); }
+    bool HasTypedLeafArgument() const { _ASSERTE(m_pLeafHandler != nullptr); return m_pLeafHandler->HasTypedArgument(); }
+    bool ParseLeafArgument(vector<CString> &leafArgv, LeafHandler::TypedArgument &argOut, CString &statusOut) const { _ASSERTE(m_pLeafHandler != nullptr); return m_pLeafHandler->ParseArgument(this, leafArgv, argOut, statusOut); }
+    bool ExecuteLeaf(const LeafHandler::TypedArgument &arg, CString &statusOut) const { _ASSERTE(m_pLeafHandler != nullptr); return m_pLeafHandler->ExecuteTyped(this, arg, statusOut); }
     const ParserTreeNode *GetParentNode() const { return m_pParentNode; }  // will only be null for root node
     void AppendChildNodeNames(CString &csOut) const;
     void BuildCommandHelpTree(int recursionLevel, CString &csOut);  // cosmetic help string
+
+    // static utility methods
+    static bool ParseToSpaceDelimitedTokens(const char *pCommand, TokenArray &argv);
     
 protected:
     // This is the leaf node callback for this node; is null for non-leaf nodes.
@@ -95,6 +137,15 @@ protected:
     LeafHandler * const m_pLeafHandler;  // make the pointer itself const so it can't be altered accidentally after it is initialized
     vector<ParserTreeNode *> m_children;
 
+    // Case-folded prefix trie that indexes m_children by node text, so finding all children that 
+    // match a given token takes time proportional to the token length.
+    struct ChildTrieNode
+    {
+        vector<pair<char, int>> next;                // (lowercase character, index in m_childTrie of the next trie node)
+        vector<ParserTreeNode *> matchingChildren;   // all children whose text begins with this trie node's prefix, in m_children order
+    };
+    vector<ChildTrieNode> m_childTrie;  // element 0 is the root node (empty prefix)
+
     // These fields maintain state between successive autocompletion calls; this structure is passed to us
     // by the caller.
     struct AutocompletionState 
@@ -104,14 +155,12 @@ protected:
     };
     
     // member methods
-    ParserTreeNode *FindChildForToken(const CString &csToken, AUTOCOMPLETION_STATE *pACState, const bool direction) const;
-    const char *AutocompleteToken(const CString &csToken, AUTOCOMPLETION_STATE *pACState, const bool direction, const char **pValidTokenValues) const; 
-    int AutoComplete(vector<CString> &argv, const int startingIndex, AUTOCOMPLETION_STATE *pACState, const bool direction) const;  // recursive method
-    bool Parse(vector<CString> &argv, const int startingIndex, CString &statusOut) const;  // recursive method
-    int GetAvailableArgumentsForCommand(vector<CString> &argv, const int startingIndex, vector<CString> &argsOut) const;  // recursive method
-    
-    // static utility methods
-    static int ParseToSpaceDelimitedTokens(const char *pCommand, vector<CString> &argv);
+    const vector<ParserTreeNode *> *FindChildrenWithPrefix(const char *pPrefix, const int prefixLength) const;
+    ParserTreeNode *FindChildForToken(const Token &token, AUTOCOMPLETION_STATE *pACState, const bool direction) const;
+    const char *AutocompleteToken(const Token &token, AUTOCOMPLETION_STATE *pACState, const bool direction, const char **pValidTokenValues) const; 
+    int AutoComplete(TokenArray &argv, const int startingIndex, AUTOCOMPLETION_STATE *pACState, const bool direction) const;  // recursive method
+    const ParserTreeNode *Resolve(const TokenArray &argv, const int startingIndex, int &leafArgIndexOut, CString &statusOut) const;  // recursive method
+    int GetAvailableArgumentsForCommand(const TokenArray &argv, const int startingIndex, vector<CString> &argsOut) const;  // recursive method
 
 private:
     const CString *m_pCSNodeText;  // "Set", "MainLeft", etc.  Will be null only for the root node.
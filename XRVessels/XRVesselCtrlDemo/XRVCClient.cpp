@@ -31,6 +31,7 @@
 
 #include <windows.h>
 #include "XRVCClient.h"
+#include "XRNumberFormat.h"
 
 // Constructor
 XRVCClient::XRVCClient() : 
@@ -401,25 +402,25 @@ void XRVCClient::RetrieveStatus(CString &csOut) const
 // ID = LeftWing, RightWing, etc.
 #define WRITE_STATUS_DOUBLE_PAIR(ID1, ID2)  \
     WRITE_LABEL(#ID1 ":");                  \
-    WRITE_DOUBLE(status.##ID1);             \
+    WRITE_DOUBLE(status.ID1);             \
     WRITE_LABEL(#ID2 ":");                  \
-    WRITE_DOUBLE(status.##ID2);             \
+    WRITE_DOUBLE(status.ID2);             \
     WRITE_CRLF()
 
 // ID = LeftAileron, RightAileron, etc.
 #define WRITE_DAMAGE_STATE_PAIR(ID1, ID2)    \
     WRITE_LABEL(#ID1 ":");                   \
-    WRITE_STR(GetDamageStateString(status.##ID1));  \
+    WRITE_STR(GetDamageStateString(status.ID1));  \
     WRITE_LABEL(#ID2 ":");                   \
-    WRITE_STR(GetDamageStateString(status.##ID2));  \
+    WRITE_STR(GetDamageStateString(status.ID2));  \
     WRITE_CRLF()
 
 // ID = LeftAileron, RightAileron, etc.
 #define WRITE_WARNING_STATE_PAIR(ID1, ID2)    \
     WRITE_LABEL(#ID1 ":");                   \
-    WRITE_STR(GetWarningStateString(status.##ID1));  \
+    WRITE_STR(GetWarningStateString(status.ID1));  \
     WRITE_LABEL(#ID2 ":");                   \
-    WRITE_STR(GetWarningStateString(status.##ID2));  \
+    WRITE_STR(GetWarningStateString(status.ID2));  \
     WRITE_CRLF()
 
     // items that support partial failure
@@ -656,18 +657,19 @@ void XRVCClient::RetrieveOther(CString &csOut) const
 
 CString &XRVCClient::AppendPaddedInt(CString &csOut, const int val, const int width)
 {
-    CString csLine;
-    csLine.Format("%d", val);
-    return AppendPaddedString(csOut, csLine, width);  // pad with spaces to proper length
+    char temp[64];
+    XRNumberFormat::FormatInt(temp, sizeof(temp), val, -width);  // negative width = pad on the right with spaces to proper length
+    csOut += temp;
+    return csOut;
 }
 
 // prependPlus: true = prepend '+' to number, false = do not. (Default = false)
 CString &XRVCClient::AppendPaddedDouble(CString &csOut, const double val, const int width, const bool prependPlus)
 {
-    CString csLine;
-    CString csFormat = (prependPlus ? "%+0.3lf" : "%0.3lf");
-    csLine.Format(csFormat, val);
-    return AppendPaddedString(csOut, csLine, width);  // pad with spaces to proper length
+    char temp[64];
+    XRNumberFormat::FormatDouble(temp, sizeof(temp), val, 3, -width, prependPlus);  // negative width = pad on the right with spaces to proper length
+    csOut += temp;
+    return csOut;
 }
 
 CString &XRVCClient::AppendPaddedBool(CString &csOut, const bool val, const int width)
@@ -31,6 +31,7 @@
 
 #include "orbitersdk.h"
 #include "XRVesselCtrl.h"
+#include "XRVCFleet.h"
 
 class XRVCClient
 {
@@ -44,6 +45,7 @@ public:
     XRVesselCtrl *GetXRVessel() const             { return m_pVessel; }         // may be null
     XREngineStateWrite &GetXREngineStateWrite()   { return m_xrEngineState; }   // working XREngineStateWrite structure
     XRSystemStatusWrite &GetXRSystemStatusWrite() { return m_xrSystemStatus; }  // working XRSystemStatusWrite structure
+    XRVCFleet &GetFleet()                         { return m_fleet; }           // all XR vessels in the simulation
 
     // Status retrieval methods; each method sends output to a supplied CString 
     // that will contain formatted (i.e., space-padded) output.
@@ -77,6 +79,7 @@ public:
 
 protected:
     XRVesselCtrl *m_pVessel;      // active XR vessel, or nullptr for none
+    XRVCFleet m_fleet;            // index of all XR vessels for fleet commands
 
     // static utility methods to format output; each returns a reference to csOut
     static CString &AppendPaddedInt(CString &csOut, const int val, const int width);
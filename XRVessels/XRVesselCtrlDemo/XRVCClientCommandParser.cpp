@@ -72,6 +72,7 @@ void XRVCClientCommandParser::FreeCommandParserTree()
     delete m_pSimpleResetLeafHandler;
     delete m_pDamageStateLeafHandler;
     delete m_pRunScriptLeafHandler;
+    delete m_pFleetLeafHandler;
 }
 
 //-------------------------------------------------------------------------
@@ -91,6 +92,7 @@ void XRVCClientCommandParser::InitializeCommandParserTree()
     m_pSimpleResetLeafHandler = new SimpleResetLeafHandler();
     m_pDamageStateLeafHandler = new DamageStateLeafHandler();
     m_pRunScriptLeafHandler = new RunScriptLeafHandler();
+    m_pFleetLeafHandler = new FleetLeafHandler();
 
     //
     // Build our parser tree
@@ -114,6 +116,11 @@ void XRVCClientCommandParser::InitializeCommandParserTree()
     nodeGroup++;
     m_commandParserTree->AddTopLevelNode(new ParserTreeNode("Runscript", nodeGroup, &baseNodeData, m_pRunScriptLeafHandler));
 
+    // Fleet [All | Class <classPattern> | Name <namePattern>] <command>
+    nodeGroup++;
+    FleetNodeData fleetNodeData(m_xrvcClient, *this);
+    m_commandParserTree->AddTopLevelNode(new ParserTreeNode("Fleet", nodeGroup, &fleetNodeData, m_pFleetLeafHandler));
+
     // Shift center-of-gravity
     nodeGroup++;
     SingleDoubleNodeData singleDoubleNodeData(m_xrvcClient);
@@ -187,7 +194,7 @@ void XRVCClientCommandParser::InitializeCommandParserTree()
         //       pEngineNode->AddChild(new ParserTreeNode("ThrottleLevel", &nodeData, &s_doubleLeafHandler));
 #define ADD_ENGINE_LEAF(FIELD, DATATYPE, MINVALUE, MAXVALUE)                        \
             nodeData.dataType = DATATYPE;                                           \
-            nodeData.pValueToSet = &m_xrvcClient.GetXREngineStateWrite().##FIELD;   \
+            nodeData.pValueToSet = &m_xrvcClient.GetXREngineStateWrite().FIELD;   \
             nodeData.minDblValue = MINVALUE;                                        \
             nodeData.maxDblValue = MAXVALUE;                                        \
             pEngineNode->AddChild(new ParserTreeNode(#FIELD, (nodeGroup+1), &nodeData, m_pEngineLeafHandler))
@@ -279,7 +286,7 @@ void XRVCClientCommandParser::InitializeCommandParserTree()
 
 #define ADD_DAMAGE_LEAF(FIELD, DATATYPE)                                         \
     damageStateNodeData.dataType = DATATYPE;                                 \
-    damageStateNodeData.pValueToSet = &m_xrvcClient.GetXRSystemStatusWrite().##FIELD;  \
+    damageStateNodeData.pValueToSet = &m_xrvcClient.GetXRSystemStatusWrite().FIELD;  \
     pptnDamageState->AddChild(new ParserTreeNode(#FIELD, (nodeGroup+1), &damageStateNodeData, m_pDamageStateLeafHandler))
 
     // define the leaf nodes for EngineStateWrite    
@@ -389,38 +396,57 @@ const char *XRVCClientCommandParser::RetrieveCommand(const bool getNext)
 // statusOut = CString to which status message will be written
 //=========================================================================
 bool XRVCClientCommandParser::EngineLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    TypedArgument arg;
+    if (!ParseArgument(pTreeNode, remainingArgv, arg, statusOut))
+        return false;
+
+    return ExecuteTyped(pTreeNode, arg, statusOut);
+}
+
+// Parses and validates our single argument.
+// Returns true on success, false on error
+bool XRVCClientCommandParser::EngineLeafHandler::ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const
 {
     _ASSERTE(pTreeNode != nullptr);
 
     if (!ValidateArgumentCount(static_cast<int>(remainingArgv.size()), 1, 1, statusOut))
         return false;   // too few/many arguments
 
-    // Retrieve our engine enum ID(s)
     const EngineNodeData *pNodeData = static_cast<const EngineNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
     _ASSERTE(pNodeData != nullptr);
 
     // parse our single argument
     const XRVCClient::DataType dataType = pNodeData->dataType;
     const CString &arg = remainingArgv[0];  // this is our only argument
-    bool parseStatus;  // populated below
-    XRVCClient::Value value;  // populated below
     if (dataType == XRVCClient::DataType::Double)
-    {
-        parseStatus = ParseValidatedDouble(arg, value.Double, pNodeData->minDblValue, pNodeData->maxDblValue, &statusOut);
-    }
-    else if (dataType == XRVCClient::DataType::Bool)
-    {
-        parseStatus = ParseValidatedBool(arg, value.Bool, &statusOut);
-    }
-    else   // invalid data type (should never happen)
-    {
-        statusOut.Format("INTERNAL ERROR: invalid DataType: %d", dataType); 
-        return false;
-    }
-    if (!parseStatus)
-        return false;  
+        return ParseValidatedDouble(arg, argOut.Double, pNodeData->minDblValue, pNodeData->maxDblValue, &statusOut);
+
+    if (dataType == XRVCClient::DataType::Bool)
+        return ParseValidatedBool(arg, argOut.Bool, &statusOut);
+
+    // invalid data type (should never happen)
+    statusOut.Format("INTERNAL ERROR: invalid DataType: %d", dataType); 
+    return false;
+}
+
+// Updates the engine state(s) from an argument already validated by ParseArgument.
+bool XRVCClientCommandParser::EngineLeafHandler::ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
 
-    // argument is OK; update the state of the first engine
+    // Retrieve our engine enum ID(s)
+    const EngineNodeData *pNodeData = static_cast<const EngineNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+
+    const XRVCClient::DataType dataType = pNodeData->dataType;
+    XRVCClient::Value value;
+    if (dataType == XRVCClient::DataType::Double)
+        value.Double = arg.Double;
+    else
+        value.Bool = arg.Bool;
+
+    // update the state of the first engine
     bool success = pNodeData->xrvcClient.UpdateEngineState(pNodeData->engine1, dataType, value, pNodeData->pValueToSet, statusOut);
     if (success)
     {
@@ -474,6 +500,17 @@ const char **XRVCClientCommandParser::EngineLeafHandler::GetFirstParamAutocomple
 // statusOut = CString to which status message will be written
 //=========================================================================
 bool XRVCClientCommandParser::DamageStateLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    TypedArgument arg;
+    if (!ParseArgument(pTreeNode, remainingArgv, arg, statusOut))
+        return false;
+
+    return ExecuteTyped(pTreeNode, arg, statusOut);
+}
+
+// Parses and validates our single argument.
+// Returns true on success, false on error
+bool XRVCClientCommandParser::DamageStateLeafHandler::ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const
 {
     _ASSERTE(pTreeNode != nullptr);
 
@@ -486,35 +523,44 @@ bool XRVCClientCommandParser::DamageStateLeafHandler::Execute(const ParserTreeNo
     // parse our single argument
     const XRVCClient::DataType dataType = pNodeData->dataType;
     const CString &arg = remainingArgv[0];  // this is our only argument
-    bool parseStatus;  // populated below
-    XRVCClient::Value value;  // populated below
     if (dataType == XRVCClient::DataType::Double)
-    {
-        parseStatus = ParseValidatedDouble(arg, value.Double, 0.0, 1.0, &statusOut);
-    }
-    else if (dataType == XRVCClient::DataType::Int)
+        return ParseValidatedDouble(arg, argOut.Double, 0.0, 1.0, &statusOut);
+
+    if (dataType == XRVCClient::DataType::Int)
     {
         // parse the text XRDamageState argument 
-        parseStatus = true;
         if (arg.CompareNoCase("offline") == 0)
-            value.Int = static_cast<int>(XRDamageState::XRDMG_offline);
+            argOut.Int = static_cast<int>(XRDamageState::XRDMG_offline);
         else if (arg.CompareNoCase("online") == 0)
-            value.Int = static_cast<int>(XRDamageState::XRDMG_online);
+            argOut.Int = static_cast<int>(XRDamageState::XRDMG_online);
         else
         {
-            parseStatus = false;
-            statusOut.Format("Invalid parameter: '%s'", arg);
+            statusOut.Format("Invalid parameter: '%s'", static_cast<const char *>(arg));
+            return false;
         }
+        return true;
     }
-    else   // invalid data type (should never happen)
-    {
-        statusOut.Format("INTERNAL ERROR: invalid DataType: %d", dataType); 
-        return false;
-    }
-    if (!parseStatus)
-        return false;  
 
-    // argument is OK; update the damage state 
+    // invalid data type (should never happen)
+    statusOut.Format("INTERNAL ERROR: invalid DataType: %d", dataType); 
+    return false;
+}
+
+// Updates the damage state from an argument already validated by ParseArgument.
+bool XRVCClientCommandParser::DamageStateLeafHandler::ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
+
+    const DamageStateNodeData *pNodeData = static_cast<const DamageStateNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+
+    const XRVCClient::DataType dataType = pNodeData->dataType;
+    XRVCClient::Value value;
+    if (dataType == XRVCClient::DataType::Double)
+        value.Double = arg.Double;
+    else
+        value.Int = arg.Int;
+
     return pNodeData->xrvcClient.UpdateDamageState(dataType, value, pNodeData->pValueToSet, statusOut);
 }
 
@@ -560,27 +606,46 @@ const char **XRVCClientCommandParser::DamageStateLeafHandler::GetFirstParamAutoc
 // statusOut = CString to which status message will be written
 //=========================================================================
 bool XRVCClientCommandParser::DoorLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    TypedArgument arg;
+    if (!ParseArgument(pTreeNode, remainingArgv, arg, statusOut))
+        return false;
+
+    return ExecuteTyped(pTreeNode, arg, statusOut);
+}
+
+// Parses our single argument into an XRDoorState, stored in argOut.Int.
+// Returns true on success, false on error
+bool XRVCClientCommandParser::DoorLeafHandler::ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const
 {
     _ASSERTE(pTreeNode != nullptr);
 
     if (!ValidateArgumentCount(static_cast<int>(remainingArgv.size()), 1, 1, statusOut))
         return false;   // too few/many arguments
 
-    // Retrieve our door enum ID
-    const DoorNodeData *pNodeData = static_cast<const DoorNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
-    _ASSERTE(pNodeData != nullptr);
-
     // parse our single argument
     const CString &arg = remainingArgv[0];  // this is our only argument
     const XRDoorState doorState = ParseDoorState(arg);    // < 0 == error
     if (doorState < XRDoorState::XRDS_Opening)
     {
-        statusOut.Format("Invalid door state: '%s'", arg);
+        statusOut.Format("Invalid door state: '%s'", static_cast<const char *>(arg));
         return false;  
     }
 
-    // argument is OK; update the state of the door 
-    return pNodeData->xrvcClient.UpdateDoorState(pNodeData->doorID, doorState, statusOut);
+    argOut.Int = static_cast<int>(doorState);
+    return true;
+}
+
+// Updates the state of the door from an argument already validated by ParseArgument.
+bool XRVCClientCommandParser::DoorLeafHandler::ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
+
+    // Retrieve our door enum ID
+    const DoorNodeData *pNodeData = static_cast<const DoorNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+
+    return pNodeData->xrvcClient.UpdateDoorState(pNodeData->doorID, static_cast<XRDoorState>(arg.Int), statusOut);
 }
 
 // Static method that parses a string into an XRDoorState.
@@ -619,27 +684,43 @@ XRDoorState XRVCClientCommandParser::DoorLeafHandler::ParseDoorState(const char
 // statusOut = CString to which status message will be written
 //=========================================================================
 bool XRVCClientCommandParser::EnumBoolLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    TypedArgument arg;
+    if (!ParseArgument(pTreeNode, remainingArgv, arg, statusOut))
+        return false;
+
+    return ExecuteTyped(pTreeNode, arg, statusOut);
+}
+
+// Parses our single boolean argument.
+// Returns true on success, false on error
+bool XRVCClientCommandParser::EnumBoolLeafHandler::ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const
 {
     _ASSERTE(pTreeNode != nullptr);
 
     if (!ValidateArgumentCount(static_cast<int>(remainingArgv.size()), 1, 1, statusOut))
         return false;   // too few/many arguments
 
-    // Retrieve our ID (usually an enum value)
-    const XRVCClientCommandParser::EnumBoolNodeData *pNodeData = static_cast<const EnumBoolNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
-    _ASSERTE(pNodeData != nullptr);
-
     // parse our single argument
-    bool state;
     const char *pArg = remainingArgv[0];
-    if (!ParseBool(pArg, state))
+    if (!ParseBool(pArg, argOut.Bool))
     {
         statusOut.Format("Invalid boolean value: '%s'", pArg);
         return false;  
     }
+    return true;
+}
 
-    // argument in argValue is OK; invoke the callback to perform the XR work
-    return (pNodeData->xrvcClient.*(pNodeData->method))(pNodeData->enumID, state, statusOut);  // pNodeData->xrvcClient is the 'this' object for the callback method
+// Invokes the callback to perform the XR work with an argument already validated by ParseArgument.
+bool XRVCClientCommandParser::EnumBoolLeafHandler::ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
+
+    // Retrieve our ID (usually an enum value)
+    const XRVCClientCommandParser::EnumBoolNodeData *pNodeData = static_cast<const EnumBoolNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+
+    return (pNodeData->xrvcClient.*(pNodeData->method))(pNodeData->enumID, arg.Bool, statusOut);  // pNodeData->xrvcClient is the 'this' object for the callback method
 }
 
 //=========================================================================
@@ -649,6 +730,17 @@ bool XRVCClientCommandParser::EnumBoolLeafHandler::Execute(const ParserTreeNode
 // statusOut = CString to which status message will be written
 //=========================================================================
 bool XRVCClientCommandParser::SingleIntLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    TypedArgument arg;
+    if (!ParseArgument(pTreeNode, remainingArgv, arg, statusOut))
+        return false;
+
+    return ExecuteTyped(pTreeNode, arg, statusOut);
+}
+
+// Parses and validates our single integer argument.
+// Returns true on success, false on error
+bool XRVCClientCommandParser::SingleIntLeafHandler::ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const
 {
     _ASSERTE(pTreeNode != nullptr);
 
@@ -658,23 +750,29 @@ bool XRVCClientCommandParser::SingleIntLeafHandler::Execute(const ParserTreeNode
         return false;   // too few/many arguments
 
     // parse our single argument
-    int argValue;
     const char *pArg = remainingArgv[0];
     if (pNodeData->IsBoolArgument())
     {
         bool state;
         if (!ParseValidatedBool(pArg, state, &statusOut))
             return false;
-        argValue = (state ? TRUE : FALSE);  // convert bool to BOOL
-    }
-    else  // normal integer argument
-    {
-        if (!ParseValidatedInt(pArg, argValue, pNodeData->limitLow, pNodeData->limitHigh, &statusOut))
-            return false;
+        argOut.Int = (state ? TRUE : FALSE);  // convert bool to BOOL
+        return true;
     }
 
-    // argument in argValue is OK; invoke the callback to perform the XR work
-    return (pNodeData->xrvcClient.*(pNodeData->method))(argValue, statusOut);  // pNodeData->xrvcClient is the 'this' object for the callback method
+    // normal integer argument
+    return ParseValidatedInt(pArg, argOut.Int, pNodeData->limitLow, pNodeData->limitHigh, &statusOut);
+}
+
+// Invokes the callback to perform the XR work with an argument already validated by ParseArgument.
+bool XRVCClientCommandParser::SingleIntLeafHandler::ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
+
+    const SingleIntNodeData *pNodeData = static_cast<const SingleIntNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+
+    return (pNodeData->xrvcClient.*(pNodeData->method))(arg.Int, statusOut);  // pNodeData->xrvcClient is the 'this' object for the callback method
 }
 
 //-------------------------------------------------------------------------
@@ -699,6 +797,17 @@ void XRVCClientCommandParser::SingleIntLeafHandler::GetArgumentHelp(const Parser
 // statusOut = CString to which status message will be written
 //=========================================================================
 bool XRVCClientCommandParser::SingleDoubleLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    TypedArgument arg;
+    if (!ParseArgument(pTreeNode, remainingArgv, arg, statusOut))
+        return false;
+
+    return ExecuteTyped(pTreeNode, arg, statusOut);
+}
+
+// Parses and validates our single double argument.
+// Returns true on success, false on error
+bool XRVCClientCommandParser::SingleDoubleLeafHandler::ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const
 {
     _ASSERTE(pTreeNode != nullptr);
 
@@ -708,13 +817,19 @@ bool XRVCClientCommandParser::SingleDoubleLeafHandler::Execute(const ParserTreeN
         return false;   // too few/many arguments
 
     // parse our single argument
-    double argValue;
     const char *pArg = remainingArgv[0];
-    if (!ParseValidatedDouble(pArg, argValue, pNodeData->limitLow, pNodeData->limitHigh, &statusOut))
-        return false;
+    return ParseValidatedDouble(pArg, argOut.Double, pNodeData->limitLow, pNodeData->limitHigh, &statusOut);
+}
 
-    // argument in argValue is OK; invoke the callback to perform the XR work
-    return (pNodeData->xrvcClient.*(pNodeData->method))(argValue, statusOut);  // pNodeData->xrvcClient is the 'this' object for the callback method
+// Invokes the callback to perform the XR work with an argument already validated by ParseArgument.
+bool XRVCClientCommandParser::SingleDoubleLeafHandler::ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
+
+    const SingleDoubleNodeData *pNodeData = static_cast<const SingleDoubleNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+
+    return (pNodeData->xrvcClient.*(pNodeData->method))(arg.Double, statusOut);  // pNodeData->xrvcClient is the 'this' object for the callback method
 }
 
 //-------------------------------------------------------------------------
@@ -778,7 +893,7 @@ bool XRVCClientCommandParser::AttitudeHoldLeafHandler::Execute(const ParserTreeN
             holdPitch = false;
         else
         {
-            statusOut.Format("Invalid value for [Pitch/AoA] parameter: '%s'", holdArgv);
+            statusOut.Format("Invalid value for [Pitch/AoA] parameter: '%s'", static_cast<const char *>(holdArgv));
             return false;
         }
 
@@ -979,7 +1094,7 @@ bool XRVCClientCommandParser::SimpleResetLeafHandler::Execute(const ParserTreeNo
     }
     else  // invalid command
     {
-        statusOut.Format("Invalid command: '%s'", csArg);
+        statusOut.Format("Invalid command: '%s'", static_cast<const char *>(csArg));
         success = false;
     }
     
@@ -999,13 +1114,23 @@ bool XRVCClientCommandParser::ExecuteCommand(const CString &command, CString &st
         success = m_commandParserTree->Parse(command, statusOut);
     }
 
+    AddCommandToHistory(command);
+    return success;
+}
+
+//-------------------------------------------------------------------------
+// Saves a command in the user's command history and resets the recall index to the most recent command.
+// command = already-autocompleted command
+//-------------------------------------------------------------------------
+void XRVCClientCommandParser::AddCommandToHistory(const CString &command)
+{
     // check whether this command is identical to the last command on the stack; if so, do not add it again
     const int commandHistoryCount = static_cast<int>(m_commandHistoryVector.size());
     if (commandHistoryCount > 0)
     {
         const CString *pLastCommand = m_commandHistoryVector[commandHistoryCount - 1];
         if (*pLastCommand == command)
-            goto exit;  // let's have a single exit point rather than two separate 'return success' lines.
+            goto exit;  // let's have a single exit point
     }
 
     // save the new command in our command stack; there is no limit on the stack size
@@ -1013,7 +1138,22 @@ bool XRVCClientCommandParser::ExecuteCommand(const CString &command, CString &st
 
 exit:
     ResetCommandRecallIndex();  // reset to most recent command
-    return success;
+}
+
+// Autocompletes and parses the supplied command down to its leaf node without executing it or adding 
+// it to the command history; this is used to precompile script commands.
+// csCommand = command to be compiled; will be set to the autocompleted command text
+// leafArgvOut = will be set to the arguments for the leaf node's handler
+// statusOut = set to the error reason on failure
+// Returns the leaf node to be executed, or nullptr on error.
+const ParserTreeNode *XRVCClientCommandParser::CompileCommand(CString &csCommand, vector<CString> &leafArgvOut, CString &statusOut)
+{
+    // each command is a brand-new line, so do not carry over any autocompletion state from the previous one
+    ResetAutocompletionState();
+    AutoCompleteCommand(csCommand, true);   // direction is moot here since we only call this once
+    csCommand = csCommand.Trim();
+
+    return m_commandParserTree->Resolve(csCommand, leafArgvOut, statusOut);
 }
 
 //=========================================================================
@@ -1035,7 +1175,7 @@ bool XRVCClientCommandParser::RunScriptLeafHandler::Execute(const ParserTreeNode
     CString csFilename = remainingArgv[0];
     if (_access_s(csFilename, 0x4) != 0)
     {
-        statusOut.Format("Script file not found: %s", csFilename);
+        statusOut.Format("Script file not found: %s", static_cast<const char *>(csFilename));
         return false;
     }
 
@@ -1044,11 +1184,125 @@ bool XRVCClientCommandParser::RunScriptLeafHandler::Execute(const ParserTreeNode
     if (!success)
         statusOut.Format("Script thread is busy.");  // should never happen, really
     else
-        statusOut.Format("Script file '%s' queued for execution.", csFilename);  // this should be replaced very shortly by message from the thread
+        statusOut.Format("Script file '%s' queued for execution.", static_cast<const char *>(csFilename));  // this should be replaced very shortly by message from the thread
     
     return success;
 }
 
+//=========================================================================
+// Leaf handler for Fleet: parses the command once and then executes it on 
+// each matching XR vessel in a single pass.
+// pTreeNode = ParserTreeNode leaf node to which this handler belongs
+// remainingArgv = remaining text arguments; e.g., "Class XR5* Set Door Gear open"
+// statusOut = CString to which status message will be written
+//=========================================================================
+bool XRVCClientCommandParser::FleetLeafHandler::Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut)
+{
+    _ASSERTE(pTreeNode != nullptr);
+
+    const FleetNodeData *pNodeData = static_cast<const FleetNodeData *>(pTreeNode->GetNodeData());  // downcast to actual type
+    _ASSERTE(pNodeData != nullptr);
+    XRVCClient &xrvcClient = pNodeData->xrvcClient;
+
+    // parse the vessel selector
+    const int argc = static_cast<int>(remainingArgv.size());
+    if (argc < 1)
+    {
+        statusOut.Format("Insufficient number of parameters.");
+        return false;
+    }
+
+    const char *pClassPattern = "*";
+    const char *pNamePattern = "*";
+    int commandIndex;     // index of first command token in remainingArgv
+    const CString &csSelector = remainingArgv[0];
+    if (csSelector.CompareNoCase("All") == 0)
+    {
+        commandIndex = 1;
+    }
+    else if ((csSelector.CompareNoCase("Class") == 0) || (csSelector.CompareNoCase("Name") == 0))
+    {
+        if (argc < 2)
+        {
+            statusOut.Format("Insufficient number of parameters.");
+            return false;
+        }
+        if (csSelector.CompareNoCase("Class") == 0)
+            pClassPattern = remainingArgv[1];
+        else
+            pNamePattern = remainingArgv[1];
+        commandIndex = 2;
+    }
+    else
+    {
+        statusOut.Format("Invalid vessel selector: [%s]; valid options are All, Class, or Name.", static_cast<const char *>(csSelector));
+        return false;
+    }
+
+    if (commandIndex >= argc)
+    {
+        statusOut.Format("Fleet command missing.");
+        return false;
+    }
+
+    // rebuild the fleet command and parse it only once for all vessels
+    CString csCommand;
+    for (int i=commandIndex; i < argc; i++)
+    {
+        if (i > commandIndex)
+            csCommand += " ";
+        csCommand += remainingArgv[i];
+    }
+
+    vector<CString> leafArgv;
+    CString csCommandStatus;
+    const ParserTreeNode *pLeafNode = pNodeData->pParser->CompileCommand(csCommand, leafArgv, csCommandStatus);
+    if (pLeafNode == nullptr)
+    {
+        statusOut.Format("Invalid fleet command [%s]: %s", static_cast<const char *>(csCommand), static_cast<const char *>(csCommandStatus));
+        return false;
+    }
+    if (pLeafNode == pTreeNode)
+    {
+        statusOut.Format("Fleet commands may not be nested.");
+        return false;
+    }
+
+    // execute the command on each matching vessel, aggregating the results
+    XRVesselCtrl *pSelectedVessel = xrvcClient.GetXRVessel();   // may be null
+    const vector<XRVCFleet::Member> &members = xrvcClient.GetFleet().GetMembers();
+    int matchingVesselCount = 0;
+    int successCount = 0;
+    CString csFailures;
+    for (unsigned int i=0; i < members.size(); i++)
+    {
+        const XRVCFleet::Member &member = members[i];
+        if (!XRVCFleet::GlobMatch(pClassPattern, member.csClassName) || !XRVCFleet::GlobMatch(pNamePattern, member.csName))
+            continue;   // vessel not selected
+
+        if (!XRVCFleet::IsVesselValid(member))
+            continue;   // vessel was deleted this frame
+
+        matchingVesselCount++;
+        xrvcClient.SetXRVessel(member.pXRVessel);   // leaf handlers operate on the client's active vessel
+        if (pLeafNode->ExecuteLeaf(leafArgv, csCommandStatus))
+            successCount++;
+        else
+            csFailures.AppendFormat("\r\n    %s: %s", static_cast<const char *>(member.csName), static_cast<const char *>(csCommandStatus));
+    }
+    xrvcClient.SetXRVessel(pSelectedVessel);   // restore the selected vessel
+
+    if (matchingVesselCount == 0)
+    {
+        statusOut.Format("No XR vessels match the fleet selector.");
+        return false;
+    }
+
+    statusOut.Format("Fleet command [%s] succeeded on %d of %d vessel(s).", static_cast<const char *>(csCommand), successCount, matchingVesselCount);
+    statusOut += csFailures;
+    return (successCount == matchingVesselCount);
+}
+
 //-------------------------------------------------------------------------
 // Static utility methods
 //-------------------------------------------------------------------------
@@ -37,6 +37,8 @@ public:
     virtual ~XRVCClientCommandParser();
 
     bool ExecuteCommand(const CString &command, CString &statusOut);  // runs a command and stores status to statusOut
+    void AddCommandToHistory(const CString &command);  // invoked by ExecuteCommand, and for each script command as it runs
+    const ParserTreeNode *CompileCommand(CString &csCommand, vector<CString> &leafArgvOut, CString &statusOut);  // parses a command without running it
 
     bool AutoCompleteCommand(CString &csCommand, const bool direction) const { return m_commandParserTree->AutoComplete(csCommand, direction); }  // returns true if we autocompleted all tokens in csCommand
     int GetAvailableArgumentsForCommand(CString &csCommand, vector<CString> &argsOut) const { return m_commandParserTree->GetAvailableArgumentsForCommand(csCommand, argsOut); }
@@ -134,6 +136,15 @@ protected:
         virtual NodeData *Clone() const { return new StdAutopilotNodeData(*this); }  // default byte-for-byte copy constructor is sufficient
     };
 
+    struct FleetNodeData : public BaseNodeData
+    {
+        FleetNodeData(XRVCClient &client, XRVCClientCommandParser &parser) : BaseNodeData(client), pParser(&parser) { }
+        XRVCClientCommandParser *pParser;  // parses the command to be sent to each vessel in the fleet
+
+        // implement the NodeData interface
+        virtual NodeData *Clone() const { return new FleetNodeData(*this); }  // default byte-for-byte copy constructor is sufficient
+    };
+
     struct DamageStateNodeData : public BaseNodeData
     {
         DamageStateNodeData(XRVCClient &client) : BaseNodeData(client) { }
@@ -150,6 +161,9 @@ protected:
     struct EngineLeafHandler : public ParserTreeNode::LeafHandler
     {
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual bool HasTypedArgument() const { return true; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const;
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut);
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const;
         virtual const char **GetFirstParamAutocompletionTokens(const ParserTreeNode *pTreeNode); 
     };
@@ -157,6 +171,9 @@ protected:
     struct DoorLeafHandler : public ParserTreeNode::LeafHandler
     {
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual bool HasTypedArgument() const { return true; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const;
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut);
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const  { csOut = "opening  open  closing  closed "; }  
         // Note: 'open' should be listed first so it will not be autocompleted to 'opening'
         virtual const char **GetFirstParamAutocompletionTokens(const ParserTreeNode *pTreeNode) { static const char *s_pTokens[] =  { "open", "opening", "closing", "closed", nullptr }; return s_pTokens; }  
@@ -166,6 +183,9 @@ protected:
     struct EnumBoolLeafHandler : public ParserTreeNode::LeafHandler
     {
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual bool HasTypedArgument() const { return true; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const;
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut);
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const  { csOut = "on/true  off/false"; }  
         virtual const char **GetFirstParamAutocompletionTokens(const ParserTreeNode *pTreeNode) { static const char *s_pTokens[] =  { "on", "off", nullptr }; return s_pTokens; } 
     };
@@ -173,12 +193,18 @@ protected:
     struct SingleIntLeafHandler : public ParserTreeNode::LeafHandler
     {
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual bool HasTypedArgument() const { return true; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const;
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut);
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const;
     };
 
     struct SingleDoubleLeafHandler : public ParserTreeNode::LeafHandler
     {
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual bool HasTypedArgument() const { return true; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const;
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut);
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const;
     };
 
@@ -213,6 +239,9 @@ protected:
     struct DamageStateLeafHandler : public ParserTreeNode::LeafHandler
     {
         virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual bool HasTypedArgument() const { return true; }
+        virtual bool ParseArgument(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, TypedArgument &argOut, CString &statusOut) const;
+        virtual bool ExecuteTyped(const ParserTreeNode *pTreeNode, const TypedArgument &arg, CString &statusOut);
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const;
         virtual const char **GetFirstParamAutocompletionTokens(const ParserTreeNode *pTreeNode); 
     };
@@ -223,6 +252,13 @@ protected:
         virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const { csOut = "<filepath\\filename>"; }
     };
 
+    struct FleetLeafHandler : public ParserTreeNode::LeafHandler
+    {
+        virtual bool Execute(const ParserTreeNode *pTreeNode, vector<CString> &remainingArgv, CString &statusOut);
+        virtual void GetArgumentHelp(const ParserTreeNode *pTreeNode, CString &csOut) const { csOut = "All | Class <classPattern> | Name <namePattern>  <command>"; }
+        virtual const char **GetFirstParamAutocompletionTokens(const ParserTreeNode *pTreeNode) { static const char *s_pTokens[] =  { "All", "Class", "Name", nullptr }; return s_pTokens; } 
+    };
+
     // member data containing parser leaf callback pointers
     EngineLeafHandler *m_pEngineLeafHandler;  // writes a value to XREngineStateWrite
     DoorLeafHandler *m_pDoorLeafHandler;
@@ -235,6 +271,7 @@ protected:
     SimpleResetLeafHandler *m_pSimpleResetLeafHandler;
     DamageStateLeafHandler *m_pDamageStateLeafHandler;
     RunScriptLeafHandler *m_pRunScriptLeafHandler;
+    FleetLeafHandler *m_pFleetLeafHandler;
 
 private:
     void InitializeCommandParserTree();   // invoked from constructor
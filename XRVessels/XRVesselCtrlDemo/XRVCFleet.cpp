@@ -0,0 +1,105 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRVCFleet.cpp : implementation of XRVCFleet class.
+//-------------------------------------------------------------------------
+
+#include <windows.h>
+#include <ctype.h>
+
+#include "XRVCFleet.h"
+
+// Returns our list of all XR vessels, rebuilding it first if necessary
+const vector<XRVCFleet::Member> &XRVCFleet::GetMembers()
+{
+    // Orbiter has no legacy plugin callback for new vessels, so a changed vessel count means one was created
+    if (!m_isIndexValid || (oapiGetVesselCount() != m_indexedVesselCount))
+        RebuildIndex();
+
+    return m_members;
+}
+
+// Enumerate all vessels in the simulation and index those that implement XRVesselCtrl
+void XRVCFleet::RebuildIndex()
+{
+    m_members.clear();
+    for (UINT i=0; i < oapiGetVesselCount(); i++)
+    {
+        const OBJHANDLE hVessel = oapiGetVesselByIndex(i);  // will never be null
+        VESSEL *pVessel = oapiGetVesselInterface(hVessel);  // will never be null
+        if (!XRVesselCtrl::IsXRVesselCtrl(pVessel))
+            continue;   // not an XR vessel
+
+        // this vessel implements XRVesselCtrl, so it is safe to downcast to XRVesselCtrl
+        XRVesselCtrl *pXRVessel = static_cast<XRVesselCtrl *>(pVessel);
+        if (pXRVessel->GetCtrlAPIVersion() < THIS_XRVESSELCTRL_API_VERSION)
+            continue;   // API version too old
+
+        Member member;
+        member.hVessel = hVessel;
+        member.pXRVessel = pXRVessel;
+        member.csName = pVessel->GetName();
+        const char *pClassName = pVessel->GetClassName();
+        member.csClassName = ((pClassName != nullptr) ? pClassName : "");   // class name may be null
+        m_members.push_back(member);
+    }
+    m_indexedVesselCount = oapiGetVesselCount();
+    m_isIndexValid = true;
+}
+
+// Returns true if pStr matches the supplied wildcard pattern (case-insensitive).
+// pPattern may contain '*' (matches zero or more characters) and '?' (matches any single character).
+bool XRVCFleet::GlobMatch(const char *pPattern, const char *pStr)
+{
+    const char *pStarPattern = nullptr;   // pattern position just after the last '*' we saw
+    const char *pStarStr = nullptr;       // string position that the last '*' is currently matching up to
+    while (*pStr != 0)
+    {
+        if (*pPattern == '*')
+        {
+            // '*' initially matches nothing; we backtrack to here if the rest of the pattern fails to match
+            pStarPattern = ++pPattern;
+            pStarStr = pStr;
+        }
+        else if ((*pPattern == '?') || (tolower(static_cast<unsigned char>(*pPattern)) == tolower(static_cast<unsigned char>(*pStr))))
+        {
+            pPattern++;
+            pStr++;
+        }
+        else if (pStarPattern != nullptr)
+        {
+            // mismatch, so let the last '*' consume one more character and try again
+            pPattern = pStarPattern;
+            pStr = ++pStarStr;
+        }
+        else
+        {
+            return false;   // mismatch and no '*' to fall back on
+        }
+    }
+
+    // string is exhausted, so any remaining pattern characters must all be '*'
+    while (*pPattern == '*')
+        pPattern++;
+
+    return (*pPattern == 0);
+}
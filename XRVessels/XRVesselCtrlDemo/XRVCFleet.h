@@ -0,0 +1,67 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRVCFleet.h : definition of XRVCFleet class; maintains an index of all
+//               XR vessels in the simulation for fleet commands.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include <windows.h>
+#include <atlstr.h>
+#include <vector>
+
+#include "orbitersdk.h"
+#include "XRVesselCtrl.h"
+
+using namespace std;
+
+class XRVCFleet
+{
+public:
+    // a single XR vessel in the simulation
+    struct Member
+    {
+        OBJHANDLE hVessel;
+        XRVesselCtrl *pXRVessel;
+        CString csName;       // e.g., "XR5-01"
+        CString csClassName;  // e.g., "XR5Vanguard"
+    };
+
+    XRVCFleet() : m_isIndexValid(false), m_indexedVesselCount(0) { }
+    virtual ~XRVCFleet() { }
+
+    // Invoked from our opcDeleteVessel hook; the index is then rebuilt the next time a fleet command needs it.
+    // Newly created vessels are detected by GetMembers itself, so this works while the simulation is paused, too.
+    void InvalidateIndex() { m_isIndexValid = false; }
+    const vector<Member> &GetMembers();
+
+    static bool IsVesselValid(const Member &member) { return oapiIsVessel(member.hVessel); }  // false if vessel was deleted since the index was built
+    static bool GlobMatch(const char *pPattern, const char *pStr);
+
+protected:
+    void RebuildIndex();
+
+    vector<Member> m_members;   // all XR vessels that implement our XRVesselCtrl API version or newer
+    bool m_isIndexValid;
+    DWORD m_indexedVesselCount; // total number of vessels in the simulation when the index was built
+};
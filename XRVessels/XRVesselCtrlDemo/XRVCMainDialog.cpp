@@ -51,7 +51,7 @@ void XRVCMainDialog::OpenDialogClbk(void *pContext)
 
 // Constructor
 XRVCMainDialog::XRVCMainDialog(const HINSTANCE hDLL) :
-    m_hwndDlg(0), m_hDLL(hDLL), m_hwndHelpDlg(0), m_pScriptThread(nullptr)
+    m_hwndDlg(0), m_hDLL(hDLL), m_hwndHelpDlg(0), m_pScriptThread(nullptr), m_scriptSimt(0)
 {
     // construct our fixed-width courier font for our output edit boxes
     m_hCourierFontSmall  = CreateFont(-10, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, FIXED_PITCH | FF_MODERN, "Courier New");
@@ -180,6 +180,7 @@ INT_PTR CALLBACK XRVCMainDialog::MsgProcMain(const HWND hDlg, const UINT uMsg, c
 
         case WM_DESTROY:
             s_pSingleton->CloseHelpWindow();
+            s_pSingleton->m_xrvcScript.Reset();      // stop any running script
             delete s_pSingleton->m_pScriptThread;    // destructor signals the thread to terminate gracefully and block until it does so
 	        return TRUE;
 
@@ -188,6 +189,7 @@ INT_PTR CALLBACK XRVCMainDialog::MsgProcMain(const HWND hDlg, const UINT uMsg, c
             {
                 case TIMERID_20_TICKS_A_SECOND:     
                     s_pSingleton->RefreshDataSection();  // refresh on-screen ship status data
+                    s_pSingleton->RefreshScriptStatus();
                     s_pSingleton->HandleExecuteScript();
                     return 0;
                 
@@ -729,7 +731,7 @@ void XRVCMainDialog::EnableDisableButtons() const
 
     // Only enable "Execute Script File" button if 1) the selected vessel is an XR vessel, 
     // 2) the thread is idle and waiting for work, and 3) if we are not in full-screen mode.
-    const bool isExecuteScriptEnabled = ((m_xrvcClient.GetXRVessel() != nullptr) && m_pScriptThread->IsThreadIdle()  && !s_enableFullScreenMode);
+    const bool isExecuteScriptEnabled = ((m_xrvcClient.GetXRVessel() != nullptr) && m_pScriptThread->IsThreadIdle() && !m_xrvcScript.IsRunning() && !s_enableFullScreenMode);
     EnableWindow(GetDlgItem(m_hwndDlg, IDC_EXECUTE_SCRIPT), isExecuteScriptEnabled);
 }
 
@@ -1048,8 +1050,9 @@ void XRVCMainDialog::UpdateFromStaticFields()
 }
 
 //=========================================================================================
-// Interfaces with our ScriptThread and executes a group of script commands if ready.
-// Returns true if script executed, or false if no work was available.
+// Interfaces with our ScriptThread and compiles a group of script commands if ready; 
+// the compiled script is then executed by clbkPreStep.
+// Returns true if script compiled and started, or false if no work was available.
 //=========================================================================================
 bool XRVCMainDialog::HandleExecuteScript()
 {
@@ -1059,7 +1062,6 @@ bool XRVCMainDialog::HandleExecuteScript()
         SetStatusText(statusMsg);    // update the dialog
 
     // check for a list of script commands from the ExecuteScript thread    
-    bool scriptExecuted = false;
     vector<CString> latchedCommandList;
     m_pScriptThread->GetScriptCommands(latchedCommandList);   // latch command list from thread
     
@@ -1073,28 +1075,67 @@ bool XRVCMainDialog::HandleExecuteScript()
     if (!CheckXRVesselForCommand())
         return false;       // not an XR vessel
 
-    // execute all latched script commands
-    for (unsigned int i=0; i < latchedCommandList.size(); i++)
+    // Compile all latched script commands once up front; this replaces any script that is already running 
+    // (e.g., via a Runscript command inside a script).
+    m_csScriptStatus.Empty();   // do not show the final status of any script we are replacing
+    const bool scriptCompiled = m_xrvcScript.Compile(latchedCommandList, *m_pxrvcClientCommandParser, m_xrvcClient.GetXRVessel(), statusMsg);
+    if (!scriptCompiled)
+        ErrorBeep();
+
+    SetStatusText(statusMsg);
+    return scriptCompiled;
+}
+
+// Invalidates our fleet index; the vessel is still valid when this is invoked.
+// hVessel = vessel about to be destroyed
+void XRVCMainDialog::clbkDeleteVessel(const OBJHANDLE hVessel)
+{
+    m_xrvcClient.GetFleet().InvalidateIndex();
+}
+
+// Executes the running script, if any, until it completes or reaches a wait instruction.
+// The status box is not updated here; that is done by RefreshScriptStatus from our 20-ticks-a-second timer.
+// simt = current simulation time
+void XRVCMainDialog::clbkPreStep(const double simt)
+{
+    if (!m_xrvcScript.IsRunning())
+        return;     // nothing to do
+
+    m_scriptSimt = simt;
+    const XRVCScript::StepResult result = m_xrvcScript.Step(m_xrvcClient.GetXRVessel(), simt, *this, m_csScriptStatus);
+    if ((result == XRVCScript::StepResult::Completed) || (result == XRVCScript::StepResult::Failed))
     {
-        CString &csLatchedCommand = latchedCommandList[i];
-        if (csLatchedCommand.GetLength() == 0)
-            continue;       // line is empty
+        if (result == XRVCScript::StepResult::Failed)
+            ErrorBeep();
+
+        SetCommandText("");  // the script is done, so clear its last command from the command box
+    }
+}
 
-        scriptExecuted = true;
+// Echo a script command to the command box and save it in the user's command history, just as if the user had typed it.
+void XRVCMainDialog::ScriptCommandExecuting(const CString &csCommand)
+{
+    SetCommandText(csCommand);
+    m_pxrvcClientCommandParser->AddCommandToHistory(csCommand);
+}
 
-        // Write the script command to the command line and feed then invoke our ExecuteCommand so that
-        // the command will be auto-completed, etc., just as if the user had typed it.
-        SetCommandText(csLatchedCommand);
-        const bool commandStatus = ExecuteCommand(csLatchedCommand);   // this will store the command in the user's history as well
-        if (!commandStatus)
-        {
-            CString msg;
-            msg.Format("Script Error - command failed: [%s]", csLatchedCommand);
-            SetStatusText(msg);
-            break;    // command failed, so halt script execution
-        }
+// Update the status box with the running script's status, if it changed; this is invoked 20 times a second
+// rather than each frame since the wait status text changes every frame.
+void XRVCMainDialog::RefreshScriptStatus()
+{
+    if (m_xrvcScript.IsRunning())
+    {
+        CString csStatus;
+        m_xrvcScript.GetWaitStatus(m_scriptSimt, csStatus);
+        if (!csStatus.IsEmpty())
+            SetStatusText(csStatus);
+    }
+    else if (!m_csScriptStatus.IsEmpty())
+    {
+        // the script just completed or failed
+        SetStatusText(m_csScriptStatus);
+        m_csScriptStatus.Empty();
     }
-    return scriptExecuted;
 }
 
 // This quick-and-dirty method is only used for debugging to dump the tree to a file.
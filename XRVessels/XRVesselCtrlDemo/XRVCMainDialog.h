@@ -32,6 +32,7 @@
 #include "XRVCClientCommandParser.h"
 #include "XRVCClient.h"
 #include "XRVCScriptThread.h"
+#include "XRVCScript.h"
 
 // {XXX} UPDATE THIS FOR THE CURRENT BUILD VERSION; DO NOT REMOVE THIS {XXX} COMMENT
 // NOTE: be sure to also update the version to match in the following files:
@@ -39,7 +40,7 @@
 //      XRVesselCtrl.h
 #define VERSION "XRVesselCtrlDemo 4.0"
 
-class XRVCMainDialog
+class XRVCMainDialog : public XRVCScript::Listener
 {
 public:
     // public member methods
@@ -58,6 +59,10 @@ public:
    // this method must be public so we can call it from a leaf handler in the parser
     bool ExecuteScriptFile(const char *pFilename) { return m_pScriptThread->OpenScriptFile(pFilename); } 
 
+    void clbkPreStep(const double simt);  // invoked by Orbiter once per frame
+    virtual void ScriptCommandExecuting(const CString &csCommand);  // implements XRVCScript::Listener
+    void clbkDeleteVessel(const OBJHANDLE hVessel);  // invoked by Orbiter just before a vessel is destroyed
+
 protected:
     // identifies text panels on the dialog
     enum class TextPanel { TEXTPANEL_LEFT, TEXTPANEL_RIGHT, TEXTPANEL_BOTH };
@@ -77,6 +82,7 @@ protected:
     void ComboVesselChanged();
     void RefreshDataSection();
     bool HandleExecuteScript();
+    void RefreshScriptStatus();
     const char *GetSelectedVesselName() const;
     void SetFocusToSelectedVessel() const;
     
@@ -124,6 +130,9 @@ protected:
     CString m_csRightPanelText;
     HWND m_hwndHelpDlg;  // our help dialog
     XRVCScriptThread *m_pScriptThread;  // handles script parsing for us
+    XRVCScript m_xrvcScript;            // compiled script currently running, if any
+    double m_scriptSimt;                // simt of the last script step; used for the script's wait status
+    CString m_csScriptStatus;           // final status of the last script, or empty if already shown
     
     static void *s_pCommandBoxOldMessageProc; 
     XRVCClient m_xrvcClient;   // handles XRVesselCtrl interface calls
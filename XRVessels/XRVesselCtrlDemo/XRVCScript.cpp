@@ -0,0 +1,321 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRVCScript.cpp : Implementation of XRVCScript class.
+//-------------------------------------------------------------------------
+
+#include <windows.h>
+#include <limits>
+
+#include "XRVCScript.h"
+
+// parameter names for wait-until; order must match the ConditionParam enum
+static const char *s_conditionParamNames[] = { "SimTime", "Altitude", "Airspeed", "Groundspeed", "VerticalSpeed", "MachNumber", "DynPressure", nullptr };
+
+// comparison operators for wait-until; order must match the ComparisonOp enum
+static const char *s_comparisonOpNames[] = { "<", "<=", ">", ">=", nullptr };
+
+// Constructor
+XRVCScript::XRVCScript() :
+    m_programCounter(0), m_waitTargetSimt(-1), m_lastConditionValue(0), m_pTargetVessel(nullptr)
+{
+}
+
+// Stop any running script and free all instructions
+void XRVCScript::Reset()
+{
+    m_instructions.clear();
+    m_programCounter = 0;
+    m_waitTargetSimt = -1;
+    m_pTargetVessel = nullptr;
+}
+
+//=========================================================================
+// Compile the supplied script lines into our instruction list and start the script.
+// Any script that was already running is replaced.
+//
+// commandList = script lines as read by XRVCScriptThread; empty lines and comments are already removed
+// parser = parser used to resolve each command to its leaf node
+// pTargetVessel = vessel on which the script will operate; the script is aborted if the selected vessel changes
+// statusOut = set to the error reason on failure
+//
+// Returns true on success, false if any line failed to compile; no instructions are executed in either case
+//=========================================================================
+bool XRVCScript::Compile(const vector<CString> &commandList, XRVCClientCommandParser &parser, const XRVesselCtrl *pTargetVessel, CString &statusOut)
+{
+    Reset();
+    m_instructions.reserve(commandList.size());
+
+    ParserTreeNode::TokenArray argv;
+    for (unsigned int i=0; i < commandList.size(); i++)
+    {
+        CString csLine = commandList[i];
+        csLine = csLine.Trim();
+        if (csLine.IsEmpty())
+            continue;       // line is empty
+
+        m_instructions.push_back(Instruction());
+        Instruction &instruction = m_instructions.back();
+
+        // check for timing instructions first; these are not part of the command parser tree
+        ParserTreeNode::ParseToSpaceDelimitedTokens(csLine, argv);   // any extra tokens are caught by the command parser below
+
+        CString csError;
+        bool success;
+        if (argv[0].EqualsNoCase("wait"))
+        {
+            success = CompileWait(argv, instruction, csError);
+        }
+        else if (argv[0].EqualsNoCase("wait-until"))
+        {
+            success = CompileWaitUntil(argv, instruction, csError);
+        }
+        else  // normal command
+        {
+            instruction.opcode = Opcode::Command;
+            instruction.pLeafNode = parser.CompileCommand(csLine, instruction.leafArgv, csError);
+            success = (instruction.pLeafNode != nullptr);
+
+            // parse and validate the argument now if the leaf handler supports it, so that bad arguments are caught before the script runs
+            if (success && instruction.pLeafNode->HasTypedLeafArgument())
+                success = instruction.pLeafNode->ParseLeafArgument(instruction.leafArgv, instruction.typedArg, csError);
+        }
+
+        if (!success)
+        {
+            statusOut.Format("Script Error - invalid command: [%s]\r\nError: %s", static_cast<const char *>(csLine), static_cast<const char *>(csError));
+            Reset();
+            return false;
+        }
+        instruction.csText = csLine;
+    }
+
+    m_pTargetVessel = pTargetVessel;
+    statusOut.Format("Compiled script: %d instructions.", GetInstructionCount());
+    return true;
+}
+
+// Compile a "wait <seconds>" instruction.
+// Returns true on success, false on error.
+bool XRVCScript::CompileWait(const ParserTreeNode::TokenArray &argv, Instruction &instructionOut, CString &statusOut)
+{
+    if (argv.size() != 2)
+    {
+        statusOut = "Usage: wait <seconds>";
+        return false;
+    }
+
+    instructionOut.opcode = Opcode::Wait;
+    return ParserTreeNode::LeafHandler::ParseValidatedDouble(argv[1].ToCString(), instructionOut.waitSeconds, 0, numeric_limits<double>::max(), &statusOut);
+}
+
+// Compile a "wait-until <parameter> <op> <value>" instruction.
+// Returns true on success, false on error.
+bool XRVCScript::CompileWaitUntil(const ParserTreeNode::TokenArray &argv, Instruction &instructionOut, CString &statusOut)
+{
+    if (argv.size() != 4)
+    {
+        statusOut = "Usage: wait-until <parameter> <, <=, >, or >= <value>";
+        return false;
+    }
+
+    instructionOut.opcode = Opcode::WaitUntil;
+
+    int paramIndex = 0;
+    for (; s_conditionParamNames[paramIndex] != nullptr; paramIndex++)
+    {
+        if (argv[1].EqualsNoCase(s_conditionParamNames[paramIndex]))
+            break;
+    }
+    if (s_conditionParamNames[paramIndex] == nullptr)
+    {
+        statusOut.Format("Invalid wait-until parameter: [%s]; valid options are SimTime, Altitude, Airspeed, Groundspeed, VerticalSpeed, MachNumber, or DynPressure.", static_cast<const char *>(argv[1].ToCString()));
+        return false;
+    }
+    instructionOut.conditionParam = static_cast<ConditionParam>(paramIndex);
+
+    int opIndex = 0;
+    for (; s_comparisonOpNames[opIndex] != nullptr; opIndex++)
+    {
+        if (argv[2].EqualsNoCase(s_comparisonOpNames[opIndex]))
+            break;
+    }
+    if (s_comparisonOpNames[opIndex] == nullptr)
+    {
+        statusOut.Format("Invalid wait-until operator: [%s]; valid options are <, <=, >, or >=.", static_cast<const char *>(argv[2].ToCString()));
+        return false;
+    }
+    instructionOut.comparisonOp = static_cast<ComparisonOp>(opIndex);
+
+    const CString csValue = argv[3].ToCString();
+    if (!ParserTreeNode::LeafHandler::ParseDouble(csValue, instructionOut.conditionValue))
+    {
+        statusOut.Format("Invalid argument: '%s'", static_cast<const char *>(csValue));
+        return false;
+    }
+    return true;
+}
+
+//=========================================================================
+// Execute script instructions until the script completes, fails, or reaches a wait
+// instruction that is not satisfied yet.  This should be invoked once per frame.
+//
+// pSelectedVessel = vessel currently selected in the dialog
+// simt = current simulation time
+// listener = notified before each command executes
+// statusOut = set to the final status for the user if the script completes or fails; not changed otherwise.
+//             Use GetWaitStatus to build the status while the script is waiting.
+//
+// Returns the script state after this step
+//=========================================================================
+XRVCScript::StepResult XRVCScript::Step(const XRVesselCtrl *pSelectedVessel, const double simt, Listener &listener, CString &statusOut)
+{
+    if (!IsRunning())
+        return StepResult::Idle;
+
+    if (pSelectedVessel != m_pTargetVessel)
+    {
+        statusOut = "Script aborted: the selected vessel changed.";
+        Reset();
+        return StepResult::Failed;
+    }
+
+    // we only need to build the status message for the last command executed in this frame
+    const Instruction *pLastCommand = nullptr;
+    CString csCommandStatus;
+    while (IsRunning())
+    {
+        Instruction &instruction = m_instructions[m_programCounter];
+        switch (instruction.opcode)
+        {
+        case Opcode::Command:
+        {
+            listener.ScriptCommandExecuting(instruction.csText);
+
+            const bool success = (instruction.pLeafNode->HasTypedLeafArgument() ? 
+                instruction.pLeafNode->ExecuteLeaf(instruction.typedArg, csCommandStatus) : 
+                instruction.pLeafNode->ExecuteLeaf(instruction.leafArgv, csCommandStatus));
+            if (!success)
+            {
+                statusOut.Format("Script Error - command failed: [%s]\r\nError: %s", static_cast<const char *>(instruction.csText), static_cast<const char *>(csCommandStatus));
+                Reset();
+                return StepResult::Failed;    // command failed, so halt script execution
+            }
+            pLastCommand = &instruction;
+            break;
+        }
+
+        case Opcode::Wait:
+            if (m_waitTargetSimt < 0)
+                m_waitTargetSimt = simt + instruction.waitSeconds;   // wait is just starting
+
+            if (simt < m_waitTargetSimt)
+                return StepResult::Waiting;
+
+            m_waitTargetSimt = -1;   // wait is complete
+            break;
+
+        case Opcode::WaitUntil:
+            if (!IsConditionTrue(instruction, simt))
+                return StepResult::Waiting;
+            break;
+
+        default:
+            _ASSERTE(false);  // should never happen!
+            break;
+        }
+        m_programCounter++;
+    }
+
+    // script is complete
+    if (pLastCommand != nullptr)
+        statusOut.Format("Script complete; last command: [%s]\r\n%s", static_cast<const char *>(pLastCommand->csText), static_cast<const char *>(csCommandStatus));
+    else
+        statusOut = "Script complete.";
+
+    Reset();
+    return StepResult::Completed;
+}
+
+// Sets statusOut to the status of the wait instruction on which the script is waiting; this does not access the vessel, 
+// so it is cheap enough to invoke each time the dialog refreshes.
+// simt = simulation time of the last Step
+void XRVCScript::GetWaitStatus(const double simt, CString &statusOut) const
+{
+    if (!IsRunning())
+        return;     // script is not waiting
+
+    const Instruction &instruction = m_instructions[m_programCounter];
+    if ((instruction.opcode == Opcode::Wait) && (m_waitTargetSimt >= 0))
+        statusOut.Format("Script waiting: [%s] (%.1lf seconds remaining)", static_cast<const char *>(instruction.csText), (m_waitTargetSimt - simt));
+    else if (instruction.opcode == Opcode::WaitUntil)
+        statusOut.Format("Script waiting: [%s] (%s = %.2lf)", static_cast<const char *>(instruction.csText), s_conditionParamNames[static_cast<int>(instruction.conditionParam)], m_lastConditionValue);
+}
+
+// Returns true if the condition for the supplied WaitUntil instruction is satisfied
+bool XRVCScript::IsConditionTrue(const Instruction &instruction, const double simt)
+{
+    _ASSERTE(instruction.opcode == Opcode::WaitUntil);
+
+    const double value = GetConditionParamValue(instruction.conditionParam, simt);
+    m_lastConditionValue = value;   // for GetWaitStatus
+    bool retVal = false;
+    switch (instruction.comparisonOp)
+    {
+    case ComparisonOp::LessThan:       retVal = (value <  instruction.conditionValue); break;
+    case ComparisonOp::LessOrEqual:    retVal = (value <= instruction.conditionValue); break;
+    case ComparisonOp::GreaterThan:    retVal = (value >  instruction.conditionValue); break;
+    case ComparisonOp::GreaterOrEqual: retVal = (value >= instruction.conditionValue); break;
+    default:
+        _ASSERTE(false);  // should never happen!
+        break;
+    }
+    return retVal;
+}
+
+// Returns the current value of the supplied wait-until parameter for our target vessel
+double XRVCScript::GetConditionParamValue(const ConditionParam param, const double simt) const
+{
+    _ASSERTE(m_pTargetVessel != nullptr);
+
+    double retVal = 0;
+    switch (param)
+    {
+    case ConditionParam::SimTime:       retVal = simt; break;
+    case ConditionParam::Altitude:      retVal = m_pTargetVessel->GetAltitude(); break;
+    case ConditionParam::Airspeed:      retVal = m_pTargetVessel->GetAirspeed(); break;
+    case ConditionParam::Groundspeed:   retVal = m_pTargetVessel->GetGroundspeed(); break;
+    case ConditionParam::MachNumber:    retVal = m_pTargetVessel->GetMachNumber(); break;
+    case ConditionParam::DynPressure:   retVal = m_pTargetVessel->GetDynPressure(); break;
+    case ConditionParam::VerticalSpeed:
+    {
+        VECTOR3 airspeedVector;
+        m_pTargetVessel->GetAirspeedVector(FRAME_HORIZON, airspeedVector);
+        retVal = airspeedVector.y;
+        break;
+    }
+    default:
+        _ASSERTE(false);  // should never happen!
+        break;
+    }
+    return retVal;
+}
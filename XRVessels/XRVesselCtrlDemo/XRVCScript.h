@@ -0,0 +1,93 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+//-------------------------------------------------------------------------
+// XRVCScript.h : Class definition for a precompiled XRVesselCtrl script.
+//-------------------------------------------------------------------------
+
+#pragma once
+
+#include <windows.h>
+#include <atlstr.h>  // we use CString instead of std::string primarily because we want the CString.Format method
+#include <vector>
+
+#include "XRVCClientCommandParser.h"
+
+using namespace std;
+
+// A script is compiled once into a list of instructions when it is loaded; each command instruction holds its 
+// resolved leaf node and arguments, so no parsing is necessary while the script runs.  In addition to normal 
+// commands, scripts support these timing instructions:
+//     wait <seconds>                       : pause script execution for the specified number of sim seconds
+//     wait-until <parameter> <op> <value>  : pause script execution until the condition is true; e.g., "wait-until Altitude > 1000"
+// Scripts are stepped once per frame, so waiting never blocks the dialog or Orbiter's main thread.
+class XRVCScript
+{
+public:
+    enum class StepResult { Idle, Waiting, Completed, Failed };
+
+    // Implemented by the owner of the script so that each command can be shown to the user as it executes
+    class Listener
+    {
+    public:
+        virtual void ScriptCommandExecuting(const CString &csCommand) = 0;
+    };
+
+    XRVCScript();
+    virtual ~XRVCScript() { }
+
+    bool Compile(const vector<CString> &commandList, XRVCClientCommandParser &parser, const XRVesselCtrl *pTargetVessel, CString &statusOut);
+    StepResult Step(const XRVesselCtrl *pSelectedVessel, const double simt, Listener &listener, CString &statusOut);
+    void GetWaitStatus(const double simt, CString &statusOut) const;
+    void Reset();
+    bool IsRunning() const { return (m_programCounter < static_cast<int>(m_instructions.size())); }
+    int GetInstructionCount() const { return static_cast<int>(m_instructions.size()); }
+
+protected:
+    enum class Opcode { Command, Wait, WaitUntil };
+    enum class ConditionParam { SimTime, Altitude, Airspeed, Groundspeed, VerticalSpeed, MachNumber, DynPressure };
+    enum class ComparisonOp { LessThan, LessOrEqual, GreaterThan, GreaterOrEqual };
+
+    struct Instruction
+    {
+        Opcode opcode;
+        CString csText;                   // autocompleted source text of this instruction; used for status messages
+        const ParserTreeNode *pLeafNode;  // Command only: resolved leaf node to execute
+        vector<CString> leafArgv;         // Command only: pre-tokenized arguments for leaf handlers that do not take a typed argument
+        ParserTreeNode::LeafHandler::TypedArgument typedArg;  // Command only: pre-parsed argument if pLeafNode->HasTypedLeafArgument()
+        double waitSeconds;               // Wait only
+        ConditionParam conditionParam;    // WaitUntil only
+        ComparisonOp comparisonOp;        // WaitUntil only
+        double conditionValue;            // WaitUntil only
+    };
+
+    static bool CompileWait(const ParserTreeNode::TokenArray &argv, Instruction &instructionOut, CString &statusOut);
+    static bool CompileWaitUntil(const ParserTreeNode::TokenArray &argv, Instruction &instructionOut, CString &statusOut);
+    bool IsConditionTrue(const Instruction &instruction, const double simt);
+    double GetConditionParamValue(const ConditionParam param, const double simt) const;
+
+    // data
+    vector<Instruction> m_instructions;
+    int m_programCounter;              // index of next instruction to execute; == m_instructions.size() when script is not running
+    double m_waitTargetSimt;           // sim time at which the active Wait instruction completes; < 0 = no wait in progress
+    double m_lastConditionValue;       // parameter value when the active WaitUntil instruction was last checked
+    const XRVesselCtrl *m_pTargetVessel;  // vessel that was selected when the script was compiled
+};
@@ -78,6 +78,26 @@ DLLCLBK void opcDLLExit (HINSTANCE hDLL)
 }
 
 
+//==============================================================
+// This function is called by Orbiter once per frame.
+//==============================================================
+DLLCLBK void opcPreStep(double simt, double simdt, double mjd)
+{
+    // step any running script; our dialog object is only created when the user first opens the dialog
+    if (XRVCMainDialog::s_pSingleton != nullptr)
+        XRVCMainDialog::s_pSingleton->clbkPreStep(simt);
+}
+
+//==============================================================
+// This function is called by Orbiter just before a vessel is
+// destroyed.
+//==============================================================
+DLLCLBK void opcDeleteVessel(OBJHANDLE hVessel)
+{
+    if (XRVCMainDialog::s_pSingleton != nullptr)
+        XRVCMainDialog::s_pSingleton->clbkDeleteVessel(hVessel);
+}
+
 // ==============================================================
 // Write our parameters to the scenario file
 // ==============================================================
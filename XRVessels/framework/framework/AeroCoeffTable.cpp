@@ -0,0 +1,126 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// AeroCoeffTable.cpp
+// Precomputed lookup table for an airfoil coefficient function.
+// ==============================================================
+
+#include "AeroCoeffTable.h"
+#include <stdio.h>
+#include <math.h>
+
+const double AeroCoeffTable::MAX_TABLE_MACH = 40.0;
+
+// grid spacing
+static const double ALPHA_STEP = (2 * PI) / AeroCoeffTable::ALPHA_CELL_COUNT;
+static const double MACH_STEP = AeroCoeffTable::MAX_TABLE_MACH / AeroCoeffTable::MACH_CELL_COUNT;
+static const double ALPHA_CELLS_PER_RADIAN = 1.0 / ALPHA_STEP;
+static const double MACH_CELLS_PER_MACH = 1.0 / MACH_STEP;
+
+// Constructor: samples the source function onto our grids.
+// pSourceFunc = airfoil coefficient function to be tabulated; it is always invoked with a null vessel,
+//               Reynolds number, and context, so it must not depend on any of those.
+AeroCoeffTable::AeroCoeffTable(AirfoilCoeffFuncEx pSourceFunc) :
+    m_pSourceFunc(pSourceFunc), m_isTableValid(true)
+{
+    for (int i = 0; i <= ALPHA_CELL_COUNT; i++)
+    {
+        AlphaRow &row = m_alphaRows[i];
+        SampleSourceFunc(-PI + (i * ALPHA_STEP), 0, row.cl, row.cm, row.cd);
+    }
+
+    // wave drag is whatever drag Mach adds at a fixed angle of attack
+    const int zeroAlphaIndex = ALPHA_CELL_COUNT / 2;
+    double cl, cm, cd;
+    for (int j = 0; j <= MACH_CELL_COUNT; j++)
+    {
+        SampleSourceFunc(-PI + (zeroAlphaIndex * ALPHA_STEP), j * MACH_STEP, cl, cm, cd);
+        m_waveDrag[j] = cd - m_alphaRows[zeroAlphaIndex].cd;
+    }
+
+    // Verify that the source function actually separates into alpha and Mach terms by checking a
+    // cross-section of grid nodes; each of these must match the source function exactly.
+    const int stride = 100;
+    for (int i = 0; (i <= ALPHA_CELL_COUNT) && m_isTableValid; i++)
+    {
+        for (int j = 0; (j <= MACH_CELL_COUNT) && m_isTableValid; j += (((i % stride) == 0) ? 1 : stride))
+        {
+            SampleSourceFunc(-PI + (i * ALPHA_STEP), j * MACH_STEP, cl, cm, cd);
+            const AlphaRow &row = m_alphaRows[i];
+            const double tableCD = row.cd + m_waveDrag[j];
+            if ((fabs(cl - row.cl) > 1e-9) || (fabs(cm - row.cm) > 1e-9) || (fabs(cd - tableCD) > 1e-9))
+            {
+                char msg[256];
+                sprintf(msg, "AeroCoeffTable: coefficient function is not separable at alpha=%.2lf, Mach=%.2lf; table disabled", (-PI + (i * ALPHA_STEP)) * DEG, j * MACH_STEP);
+                oapiWriteLog(msg);
+                m_isTableValid = false;
+            }
+        }
+    }
+}
+
+// Returns the interpolated coefficients for the supplied angle of attack (or slip angle) and Mach number.
+void AeroCoeffTable::GetCoeffs(const double alpha, const double M, double *cl, double *cm, double *cd) const
+{
+    // the table does not extend past MAX_TABLE_MACH, which is only reached in the very thin upper atmosphere anyway
+    if (!m_isTableValid || (M > MAX_TABLE_MACH))
+    {
+        SampleSourceFunc(alpha, M, *cl, *cm, *cd);
+        return;
+    }
+
+    // Orbiter always passes -PI <= alpha <= PI, but clamp it anyway so we never index outside the table
+    double a = (alpha + PI) * ALPHA_CELLS_PER_RADIAN;
+    if (a < 0)
+        a = 0;
+    int i = static_cast<int>(a);
+    if (i > ALPHA_CELL_COUNT - 1)
+        i = ALPHA_CELL_COUNT - 1;
+    const double fa = ((a < ALPHA_CELL_COUNT) ? a : ALPHA_CELL_COUNT) - i;
+    const AlphaRow &r0 = m_alphaRows[i];
+    const AlphaRow &r1 = m_alphaRows[i + 1];
+
+    double m = M * MACH_CELLS_PER_MACH;
+    if (m < 0)
+        m = 0;
+    int j = static_cast<int>(m);
+    if (j > MACH_CELL_COUNT - 1)
+        j = MACH_CELL_COUNT - 1;
+    const double fm = m - j;
+
+    *cl = r0.cl + (r1.cl - r0.cl) * fa;
+    *cm = r0.cm + (r1.cm - r0.cm) * fa;
+    *cd = r0.cd + (r1.cd - r0.cd) * fa + m_waveDrag[j] + (m_waveDrag[j + 1] - m_waveDrag[j]) * fm;
+}
+
+// Orbiter airfoil callback; context = AeroCoeffTable to use
+void AeroCoeffTable::AirfoilCoeffFunc(VESSEL *v, double alpha, double M, double Re, void *context, double *cl, double *cm, double *cd)
+{
+    static_cast<const AeroCoeffTable *>(context)->GetCoeffs(alpha, M, cl, cm, cd);
+}
+
+void AeroCoeffTable::SampleSourceFunc(const double alpha, const double M, double &cl, double &cm, double &cd) const
+{
+    m_pSourceFunc(nullptr, alpha, M, 0, nullptr, &cl, &cm, &cd);
+}
@@ -0,0 +1,72 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// AeroCoeffTable.h
+// Precomputed lookup table for an airfoil coefficient function.  The table
+// samples the function once onto uniform angle-of-attack and Mach grids and
+// then answers each Orbiter airfoil callback with an index computation and
+// linear interpolation instead of evaluating the function itself.
+//
+// The table assumes the same thing that is true of all the XR coefficient
+// functions: lift and moment depend only on the angle, and Mach affects drag
+// only through an additive wave drag term.  The constructor verifies this at
+// each grid node; if the function does not pass, every lookup is passed
+// through to the function instead.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+
+class AeroCoeffTable
+{
+public:
+    AeroCoeffTable(AirfoilCoeffFuncEx pSourceFunc);
+
+    void GetCoeffs(const double alpha, const double M, double *cl, double *cm, double *cd) const;
+    bool IsTableValid() const { return m_isTableValid; }  // false = all lookups are passed through to the source function
+
+    // Pass this to CreateAirfoil3 along with a pointer to an AeroCoeffTable as the context
+    static void AirfoilCoeffFunc(VESSEL *v, double alpha, double M, double Re, void *context, double *cl, double *cm, double *cd);
+
+    static const int ALPHA_CELL_COUNT = 3600;   // 0.1 degree per cell from -180 to +180 degrees
+    static const int MACH_CELL_COUNT = 4000;    // 0.01 Mach per cell
+    static const double MAX_TABLE_MACH;         // above this we call the source function
+
+protected:
+    void SampleSourceFunc(const double alpha, const double M, double &cl, double &cm, double &cd) const;
+
+    // all three coefficients at a given angle are stored together so each lookup touches only two adjacent rows
+    struct AlphaRow
+    {
+        double cl;
+        double cm;
+        double cd;  // drag coefficient at Mach 0
+    };
+
+    const AirfoilCoeffFuncEx m_pSourceFunc;
+    AlphaRow m_alphaRows[ALPHA_CELL_COUNT + 1];
+    double m_waveDrag[MACH_CELL_COUNT + 1];      // additive drag coefficient for each Mach step
+    bool m_isTableValid;
+};
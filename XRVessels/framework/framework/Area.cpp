@@ -29,6 +29,7 @@
 // ==============================================================
 
 #include "Area.h"
+#include "SurfaceCache.h"
 
 // Constructor
 // Note: default for m_vcPanelTextureID = -1, which means "none"
@@ -59,10 +60,11 @@ RECT Area::GetRectForSize(const int sizeX, const int sizeY)
 }
 
 // Load a bitmap resource and return an Orbiter surface handle.  
+// Surfaces are shared via the SurfaceCache, so the caller must never draw onto the returned surface.
 SURFHANDLE Area::CreateSurface(const int resourceID) const
 {
     const HINSTANCE hDLL = GetVessel().GetModuleHandle();
-    return oapiCreateSurface(LoadBitmap(hDLL, MAKEINTRESOURCE (resourceID)));
+    return SurfaceCache::GetInstance().Acquire(GetVessel(), hDLL, resourceID);
 }
 
 // Destroy (free) an Orbiter surface and set the variable containing the surface value to 0
@@ -71,7 +73,9 @@ void Area::DestroySurface(SURFHANDLE *pSurfHandle)
     // NOTE: surface may have already been freed (or not yet allocated), so check for 0 here
     if (*pSurfHandle != 0)
     {
-        oapiDestroySurface(*pSurfHandle);
+        // surfaces from CreateSurface are returned to the cache; any other surface is ours alone
+        if (!SurfaceCache::GetInstance().Release(*pSurfHandle))
+            oapiDestroySurface(*pSurfHandle);
         *pSurfHandle = 0;    // clear so we don't free it again
     }
 }
@@ -83,6 +87,14 @@ void Area::TriggerRedraw()
     GetParentPanel().TriggerRedrawArea(this);
 }
 
+// Request a redraw of ourself each time the supplied blink rate toggles; this is typically invoked from Activate.
+// This saves an area whose only per-frame work is tracking a blink phase from needing a clbkPrePostStep.
+void Area::SubscribeToBlinkClock(const BLINK_RATE rate)
+{
+    _ASSERTE(IsActive());
+    GetVessel().GetBlinkClock().Subscribe(rate, this);
+}
+
 // the default activate method currently only sets our active flag, which is mainly used by assertion checks
 void Area::Activate()
 {
@@ -90,13 +102,15 @@ void Area::Activate()
     m_isActive = true;
 }
 
-// the default deactivate method currently only frees m_mainSurface and our private, cached, m_cachedGDISurface 
-// and clears the active flag, which is mainly used by assertion checks
+// the default deactivate method currently only frees m_mainSurface and our private, cached, m_cachedGDISurface, 
+// cancels any blink clock subscription, and clears the active flag, which is mainly used by assertion checks
 void Area::Deactivate()
 {
     _ASSERTE(IsActive());  // ensure that the subclass remembered to invoke its superclass's Activate method
     m_isActive = false;
 
+    GetVessel().GetBlinkClock().Unsubscribe(this);
+
     // destroy surfaces and set handles to 0 (either or both of these may be zero)
     DestroySurface(&m_mainSurface);       
 }
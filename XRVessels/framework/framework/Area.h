@@ -52,6 +52,7 @@ public:
     
     int GetAreaID() const { return m_areaID; };
     void TriggerRedraw();
+    void SubscribeToBlinkClock(const BLINK_RATE rate);  // TriggerRedraw each time rate toggles; remains in effect until we are deactivated
     void SetParentComponent(Component *pComponent) { m_pParentComponent = pComponent; }
     Component *GetParentComponent() const { return m_pParentComponent; }
     // Note: these two handles do not need to be cleaned up later: Orbiter does it automatically
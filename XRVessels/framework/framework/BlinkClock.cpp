@@ -0,0 +1,82 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// BlinkClock.cpp
+// Shared blink phases for all blinking lights and indicators on a vessel.
+// ==============================================================
+
+#include "BlinkClock.h"
+#include "Area.h"
+#include <math.h>
+#include <algorithm>
+
+// Constructor
+BlinkClock::BlinkClock()
+{
+    static const double periods[] = { 1.0, 0.75, 0.5 };  // indexed by BLINK_RATE
+    for (int i = 0; i < static_cast<int>(BLINK_RATE::COUNT); i++)
+    {
+        m_phases[i].period = periods[i];
+        m_phases[i].isOn = false;
+        m_phases[i].isToggled = false;
+    }
+}
+
+// Invoked by VESSEL3_EXT once per frame before any PreSteps, PostSteps, or area PrePostSteps are invoked.
+// simt = absolute simulation time
+void BlinkClock::Update(const double simt)
+{
+    for (int i = 0; i < static_cast<int>(BLINK_RATE::COUNT); i++)
+    {
+        Phase &phase = m_phases[i];
+        const bool isOn = (fmod(simt, phase.period) < (phase.period / 2));
+        phase.isToggled = (isOn != phase.isOn);
+        phase.isOn = isOn;
+
+        // repaint every area blinking at this rate in the same frame
+        if (phase.isToggled)
+        {
+            for (auto it = phase.subscribers.begin(); it != phase.subscribers.end(); it++)
+                (*it)->TriggerRedraw();
+        }
+    }
+}
+
+// Request a redraw of pArea each time the supplied rate toggles
+void BlinkClock::Subscribe(const BLINK_RATE rate, Area *pArea)
+{
+    vector<Area *> &subscribers = m_phases[static_cast<int>(rate)].subscribers;
+    if (find(subscribers.begin(), subscribers.end(), pArea) == subscribers.end())
+        subscribers.push_back(pArea);
+}
+
+// Remove pArea from all rates; it is OK if pArea is not subscribed to any of them
+void BlinkClock::Unsubscribe(Area *pArea)
+{
+    for (int i = 0; i < static_cast<int>(BLINK_RATE::COUNT); i++)
+    {
+        vector<Area *> &subscribers = m_phases[i].subscribers;
+        subscribers.erase(remove(subscribers.begin(), subscribers.end(), pArea), subscribers.end());
+    }
+}
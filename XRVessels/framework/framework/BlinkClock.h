@@ -0,0 +1,78 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// BlinkClock.h
+// Shared blink phases for all blinking lights and indicators on a vessel.
+// VESSEL3_EXT updates the clock once at the start of each PreStep, so
+// every light using the same rate toggles in the same frame.  Areas that
+// only need to repaint when their blink phase changes can subscribe to a
+// rate instead of polling in clbkPrePostStep; each phase change then
+// triggers one redraw of every subscribed area.
+// ==============================================================
+
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+class Area;
+
+// Each rate is on for the first half of its period.
+enum class BLINK_RATE
+{
+    HZ_1,       // on/off once per second; used by the master warning system
+    HZ_1_33,    // on/off once every 3/4-second; used by door transit indicators
+    HZ_2,       // on/off twice per second; used for startup/shutdown and fuel dump lights
+    COUNT       // not a rate: number of rates
+};
+
+class BlinkClock
+{
+public:
+    BlinkClock();
+
+    void Update(const double simt);
+
+    // Returns true if the supplied rate is in the "on" half of its period this frame.
+    bool IsOn(const BLINK_RATE rate) const { return m_phases[static_cast<int>(rate)].isOn; }
+
+    // Returns true if the supplied rate toggled this frame.
+    bool IsToggled(const BLINK_RATE rate) const { return m_phases[static_cast<int>(rate)].isToggled; }
+
+    // Area subscriptions; these are managed by Area::SubscribeToBlinkClock and Area::Deactivate.
+    void Subscribe(const BLINK_RATE rate, Area *pArea);
+    void Unsubscribe(Area *pArea);
+
+protected:
+    struct Phase
+    {
+        double period;      // in seconds
+        bool isOn;
+        bool isToggled;
+        vector<Area *> subscribers;
+    };
+
+    Phase m_phases[static_cast<int>(BLINK_RATE::COUNT)];
+};
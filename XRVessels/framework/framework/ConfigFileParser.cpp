@@ -43,15 +43,15 @@
 // pDefaultFilename = path to default config file; may be relative to Orbiter root or absolute
 // pLogFilename = path to optional (but highly recommended) log file; may be null
 ConfigFileParser::ConfigFileParser(const char *pDefaultFilename, const char *pLogFilename) :
-    m_pLogFile(nullptr), m_parseFailed(false) 
+    m_pLogWriter(nullptr), m_parseFailed(false) 
 {
     m_csDefaultFilename = pDefaultFilename;
     
     if (pLogFilename != nullptr)
     {
-        // open the log file in APPEND and SHARED mode so we can share it between multiple ship instances
-        m_pLogFile = fopen(pLogFilename, "a+t");
-        if (m_pLogFile == nullptr)
+        // the log writer is shared between multiple ship instances
+        m_pLogWriter = XRLogWriter::Open(pLogFilename);
+        if (m_pLogWriter == nullptr)
         {
             char temp[256];
             sprintf(temp, "Error opening log file '%s' for writing; attempting to continue", pLogFilename);
@@ -63,8 +63,7 @@ ConfigFileParser::ConfigFileParser(const char *pDefaultFilename, const char *pLo
 // Destructor
 ConfigFileParser::~ConfigFileParser()
 {
-    // clean up and close our logfile
-    fclose(m_pLogFile);
+    // nothing to do: the log writer is shared, and it is closed by XRLogWriter::Terminate
 }
 
 //
@@ -276,32 +275,14 @@ void ConfigFileParser::TrimString(char *pStr)
 }
 
 
-// log a message
+// log a message; the message is timestamped here and written to the log file and the debug console by the log writer's thread
 void ConfigFileParser::WriteLog(const char *pMsg) const
 {
     // nothing to do if msg is null or if logging disabled
-    if ((pMsg == nullptr) || (m_pLogFile == nullptr)) 
+    if ((pMsg == nullptr) || (m_pLogWriter == nullptr)) 
         return;
 
-    CStringA csMsg;
-    // get and format the current time
-    SYSTEMTIME st;
-    GetLocalTime(&st);
-    CString csPrefix;
-    if (!GetLogPrefix().IsEmpty())
-        csPrefix.Format("[%s] ", static_cast<const char *>(GetLogPrefix()));
-
-    csMsg.Format("%02d.%02d.%04d %02d:%02d:%02d.%03d - %s%s\n", 
-        st.wMonth, st.wDay, st.wYear, 
-        st.wHour, st.wMinute, st.wSecond, st.wMilliseconds,
-        static_cast<const char *>(csPrefix), pMsg);
-
-    // no point in checking for error here
-    OutputDebugString(csMsg);   // send to debug console
-    fwrite(csMsg, 1, csMsg.GetLength(), m_pLogFile);
-
-    // flush to disk in case we crash or are terminated
-    fflush(m_pLogFile);
+    m_pLogWriter->Write(GetLogPrefix(), pMsg);
 }
 
 // logs an error and returns false if the supplied value is out-of-range
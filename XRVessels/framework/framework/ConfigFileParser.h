@@ -34,6 +34,8 @@
 #include <atlstr.h>		// for CString
 #include <fstream>      // for ifstream
 
+#include "XRLogWriter.h"
+
 const int MAX_LINE_LENGTH = 1024;
 const int MAX_NAME_LENGTH = 256;
 const int MAX_VALUE_LENGTH = (MAX_LINE_LENGTH - MAX_NAME_LENGTH - 1);
@@ -93,7 +95,7 @@ protected:
     virtual bool ParseLine(const char *pSection, const char *pName, const char *pValue, const bool bParsingOverrideFile) = 0;
 
     bool m_parseFailed;     // true if parse failed, false if it succeeded
-    FILE *m_pLogFile;
+    XRLogWriter *m_pLogWriter;   // shared by all parsers that log to the same file; may be null
     CString m_csDefaultFilename;          // e.g,. "Config\XR2RavenstarPrefs.cfg"
     char m_buffer[MAX_LINE_LENGTH];
     char m_section[256];                  // value between brackets in [SECTION]; changes as each new section is encountered
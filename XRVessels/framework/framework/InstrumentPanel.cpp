@@ -25,6 +25,7 @@
 // ==============================================================
 
 #include <memory.h>
+#include <algorithm>
 #include "InstrumentPanel.h"
 #include "Area.h"
 
@@ -38,7 +39,8 @@
 InstrumentPanel::InstrumentPanel(VESSEL3_EXT &vessel, const int panelID, const int vcPanelID, const WORD panelResourceID, const bool force3DRedrawTo2D) :
         AreaGroup(), 
         m_vessel(vessel), m_panelID(panelID), m_vcPanelID(vcPanelID), m_hBmp(nullptr), m_isActive(false), 
-        m_panelResourceID(panelResourceID), m_force3DRedrawTo2D(force3DRedrawTo2D)
+        m_panelResourceID(panelResourceID), m_force3DRedrawTo2D(force3DRedrawTo2D),
+        m_redrawFrameSysTime(-1), m_redrawPreviousFrameSysTime(-1), m_redrawRoundRobinStart(0)
 {
     // NOTE: m_hBitmap must be reloaded inside Activate on each call because Orbiter seems to free the 
     // panel-associated bitmap memory itself each time the panel is deactivated.
@@ -93,11 +95,157 @@ bool InstrumentPanel::ProcessRedrawEvent(const int areaID, const int event, cons
 
     Area *pArea = GetArea(areaID);
     if (pArea != nullptr)
-        retVal = pArea->Redraw(event, surf);
+    {
+        // only PANEL_REDRAW_ALWAYS events are scheduled; all others are the result of an explicit trigger or mouse event
+        if (event == PANEL_REDRAW_ALWAYS)
+            retVal = ProcessScheduledRedraw(pArea, surf);
+        else
+            retVal = pArea->Redraw(event, surf);
+    }
 
     return retVal;
 }
 
+// Redraw a PANEL_REDRAW_ALWAYS area if it is due and fits in this frame's redraw budget.
+// Returns: true if the area was redrawn, false if it was not
+bool InstrumentPanel::ProcessScheduledRedraw(Area *pArea, const SURFHANDLE surf)
+{
+    // Orbiter sends all PANEL_REDRAW_ALWAYS events for a frame together, so plan the whole frame on its first event
+    const double sysTime = oapiGetSysTime();
+    if (sysTime != m_redrawFrameSysTime)
+        PlanRedrawFrame(sysTime);
+
+    const int areaID = pArea->GetAreaID();
+    auto it = m_redrawScheduleMap.find(areaID);
+    if (it == m_redrawScheduleMap.end())
+    {
+        // first event for this area: redraw it now so we can measure its cost
+        const RedrawSchedule newSchedule = { 0, -1, 0, 0, 0, true };
+        it = m_redrawScheduleMap.insert(make_pair(areaID, newSchedule)).first;
+    }
+
+    RedrawSchedule &schedule = it->second;
+
+    // if we were not visible last frame PlanRedrawFrame did not consider us, so redraw now if we are due
+    if ((schedule.lastEventSysTime != m_redrawPreviousFrameSysTime) && (GetPreciseUptime() >= schedule.nextDue))
+        schedule.isPlanned = true;
+
+    schedule.lastEventSysTime = sysTime;
+    if (!schedule.isPlanned)
+        return false;   // not due yet, or deferred to a later frame by the redraw budget
+    schedule.isPlanned = false;
+
+    const double startUptime = GetPreciseUptime();
+    const bool retVal = pArea->Redraw(PANEL_REDRAW_ALWAYS, surf);
+    const double redrawCost = GetPreciseUptime() - startUptime;
+
+    // update our rolling averages
+    if (schedule.lastRedraw < 0)
+    {
+        schedule.avgRedrawCost = redrawCost;
+        schedule.nextDue = startUptime;
+    }
+    else
+    {
+        schedule.avgRedrawCost += (redrawCost - schedule.avgRedrawCost) * 0.1;
+        const double redrawInterval = startUptime - schedule.lastRedraw;
+        schedule.avgRedrawInterval = ((schedule.avgRedrawInterval > 0) ? (schedule.avgRedrawInterval + ((redrawInterval - schedule.avgRedrawInterval) * 0.1)) : redrawInterval);
+    }
+    schedule.lastRedraw = startUptime;
+
+    // Keep our redraws in phase so we achieve the requested rate on average; however, if we fell more than an interval 
+    // behind (e.g., after a slow frame or because the budget deferred us), restart the interval from now rather than 
+    // redrawing in a burst.
+    const double redrawInterval = GetVessel().GetAreaRedrawInterval(areaID);
+    schedule.nextDue += redrawInterval;
+    if (schedule.nextDue < startUptime)
+        schedule.nextDue = startUptime + redrawInterval;
+
+    return retVal;
+}
+
+// Decide which PANEL_REDRAW_ALWAYS areas may redraw during the frame that is just starting.
+// Every area that is due is planned if there is no budget.  Otherwise, the due areas are ranked by how stale they are 
+// (in redraw intervals or frames, whichever is longer) times their priority weight, and the stalest areas are planned 
+// until their average redraw costs fill the budget.  The stalest area is always planned so that every area eventually
+// redraws no matter how small the budget is.
+void InstrumentPanel::PlanRedrawFrame(const double sysTime)
+{
+    const double previousFrameSysTime = m_redrawFrameSysTime;
+    const double frameDuration = ((previousFrameSysTime >= 0) ? (sysTime - previousFrameSysTime) : 0);
+    m_redrawPreviousFrameSysTime = previousFrameSysTime;
+    m_redrawFrameSysTime = sysTime;
+
+    const double budget = GetVessel().m_pConfig->GetPanelRedrawBudget() / 1000;   // convert to seconds
+    const double uptime = GetPreciseUptime();
+    const int areaCount = static_cast<int>(m_redrawScheduleMap.size());
+    const int roundRobinStart = ((areaCount > 0) ? (m_redrawRoundRobinStart++ % areaCount) : 0);
+
+    m_redrawCandidates.clear();
+    int areaIndex = 0;
+    for (auto it = m_redrawScheduleMap.begin(); it != m_redrawScheduleMap.end(); it++, areaIndex++)
+    {
+        RedrawSchedule &schedule = it->second;
+        schedule.isPlanned = false;
+
+        // Only consider areas that Orbiter redrew last frame: areas that are not visible receive no events, 
+        // so they must not use up any of the budget.
+        if ((schedule.lastEventSysTime != previousFrameSysTime) || (uptime < schedule.nextDue))
+            continue;
+
+        if (budget <= 0)
+        {
+            schedule.isPlanned = true;
+            continue;
+        }
+
+        const int areaID = it->first;
+        const double redrawInterval = max(GetVessel().GetAreaRedrawInterval(areaID), frameDuration);
+        const double staleness = ((redrawInterval > 0) ? ((uptime - schedule.lastRedraw) / redrawInterval) : 1.0);
+        const RedrawCandidate candidate = { staleness * static_cast<int>(GetVessel().GetAreaRedrawPriority(areaID)), (areaIndex + areaCount - roundRobinStart) % areaCount, &schedule };
+        m_redrawCandidates.push_back(candidate);
+    }
+
+    if (m_redrawCandidates.empty())
+        return;
+
+    sort(m_redrawCandidates.begin(), m_redrawCandidates.end(), [](const RedrawCandidate &a, const RedrawCandidate &b)
+        { return (a.score != b.score) ? (a.score > b.score) : (a.roundRobinOrder < b.roundRobinOrder); });
+
+    // areas that do not fit are skipped rather than ending the plan so that cheaper areas can still use the remaining budget
+    double plannedCost = 0;
+    for (auto it = m_redrawCandidates.begin(); it != m_redrawCandidates.end(); it++)
+    {
+        RedrawSchedule &schedule = *it->pSchedule;
+        if ((it != m_redrawCandidates.begin()) && ((plannedCost + schedule.avgRedrawCost) > budget))
+            continue;
+
+        schedule.isPlanned = true;
+        plannedCost += schedule.avgRedrawCost;
+    }
+}
+
+double InstrumentPanel::GetAchievedRefreshRate(const int areaID) const
+{
+    const auto it = m_redrawScheduleMap.find(areaID);
+    if ((it == m_redrawScheduleMap.end()) || (it->second.avgRedrawInterval <= 0))
+        return 0;
+
+    return 1.0 / it->second.avgRedrawInterval;
+}
+
+// Returns realtime seconds with sub-millisecond precision; VESSEL3_EXT::GetSystemUptime is too coarse to time a single redraw.
+double InstrumentPanel::GetPreciseUptime()
+{
+    static LARGE_INTEGER s_frequency = { 0 };
+    if (s_frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&s_frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<double>(counter.QuadPart) / static_cast<double>(s_frequency.QuadPart);
+}
+
 // Process a mouse event for the requested area ID if it is on our panel.
 // Returns: true if event was processed, false if it was not
 bool InstrumentPanel::ProcessMouseEvent(const int areaID, const int event, const int mx, const int my)
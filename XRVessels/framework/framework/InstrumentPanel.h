@@ -30,6 +30,8 @@
 #include "vessel3ext.h"
 #include "Component.h"
 #include "AreaGroup.h"
+#include <unordered_map>
+#include <vector>
 
 class InstrumentPanel : public AreaGroup
 {
@@ -50,6 +52,9 @@ public:
     bool TriggerRedrawArea(const int areaID);
     void TriggerRedrawArea(Area *pArea);
 
+    // Returns the realtime PANEL_REDRAW_ALWAYS redraws per second achieved by the given area while this panel was active; 0 = not redrawn yet
+    double GetAchievedRefreshRate(const int areaID) const;
+
     // returns resource ID of this panel in our DLL; e.g., IDB_PANEL1_1280
     WORD GetPanelResourceID() const
     {
@@ -67,6 +72,29 @@ public:
 
 protected:
     Component *AddComponent(Component *pComp);
+    bool ProcessScheduledRedraw(Area *pArea, const SURFHANDLE surf);
+    void PlanRedrawFrame(const double sysTime);
+
+    // PANEL_REDRAW_ALWAYS scheduling state for one area; all times are realtime seconds from GetPreciseUptime
+    struct RedrawSchedule
+    {
+        double nextDue;             // uptime at which this area should next be redrawn
+        double lastRedraw;          // uptime of our last redraw; < 0 = never
+        double avgRedrawCost;       // rolling average time spent in Area::Redraw
+        double avgRedrawInterval;   // rolling average time between redraws; 0 = unknown
+        double lastEventSysTime;    // oapiGetSysTime() of the last frame in which Orbiter sent us a PANEL_REDRAW_ALWAYS event
+        bool isPlanned;             // true if we may redraw during the current frame
+    };
+
+    // area that is due for a redraw but must compete for the frame's redraw budget
+    struct RedrawCandidate
+    {
+        double score;               // staleness * priority weight; highest is redrawn first
+        int roundRobinOrder;        // breaks ties so equally stale areas take turns
+        RedrawSchedule *pSchedule;
+    };
+
+    static double GetPreciseUptime();
 
     // data
     VESSEL3_EXT &m_vessel;
@@ -80,4 +108,9 @@ private:
     // data
     WORD m_panelResourceID; // resource ID of this panel in our DLL; e.g., IDB_PANEL1_1280
     vector<Component *> m_componentVector;    // list of all components on the panel
+    unordered_map<int, RedrawSchedule> m_redrawScheduleMap;  // key = area ID
+    vector<RedrawCandidate> m_redrawCandidates;   // reused each frame to avoid allocations
+    double m_redrawFrameSysTime;      // oapiGetSysTime() of the frame we last planned; < 0 = none
+    double m_redrawPreviousFrameSysTime;  // oapiGetSysTime() of the frame before that; < 0 = none
+    unsigned int m_redrawRoundRobinStart;
 };
@@ -0,0 +1,67 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// InstrumentPanelFactory.h
+// Factories that construct instrument panels on demand; these are
+// registered with VESSEL3_EXT::AddInstrumentPanel so that each panel is
+// only built the first time Orbiter loads it.
+// ==============================================================
+
+#pragma once
+
+class InstrumentPanel;
+
+// Abstract base class for all instrument panel factories
+class InstrumentPanelFactory
+{
+public:
+    virtual ~InstrumentPanelFactory() { }
+    virtual InstrumentPanel *CreatePanel() const = 0;   // caller takes ownership of the new panel
+};
+
+// Factory for panels whose constructor takes only the parent vessel; e.g., 2D panels.
+// VESSEL_CLASS is the vessel type that the panel's constructor requires; e.g., DeltaGliderXR1.
+template <class PANEL, class VESSEL_CLASS>
+class VesselPanelFactory : public InstrumentPanelFactory
+{
+public:
+    VesselPanelFactory(VESSEL_CLASS &vessel) : m_vessel(vessel) { }
+    virtual InstrumentPanel *CreatePanel() const { return new PANEL(m_vessel); }
+
+protected:
+    VESSEL_CLASS &m_vessel;
+};
+
+// Factory for panels whose constructor takes the parent vessel and the panel ID; e.g., VC panels.
+template <class PANEL, class VESSEL_CLASS>
+class VesselPanelIDFactory : public InstrumentPanelFactory
+{
+public:
+    VesselPanelIDFactory(VESSEL_CLASS &vessel, const int panelID) : m_vessel(vessel), m_panelID(panelID) { }
+    virtual InstrumentPanel *CreatePanel() const { return new PANEL(m_vessel, m_panelID); }
+
+protected:
+    VESSEL_CLASS &m_vessel;
+    const int m_panelID;
+};
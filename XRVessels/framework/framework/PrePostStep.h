@@ -34,12 +34,45 @@
 class PrePostStep
 {
 public:
-    PrePostStep(VESSEL3_EXT &vessel) : m_vessel(vessel) { } 
+    PrePostStep(VESSEL3_EXT &vessel) : m_vessel(vessel), m_skipped(false) { } 
     VESSEL3_EXT &GetVessel() const { return m_vessel; }
 
     // subclass must implement this method
     virtual void clbkPrePostStep(const double simt, const double simdt, const double mjd) = 0;
+
+    // Returns the lowest vessel fidelity level at which this step must run.  The default is REMOTE (always run), which
+    // is required for any step that affects the vessel's physics, systems, or consumables.  Steps that only produce 
+    // sounds, visuals, or panel state may return a higher level.
+    virtual FIDELITY_LEVEL GetMinimumFidelityLevel() const { return FIDELITY_LEVEL::REMOTE; }
+
+    // Invoked just before clbkPrePostStep when this step runs again after being skipped for one or more frames.
+    // Steps that detect changes from one frame to the next should reset their previous-frame state here so that
+    // they do not act on changes that occurred while they were not running.
+    virtual void clbkResync(const double simt) { }
+
+    // Invoked instead of clbkPrePostStep on each frame that this step is skipped.  A step that is skipped because 
+    // it only produces sounds or visuals may still need to keep some vessel state current here.
+    virtual void clbkSkipped(const double simt, const double simdt, const double mjd) { }
+
+    // Invoked by VESSEL3_EXT each frame: runs this step if it is needed at the supplied fidelity level
+    void Invoke(const FIDELITY_LEVEL fidelityLevel, const double simt, const double simdt, const double mjd)
+    {
+        if (fidelityLevel < GetMinimumFidelityLevel())
+        {
+            clbkSkipped(simt, simdt, mjd);
+            m_skipped = true;
+            return;
+        }
+
+        if (m_skipped)
+        {
+            clbkResync(simt);
+            m_skipped = false;
+        }
+        clbkPrePostStep(simt, simdt, mjd);
+    }
     
 private:
     VESSEL3_EXT &m_vessel;
+    bool m_skipped;     // true if we were skipped at least once since we last ran
 };
@@ -0,0 +1,135 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// SurfaceCache.cpp
+// DLL-wide cache of the Orbiter surfaces that areas load from bitmap
+// resources.
+// ==============================================================
+
+#include "SurfaceCache.h"
+#include "Vessel3Ext.h"
+
+// Unused surfaces are kept long enough to cover flipping back and forth between panels.
+const double SurfaceCache::RELEASE_DELAY = 60.0;
+
+// Returns the singleton surface cache for this module
+SurfaceCache &SurfaceCache::GetInstance()
+{
+    static SurfaceCache s_instance;
+    return s_instance;
+}
+
+// Returns the surface for the specified bitmap resource, loading it if it is not already cached.
+// Every call must be balanced by a call to Release.
+// vessel = vessel whose panel is acquiring the surface
+SURFHANDLE SurfaceCache::Acquire(const VESSEL &vessel, const HINSTANCE hModule, const int resourceID)
+{
+    const Key key(hModule, resourceID);
+    map<Key, Entry>::iterator it = m_surfaceMap.find(key);
+    if (it != m_surfaceMap.end())
+    {
+        m_hitCount++;
+        it->second.refCount++;
+        it->second.vessels.insert(&vessel);
+        return it->second.hSurface;
+    }
+
+    m_missCount++;
+    const SURFHANDLE hSurface = oapiCreateSurface(LoadBitmap(hModule, MAKEINTRESOURCE(resourceID)));
+    if (hSurface == 0)
+        return 0;   // should never happen; do not cache failures
+
+    Entry &entry = m_surfaceMap[key];
+    entry.hSurface = hSurface;
+    entry.refCount = 1;
+    entry.unusedSince = 0;
+    entry.vessels.insert(&vessel);
+    m_keyMap[hSurface] = key;
+    return hSurface;
+}
+
+// Release one reference to the specified surface; the surface is freed later by FreeUnusedSurfaces.
+// Returns true on success, or false if hSurface was not acquired from this cache.
+bool SurfaceCache::Release(const SURFHANDLE hSurface)
+{
+    unordered_map<SURFHANDLE, Key>::const_iterator itKey = m_keyMap.find(hSurface);
+    if (itKey == m_keyMap.end())
+        return false;
+
+    Entry &entry = m_surfaceMap[itKey->second];
+    _ASSERTE(entry.refCount > 0);
+    if (--entry.refCount == 0)
+        entry.unusedSince = VESSEL3_EXT::GetSystemUptime();
+
+    return true;
+}
+
+// Free surfaces that have been unused for at least RELEASE_DELAY seconds; if bForce is true, free all unused surfaces now.
+void SurfaceCache::FreeUnusedSurfaces(const bool bForce)
+{
+    const double uptime = VESSEL3_EXT::GetSystemUptime();
+    if (!bForce)
+    {
+        // this is invoked every frame, so only walk the cache a few times per release delay
+        if (uptime < m_nextFreeCheck)
+            return;
+        m_nextFreeCheck = uptime + (RELEASE_DELAY / 4);
+    }
+
+    for (map<Key, Entry>::iterator it = m_surfaceMap.begin(); it != m_surfaceMap.end(); )
+    {
+        const Entry &entry = it->second;
+        if ((entry.refCount == 0) && (bForce || ((uptime - entry.unusedSince) >= RELEASE_DELAY)))
+        {
+            oapiDestroySurface(entry.hSurface);
+            m_keyMap.erase(entry.hSurface);
+            it = m_surfaceMap.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+// Drop the supplied vessel's claim on each surface it acquired, and free any of those surfaces that are now unused 
+// and were never acquired by another live vessel.  Surfaces still shared with other vessels are left alone.  This is
+// invoked when a vessel is destroyed, since the graphics client may go away at the end of the session.
+void SurfaceCache::FreeVesselSurfaces(const VESSEL &vessel)
+{
+    for (map<Key, Entry>::iterator it = m_surfaceMap.begin(); it != m_surfaceMap.end(); )
+    {
+        Entry &entry = it->second;
+        if ((entry.vessels.erase(&vessel) > 0) && entry.vessels.empty() && (entry.refCount == 0))
+        {
+            oapiDestroySurface(entry.hSurface);
+            m_keyMap.erase(entry.hSurface);
+            it = m_surfaceMap.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
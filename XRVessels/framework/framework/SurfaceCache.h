@@ -0,0 +1,78 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// SurfaceCache.h
+// DLL-wide cache of the Orbiter surfaces that areas load from bitmap
+// resources, shared by all panels of all vessels in this module.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+// Surfaces are reference-counted: Area::CreateSurface acquires a surface and Area::DestroySurface
+// releases it.  A surface whose reference count drops to zero is not freed until it has been
+// unused for RELEASE_DELAY seconds, so switching between panels reuses the surfaces that were
+// already loaded instead of reloading each bitmap.
+// NOTE: cached surfaces are shared, so areas must never draw *onto* a surface obtained from CreateSurface.
+class SurfaceCache
+{
+public:
+    static SurfaceCache &GetInstance();
+
+    SURFHANDLE Acquire(const VESSEL &vessel, const HINSTANCE hModule, const int resourceID);
+    bool Release(const SURFHANDLE hSurface);    // returns false if hSurface did not come from this cache
+    void FreeUnusedSurfaces(const bool bForce);
+    void FreeVesselSurfaces(const VESSEL &vessel);
+
+    // statistics since the module was loaded
+    unsigned int GetHitCount() const { return m_hitCount; }
+    unsigned int GetMissCount() const { return m_missCount; }
+    int GetSurfaceCount() const { return static_cast<int>(m_surfaceMap.size()); }
+
+    static const double RELEASE_DELAY;   // in seconds (realtime)
+
+protected:
+    SurfaceCache() : m_hitCount(0), m_missCount(0), m_nextFreeCheck(0) { }
+
+    typedef pair<HINSTANCE, int> Key;   // module handle, bitmap resource ID
+    struct Entry
+    {
+        SURFHANDLE hSurface;
+        int refCount;
+        double unusedSince;     // system uptime when refCount dropped to zero
+        unordered_set<const VESSEL *> vessels;  // vessels that acquired this surface and have not been destroyed yet
+    };
+
+    map<Key, Entry> m_surfaceMap;
+    unordered_map<SURFHANDLE, Key> m_keyMap;   // reverse lookup for Release: key = surface, value = key in m_surfaceMap
+    unsigned int m_hitCount;
+    unsigned int m_missCount;
+    double m_nextFreeCheck;     // system uptime at which FreeUnusedSurfaces next checks for expired surfaces
+};
@@ -33,13 +33,19 @@
 
 #include "InstrumentPanel.h"
 #include "PrePostStep.h"
+#include "SurfaceCache.h"
+
+// clbkLoadPanel logs its latency on the first panel load and then once per this many panel switches
+static const int PANEL_SWITCH_LOG_INTERVAL = 50;
 
 // constructor
 VESSEL3_EXT::VESSEL3_EXT(OBJHANDLE vessel, int fmodel) :
     XRVesselCtrl(vessel, fmodel),
     m_hModule(nullptr), m_hasFocus(false), exmesh_tpl(nullptr),
 	m_videoWindowWidth(0), m_videoWindowHeight(0), m_lastVideoWindowWidth(-1), m_last2DPanelWidth(0),
-    m_absoluteSimTime(0), m_pConfig(nullptr)
+    m_absoluteSimTime(0), m_pConfig(nullptr), m_nextPanelEvictionCheck(0), m_flightDataRecorderOpened(false),
+    m_panelSwitchCount(0), m_panelSwitchMillis(0), m_maxPanelSwitchMillis(0),
+    m_fidelityLevel(FIDELITY_LEVEL::FOCUS)   // run everything until our first PreStep
 {
 	m_regKeyManager.Initialize(HKEY_CURRENT_USER, XR_GLOBAL_SETTINGS_REG_KEY, nullptr);   // should always succeed
 }
@@ -56,6 +62,14 @@ VESSEL3_EXT::~VESSEL3_EXT()
         delete pPanel;                         // ...and deallocate
     }
 
+    // Free any cached panel surfaces that only this vessel used: if this vessel is being deleted at the end of the 
+    // session the graphics client may be going away, too.
+    SurfaceCache::GetInstance().FreeVesselSurfaces(*this);
+
+    // clean up our panel factories
+    for (auto itFactory = m_panelFactoryMap.begin(); itFactory != m_panelFactoryMap.end(); itFactory++)
+        delete itFactory->second;
+
     // clean up each PostStep in our list
     PostStepIterator it2 = GetPostStepVector().begin();   // iterates over values
     for (; it2 != GetPostStepVector().end(); it2++)
@@ -97,6 +111,25 @@ void VESSEL3_EXT::AddInstrumentPanel(InstrumentPanel *pPanel, const int panelWid
     m_panelMap.insert(Int_InstrumentPanel_Pair(panelHash, pPanel));  // key = panel ID, value = panel *
 }
 
+// Register a factory for an instrument panel; the panel is not constructed until GetInstrumentPanel first 
+// requests it, so panels for unused resolutions (and all panels of vessels never flown) are never built.
+// We take ownership of pFactory.
+// Note: panelWidth must be zero for VC panels
+void VESSEL3_EXT::AddInstrumentPanel(InstrumentPanelFactory *pFactory, const int panelID, const int panelWidth)
+{
+    // sanity check
+#ifdef _DEBUG
+    if (panelID >= GetVCPanelIDBase()) // is this a VC panel?
+        _ASSERTE(panelWidth == 0);
+    else  // this is a 2D panel
+        _ASSERTE(panelWidth > 0);
+#endif
+
+    const int panelHash = GetPanelKey(panelID, panelWidth);
+    _ASSERTE(m_panelFactoryMap.find(panelHash) == m_panelFactoryMap.end());
+    m_panelFactoryMap[panelHash] = pFactory;
+}
+
 // Add a new PostStep to our vector
 void VESSEL3_EXT::AddPostStep(PrePostStep *pStep)
 {
@@ -109,27 +142,89 @@ void VESSEL3_EXT::AddPreStep(PrePostStep *pStep)
     GetPreStepVector().push_back(pStep);  // add to end of vector
 }
 
-// Returns the panel with the requested number (0-n), or nullptr if panel number is invalid
+// Returns the panel with the requested number (0-n) for the active video mode, constructing it first if necessary, 
+// or nullptr if panel number is invalid.
 // Note that each VC panel has a unique ID alongside the 2D panels
-// vcPanelIDBase = VC_PANEL_ID_BASE from the subclass
 InstrumentPanel *VESSEL3_EXT::GetInstrumentPanel(const int panelNumber)
 {
-    // obtain the current panel width, or 0 if this is a VC panel
-    int panelWidth = (Is2DPanel(panelNumber) ? Get2DPanelWidth() : 0);
-
-    // compute the panel hash
-    const int panelHash = GetPanelKey(panelNumber, panelWidth);
+    InstrumentPanel *retVal = FindInstrumentPanel(panelNumber);
+    if (retVal == nullptr)
+    {
+        // obtain the current panel width, or 0 if this is a VC panel
+        const int panelWidth = (Is2DPanel(panelNumber) ? Get2DPanelWidth() : 0);
+        const int panelHash = GetPanelKey(panelNumber, panelWidth);
 
-    InstrumentPanel *retVal = nullptr;    // assume not found
-    InstrumentPanelIterator it = m_panelMap.find(panelHash);
-    
-    if (it != m_panelMap.end())
-        retVal = it->second;     // found a matching panel
+        // construct the panel now if it was registered with a factory
+        auto itFactory = m_panelFactoryMap.find(panelHash);
+        if (itFactory != m_panelFactoryMap.end())
+        {
+            const double startTime = GetSystemUptime();
+            retVal = itFactory->second->CreatePanel();
+            _ASSERTE(retVal->GetPanelID() == panelNumber);
+            m_panelMap[panelHash] = retVal;
+
+            char msg[256];
+            sprintf(msg, "Constructed instrument panel %d (width %d) on demand in %.0lf ms", panelNumber, panelWidth, (GetSystemUptime() - startTime) * 1000);
+            m_pConfig->WriteLog(msg);
+        }
+    }
     
     _ASSERTE(retVal != nullptr);
     return retVal;
 }
 
+// Returns the panel with the requested number (0-n) for the active video mode, or nullptr if that panel has not 
+// been constructed yet.  Unlike GetInstrumentPanel, this never constructs a panel.
+InstrumentPanel *VESSEL3_EXT::FindInstrumentPanel(const int panelNumber)
+{
+    // obtain the current panel width, or 0 if this is a VC panel
+    const int panelWidth = (Is2DPanel(panelNumber) ? Get2DPanelWidth() : 0);
+
+    InstrumentPanelIterator it = m_panelMap.find(GetPanelKey(panelNumber, panelWidth));
+    return ((it != m_panelMap.end()) ? it->second : nullptr);
+}
+
+// Free any on-demand panels that have not been active for InactivePanelTimeout seconds; they will be constructed again
+// if they are loaded later.  Panels added without a factory and panels whose areas were read via GetArea are never 
+// freed here, since their area state is needed outside the panel.  Invoked from clbkPostStep.
+void VESSEL3_EXT::EvictInactivePanels()
+{
+    const double timeout = m_pConfig->GetInactivePanelTimeout();
+    if (timeout <= 0)
+        return;     // eviction disabled
+
+    // only check a few times per timeout period, since this is not time-critical
+    const double uptime = GetSystemUptime();
+    if (uptime < m_nextPanelEvictionCheck)
+        return;
+    m_nextPanelEvictionCheck = uptime + max(timeout / 4, 1.0);
+
+    for (InstrumentPanelIterator it = m_panelMap.begin(); it != m_panelMap.end(); )
+    {
+        const int panelHash = it->first;
+        InstrumentPanel *pPanel = it->second;
+
+        auto itLastUsed = m_panelLastUsedMap.find(panelHash);
+        if (pPanel->IsActive() || (itLastUsed == m_panelLastUsedMap.end()))
+        {
+            m_panelLastUsedMap[panelHash] = uptime;     // in use now, or we never saw it before
+            it++;
+        }
+        else if ((m_panelFactoryMap.find(panelHash) != m_panelFactoryMap.end()) && (m_pinnedPanelSet.find(panelHash) == m_pinnedPanelSet.end()) && 
+                 ((uptime - itLastUsed->second) >= timeout))
+        {
+            pPanel->Deactivate();   // should already be deactivated, but let's be safe
+            delete pPanel;
+            m_panelLastUsedMap.erase(itLastUsed);
+            it = m_panelMap.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
 // Trigger a redraw are for the supplied area ID by sending the request to each of our panels
 bool VESSEL3_EXT::TriggerRedrawArea(const int areaID)
 {
@@ -171,6 +266,10 @@ bool VESSEL3_EXT::clbkLoadPanel2D(int panelID, PANELHANDLE hPanel, DWORD viewW,
 // NOTE: panelID may refer to a 3D (VC) panel.
 bool VESSEL3_EXT::clbkLoadPanel(int panelID)
 {
+    LARGE_INTEGER freq, startTime, endTime;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&startTime);
+
     // release any surfaces from any other panels, 2D and 3D
     DeactivateAllPanels();
 
@@ -179,6 +278,25 @@ bool VESSEL3_EXT::clbkLoadPanel(int panelID)
     if (activationSuccessful)
         pPanel->SetActive(true);    // mark as active so the panel's Activate() method doesn't have to remember to do it
 
+    // Track the panel switch latency; this is logged only on the first panel load (which loads every surface) and then 
+    // once every PANEL_SWITCH_LOG_INTERVAL switches so the log is not flooded while the user flips through panels.
+    QueryPerformanceCounter(&endTime);
+    const double elapsedMillis = static_cast<double>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+    m_panelSwitchCount++;
+    m_panelSwitchMillis += elapsedMillis;
+    m_maxPanelSwitchMillis = max(m_maxPanelSwitchMillis, elapsedMillis);
+    if (((m_panelSwitchCount - 1) % PANEL_SWITCH_LOG_INTERVAL) == 0)   // 1, 1 + interval, 1 + (2 * interval), ...
+    {
+        const int switchesSinceLog = ((m_panelSwitchCount == 1) ? 1 : PANEL_SWITCH_LOG_INTERVAL);
+        const SurfaceCache &surfaceCache = SurfaceCache::GetInstance();
+        char msg[256];
+        sprintf(msg, "%d panel switch(es): average %.2lf ms, longest %.2lf ms (surface cache: %u reused, %u loaded, %d cached)", 
+            switchesSinceLog, m_panelSwitchMillis / switchesSinceLog, m_maxPanelSwitchMillis, 
+            surfaceCache.GetHitCount(), surfaceCache.GetMissCount(), surfaceCache.GetSurfaceCount());
+        m_pConfig->WriteLog(msg);
+        m_panelSwitchMillis = m_maxPanelSwitchMillis = 0;
+    }
+
     return activationSuccessful;
 }
 
@@ -341,16 +459,25 @@ bool VESSEL3_EXT::clbkPanelRedrawEvent(int areaID, int event, SURFHANDLE surf)
 // Retrieve an area by its ID for a given panel; remember that the same area can (and usually will!) have the same ID
 // if it appears on multiple panels.
 //
-// This will return the area object for a given panel ID.
-// Returns: requested Area object, or nullptr if area not found on the specified panel
+// This will return the area object for a given panel ID; the panel is not constructed here if it has not been
+// displayed yet.  A panel whose areas are read here is never evicted from then on, so its area state is preserved.
+// Returns: requested Area object, or nullptr if area not found on the specified panel or the panel has not been constructed
 Area *VESSEL3_EXT::GetArea(const int panelID, const int areaID)
 {
-    Area *pArea = nullptr;
-    InstrumentPanel *pPanel = GetInstrumentPanel(panelID);
-    if (pPanel != nullptr)
-        pArea = pPanel->GetArea(areaID);
+    if (FindInstrumentPanel(panelID) == nullptr)
+        return nullptr;
 
-    return pArea;
+    m_pinnedPanelSet.insert(GetPanelKey(panelID, (Is2DPanel(panelID) ? Get2DPanelWidth() : 0)));
+    return FindArea(panelID, areaID);
+}
+
+// Retrieve an area by its ID for a given panel without pinning the panel; use this for lookups made on every frame 
+// that only read the area's current state, so that the panel may still be evicted when it is inactive.
+// Returns: requested Area object, or nullptr if area not found on the specified panel or the panel has not been constructed
+Area *VESSEL3_EXT::FindArea(const int panelID, const int areaID)
+{
+    InstrumentPanel *pPanel = FindInstrumentPanel(panelID);
+    return ((pPanel != nullptr) ? pPanel->GetArea(areaID) : nullptr);
 }
 
 //
@@ -378,6 +505,9 @@ void VESSEL3_EXT::clbkPostStep(double simtDoNotUse, double simdt, double mjd)
     // Note: PostStep happens after the PreStep, so AbsoluteSimTime was already updated before here.
     const double simt = GetAbsoluteSimTime();
 
+    // refresh our flight state snapshot: the core has integrated a new state since our PreStep
+    m_flightState.Capture(*this);
+
     // NEW BEHAVIOR for XR1 1.3: only invoke PostSteps on the ACTIVE panel, since they should not be doing any business logic anyway.
     InstrumentPanelIterator it = GetPanelMap().begin(); // key = panel ID, value = InstrumentPanel *
     for (; it != GetPanelMap().end(); it++)
@@ -390,13 +520,106 @@ void VESSEL3_EXT::clbkPostStep(double simtDoNotUse, double simdt, double mjd)
         }
     }
 
-    // invoke all registered PostStep objects
+    // invoke all registered PostStep objects that are needed at our current fidelity level
     PostStepIterator it2 = GetPostStepVector().begin();
     for (; it2 != GetPostStepVector().end(); it2++)
     {
         PrePostStep *pStep = *it2;
-        pStep->clbkPrePostStep(simt, simdt, mjd);
+        pStep->Invoke(m_fidelityLevel, simt, simdt, mjd);
+    }
+
+    EvictInactivePanels();
+    SurfaceCache::GetInstance().FreeUnusedSurfaces(false);
+
+    // Publish this frame's telemetry last so that it reflects the state set by all our PostSteps.
+    PublishTelemetry(simdt, mjd);
+}
+
+// Publish a telemetry record for this frame if telemetry is enabled in the config file, and record it if the
+// flight data recorder is enabled; invoked at the end of each clbkPostStep.  This never blocks and never allocates
+// once the channel and recorder are open.
+void VESSEL3_EXT::PublishTelemetry(const double simdt, const double mjd)
+{
+    const TELEMETRY_MODE mode = m_pConfig->GetTelemetryMode();
+    const int fdrChannels = m_pConfig->GetFlightDataRecorderChannels();
+    if ((mode == TELEMETRY_MODE::DISABLED) && (fdrChannels == 0))
+        return;     // nothing to do
+
+    // first frame: we need our vessel name, so this cannot be done in the constructor
+    if ((mode != TELEMETRY_MODE::DISABLED) && !m_telemetryChannel.IsOpen())
+    {
+        const bool bSharedMemory = (mode == TELEMETRY_MODE::SHARED_MEMORY);
+        char msg[256];
+        if (m_telemetryChannel.Open(GetName(), bSharedMemory))
+            sprintf(msg, "Telemetry publisher enabled (%s)", (bSharedMemory ? "shared memory: " XRTELEMETRY_MAPPING_PREFIX "<vessel name>" : "in-process only"));
+        else
+            sprintf(msg, "WARNING: unable to create telemetry shared memory; GetLastError=0x%X.  Falling back to in-process telemetry only.", GetLastError());
+        m_pConfig->WriteLog(msg);
+    }
+
+    if ((fdrChannels != 0) && !m_flightDataRecorderOpened)
+    {
+        m_flightDataRecorderOpened = true;   // only try once
+        char msg[MAX_PATH + 128];
+        if (m_flightDataRecorder.Open(GetName(), GetClassName(), fdrChannels, mjd))
+            sprintf(msg, "Flight data recorder enabled: %s", m_flightDataRecorder.GetFilename());
+        else
+            sprintf(msg, "WARNING: unable to create flight data recorder file; GetLastError=0x%X.  Flight data will not be recorded.", GetLastError());
+        m_pConfig->WriteLog(msg);
     }
+
+    memset(&m_telemetryRecord, 0, sizeof(m_telemetryRecord));
+    m_telemetryRecord.SimTime = GetAbsoluteSimTime();
+    m_telemetryRecord.SimDT = simdt;
+    m_telemetryRecord.MJD = mjd;
+    PopulateTelemetryRecord(m_telemetryRecord);
+
+    if (m_telemetryChannel.IsOpen())
+        m_telemetryChannel.Publish(m_telemetryRecord);
+
+    if (m_flightDataRecorder.IsOpen())
+        m_flightDataRecorder.Record(m_telemetryRecord);
+}
+
+// Populate the core flight data in the telemetry record; XR system fields are set to -1 (not supported) here.
+void VESSEL3_EXT::PopulateTelemetryRecord(XRTelemetryRecord &record) const
+{
+    const XRFlightState &fs = GetFlightState();
+    record.Altitude = fs.GetAltitude(ALTMODE_GROUND);
+    record.Airspeed = fs.GetAirspeed();
+    record.Groundspeed = fs.GetGroundspeed();
+    record.MachNumber = fs.GetMachNumber();
+    record.DynPressure = fs.GetDynPressure();
+    record.AtmPressure = fs.GetAtmPressure();
+    record.Pitch = fs.GetPitch();
+    record.Bank = fs.GetBank();
+    record.Yaw = fs.GetYaw();
+    record.AOA = fs.GetAOA();
+    record.Slip = fs.GetSlipAngle();
+
+    VECTOR3 angularVel;
+    fs.GetAngularVel(angularVel);
+    record.AngularVel[0] = angularVel.x;
+    record.AngularVel[1] = angularVel.y;
+    record.AngularVel[2] = angularVel.z;
+
+    record.Mass = GetMass();
+    record.MainThrustLevel = GetThrusterGroupLevel(THGROUP_MAIN);
+    record.RetroThrustLevel = GetThrusterGroupLevel(THGROUP_RETRO);
+    record.HoverThrustLevel = GetThrusterGroupLevel(THGROUP_HOVER);
+    record.GroundContact = (fs.GroundContact() ? 1 : 0);
+    record.HasFocus = (HasFocus() ? 1 : 0);
+
+    // XR system data is not known at this level
+    record.MainFuelMass = record.RCSFuelMass = record.ScramFuelMass = record.APUFuelMass = record.LOXMass = -1;
+    record.CoolantTemp = record.NoseconeTemp = record.LeftWingTemp = record.RightWingTemp = record.CockpitTemp = record.TopHullTemp = -1;
+    record.CenterOfGravity = -1;
+    record.GearProc = record.NoseconeProc = record.AirbrakeProc = record.RadiatorProc = record.BayDoorsProc = -1;
+    record.AutopilotTargetPitch = record.AutopilotTargetBank = record.AutopilotTargetDescentRate = record.AutopilotTargetAirspeed = -1;
+    record.CustomAutopilotMode = record.AirspeedHoldEngaged = record.MWSActive = record.IsCrashed = -1;
+    record.LeftWingIntegrity = record.RightWingIntegrity = -1;
+    record.SoundLoadMillis = record.SoundCacheHitRate = record.SoundResidentBytes = -1;
+    record.SoundLoads = record.SoundRequests = -1;
 }
 
 //
@@ -440,13 +663,49 @@ void VESSEL3_EXT::clbkPreStep(double simtDoNotUse, double simdt, double mjd)
     // ********************************************************************
     const double simt = GetAbsoluteSimTime();
 
-    // invoke all registered PreStep objects
+    // capture this frame's flight state once so our PreStep objects do not each query the core for it
+    m_flightState.Capture(*this);
+
+    // advance the blink phases before anything reads them this frame; this also triggers a redraw of each area subscribed to a phase that just toggled
+    m_blinkClock.Update(simt);
+
+    // this level applies to both our PreSteps and PostSteps for this frame
+    UpdateFidelityLevel();
+
+    // invoke all registered PreStep objects that are needed at our current fidelity level
     PreStepIterator it2 = GetPreStepVector().begin();
     for (; it2 != GetPreStepVector().end(); it2++)
     {
         PrePostStep *pStep = *it2;
-        pStep->clbkPrePostStep(simt, simdt, mjd);
+        pStep->Invoke(m_fidelityLevel, simt, simdt, mjd);
+    }
+}
+
+// Set our fidelity level for this frame based on focus and the camera's distance from us.
+// A vessel is promoted as soon as it crosses a distance threshold, but it is demoted only after it moves 
+// FIDELITY_HYSTERESIS times farther away than the threshold so that it does not toggle levels every frame.
+void VESSEL3_EXT::UpdateFidelityLevel()
+{
+    if (HasFocus())
+    {
+        m_fidelityLevel = FIDELITY_LEVEL::FOCUS;
+        return;
     }
+
+    VECTOR3 cameraPos, vesselPos;
+    oapiCameraGlobalPos(&cameraPos);
+    GetGlobalPos(vesselPos);
+    const double distance = length(cameraPos - vesselPos);
+
+    const double nearDistance = FIDELITY_NEAR_DISTANCE * ((m_fidelityLevel >= FIDELITY_LEVEL::NEARBY) ? FIDELITY_HYSTERESIS : 1.0);
+    const double farDistance = FIDELITY_FAR_DISTANCE * ((m_fidelityLevel >= FIDELITY_LEVEL::DISTANT) ? FIDELITY_HYSTERESIS : 1.0);
+
+    if (distance < nearDistance)
+        m_fidelityLevel = FIDELITY_LEVEL::NEARBY;
+    else if (distance < farDistance)
+        m_fidelityLevel = FIDELITY_LEVEL::DISTANT;
+    else
+        m_fidelityLevel = FIDELITY_LEVEL::REMOTE;
 }
 
 #if 0  // NOT IMPLEMENTED BECAUSE THIS CANNOT YET HANDLE FULL-SCREEN MODES : NOTE: we will not need this now, but let's keep the code in case we need to parse Orbiter.cfg later for any reason (sample code).
@@ -33,8 +33,14 @@
 #include "PropType.h"
 #include "VesselConfigFileParser.h"
 #include "RegKeyManager.h"
+#include "XRTelemetry.h"
+#include "XRFlightDataRecorder.h"
+#include "XRFlightState.h"
+#include "BlinkClock.h"
+#include "InstrumentPanelFactory.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // redefine oapiGetSimTime as a compile-time error to prevent XR code from accidentally invoking it
@@ -73,6 +79,22 @@ inline double SAFE_FRACTION(double a, double b)
     return (a / b);
 }
 
+// Simulation fidelity of a vessel, from lowest to highest; each PrePostStep runs only at or above its minimum level.
+//   FOCUS   = vessel has the focus
+//   NEARBY  = camera is close enough to see the vessel
+//   DISTANT = vessel is not visible, but is close enough that the pilot may switch to it soon
+//   REMOTE  = vessel is far from the camera: steps that only matter once the pilot may switch to it are skipped, too
+// Every step that affects a vessel's physics, systems, or consumables runs every frame at every level.
+enum class FIDELITY_LEVEL { REMOTE, DISTANT, NEARBY, FOCUS };
+
+#define FIDELITY_NEAR_DISTANCE   20e3     /* meters from the camera */
+#define FIDELITY_FAR_DISTANCE    2000e3   /* meters from the camera */
+#define FIDELITY_HYSTERESIS      1.1      /* a vessel must move this much farther than a threshold before it is demoted */
+
+// Relative weight of a PANEL_REDRAW_ALWAYS area when the panel redraw budget cannot cover every area that is due 
+// in a frame; see InstrumentPanel::PlanRedrawFrame.
+enum class REDRAW_PRIORITY { LOW = 1, NORMAL = 2, HIGH = 4 };
+
 // VESSEL3_EXT base class common to all XR vessels
 class VESSEL3_EXT : public XRVesselCtrl
 {
@@ -93,14 +115,19 @@ public:
 
     void SetModuleHandle(const HMODULE hModule) { m_hModule = hModule; }
     void AddInstrumentPanel(InstrumentPanel *pPanel, const int panelWidth);
+    void AddInstrumentPanel(InstrumentPanelFactory *pFactory, const int panelID, const int panelWidth);  // panel is constructed when first used
     void AddPreStep(PrePostStep *pPostStep);
     void AddPostStep(PrePostStep *pPreStep);
     InstrumentPanel *GetInstrumentPanel(const int panelNumber);
+    InstrumentPanel *FindInstrumentPanel(const int panelNumber);   // returns nullptr if the panel has not been constructed
     vector<PrePostStep *> &GetPostStepVector() { return m_postStepVector; }
     vector<PrePostStep *>  &GetPreStepVector()  { return m_preStepVector; }
     void DeactivateAllPanels();
-    Area *GetArea(const int panelID, const int areaID);
+    Area *GetArea(const int panelID, const int areaID);   // returns nullptr if the panel has not been constructed
+    Area *FindArea(const int panelID, const int areaID);  // same as GetArea, but does not pin the panel; for lookups that need no area state later
     bool HasFocus() const { return m_hasFocus; }   // returns true if we have the focus, false if not
+    FIDELITY_LEVEL GetFidelityLevel() const { return m_fidelityLevel; }   // updated at the start of each PreStep
+    const XRTelemetryChannel &GetTelemetryChannel() const { return m_telemetryChannel; }  // in-process consumers may Read() from this at any time
 
     // returns the number of '1' bits in dwBitmask
     static int CountOneBits(DWORD dwBitmask)
@@ -135,6 +162,13 @@ public:
     // This is the same principle as oapiGetSimTime except that it always returns a value >= the previous frame's value.
     double GetAbsoluteSimTime() const { return m_absoluteSimTime; }  
 
+    // Returns the flight state snapshot captured at the start of this frame's PreStep and PostStep; use this from 
+    // PreStep and PostStep objects instead of re-querying the Orbiter core for the same values every frame.
+    const XRFlightState &GetFlightState() const { return m_flightState; }
+
+    // Returns the blink phases shared by all of our blinking lights; updated at the start of each PreStep.
+    BlinkClock &GetBlinkClock() { return m_blinkClock; }
+
     // Returns the number of seconds since the system booted (realtime); typically has 10-16 millisecond accuracy (16 ms = 1/60th second),
     // which should suffice for normal realtime deltas.
     // Note: it is OK for this method to be static without a mutex because Orbiter is single-threaded
@@ -162,6 +196,11 @@ public:
     virtual bool clbkVCRedrawEvent(int areaID, int event, SURFHANDLE surf) { return clbkPanelRedrawEvent(areaID, event, surf); }
     //----------------------------------------------------------------------------
 
+    // Override these to throttle PANEL_REDRAW_ALWAYS areas; the active InstrumentPanel queries them each frame.  
+    // The defaults redraw every area each frame at NORMAL priority.
+    virtual double GetAreaRedrawInterval(const int areaID) { return 0; }   // minimum realtime seconds between redraws; 0 = every frame
+    virtual REDRAW_PRIORITY GetAreaRedrawPriority(const int areaID) { return REDRAW_PRIORITY::NORMAL; }
+
     // you should not normally need to override these methods; however, they are virtual in case you need to sometime
     virtual bool TriggerRedrawArea(const int areaID);
 
@@ -207,12 +246,19 @@ public:
 
 protected:
     void WriteForced2DResolutionLogMessage(const int panelWidth) const;
+    void PublishTelemetry(const double simdt, const double mjd);
+    void UpdateFidelityLevel();
+
+    // Populates the vessel-specific fields in the telemetry record; invoked once per frame only if telemetry or the flight data recorder is enabled.
+    // Subclasses that override this should invoke the base class method first.
+    virtual void PopulateTelemetryRecord(XRTelemetryRecord &record) const;
 
     // construct panel ID key: (panelWidth * 1000) + panel ID
     // Note: panelWidth MUST be zero for VC (non-2D) panels!
     int GetPanelKey(const int panelID, const int panelWidth) { return (panelWidth * 1000) + panelID; }
 
-    unordered_map<int, InstrumentPanel *> &GetPanelMap() { return m_panelMap; }  // returns map of all panels in this ship
+    unordered_map<int, InstrumentPanel *> &GetPanelMap() { return m_panelMap; }  // returns map of all panels constructed so far in this ship
+    void EvictInactivePanels();
 
     // map of our XRGrappleTargetVessels: key=vessel name, value=XRGrappleTargetVessel itself
     typedef unordered_map<const string *, XRGrappleTargetVessel *, stringhasher, stringhasher> HASHMAP_STR_XRGRAPPLETARGETVESSEL;
@@ -229,9 +275,23 @@ private:
     HMODULE m_hModule;
     bool m_hasFocus;                             // true if we are in focus (i.e., we are the active ship), false if not
     unordered_map<int, InstrumentPanel *> m_panelMap; // map of all instrument panels: key = (panelWidth * 1000) + panel ID, value = InstrumentPanel *
+    unordered_map<int, InstrumentPanelFactory *> m_panelFactoryMap;  // panels that are constructed on demand: key = same as m_panelMap
+    unordered_map<int, double> m_panelLastUsedMap;   // key = same as m_panelMap, value = system uptime when the panel was last active
+    unordered_set<int> m_pinnedPanelSet;         // panels whose areas were read via GetArea; these are never evicted.  Key = same as m_panelMap
+    double m_nextPanelEvictionCheck;             // system uptime at which EvictInactivePanels next checks our panels
+    int m_panelSwitchCount;                      // number of times clbkLoadPanel was invoked
+    double m_panelSwitchMillis;                  // total clbkLoadPanel time since the panel switch latency was last logged
+    double m_maxPanelSwitchMillis;               // longest clbkLoadPanel time since the panel switch latency was last logged
     vector<PrePostStep *> m_postStepVector;      // list of PrePostStep objects; may be empty
     vector<PrePostStep *> m_preStepVector;       // list of PrePostStep objects; may be empty
     double m_absoluteSimTime;                    // linear simulation time since simulation start, ignoring any MJD changes (edits)
+    XRTelemetryChannel m_telemetryChannel;       // opened on the first PostStep if telemetry is enabled
+    XRTelemetryRecord m_telemetryRecord;         // work record reused each frame
+    XRFlightDataRecorder m_flightDataRecorder;   // opened on the first PostStep if the flight data recorder is enabled; closed when we are deleted
+    bool m_flightDataRecorderOpened;             // true = we already tried to open m_flightDataRecorder
+    XRFlightState m_flightState;                 // recaptured at the start of each PreStep and PostStep
+    FIDELITY_LEVEL m_fidelityLevel;              // determines which PreSteps and PostSteps are run this frame
+    BlinkClock m_blinkClock;                     // updated at the start of each PreStep
 };
 
 //---------------------------------------------------------------------------
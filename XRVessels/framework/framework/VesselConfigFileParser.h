@@ -32,6 +32,9 @@
 // NOTE: if you add additional widths, be sure to update VESSEL3_EXT::Get2DPanelWidth() as well.
 enum class TWO_D_PANEL_WIDTH { AUTODETECT, USE1280, USE1600, USE1920 };
 
+// telemetry publisher modes; see XRTelemetry.h
+enum class TELEMETRY_MODE { DISABLED, IN_PROCESS, SHARED_MEMORY };
+
 class VesselConfigFileParser : public ConfigFileParser
 {
 public:
@@ -40,11 +43,19 @@ public:
 
     bool ParseVesselConfig(const char *pVesselName);    // e.g., pVesselName = "XR5-01"
     TWO_D_PANEL_WIDTH GetTwoDPanelWidth() const { return TwoDPanelWidth; }
+    TELEMETRY_MODE GetTelemetryMode() const { return TelemetryMode; }
+    int GetFlightDataRecorderChannels() const { return FlightDataRecorderChannels; }
+    double GetInactivePanelTimeout() const { return InactivePanelTimeout; }
+    double GetPanelRedrawBudget() const { return PanelRedrawBudget; }
 
 protected:
     // parsed data values required for the framework
     // NOTE: THE SUBCLASS *MUST* POPULATE THESE VALUES!
     TWO_D_PANEL_WIDTH TwoDPanelWidth;
+    TELEMETRY_MODE TelemetryMode;
+    int FlightDataRecorderChannels; // sum of XRFDR_GROUP_* values; 0 = flight data recorder disabled
+    double InactivePanelTimeout;    // in seconds; 0 = never free inactive panels
+    double PanelRedrawBudget;       // in milliseconds per frame for all PANEL_REDRAW_ALWAYS areas; 0 = unlimited
 
 private:
 };
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XREventRecorder.cpp
+// Records and plays back XR vessel events in .xrevt files.
+// ==============================================================
+
+#include "XREventRecorder.h"
+#include <string.h>
+#include <math.h>
+
+// A playback session starts at the MJD at which its recording started; allow for the recording having started
+// a frame or two before our first PreStep.  A file outside this window belongs to a different recording.
+const double XREventPlayer::START_MJD_TOLERANCE = 1.0 / 86400;    // one second
+
+// Build the .xrevt filename for the supplied vessel and recording, e.g., "XRFlightData\XR5-01-51983.621940.xrevt".
+// Orbiter does not tell vessels the name of the recording, so each recording is identified by the MJD at which it 
+// started: recordings of different flights each keep their own event file.
+static void GetEventFilename(char *pFilenameOut, const size_t bufferSize, const char *pFolder, const char *pVesselName, const double startMJD)
+{
+    _snprintf(pFilenameOut, bufferSize - 1, "%s\\%s-%.6lf%s", pFolder, pVesselName, startMJD, XREVT_FILE_EXTENSION);
+    pFilenameOut[bufferSize - 1] = 0;
+}
+
+//-------------------------------------------------------------------------
+
+XREventRecorder::XREventRecorder() :
+    m_pFile(nullptr), m_startMJD(0)
+{
+}
+
+XREventRecorder::~XREventRecorder()
+{
+    Close();
+}
+
+// Create the output file and start recording.
+//   pOutputFolder = folder relative to the Orbiter root folder; created if it does not exist
+//   pVesselName, pVesselClass = stored in the file header; the vessel name is also used to name the file
+//   mjd = MJD at which recording started; all event times are relative to this, and it is also used to name the file
+// Returns: true on success, false if the output file could not be created
+bool XREventRecorder::Open(const char *pOutputFolder, const char *pVesselName, const char *pVesselClass, const double mjd)
+{
+    Close();    // in case we were already open
+
+    char filename[MAX_PATH];
+    CreateDirectory(pOutputFolder, nullptr);   // OK if it already exists
+    GetEventFilename(filename, sizeof(filename), pOutputFolder, pVesselName, mjd);
+    m_pFile = fopen(filename, "wb");
+    if (m_pFile == nullptr)
+        return false;
+
+    XREventFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = XREVT_MAGIC;
+    header.FormatVersion = XREVT_FORMAT_VERSION;
+    header.HeaderSize = sizeof(XREventFileHeader);
+    header.RecordSize = sizeof(XREventRecord);
+    header.StartMJD = mjd;
+    strncpy(header.VesselName, pVesselName, XREVT_VESSEL_NAME_LEN - 1);
+    strncpy(header.VesselClass, pVesselClass, XREVT_VESSEL_NAME_LEN - 1);
+    fwrite(&header, sizeof(header), 1, m_pFile);
+
+    m_startMJD = mjd;
+    return true;
+}
+
+// Stop recording and flush any buffered records to disk
+void XREventRecorder::Close()
+{
+    if (!IsOpen())
+        return;     // nothing to do
+
+    fclose(m_pFile);
+    m_pFile = nullptr;
+}
+
+// Append one event.
+//   mjd = current MJD
+//   type, value, flags, args = vessel-defined; see XREventRecord
+void XREventRecorder::Record(const double mjd, const int type, const int value, const int flags, const float arg0, const float arg1, const float arg2)
+{
+    if (!IsOpen())
+        return;     // not recording
+
+    XREventRecord record;
+    record.EventTime = (mjd - m_startMJD) * 86400;
+    record.Type = static_cast<uint16_t>(type);
+    record.Value = static_cast<uint8_t>(value);
+    record.Flags = static_cast<uint8_t>(flags);
+    record.Args[0] = arg0;
+    record.Args[1] = arg1;
+    record.Args[2] = arg2;
+    fwrite(&record, sizeof(record), 1, m_pFile);
+}
+
+//-------------------------------------------------------------------------
+
+XREventPlayer::XREventPlayer() :
+    m_nextRecord(0), m_startMJD(0), m_isOpen(false)
+{
+}
+
+// Load the event file for the supplied vessel that was recorded along with this playback session.
+//   pInputFolder, pVesselName = same values that were passed to XREventRecorder::Open
+//   mjd = MJD at which playback started
+// Returns: true on success, false if there is no valid event file for this vessel and playback session
+bool XREventPlayer::Open(const char *pInputFolder, const char *pVesselName, const double mjd)
+{
+    Close();    // in case we were already open
+
+    // The playback may not start at exactly the recorded MJD, so check each of this vessel's event files
+    char pattern[MAX_PATH];
+    _snprintf(pattern, sizeof(pattern) - 1, "%s\\%s-*%s", pInputFolder, pVesselName, XREVT_FILE_EXTENSION);
+    pattern[sizeof(pattern) - 1] = 0;
+
+    WIN32_FIND_DATA findData;
+    const HANDLE hFind = FindFirstFile(pattern, &findData);
+    if (hFind == INVALID_HANDLE_VALUE)
+        return false;   // no event files for this vessel
+
+    do
+    {
+        char filename[MAX_PATH];
+        _snprintf(filename, sizeof(filename) - 1, "%s\\%s", pInputFolder, findData.cFileName);
+        filename[sizeof(filename) - 1] = 0;
+        if (Load(filename, pVesselName, mjd))
+            break;
+    } while (FindNextFile(hFind, &findData));
+    FindClose(hFind);
+
+    return m_isOpen;
+}
+
+// Load the supplied event file if it was recorded by the supplied vessel along with this playback session.
+//   mjd = MJD at which playback started
+// Returns: true on success, false if the file is invalid or belongs to a different vessel or recording
+bool XREventPlayer::Load(const char *pFilename, const char *pVesselName, const double mjd)
+{
+    FILE *pFile = fopen(pFilename, "rb");
+    if (pFile == nullptr)
+        return false;
+
+    // Note: the filename pattern also matches vessels whose names start with this vessel's name followed by a dash
+    XREventFileHeader header;
+    bool retVal = ((fread(&header, sizeof(header), 1, pFile) == 1) &&
+                   (header.Magic == XREVT_MAGIC) && (header.FormatVersion == XREVT_FORMAT_VERSION) &&
+                   (header.HeaderSize == sizeof(XREventFileHeader)) && (header.RecordSize == sizeof(XREventRecord)) &&
+                   (strncmp(header.VesselName, pVesselName, XREVT_VESSEL_NAME_LEN - 1) == 0) &&
+                   (fabs(mjd - header.StartMJD) <= START_MJD_TOLERANCE));
+
+    if (retVal)
+    {
+        // a partial record at the end means the recording was cut short; just ignore it
+        XREventRecord record;
+        while (fread(&record, sizeof(record), 1, pFile) == 1)
+            m_records.push_back(record);
+
+        m_startMJD = header.StartMJD;
+        m_nextRecord = 0;
+        m_isOpen = true;
+    }
+
+    fclose(pFile);
+    return retVal;
+}
+
+void XREventPlayer::Close()
+{
+    m_records.clear();
+    m_nextRecord = 0;
+    m_isOpen = false;
+}
+
+// Returns the next record whose event time has been reached, or nullptr if none is due yet;
+// invoke this repeatedly each frame until it returns nullptr.
+//   mjd = current MJD
+const XREventRecord *XREventPlayer::GetNextDueRecord(const double mjd)
+{
+    if (m_nextRecord >= m_records.size())
+        return nullptr;     // no more events
+
+    const XREventRecord &record = m_records[m_nextRecord];
+    if (record.EventTime > ((mjd - m_startMJD) * 86400))
+        return nullptr;     // not due yet
+
+    m_nextRecord++;
+    return &record;
+}
@@ -0,0 +1,115 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XREventRecorder.h
+// Records XR vessel actions as fixed-size binary records in a .xrevt file
+// while Orbiter's flight recorder is running, and feeds them back at their
+// recorded times during playback.
+//
+// A file is a fixed-size header followed by XREventRecord entries in the
+// order they were recorded.  Event times are stored in seconds relative to
+// the header's StartMJD, which is the MJD at which recording started; a
+// playback session starts at that same MJD, so the recorded times line up
+// with the playback timeline.  The meaning of Type, Value, and Args is
+// defined by the vessel that records the events.
+// ==============================================================
+
+#pragma once
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+#define XREVT_MAGIC            0x54564558   /* 'XEVT' */
+#define XREVT_FORMAT_VERSION   1            /* bump this whenever the layout below changes */
+#define XREVT_FILE_EXTENSION   ".xrevt"
+#define XREVT_VESSEL_NAME_LEN  64           // includes the terminating null
+#define XREVT_ARG_COUNT        3
+
+#pragma pack(push, 8)
+
+struct XREventFileHeader
+{
+    uint32_t Magic;             // XREVT_MAGIC
+    uint32_t FormatVersion;     // XREVT_FORMAT_VERSION
+    uint32_t HeaderSize;        // sizeof(XREventFileHeader); the first record starts here
+    uint32_t RecordSize;        // sizeof(XREventRecord)
+    double   StartMJD;          // MJD at which recording started
+    char     VesselName[XREVT_VESSEL_NAME_LEN];
+    char     VesselClass[XREVT_VESSEL_NAME_LEN];
+};
+
+struct XREventRecord
+{
+    double   EventTime;         // seconds since StartMJD
+    uint16_t Type;              // vessel-defined event type
+    uint8_t  Value;             // vessel-defined event value
+    uint8_t  Flags;             // vessel-defined
+    float    Args[XREVT_ARG_COUNT];  // vessel-defined; unused arguments are zero
+};
+
+#pragma pack(pop)
+
+// Writes XREventRecords for one vessel; owned by the vessel and used only from the simulation thread.
+// Records go through a buffered stream, so Record() does not touch the disk on every event.
+class XREventRecorder
+{
+public:
+    XREventRecorder();
+    virtual ~XREventRecorder();
+
+    bool Open(const char *pOutputFolder, const char *pVesselName, const char *pVesselClass, const double mjd);
+    void Close();
+    bool IsOpen() const { return (m_pFile != nullptr); }
+    void Record(const double mjd, const int type, const int value, const int flags = 0, const float arg0 = 0, const float arg1 = 0, const float arg2 = 0);
+
+protected:
+    FILE *m_pFile;
+    double m_startMJD;
+};
+
+// Reads a .xrevt file recorded by XREventRecorder and returns its records in order as the playback reaches their event times.
+class XREventPlayer
+{
+public:
+    XREventPlayer();
+
+    bool Open(const char *pInputFolder, const char *pVesselName, const double mjd);
+    void Close();
+    bool IsOpen() const { return m_isOpen; }
+    const XREventRecord *GetNextDueRecord(const double mjd);
+
+protected:
+    static const double START_MJD_TOLERANCE;
+
+    bool Load(const char *pFilename, const char *pVesselName, const double mjd);
+
+    vector<XREventRecord> m_records;    // the entire file is read at open; these files are small
+    size_t m_nextRecord;                // index of the next record to be returned
+    double m_startMJD;
+    bool m_isOpen;
+};
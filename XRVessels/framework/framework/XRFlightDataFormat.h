@@ -0,0 +1,105 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRFlightDataFormat.h
+// On-disk layout of XR flight data recorder (.xrfdr) files.
+//
+// A file is a fixed-size header followed by fixed-size blocks of
+// XRFDR_BLOCK_FRAMES frames each.  Within a block the data is stored by
+// column: first the sim time of each frame, then all values of the first
+// channel, then all values of the second channel, and so on, so a reader can
+// pull a single channel out of a block without touching the others.
+//
+// This header has no dependencies on Windows or Orbiter so that external
+// tools may simply include it.
+// ==============================================================
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define XRFDR_MAGIC            0x52444658   /* 'XFDR' */
+#define XRFDR_FORMAT_VERSION   1            /* bump this whenever the layout below changes */
+#define XRFDR_FILE_EXTENSION   ".xrfdr"
+
+#define XRFDR_BLOCK_FRAMES     256          // frames per block
+#define XRFDR_MAX_CHANNELS     64
+#define XRFDR_NAME_LEN         32           // includes the terminating null
+#define XRFDR_UNITS_LEN        16           // includes the terminating null
+#define XRFDR_VESSEL_NAME_LEN  64           // includes the terminating null
+
+#pragma pack(push, 8)
+
+struct XRFDRChannelInfo
+{
+    char Name[XRFDR_NAME_LEN];      // e.g., "Pitch"
+    char Units[XRFDR_UNITS_LEN];    // e.g., "rad"
+};
+
+struct XRFDRFileHeader
+{
+    uint32_t Magic;             // XRFDR_MAGIC
+    uint32_t FormatVersion;     // XRFDR_FORMAT_VERSION
+    uint32_t HeaderSize;        // sizeof(XRFDRFileHeader); the first block starts here
+    uint32_t BlockFrames;       // XRFDR_BLOCK_FRAMES
+    uint32_t ChannelCount;      // 1 <= n <= XRFDR_MAX_CHANNELS
+    uint32_t BlockSize;         // XRFDRBlockSize(ChannelCount)
+    uint32_t BlockCount;        // number of blocks written so far; updated after each block, so a file is readable while it is being recorded
+    uint32_t Reserved;
+    double   StartMJD;          // MJD of the first frame
+    char     VesselName[XRFDR_VESSEL_NAME_LEN];
+    char     VesselClass[XRFDR_VESSEL_NAME_LEN];
+    XRFDRChannelInfo Channels[XRFDR_MAX_CHANNELS];  // only the first ChannelCount entries are used
+};
+
+// Each block begins with this header, followed by:
+//   double SimTime[XRFDR_BLOCK_FRAMES]                       (absolute sim time in seconds)
+//   float  Values[ChannelCount][XRFDR_BLOCK_FRAMES]
+// Only the first FrameCount rows of each column are valid; only the last block in a file may be partially filled.
+struct XRFDRBlockHeader
+{
+    uint32_t FrameCount;
+    uint32_t Reserved;
+};
+
+#pragma pack(pop)
+
+// Returns the size in bytes of a single block for the specified number of channels
+inline size_t XRFDRBlockSize(const uint32_t channelCount)
+{
+    return sizeof(XRFDRBlockHeader) + (XRFDR_BLOCK_FRAMES * sizeof(double)) + (static_cast<size_t>(channelCount) * XRFDR_BLOCK_FRAMES * sizeof(float));
+}
+
+// Returns the sim time column of a block
+inline const double *XRFDRGetSimTimes(const void *pBlock)
+{
+    return reinterpret_cast<const double *>(static_cast<const uint8_t *>(pBlock) + sizeof(XRFDRBlockHeader));
+}
+
+// Returns the value column of the specified channel in a block
+inline const float *XRFDRGetChannelValues(const void *pBlock, const uint32_t channelIndex)
+{
+    return reinterpret_cast<const float *>(XRFDRGetSimTimes(pBlock) + XRFDR_BLOCK_FRAMES) + (static_cast<size_t>(channelIndex) * XRFDR_BLOCK_FRAMES);
+}
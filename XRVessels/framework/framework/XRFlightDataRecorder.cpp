@@ -0,0 +1,343 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRFlightDataRecorder.cpp
+// Records telemetry channels into a memory-mapped .xrfdr file.
+// ==============================================================
+
+#include "XRFlightDataRecorder.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Every channel that may be recorded, in file order; channels are written only if their group is enabled.
+struct XRFDRChannelDef
+{
+    int group;              // XRFDR_GROUP_*
+    const char *pName;
+    const char *pUnits;
+    size_t offset;          // into XRTelemetryRecord
+    bool isInt;
+};
+
+#define XRFDR_DOUBLE(group, field, units)  { group, #field, units, offsetof(XRTelemetryRecord, field), false }
+#define XRFDR_INT(group, field, units)     { group, #field, units, offsetof(XRTelemetryRecord, field), true }
+
+static const XRFDRChannelDef s_channelDefs[] =
+{
+    XRFDR_DOUBLE(XRFDR_GROUP_ATTITUDE, Pitch, "rad"),
+    XRFDR_DOUBLE(XRFDR_GROUP_ATTITUDE, Bank, "rad"),
+    XRFDR_DOUBLE(XRFDR_GROUP_ATTITUDE, Yaw, "rad"),
+    XRFDR_DOUBLE(XRFDR_GROUP_ATTITUDE, AOA, "rad"),
+    XRFDR_DOUBLE(XRFDR_GROUP_ATTITUDE, Slip, "rad"),
+
+    { XRFDR_GROUP_RATES, "AngularVelX", "rad/s", offsetof(XRTelemetryRecord, AngularVel) + (0 * sizeof(double)), false },
+    { XRFDR_GROUP_RATES, "AngularVelY", "rad/s", offsetof(XRTelemetryRecord, AngularVel) + (1 * sizeof(double)), false },
+    { XRFDR_GROUP_RATES, "AngularVelZ", "rad/s", offsetof(XRTelemetryRecord, AngularVel) + (2 * sizeof(double)), false },
+
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, Altitude, "m"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, Airspeed, "m/s"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, Groundspeed, "m/s"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, MachNumber, ""),
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, DynPressure, "Pa"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, AtmPressure, "Pa"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FLIGHT, Mass, "kg"),
+    XRFDR_INT   (XRFDR_GROUP_FLIGHT, GroundContact, "bool"),
+
+    XRFDR_DOUBLE(XRFDR_GROUP_THRUST, MainThrustLevel, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_THRUST, RetroThrustLevel, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_THRUST, HoverThrustLevel, "frac"),
+
+    XRFDR_DOUBLE(XRFDR_GROUP_FUEL, MainFuelMass, "kg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FUEL, RCSFuelMass, "kg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FUEL, ScramFuelMass, "kg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FUEL, APUFuelMass, "kg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FUEL, LOXMass, "kg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_FUEL, CenterOfGravity, "m"),
+
+    XRFDR_DOUBLE(XRFDR_GROUP_TEMPERATURES, CoolantTemp, "C"),
+    XRFDR_DOUBLE(XRFDR_GROUP_TEMPERATURES, NoseconeTemp, "K"),
+    XRFDR_DOUBLE(XRFDR_GROUP_TEMPERATURES, LeftWingTemp, "K"),
+    XRFDR_DOUBLE(XRFDR_GROUP_TEMPERATURES, RightWingTemp, "K"),
+    XRFDR_DOUBLE(XRFDR_GROUP_TEMPERATURES, CockpitTemp, "K"),
+    XRFDR_DOUBLE(XRFDR_GROUP_TEMPERATURES, TopHullTemp, "K"),
+
+    XRFDR_DOUBLE(XRFDR_GROUP_DOORS, GearProc, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_DOORS, NoseconeProc, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_DOORS, AirbrakeProc, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_DOORS, RadiatorProc, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_DOORS, BayDoorsProc, "frac"),
+
+    XRFDR_INT   (XRFDR_GROUP_AUTOPILOT, CustomAutopilotMode, "enum"),
+    XRFDR_INT   (XRFDR_GROUP_AUTOPILOT, AirspeedHoldEngaged, "bool"),
+    XRFDR_DOUBLE(XRFDR_GROUP_AUTOPILOT, AutopilotTargetPitch, "deg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_AUTOPILOT, AutopilotTargetBank, "deg"),
+    XRFDR_DOUBLE(XRFDR_GROUP_AUTOPILOT, AutopilotTargetDescentRate, "m/s"),
+    XRFDR_DOUBLE(XRFDR_GROUP_AUTOPILOT, AutopilotTargetAirspeed, "m/s"),
+
+    XRFDR_DOUBLE(XRFDR_GROUP_DAMAGE, LeftWingIntegrity, "frac"),
+    XRFDR_DOUBLE(XRFDR_GROUP_DAMAGE, RightWingIntegrity, "frac"),
+    XRFDR_INT   (XRFDR_GROUP_DAMAGE, MWSActive, "bool"),
+    XRFDR_INT   (XRFDR_GROUP_DAMAGE, IsCrashed, "bool"),
+};
+
+static_assert((sizeof(s_channelDefs) / sizeof(s_channelDefs[0])) <= XRFDR_MAX_CHANNELS, "too many flight data recorder channels");
+
+// Constructor
+XRFlightDataRecorder::XRFlightDataRecorder() :
+    m_channelCount(0), m_blockSize(0), m_frameInBlock(0), m_droppedBlocks(0), m_pRing(nullptr),
+    m_producedBlocks(0), m_writtenBlocks(0), m_stopRequested(false),
+    m_hFile(INVALID_HANDLE_VALUE), m_hMapping(nullptr), m_pView(nullptr), m_blockCapacity(0), m_committedBlocks(0), m_writeFailed(false)
+{
+    *m_filename = 0;
+}
+
+// Destructor
+XRFlightDataRecorder::~XRFlightDataRecorder()
+{
+    Close();
+}
+
+// Create the output file and start recording.
+//   pVesselName, pVesselClass = stored in the file header; the vessel name is also used to name the file
+//   channelGroups = sum of XRFDR_GROUP_* values to record
+//   mjd = MJD of the first frame
+// Returns: true on success, false if no channels were selected or the output file could not be created
+bool XRFlightDataRecorder::Open(const char *pVesselName, const char *pVesselClass, const int channelGroups, const double mjd)
+{
+    Close();    // in case we were already open
+
+    m_channelCount = 0;
+    XRFDRFileHeader header;
+    memset(&header, 0, sizeof(header));
+    for (const XRFDRChannelDef &def : s_channelDefs)
+    {
+        if ((def.group & channelGroups) == 0)
+            continue;
+
+        m_sources[m_channelCount].offset = def.offset;
+        m_sources[m_channelCount].isInt = def.isInt;
+        strncpy(header.Channels[m_channelCount].Name, def.pName, XRFDR_NAME_LEN - 1);
+        strncpy(header.Channels[m_channelCount].Units, def.pUnits, XRFDR_UNITS_LEN - 1);
+        m_channelCount++;
+    }
+
+    if (m_channelCount == 0)
+        return false;   // nothing to record
+
+    // e.g., "XRFlightData\XR5-01_20211231_235959.xrfdr"
+    CreateDirectory(XRFDR_OUTPUT_FOLDER, nullptr);   // OK if it already exists
+    const time_t now = time(nullptr);
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", localtime(&now));
+    _snprintf(m_filename, sizeof(m_filename) - 1, "%s\\%s_%s%s", XRFDR_OUTPUT_FOLDER, pVesselName, timestamp, XRFDR_FILE_EXTENSION);
+    m_filename[sizeof(m_filename) - 1] = 0;
+
+    m_hFile = CreateFile(m_filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    m_blockSize = XRFDRBlockSize(m_channelCount);
+    if (!MapFile(GROW_BLOCKS))
+    {
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+        DeleteFile(m_filename);
+        return false;
+    }
+
+    header.Magic = XRFDR_MAGIC;
+    header.FormatVersion = XRFDR_FORMAT_VERSION;
+    header.HeaderSize = sizeof(XRFDRFileHeader);
+    header.BlockFrames = XRFDR_BLOCK_FRAMES;
+    header.ChannelCount = m_channelCount;
+    header.BlockSize = static_cast<uint32_t>(m_blockSize);
+    header.BlockCount = 0;
+    header.StartMJD = mjd;
+    strncpy(header.VesselName, pVesselName, XRFDR_VESSEL_NAME_LEN - 1);
+    strncpy(header.VesselClass, pVesselClass, XRFDR_VESSEL_NAME_LEN - 1);
+    memcpy(m_pView, &header, sizeof(header));
+
+    // allocate the ring buffer up front: Record() never allocates
+    m_pRing = new unsigned char[RING_BLOCKS * m_blockSize];
+    memset(m_pRing, 0, RING_BLOCKS * m_blockSize);
+    m_frameInBlock = 0;
+    m_droppedBlocks = 0;
+    m_committedBlocks = 0;
+    m_writeFailed = false;
+    m_producedBlocks.store(0, std::memory_order_relaxed);
+    m_writtenBlocks.store(0, std::memory_order_relaxed);
+    m_stopRequested.store(false, std::memory_order_relaxed);
+
+    m_writerThread = std::thread(&XRFlightDataRecorder::WriterThreadMain, this);
+    return true;
+}
+
+// Stop recording: waits for the writer thread to flush all completed blocks, writes the final partial block, and trims the file
+void XRFlightDataRecorder::Close()
+{
+    if (!IsOpen())
+        return;     // nothing to do
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested.store(true, std::memory_order_relaxed);
+    }
+    m_wakeWriter.notify_one();
+    m_writerThread.join();
+
+    // the writer thread has exited, so we own the file now
+    if (m_frameInBlock > 0)
+    {
+        unsigned char *pBlock = m_pRing + ((m_producedBlocks.load(std::memory_order_relaxed) % RING_BLOCKS) * m_blockSize);
+        reinterpret_cast<XRFDRBlockHeader *>(pBlock)->FrameCount = m_frameInBlock;
+        WriteBlock(pBlock);
+    }
+
+    // If growing the file failed, MapFile already unmapped the view; the header and every committed block were
+    // flushed to the file before that, so the file only needs to be trimmed.
+    const unsigned long long usedBytes = sizeof(XRFDRFileHeader) + (m_committedBlocks * static_cast<unsigned long long>(m_blockSize));
+    if (m_pView != nullptr)
+        UnmapFile();
+
+    // trim the unused space at the end of the file
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = static_cast<LONGLONG>(usedBytes);
+    if (SetFilePointerEx(m_hFile, fileSize, nullptr, FILE_BEGIN))
+        SetEndOfFile(m_hFile);
+    CloseHandle(m_hFile);
+    m_hFile = INVALID_HANDLE_VALUE;
+
+    delete[] m_pRing;
+    m_pRing = nullptr;
+}
+
+// Invoked by Record() on the simulation thread when the current block is full; hands it to the writer thread.
+void XRFlightDataRecorder::CommitBlock()
+{
+    const unsigned long long produced = m_producedBlocks.load(std::memory_order_relaxed);
+    unsigned char *pBlock = m_pRing + ((produced % RING_BLOCKS) * m_blockSize);
+    reinterpret_cast<XRFDRBlockHeader *>(pBlock)->FrameCount = XRFDR_BLOCK_FRAMES;
+    m_frameInBlock = 0;
+
+    // The next block must not still be waiting to be written; if the writer thread has fallen that far behind,
+    // drop this block and reuse its slot rather than blocking the simulation.
+    if (((produced + 1) - m_writtenBlocks.load(std::memory_order_acquire)) >= RING_BLOCKS)
+    {
+        m_droppedBlocks++;
+        return;
+    }
+
+    m_producedBlocks.store(produced + 1, std::memory_order_release);
+    m_wakeWriter.notify_one();  // the writer also polls, so a missed wakeup only delays the write
+}
+
+// Writer thread: copies each completed block from the ring buffer to the file
+void XRFlightDataRecorder::WriterThreadMain()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWriter.wait_for(lock, std::chrono::milliseconds(250), [this]
+            {
+                return m_stopRequested.load(std::memory_order_relaxed) || 
+                    (m_writtenBlocks.load(std::memory_order_relaxed) < m_producedBlocks.load(std::memory_order_acquire));
+            });
+        }
+
+        // always drain completed blocks before exiting
+        unsigned long long written = m_writtenBlocks.load(std::memory_order_relaxed);
+        while (written < m_producedBlocks.load(std::memory_order_acquire))
+        {
+            WriteBlock(m_pRing + ((written % RING_BLOCKS) * m_blockSize));
+            m_writtenBlocks.store(++written, std::memory_order_release);   // frees the ring slot
+        }
+
+        if (m_stopRequested.load(std::memory_order_relaxed))
+            break;
+    }
+}
+
+// Append a block to the file, growing the file if necessary; invoked only from the writer thread or from Close.
+// Returns: true on success, false if the file could not be grown (the block is discarded)
+bool XRFlightDataRecorder::WriteBlock(const unsigned char *pBlock)
+{
+    if (m_writeFailed)
+        return false;
+
+    const unsigned long long blockIndex = m_committedBlocks;
+    if (blockIndex >= m_blockCapacity)
+    {
+        if (!MapFile(m_blockCapacity + GROW_BLOCKS))
+        {
+            m_writeFailed = true;   // e.g., disk full; m_pView is nullptr now
+            return false;
+        }
+    }
+
+    memcpy(m_pView + sizeof(XRFDRFileHeader) + (blockIndex * m_blockSize), pBlock, m_blockSize);
+    m_committedBlocks = blockIndex + 1;
+    reinterpret_cast<XRFDRFileHeader *>(m_pView)->BlockCount = static_cast<uint32_t>(m_committedBlocks);   // readers only see the block once it is complete
+    return true;
+}
+
+// (Re)map the output file so that it can hold the specified number of blocks; this extends the file on disk.
+// Returns: true on success, false on error
+bool XRFlightDataRecorder::MapFile(const unsigned long long blockCapacity)
+{
+    UnmapFile();
+
+    const unsigned long long fileBytes = sizeof(XRFDRFileHeader) + (blockCapacity * m_blockSize);
+    m_hMapping = CreateFileMapping(m_hFile, nullptr, PAGE_READWRITE, static_cast<DWORD>(fileBytes >> 32), static_cast<DWORD>(fileBytes & 0xFFFFFFFF), nullptr);
+    if (m_hMapping == nullptr)
+        return false;
+
+    m_pView = static_cast<unsigned char *>(MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(fileBytes)));
+    if (m_pView == nullptr)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+        return false;
+    }
+
+    m_blockCapacity = blockCapacity;
+    return true;
+}
+
+void XRFlightDataRecorder::UnmapFile()
+{
+    if (m_pView != nullptr)
+    {
+        FlushViewOfFile(m_pView, 0);
+        UnmapViewOfFile(m_pView);
+        m_pView = nullptr;
+    }
+
+    if (m_hMapping != nullptr)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+}
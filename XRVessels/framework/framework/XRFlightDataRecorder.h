@@ -0,0 +1,133 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRFlightDataRecorder.h
+// Records a configurable set of telemetry channels each frame into a 
+// preallocated ring buffer; a background thread streams completed blocks
+// to a memory-mapped .xrfdr file (see XRFlightDataFormat.h).
+// ==============================================================
+
+#pragma once
+
+#include <windows.h>
+#include <crtdbg.h>   // for _ASSERTE
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "XRTelemetry.h"
+#include "XRFlightDataFormat.h"
+
+// Channel groups that may be recorded; the FlightDataRecorderChannels config setting is the sum of these values
+#define XRFDR_GROUP_ATTITUDE     0x001    // pitch, bank, yaw, AOA, slip
+#define XRFDR_GROUP_RATES        0x002    // angular velocities
+#define XRFDR_GROUP_FLIGHT       0x004    // altitude, speeds, pressures, mass, ground contact
+#define XRFDR_GROUP_THRUST       0x008    // thrust group levels
+#define XRFDR_GROUP_FUEL         0x010    // propellant and LOX masses, center of gravity
+#define XRFDR_GROUP_TEMPERATURES 0x020    // coolant and hull temperatures
+#define XRFDR_GROUP_DOORS        0x040    // door procs
+#define XRFDR_GROUP_AUTOPILOT    0x080    // autopilot modes and targets
+#define XRFDR_GROUP_DAMAGE       0x100    // wing integrity, master warning, crash state
+#define XRFDR_GROUP_ALL          0x1FF
+
+// Folder relative to the Orbiter root folder in which flight data files are written
+#define XRFDR_OUTPUT_FOLDER "XRFlightData"
+
+// Owned by each XR vessel.  Record() is invoked only from the simulation thread; it never blocks, never allocates, 
+// and never touches the disk.  If the disk cannot keep up, whole blocks are dropped rather than stalling the simulation.
+class XRFlightDataRecorder
+{
+public:
+    XRFlightDataRecorder();
+    virtual ~XRFlightDataRecorder();
+
+    bool Open(const char *pVesselName, const char *pVesselClass, const int channelGroups, const double mjd);
+    void Close();
+    bool IsOpen() const { return (m_pRing != nullptr); }
+    const char *GetFilename() const { return m_filename; }
+    unsigned int GetDroppedBlocks() const { return m_droppedBlocks; }
+
+    // Record one frame; invoked once per frame from the simulation thread.
+    void Record(const XRTelemetryRecord &record)
+    {
+        _ASSERTE(IsOpen());
+        unsigned char *pBlock = m_pRing + ((m_producedBlocks.load(std::memory_order_relaxed) % RING_BLOCKS) * m_blockSize);
+        double *pSimTimes = reinterpret_cast<double *>(pBlock + sizeof(XRFDRBlockHeader));
+        float *pValues = reinterpret_cast<float *>(pSimTimes + XRFDR_BLOCK_FRAMES) + m_frameInBlock;
+
+        pSimTimes[m_frameInBlock] = record.SimTime;
+
+        const unsigned char *pRecord = reinterpret_cast<const unsigned char *>(&record);
+        for (int i = 0; i < m_channelCount; i++, pValues += XRFDR_BLOCK_FRAMES)
+        {
+            const ChannelSource &src = m_sources[i];
+            *pValues = (src.isInt ? static_cast<float>(*reinterpret_cast<const int *>(pRecord + src.offset)) : 
+                                    static_cast<float>(*reinterpret_cast<const double *>(pRecord + src.offset)));
+        }
+
+        if (++m_frameInBlock == XRFDR_BLOCK_FRAMES)
+            CommitBlock();
+    }
+
+protected:
+    static const int RING_BLOCKS = 16;      // blocks buffered in memory for the writer thread
+    static const int GROW_BLOCKS = 64;      // number of blocks by which the output file grows each time it fills up
+
+    struct ChannelSource
+    {
+        size_t offset;      // into XRTelemetryRecord
+        bool isInt;         // true = int field, false = double field
+    };
+
+    void CommitBlock();
+    void WriterThreadMain();
+    bool WriteBlock(const unsigned char *pBlock);
+    bool MapFile(const unsigned long long blockCapacity);
+    void UnmapFile();
+
+    // data used only by the simulation thread
+    ChannelSource m_sources[XRFDR_MAX_CHANNELS];
+    int m_channelCount;
+    size_t m_blockSize;
+    int m_frameInBlock;                 // row in the current block
+    unsigned int m_droppedBlocks;       // blocks discarded because the writer thread fell behind
+    unsigned char *m_pRing;             // RING_BLOCKS * m_blockSize bytes; nullptr = not open
+    char m_filename[MAX_PATH];
+
+    // shared between the simulation thread and the writer thread
+    std::atomic<unsigned long long> m_producedBlocks;   // blocks completed by Record(); the current block is m_producedBlocks % RING_BLOCKS
+    std::atomic<unsigned long long> m_writtenBlocks;    // blocks copied to the file by the writer thread
+    std::atomic<bool> m_stopRequested;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWriter;
+    std::thread m_writerThread;
+
+    // data used only by the writer thread (and by Close once the writer thread has exited)
+    HANDLE m_hFile;
+    HANDLE m_hMapping;
+    unsigned char *m_pView;             // header + blocks
+    unsigned long long m_blockCapacity; // number of blocks that fit in the current mapping
+    unsigned long long m_committedBlocks;   // blocks written to the file; same as the header's BlockCount, but still valid if growing the file failed and the view is gone
+    bool m_writeFailed;                 // true = the output file could not be extended; remaining blocks are discarded
+};
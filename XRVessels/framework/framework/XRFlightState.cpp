@@ -0,0 +1,164 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRFlightState.cpp
+// Per-frame snapshot of a vessel's flight state.
+// ==============================================================
+
+#include "XRFlightState.h"
+#include <stdio.h>
+#include <math.h>
+
+// Constructor
+XRFlightState::XRFlightState() :
+    m_pVessel(nullptr), m_altitude(0), m_airspeed(0), m_groundspeed(0), m_machNumber(0), m_atmPressure(0), m_dynPressure(0),
+    m_pitch(0), m_bank(0), m_aoa(0), m_slipAngle(0), m_groundContact(false), m_angularVel(_V(0, 0, 0)),
+    m_lazyValidFlags(0), m_groundAltitude(0), m_yaw(0), m_horizonAirspeedVector(_V(0, 0, 0)), m_horizonGroundspeedVector(_V(0, 0, 0))
+{
+}
+
+// Capture the vessel's current flight state; invoked by VESSEL3_EXT at the start of each PreStep and PostStep.
+void XRFlightState::Capture(const VESSEL &vessel)
+{
+    m_pVessel = &vessel;
+    m_altitude = vessel.GetAltitude();
+    m_airspeed = vessel.GetAirspeed();
+    m_groundspeed = vessel.GetGroundspeed();
+    m_machNumber = vessel.GetMachNumber();
+    m_atmPressure = vessel.GetAtmPressure();
+    m_dynPressure = vessel.GetDynPressure();
+    m_pitch = vessel.GetPitch();
+    m_bank = vessel.GetBank();
+    m_aoa = vessel.GetAOA();
+    m_slipAngle = vessel.GetSlipAngle();
+    m_groundContact = vessel.GroundContact();
+    vessel.GetAngularVel(m_angularVel);
+
+    m_lazyValidFlags = 0;   // lazy values must be refetched this frame
+}
+
+void XRFlightState::GetAngularVel(VECTOR3 &avel) const
+{
+#ifdef XRFLIGHTSTATE_VERIFY
+    VECTOR3 liveAngularVel;
+    m_pVessel->GetAngularVel(liveAngularVel);
+    VerifyValue("AngularVel", m_angularVel, liveAngularVel);
+#endif
+    avel = m_angularVel;
+}
+
+// Returns altitude in the requested mode; ALTMODE_GROUND is fetched on first use since it requires an elevation lookup.
+double XRFlightState::GetAltitude(const AltitudeMode mode) const
+{
+    if (mode != ALTMODE_GROUND)
+        return GetAltitude();   // mean radius altitude is always captured
+
+    if (!IsLazyValueValid(LV_GROUND_ALTITUDE))
+    {
+        m_groundAltitude = m_pVessel->GetAltitude(ALTMODE_GROUND);
+        m_lazyValidFlags |= LV_GROUND_ALTITUDE;
+    }
+    XRFS_VERIFY("GroundAltitude", m_groundAltitude, m_pVessel->GetAltitude(ALTMODE_GROUND));
+    return m_groundAltitude;
+}
+
+double XRFlightState::GetYaw() const
+{
+    if (!IsLazyValueValid(LV_YAW))
+    {
+        m_yaw = m_pVessel->GetYaw();
+        m_lazyValidFlags |= LV_YAW;
+    }
+    XRFS_VERIFY("Yaw", m_yaw, m_pVessel->GetYaw());
+    return m_yaw;
+}
+
+// Only FRAME_HORIZON is cached since that is what nearly all steps use; other frames are passed through to the core.
+void XRFlightState::GetAirspeedVector(const REFFRAME frame, VECTOR3 &v) const
+{
+    if (frame != FRAME_HORIZON)
+    {
+        m_pVessel->GetAirspeedVector(frame, v);
+        return;
+    }
+
+    if (!IsLazyValueValid(LV_HORIZON_AIRSPEED_VECTOR))
+    {
+        m_pVessel->GetAirspeedVector(FRAME_HORIZON, m_horizonAirspeedVector);
+        m_lazyValidFlags |= LV_HORIZON_AIRSPEED_VECTOR;
+    }
+#ifdef XRFLIGHTSTATE_VERIFY
+    VECTOR3 liveVector;
+    m_pVessel->GetAirspeedVector(FRAME_HORIZON, liveVector);
+    VerifyValue("HorizonAirspeedVector", m_horizonAirspeedVector, liveVector);
+#endif
+    v = m_horizonAirspeedVector;
+}
+
+// Only FRAME_HORIZON is cached since that is what nearly all steps use; other frames are passed through to the core.
+void XRFlightState::GetGroundspeedVector(const REFFRAME frame, VECTOR3 &v) const
+{
+    if (frame != FRAME_HORIZON)
+    {
+        m_pVessel->GetGroundspeedVector(frame, v);
+        return;
+    }
+
+    if (!IsLazyValueValid(LV_HORIZON_GROUNDSPEED_VECTOR))
+    {
+        m_pVessel->GetGroundspeedVector(FRAME_HORIZON, m_horizonGroundspeedVector);
+        m_lazyValidFlags |= LV_HORIZON_GROUNDSPEED_VECTOR;
+    }
+#ifdef XRFLIGHTSTATE_VERIFY
+    VECTOR3 liveVector;
+    m_pVessel->GetGroundspeedVector(FRAME_HORIZON, liveVector);
+    VerifyValue("HorizonGroundspeedVector", m_horizonGroundspeedVector, liveVector);
+#endif
+    v = m_horizonGroundspeedVector;
+}
+
+#ifdef XRFLIGHTSTATE_VERIFY
+// Log a mismatch between a snapshot value and the live core value.  A mismatch means that something changed the
+// vessel's state after the snapshot was captured this frame (e.g., DefSetStateEx), so the caller should read the core directly.
+void XRFlightState::VerifyValue(const char *pName, const double cachedValue, const double liveValue) const
+{
+    static int s_mismatchCount = 0;   // limit log spam
+    const double tolerance = 1e-9 * fmax(1.0, fabs(liveValue));
+    if ((fabs(cachedValue - liveValue) > tolerance) && (s_mismatchCount < 100))
+    {
+        s_mismatchCount++;
+        char msg[256];
+        sprintf(msg, "XRFlightState MISMATCH for %s [%s]: snapshot=%.12lf, live=%.12lf", m_pVessel->GetName(), pName, cachedValue, liveValue);
+        oapiWriteLog(msg);
+        _ASSERTE(false);
+    }
+}
+
+void XRFlightState::VerifyValue(const char *pName, const VECTOR3 &cachedValue, const VECTOR3 &liveValue) const
+{
+    VerifyValue(pName, cachedValue.x, liveValue.x);
+    VerifyValue(pName, cachedValue.y, liveValue.y);
+    VerifyValue(pName, cachedValue.z, liveValue.z);
+}
+#endif
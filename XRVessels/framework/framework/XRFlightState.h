@@ -0,0 +1,103 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRFlightState.h
+// Per-frame snapshot of a vessel's flight state.  VESSEL3_EXT captures this
+// once at the start of clbkPreStep and again at the start of clbkPostStep, so
+// PreStep and PostStep objects can read these values without each one calling
+// into the Orbiter core.  Rarely used values are fetched lazily on first use.
+//
+// Define XRFLIGHTSTATE_VERIFY in the project to compare every value read from
+// the snapshot against a live core call and log any mismatches.
+// ==============================================================
+
+#pragma once
+
+#include "Orbitersdk.h"
+
+#ifdef XRFLIGHTSTATE_VERIFY
+#define XRFS_VERIFY(pName, cachedValue, liveValue) VerifyValue(pName, cachedValue, liveValue)
+#else
+#define XRFS_VERIFY(pName, cachedValue, liveValue)
+#endif
+
+class XRFlightState
+{
+public:
+    XRFlightState();
+
+    void Capture(const VESSEL &vessel);
+    bool IsValid() const { return (m_pVessel != nullptr); }   // false until the first Capture
+
+    // values captured each frame
+    double GetAltitude() const      { XRFS_VERIFY("Altitude", m_altitude, m_pVessel->GetAltitude()); return m_altitude; }  // ALTMODE_MEANRAD
+    double GetAirspeed() const      { XRFS_VERIFY("Airspeed", m_airspeed, m_pVessel->GetAirspeed()); return m_airspeed; }
+    double GetGroundspeed() const   { XRFS_VERIFY("Groundspeed", m_groundspeed, m_pVessel->GetGroundspeed()); return m_groundspeed; }
+    double GetMachNumber() const    { XRFS_VERIFY("MachNumber", m_machNumber, m_pVessel->GetMachNumber()); return m_machNumber; }
+    double GetAtmPressure() const   { XRFS_VERIFY("AtmPressure", m_atmPressure, m_pVessel->GetAtmPressure()); return m_atmPressure; }
+    double GetDynPressure() const   { XRFS_VERIFY("DynPressure", m_dynPressure, m_pVessel->GetDynPressure()); return m_dynPressure; }
+    double GetPitch() const         { XRFS_VERIFY("Pitch", m_pitch, m_pVessel->GetPitch()); return m_pitch; }
+    double GetBank() const          { XRFS_VERIFY("Bank", m_bank, m_pVessel->GetBank()); return m_bank; }
+    double GetAOA() const           { XRFS_VERIFY("AOA", m_aoa, m_pVessel->GetAOA()); return m_aoa; }
+    double GetSlipAngle() const     { XRFS_VERIFY("SlipAngle", m_slipAngle, m_pVessel->GetSlipAngle()); return m_slipAngle; }
+    bool GroundContact() const      { XRFS_VERIFY("GroundContact", m_groundContact, m_pVessel->GroundContact()); return m_groundContact; }
+    void GetAngularVel(VECTOR3 &avel) const;
+
+    // values fetched from the core on first use each frame
+    double GetAltitude(const AltitudeMode mode) const;
+    double GetYaw() const;
+    void GetAirspeedVector(const REFFRAME frame, VECTOR3 &v) const;
+    void GetGroundspeedVector(const REFFRAME frame, VECTOR3 &v) const;
+
+protected:
+#ifdef XRFLIGHTSTATE_VERIFY
+    void VerifyValue(const char *pName, const double cachedValue, const double liveValue) const;
+    void VerifyValue(const char *pName, const VECTOR3 &cachedValue, const VECTOR3 &liveValue) const;
+#endif
+
+    // bits in m_lazyValidFlags
+    enum LazyValue { LV_GROUND_ALTITUDE = 0x01, LV_YAW = 0x02, LV_HORIZON_AIRSPEED_VECTOR = 0x04, LV_HORIZON_GROUNDSPEED_VECTOR = 0x08 };
+    bool IsLazyValueValid(const LazyValue value) const { return ((m_lazyValidFlags & value) != 0); }
+
+    const VESSEL *m_pVessel;        // vessel we captured; null until the first Capture
+    double m_altitude;
+    double m_airspeed;
+    double m_groundspeed;
+    double m_machNumber;
+    double m_atmPressure;
+    double m_dynPressure;
+    double m_pitch;
+    double m_bank;
+    double m_aoa;
+    double m_slipAngle;
+    bool m_groundContact;
+    VECTOR3 m_angularVel;
+
+    // lazy values; only valid if their bit is set in m_lazyValidFlags
+    mutable unsigned int m_lazyValidFlags;
+    mutable double m_groundAltitude;
+    mutable double m_yaw;
+    mutable VECTOR3 m_horizonAirspeedVector;
+    mutable VECTOR3 m_horizonGroundspeedVector;
+};
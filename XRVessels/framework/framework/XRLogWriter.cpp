@@ -0,0 +1,241 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRLogWriter.cpp
+// Shared, asynchronous writer for an XR log file.
+// ==============================================================
+
+#include "XRLogWriter.h"
+#include <string.h>
+#include <ctype.h>
+
+std::unordered_map<std::string, XRLogWriter *> XRLogWriter::s_writers;
+
+const int XRLogWriter::QUEUE_SLOTS;
+const int XRLogWriter::WRITER_BATCH_MESSAGES;
+const int XRLogWriter::FLUSH_INTERVAL_MS;
+
+// Returns the log writer for the supplied file, opening the file and starting its writer thread if this is the
+// first request for it in this DLL; all vessels that log to the same file share one writer.
+//   pFilename = path to the log file; may be relative to Orbiter root or absolute
+// Returns: log writer, or nullptr if the file could not be opened
+XRLogWriter *XRLogWriter::Open(const char *pFilename)
+{
+    std::string key(pFilename);
+    for (char &c : key)
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+
+    const auto it = s_writers.find(key);
+    if (it != s_writers.end())
+        return it->second;
+
+    // open the log file in APPEND and SHARED mode so we can share it with other processes
+    FILE *pFile = fopen(pFilename, "a+t");
+    if (pFile == nullptr)
+        return nullptr;
+
+    XRLogWriter *pWriter = new XRLogWriter(pFile);
+    s_writers[key] = pWriter;
+    return pWriter;
+}
+
+// Write all queued messages to disk, close all log files, and stop all writer threads.  Clients must invoke
+// this from the module's ExitModule method: threads cannot be joined safely once the DLL is being unloaded,
+// and no writer may be used after this returns.
+void XRLogWriter::Terminate()
+{
+    for (auto it = s_writers.begin(); it != s_writers.end(); it++)
+        delete it->second;
+
+    s_writers.clear();
+}
+
+// Constructor
+// pFile = open log file; we take ownership of it
+XRLogWriter::XRLogWriter(FILE *pFile) :
+    m_pSlots(new Slot[QUEUE_SLOTS]), m_dequeueTicket(0), m_pFile(pFile)
+{
+    for (int i = 0; i < QUEUE_SLOTS; i++)
+        m_pSlots[i].sequence.store(i, std::memory_order_relaxed);
+
+    m_enqueueTicket.store(0, std::memory_order_relaxed);
+    m_droppedMessages.store(0, std::memory_order_relaxed);
+    m_stopRequested.store(false, std::memory_order_relaxed);
+    m_writerThread = std::thread(&XRLogWriter::WriterThreadMain, this);
+}
+
+// Destructor: waits for the writer thread to write all queued messages
+XRLogWriter::~XRLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested.store(true, std::memory_order_relaxed);
+    }
+    m_wakeWriter.notify_one();
+    m_writerThread.join();
+
+    // the writer thread has exited, so we own the file now
+    WriteQueuedMessages();
+    fclose(m_pFile);
+    delete[] m_pSlots;
+}
+
+// Queue a message to be logged; may be invoked from any thread.  This never blocks: if the queue is full, the
+// message is dropped and counted rather than stalling the caller until the writer thread catches up.
+//   pPrefix = shown in brackets before the message, e.g., "[XR2-01] "; if null or empty, no prefix is shown
+//   pMsg = message to log; will be truncated to fit in XRLOG_MAX_MESSAGE_LENGTH
+void XRLogWriter::Write(const char *pPrefix, const char *pMsg)
+{
+    // claim a ticket for a free slot
+    size_t ticket = m_enqueueTicket.load(std::memory_order_relaxed);
+    Slot *pSlot;
+    for (;;)
+    {
+        pSlot = m_pSlots + (ticket & (QUEUE_SLOTS - 1));
+        const intptr_t diff = static_cast<intptr_t>(pSlot->sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(ticket);
+        if (diff == 0)
+        {
+            if (m_enqueueTicket.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed))
+                break;      // the slot is ours
+            // else another producer claimed this ticket first; ticket now holds the next one to try
+        }
+        else if (diff < 0)
+        {
+            // the queue is full
+            m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            m_wakeWriter.notify_one();
+            return;
+        }
+        else
+        {
+            ticket = m_enqueueTicket.load(std::memory_order_relaxed);   // another producer claimed this ticket first
+        }
+    }
+
+    // The timestamp is converted to local time by the writer thread; GetLocalTime is much slower.
+    GetSystemTimeAsFileTime(&pSlot->time);
+
+    char *pOut = pSlot->text;
+    const char *const pLast = pSlot->text + (XRLOG_MAX_MESSAGE_LENGTH - 1);   // reserved for the terminator
+    if ((pPrefix != nullptr) && (*pPrefix != 0))
+    {
+        *pOut++ = '[';
+        for (const char *p = pPrefix; (*p != 0) && (pOut < pLast); p++)
+            *pOut++ = *p;
+        for (const char *p = "] "; (*p != 0) && (pOut < pLast); p++)
+            *pOut++ = *p;
+    }
+    for (const char *p = pMsg; (*p != 0) && (pOut < pLast); p++)
+        *pOut++ = *p;
+    *pOut = 0;
+
+    pSlot->sequence.store(ticket + 1, std::memory_order_release);   // hand the slot to the writer thread
+
+    // the writer also polls, so a missed wakeup only delays the write
+    if (((ticket + 1) % WRITER_BATCH_MESSAGES) == 0)
+        m_wakeWriter.notify_one();
+}
+
+// Writer thread: writes queued messages in batches until the writer is destroyed
+void XRLogWriter::WriterThreadMain()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWriter.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [this]
+            {
+                return m_stopRequested.load(std::memory_order_relaxed) ||
+                    ((m_enqueueTicket.load(std::memory_order_relaxed) - m_dequeueTicket) >= WRITER_BATCH_MESSAGES);
+            });
+        }
+
+        // always drain queued messages before exiting
+        WriteQueuedMessages();
+
+        if (m_stopRequested.load(std::memory_order_relaxed))
+            break;
+    }
+}
+
+// Write each queued message in order to the debug console and the log file, then flush the file once for the
+// whole batch so that the messages survive a crash; invoked only from the writer thread or from the destructor.
+// Returns: true if any messages were written
+bool XRLogWriter::WriteQueuedMessages()
+{
+    bool wroteMessages = false;
+    for (;;)
+    {
+        Slot &slot = m_pSlots[m_dequeueTicket & (QUEUE_SLOTS - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != (m_dequeueTicket + 1))
+            break;  // queue is empty, or the producer of the next message has not finished copying it yet
+
+        FILETIME localTime;
+        SYSTEMTIME st;
+        FileTimeToLocalFileTime(&slot.time, &localTime);
+        FileTimeToSystemTime(&localTime, &st);
+
+        char line[XRLOG_MAX_MESSAGE_LENGTH + 32];   // allow room for the timestamp
+        _snprintf(line, sizeof(line) - 1, "%02d.%02d.%04d %02d:%02d:%02d.%03d - %s\n",
+            st.wMonth, st.wDay, st.wYear,
+            st.wHour, st.wMinute, st.wSecond, st.wMilliseconds,
+            slot.text);
+        line[sizeof(line) - 1] = 0;
+
+        // no point in checking for error here
+        OutputDebugString(line);   // send to debug console
+        fwrite(line, 1, strlen(line), m_pFile);
+
+        slot.sequence.store(m_dequeueTicket + QUEUE_SLOTS, std::memory_order_release);  // free the slot for ticket + QUEUE_SLOTS
+        m_dequeueTicket++;
+        wroteMessages = true;
+    }
+
+    // report any messages that were dropped since the last batch
+    const size_t droppedMessages = m_droppedMessages.exchange(0, std::memory_order_relaxed);
+    if (droppedMessages > 0)
+    {
+        FILETIME time, localTime;
+        SYSTEMTIME st;
+        GetSystemTimeAsFileTime(&time);
+        FileTimeToLocalFileTime(&time, &localTime);
+        FileTimeToSystemTime(&localTime, &st);
+
+        char line[128];
+        _snprintf(line, sizeof(line) - 1, "%02d.%02d.%04d %02d:%02d:%02d.%03d - WARNING: %u log messages dropped because the log queue was full\n",
+            st.wMonth, st.wDay, st.wYear,
+            st.wHour, st.wMinute, st.wSecond, st.wMilliseconds,
+            static_cast<unsigned int>(droppedMessages));
+        line[sizeof(line) - 1] = 0;
+
+        OutputDebugString(line);
+        fwrite(line, 1, strlen(line), m_pFile);
+        wroteMessages = true;
+    }
+
+    if (wroteMessages)
+        fflush(m_pFile);
+
+    return wroteMessages;
+}
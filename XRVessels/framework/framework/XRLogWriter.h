@@ -0,0 +1,91 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRLogWriter.h
+// Shared, asynchronous writer for an XR log file.  Any thread may log a
+// message: Write() timestamps it and copies it into a lock-free queue, and
+// a background thread formats the queued messages, writes them to the file
+// and the debug console, and flushes the file once per batch.  The writer
+// wakes every WRITER_BATCH_MESSAGES messages or every FLUSH_INTERVAL_MS
+// milliseconds, whichever comes first.  Write() never waits for the writer:
+// a message that arrives while the queue is full is dropped, and the number
+// of dropped messages is logged with the next batch.
+// ==============================================================
+
+#pragma once
+
+#include <windows.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <unordered_map>
+
+#define XRLOG_MAX_MESSAGE_LENGTH 1024   // includes the vessel prefix and the terminating null; longer messages are truncated
+
+class XRLogWriter
+{
+public:
+    static XRLogWriter *Open(const char *pFilename);
+    static void Terminate();
+
+    void Write(const char *pPrefix, const char *pMsg);
+
+protected:
+    static const int QUEUE_SLOTS = 512;             // must be a power of two
+    static const int WRITER_BATCH_MESSAGES = 64;    // wake the writer thread early once this many messages have been queued
+    static const int FLUSH_INTERVAL_MS = 200;       // maximum time a message waits in the queue
+
+    XRLogWriter(FILE *pFile);
+    virtual ~XRLogWriter();
+
+    void WriterThreadMain();
+    bool WriteQueuedMessages();
+
+    // One queued message.  A slot is free for the producer that claims ticket N when sequence == N, and it holds
+    // a message ready for the writer when sequence == N + 1.
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        FILETIME time;      // UTC; converted to local time by the writer thread
+        char text[XRLOG_MAX_MESSAGE_LENGTH];
+    };
+
+    // all log writers in this DLL, keyed by lowercase filename; accessed only from the simulation thread
+    static std::unordered_map<std::string, XRLogWriter *> s_writers;
+
+    Slot *m_pSlots;                         // QUEUE_SLOTS entries
+    std::atomic<size_t> m_enqueueTicket;    // next ticket to be claimed by a producer
+    std::atomic<size_t> m_droppedMessages;  // messages dropped because the queue was full since the writer last logged the count
+    size_t m_dequeueTicket;                 // next ticket to be written; used only by the writer thread
+
+    std::atomic<bool> m_stopRequested;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWriter;
+    std::thread m_writerThread;
+
+    FILE *m_pFile;                          // used only by the writer thread (and by the destructor once the writer thread has exited)
+};
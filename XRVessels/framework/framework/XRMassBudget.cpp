@@ -0,0 +1,80 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRMassBudget.cpp
+// Tracks the items that make up a vessel's empty mass.
+// ==============================================================
+
+#include "XRMassBudget.h"
+#include <math.h>
+
+// Smaller changes are not sent to Orbiter; consumables such as LOX change by a few grams per second, and there is
+// no point in updating the vessel's mass every frame for that.
+const double XRMassBudget::PUSH_THRESHOLD = 1e-3;
+
+// Constructor
+// itemCount = number of items in the budget; each item starts at zero mass
+XRMassBudget::XRMassBudget(const int itemCount) :
+    m_itemMasses(itemCount, 0.0), m_totalMass(0), m_pushedMass(0), m_isPushForced(true)
+{
+}
+
+// Set the mass of one item in the budget and adjust the total mass by the change
+//   index = 0...itemCount-1
+//   mass = new mass of this item in kg
+void XRMassBudget::SetItemMass(const int index, const double mass)
+{
+    double &itemMass = m_itemMasses[index];
+    m_totalMass += (mass - itemMass);
+    itemMass = mass;
+}
+
+// Returns the sum of all item masses; this is what GetTotalMass tracks
+double XRMassBudget::RecomputeTotalMass() const
+{
+    double totalMass = 0;
+    for (size_t i = 0; i < m_itemMasses.size(); i++)
+        totalMass += m_itemMasses[i];
+
+    return totalMass;
+}
+
+// Returns true if the total mass should be sent to Orbiter; i.e., it has moved more than PUSH_THRESHOLD since the last Push
+bool XRMassBudget::IsPushRequired() const
+{
+    return (m_isPushForced || (fabs(m_totalMass - m_pushedMass) > PUSH_THRESHOLD));
+}
+
+// Latch the total mass as the mass sent to Orbiter.  The running total is recomputed here so that rounding
+// errors in the item deltas never accumulate.
+// Returns: total mass in kg, which the caller must send to Orbiter
+double XRMassBudget::Push()
+{
+    m_totalMass = RecomputeTotalMass();
+    m_pushedMass = m_totalMass;
+    m_isPushForced = false;
+
+    return m_totalMass;
+}
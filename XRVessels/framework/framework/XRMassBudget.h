@@ -0,0 +1,60 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRMassBudget.h
+// Tracks the items that make up a vessel's empty mass: structure, crew,
+// consumables, payload, etc.  The code that changes an item reports the
+// item's new mass, and the budget adjusts its running total by the
+// difference, so the total is available without walking every mass source.
+// The owner sends the total to Orbiter only when it has moved more than
+// PUSH_THRESHOLD kg since it was last sent.
+// ==============================================================
+
+#pragma once
+
+#include <vector>
+
+class XRMassBudget
+{
+public:
+    static const double PUSH_THRESHOLD;     // in kg
+
+    XRMassBudget(const int itemCount);
+
+    void SetItemMass(const int index, const double mass);
+    double GetItemMass(const int index) const  { return m_itemMasses[index]; }
+    double GetTotalMass() const                { return m_totalMass; }
+    double RecomputeTotalMass() const;
+
+    bool IsPushRequired() const;
+    double Push();
+    void Invalidate()                          { m_isPushForced = true; }  // the next IsPushRequired call returns true; e.g., if Orbiter's empty mass was set elsewhere
+
+protected:
+    std::vector<double> m_itemMasses;   // in kg; indexed by the owner's item enum
+    double m_totalMass;                 // running total; may differ from the sum of m_itemMasses by rounding error until the next Push
+    double m_pushedMass;                // total as of the last Push
+    bool m_isPushForced;                // true = no total has been pushed since the budget was created or invalidated
+};
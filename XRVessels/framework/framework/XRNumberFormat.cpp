@@ -0,0 +1,187 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRNumberFormat.cpp
+// Fast, locale-free number formatting for panel and HUD text.
+// ==============================================================
+
+#include "XRNumberFormat.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+// Indexed by XR_UNIT.  The "\xB0" escapes are split from the following letter so that it is not parsed as another hex digit.
+const char *const XRNumberFormat::s_unitSuffixes[static_cast<int>(XR_UNIT::COUNT)] =
+{
+    "",
+    " m", " km", " mm", " gm",
+    " ft", " mi", " mmi", " gmi",
+    " \xB0" "K", " \xB0" "C", " \xB0" "F",
+    "\xB0",
+    " m/s", " fps", " mph", " Mach",
+    " m/s\xB2", " fps\xB2", " G",
+    " kPa", " psi",
+    " kg", " lb",
+    " N", " kN", " kLb"
+};
+
+// Scaled values at or above this are formatted by _snprintf; it keeps every value we format ourselves well
+// inside the range where a double holds each integer exactly.
+static const double FAST_PATH_LIMIT = 1e15;
+
+static const double s_powersOf10[XRNumberFormat::MAX_DECIMALS + 1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+static const unsigned long long s_intPowersOf10[XRNumberFormat::MAX_DECIMALS + 1] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL };
+
+// Equivalent to sprintf(pOut, "%*.*f%s", width, decimals, value, pSuffix), or "%+*.*f%s" if prependPlus is true.
+//   width = minimum width of the number, excluding the suffix; the number is padded on the left with spaces,
+//           or on the right if width is negative, as with sprintf's "*" width
+//   pSuffix = appended as-is after the number; may be null
+int XRNumberFormat::FormatDouble(char *pOut, const size_t bufferSize, const double value, const int decimals, const int width, const bool prependPlus, const char *pSuffix)
+{
+    if ((decimals < 0) || (decimals > MAX_DECIMALS) || !isfinite(value))
+        return FormatDoubleSlow(pOut, bufferSize, value, decimals, width, prependPlus, pSuffix);
+
+    // Work in units of the last decimal place.  The multiply is exact to within half a unit in the last
+    // place of scaled, so unless the fraction lies within that distance of 0.5 it rounds the same way the
+    // exact decimal expansion that sprintf rounds would.  Ties are left to the CRT, since CRTs differ on
+    // how they break them.
+    const double scaled = fabs(value) * s_powersOf10[decimals];
+    if (scaled >= FAST_PATH_LIMIT)
+        return FormatDoubleSlow(pOut, bufferSize, value, decimals, width, prependPlus, pSuffix);
+
+    unsigned long long digits = static_cast<unsigned long long>(scaled);
+    const double fraction = scaled - static_cast<double>(digits);   // exact
+    if (fabs(fraction - 0.5) <= (scaled * DBL_EPSILON))
+        return FormatDoubleSlow(pOut, bufferSize, value, decimals, width, prependPlus, pSuffix);
+
+    if (fraction > 0.5)
+        digits++;
+
+    // build the number from right to left
+    char number[32];
+    char *const pEnd = number + sizeof(number);
+    char *p = pEnd;
+
+    unsigned long long wholePart = digits / s_intPowersOf10[decimals];
+    unsigned long long fractionPart = digits % s_intPowersOf10[decimals];
+    if (decimals > 0)
+    {
+        for (int i = 0; i < decimals; i++)
+        {
+            *--p = static_cast<char>('0' + (fractionPart % 10));
+            fractionPart /= 10;
+        }
+        *--p = '.';
+    }
+
+    do
+    {
+        *--p = static_cast<char>('0' + (wholePart % 10));
+        wholePart /= 10;
+    } while (wholePart > 0);
+
+    // sprintf shows the sign of negative values that round to zero, e.g., "-0.00"
+    if (signbit(value))
+        *--p = '-';
+    else if (prependPlus)
+        *--p = '+';
+
+    return Finish(pOut, bufferSize, p, static_cast<int>(pEnd - p), width, pSuffix);
+}
+
+// Equivalent to sprintf(pOut, "%*d", width, value), or "%0*d" if zeroPad is true
+int XRNumberFormat::FormatInt(char *pOut, const size_t bufferSize, const int value, const int width, const bool zeroPad)
+{
+    char number[32];
+    char *const pEnd = number + sizeof(number);
+    char *p = pEnd;
+
+    // negate as unsigned so that INT_MIN does not overflow
+    unsigned int magnitude = ((value < 0) ? (0U - static_cast<unsigned int>(value)) : static_cast<unsigned int>(value));
+    do
+    {
+        *--p = static_cast<char>('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (zeroPad && (width > 0))     // sprintf ignores the zero flag for left-justified values
+    {
+        // the sign counts toward the width; leave room for it in the buffer
+        const int signWidth = ((value < 0) ? 1 : 0);
+        while (((pEnd - p) + signWidth < width) && (p > number + 1))
+            *--p = '0';
+    }
+
+    if (value < 0)
+        *--p = '-';
+
+    return Finish(pOut, bufferSize, p, static_cast<int>(pEnd - p), width, nullptr);
+}
+
+// Format a value that the fast path cannot format exactly
+int XRNumberFormat::FormatDoubleSlow(char *pOut, const size_t bufferSize, const double value, const int decimals, const int width, const bool prependPlus, const char *pSuffix)
+{
+    char number[512];   // large enough for DBL_MAX with a sane number of decimals
+    _snprintf(number, sizeof(number) - 1, (prependPlus ? "%+.*f" : "%.*f"), decimals, value);
+    number[sizeof(number) - 1] = 0;     // _snprintf does not terminate the string if it is truncated
+
+    return Finish(pOut, bufferSize, number, static_cast<int>(strlen(number)), width, pSuffix);
+}
+
+// Pad pNumber with spaces to width (on the right if width is negative), append pSuffix, and copy the result to pOut, truncating it if necessary.
+// Returns: length of the string in pOut
+int XRNumberFormat::Finish(char *pOut, const size_t bufferSize, const char *pNumber, const int numberLength, const int width, const char *pSuffix)
+{
+    if (bufferSize == 0)
+        return 0;   // no room for anything, not even the terminator
+
+    const size_t maxLength = bufferSize - 1;
+    const int padding = abs(width) - numberLength;
+    size_t length = 0;
+    if (width > 0)
+    {
+        for (int i = 0; (i < padding) && (length < maxLength); i++)
+            pOut[length++] = ' ';
+    }
+
+    for (int i = 0; (i < numberLength) && (length < maxLength); i++)
+        pOut[length++] = pNumber[i];
+
+    if (width < 0)
+    {
+        for (int i = 0; (i < padding) && (length < maxLength); i++)
+            pOut[length++] = ' ';
+    }
+
+    if (pSuffix != nullptr)
+    {
+        for (const char *p = pSuffix; (*p != 0) && (length < maxLength); p++)
+            pOut[length++] = *p;
+    }
+
+    pOut[length] = 0;
+    return static_cast<int>(length);
+}
@@ -0,0 +1,79 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRNumberFormat.h
+// Fast, locale-free number formatting for panel and HUD text that is
+// rebuilt every frame.  FormatDouble produces exactly the same text as
+// sprintf("%*.*f") and FormatInt the same text as sprintf("%*d") or
+// sprintf("%0*d"), without parsing a format string.  Values that cannot be
+// formatted exactly in integer arithmetic (very large values, values that
+// lie on a rounding tie, NaN, and infinity) are passed to _snprintf, so the
+// output never differs from what the old sprintf calls produced.
+// ==============================================================
+
+#pragma once
+
+#include <stddef.h>
+
+// Unit suffixes shared by the HUDs and panels; each includes its leading space, if any.
+// The degree, squared, and other non-ASCII characters are in the panel fonts' Latin-1 code page.
+enum class XR_UNIT
+{
+    NONE,           // no suffix
+    METERS, KILOMETERS, MEGAMETERS, GIGAMETERS,
+    FEET, MILES, MEGAMILES, GIGAMILES,
+    KELVIN, CELSIUS, FAHRENHEIT,
+    DEGREES,        // angle; no leading space
+    METERS_PER_SEC, FEET_PER_SEC, MPH, MACH,
+    METERS_PER_SEC2, FEET_PER_SEC2, G,
+    KPA, PSI,
+    KG, POUNDS,
+    NEWTONS, KILONEWTONS, KILOPOUNDS,
+    COUNT           // not a unit: number of units
+};
+
+class XRNumberFormat
+{
+public:
+    static const int MAX_DECIMALS = 9;      // values with more decimals than this are passed to _snprintf
+
+    // Each method writes a null-terminated string to pOut and returns its length, as sprintf does.
+    // A negative width left-justifies the number, as it does for sprintf's "*" width.
+    // If bufferSize is too small the text is truncated to (bufferSize - 1) characters.
+    static int FormatDouble(char *pOut, const size_t bufferSize, const double value, const int decimals, const int width = 0, const bool prependPlus = false, const char *pSuffix = nullptr);
+    static int FormatDouble(char *pOut, const size_t bufferSize, const double value, const int decimals, const XR_UNIT unit, const bool prependPlus = false)
+    {
+        return FormatDouble(pOut, bufferSize, value, decimals, 0, prependPlus, GetUnitSuffix(unit));
+    }
+
+    static int FormatInt(char *pOut, const size_t bufferSize, const int value, const int width = 0, const bool zeroPad = false);
+
+    static const char *GetUnitSuffix(const XR_UNIT unit) { return s_unitSuffixes[static_cast<int>(unit)]; }
+
+protected:
+    static int FormatDoubleSlow(char *pOut, const size_t bufferSize, const double value, const int decimals, const int width, const bool prependPlus, const char *pSuffix);
+    static int Finish(char *pOut, const size_t bufferSize, const char *pNumber, const int numberLength, const int width, const char *pSuffix);
+
+    static const char *const s_unitSuffixes[static_cast<int>(XR_UNIT::COUNT)];
+};
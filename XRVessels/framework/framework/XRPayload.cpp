@@ -28,6 +28,7 @@
 #include "VesselAPI.h"
 #include "XRPayloadBay.h"
 #include "FileList.h"
+#include "XRPayloadThumbnailCache.h"
 #include <string>
 #include <string.h>
 
@@ -58,7 +59,8 @@ const XRPayloadClassData &XRPayloadClassData::GetXRPayloadClassDataForClassname(
     XRPayloadClassData *pRetVal = nullptr;
 
     // pull the data from cache, which was already pre-populated with all .cfg files in the system
-    auto it = s_classnameToXRPayloadClassDataMap.find(&string(pClassname));
+    const string classname(pClassname);
+    auto it = s_classnameToXRPayloadClassDataMap.find(&classname);
     if (it != s_classnameToXRPayloadClassDataMap.end())
     {
         // object is in cache: return it
@@ -67,7 +69,8 @@ const XRPayloadClassData &XRPayloadClassData::GetXRPayloadClassDataForClassname(
     else   // something goofy is going on: there is no .cfg for this vessel under Config\Vessels
     {
         // return the default PCD 
-        pRetVal = s_classnameToXRPayloadClassDataMap.find(&string(XRPAYLOAD_BAY_CLASSNAME))->second;  // will always succeed
+        const string bayClassname(XRPAYLOAD_BAY_CLASSNAME);
+        pRetVal = s_classnameToXRPayloadClassDataMap.find(&bayClassname)->second;  // will always succeed
     }
 
     return *pRetVal;
@@ -92,6 +95,13 @@ void XRPayloadClassData::Terminate()
 
     // delete the static s_allXRPayloadEnabledClassData array
     delete s_allXRPayloadEnabledClassData;      // do not use 'delete []' here; objects in the array were already freed above
+
+    // reset the cache so that a later InitializeXRPayloadClassData rescans the .cfg files instead of using freed data
+    s_classnameToXRPayloadClassDataMap.clear();
+    s_allXRPayloadEnabledClassData = nullptr;
+
+    // stop the thumbnail loader thread and free any thumbnails it decoded
+    XRPayloadThumbnailCache::GetInstance().Terminate();
 }
 
 // Payload vessles MUST invoke this static method before the simulation begins (typically from clbkPostCreation) so that all Orbiter vessel .cfg files are parsed.
@@ -147,8 +157,7 @@ void XRPayloadClassData::InitializeXRPayloadClassData()
 // is parsed for custom configuration data.
 // pConfigFilespec = path\filename under $ORBITER_HOME\Config of filename; e.g., "Vessels\XRParts.cfg".
 // pClassname = vessel classname to which this payload object is tied; e.g., "XRParts", "UCGO\foo", etc.
-XRPayloadClassData::XRPayloadClassData(const char *pConfigFilespec, const char *pClassname) :
-    m_hThumbnailBitmap(nullptr)
+XRPayloadClassData::XRPayloadClassData(const char *pConfigFilespec, const char *pClassname)
 {
     m_pClassname = _strdup(pClassname);
     m_pConfigFilespec = _strdup(pConfigFilespec);
@@ -247,19 +256,9 @@ XRPayloadClassData::XRPayloadClassData(const char *pConfigFilespec, const char *
                          m_dimensions.z / PAYLOAD_SLOT_DIMENSIONS.z);
 
 
-    // load the thumbnail and save a handle to it
-    // Note: our default path here is the Orbiter root directory: i.e., the directory from which
-    // Orbiter.exe is running.
-    static char pFullThumbnailPath[1024];    
-    sprintf(pFullThumbnailPath, "Config\\%s", pThumbnailPath);
-    m_hThumbnailBitmap = (HBITMAP)LoadImage(0, pFullThumbnailPath, IMAGE_BITMAP, PAYLOAD_THUMBNAIL_DIMX, PAYLOAD_THUMBNAIL_DIMY, LR_LOADFROMFILE);  // will be null if load failed
-    if (m_hThumbnailBitmap == nullptr)
-    {
-        // Bad thumbnail path!  Switch to the default thumbnail.
-        // Note: it is too early for oapiDebugString() to work, and we don't have access to the XR log, so we don't bother logging a message here.
-        sprintf(pFullThumbnailPath, "Config\\%s", DEFAULT_PAYLOAD_THUMBNAIL_PATH);  // reset to default thumbnail
-        m_hThumbnailBitmap = (HBITMAP)LoadImage(0, pFullThumbnailPath, IMAGE_BITMAP, PAYLOAD_THUMBNAIL_DIMX, PAYLOAD_THUMBNAIL_DIMY, LR_LOADFROMFILE);  // will be null if load failed, but default should always succeed
-    }
+    // Save the thumbnail path only: most thumbnails are never displayed, so the bitmap is not loaded until
+    // a payload dialog or screen asks for it.  If the path is invalid the default thumbnail is shown instead.
+    m_pThumbnailPath = _strdup(pThumbnailPath);
 }
 
 // Destructor
@@ -283,9 +282,7 @@ XRPayloadClassData::~XRPayloadClassData()
         delete pSlotList;
     }
 
-    // free the thumbnail bitmap, if any
-    if (m_hThumbnailBitmap != nullptr)
-        DeleteObject(m_hThumbnailBitmap);
+    free(m_pThumbnailPath);
 }
 
 // Add an explicit attachment point to which this object may dock.
@@ -296,7 +293,8 @@ void XRPayloadClassData::AddExplicitAttachmentSlot(const char *pParentVesselClas
 {
     vector<int> *pSlotList = nullptr;  // assume not found
     
-    auto it = m_explicitAttachmentSlotsMap.find(&string(pParentVesselClassname));
+    const string parentVesselClassname(pParentVesselClassname);
+    auto it = m_explicitAttachmentSlotsMap.find(&parentVesselClassname);
     
     // did we find an existing slot list of the specified vessel class?
     if (it != m_explicitAttachmentSlotsMap.end())
@@ -319,16 +317,27 @@ void XRPayloadClassData::AddExplicitAttachmentSlot(const char *pParentVesselClas
 // Returns true if any explicit bay slots are defined for the specified vessel classname.
 bool XRPayloadClassData::AreAnyExplicitAttachmentSlotsDefined(const char *pParentVesselClassname) const
 {
-    auto it = m_explicitAttachmentSlotsMap.find(&string(pParentVesselClassname));
+    const string parentVesselClassname(pParentVesselClassname);
+    auto it = m_explicitAttachmentSlotsMap.find(&parentVesselClassname);
     return (it != m_explicitAttachmentSlotsMap.end());
 }
 
+// Returns the thumbnail bitmap for this payload, loading it in the background on first access.
+// Until the bitmap is decoded (or if its path is invalid) this returns the default payload thumbnail, so
+// callers should re-query this each time they render.  Do not cache the returned handle: it is freed
+// when the thumbnail is evicted from the cache.
+HBITMAP XRPayloadClassData::GetThumbnailBitmapHandle() const
+{
+    return XRPayloadThumbnailCache::GetInstance().GetThumbnail(m_pThumbnailPath);
+}
+
 // Returns true if the specified attachment slot in the bay is explicitly allowed for the specified vessel classname.
 bool XRPayloadClassData::IsExplicitAttachmentSlotAllowed(const char *pParentVesselClassname, int slotNumber) const
 {
     bool retVal = true;     // assume vessel not found
 
-    auto it = m_explicitAttachmentSlotsMap.find(&string(pParentVesselClassname));
+    const string parentVesselClassname(pParentVesselClassname);
+    auto it = m_explicitAttachmentSlotsMap.find(&parentVesselClassname);
     if (it != m_explicitAttachmentSlotsMap.end())
     {
         retVal = false;     // slot denied now unless explicitly found in the slot list below
@@ -362,7 +371,7 @@ const XRPayloadClassData **XRPayloadClassData::GetAllAvailableXRPayloads()
         VECTOR_XRPAYLOAD allXRPayloads;
 
         // Walk through each XRPayloadClassData in our s_classnameToXRPayloadClassDataMap and copy all XRPayload-enabled ones to our master s_allXRPayloadEnabledClassData 
-        unordered_map<const string *, XRPayloadClassData *>::const_iterator it = s_classnameToXRPayloadClassDataMap.begin();  // iterate over values
+        HASHMAP_STR_XRPAYLOAD::const_iterator it = s_classnameToXRPayloadClassDataMap.begin();  // iterate over values
         for (; it != s_classnameToXRPayloadClassDataMap.end(); it++)
         {
             const XRPayloadClassData *pPCD = it->second;  // get next PCD
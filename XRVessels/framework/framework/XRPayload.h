@@ -83,7 +83,8 @@ public:
     bool IsXRConsumableTank() const          { return m_isXRConsumableTank; }
     double GetMass() const                   { return m_mass; }
     const VECTOR3 &GetGroundDeploymentAdjustment() const { return m_groundDeploymentAdjustment; }
-    HBITMAP GetThumbnailBitmapHandle() const { return m_hThumbnailBitmap; }  // may be null
+    const char *GetThumbnailPath() const     { return m_pThumbnailPath; }   // will never be null
+    HBITMAP GetThumbnailBitmapHandle() const;  // may be null; see XRPayloadThumbnailCache
     
     // operator overloading
     bool operator==(const XRPayloadClassData &that) const { return (strcmp(m_pClassname, that.m_pClassname) == 0); }  // vessel classnames are unique
@@ -95,7 +96,7 @@ protected:
     VECTOR3 m_dimensions;       // width (X), height (Y), length (Z)
     VECTOR3 m_slotsOccupied;    // width (X), height (Y), length (Z)
     VECTOR3 m_primarySlotCenterOfMassOffset;  // X,Y,Z
-    HBITMAP m_hThumbnailBitmap; // will be nullptr if bitmap is no defined or is invalid
+    char *m_pThumbnailPath;     // Config-relative path of the thumbnail bitmap; loaded on demand by XRPayloadThumbnailCache
     HASHMAP_STR_VECINT m_explicitAttachmentSlotsMap;   // key=vessel classname, value=list of ship bay slots to which this object may attach (assuming sufficient room).    
     bool m_isXRPayloadEnabled;  // true if this vessel is enabled for docking in the bay, false otherwise
     bool m_isXRConsumableTank;  // true if this vessel contains XR fuel consumable by the parent ship.
@@ -78,7 +78,9 @@ public:
 
     VESSEL *GetChild(const int slotNumber) const;  // convenience method: WARNING: will return nullptr if child was deleted since it was attached, or if no payload is in this slot.
     bool IsSlotEnabled(int slotNumber) const;      // convenience method
-    double GetPayloadMass() const;
+    double GetPayloadMass() const { return m_payloadMass; }   // as of the last slot refresh, AdjustPropellantMass, or PollPayloadMass
+    double PollPayloadMass();
+    double ComputePayloadMass() const;
     void PerformFinalInitialization(ATTACHMENTHANDLE dummyAttachmentPoint);
     void RefreshSlotStates();  
     bool CreateAndAttachPayloadVessel(const char *pClassname, const int slotNumber);
@@ -111,4 +113,6 @@ protected:
     // map of slots numbers -> slot data: key=(int) slot #, value=(XRPayloadBaySlot) data
     HASHMAP_INT_XRPAYLOADBAYSLOT m_allSlotsMap;
     SlotsDrainedFilled m_slotsDrainedFilled;  // only updated by AdjustPropellantMass
+    vector<int> m_occupiedSlotVector;   // primary slots that had a child attached at the last RefreshSlotStates
+    double m_payloadMass;               // total mass of all attached payload vessels in kg
 };
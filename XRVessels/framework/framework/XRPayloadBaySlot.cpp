@@ -177,24 +177,49 @@ bool XRPayloadBaySlot::CheckSlotSpace(const VESSEL &childVessel) const
 // Returns: returns 'true' if hull edge check OK, or 'false' if vessel would hit the hull edge.
 bool XRPayloadBaySlot::GetRequiredNeighborSlotsForCandidateVessel(const VESSEL &childVessel, vector<const XRPayloadBaySlot *> &vOut) const
 {
-    bool retVal = false;        // assume we do NOT impact the hull along any axis
-    
     // Step 1: obtain the child vessel's attachment point, direction, and rotation
     ATTACHMENTHANDLE hChildAttachment = XRPayloadClassData::GetAttachmentHandleForPayloadVessel(childVessel);  // will be null if vessel is not XRPayload-enabled or does not have an attachment point defined
     if (hChildAttachment == nullptr)
         return true;        // no slot data available, so assume edge is OK, too
 
-    // Step 2: obtain the size of the vessel in X,Y,Z lengths (meters)
+    // Step 2: look up the slots this payload class occupies when latched in this slot; the bay is swept only the
+    // first time a given class is tested here.
     const XRPayloadClassData &pcd = XRPayloadClassData::GetXRPayloadClassDataForClassname(childVessel.GetClassName());
+    const SweepResult &sweepResult = GetSweepResult(pcd);
+    vOut.insert(vOut.end(), sweepResult.slots.begin(), sweepResult.slots.end());
+
+    return sweepResult.clearsHull;
+}
+
+// Sweep each XR payload class from this slot now and cache the results so that later fit checks do not have to walk the bay.
+// This must be invoked only after all of this slot's neighbors are set.
+// ppPayloadClasses = null-terminated array of payload classes to sweep, e.g., from XRPayloadClassData::GetAllAvailableXRPayloads()
+void XRPayloadBaySlot::PrecomputeSweeps(const XRPayloadClassData **ppPayloadClasses)
+{
+    for (const XRPayloadClassData **pp = ppPayloadClasses; *pp != nullptr; pp++)
+        GetSweepResult(**pp);
+}
+
+// Returns the cached result of sweeping the supplied payload class from this slot, sweeping the bay now if this is
+// the first request for that class.
+const XRPayloadBaySlot::SweepResult &XRPayloadBaySlot::GetSweepResult(const XRPayloadClassData &pcd) const
+{
+    auto it = m_sweepCache.find(&pcd);
+    if (it != m_sweepCache.end())
+        return it->second;
+
+    SweepResult &sweepResult = m_sweepCache[&pcd];
+
+    // Step 3: obtain the size of the vessel in X,Y,Z lengths (meters)
     const VECTOR3 &childDimensions = pcd.GetDimensions();
 
-    // Step 3: set the point from which the distance dimensions will be measured (the center of the child's mass), as defined in payload-slot-center coordinates.
+    // Step 4: set the point from which the distance dimensions will be measured (the center of the child's mass), as defined in payload-slot-center coordinates.
     // +X = right (starboard), +Y = straight up, +Z = forward
     // NOTE: the actual *attachment point coordinates* have nothing to do with the center of the payload's mass in its primary slot (this slot!)  
     // That is determined by the 'PrimarySlotCenterOfMassOffset' coordinates.
     const VECTOR3 childCenterOfMass = pcd.GetPrimarySlotCenterOfMassOffset();
 
-    // Step 4: we now have 1) the length of the three vectors for the payload module, and 2) the centerpoint where all 
+    // Step 5: we now have 1) the length of the three vectors for the payload module, and 2) the centerpoint where all 
     // three axes converge, shifted correctly to adjust for the attachment point.  
     // Next we need to compute the endpoints of the three length vectors (X,Y,Z) in *payload-slot-local-coordinates*
     // based on the direction and rotation of the child vessel.
@@ -207,9 +232,9 @@ bool XRPayloadBaySlot::GetRequiredNeighborSlotsForCandidateVessel(const VESSEL &
     //       up/down : forward/aft/left/right
     //
     // We must check each slot along each up/down level (or "layer") all the way out; i.e., we must "sweep" all the slots we touch.
-    retVal = SweepSlots(childCenterOfMass, childDimensions, vOut);
+    sweepResult.clearsHull = SweepSlots(childCenterOfMass, childDimensions, sweepResult.slots);
 
-    return retVal;
+    return sweepResult;
 }
 
 // Sweep each slot in a cube from supplied the childCenterOfMass centerpoint, using each slot's dimensions (including *this* slot).  
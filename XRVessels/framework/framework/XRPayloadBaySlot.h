@@ -53,6 +53,7 @@ public:
     VESSEL *GetChild() const;  // will return nullptr if child was deleted since it was attached or if no payload is in this slot.
     bool GetRequiredNeighborSlotsForCandidateVessel(const VESSEL &childVessel, vector<const XRPayloadBaySlot *> &vOut) const;  // populates slot ptrs in vOut; returns TRUE if hull edge check OK, or FALSE if vessel would hit the hull edge
     bool CheckSlotSpace(const VESSEL &childVessel) const;  // returns TRUE if there is room to latch the child in this slot; NOTE: may be via explicit-latch
+    void PrecomputeSweeps(const XRPayloadClassData **ppPayloadClasses);  // sweeps each payload class from this slot and caches the results; ppPayloadClasses is null-terminated
 
     int GetSlotNumber() const                      { return m_slotNumber; }  // 1...n
     const VECTOR3 &GetLocalCoordinates() const     { return m_localCoordinates; }   // coordinates to the center of the slot
@@ -83,6 +84,14 @@ public:
     double AdjustLOXMass(const double delta) const         { return AdjustPropellantMass(2, delta); }
 
 protected:
+    // result of sweeping the bay for one payload class with this slot as its primary slot
+    struct SweepResult
+    {
+        bool clearsHull;                            // true if the payload clears the hull edge along every axis
+        vector<const XRPayloadBaySlot *> slots;     // neighboring slots the payload would occupy, in sweep order
+    };
+
+    const SweepResult &GetSweepResult(const XRPayloadClassData &pcd) const;
     bool SweepSlots(const VECTOR3 &childCenterOfMass, const VECTOR3 &childDimensions, vector<const XRPayloadBaySlot *> &vOut) const ;
     bool SweepXAxisForSlots(vector<const XRPayloadBaySlot *> &zAxisOriginSlots, const bool addOriginSlotsToVout, const VECTOR3 &childCenterOfMass, const double xAxisLength, vector<const XRPayloadBaySlot *> &vOut) const;
     bool SweepAxis(const NEIGHBOR axisPlus, const NEIGHBOR axisMinus, const VECTOR3 &childCenterOfMass, const double axisLength, vector<const XRPayloadBaySlot *> &vOut) const;
@@ -103,4 +112,8 @@ protected:
     // If true, this slot is available for explicit attach/detach operations by the pilot; i.e., it is "enabled."
     // If false, this slot is occupied by a payload that was explicitly attached in a *neighboring* slot; i.e., it is "disabled" until the neighboring payload is detached.
     bool m_isEnabled; 
+
+    // Sweep results keyed by payload class.  The bay layout is fixed once the bay is built, and each XRPayloadClassData
+    // is immutable and lives until ExitModule, so a class's result never changes once it is cached here.
+    mutable unordered_map<const XRPayloadClassData *, SweepResult> m_sweepCache;
 }; 
@@ -0,0 +1,237 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRPayloadThumbnailCache.cpp
+// DLL-wide cache of payload thumbnail bitmaps, decoded on demand
+// by a background thread.
+// ==============================================================
+
+#include "XRPayloadThumbnailCache.h"
+#include "XRPayload.h"
+#include <algorithm>
+#include <crtdbg.h>
+#include <stdio.h>
+
+// Returns the singleton thumbnail cache for this module
+XRPayloadThumbnailCache &XRPayloadThumbnailCache::GetInstance()
+{
+    static XRPayloadThumbnailCache s_instance;
+    return s_instance;
+}
+
+// Constructor
+XRPayloadThumbnailCache::XRPayloadThumbnailCache() :
+    m_bStopWorker(false), m_useCounter(0)
+{
+}
+
+// Returns the thumbnail bitmap for the specified payload thumbnail path.
+// If the thumbnail has not been decoded yet (or cannot be loaded) the default thumbnail is returned instead;
+// that will be null only until the default thumbnail itself has been decoded.
+// pThumbnailPath = path relative to the Config folder; e.g., "Vessels\XRParts.bmp"
+HBITMAP XRPayloadThumbnailCache::GetThumbnail(const char *pThumbnailPath)
+{
+    const string placeholderKey = MakeKey(DEFAULT_PAYLOAD_THUMBNAIL_PATH);
+    const string key = MakeKey(pThumbnailPath);
+
+    lock_guard<mutex> lock(m_mutex);
+    m_useCounter++;
+
+    // the placeholder is requested first so that it is decoded ahead of everything else
+    const HBITMAP hPlaceholder = Lookup(placeholderKey, true);
+    if (key == placeholderKey)
+        return hPlaceholder;
+
+    const HBITMAP hBitmap = Lookup(key, false);
+    EvictLeastRecentlyUsed();
+    return ((hBitmap != nullptr) ? hBitmap : hPlaceholder);
+}
+
+// Returns the cached bitmap for the specified key, or null if it is still pending or failed to load.
+// If the key is not cached yet it is queued for the worker thread.
+HBITMAP XRPayloadThumbnailCache::Lookup(const string &key, const bool isPlaceholder)
+{
+    auto it = m_entryMap.find(key);
+    if (it != m_entryMap.end())
+    {
+        it->second.lastUsed = m_useCounter;
+        return it->second.hBitmap;
+    }
+
+    const Entry entry = { nullptr, true, isPlaceholder, m_useCounter, 0 };
+    m_entryMap.emplace(key, entry);
+    m_pendingQueue.push_back(key);
+
+    // start the worker thread on first use so that modules that never show a thumbnail never create it
+    if (!m_workerThread.joinable())
+    {
+        m_bStopWorker = false;
+        m_workerThread = thread(&XRPayloadThumbnailCache::WorkerThreadProc, this);
+    }
+    m_workAvailable.notify_one();
+    return nullptr;
+}
+
+// Returns the entry holding the supplied bitmap, or nullptr if the bitmap is not cached.
+// This walks the whole cache, but the cache never holds more than CAPACITY + 1 entries.
+XRPayloadThumbnailCache::Entry *XRPayloadThumbnailCache::FindEntry(const HBITMAP hBitmap)
+{
+    if (hBitmap == nullptr)
+        return nullptr;
+
+    for (auto it = m_entryMap.begin(); it != m_entryMap.end(); it++)
+    {
+        if (it->second.hBitmap == hBitmap)
+            return &it->second;
+    }
+    return nullptr;
+}
+
+// Prevent the supplied thumbnail from being evicted until it is unpinned.  Callers that hand a thumbnail to a
+// window that keeps it (e.g., a picture control via STM_SETIMAGE) must pin it for as long as the window shows it.
+void XRPayloadThumbnailCache::Pin(const HBITMAP hBitmap)
+{
+    lock_guard<mutex> lock(m_mutex);
+    Entry *pEntry = FindEntry(hBitmap);
+    if (pEntry != nullptr)
+        pEntry->pinCount++;
+}
+
+// Allow the supplied thumbnail to be evicted again; it will be freed by a later GetThumbnail if the cache is full.
+void XRPayloadThumbnailCache::Unpin(const HBITMAP hBitmap)
+{
+    lock_guard<mutex> lock(m_mutex);
+    Entry *pEntry = FindEntry(hBitmap);
+    if (pEntry != nullptr)
+    {
+        _ASSERTE(pEntry->pinCount > 0);
+        pEntry->pinCount--;
+    }
+}
+
+// Frees least-recently-requested thumbnails until no more than CAPACITY are held.
+// Pending entries, pinned entries and the placeholder are never evicted, and neither is the thumbnail
+// requested by the current call, since the caller is about to use it.
+void XRPayloadThumbnailCache::EvictLeastRecentlyUsed()
+{
+    for (;;)
+    {
+        int thumbnailCount = 0;
+        auto lruIt = m_entryMap.end();
+        for (auto it = m_entryMap.begin(); it != m_entryMap.end(); it++)
+        {
+            const Entry &entry = it->second;
+            if (entry.isPlaceholder)
+                continue;
+
+            thumbnailCount++;
+            if (entry.isPending || (entry.pinCount > 0) || (entry.lastUsed == m_useCounter))
+                continue;
+
+            if ((lruIt == m_entryMap.end()) || (entry.lastUsed < lruIt->second.lastUsed))
+                lruIt = it;
+        }
+
+        if ((thumbnailCount <= CAPACITY) || (lruIt == m_entryMap.end()))
+            break;
+
+        if (lruIt->second.hBitmap != nullptr)
+            DeleteObject(lruIt->second.hBitmap);
+        m_entryMap.erase(lruIt);
+    }
+}
+
+// Stops the worker thread and frees all cached bitmaps.
+void XRPayloadThumbnailCache::Terminate()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_bStopWorker = true;
+    }
+    m_workAvailable.notify_one();
+    if (m_workerThread.joinable())
+        m_workerThread.join();   // the worker finishes at most one in-progress load
+
+    lock_guard<mutex> lock(m_mutex);
+    for (auto it = m_entryMap.begin(); it != m_entryMap.end(); it++)
+    {
+        if (it->second.hBitmap != nullptr)
+            DeleteObject(it->second.hBitmap);
+    }
+    m_entryMap.clear();
+    m_pendingQueue.clear();
+}
+
+// Worker thread: decodes queued thumbnails one at a time.
+// Note: GDI bitmaps belong to the process, not the thread, so bitmaps loaded here may be
+// selected into DCs on the main thread.
+void XRPayloadThumbnailCache::WorkerThreadProc()
+{
+    for (;;)
+    {
+        string key;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this] { return (m_bStopWorker || !m_pendingQueue.empty()); });
+            if (m_bStopWorker)
+                return;
+
+            key = m_pendingQueue.front();
+            m_pendingQueue.pop_front();
+        }
+
+        // do not hold the lock while we touch the disk
+        const HBITMAP hBitmap = LoadThumbnail(key.c_str());
+
+        lock_guard<mutex> lock(m_mutex);
+        auto it = m_entryMap.find(key);
+        if (it != m_entryMap.end())
+        {
+            it->second.hBitmap = hBitmap;
+            it->second.isPending = false;
+        }
+        else if (hBitmap != nullptr)   // cache was cleared while we were loading
+        {
+            DeleteObject(hBitmap);
+        }
+    }
+}
+
+// Returns the cache key for a thumbnail path; Windows paths are case-insensitive.
+string XRPayloadThumbnailCache::MakeKey(const char *pThumbnailPath)
+{
+    string key(pThumbnailPath);
+    transform(key.begin(), key.end(), key.begin(), [](const char c) { return static_cast<char>(tolower(static_cast<unsigned char>(c))); });
+    return key;
+}
+
+// Loads a thumbnail bitmap from disk.
+// Note: our base path here is the Orbiter root directory: i.e., the directory from which Orbiter.exe is running.
+// Returns: bitmap handle, or null if the load failed
+HBITMAP XRPayloadThumbnailCache::LoadThumbnail(const char *pThumbnailPath)
+{
+    char fullThumbnailPath[1024];
+    sprintf(fullThumbnailPath, "Config\\%s", pThumbnailPath);
+    return static_cast<HBITMAP>(LoadImage(0, fullThumbnailPath, IMAGE_BITMAP, PAYLOAD_THUMBNAIL_DIMX, PAYLOAD_THUMBNAIL_DIMY, LR_LOADFROMFILE));
+}
@@ -0,0 +1,87 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRPayloadThumbnailCache.h
+// DLL-wide cache of payload thumbnail bitmaps, decoded on demand
+// by a background thread.
+// ==============================================================
+
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+// Thumbnails are not loaded until a payload dialog or screen first asks for them.  GetThumbnail never
+// blocks on a file load: it queues the bitmap for the worker thread and returns the shared placeholder
+// (the default payload thumbnail) until the decoded bitmap is ready, so callers must re-query each time
+// they render and redraw when the returned handle changes.
+// At most CAPACITY thumbnails are held; the least-recently-requested thumbnail is freed first, except that a
+// thumbnail that is pinned (e.g., because a dialog control still displays it) is never freed until it is unpinned.
+// NOTE: all methods except the worker thread itself must be invoked from Orbiter's main thread.
+class XRPayloadThumbnailCache
+{
+public:
+    static XRPayloadThumbnailCache &GetInstance();
+
+    HBITMAP GetThumbnail(const char *pThumbnailPath);   // pThumbnailPath is relative to the Config folder; may return null
+    void Pin(const HBITMAP hBitmap);     // hBitmap may be null or the placeholder; each Pin must be balanced by an Unpin
+    void Unpin(const HBITMAP hBitmap);
+    void Terminate();   // stops the worker thread and frees all bitmaps; invoked by XRPayloadClassData::Terminate
+
+    static const int CAPACITY = 16;     // max number of thumbnails held, not counting the placeholder
+
+protected:
+    XRPayloadThumbnailCache();
+
+    struct Entry
+    {
+        HBITMAP hBitmap;        // null if still pending or if the load failed
+        bool isPending;         // true = queued for or being decoded by the worker thread
+        bool isPlaceholder;     // true = default thumbnail, which is never evicted
+        unsigned int lastUsed;  // value of m_useCounter when this thumbnail was last requested
+        int pinCount;           // > 0 = still displayed somewhere, so never evicted
+    };
+
+    HBITMAP Lookup(const string &key, const bool isPlaceholder);   // caller must hold m_mutex
+    Entry *FindEntry(const HBITMAP hBitmap);   // caller must hold m_mutex
+    void EvictLeastRecentlyUsed();      // caller must hold m_mutex
+    void WorkerThreadProc();
+    static string MakeKey(const char *pThumbnailPath);
+    static HBITMAP LoadThumbnail(const char *pThumbnailPath);
+
+    mutex m_mutex;                          // guards all fields below
+    condition_variable m_workAvailable;
+    thread m_workerThread;
+    bool m_bStopWorker;
+    deque<string> m_pendingQueue;           // keys waiting for the worker thread
+    unordered_map<string, Entry> m_entryMap;   // key = lowercase thumbnail path
+    unsigned int m_useCounter;
+};
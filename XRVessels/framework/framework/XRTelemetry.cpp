@@ -0,0 +1,109 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRTelemetry.cpp
+// Lock-free, single-producer/multi-consumer telemetry channel.
+// ==============================================================
+
+#include "XRTelemetry.h"
+#include <stdio.h>
+#include <new>      // for placement new
+
+// Constructor
+XRTelemetryChannel::XRTelemetryChannel() :
+    m_pBlock(nullptr), m_hMapping(nullptr)
+{
+}
+
+// Destructor
+XRTelemetryChannel::~XRTelemetryChannel()
+{
+    Close();
+}
+
+// Allocate the telemetry block for this channel.
+//   pVesselName = name of the vessel publishing the data; used to name the memory-mapped file, if any
+//   bSharedMemory = true to back this channel with a named memory-mapped file readable by other processes, false for in-process only
+// Returns: true on success, false if the memory-mapped file could not be created (the channel still falls back to in-process only in that case)
+bool XRTelemetryChannel::Open(const char *pVesselName, const bool bSharedMemory)
+{
+    Close();    // in case we were already open
+
+    bool retVal = true;
+    if (bSharedMemory)
+    {
+        char mappingName[MAX_PATH];
+        _snprintf(mappingName, sizeof(mappingName) - 1, "%s%s", XRTELEMETRY_MAPPING_PREFIX, pVesselName);
+        mappingName[sizeof(mappingName) - 1] = 0;
+
+        // backed by the system paging file
+        m_hMapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(XRTelemetryBlock), mappingName);
+        if (m_hMapping != nullptr)
+        {
+            void *pView = MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, sizeof(XRTelemetryBlock));
+            if (pView != nullptr)
+                m_pBlock = new (pView) XRTelemetryBlock;  // placement new so the atomic is properly constructed
+            else
+            {
+                CloseHandle(m_hMapping);
+                m_hMapping = nullptr;
+            }
+        }
+
+        retVal = (m_pBlock != nullptr);
+    }
+
+    if (m_pBlock == nullptr)    // in-process only (or mapping failed)
+        m_pBlock = new XRTelemetryBlock;
+
+    m_pBlock->Magic = XRTELEMETRY_MAGIC;
+    m_pBlock->LayoutVersion = XRTELEMETRY_LAYOUT_VERSION;
+    m_pBlock->RecordSize = sizeof(XRTelemetryRecord);
+    m_pBlock->Reserved = 0;
+    memset(&m_pBlock->Record, 0, sizeof(XRTelemetryRecord));
+    m_pBlock->Sequence.store(0, std::memory_order_release);   // nothing published yet
+
+    return retVal;
+}
+
+// Free the telemetry block; any external readers still attached to the memory-mapped file retain their own view until they close it
+void XRTelemetryChannel::Close()
+{
+    if (m_pBlock == nullptr)
+        return;     // nothing to do
+
+    if (m_hMapping != nullptr)
+    {
+        m_pBlock->~XRTelemetryBlock();
+        UnmapViewOfFile(m_pBlock);
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    else
+    {
+        delete m_pBlock;
+    }
+
+    m_pBlock = nullptr;
+}
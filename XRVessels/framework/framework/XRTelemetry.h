@@ -0,0 +1,274 @@
+/**
+  XR Vessel add-ons for OpenOrbiter Space Flight Simulator
+  Copyright (C) 2006-2021 Douglas Beachy
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+  Email: mailto:doug.beachy@outlook.com
+  Web: https://www.alteaaerospace.com
+**/
+
+// ==============================================================
+// XR Vessel Framework
+//
+// XRTelemetry.h
+// Lock-free, single-producer/multi-consumer telemetry channel used to
+// publish a fixed-layout state record for each XR vessel once per frame.
+// The channel may optionally be backed by a named memory-mapped file so 
+// that a separate process can read the vessel's state without touching 
+// any Orbiter objects.
+// ==============================================================
+
+#pragma once
+
+#include <windows.h>
+#include <crtdbg.h>   // for _ASSERTE
+#include <atomic>
+#include <string.h>
+
+#define XRTELEMETRY_MAGIC          0x4D4C5458    /* 'XTLM' */
+#define XRTELEMETRY_LAYOUT_VERSION 3             /* bump this whenever XRTelemetryRecord changes */
+
+// Name of the memory-mapped file for a given vessel is XRTELEMETRY_MAPPING_PREFIX + vessel name; e.g., "Local\XRTelemetry_XR5-01"
+#define XRTELEMETRY_MAPPING_PREFIX "Local\\XRTelemetry_"
+
+// max number of times a reader will retry a read that was torn by a concurrent write before giving up for this call
+#define XRTELEMETRY_MAX_READ_ATTEMPTS 64
+
+// Fixed-layout state record published for each XR vessel at the end of each clbkPostStep.
+// WARNING: this structure is shared across processes (and across 32-bit and 64-bit binaries), so it must
+// contain only fixed-size types in a fixed order.  If you change it, bump XRTELEMETRY_LAYOUT_VERSION.
+#pragma pack(push, 8)
+struct XRTelemetryRecord
+{
+    //
+    // Core flight data; populated by VESSEL3_EXT
+    //
+    double SimTime;             // absolute simt (see VESSEL3_EXT::GetAbsoluteSimTime)
+    double SimDT;               // frame delta in seconds
+    double MJD;
+    double Altitude;            // ALTMODE_GROUND, in meters
+    double Airspeed;            // m/s
+    double Groundspeed;         // m/s
+    double MachNumber;
+    double DynPressure;         // pascals
+    double AtmPressure;         // pascals
+    double Pitch;               // radians
+    double Bank;                // radians
+    double Yaw;                 // radians
+    double AOA;                 // radians
+    double Slip;                // radians
+    double AngularVel[3];       // radians/sec (x, y, z)
+    double Mass;                // total mass in kg
+    double MainThrustLevel;     // thrust group levels: 0 <= n <= 1.0
+    double RetroThrustLevel;
+    double HoverThrustLevel;
+    int    GroundContact;       // 1 = ship is touching the ground
+    int    HasFocus;            // 1 = vessel has the focus
+
+    //
+    // XR system data; populated by XR vessel subclasses.  Any value not supported by a given vessel is -1.
+    //
+    double MainFuelMass;        // kg, including bay tanks
+    double RCSFuelMass;         // kg, including bay tanks
+    double ScramFuelMass;       // kg, including bay tanks
+    double APUFuelMass;         // kg
+    double LOXMass;             // kg, including bay tanks
+    double CoolantTemp;         // degrees C
+    double NoseconeTemp;        // Kelvin
+    double LeftWingTemp;        // Kelvin
+    double RightWingTemp;       // Kelvin
+    double CockpitTemp;         // Kelvin
+    double TopHullTemp;         // Kelvin
+    double CenterOfGravity;     // meters
+    double GearProc;            // door procs: 0 = closed, 1 = open
+    double NoseconeProc;
+    double AirbrakeProc;
+    double RadiatorProc;
+    double BayDoorsProc;
+    double AutopilotTargetPitch;        // degrees (target AOA if AOA hold engaged)
+    double AutopilotTargetBank;         // degrees
+    double AutopilotTargetDescentRate;  // m/s
+    double AutopilotTargetAirspeed;     // m/s
+    int    CustomAutopilotMode;         // AUTOPILOT enum value for the vessel
+    int    AirspeedHoldEngaged;         // 1 = engaged
+    int    MWSActive;                   // 1 = master warning active
+    int    IsCrashed;                   // 1 = vessel is crashed
+    double LeftWingIntegrity;           // 0 = destroyed, 1 = fully functional
+    double RightWingIntegrity;          // 0 = destroyed, 1 = fully functional
+
+    //
+    // Sound cache statistics since the vessel was created; populated by XR vessel subclasses.  -1 = not supported.
+    //
+    double SoundLoadMillis;             // average time to load a sound file into XRSound, in milliseconds
+    double SoundCacheHitRate;           // fraction of sounds played that were already loaded: 0 <= n <= 1.0
+    double SoundResidentBytes;          // total size of all sound files currently loaded
+    int    SoundLoads;                  // number of sound files loaded
+    int    SoundRequests;               // number of sounds played
+};
+
+// Header + record: this is the exact layout of the shared memory block.
+struct XRTelemetryBlock
+{
+    DWORD Magic;                // XRTELEMETRY_MAGIC
+    DWORD LayoutVersion;        // XRTELEMETRY_LAYOUT_VERSION
+    DWORD RecordSize;           // sizeof(XRTelemetryRecord)
+    DWORD Reserved;
+    // Seqlock sequence number: odd = write in progress, even = record is stable. 
+    // Also serves as a frame counter: (Sequence / 2) == number of records published so far.
+    std::atomic<unsigned long long> Sequence;
+    XRTelemetryRecord Record;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(std::atomic<unsigned long long>) == sizeof(unsigned long long), "XRTelemetryBlock::Sequence must be lock-free in order to be shared across processes");
+
+//-------------------------------------------------------------------------
+
+// Owned by each XR vessel: there is exactly one writer (the simulation thread) and any number of readers.
+// Publish() never blocks and never allocates.
+class XRTelemetryChannel
+{
+public:
+    XRTelemetryChannel();
+    virtual ~XRTelemetryChannel();
+
+    bool Open(const char *pVesselName, const bool bSharedMemory);
+    void Close();
+    bool IsOpen() const { return (m_pBlock != nullptr); }
+    bool IsSharedMemory() const { return (m_hMapping != nullptr); }
+
+    // Publish a new record; invoked only from the simulation thread.
+    void Publish(const XRTelemetryRecord &record)
+    {
+        _ASSERTE(IsOpen());
+        const unsigned long long seq = m_pBlock->Sequence.load(std::memory_order_relaxed);
+        m_pBlock->Sequence.store(seq + 1, std::memory_order_relaxed);  // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&m_pBlock->Record, &record, sizeof(XRTelemetryRecord));
+        m_pBlock->Sequence.store(seq + 2, std::memory_order_release);  // even: record is stable
+    }
+
+    // Read the latest record; may be invoked from any thread.  See ReadBlock for details.
+    bool Read(XRTelemetryRecord &recordOut, unsigned long long *pSequenceOut = nullptr) const
+    {
+        return (IsOpen() ? ReadBlock(*m_pBlock, recordOut, pSequenceOut) : false);
+    }
+
+    // Reads a consistent copy of the record in the supplied block without blocking the writer.
+    // Returns: true on success, false if no record has been published yet or if the reader kept colliding with the writer
+    static bool ReadBlock(const XRTelemetryBlock &block, XRTelemetryRecord &recordOut, unsigned long long *pSequenceOut)
+    {
+        for (int i = 0; i < XRTELEMETRY_MAX_READ_ATTEMPTS; i++)
+        {
+            const unsigned long long seq1 = block.Sequence.load(std::memory_order_acquire);
+            if (seq1 & 1)
+            {
+                YieldProcessor();   // writer is busy; spin briefly
+                continue;
+            }
+
+            memcpy(&recordOut, &block.Record, sizeof(XRTelemetryRecord));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            const unsigned long long seq2 = block.Sequence.load(std::memory_order_relaxed);
+            if (seq1 == seq2)
+            {
+                if (pSequenceOut != nullptr)
+                    *pSequenceOut = seq1;
+                return (seq1 != 0);    // 0 = nothing published yet
+            }
+        }
+        return false;   // writer kept tearing our reads; try again next time
+    }
+
+protected:
+    XRTelemetryBlock *m_pBlock;     // heap block or mapped view; nullptr = not open
+    HANDLE m_hMapping;              // nullptr if channel is in-process only
+};
+
+//-------------------------------------------------------------------------
+
+// Reference out-of-process consumer: attaches to a vessel's memory-mapped telemetry channel by vessel name.
+// This class has no dependencies on Orbiter, so external tools may simply include this header.
+class XRTelemetryReader
+{
+public:
+    XRTelemetryReader() : m_hMapping(nullptr), m_pBlock(nullptr), m_lastSequence(0) { }
+    virtual ~XRTelemetryReader() { Close(); }
+
+    // pVesselName = e.g., "XR5-01"
+    // Returns: true on success, false if the vessel is not publishing telemetry or its layout does not match ours
+    bool Open(const char *pVesselName)
+    {
+        Close();
+
+        char mappingName[MAX_PATH];
+        _snprintf(mappingName, sizeof(mappingName) - 1, "%s%s", XRTELEMETRY_MAPPING_PREFIX, pVesselName);
+        mappingName[sizeof(mappingName) - 1] = 0;
+
+        m_hMapping = OpenFileMapping(FILE_MAP_READ, FALSE, mappingName);
+        if (m_hMapping == nullptr)
+            return false;
+
+        m_pBlock = static_cast<const XRTelemetryBlock *>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, sizeof(XRTelemetryBlock)));
+        if ((m_pBlock == nullptr) || 
+            (m_pBlock->Magic != XRTELEMETRY_MAGIC) || 
+            (m_pBlock->LayoutVersion != XRTELEMETRY_LAYOUT_VERSION) || 
+            (m_pBlock->RecordSize != sizeof(XRTelemetryRecord)))
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_pBlock != nullptr)
+        {
+            UnmapViewOfFile(m_pBlock);
+            m_pBlock = nullptr;
+        }
+
+        if (m_hMapping != nullptr)
+        {
+            CloseHandle(m_hMapping);
+            m_hMapping = nullptr;
+        }
+        m_lastSequence = 0;
+    }
+
+    bool IsOpen() const { return (m_pBlock != nullptr); }
+
+    // Reads the latest record.
+    // Returns: true if recordOut was populated with a record that is newer than the one returned by the previous call
+    bool ReadIfNew(XRTelemetryRecord &recordOut)
+    {
+        unsigned long long seq = 0;
+        if (!IsOpen() || !XRTelemetryChannel::ReadBlock(*m_pBlock, recordOut, &seq) || (seq == m_lastSequence))
+            return false;
+
+        m_lastSequence = seq;
+        return true;
+    }
+
+    // Returns the number of records published by the vessel so far
+    unsigned long long GetPublishedCount() const { return (IsOpen() ? (m_pBlock->Sequence.load(std::memory_order_relaxed) / 2) : 0); }
+
+protected:
+    HANDLE m_hMapping;
+    const XRTelemetryBlock *m_pBlock;
+    unsigned long long m_lastSequence;  // sequence of the last record returned by ReadIfNew
+};
@@ -31,7 +31,7 @@
 
 // Constructor
 XRPayloadBay::XRPayloadBay(VESSEL &parentVessel) :
-    m_parentVessel(parentVessel)
+    m_parentVessel(parentVessel), m_payloadMass(0)
 {
 }
 
@@ -220,26 +220,30 @@ int XRPayloadBay::DetachAllChildrenLanded()
     return detachedCount;
 }
 
-// Returns the total payload mass in kg
-double XRPayloadBay::GetPayloadMass() const
+// Re-read the mass of each attached payload vessel and return the new total payload mass in kg.
+// GetPayloadMass is kept current as payload is attached, detached, or refueled through this bay, so this only needs
+// to be invoked occasionally to pick up "dynamic vessels" in the bay that change their own mass (e.g., by burning 
+// consumables or venting mass) or that were deleted since they were attached.
+double XRPayloadBay::PollPayloadMass()
+{
+    m_payloadMass = ComputePayloadMass();
+    return m_payloadMass;
+}
+
+// Returns the total mass in kg of the payload vessels attached as of the last slot refresh, read from each vessel;
+// this does not change GetPayloadMass.  Only occupied slots are checked.
+double XRPayloadBay::ComputePayloadMass() const
 {
     double totalMass = 0;
 
-    // iterate through each slot and add up the total payload mass
-    for (int i=1; i <= GetSlotCount(); i++)     // slots are one-based
+    // Only primary slots (slots to which a vessel was explicitly attached) have a child vessel present;
+    // other surrounding slots will be marked as 'disabled' if the vessel occupies more than one slot, but all of the mass
+    // will be tracked from the primary slot only.
+    for (UINT i=0; i < m_occupiedSlotVector.size(); i++)
     {
-        const VESSEL *pChild = GetChild(i);
-        if (pChild != nullptr)        
-        {
-            // Only primary slots (slots to which a vessel was explicitly attached) have a child vessel present;
-            // other surrounding slots will be marked as 'disabled' if the vessel occupies more than one slot, but all of the mass
-            // will be tracked from the primary slot only.
-            //
-            // Note that we use the actual vessel MASS here instead of just the nominal initial mass tracked by the XRPayload object.  This is
-            // so that the mass will be correct when "dynamic vessels" are docked in the payload bay.  In other words, if you have a ship docked 
-            // in the payload bay that is burning consumables or venting mass, it will be reflected in real-time on the ship's mass readouts.
+        const VESSEL *pChild = GetChild(m_occupiedSlotVector[i]);
+        if (pChild != nullptr)      // child may have been deleted since it was attached
             totalMass += pChild->GetMass();
-        }
     }
 
     return totalMass;
@@ -305,15 +309,23 @@ void XRPayloadBay::PerformFinalInitialization(ATTACHMENTHANDLE dummyAttachmentPo
         VESSEL3_EXT::ResetAllFuelLevels(pDummyVessel, 0);
     }
 
+    // The bay layout is final now, so sweep every XR payload class from every slot up front; fit checks are then table lookups.
+    // XRPayloadClassData was initialized from clbkPostCreation, so all payload classes are known by now.
+    const XRPayloadClassData **ppPayloadClasses = XRPayloadClassData::GetAllAvailableXRPayloads();
+    for (int slotNumber=1; slotNumber <= GetSlotCount(); slotNumber++)
+        GetSlot(slotNumber)->PrecomputeSweeps(ppPayloadClasses);
+
     // initialize the enabled/disabled state of all slots
     RefreshSlotStates();
 }
 
 // Refresh the enabled/disabled state of all slots in the bay based on 
 // payload in each slot.  This should be called on startup and whenever a new vessel is 
-// attached or detached.
+// attached or detached; it also updates our list of occupied slots and the payload mass.
 void XRPayloadBay::RefreshSlotStates()
 {
+    m_occupiedSlotVector.clear();
+
     // First, reset all slots to ENABLED.
     for (int slotNumber=1; slotNumber <= GetSlotCount(); slotNumber++)
        GetSlot(slotNumber)->SetEnabled(true);
@@ -327,6 +339,7 @@ void XRPayloadBay::RefreshSlotStates()
         VESSEL *pChild = pSlot->GetChild();
         if (pChild != nullptr)
         {
+            m_occupiedSlotVector.push_back(slotNumber);
             vOut.clear();       // reset
 
             // This is a primary slot with a child attached; process it and mark any surrounding slots as DISABLED if the 
@@ -342,6 +355,8 @@ void XRPayloadBay::RefreshSlotStates()
             }
         }
     }
+
+    PollPayloadMass();
 }
 
 // Instantiate a new instance of a given payload vessel and attach it in the bay at the specified slot, provided there is room.
@@ -637,6 +652,9 @@ const XRPayloadBay::SlotsDrainedFilled &XRPayloadBay::AdjustPropellantMass(const
         else if ((currentSlotQty == 0) && (prevSlotQty > 0))
             m_slotsDrainedFilled.drainedList.push_back(slotNumber);  // tank just emptied
     }
+
+    // the adjusted propellant is in the payload vessels, so their mass changed by the same amount
+    m_payloadMass += m_slotsDrainedFilled.quantityAdjusted;
     
     return m_slotsDrainedFilled;
 }